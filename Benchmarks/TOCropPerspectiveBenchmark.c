@@ -0,0 +1,277 @@
+//
+//  TOCropPerspectiveBenchmark.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Checks the accuracy of the perspective warp (`TOCropWarpPerspective`) against a plain
+// double-precision version of the same warp, and then measures how many output pixels per
+// second it gets through when flattening a photographed page, on one thread and on every core.
+// It only depends on the C geometry and rendering code, so it builds and runs anywhere,
+// including on Linux build machines:
+//
+//   cc -O2 -std=gnu99 -I Objective-C/TOCropViewController/Geometry -I Objective-C/TOCropViewController/Rendering
+//      -o crop-perspective-benchmark Benchmarks/TOCropPerspectiveBenchmark.c
+//      Objective-C/TOCropViewController/Geometry/TOCropGeometry.c
+//      Objective-C/TOCropViewController/Rendering/TOCropPerspective.c
+//      Objective-C/TOCropViewController/Rendering/TOCropParallel.c
+//      Objective-C/TOCropViewController/Rendering/TOCropPixelBuffer.c
+//      Objective-C/TOCropViewController/Rendering/TOCropPixelOrientation.c
+//      Objective-C/TOCropViewController/Rendering/TOCropPixelView.c -lm -lpthread
+//
+//   ./crop-perspective-benchmark [-n iterations]
+//
+// It exits with a non-zero status if any output pixel is off by more than one step in any
+// channel, or if the output differs on any number of threads. The SSE2 and NEON paths are used
+// automatically where available. Build with -U__SSE2__ to check and time the plain C path on x86.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "TOCropGeometry.h"
+#include "TOCropParallel.h"
+#include "TOCropPerspective.h"
+
+static double TOCropPerspectiveBenchmarkCurrentTime(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + ((double)time.tv_nsec / 1000000000.0);
+}
+
+// Fills a buffer with smooth gradients and a fine checkerboard, so interpolation errors show up
+// on both soft and hard edges. Alpha is left opaque, as the warp expects premultiplied pixels.
+static void TOCropPerspectiveBenchmarkFill(TOCropPixelBuffer *buffer) {
+    for (size_t y = 0; y < buffer->height; y++) {
+        uint8_t *row = buffer->data + y * buffer->bytesPerRow;
+        for (size_t x = 0; x < buffer->width; x++) {
+            uint8_t *pixel = row + x * TOCropPixelBufferBytesPerPixel;
+            pixel[0] = (uint8_t)((x * 255) / buffer->width);
+            pixel[1] = (uint8_t)((y * 255) / buffer->height);
+            pixel[2] = (((x / 3) + (y / 3)) % 2) ? 230 : 20;
+            pixel[3] = 255;
+        }
+    }
+}
+
+// The same bilinear or bicubic warp as the kernel, one pixel at a time in double precision,
+// straight through the homography, with no tiles, vectors or stepping along rows
+static double TOCropPerspectiveBenchmarkReferenceTap(const TOCropPixelBuffer *source, long x, long y, int channel) {
+    if (x < 0 || y < 0 || x >= (long)source->width || y >= (long)source->height) {
+        return 0.0;
+    }
+    return source->data[(size_t)y * source->bytesPerRow + (size_t)x * TOCropPixelBufferBytesPerPixel + channel];
+}
+
+static void TOCropPerspectiveBenchmarkReferenceWeights(TOCropInterpolation interpolation, double t, double *weights) {
+    if (interpolation == TOCropInterpolationBicubic) {
+        weights[0] = -0.5 * t * t * t + t * t - 0.5 * t;
+        weights[1] = 1.5 * t * t * t - 2.5 * t * t + 1.0;
+        weights[2] = -1.5 * t * t * t + 2.0 * t * t + 0.5 * t;
+        weights[3] = 0.5 * t * t * t - 0.5 * t * t;
+    } else {
+        weights[0] = 1.0 - t;
+        weights[1] = t;
+    }
+}
+
+static void TOCropPerspectiveBenchmarkReferenceWarp(const TOCropPixelBuffer *source, const TOCropHomography *homography,
+                                                    TOCropInterpolation interpolation, TOCropPixelBuffer *destination) {
+    const int taps = interpolation == TOCropInterpolationBicubic ? 4 : 2;
+    for (size_t row = 0; row < destination->height; row++) {
+        for (size_t column = 0; column < destination->width; column++) {
+            const TOCropPoint point = TOCropGeometryApplyHomography(homography, (TOCropPoint){column + 0.5, row + 0.5});
+            const double x = point.x - 0.5, y = point.y - 0.5;
+            const long firstX = (long)floor(x) - (taps / 2 - 1), firstY = (long)floor(y) - (taps / 2 - 1);
+            double weightsX[4], weightsY[4];
+            TOCropPerspectiveBenchmarkReferenceWeights(interpolation, x - floor(x), weightsX);
+            TOCropPerspectiveBenchmarkReferenceWeights(interpolation, y - floor(y), weightsY);
+
+            uint8_t *pixel = destination->data + row * destination->bytesPerRow + column * TOCropPixelBufferBytesPerPixel;
+            for (int c = 0; c < (int)TOCropPixelBufferBytesPerPixel; c++) {
+                double sum = 0.0;
+                for (int j = 0; j < taps; j++) {
+                    for (int i = 0; i < taps; i++) {
+                        sum += weightsX[i] * weightsY[j] *
+                               TOCropPerspectiveBenchmarkReferenceTap(source, firstX + i, firstY + j, c);
+                    }
+                }
+                pixel[c] = (uint8_t)fmin(fmax(round(sum), 0.0), 255.0);
+            }
+        }
+    }
+}
+
+// The most any channel of any pixel differs by between two buffers of the same size
+static int TOCropPerspectiveBenchmarkMaximumError(const TOCropPixelBuffer *a, const TOCropPixelBuffer *b) {
+    int maximumError = 0;
+    for (size_t row = 0; row < a->height; row++) {
+        const uint8_t *rowA = a->data + row * a->bytesPerRow;
+        const uint8_t *rowB = b->data + row * b->bytesPerRow;
+        for (size_t i = 0; i < a->width * TOCropPixelBufferBytesPerPixel; i++) {
+            const int error = abs((int)rowA[i] - (int)rowB[i]);
+            maximumError = error > maximumError ? error : maximumError;
+        }
+    }
+    return maximumError;
+}
+
+// A page photographed from below and to the left, filling most of the frame,
+// and one that's partly out of the frame, so the edges are handled too
+static TOCropQuad TOCropPerspectiveBenchmarkQuad(TOCropSize imageSize, bool clipped) {
+    const double w = imageSize.width, h = imageSize.height;
+    if (clipped) {
+        return (TOCropQuad){{-0.1 * w, 0.05 * h}, {0.8 * w, -0.08 * h}, {1.1 * w, 0.9 * h}, {0.05 * w, 1.05 * h}};
+    }
+    return (TOCropQuad){{0.18 * w, 0.1 * h}, {0.86 * w, 0.04 * h}, {0.95 * w, 0.97 * h}, {0.06 * w, 0.88 * h}};
+}
+
+static bool TOCropPerspectiveBenchmarkCheckAccuracy(void) {
+    TOCropPixelBuffer source;
+    if (!TOCropPixelBufferAllocate(&source, 601, 457)) {
+        return false;
+    }
+    TOCropPerspectiveBenchmarkFill(&source);
+    const TOCropSize sourceSize = {(double)source.width, (double)source.height};
+
+    bool passed = true;
+    for (int clipped = 0; clipped < 2; clipped++) {
+        const TOCropQuad quad = TOCropPerspectiveBenchmarkQuad(sourceSize, clipped);
+        const TOCropSize outputSize = TOCropGeometryPerspectiveOutputSize(quad);
+        TOCropHomography homography;
+        TOCropPixelBuffer expected, warped, threaded;
+        if (!TOCropGeometryHomographyForQuad(quad, outputSize, &homography) ||
+            !TOCropPixelBufferAllocate(&expected, (size_t)round(outputSize.width), (size_t)round(outputSize.height)) ||
+            !TOCropPixelBufferAllocate(&warped, expected.width, expected.height) ||
+            !TOCropPixelBufferAllocate(&threaded, expected.width, expected.height)) {
+            return false;
+        }
+        // The homography was made for the unrounded size, so make it again for the buffer's
+        TOCropGeometryHomographyForQuad(quad, (TOCropSize){(double)expected.width, (double)expected.height}, &homography);
+
+        for (TOCropInterpolation interpolation = TOCropInterpolationBilinear; interpolation <= TOCropInterpolationBicubic;
+             interpolation++) {
+            TOCropPerspectiveBenchmarkReferenceWarp(&source, &homography, interpolation, &expected);
+            TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, interpolation, 1, NULL, &warped);
+            const int maximumError = TOCropPerspectiveBenchmarkMaximumError(&expected, &warped);
+
+            bool identical = true;
+            for (size_t threads = 2; threads <= TOCropParallelDefaultThreadCount() + 1; threads++) {
+                TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, interpolation, threads, NULL,
+                                      &threaded);
+                identical = identical && TOCropPerspectiveBenchmarkMaximumError(&warped, &threaded) == 0;
+            }
+
+            const bool interpolationPassed = maximumError <= 1 && identical;
+            printf("%-8s %-9s %6zux%-6zu maximum error %d, %s on every thread count: %s\n",
+                   clipped ? "clipped" : "inside", interpolation == TOCropInterpolationBicubic ? "bicubic" : "bilinear",
+                   expected.width, expected.height, maximumError, identical ? "identical" : "DIFFERENT",
+                   interpolationPassed ? "ok" : "FAILED");
+            passed = passed && interpolationPassed;
+        }
+
+        TOCropPixelBufferFree(&expected);
+        TOCropPixelBufferFree(&warped);
+        TOCropPixelBufferFree(&threaded);
+    }
+
+    // A quad that's exactly the whole source comes back as an exact copy
+    TOCropHomography identity;
+    TOCropPixelBuffer copy;
+    if (!TOCropGeometryHomographyForQuad(TOCropGeometryQuadWithRect((TOCropRect){{0, 0}, sourceSize}), sourceSize, &identity) ||
+        !TOCropPixelBufferAllocate(&copy, source.width, source.height)) {
+        return false;
+    }
+    TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), identity.m, TOCropInterpolationBicubic, 0, NULL, &copy);
+    const bool copied = TOCropPerspectiveBenchmarkMaximumError(&source, &copy) == 0;
+    printf("%-8s %-9s %6zux%-6zu exact copy: %s\n\n", "whole", "bicubic", copy.width, copy.height, copied ? "ok" : "FAILED");
+
+    TOCropPixelBufferFree(&copy);
+    TOCropPixelBufferFree(&source);
+    return passed && copied;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = 5;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        iterations = (unsigned int)strtoul(argv[2], NULL, 10);
+    } else if (argc > 1) {
+        iterations = 0;
+    }
+
+    if (iterations == 0) {
+        fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+        return 2;
+    }
+
+    if (!TOCropPerspectiveBenchmarkCheckAccuracy()) {
+        fprintf(stderr, "the perspective warp doesn't match the reference\n");
+        return 1;
+    }
+
+    // A 12MP photo of a page, flattened at its full resolution
+    TOCropPixelBuffer source;
+    if (!TOCropPixelBufferAllocate(&source, 4032, 3024)) {
+        fprintf(stderr, "couldn't allocate the source\n");
+        return 1;
+    }
+    TOCropPerspectiveBenchmarkFill(&source);
+
+    const TOCropQuad quad = TOCropPerspectiveBenchmarkQuad((TOCropSize){4032, 3024}, false);
+    const TOCropSize outputSize = TOCropGeometryPerspectiveOutputSize(quad);
+    TOCropPixelBuffer destination;
+    TOCropHomography homography;
+    if (!TOCropPixelBufferAllocate(&destination, (size_t)round(outputSize.width), (size_t)round(outputSize.height)) ||
+        !TOCropGeometryHomographyForQuad(quad, (TOCropSize){(double)destination.width, (double)destination.height}, &homography)) {
+        fprintf(stderr, "couldn't allocate the output\n");
+        return 1;
+    }
+
+    const size_t threadCounts[] = {1, TOCropParallelDefaultThreadCount()};
+    printf("%-11s %-9s %8s %10s %12s\n", "output", "filter", "threads", "time (ms)", "Mpixels/s");
+
+    for (TOCropInterpolation interpolation = TOCropInterpolationBilinear; interpolation <= TOCropInterpolationBicubic;
+         interpolation++) {
+        for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+            if (t > 0 && threadCounts[t] == threadCounts[0]) {
+                continue;
+            }
+
+            const double start = TOCropPerspectiveBenchmarkCurrentTime();
+            for (unsigned int i = 0; i < iterations; i++) {
+                TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, interpolation,
+                                      threadCounts[t], NULL, &destination);
+            }
+            const double time = (TOCropPerspectiveBenchmarkCurrentTime() - start) / iterations;
+
+            char size[32];
+            snprintf(size, sizeof(size), "%zux%zu", destination.width, destination.height);
+            printf("%-11s %-9s %8zu %10.3f %12.1f\n", size,
+                   interpolation == TOCropInterpolationBicubic ? "bicubic" : "bilinear", threadCounts[t], time * 1e3,
+                   (double)(destination.width * destination.height) / time / 1e6);
+        }
+    }
+
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&destination);
+    return 0;
+}
@@ -0,0 +1,110 @@
+//
+//  TOCropTraceBenchmark.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Replays interaction traces recorded by `TOCropView` (see `startRecordingInteractionTrace`)
+// through the crop geometry, and reports how long each event took to apply, along with a
+// checksum of where the crop ended up. It only depends on the C geometry code, so it builds
+// and runs anywhere, including on Linux build machines:
+//
+//   cc -O2 -std=gnu99 -I Objective-C/TOCropViewController/Geometry -o crop-trace-benchmark
+//      Benchmarks/TOCropTraceBenchmark.c Objective-C/TOCropViewController/Geometry/*.c -lm
+//
+//   ./crop-trace-benchmark [-n iterations] session.trace [...]
+//
+// The checksum should only change when the geometry's behavior does, so compare it before
+// and after an optimization, as well as the timings.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TOCropTrace.h"
+
+static uint8_t *TOCropTraceBenchmarkReadFile(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) { return NULL; }
+
+    size_t capacity = 64 * 1024, used = 0;
+    uint8_t *bytes = malloc(capacity);
+    while (bytes != NULL) {
+        used += fread(bytes + used, 1, capacity - used, file);
+        if (used < capacity) { break; }
+
+        capacity *= 2;
+        uint8_t *grown = realloc(bytes, capacity);
+        if (grown == NULL) { free(bytes); }
+        bytes = grown;
+    }
+
+    const int failed = ferror(file);
+    fclose(file);
+    if (failed) {
+        free(bytes);
+        return NULL;
+    }
+
+    *length = used;
+    return bytes;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = 1000;
+    int firstPath = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        iterations = (unsigned int)strtoul(argv[2], NULL, 10);
+        firstPath = 3;
+    }
+
+    if (firstPath >= argc || iterations == 0) {
+        fprintf(stderr, "usage: %s [-n iterations] trace [trace ...]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%-32s %8s %10s %10s %10s  %s\n", "trace", "events", "p50 (us)", "p99 (us)", "max (us)", "checksum");
+
+    int status = 0;
+    for (int i = firstPath; i < argc; i++) {
+        size_t length = 0;
+        uint8_t *bytes = TOCropTraceBenchmarkReadFile(argv[i], &length);
+        if (bytes == NULL) {
+            fprintf(stderr, "%s: couldn't be read\n", argv[i]);
+            status = 1;
+            continue;
+        }
+
+        TOCropTraceReplayResult result;
+        if (!TOCropTraceReplay(bytes, length, iterations, &result)) {
+            fprintf(stderr, "%s: isn't a valid trace\n", argv[i]);
+            free(bytes);
+            status = 1;
+            continue;
+        }
+        free(bytes);
+
+        printf("%-32s %8zu %10.3f %10.3f %10.3f  %016" PRIx64 "\n", argv[i], result.eventCount,
+               result.medianEventTime * 1e6, result.p99EventTime * 1e6, result.maximumEventTime * 1e6,
+               result.checksum);
+    }
+
+    return status;
+}
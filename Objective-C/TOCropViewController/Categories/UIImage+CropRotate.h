@@ -22,10 +22,22 @@
 
 #import <UIKit/UIKit.h>
 
+#if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropViewConstants.h"
+#else
+#import <TOCropViewController/TOCropViewConstants.h>
+#endif
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface UIImage (TOCropRotate)
 
+/// The most threads a single crop will be spread across. Crops at multiples of 90 degrees are split
+/// into blocks of rows that are copied, masked or scaled on separate cores at once, and the result
+/// is identical however many are used. Set this to leave cores free for other work.
+/// Default is 0, which uses one thread per core.
+@property (class, nonatomic, assign) NSUInteger croppingThreadLimit;
+
 /// Crops a portion of an existing image object and returns it as a new image
 /// @param frame The region inside the image to crop (in the image's point space, ie image.size)
 /// @param angle If any, the angle the image is rotated at as well
@@ -34,6 +46,110 @@ NS_ASSUME_NONNULL_BEGIN
                                      angle:(NSInteger)angle
                               circularClip:(BOOL)circular;
 
+/// Crops a portion of an existing image that has been straightened by a fraction of a turn, such
+/// as to level a tilted horizon. The image is first rotated by `angle`, and then by `straighteningAngle`
+/// about its center, without changing its size, so `frame` should be inside the region that's still
+/// covered by the image (see `TOCropView.straighteningAngle`). Anything outside of it is transparent.
+///
+/// Each output pixel is interpolated from the 4x4 source pixels around where it lands, with blocks of
+/// rows spread across every core, and no source pixels outside of the frame are read.
+/// @param frame The region inside the straightened image to crop (in the image's point space, ie image.size)
+/// @param angle If any, the angle the image is rotated at, in multiples of 90
+/// @param straighteningAngle The angle the image is straightened by afterwards, in degrees. Positive angles are clockwise.
+/// @param circular Whether the resulting image is returned as a square or a circle
+- (nonnull UIImage *)croppedImageWithFrame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                              circularClip:(BOOL)circular;
+
+/// Flattens a four-sided region of the image into a rectangle, undoing the keystone distortion
+/// of a document, whiteboard or sign photographed at an angle. The image is first rotated by `angle`
+/// and straightened by `straighteningAngle`, as with `croppedImageWithFrame:angle:straighteningAngle:circularClip:`.
+///
+/// The flattened image is as wide and tall as the longer of each pair of opposite sides, so no part of the
+/// region is shrunk. Each output pixel is interpolated from the 4x4 source pixels around where it lands,
+/// in tiles spread across every core. Any part of the region outside of the image is transparent.
+/// @param quadrilateral The corners of the region (in the image's point space, ie image.size, after rotating
+///                      and straightening it). If they don't make a convex shape, the image is cropped to the
+///                      rectangle around them instead.
+/// @param angle If any, the angle the image is rotated at, in multiples of 90
+/// @param straighteningAngle If any, the angle the image is straightened by afterwards, in degrees
+- (nonnull UIImage *)perspectiveCorrectedImageWithQuadrilateral:(TOCropQuadrilateral)quadrilateral
+                                                          angle:(NSInteger)angle
+                                             straighteningAngle:(CGFloat)straighteningAngle;
+
+/// Crops a portion of an existing image and scales it to a new size in the same pass, such as
+/// when a crop is only ever going to be shared at 1080 pixels wide. The crop is never held in
+/// memory at its full size, and only the rows of the original image inside the frame are read.
+/// @param frame The region inside the image to crop (in the image's point space, ie image.size)
+/// @param angle If any, the angle the image is rotated at as well
+/// @param circular Whether the resulting image is returned as a square or a circle
+/// @param pixelSize The size of the resulting image, in pixels (Its scale will be 1)
+/// @param filter The filter used to scale the image
+- (nonnull UIImage *)croppedImageWithFrame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                              circularClip:(BOOL)circular
+                         scaledToPixelSize:(CGSize)pixelSize
+                                    filter:(TOCropViewResamplingFilter)filter;
+
+/// Builds a chain of copies of the image, each half the width and height of the one before it, for
+/// displaying a very large image at a fraction of its size without filtering all of its pixels.
+/// Each level is a 2x2 box filtered average of the one before, drawn at the same size in points
+/// as the image (with a lower `scale`), so any level can be swapped in for any other.
+/// @param minimumPixelSize Levels stop being added once neither side is larger than this, in pixels
+/// @return The levels in order, starting with the image itself. If the image isn't stored as
+///         8-bit pixels, the image is the only level.
+- (NSArray<UIImage *> *)mipmapImagesWithMinimumPixelSize:(NSUInteger)minimumPixelSize;
+
+/// Builds a small, blurred and darkened copy of the image, to be drawn in place of a live blur
+/// effect over the image. The blur is worked out once, on the CPU, rather than on every frame.
+/// The copy is the same size in points as the image (with a lower `scale`), and is always upright.
+/// @param maximumPixelSize The most pixels along either side of the copy (eg, 512)
+/// @param blurRadius The standard deviation of the blur, in the image's points
+/// @param brightness How bright the copy is relative to the image (0...1), as if it were behind a dark tint
+- (nullable UIImage *)backdropImageWithMaximumPixelSize:(NSUInteger)maximumPixelSize
+                                             blurRadius:(CGFloat)blurRadius
+                                             brightness:(CGFloat)brightness;
+
+/// Crops a portion of an existing image one horizontal band of rows at a time, without ever
+/// holding the whole cropped image in memory. Use this over `croppedImageWithFrame:angle:circularClip:`
+/// when the result won't comfortably fit in memory, such as very large images in app extensions.
+///
+/// Rows are delivered top band first, as 8-bit premultiplied RGBA pixels in the sRGB color space.
+///
+/// The budget covers the working memory of the crop itself. The image's own pixels are read
+/// through Core Graphics, which decodes (and caches) the whole image the first time it's read if
+/// it isn't decoded already, such as an image loaded lazily from a JPEG file. For those, crop the
+/// file with `writeLosslessJPEGCropFromURL:toURL:frame:angle:`, or load a downsampled copy through
+/// `CGImageSourceCreateThumbnailAtIndex` first.
+/// @param frame The region inside the image to crop (in the image's point space), rounded to whole pixels
+/// @param angle The angle the image is rotated at, which must be a multiple of 90
+/// @param memoryBudget The most working memory to use, in bytes (eg, 16MB)
+/// @param block Called with each band of rows. The bytes are only valid until the block returns. Return NO to stop early.
+/// @return NO if the crop couldn't be rendered, or the block stopped early
+- (BOOL)enumerateCroppedRowsWithFrame:(CGRect)frame
+                                angle:(NSInteger)angle
+                         memoryBudget:(NSUInteger)memoryBudget
+                           usingBlock:(NS_NOESCAPE BOOL (^)(const uint8_t *bytes, size_t bytesPerRow,
+                                                            NSInteger firstRow, NSInteger rowCount))block;
+
+/// Crops and rotates a JPEG file into a new JPEG file without decoding or re-encoding its pixels,
+/// so there is no loss in quality, and very little memory is needed.
+///
+/// The crop can only start on a block boundary (every 8 or 16 pixels), so the frame will be
+/// expanded outwards as needed. Any EXIF orientation in the file is applied along with the rotation.
+/// Progressive JPEGs aren't supported; crop those through `croppedImageWithFrame:angle:circularClip:` instead.
+/// @param sourceURL The file URL of the original JPEG
+/// @param destinationURL The file URL to write the new JPEG to
+/// @param frame The region to crop, in pixels of the image as displayed (ie, the rect reported by
+///              `cropViewController:didCropImageToRect:angle:` when the image was loaded from the file at a scale of 1)
+/// @param angle The angle to rotate the image by, which must be a multiple of 90
+/// @return The region that was actually cropped, or `CGRectNull` if the file couldn't be transformed
++ (CGRect)writeLosslessJPEGCropFromURL:(NSURL *)sourceURL
+                                 toURL:(NSURL *)destinationURL
+                                 frame:(CGRect)frame
+                                 angle:(NSInteger)angle;
+
 @end
 
 NS_ASSUME_NONNULL_END
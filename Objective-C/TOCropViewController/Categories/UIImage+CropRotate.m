@@ -22,8 +22,245 @@
 
 #import "UIImage+CropRotate.h"
 
+#import "TOCropBandRenderer.h"
+#import "TOCropBlur.h"
+#import "TOCropCircularMask.h"
+#import "TOCropGeometry.h"
+#import "TOCropJPEGTransform.h"
+#import "TOCropMipmap.h"
+#import "TOCropPerspective.h"
+#import "TOCropPixelBuffer.h"
+#import "TOCropPixelOrientation.h"
+#import "TOCropResample.h"
+#import "TOCropRotation.h"
+#import "TOCropStraighten.h"
+#import "TOCropTiledRenderer.h"
+
+// The most threads a crop may be spread over, or 0 for one per core
+static NSUInteger TOCropThreadLimit = 0;
+
+static void TOCropReleasePixelBufferData(void *info, const void *data, size_t size) {
+    free((void *)data);
+}
+
+// Wraps a pixel buffer in a new image with the same pixel format as `templateImage`, apart
+// from the layout of the channels, which is given by `bitmapInfo`.
+// Ownership of the buffer's storage passes to the image, even if creating it fails.
+static CGImageRef TOCropCreateImageWithPixelBuffer(TOCropPixelBuffer *buffer, CGImageRef templateImage,
+                                                   CGBitmapInfo bitmapInfo) {
+    CGDataProviderRef provider = CGDataProviderCreateWithData(NULL, buffer->data,
+                                                              buffer->bytesPerRow * buffer->height,
+                                                              TOCropReleasePixelBufferData);
+    if (provider == NULL) {
+        TOCropPixelBufferFree(buffer);
+        return NULL;
+    }
+
+    CGImageRef image = CGImageCreate(buffer->width, buffer->height,
+                                     CGImageGetBitsPerComponent(templateImage),
+                                     CGImageGetBitsPerPixel(templateImage),
+                                     buffer->bytesPerRow,
+                                     CGImageGetColorSpace(templateImage),
+                                     bitmapInfo,
+                                     provider, NULL, false,
+                                     CGImageGetRenderingIntent(templateImage));
+    CGDataProviderRelease(provider);
+
+#if defined(__IPHONE_18_0)
+    // Carry over how far above SDR white the original's values reach, or the HDR
+    // highlights would be displayed as if they were SDR
+    if (@available(iOS 18.0, *)) {
+        const float headroom = CGImageGetContentHeadroom(templateImage);
+        if (image != NULL && headroom > 1.0f) {
+            CGImageRef headroomImage = CGImageCreateCopyWithContentHeadroom(headroom, image);
+            if (headroomImage != NULL) {
+                CGImageRelease(image);
+                image = headroomImage;
+            }
+        }
+    }
+#endif
+
+    return image;
+}
+
+// Draws just the requested region of an image into a band buffer. This only bounds memory for
+// images whose pixels are already decoded: an image still backed by its compressed file (such as
+// one from `imageWithContentsOfFile:`) is decoded, and cached, in full by the first band drawn.
+static bool TOCropReadImageRegion(void *context, TOCropPixelRect region, TOCropPixelBuffer *buffer) {
+    CGImageRef imageRef = (CGImageRef)context;
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    CGContextRef bitmapContext = CGBitmapContextCreate(buffer->data, buffer->width, buffer->height, 8,
+                                                       buffer->bytesPerRow, colorSpace,
+                                                       kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+    CGColorSpaceRelease(colorSpace);
+    if (bitmapContext == NULL) {
+        return false;
+    }
+
+    // Core Graphics places the origin at the bottom left, so offset the image to match
+    const CGFloat imageWidth = CGImageGetWidth(imageRef);
+    const CGFloat imageHeight = CGImageGetHeight(imageRef);
+    const CGRect imageRect = (CGRect){-(CGFloat)region.x, -(imageHeight - (CGFloat)(region.y + region.height)),
+                                      imageWidth, imageHeight};
+    CGContextClearRect(bitmapContext, (CGRect){0.0f, 0.0f, buffer->width, buffer->height});
+    CGContextSetInterpolationQuality(bitmapContext, kCGInterpolationNone);
+    CGContextDrawImage(bitmapContext, imageRect, imageRef);
+    CGContextRelease(bitmapContext);
+    return true;
+}
+
+static bool TOCropWriteRowsToBlock(void *context, size_t firstRow, const TOCropPixelBuffer *rows) {
+    BOOL (^block)(const uint8_t *, size_t, NSInteger, NSInteger) = (__bridge id)context;
+    return block(rows->data, rows->bytesPerRow, (NSInteger)firstRow, (NSInteger)rows->height);
+}
+
+// The EXIF orientation tag value equivalent to each UIKit image orientation
+static int TOCropEXIFOrientationForImageOrientation(UIImageOrientation orientation) {
+    switch (orientation) {
+        case UIImageOrientationUpMirrored: return 2;
+        case UIImageOrientationDown: return 3;
+        case UIImageOrientationDownMirrored: return 4;
+        case UIImageOrientationLeftMirrored: return 5;
+        case UIImageOrientationRight: return 6;
+        case UIImageOrientationRightMirrored: return 7;
+        case UIImageOrientationLeft: return 8;
+        default: return 1;
+    }
+}
+
+// The circular mask scales every channel by its coverage, which needs premultiplied pixels.
+// Opaque images have their unused byte filled in as alpha, and are output as premultiplied.
+// Returns NO if pixels in this format can't be masked.
+static BOOL TOCropCircularMaskFormat(CGBitmapInfo bitmapInfo, uint32_t *alphaMask, CGBitmapInfo *maskedBitmapInfo) {
+    const CGImageAlphaInfo alphaInfo = (CGImageAlphaInfo)(bitmapInfo & kCGBitmapAlphaInfoMask);
+    const CGBitmapInfo byteOrder = bitmapInfo & kCGBitmapByteOrderMask;
+    *alphaMask = 0;
+    *maskedBitmapInfo = bitmapInfo;
+    if (alphaInfo == kCGImageAlphaNoneSkipFirst || alphaInfo == kCGImageAlphaNoneSkipLast) {
+        // In little endian layouts, the 'first' channel is the last byte in memory
+        const BOOL alphaFirst = (alphaInfo == kCGImageAlphaNoneSkipFirst);
+        const BOOL littleEndian = (byteOrder == kCGBitmapByteOrder32Little);
+        uint8_t maskBytes[TOCropPixelBufferBytesPerPixel] = {0};
+        maskBytes[(alphaFirst != littleEndian) ? 0 : TOCropPixelBufferBytesPerPixel - 1] = 0xff;
+        memcpy(alphaMask, maskBytes, sizeof(*alphaMask));
+        *maskedBitmapInfo = byteOrder | (alphaFirst ? kCGImageAlphaPremultipliedFirst : kCGImageAlphaPremultipliedLast);
+        return YES;
+    }
+    return (alphaInfo == kCGImageAlphaPremultipliedFirst || alphaInfo == kCGImageAlphaPremultipliedLast);
+}
+
+// The format the pixel kernels can read an image's pixels in directly, if any. Copies only
+// care about the size of each pixel, so any 4-channel 16-bit layout (half float or integer)
+// is moved as RGBA16F, and any packed 10-bit layout as RGB10A2, with every bit intact.
+static BOOL TOCropPixelFormatForImage(CGImageRef imageRef, TOCropPixelFormat *format) {
+    const size_t bitsPerComponent = CGImageGetBitsPerComponent(imageRef);
+    const size_t bitsPerPixel = CGImageGetBitsPerPixel(imageRef);
+    if (bitsPerComponent == 8 && bitsPerPixel == 32) {
+        *format = TOCropPixelFormatRGBA8;
+    } else if (bitsPerComponent == 10 && bitsPerPixel == 32) {
+        *format = TOCropPixelFormatRGB10A2;
+    } else if (bitsPerComponent == 16 && bitsPerPixel == 64) {
+        *format = TOCropPixelFormatRGBA16F;
+    } else {
+        return NO;
+    }
+    return (CGImageGetBytesPerRow(imageRef) % TOCropPixelFormatBytesPerPixel(*format) == 0);
+}
+
+// A region of an image's stored pixels, loaded for the pixel kernels to read
+typedef struct {
+    TOCropPixelBuffer buffer; // Just the pixels inside `region`
+    TOCropPixelRect region;   // Where those pixels are in the stored image
+    CFDataRef imageData;      // If the whole image had to be copied, the copy `buffer` points into
+} TOCropImagePixels;
+
+// Copies a region of an image's stored pixels into a buffer the size of the region. The image is narrowed
+// to the region and drawn, unscaled, in the same format, so only the region is copied. Core Graphics can't
+// draw into every format it can store (such as alpha that isn't premultiplied), so this fails for those.
+static bool TOCropDrawImageRegion(CGImageRef imageRef, TOCropPixelRect region, TOCropPixelBuffer *buffer) {
+    const CGRect regionRect = (CGRect){region.x, region.y, region.width, region.height};
+    CGImageRef regionImageRef = CGImageCreateWithImageInRect(imageRef, regionRect);
+    if (regionImageRef == NULL) {
+        return false;
+    }
+    CGContextRef context = CGBitmapContextCreate(buffer->data, region.width, region.height,
+                                                 CGImageGetBitsPerComponent(imageRef), buffer->bytesPerRow,
+                                                 CGImageGetColorSpace(imageRef), CGImageGetBitmapInfo(imageRef));
+    if (context == NULL) {
+        CGImageRelease(regionImageRef);
+        return false;
+    }
+
+    // The same format, color space and size, with nothing blended, so every value is copied as it is
+    CGContextSetBlendMode(context, kCGBlendModeCopy);
+    CGContextSetInterpolationQuality(context, kCGInterpolationNone);
+    CGContextDrawImage(context, (CGRect){0.0f, 0.0f, region.width, region.height}, regionImageRef);
+    CGContextRelease(context);
+    CGImageRelease(regionImageRef);
+    return true;
+}
+
+// Reads one band of an image's stored pixels for the resampler, which reads from several threads at once
+static bool TOCropReadStoredImageRegion(void *context, TOCropPixelRect region, TOCropPixelBuffer *buffer) {
+    return TOCropDrawImageRegion((CGImageRef)context, region, buffer);
+}
+
+// Loads the pixels of a region of an image, in the format they're stored in. Images Core Graphics can't
+// draw the region of fall back to copying all of their pixels, and reading the region out of that.
+static bool TOCropImagePixelsLoad(CGImageRef imageRef, TOCropPixelRect region, TOCropPixelFormat format,
+                                  TOCropImagePixels *pixels) {
+    memset(pixels, 0, sizeof(*pixels));
+    if (region.width == 0 || region.height == 0 ||
+        !TOCropPixelRectFitsInSize(region, CGImageGetWidth(imageRef), CGImageGetHeight(imageRef))) {
+        return false;
+    }
+    pixels->region = region;
+
+    if (TOCropPixelBufferAllocateWithFormat(&pixels->buffer, region.width, region.height, format)) {
+        if (TOCropDrawImageRegion(imageRef, region, &pixels->buffer)) {
+            return true;
+        }
+        TOCropPixelBufferFree(&pixels->buffer);
+    }
+
+    CFDataRef imageData = CGDataProviderCopyData(CGImageGetDataProvider(imageRef));
+    if (imageData == NULL) {
+        return false;
+    }
+    const size_t bytesPerRow = CGImageGetBytesPerRow(imageRef);
+    const size_t bytesPerPixel = TOCropPixelFormatBytesPerPixel(format);
+    const TOCropPixelBuffer image = {(uint8_t *)CFDataGetBytePtr(imageData), CGImageGetWidth(imageRef),
+                                     CGImageGetHeight(imageRef), bytesPerRow, format};
+    if ((size_t)CFDataGetLength(imageData) < TOCropPixelBufferByteCount(&image)) {
+        CFRelease(imageData);
+        return false;
+    }
+    pixels->imageData = imageData;
+    pixels->buffer = (TOCropPixelBuffer){image.data + (region.y * bytesPerRow) + (region.x * bytesPerPixel),
+                                         region.width, region.height, bytesPerRow, format};
+    return true;
+}
+
+static void TOCropImagePixelsRelease(TOCropImagePixels *pixels) {
+    if (pixels->imageData != NULL) {
+        CFRelease(pixels->imageData);
+    } else {
+        TOCropPixelBufferFree(&pixels->buffer);
+    }
+    memset(pixels, 0, sizeof(*pixels));
+}
+
 @implementation UIImage (TOCropRotate)
 
++ (NSUInteger)croppingThreadLimit {
+    return __atomic_load_n(&TOCropThreadLimit, __ATOMIC_RELAXED);
+}
+
++ (void)setCroppingThreadLimit:(NSUInteger)croppingThreadLimit {
+    __atomic_store_n(&TOCropThreadLimit, croppingThreadLimit, __ATOMIC_RELAXED);
+}
+
 - (BOOL)hasAlpha {
     CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(self.CGImage);
     return (alphaInfo == kCGImageAlphaFirst || alphaInfo == kCGImageAlphaLast ||
@@ -31,6 +268,42 @@
 }
 
 - (UIImage *)croppedImageWithFrame:(CGRect)frame angle:(NSInteger)angle circularClip:(BOOL)circular {
+    return [self croppedImageWithFrame:frame angle:angle straighteningAngle:0.0f circularClip:circular renderProgress:NULL];
+}
+
+- (UIImage *)croppedImageWithFrame:(CGRect)frame
+                             angle:(NSInteger)angle
+                straighteningAngle:(CGFloat)straighteningAngle
+                      circularClip:(BOOL)circular {
+    return [self croppedImageWithFrame:frame angle:angle straighteningAngle:straighteningAngle circularClip:circular
+                        renderProgress:NULL];
+}
+
+// Used by `TOCropRenderJob`, which renders on a background queue. Rows rendered are counted
+// in `progress`, and nil is returned if it is cancelled before the crop finishes.
+- (nullable UIImage *)croppedImageWithFrame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                              circularClip:(BOOL)circular
+                            renderProgress:(nullable TOCropRenderProgress *)progress {
+    // Crops at multiples of 90 degrees are a straight remapping of pixels (plus an edge mask
+    // when circular), and straightened ones are interpolated straight out of the source pixels,
+    // so skip the full resampling pass of drawing through a rotated context when possible
+    UIImage *pixelCroppedImage = nil;
+    if (straighteningAngle == 0.0f) {
+        pixelCroppedImage = [self pixelCroppedImageWithFrame:frame angle:angle circularClip:circular
+                                              renderProgress:progress];
+    } else {
+        pixelCroppedImage = [self straightenedImageWithFrame:frame angle:angle straighteningAngle:straighteningAngle
+                                                circularClip:circular renderProgress:progress];
+    }
+    if (pixelCroppedImage) {
+        return pixelCroppedImage;
+    }
+    if (progress && __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED)) {
+        return nil;
+    }
+
     UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
 
 #if defined(__IPHONE_17_0)
@@ -48,7 +321,7 @@
     }
 #endif
 
-    format.opaque = !self.hasAlpha && !circular;
+    format.opaque = !self.hasAlpha && !circular && straighteningAngle == 0.0f;
     format.scale = self.scale;
 
     UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:frame.size format:format];
@@ -64,15 +337,21 @@
         // Offset the origin (Which is the top left corner) to start where our cropping origin is
         CGContextTranslateCTM(context, -frame.origin.x, -frame.origin.y);
 
+        // Work out the new bounding size of the canvas after rotation
+        CGFloat rotation = angle * (M_PI / 180.0f);
+        CGRect imageBounds = (CGRect){CGPointZero, self.size};
+        CGRect rotatedBounds = CGRectApplyAffineTransform(imageBounds, CGAffineTransformMakeRotation(rotation));
+
+        // If the image is straightened, turn the whole canvas about its center, without changing its size
+        if (straighteningAngle != 0.0f) {
+            const CGPoint center = (CGPoint){CGRectGetWidth(rotatedBounds) * 0.5f, CGRectGetHeight(rotatedBounds) * 0.5f};
+            CGContextTranslateCTM(context, center.x, center.y);
+            CGContextRotateCTM(context, straighteningAngle * (M_PI / 180.0f));
+            CGContextTranslateCTM(context, -center.x, -center.y);
+        }
+
         // If an angle was supplied, rotate the entire canvas + coordinate space to match
         if (angle != 0) {
-            // Rotation in radians
-            CGFloat rotation = angle * (M_PI / 180.0f);
-
-            // Work out the new bounding size of the canvas after rotation
-            CGRect imageBounds = (CGRect){CGPointZero, self.size};
-            CGRect rotatedBounds = CGRectApplyAffineTransform(imageBounds,
-                                                              CGAffineTransformMakeRotation(rotation));
             // As we're rotating from the top left corner, and not the center of the canvas, the frame
             // will have rotated out of our visible canvas. Compensate for this.
             CGContextTranslateCTM(context, -rotatedBounds.origin.x, -rotatedBounds.origin.y);
@@ -91,4 +370,616 @@
     return [UIImage imageWithCGImage:croppedImage.CGImage scale:self.scale orientation:UIImageOrientationUp];
 }
 
+- (UIImage *)perspectiveCorrectedImageWithQuadrilateral:(TOCropQuadrilateral)quadrilateral
+                                                  angle:(NSInteger)angle
+                                     straighteningAngle:(CGFloat)straighteningAngle {
+    return [self perspectiveCorrectedImageWithQuadrilateral:quadrilateral angle:angle
+                                         straighteningAngle:straighteningAngle renderProgress:NULL];
+}
+
+// Used by `TOCropRenderJob`. Rows rendered are counted in `progress`, and nil is returned if it is cancelled.
+- (nullable UIImage *)perspectiveCorrectedImageWithQuadrilateral:(TOCropQuadrilateral)quadrilateral
+                                                           angle:(NSInteger)angle
+                                              straighteningAngle:(CGFloat)straighteningAngle
+                                                  renderProgress:(nullable TOCropRenderProgress *)progress {
+    const TOCropQuad quad = {{quadrilateral.topLeft.x, quadrilateral.topLeft.y},
+                             {quadrilateral.topRight.x, quadrilateral.topRight.y},
+                             {quadrilateral.bottomRight.x, quadrilateral.bottomRight.y},
+                             {quadrilateral.bottomLeft.x, quadrilateral.bottomLeft.y}};
+
+    UIImage *warpedImage = [self warpedImageWithQuad:quad angle:angle straighteningAngle:straighteningAngle
+                                      renderProgress:progress];
+    if (warpedImage) {
+        return warpedImage;
+    }
+    if (progress && __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED)) {
+        return nil;
+    }
+
+    // Core Graphics has no way to draw through a perspective transform, so a quad that
+    // can't be flattened falls back to a regular crop of the rect around it
+    const TOCropRect boundingRect = TOCropGeometryQuadBoundingRect(quad);
+    const CGRect frame = (CGRect){{boundingRect.origin.x, boundingRect.origin.y},
+                                  {boundingRect.size.width, boundingRect.size.height}};
+    return [self croppedImageWithFrame:frame angle:angle straighteningAngle:straighteningAngle circularClip:NO
+                        renderProgress:progress];
+}
+
+- (UIImage *)croppedImageWithFrame:(CGRect)frame
+                             angle:(NSInteger)angle
+                      circularClip:(BOOL)circular
+                 scaledToPixelSize:(CGSize)pixelSize
+                            filter:(TOCropViewResamplingFilter)filter {
+    const CGSize outputSize = (CGSize){MAX(round(pixelSize.width), 1.0f), MAX(round(pixelSize.height), 1.0f)};
+
+    // Crop and scale straight out of the source pixels where possible
+    CGImageRef resampledImageRef = [self newResampledImageWithFrame:frame angle:angle circularClip:circular
+                                                          pixelSize:outputSize filter:filter];
+    if (resampledImageRef) {
+        UIImage *resampledImage = [UIImage imageWithCGImage:resampledImageRef scale:1.0f
+                                                orientation:UIImageOrientationUp];
+        CGImageRelease(resampledImageRef);
+        return resampledImage;
+    }
+
+    // Otherwise, crop at full size and let Core Graphics scale the result
+    UIImage *croppedImage = [self croppedImageWithFrame:frame angle:angle circularClip:circular];
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.opaque = !croppedImage.hasAlpha && !circular;
+    format.scale = 1.0f;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:outputSize format:format];
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
+        CGContextSetInterpolationQuality(rendererContext.CGContext, kCGInterpolationHigh);
+        [croppedImage drawInRect:(CGRect){CGPointZero, outputSize}];
+    }];
+}
+
+- (nullable UIImage *)pixelCroppedImageWithFrame:(CGRect)frame
+                                           angle:(NSInteger)angle
+                                    circularClip:(BOOL)circular
+                                  renderProgress:(nullable TOCropRenderProgress *)progress {
+    // HDR images are cropped in their original format too, so their values are never
+    // tone-mapped or widened to 32-bit floats along the way
+    CGImageRef imageRef = self.CGImage;
+    if (imageRef == NULL || angle % 90 != 0) {
+        return nil;
+    }
+
+    // The crop frame is in points, but the pixel paths only deal in whole pixels
+    const CGFloat scale = self.scale;
+    const CGRect pixelFrame = (CGRect){frame.origin.x * scale, frame.origin.y * scale,
+                                       frame.size.width * scale, frame.size.height * scale};
+    const CGRect roundedFrame = (CGRect){round(pixelFrame.origin.x), round(pixelFrame.origin.y),
+                                         round(pixelFrame.size.width), round(pixelFrame.size.height)};
+    if (fabs(CGRectGetMinX(pixelFrame) - CGRectGetMinX(roundedFrame)) > 0.01f ||
+        fabs(CGRectGetMinY(pixelFrame) - CGRectGetMinY(roundedFrame)) > 0.01f ||
+        fabs(CGRectGetWidth(pixelFrame) - CGRectGetWidth(roundedFrame)) > 0.01f ||
+        fabs(CGRectGetHeight(pixelFrame) - CGRectGetHeight(roundedFrame)) > 0.01f ||
+        CGRectGetMinX(roundedFrame) < 0.0f || CGRectGetMinY(roundedFrame) < 0.0f) {
+        return nil;
+    }
+    TOCropPixelRect rect = {(size_t)CGRectGetMinX(roundedFrame), (size_t)CGRectGetMinY(roundedFrame),
+                            (size_t)CGRectGetWidth(roundedFrame), (size_t)CGRectGetHeight(roundedFrame)};
+
+    const TOCropPixelOrientation orientation = [self pixelOrientationWithAngle:angle];
+    CGImageRef croppedImageRef = NULL;
+    if (TOCropPixelOrientationIsIdentity(orientation) && !circular) {
+        // An unrotated crop is a contiguous window onto the existing pixels, which Core Graphics
+        // can reference in place. Nothing is copied until the image is drawn or encoded.
+        if (!TOCropPixelRectFitsInSize(rect, CGImageGetWidth(imageRef), CGImageGetHeight(imageRef))) {
+            return nil;
+        }
+        croppedImageRef = CGImageCreateWithImageInRect(imageRef, roundedFrame);
+    } else {
+        croppedImageRef = [self newOrientedImageWithPixelRect:rect orientation:orientation circularClip:circular
+                                               renderProgress:progress];
+    }
+
+    if (croppedImageRef == NULL) {
+        return nil;
+    }
+
+    UIImage *croppedImage = [UIImage imageWithCGImage:croppedImageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(croppedImageRef);
+    return croppedImage;
+}
+
+- (NSArray<UIImage *> *)mipmapImagesWithMinimumPixelSize:(NSUInteger)minimumPixelSize {
+    CGImageRef imageRef = self.CGImage;
+    TOCropPixelFormat pixelFormat;
+    if (imageRef == NULL || !TOCropPixelFormatForImage(imageRef, &pixelFormat) || pixelFormat != TOCropPixelFormatRGBA8) {
+        return @[self];
+    }
+
+    CFDataRef pixelData = CGDataProviderCopyData(CGImageGetDataProvider(imageRef));
+    if (pixelData == NULL) {
+        return @[self];
+    }
+
+    TOCropPixelBuffer source = {(uint8_t *)CFDataGetBytePtr(pixelData),
+                                CGImageGetWidth(imageRef),
+                                CGImageGetHeight(imageRef),
+                                CGImageGetBytesPerRow(imageRef),
+                                pixelFormat};
+    TOCropMipmapPyramid pyramid;
+    const BOOL success = ((size_t)CFDataGetLength(pixelData) >= TOCropPixelBufferByteCount(&source) &&
+                          TOCropMipmapPyramidBuild(&source, minimumPixelSize,
+                                                   (size_t)UIImage.croppingThreadLimit, &pyramid));
+    if (!success) {
+        CFRelease(pixelData);
+        return @[self];
+    }
+
+    // Each level's storage is handed over to its image as it's created
+    NSMutableArray<UIImage *> *images = [NSMutableArray arrayWithObject:self];
+    CGFloat scale = self.scale;
+    for (size_t i = 1; i < pyramid.count; i++) {
+        scale *= 0.5f;
+        CGImageRef levelImageRef = TOCropCreateImageWithPixelBuffer(&pyramid.levels[i], imageRef,
+                                                                    CGImageGetBitmapInfo(imageRef));
+        if (levelImageRef == NULL) {
+            // Release the levels that weren't handed over yet
+            for (size_t j = i + 1; j < pyramid.count; j++) {
+                TOCropPixelBufferFree(&pyramid.levels[j]);
+            }
+            break;
+        }
+        [images addObject:[UIImage imageWithCGImage:levelImageRef scale:scale orientation:self.imageOrientation]];
+        CGImageRelease(levelImageRef);
+    }
+    CFRelease(pixelData);
+
+    return images;
+}
+
+- (nullable UIImage *)backdropImageWithMaximumPixelSize:(NSUInteger)maximumPixelSize
+                                             blurRadius:(CGFloat)blurRadius
+                                             brightness:(CGFloat)brightness {
+    const CGSize size = self.size;
+    if (size.width <= 0.0f || size.height <= 0.0f || maximumPixelSize == 0) {
+        return nil;
+    }
+
+    // Blurring averages away any detail, so there's no point in blurring more pixels than this
+    const CGFloat pixelScale = MIN((CGFloat)maximumPixelSize / MAX(size.width, size.height), self.scale);
+    const size_t width = MAX((size_t)round(size.width * pixelScale), 1);
+    const size_t height = MAX((size_t)round(size.height * pixelScale), 1);
+
+    TOCropPixelBuffer buffer;
+    if (!TOCropPixelBufferAllocate(&buffer, width, height)) {
+        return nil;
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    CGContextRef bitmapContext = CGBitmapContextCreate(buffer.data, width, height, 8, buffer.bytesPerRow, colorSpace,
+                                                       kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+    CGColorSpaceRelease(colorSpace);
+    if (bitmapContext == NULL) {
+        TOCropPixelBufferFree(&buffer);
+        return nil;
+    }
+
+    // Draw through UIKit, with the origin flipped to the top left, so the image's orientation is applied
+    CGContextTranslateCTM(bitmapContext, 0.0f, height);
+    CGContextScaleCTM(bitmapContext, 1.0f, -1.0f);
+    CGContextSetInterpolationQuality(bitmapContext, kCGInterpolationMedium);
+    UIGraphicsPushContext(bitmapContext);
+    [self drawInRect:(CGRect){0.0f, 0.0f, width, height}];
+    UIGraphicsPopContext();
+
+    CGImageRef imageRef = NULL;
+    if (TOCropPixelBufferBlur(&buffer, blurRadius * pixelScale, brightness, (size_t)UIImage.croppingThreadLimit)) {
+        imageRef = CGBitmapContextCreateImage(bitmapContext);
+    }
+    CGContextRelease(bitmapContext);
+    TOCropPixelBufferFree(&buffer);
+    if (imageRef == NULL) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:(CGFloat)width / size.width
+                                   orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+- (BOOL)enumerateCroppedRowsWithFrame:(CGRect)frame
+                                angle:(NSInteger)angle
+                         memoryBudget:(NSUInteger)memoryBudget
+                           usingBlock:(NS_NOESCAPE BOOL (^)(const uint8_t *bytes, size_t bytesPerRow,
+                                                            NSInteger firstRow, NSInteger rowCount))block {
+    CGImageRef imageRef = self.CGImage;
+    if (imageRef == NULL || angle % 90 != 0) {
+        return NO;
+    }
+
+    const CGFloat scale = self.scale;
+    const CGRect pixelFrame = (CGRect){round(frame.origin.x * scale), round(frame.origin.y * scale),
+                                       round(frame.size.width * scale), round(frame.size.height * scale)};
+    if (CGRectGetMinX(pixelFrame) < 0.0f || CGRectGetMinY(pixelFrame) < 0.0f) {
+        return NO;
+    }
+    TOCropPixelRect rect = {(size_t)CGRectGetMinX(pixelFrame), (size_t)CGRectGetMinY(pixelFrame),
+                            (size_t)CGRectGetWidth(pixelFrame), (size_t)CGRectGetHeight(pixelFrame)};
+
+    TOCropBandSource source = {CGImageGetWidth(imageRef), CGImageGetHeight(imageRef),
+                               TOCropReadImageRegion, (void *)imageRef};
+    TOCropBandSink sink = {TOCropWriteRowsToBlock, (__bridge void *)block};
+    return TOCropRenderBands(&source, rect, [self pixelOrientationWithAngle:angle], memoryBudget, &sink);
+}
+
++ (CGRect)writeLosslessJPEGCropFromURL:(NSURL *)sourceURL
+                                 toURL:(NSURL *)destinationURL
+                                 frame:(CGRect)frame
+                                 angle:(NSInteger)angle {
+    if (!sourceURL.isFileURL || !destinationURL.isFileURL || angle % 90 != 0) {
+        return CGRectNull;
+    }
+
+    const CGRect pixelFrame = CGRectIntegral(frame);
+    if (CGRectGetMinX(pixelFrame) < 0.0f || CGRectGetMinY(pixelFrame) < 0.0f || CGRectIsEmpty(pixelFrame)) {
+        return CGRectNull;
+    }
+    TOCropPixelRect rect = {(size_t)CGRectGetMinX(pixelFrame), (size_t)CGRectGetMinY(pixelFrame),
+                            (size_t)CGRectGetWidth(pixelFrame), (size_t)CGRectGetHeight(pixelFrame)};
+
+    TOCropPixelRect croppedRect;
+    if (!TOCropJPEGTransformFile(sourceURL.fileSystemRepresentation, destinationURL.fileSystemRepresentation,
+                                 rect, TOCropQuarterTurnsForAngle(angle), &croppedRect)) {
+        return CGRectNull;
+    }
+    return (CGRect){croppedRect.x, croppedRect.y, croppedRect.width, croppedRect.height};
+}
+
+// Crops and scales the image's pixels together, without allocating the crop at full size.
+// Returns NULL if the image isn't stored in a pixel format the kernels can filter.
+- (nullable CGImageRef)newResampledImageWithFrame:(CGRect)frame
+                                            angle:(NSInteger)angle
+                                     circularClip:(BOOL)circular
+                                        pixelSize:(CGSize)pixelSize
+                                           filter:(TOCropViewResamplingFilter)filter CF_RETURNS_RETAINED {
+    CGImageRef imageRef = self.CGImage;
+    TOCropPixelFormat pixelFormat;
+    if (imageRef == NULL || angle % 90 != 0 || !TOCropPixelFormatForImage(imageRef, &pixelFormat) ||
+        pixelFormat != TOCropPixelFormatRGBA8) {
+        return NULL;
+    }
+
+#if defined(__IPHONE_17_0)
+    if (@available(iOS 17.0, *)) {
+        if (self.isHighDynamicRange) {
+            return NULL;
+        }
+    }
+#endif
+
+    // Every channel is filtered the same way, which is only correct once alpha is premultiplied
+    CGBitmapInfo bitmapInfo = CGImageGetBitmapInfo(imageRef);
+    const CGImageAlphaInfo alphaInfo = (CGImageAlphaInfo)(bitmapInfo & kCGBitmapAlphaInfoMask);
+    if (alphaInfo == kCGImageAlphaFirst || alphaInfo == kCGImageAlphaLast) {
+        return NULL;
+    }
+    uint32_t alphaMask = 0;
+    if (circular && !TOCropCircularMaskFormat(bitmapInfo, &alphaMask, &bitmapInfo)) {
+        return NULL;
+    }
+
+    // Any fraction of a pixel in the frame is lost in the scaling anyway, so round to whole pixels
+    const CGFloat scale = self.scale;
+    const CGRect pixelFrame = (CGRect){round(frame.origin.x * scale), round(frame.origin.y * scale),
+                                       round(frame.size.width * scale), round(frame.size.height * scale)};
+    if (CGRectGetMinX(pixelFrame) < 0.0f || CGRectGetMinY(pixelFrame) < 0.0f || CGRectIsEmpty(pixelFrame)) {
+        return NULL;
+    }
+    TOCropPixelRect rect = {(size_t)CGRectGetMinX(pixelFrame), (size_t)CGRectGetMinY(pixelFrame),
+                            (size_t)CGRectGetWidth(pixelFrame), (size_t)CGRectGetHeight(pixelFrame)};
+
+    // The crop's pixels are read a few rows at a time as they're filtered, so the final image is the only
+    // thing allocated at more than a few rows in size
+    const TOCropPixelOrientation orientation = [self pixelOrientationWithAngle:angle];
+    const TOCropBandSource source = {CGImageGetWidth(imageRef), CGImageGetHeight(imageRef),
+                                     TOCropReadStoredImageRegion, (void *)imageRef};
+    TOCropPixelBuffer destination;
+    BOOL success = TOCropPixelBufferAllocate(&destination, (size_t)pixelSize.width, (size_t)pixelSize.height);
+    if (success) {
+        const TOCropResampleFilter resampleFilter = (filter == TOCropViewResamplingFilterBox ? TOCropResampleFilterBox :
+                                                     filter == TOCropViewResamplingFilterLanczos ? TOCropResampleFilterLanczos :
+                                                     TOCropResampleFilterBilinear);
+        const size_t threadLimit = (size_t)UIImage.croppingThreadLimit;
+        success = TOCropResampleBands(&source, rect, orientation, resampleFilter, threadLimit, &destination);
+
+        // Circles are masked after scaling, so the edge is anti-aliased at the final size
+        if (success && circular) {
+            TOCropPixelBuffer masked;
+            success = TOCropPixelBufferAllocate(&masked, destination.width, destination.height);
+            if (success) {
+                const TOCropPixelRect outputRect = {0, 0, destination.width, destination.height};
+                const TOCropTiledRenderOptions options = {true, alphaMask, threadLimit, NULL};
+                success = TOCropRenderRegion(&destination, outputRect, TOCropPixelOrientationIdentity(),
+                                             options, &masked);
+                TOCropPixelBufferFree(&destination);
+                destination = masked;
+            }
+        }
+        if (!success) {
+            TOCropPixelBufferFree(&destination);
+        }
+    }
+    if (!success) {
+        return NULL;
+    }
+
+    return TOCropCreateImageWithPixelBuffer(&destination, imageRef, bitmapInfo);
+}
+
+// Straightens the image and crops it straight out of its pixels, without drawing through a rotated
+// context. Returns nil if the image isn't stored in a pixel format the kernel can interpolate.
+- (nullable UIImage *)straightenedImageWithFrame:(CGRect)frame
+                                           angle:(NSInteger)angle
+                              straighteningAngle:(CGFloat)straighteningAngle
+                                    circularClip:(BOOL)circular
+                                  renderProgress:(nullable TOCropRenderProgress *)progress {
+    CGImageRef imageRef = self.CGImage;
+    TOCropPixelFormat pixelFormat;
+    if (imageRef == NULL || angle % 90 != 0 || !TOCropPixelFormatForImage(imageRef, &pixelFormat) ||
+        pixelFormat != TOCropPixelFormatRGBA8) {
+        return nil;
+    }
+
+#if defined(__IPHONE_17_0)
+    if (@available(iOS 17.0, *)) {
+        if (self.isHighDynamicRange) {
+            return nil;
+        }
+    }
+#endif
+
+    // Every channel is interpolated the same way, which is only correct once alpha is premultiplied
+    CGBitmapInfo bitmapInfo = CGImageGetBitmapInfo(imageRef);
+    const CGImageAlphaInfo alphaInfo = (CGImageAlphaInfo)(bitmapInfo & kCGBitmapAlphaInfoMask);
+    if (alphaInfo == kCGImageAlphaFirst || alphaInfo == kCGImageAlphaLast) {
+        return nil;
+    }
+    uint32_t alphaMask = 0;
+    if (circular && !TOCropCircularMaskFormat(bitmapInfo, &alphaMask, &bitmapInfo)) {
+        return nil;
+    }
+
+    // Every pixel is interpolated anyway, so any fraction of a pixel in the frame is rounded away
+    const CGFloat scale = self.scale;
+    const CGRect pixelFrame = (CGRect){round(frame.origin.x * scale), round(frame.origin.y * scale),
+                                       round(frame.size.width * scale), round(frame.size.height * scale)};
+    if (CGRectGetMinX(pixelFrame) < 0.0f || CGRectGetMinY(pixelFrame) < 0.0f || CGRectIsEmpty(pixelFrame)) {
+        return nil;
+    }
+    TOCropPixelRect rect = {(size_t)CGRectGetMinX(pixelFrame), (size_t)CGRectGetMinY(pixelFrame),
+                            (size_t)CGRectGetWidth(pixelFrame), (size_t)CGRectGetHeight(pixelFrame)};
+
+    // Only the part of the stored image that the rotated crop passes over (plus the filter's reach) is loaded
+    const TOCropPixelOrientation orientation = [self pixelOrientationWithAngle:angle];
+    const size_t width = CGImageGetWidth(imageRef), height = CGImageGetHeight(imageRef);
+    if (!TOCropPixelRectFitsInSize(rect, orientation.transpose ? height : width, orientation.transpose ? width : height)) {
+        return nil;
+    }
+    const TOCropPixelRect sourceRect = TOCropStraightenSourceRect(rect, orientation, straighteningAngle,
+                                                                  TOCropInterpolationBicubic, width, height);
+    TOCropImagePixels pixels;
+    if (!TOCropImagePixelsLoad(imageRef, sourceRect, pixelFormat, &pixels)) {
+        return nil;
+    }
+
+    TOCropPixelBuffer destination;
+    BOOL success = TOCropPixelBufferAllocate(&destination, rect.width, rect.height);
+    if (success) {
+        const size_t threadLimit = (size_t)UIImage.croppingThreadLimit;
+        success = TOCropStraightenRegionInWindow(&pixels.buffer, pixels.region, width, height, rect, orientation,
+                                                 straighteningAngle, TOCropInterpolationBicubic, threadLimit,
+                                                 progress, &destination);
+
+        // Circles are masked afterwards, since the straightened pixels are already in the right place
+        if (success && circular) {
+            TOCropPixelBuffer masked;
+            success = TOCropPixelBufferAllocate(&masked, destination.width, destination.height);
+            if (success) {
+                const TOCropPixelRect outputRect = {0, 0, destination.width, destination.height};
+                const TOCropTiledRenderOptions options = {true, alphaMask, threadLimit, NULL};
+                success = TOCropRenderRegion(&destination, outputRect, TOCropPixelOrientationIdentity(),
+                                             options, &masked);
+                TOCropPixelBufferFree(&destination);
+                destination = masked;
+            }
+        }
+        if (!success) {
+            TOCropPixelBufferFree(&destination);
+        }
+    }
+    TOCropImagePixelsRelease(&pixels);
+    if (!success) {
+        return nil;
+    }
+
+    CGImageRef straightenedImageRef = TOCropCreateImageWithPixelBuffer(&destination, imageRef, bitmapInfo);
+    if (straightenedImageRef == NULL) {
+        return nil;
+    }
+
+    UIImage *straightenedImage = [UIImage imageWithCGImage:straightenedImageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(straightenedImageRef);
+    return straightenedImage;
+}
+
+// Flattens a quad of the image straight out of its pixels. Returns nil if the quad isn't convex,
+// or the image can't be redrawn as 8-bit pixels.
+- (nullable UIImage *)warpedImageWithQuad:(TOCropQuad)quad
+                                    angle:(NSInteger)angle
+                       straighteningAngle:(CGFloat)straighteningAngle
+                           renderProgress:(nullable TOCropRenderProgress *)progress {
+    CGImageRef imageRef = self.CGImage;
+    if (imageRef == NULL || angle % 90 != 0 || !TOCropGeometryQuadIsConvex(quad)) {
+        return nil;
+    }
+
+    // Work out where each corner lands in the oriented image's pixels before it was straightened,
+    // by turning it back the other way about the center, so the warp undoes both at once
+    const CGFloat scale = self.scale;
+    const TOCropPixelOrientation orientation = [self pixelOrientationWithAngle:angle];
+    const size_t width = CGImageGetWidth(imageRef), height = CGImageGetHeight(imageRef);
+    const double centerX = (double)(orientation.transpose ? height : width) * 0.5;
+    const double centerY = (double)(orientation.transpose ? width : height) * 0.5;
+    const double radians = straighteningAngle * (M_PI / 180.0);
+    const double cosine = cos(radians);
+    const double sine = sin(radians);
+    const TOCropPoint corners[] = {quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft};
+    TOCropPoint pixelCorners[4];
+    for (NSInteger i = 0; i < 4; i++) {
+        const double offsetX = corners[i].x * scale - centerX;
+        const double offsetY = corners[i].y * scale - centerY;
+        pixelCorners[i] = (TOCropPoint){centerX + cosine * offsetX + sine * offsetY,
+                                        centerY - sine * offsetX + cosine * offsetY};
+    }
+    const TOCropQuad pixelQuad = {pixelCorners[0], pixelCorners[1], pixelCorners[2], pixelCorners[3]};
+
+    const TOCropSize outputSize = TOCropGeometryPerspectiveOutputSize(pixelQuad);
+    const size_t outputWidth = (size_t)MAX(round(outputSize.width), 1.0);
+    const size_t outputHeight = (size_t)MAX(round(outputSize.height), 1.0);
+    TOCropHomography homography;
+    if (!TOCropGeometryHomographyForQuad(pixelQuad, (TOCropSize){outputWidth, outputHeight}, &homography)) {
+        return nil;
+    }
+
+    // Only the part of the stored image under the quad (plus the filter's reach) is loaded
+    const TOCropPixelRect sourceRect = TOCropPerspectiveSourceRect(homography.m, outputWidth, outputHeight, orientation,
+                                                                   TOCropInterpolationBicubic, width, height);
+
+    // The warp reads 8-bit premultiplied pixels straight out of the image. Anything else (including
+    // opaque images, which need an alpha channel for any part of the quad outside of the image)
+    // has just that part redrawn in that format first, as it's stored, since the warp applies the orientation.
+    TOCropPixelFormat pixelFormat;
+    const CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(imageRef);
+    BOOL readsPixelsDirectly = (TOCropPixelFormatForImage(imageRef, &pixelFormat) && pixelFormat == TOCropPixelFormatRGBA8 &&
+                                (alphaInfo == kCGImageAlphaPremultipliedFirst || alphaInfo == kCGImageAlphaPremultipliedLast));
+#if defined(__IPHONE_17_0)
+    if (@available(iOS 17.0, *)) {
+        readsPixelsDirectly = readsPixelsDirectly && !self.isHighDynamicRange;
+    }
+#endif
+
+    // Kept until the end, since `pixelsRef` may point into it
+    NS_VALID_UNTIL_END_OF_SCOPE UIImage *redrawnImage = nil;
+    CGImageRef pixelsRef = imageRef;
+    TOCropPixelRect pixelsRect = sourceRect;
+    if (!readsPixelsDirectly) {
+        CGImageRef regionRef = CGImageCreateWithImageInRect(imageRef, CGRectMake(sourceRect.x, sourceRect.y,
+                                                                                  sourceRect.width, sourceRect.height));
+        if (regionRef == NULL) {
+            return nil;
+        }
+        UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+        format.scale = 1.0f;
+        format.opaque = NO;
+        format.preferredRange = UIGraphicsImageRendererFormatRangeStandard;
+        const CGSize regionSize = (CGSize){sourceRect.width, sourceRect.height};
+        UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:regionSize format:format];
+        redrawnImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
+            [[UIImage imageWithCGImage:regionRef] drawAtPoint:CGPointZero];
+        }];
+        CGImageRelease(regionRef);
+        pixelsRef = redrawnImage.CGImage;
+        pixelsRect = (TOCropPixelRect){0, 0, sourceRect.width, sourceRect.height};
+        if (pixelsRef == NULL || CGImageGetWidth(pixelsRef) != sourceRect.width ||
+            CGImageGetHeight(pixelsRef) != sourceRect.height ||
+            !TOCropPixelFormatForImage(pixelsRef, &pixelFormat) || pixelFormat != TOCropPixelFormatRGBA8) {
+            return nil;
+        }
+    }
+
+    TOCropImagePixels pixels;
+    if (!TOCropImagePixelsLoad(pixelsRef, pixelsRect, pixelFormat, &pixels)) {
+        return nil;
+    }
+
+    TOCropPixelBuffer destination;
+    BOOL success = TOCropPixelBufferAllocate(&destination, outputWidth, outputHeight);
+    if (success) {
+        success = TOCropWarpPerspectiveInWindow(&pixels.buffer, sourceRect, width, height, orientation, homography.m,
+                                                TOCropInterpolationBicubic, (size_t)UIImage.croppingThreadLimit,
+                                                progress, &destination);
+        if (!success) {
+            TOCropPixelBufferFree(&destination);
+        }
+    }
+    TOCropImagePixelsRelease(&pixels);
+    if (!success) {
+        return nil;
+    }
+
+    CGImageRef warpedImageRef = TOCropCreateImageWithPixelBuffer(&destination, pixelsRef, CGImageGetBitmapInfo(pixelsRef));
+    if (warpedImageRef == NULL) {
+        return nil;
+    }
+
+    UIImage *warpedImage = [UIImage imageWithCGImage:warpedImageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(warpedImageRef);
+    return warpedImage;
+}
+
+// The image's own orientation, followed by the crop view's rotation, as the one orientation
+// to apply to the stored pixels. UIKit would otherwise apply the first while drawing.
+- (TOCropPixelOrientation)pixelOrientationWithAngle:(NSInteger)angle {
+    const int exifOrientation = TOCropEXIFOrientationForImageOrientation(self.imageOrientation);
+    return TOCropPixelOrientationConcat(TOCropPixelOrientationForEXIFOrientation(exifOrientation),
+                                        TOCropPixelOrientationForQuarterTurns(TOCropQuarterTurnsForAngle(angle)));
+}
+
+// Materializes a region of the image's pixels, as they appear with an orientation applied,
+// into a new image. Returns NULL if the image isn't stored in a pixel format the kernels can copy.
+- (nullable CGImageRef)newOrientedImageWithPixelRect:(TOCropPixelRect)rect
+                                         orientation:(TOCropPixelOrientation)orientation
+                                        circularClip:(BOOL)circular
+                                      renderProgress:(nullable TOCropRenderProgress *)progress CF_RETURNS_RETAINED {
+    CGImageRef imageRef = self.CGImage;
+
+    // The pixel kernels copy 4-channel pixels as-is, but can only blend the edge of a circle into 8-bit ones
+    TOCropPixelFormat pixelFormat;
+    if (!TOCropPixelFormatForImage(imageRef, &pixelFormat) || (circular && pixelFormat != TOCropPixelFormatRGBA8)) {
+        return NULL;
+    }
+
+    CGBitmapInfo bitmapInfo = CGImageGetBitmapInfo(imageRef);
+    uint32_t alphaMask = 0;
+    if (circular && !TOCropCircularMaskFormat(bitmapInfo, &alphaMask, &bitmapInfo)) {
+        return NULL;
+    }
+
+    // Only the part of the stored image that lands inside the crop is loaded
+    const size_t width = CGImageGetWidth(imageRef), height = CGImageGetHeight(imageRef);
+    if (!TOCropPixelRectFitsInSize(rect, orientation.transpose ? height : width, orientation.transpose ? width : height)) {
+        return NULL;
+    }
+    TOCropImagePixels pixels;
+    if (!TOCropImagePixelsLoad(imageRef, TOCropPixelOrientationSourceRect(orientation, rect, width, height),
+                               pixelFormat, &pixels)) {
+        return NULL;
+    }
+
+    TOCropPixelBuffer destination;
+    BOOL success = TOCropPixelBufferAllocateWithFormat(&destination, rect.width, rect.height, pixelFormat);
+    if (success) {
+        // However it was oriented, the region is read straight out of the stored pixels in one pass,
+        // with blocks of rows spread across every core. Oriented, the loaded pixels are exactly the crop.
+        const TOCropPixelRect croppedRect = {0, 0, rect.width, rect.height};
+        const TOCropTiledRenderOptions options = {circular, alphaMask, (size_t)UIImage.croppingThreadLimit, progress};
+        success = TOCropRenderRegion(&pixels.buffer, croppedRect, orientation, options, &destination);
+        if (!success) {
+            TOCropPixelBufferFree(&destination);
+        }
+    }
+    TOCropImagePixelsRelease(&pixels);
+    if (!success) {
+        return NULL;
+    }
+
+    return TOCropCreateImageWithPixelBuffer(&destination, imageRef, bitmapInfo);
+}
+
 @end
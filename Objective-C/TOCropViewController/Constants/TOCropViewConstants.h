@@ -20,6 +20,7 @@
 //  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
 //  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#import <CoreGraphics/CoreGraphics.h>
 #import <Foundation/Foundation.h>
 
 /**
@@ -38,6 +39,62 @@ typedef NS_ENUM(NSInteger, TOCropViewControllerToolbarPosition) {
     TOCropViewControllerToolbarPositionTop      // Bar is placed along the top in portrait (Respects the status bar)
 };
 
+/**
+ The filter used to weigh up the original pixels when a cropped image is scaled to a new size
+ */
+typedef NS_ENUM(NSInteger, TOCropViewResamplingFilter) {
+    TOCropViewResamplingFilterBox,      // An average of every pixel covered. Fastest, but blocky when enlarging
+    TOCropViewResamplingFilterBilinear, // Smooth, and good enough for most downscaling
+    TOCropViewResamplingFilterLanczos   // The sharpest result, at around twice the cost of bilinear
+};
+
+/**
+ How the grid overlaid on the crop box divides it up
+ */
+typedef NS_ENUM(NSInteger, TOCropViewGridStyle) {
+    TOCropViewGridStyleThirds,      // Two lines each way, a third of the way in from each side (the rule of thirds)
+    TOCropViewGridStyleGoldenRatio, // Two lines each way, dividing each side by the golden ratio
+    TOCropViewGridStyleUniform      // A number of equally sized rows and columns
+};
+
+/**
+ The four corners of a region of an image that doesn't have to be a rectangle, such as a page
+ or whiteboard photographed at an angle. The corners go clockwise, starting from the top left.
+ */
+typedef struct {
+    CGPoint topLeft;
+    CGPoint topRight;
+    CGPoint bottomRight;
+    CGPoint bottomLeft;
+} TOCropQuadrilateral;
+
+/**
+ The quadrilateral with the corners of a rectangle
+ */
+static inline TOCropQuadrilateral TOCropQuadrilateralMakeWithRect(CGRect rect) {
+    return (TOCropQuadrilateral){{CGRectGetMinX(rect), CGRectGetMinY(rect)}, {CGRectGetMaxX(rect), CGRectGetMinY(rect)},
+                                 {CGRectGetMaxX(rect), CGRectGetMaxY(rect)}, {CGRectGetMinX(rect), CGRectGetMaxY(rect)}};
+}
+
+/**
+ Whether two quadrilaterals have exactly the same corners
+ */
+static inline BOOL TOCropQuadrilateralEqualToQuadrilateral(TOCropQuadrilateral a, TOCropQuadrilateral b) {
+    return CGPointEqualToPoint(a.topLeft, b.topLeft) && CGPointEqualToPoint(a.topRight, b.topRight) &&
+           CGPointEqualToPoint(a.bottomRight, b.bottomRight) && CGPointEqualToPoint(a.bottomLeft, b.bottomLeft);
+}
+
+/**
+ The smallest rectangle that contains all four corners of a quadrilateral
+ */
+static inline CGRect TOCropQuadrilateralBoundingRect(TOCropQuadrilateral q) {
+    const CGFloat minX = MIN(MIN(q.topLeft.x, q.topRight.x), MIN(q.bottomRight.x, q.bottomLeft.x));
+    const CGFloat minY = MIN(MIN(q.topLeft.y, q.topRight.y), MIN(q.bottomRight.y, q.bottomLeft.y));
+    const CGFloat maxX = MAX(MAX(q.topLeft.x, q.topRight.x), MAX(q.bottomRight.x, q.bottomLeft.x));
+    const CGFloat maxY = MAX(MAX(q.topLeft.y, q.topRight.y), MAX(q.bottomRight.y, q.bottomLeft.y));
+    return (CGRect){{minX, minY}, {maxX - minX, maxY - minY}};
+}
+
 static inline NSBundle *TO_CROP_VIEW_RESOURCE_BUNDLE_FOR_OBJECT(NSObject *object) {
 #if SWIFT_PACKAGE
     // SPM is supposed to support the keyword SWIFTPM_MODULE_BUNDLE
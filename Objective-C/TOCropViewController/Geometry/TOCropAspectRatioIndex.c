@@ -0,0 +1,115 @@
+//
+//  TOCropAspectRatioIndex.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropAspectRatioIndex.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// Ratios are stored as logarithms, so that the distance between two of them is
+// the same whichever way round they are, and 2:1 and 1:2 are equally far from 1:1
+typedef struct {
+    double logRatio; // The natural logarithm of the ratio
+    size_t position; // Where the ratio was in the array the index was created from
+} TOCropAspectRatioEntry;
+
+struct TOCropAspectRatioIndex {
+    TOCropAspectRatioEntry *entries; // Sorted by `logRatio`, and then by `position`
+    size_t count;
+};
+
+static int TOCropAspectRatioEntryCompare(const void *a, const void *b) {
+    const TOCropAspectRatioEntry *first = a;
+    const TOCropAspectRatioEntry *second = b;
+    if (first->logRatio != second->logRatio) { return first->logRatio < second->logRatio ? -1 : 1; }
+    if (first->position != second->position) { return first->position < second->position ? -1 : 1; }
+    return 0;
+}
+
+TOCropAspectRatioIndex *TOCropAspectRatioIndexCreate(const double *ratios, size_t count) {
+    TOCropAspectRatioIndex *index = calloc(1, sizeof(TOCropAspectRatioIndex));
+    if (index == NULL) { return NULL; }
+    if (count == 0) { return index; }
+
+    index->entries = malloc(count * sizeof(TOCropAspectRatioEntry));
+    if (index->entries == NULL) {
+        free(index);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!(ratios[i] > 0.0) || !isfinite(ratios[i])) { continue; }
+        index->entries[index->count++] = (TOCropAspectRatioEntry){log(ratios[i]), i};
+    }
+
+    qsort(index->entries, index->count, sizeof(TOCropAspectRatioEntry), TOCropAspectRatioEntryCompare);
+
+    // Drop repeated ratios. Since they're sorted by position too, the first of each is kept.
+    size_t distinctCount = 0;
+    for (size_t i = 0; i < index->count; i++) {
+        if (distinctCount > 0 && index->entries[distinctCount - 1].logRatio == index->entries[i].logRatio) { continue; }
+        index->entries[distinctCount++] = index->entries[i];
+    }
+    index->count = distinctCount;
+
+    return index;
+}
+
+void TOCropAspectRatioIndexDestroy(TOCropAspectRatioIndex *index) {
+    if (index == NULL) { return; }
+    free(index->entries);
+    free(index);
+}
+
+size_t TOCropAspectRatioIndexCount(const TOCropAspectRatioIndex *index) {
+    return index->count;
+}
+
+size_t TOCropAspectRatioIndexNearest(const TOCropAspectRatioIndex *index, double ratio, double tolerance) {
+    if (index->count == 0 || !(ratio > 0.0) || !isfinite(ratio) || !(tolerance >= 0.0)) {
+        return TOCropAspectRatioIndexNotFound;
+    }
+
+    const double logRatio = log(ratio);
+
+    // Find the first entry that isn't smaller than the ratio. The closest is either it or the one before.
+    size_t lower = 0, upper = index->count;
+    while (lower < upper) {
+        const size_t middle = lower + (upper - lower) / 2;
+        if (index->entries[middle].logRatio < logRatio) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+
+    size_t nearest = lower;
+    if (nearest == index->count ||
+        (nearest > 0 && logRatio - index->entries[nearest - 1].logRatio <= index->entries[nearest].logRatio - logRatio)) {
+        nearest--;
+    }
+
+    if (fabs(index->entries[nearest].logRatio - logRatio) > log1p(tolerance)) {
+        return TOCropAspectRatioIndexNotFound;
+    }
+    return index->entries[nearest].position;
+}
@@ -0,0 +1,63 @@
+//
+//  TOCropAspectRatioIndex.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropAspectRatioIndex_h
+#define TOCropAspectRatioIndex_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A sorted index of aspect ratios (width divided by height), for finding the one closest
+/// to the shape of the crop box while it's being dragged. It's built once from the whole
+/// catalog of presets, after which each lookup is a binary search.
+
+/// Returned by `TOCropAspectRatioIndexNearest` when no ratio is within the tolerance
+#define TOCropAspectRatioIndexNotFound ((size_t)-1)
+
+typedef struct TOCropAspectRatioIndex TOCropAspectRatioIndex;
+
+/// Creates an index of `count` ratios. Ratios that are zero, negative or not finite are left out,
+/// and where several ratios are the same, only the first of them is kept.
+/// @return The index, or NULL if it couldn't be allocated
+TOCropAspectRatioIndex *TOCropAspectRatioIndexCreate(const double *ratios, size_t count);
+
+/// Destroys an index. Passing NULL does nothing.
+void TOCropAspectRatioIndexDestroy(TOCropAspectRatioIndex *index);
+
+/// The number of distinct ratios in the index
+size_t TOCropAspectRatioIndexCount(const TOCropAspectRatioIndex *index);
+
+/// Finds the ratio in the index that's closest to `ratio`. Ratios are compared by how many times
+/// bigger one is than the other, so 4:3 is as close to 1:1 as 3:4 is.
+/// @param tolerance How much bigger or smaller (eg, 0.02 for 2%) than `ratio` the closest ratio may be
+/// @return The position of the closest ratio in the array the index was created from, or
+/// `TOCropAspectRatioIndexNotFound` if none are within the tolerance
+size_t TOCropAspectRatioIndexNearest(const TOCropAspectRatioIndex *index, double ratio, double tolerance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropAspectRatioIndex_h */
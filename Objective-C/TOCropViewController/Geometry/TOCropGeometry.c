@@ -0,0 +1,906 @@
+//
+//  TOCropGeometry.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropGeometry.h"
+
+#include <float.h>
+#include <math.h>
+
+// The rounding below matches the `floorf`/`ceilf` the crop view has always used,
+// so the layout lands on exactly the same points as it did before
+
+static inline double TOCropMin(double a, double b) { return a < b ? a : b; }
+static inline double TOCropMax(double a, double b) { return a > b ? a : b; }
+
+static inline double TOCropRectMinX(TOCropRect rect) { return rect.origin.x; }
+static inline double TOCropRectMinY(TOCropRect rect) { return rect.origin.y; }
+static inline double TOCropRectMaxX(TOCropRect rect) { return rect.origin.x + rect.size.width; }
+static inline double TOCropRectMaxY(TOCropRect rect) { return rect.origin.y + rect.size.height; }
+static inline double TOCropRectMidX(TOCropRect rect) { return rect.origin.x + rect.size.width * 0.5; }
+static inline double TOCropRectMidY(TOCropRect rect) { return rect.origin.y + rect.size.height * 0.5; }
+
+static inline bool TOCropRectContainsPoint(TOCropRect rect, TOCropPoint point) {
+    return point.x >= TOCropRectMinX(rect) && point.x < TOCropRectMaxX(rect) &&
+           point.y >= TOCropRectMinY(rect) && point.y < TOCropRectMaxY(rect);
+}
+
+// Whether a crop box of this size stays within the minimum aspect ratio
+static inline bool TOCropSizeMeetsAspectRatio(double width, double height, double minimumAspectRatio) {
+    return TOCropMin(height, width) / TOCropMax(height, width) >= minimumAspectRatio;
+}
+
+#pragma mark - Crop Box -
+
+TOCropEdge TOCropGeometryEdgeForPoint(TOCropRect cropBoxFrame, TOCropPoint point) {
+    // Account for padding around the box
+    TOCropRect frame = cropBoxFrame;
+    frame.origin.x -= 32.0; frame.origin.y -= 32.0;
+    frame.size.width += 64.0; frame.size.height += 64.0;
+
+    // Make sure the corners take priority
+    const TOCropRect topLeftRect = (TOCropRect){frame.origin, {64.0, 64.0}};
+    if (TOCropRectContainsPoint(topLeftRect, point)) { return TOCropEdgeTopLeft; }
+
+    TOCropRect topRightRect = topLeftRect;
+    topRightRect.origin.x = TOCropRectMaxX(frame) - 64.0;
+    if (TOCropRectContainsPoint(topRightRect, point)) { return TOCropEdgeTopRight; }
+
+    TOCropRect bottomLeftRect = topLeftRect;
+    bottomLeftRect.origin.y = TOCropRectMaxY(frame) - 64.0;
+    if (TOCropRectContainsPoint(bottomLeftRect, point)) { return TOCropEdgeBottomLeft; }
+
+    TOCropRect bottomRightRect = topRightRect;
+    bottomRightRect.origin.y = bottomLeftRect.origin.y;
+    if (TOCropRectContainsPoint(bottomRightRect, point)) { return TOCropEdgeBottomRight; }
+
+    // Check for edges
+    const TOCropRect topRect = (TOCropRect){frame.origin, {frame.size.width, 64.0}};
+    if (TOCropRectContainsPoint(topRect, point)) { return TOCropEdgeTop; }
+
+    TOCropRect bottomRect = topRect;
+    bottomRect.origin.y = TOCropRectMaxY(frame) - 64.0;
+    if (TOCropRectContainsPoint(bottomRect, point)) { return TOCropEdgeBottom; }
+
+    const TOCropRect leftRect = (TOCropRect){frame.origin, {64.0, frame.size.height}};
+    if (TOCropRectContainsPoint(leftRect, point)) { return TOCropEdgeLeft; }
+
+    TOCropRect rightRect = leftRect;
+    rightRect.origin.x = TOCropRectMaxX(frame) - 64.0;
+    if (TOCropRectContainsPoint(rightRect, point)) { return TOCropEdgeRight; }
+
+    return TOCropEdgeNone;
+}
+
+TOCropRect TOCropGeometryResizeCropBox(const TOCropLayout *layout, const TOCropResize *resize, TOCropPoint point) {
+    TOCropRect frame = layout->cropBoxFrame;
+    const TOCropRect originFrame = resize->originFrame;
+    const TOCropRect contentFrame = layout->contentBounds;
+    const double minimumAspectRatio = resize->minimumAspectRatio;
+    const bool locked = resize->aspectRatioLocked;
+
+    point.x = TOCropMax(contentFrame.origin.x - resize->padding, point.x);
+    point.y = TOCropMax(contentFrame.origin.y - resize->padding, point.y);
+
+    // The delta between where we first tapped, and where our finger is now
+    double xDelta = ceilf(point.x - resize->originPoint.x);
+    double yDelta = ceilf(point.y - resize->originPoint.y);
+
+    // Current aspect ratio of the crop box in case we need to clamp it
+    const double aspectRatio = (originFrame.size.width / originFrame.size.height);
+
+    // Note whether we're being aspect transformed horizontally or vertically
+    bool aspectHorizontal = false, aspectVertical = false;
+
+    // Depending on which corner we drag from, set the appropriate min flag to
+    // ensure we can properly clamp the XY value of the box if it overruns the minimum size
+    // (Otherwise the image itself will slide with the drag gesture)
+    bool clampMinFromTop = false, clampMinFromLeft = false;
+
+    switch (resize->edge) {
+    case TOCropEdgeLeft:
+        if (locked) {
+            aspectHorizontal = true;
+            xDelta = TOCropMax(xDelta, 0);
+            frame.size.height = frame.size.width / aspectRatio;
+            frame.origin.y = TOCropRectMidY(originFrame) - (frame.size.height * 0.5f);
+        }
+        if (TOCropSizeMeetsAspectRatio(originFrame.size.width - xDelta, originFrame.size.height, minimumAspectRatio)) {
+            frame.origin.x = originFrame.origin.x + xDelta;
+            frame.size.width = originFrame.size.width - xDelta;
+        }
+
+        clampMinFromLeft = true;
+        break;
+    case TOCropEdgeRight:
+        if (locked) {
+            aspectHorizontal = true;
+            frame.size.height = frame.size.width / aspectRatio;
+            frame.origin.y = TOCropRectMidY(originFrame) - (frame.size.height * 0.5f);
+            frame.size.width = originFrame.size.width + xDelta;
+            frame.size.width = TOCropMin(frame.size.width, contentFrame.size.height * aspectRatio);
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width + xDelta, originFrame.size.height, minimumAspectRatio)) {
+            frame.size.width = originFrame.size.width + xDelta;
+        }
+        break;
+    case TOCropEdgeBottom:
+        if (locked) {
+            aspectVertical = true;
+            frame.size.width = frame.size.height * aspectRatio;
+            frame.origin.x = TOCropRectMidX(originFrame) - (frame.size.width * 0.5f);
+            frame.size.height = originFrame.size.height + yDelta;
+            frame.size.height = TOCropMin(frame.size.height, contentFrame.size.width / aspectRatio);
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width, originFrame.size.height + yDelta, minimumAspectRatio)) {
+            frame.size.height = originFrame.size.height + yDelta;
+        }
+        break;
+    case TOCropEdgeTop:
+        if (locked) {
+            aspectVertical = true;
+            yDelta = TOCropMax(0, yDelta);
+            frame.size.width = frame.size.height * aspectRatio;
+            frame.origin.x = TOCropRectMidX(originFrame) - (frame.size.width * 0.5f);
+            frame.origin.y = originFrame.origin.y + yDelta;
+            frame.size.height = originFrame.size.height - yDelta;
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width, originFrame.size.height - yDelta, minimumAspectRatio)) {
+            frame.origin.y = originFrame.origin.y + yDelta;
+            frame.size.height = originFrame.size.height - yDelta;
+        }
+
+        clampMinFromTop = true;
+        break;
+    case TOCropEdgeTopLeft:
+        if (locked) {
+            xDelta = TOCropMax(xDelta, 0);
+            yDelta = TOCropMax(yDelta, 0);
+
+            const double distanceX = 1.0f - (xDelta / originFrame.size.width);
+            const double distanceY = 1.0f - (yDelta / originFrame.size.height);
+            const double scale = (distanceX + distanceY) * 0.5f;
+
+            frame.size.width = ceilf(originFrame.size.width * scale);
+            frame.size.height = ceilf(originFrame.size.height * scale);
+            frame.origin.x = originFrame.origin.x + (originFrame.size.width - frame.size.width);
+            frame.origin.y = originFrame.origin.y + (originFrame.size.height - frame.size.height);
+
+            aspectVertical = true;
+            aspectHorizontal = true;
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width - xDelta, originFrame.size.height - yDelta, minimumAspectRatio)) {
+            frame.origin.x = originFrame.origin.x + xDelta;
+            frame.size.width = originFrame.size.width - xDelta;
+            frame.origin.y = originFrame.origin.y + yDelta;
+            frame.size.height = originFrame.size.height - yDelta;
+        }
+
+        clampMinFromTop = true;
+        clampMinFromLeft = true;
+        break;
+    case TOCropEdgeTopRight:
+        if (locked) {
+            xDelta = TOCropMin(xDelta, 0);
+            yDelta = TOCropMax(yDelta, 0);
+
+            const double distanceX = 1.0f - ((-xDelta) / originFrame.size.width);
+            const double distanceY = 1.0f - ((yDelta) / originFrame.size.height);
+            const double scale = (distanceX + distanceY) * 0.5f;
+
+            frame.size.width = ceilf(originFrame.size.width * scale);
+            frame.size.height = ceilf(originFrame.size.height * scale);
+            frame.origin.y = originFrame.origin.y + (originFrame.size.height - frame.size.height);
+
+            aspectVertical = true;
+            aspectHorizontal = true;
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width + xDelta, originFrame.size.height - yDelta, minimumAspectRatio)) {
+            frame.size.width = originFrame.size.width + xDelta;
+            frame.origin.y = originFrame.origin.y + yDelta;
+            frame.size.height = originFrame.size.height - yDelta;
+        }
+
+        clampMinFromTop = true;
+        break;
+    case TOCropEdgeBottomLeft:
+        if (locked) {
+            const double distanceX = 1.0f - (xDelta / originFrame.size.width);
+            const double distanceY = 1.0f - (-yDelta / originFrame.size.height);
+            const double scale = (distanceX + distanceY) * 0.5f;
+
+            frame.size.width = ceilf(originFrame.size.width * scale);
+            frame.size.height = ceilf(originFrame.size.height * scale);
+            frame.origin.x = TOCropRectMaxX(originFrame) - frame.size.width;
+
+            aspectVertical = true;
+            aspectHorizontal = true;
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width - xDelta, originFrame.size.height + yDelta, minimumAspectRatio)) {
+            frame.size.height = originFrame.size.height + yDelta;
+            frame.origin.x = originFrame.origin.x + xDelta;
+            frame.size.width = originFrame.size.width - xDelta;
+        }
+
+        clampMinFromLeft = true;
+        break;
+    case TOCropEdgeBottomRight:
+        if (locked) {
+            const double distanceX = 1.0f - ((-1 * xDelta) / originFrame.size.width);
+            const double distanceY = 1.0f - ((-1 * yDelta) / originFrame.size.height);
+            const double scale = (distanceX + distanceY) * 0.5f;
+
+            frame.size.width = ceilf(originFrame.size.width * scale);
+            frame.size.height = ceilf(originFrame.size.height * scale);
+
+            aspectVertical = true;
+            aspectHorizontal = true;
+        } else if (TOCropSizeMeetsAspectRatio(originFrame.size.width + xDelta, originFrame.size.height + yDelta, minimumAspectRatio)) {
+            frame.size.height = originFrame.size.height + yDelta;
+            frame.size.width = originFrame.size.width + xDelta;
+        }
+        break;
+    case TOCropEdgeNone:
+        break;
+    }
+
+    // The absolute max/min size the box may be in the bounds of the crop view
+    TOCropSize minSize = (TOCropSize){TOCropGeometryMinimumBoxSize, TOCropGeometryMinimumBoxSize};
+    TOCropSize maxSize = contentFrame.size;
+
+    // Clamp the box to ensure it doesn't go beyond the bounds we've set
+    if (locked && aspectHorizontal) {
+        maxSize.height = contentFrame.size.width / aspectRatio;
+        minSize.width = TOCropGeometryMinimumBoxSize * aspectRatio;
+    }
+
+    if (locked && aspectVertical) {
+        maxSize.width = contentFrame.size.height * aspectRatio;
+        minSize.height = TOCropGeometryMinimumBoxSize / aspectRatio;
+    }
+
+    // Clamp the width if it goes over
+    if (clampMinFromLeft) {
+        const double maxWidth = TOCropRectMaxX(originFrame) - contentFrame.origin.x;
+        frame.size.width = TOCropMin(frame.size.width, maxWidth);
+    }
+
+    if (clampMinFromTop) {
+        const double maxHeight = TOCropRectMaxY(originFrame) - contentFrame.origin.y;
+        frame.size.height = TOCropMin(frame.size.height, maxHeight);
+    }
+
+    // Clamp the minimum size
+    frame.size.width = TOCropMax(frame.size.width, minSize.width);
+    frame.size.height = TOCropMax(frame.size.height, minSize.height);
+
+    // Clamp the maximum size
+    frame.size.width = TOCropMin(frame.size.width, maxSize.width);
+    frame.size.height = TOCropMin(frame.size.height, maxSize.height);
+
+    // Clamp the X position of the box to the interior of the cropping bounds
+    frame.origin.x = TOCropMax(frame.origin.x, TOCropRectMinX(contentFrame));
+    frame.origin.x = TOCropMin(frame.origin.x, TOCropRectMaxX(contentFrame) - minSize.width);
+
+    // Clamp the Y postion of the box to the interior of the cropping bounds
+    frame.origin.y = TOCropMax(frame.origin.y, TOCropRectMinY(contentFrame));
+    frame.origin.y = TOCropMin(frame.origin.y, TOCropRectMaxY(contentFrame) - minSize.height);
+
+    // Once the box is completely shrunk, clamp its ability to move
+    if (clampMinFromLeft && frame.size.width <= minSize.width + FLT_EPSILON) {
+        frame.origin.x = TOCropRectMaxX(originFrame) - minSize.width;
+    }
+
+    if (clampMinFromTop && frame.size.height <= minSize.height + FLT_EPSILON) {
+        frame.origin.y = TOCropRectMaxY(originFrame) - minSize.height;
+    }
+
+    return frame;
+}
+
+TOCropRect TOCropGeometrySnapCropBoxToAspectRatio(const TOCropLayout *layout, const TOCropResize *resize,
+                                                  TOCropRect frame, double aspectRatio) {
+    if (resize->aspectRatioLocked || !(aspectRatio > 0.0)) { return frame; }
+    if (frame.size.width < FLT_EPSILON || frame.size.height < FLT_EPSILON) { return frame; }
+
+    const TOCropEdge edge = resize->edge;
+    const bool draggingLeft = (edge == TOCropEdgeLeft || edge == TOCropEdgeTopLeft || edge == TOCropEdgeBottomLeft);
+    const bool draggingTop = (edge == TOCropEdgeTop || edge == TOCropEdgeTopLeft || edge == TOCropEdgeTopRight);
+
+    bool changeWidth;
+    switch (edge) {
+    case TOCropEdgeLeft:
+    case TOCropEdgeRight:
+        changeWidth = true;
+        break;
+    case TOCropEdgeTop:
+    case TOCropEdgeBottom:
+        changeWidth = false;
+        break;
+    case TOCropEdgeTopLeft:
+    case TOCropEdgeTopRight:
+    case TOCropEdgeBottomLeft:
+    case TOCropEdgeBottomRight:
+        // Shortening rather than lengthening a side means the box can't be pushed out of bounds
+        changeWidth = (frame.size.width / frame.size.height) > aspectRatio;
+        break;
+    case TOCropEdgeNone:
+    default:
+        return frame;
+    }
+
+    // Keep the side opposite the one being dragged where it is
+    TOCropRect snappedFrame = frame;
+    if (changeWidth) {
+        snappedFrame.size.width = frame.size.height * aspectRatio;
+        if (draggingLeft) { snappedFrame.origin.x = TOCropRectMaxX(frame) - snappedFrame.size.width; }
+    } else {
+        snappedFrame.size.height = frame.size.width / aspectRatio;
+        if (draggingTop) { snappedFrame.origin.y = TOCropRectMaxY(frame) - snappedFrame.size.height; }
+    }
+
+    const TOCropRect contentFrame = layout->contentBounds;
+    if (snappedFrame.size.width < TOCropGeometryMinimumBoxSize - FLT_EPSILON ||
+        snappedFrame.size.height < TOCropGeometryMinimumBoxSize - FLT_EPSILON) {
+        return frame;
+    }
+    if (TOCropRectMinX(snappedFrame) < TOCropRectMinX(contentFrame) - FLT_EPSILON ||
+        TOCropRectMinY(snappedFrame) < TOCropRectMinY(contentFrame) - FLT_EPSILON ||
+        TOCropRectMaxX(snappedFrame) > TOCropRectMaxX(contentFrame) + FLT_EPSILON ||
+        TOCropRectMaxY(snappedFrame) > TOCropRectMaxY(contentFrame) + FLT_EPSILON) {
+        return frame;
+    }
+    if (!TOCropSizeMeetsAspectRatio(snappedFrame.size.width, snappedFrame.size.height, resize->minimumAspectRatio)) {
+        return frame;
+    }
+
+    return snappedFrame;
+}
+
+bool TOCropGeometryClampCropBox(TOCropRect contentBounds, TOCropRect frame, TOCropRect *clampedFrame) {
+    // Upon init, sometimes the box size is still 0 (or NaN), which can result in CALayer issues
+    if (frame.size.width < FLT_EPSILON || frame.size.height < FLT_EPSILON) { return false; }
+    if (isnan(frame.size.width) || isnan(frame.size.height)) { return false; }
+
+    // Clamp the cropping region to the inset boundaries of the screen
+    const TOCropRect contentFrame = contentBounds;
+    const double xOrigin = ceilf(contentFrame.origin.x);
+    const double xDelta = frame.origin.x - xOrigin;
+    frame.origin.x = floorf(TOCropMax(frame.origin.x, xOrigin));
+    if (xDelta < -FLT_EPSILON) { // If we clamp the x value, ensure we compensate for the subsequent delta generated in the width (Or else, the box will keep growing)
+        frame.size.width += xDelta;
+    }
+
+    const double yOrigin = ceilf(contentFrame.origin.y);
+    const double yDelta = frame.origin.y - yOrigin;
+    frame.origin.y = floorf(TOCropMax(frame.origin.y, yOrigin));
+    if (yDelta < -FLT_EPSILON) {
+        frame.size.height += yDelta;
+    }
+
+    // Given the clamped X/Y values, make sure we can't extend the crop box beyond the edge of the screen in the current state
+    const double maxWidth = (contentFrame.size.width + contentFrame.origin.x) - frame.origin.x;
+    frame.size.width = floorf(TOCropMin(frame.size.width, maxWidth));
+
+    const double maxHeight = (contentFrame.size.height + contentFrame.origin.y) - frame.origin.y;
+    frame.size.height = floorf(TOCropMin(frame.size.height, maxHeight));
+
+    // Make sure we can't make the crop box too small
+    frame.size.width = TOCropMax(frame.size.width, TOCropGeometryMinimumBoxSize);
+    frame.size.height = TOCropMax(frame.size.height, TOCropGeometryMinimumBoxSize);
+
+    *clampedFrame = frame;
+    return true;
+}
+
+TOCropInsets TOCropGeometryContentInsetForCropBox(TOCropRect bounds, TOCropRect cropBoxFrame) {
+    return (TOCropInsets){
+        TOCropRectMinY(cropBoxFrame),
+        TOCropRectMinX(cropBoxFrame),
+        TOCropRectMaxY(bounds) - TOCropRectMaxY(cropBoxFrame),
+        TOCropRectMaxX(bounds) - TOCropRectMaxX(cropBoxFrame)
+    };
+}
+
+double TOCropGeometryMinimumZoomScale(TOCropSize imageSize, TOCropSize cropBoxSize) {
+    return TOCropMax(cropBoxSize.height / imageSize.height, cropBoxSize.width / imageSize.width);
+}
+
+#pragma mark - Image Crop Frame -
+
+TOCropRect TOCropGeometryImageCropFrame(const TOCropLayout *layout) {
+    const TOCropSize imageSize = layout->imageSize;
+    const TOCropSize contentSize = layout->contentSize;
+    const TOCropRect cropBoxFrame = layout->cropBoxFrame;
+    const double scale = TOCropMin(imageSize.width / contentSize.width, imageSize.height / contentSize.height);
+
+    TOCropRect frame = {{0, 0}, {0, 0}};
+
+    // Calculate the normalized origin, clamped inside the image so the size
+    // subtraction below can never go negative (eg, during rubber-band overscroll)
+    frame.origin.x = floorf((floorf(layout->contentOffset.x) + layout->contentInset.left) * (imageSize.width / contentSize.width));
+    frame.origin.x = TOCropMax(0, TOCropMin(frame.origin.x, imageSize.width));
+
+    frame.origin.y = floorf((floorf(layout->contentOffset.y) + layout->contentInset.top) * (imageSize.height / contentSize.height));
+    frame.origin.y = TOCropMax(0, TOCropMin(frame.origin.y, imageSize.height));
+
+    // Calculate the normalized width, clamped so the rect never extends past the image
+    frame.size.width = ceilf(cropBoxFrame.size.width * scale);
+    frame.size.width = TOCropMin(imageSize.width - frame.origin.x, frame.size.width);
+
+    // Calculate normalized height
+    if (floor(cropBoxFrame.size.width) == floor(cropBoxFrame.size.height)) {
+        frame.size.height = frame.size.width;
+    } else {
+        frame.size.height = ceilf(cropBoxFrame.size.height * scale);
+    }
+    frame.size.height = TOCropMin(imageSize.height - frame.origin.y, frame.size.height);
+
+    return frame;
+}
+
+TOCropLayoutUpdate TOCropGeometryLayoutForImageCropFrame(const TOCropLayout *layout, TOCropRect imageCropFrame) {
+    // Convert the image crop frame's size from image space to the screen space
+    const double minimumScale = layout->minimumZoomScale;
+    const TOCropPoint scaledOffset = {imageCropFrame.origin.x * minimumScale, imageCropFrame.origin.y * minimumScale};
+    const TOCropSize scaledCropSize = {imageCropFrame.size.width * minimumScale, imageCropFrame.size.height * minimumScale};
+
+    // Work out the scale necessary to upscale the crop size to fit the content bounds of the crop bound
+    const TOCropRect bounds = layout->contentBounds;
+    const double scale = TOCropMin(bounds.size.width / scaledCropSize.width, bounds.size.height / scaledCropSize.height);
+
+    TOCropLayoutUpdate update;
+    update.scale = scale;
+    update.zoomScale = minimumScale * scale;
+
+    // Center the upscaled crop box
+    update.cropBoxFrame.size = (TOCropSize){floorf(scaledCropSize.width * scale), floorf(scaledCropSize.height * scale)};
+    update.cropBoxFrame.origin.x = floorf(TOCropRectMidX(bounds) - (update.cropBoxFrame.size.width * 0.5f));
+    update.cropBoxFrame.origin.y = floorf(TOCropRectMidY(bounds) - (update.cropBoxFrame.size.height * 0.5f));
+
+    // The scroll view's insets will have moved to line up with the new crop box
+    TOCropInsets contentInset = layout->contentInset;
+    TOCropRect clampedFrame;
+    if (TOCropGeometryClampCropBox(layout->contentBounds, update.cropBoxFrame, &clampedFrame)) {
+        contentInset = TOCropGeometryContentInsetForCropBox(layout->bounds, clampedFrame);
+    }
+
+    update.contentOffset.x = ceilf((scaledOffset.x * scale) - contentInset.left);
+    update.contentOffset.y = ceilf((scaledOffset.y * scale) - contentInset.top);
+    return update;
+}
+
+#pragma mark - Layout -
+
+TOCropInitialLayout TOCropGeometryInitialLayout(TOCropRect contentBounds, TOCropSize imageSize,
+                                                TOCropSize aspectRatio, double maximumZoomMultiplier) {
+    const TOCropSize boundsSize = contentBounds.size;
+    const bool hasAspectRatio = (aspectRatio.width > FLT_EPSILON && aspectRatio.height > FLT_EPSILON);
+
+    // Work out the size of the image to fit into the content bounds
+    double scale = TOCropMin(boundsSize.width / imageSize.width, boundsSize.height / imageSize.height);
+    const TOCropSize fittedSize = {floorf(imageSize.width * scale), floorf(imageSize.height * scale)};
+
+    // If an aspect ratio was pre-applied to the crop view, use that to work out the minimum scale the image needs to be to fit
+    TOCropSize cropBoxSize = {0};
+    if (hasAspectRatio) {
+        const double ratioScale = (aspectRatio.width / aspectRatio.height); // Work out the size of the width in relation to height
+        const TOCropSize fullSizeRatio = {boundsSize.height * ratioScale, boundsSize.height};
+        const double fitScale = TOCropMin(boundsSize.width / fullSizeRatio.width, boundsSize.height / fullSizeRatio.height);
+        cropBoxSize = (TOCropSize){fullSizeRatio.width * fitScale, fullSizeRatio.height * fitScale};
+
+        scale = TOCropMax(cropBoxSize.width / imageSize.width, cropBoxSize.height / imageSize.height);
+    }
+
+    // Whether aspect ratio, or original, the final image size we'll base the rest of the calculations off
+    const TOCropSize scaledSize = {floorf(imageSize.width * scale), floorf(imageSize.height * scale)};
+
+    TOCropInitialLayout layout = {0};
+    layout.minimumZoomScale = scale;
+    layout.maximumZoomScale = scale * maximumZoomMultiplier;
+    layout.contentSize = scaledSize;
+    layout.fittedSize = fittedSize;
+
+    // Set the crop box to the size we calculated and align in the middle of the screen
+    TOCropRect frame = {{0, 0}, {0, 0}};
+    frame.size = hasAspectRatio ? cropBoxSize : scaledSize;
+    frame.origin.x = floorf(contentBounds.origin.x + floorf((boundsSize.width - frame.size.width) * 0.5f));
+    frame.origin.y = floorf(contentBounds.origin.y + floorf((boundsSize.height - frame.size.height) * 0.5f));
+    layout.cropBoxFrame = frame;
+
+    // If we ended up with a smaller crop box than the content, line up the content so its center
+    // is in the center of the cropbox
+    if (frame.size.width < scaledSize.width - FLT_EPSILON || frame.size.height < scaledSize.height - FLT_EPSILON) {
+        layout.centersContent = true;
+        layout.contentOffset.x = -floorf(TOCropRectMidX(contentBounds) - (scaledSize.width * 0.5f));
+        layout.contentOffset.y = -floorf(TOCropRectMidY(contentBounds) - (scaledSize.height * 0.5f));
+    }
+
+    return layout;
+}
+
+bool TOCropGeometryCenterCropBox(const TOCropLayout *layout, TOCropLayoutUpdate *update) {
+    const TOCropRect contentRect = layout->contentBounds;
+    TOCropRect cropFrame = layout->cropBoxFrame;
+
+    // Ensure we only proceed after the crop frame has been setup for the first time
+    if (cropFrame.size.width < FLT_EPSILON || cropFrame.size.height < FLT_EPSILON) {
+        return false;
+    }
+
+    // The scale we need to scale up the crop box to fit full screen
+    const double scale = TOCropMin(contentRect.size.width / cropFrame.size.width, contentRect.size.height / cropFrame.size.height);
+
+    const TOCropPoint focusPoint = {TOCropRectMidX(cropFrame), TOCropRectMidY(cropFrame)};
+    const TOCropPoint midPoint = {TOCropRectMidX(contentRect), TOCropRectMidY(contentRect)};
+
+    cropFrame.size.width = ceilf(cropFrame.size.width * scale);
+    cropFrame.size.height = ceilf(cropFrame.size.height * scale);
+    cropFrame.origin.x = contentRect.origin.x + ceilf((contentRect.size.width - cropFrame.size.width) * 0.5f);
+    cropFrame.origin.y = contentRect.origin.y + ceilf((contentRect.size.height - cropFrame.size.height) * 0.5f);
+
+    // Work out the point on the scroll content that the focusPoint is aiming at,
+    // so we can re-align to center that point
+    TOCropPoint offset;
+    offset.x = -midPoint.x + ((focusPoint.x + layout->contentOffset.x) * scale);
+    offset.y = -midPoint.y + ((focusPoint.y + layout->contentOffset.y) * scale);
+
+    // Clamp the content so it doesn't create any seams around the grid
+    offset.x = TOCropMax(-cropFrame.origin.x, offset.x);
+    offset.y = TOCropMax(-cropFrame.origin.y, offset.y);
+
+    update->cropBoxFrame = cropFrame;
+    update->contentOffset = offset;
+    update->scale = scale;
+
+    // Even when the scale is exactly 1, multiplying by it can introduce enough floating point
+    // noise to zoom the image in by a few pixels, so leave the zoom alone unless it really changed
+    if (scale < 1.0f - FLT_EPSILON || scale > 1.0f + FLT_EPSILON) {
+        update->zoomScale = TOCropMin(layout->maximumZoomScale, layout->zoomScale * scale);
+    } else {
+        update->zoomScale = layout->zoomScale;
+        update->scale = 1.0;
+    }
+
+    return true;
+}
+
+TOCropPoint TOCropGeometryClampContentOffset(TOCropPoint contentOffset, TOCropRect cropBoxFrame, TOCropSize contentSize) {
+    contentOffset.x = TOCropMin(-TOCropRectMaxX(cropBoxFrame) + contentSize.width, contentOffset.x);
+    contentOffset.y = TOCropMin(-TOCropRectMaxY(cropBoxFrame) + contentSize.height, contentOffset.y);
+    return contentOffset;
+}
+
+TOCropLayoutUpdate TOCropGeometryLayoutForAspectRatio(const TOCropLayout *layout, TOCropSize aspectRatio,
+                                                      bool imageIsLandscape, bool *zoomOut) {
+    *zoomOut = false;
+
+    // Passing in an empty size (or one with a zero component) will revert back to the image aspect ratio
+    if (aspectRatio.width < FLT_EPSILON || aspectRatio.height < FLT_EPSILON) {
+        aspectRatio = layout->imageSize;
+        *zoomOut = true; // Prevent from steadily zooming in when cycling between alternate aspectRatios and original
+    }
+
+    const TOCropRect boundsFrame = layout->contentBounds;
+    TOCropRect cropBoxFrame = layout->cropBoxFrame;
+    TOCropPoint offset = layout->contentOffset;
+
+    bool cropBoxIsPortrait = false;
+    if ((long)aspectRatio.width == 1 && (long)aspectRatio.height == 1) {
+        cropBoxIsPortrait = imageIsLandscape;
+    } else {
+        cropBoxIsPortrait = aspectRatio.width < aspectRatio.height;
+    }
+
+    if (cropBoxIsPortrait) {
+        const double newWidth = floorf(cropBoxFrame.size.height * (aspectRatio.width / aspectRatio.height));
+        double delta = cropBoxFrame.size.width - newWidth;
+        cropBoxFrame.size.width = newWidth;
+        offset.x += (delta * 0.5f);
+
+        if (delta < FLT_EPSILON) {
+            cropBoxFrame.origin.x = boundsFrame.origin.x; // set to 0 to avoid accidental clamping by the crop frame sanitizer
+        }
+
+        // If the aspect ratio causes the new width to extend
+        // beyond the content width, we'll need to zoom the image out
+        const double boundsWidth = boundsFrame.size.width;
+        if (newWidth > boundsWidth) {
+            const double scale = boundsWidth / newWidth;
+
+            // Scale the new height, and offset the Y position so it stays in the middle
+            const double newHeight = cropBoxFrame.size.height * scale;
+            delta = cropBoxFrame.size.height - newHeight;
+            cropBoxFrame.size.height = newHeight;
+            offset.y += (delta * 0.5f);
+
+            // Clamp the width to the bounds width
+            cropBoxFrame.size.width = boundsWidth;
+            *zoomOut = true;
+        }
+    } else {
+        const double newHeight = floorf(cropBoxFrame.size.width * (aspectRatio.height / aspectRatio.width));
+        double delta = cropBoxFrame.size.height - newHeight;
+        cropBoxFrame.size.height = newHeight;
+        offset.y += (delta * 0.5f);
+
+        if (delta < FLT_EPSILON) {
+            cropBoxFrame.origin.y = boundsFrame.origin.y;
+        }
+
+        // If the aspect ratio causes the new height to extend
+        // beyond the content width, we'll need to zoom the image out
+        const double boundsHeight = boundsFrame.size.height;
+        if (newHeight > boundsHeight) {
+            const double scale = boundsHeight / newHeight;
+
+            // Scale the new width, and offset the X position so it stays in the middle
+            const double newWidth = cropBoxFrame.size.width * scale;
+            delta = cropBoxFrame.size.width - newWidth;
+            cropBoxFrame.size.width = newWidth;
+            offset.x += (delta * 0.5f);
+
+            // Clamp the width to the bounds height
+            cropBoxFrame.size.height = boundsHeight;
+            *zoomOut = true;
+        }
+    }
+
+    TOCropLayoutUpdate update;
+    update.cropBoxFrame = cropBoxFrame;
+    update.contentOffset = offset;
+    update.zoomScale = layout->zoomScale;
+    update.scale = 1.0;
+    return update;
+}
+
+TOCropLayoutUpdate TOCropGeometryLayoutForResizedBounds(const TOCropLayout *layout) {
+    TOCropRect cropFrame = layout->cropBoxFrame;
+    const TOCropRect contentFrame = layout->contentBounds;
+
+    const double scale = TOCropMin(contentFrame.size.width / cropFrame.size.width, contentFrame.size.height / cropFrame.size.height);
+
+    // Work out the centered, upscaled version of the crop rectangle
+    cropFrame.size.width = floorf(cropFrame.size.width * scale);
+    cropFrame.size.height = floorf(cropFrame.size.height * scale);
+    cropFrame.origin.x = floorf(contentFrame.origin.x + ((contentFrame.size.width - cropFrame.size.width) * 0.5f));
+    cropFrame.origin.y = floorf(contentFrame.origin.y + ((contentFrame.size.height - cropFrame.size.height) * 0.5f));
+
+    TOCropLayoutUpdate update;
+    update.cropBoxFrame = cropFrame;
+    update.contentOffset = layout->contentOffset;
+    update.zoomScale = layout->zoomScale * scale;
+    update.scale = scale;
+    return update;
+}
+
+TOCropPoint TOCropGeometryContentOffsetKeepingCenter(const TOCropLayout *layout, TOCropRect previousContentBounds,
+                                                     TOCropPoint previousContentOffset, TOCropSize previousContentSize) {
+    // Work out the center point of the content before we resized
+    const TOCropPoint oldMidPoint = {TOCropRectMidX(previousContentBounds), TOCropRectMidY(previousContentBounds)};
+    const TOCropPoint contentCenter = {previousContentOffset.x + oldMidPoint.x, previousContentOffset.y + oldMidPoint.y};
+
+    // Normalize it to a percentage we can apply to different sizes
+    const TOCropPoint normalizedCenter = {contentCenter.x / previousContentSize.width, contentCenter.y / previousContentSize.height};
+
+    // Work out the new content offset by applying the normalized values to the new layout
+    const TOCropPoint newMidPoint = {TOCropRectMidX(layout->contentBounds), TOCropRectMidY(layout->contentBounds)};
+    const TOCropPoint translatedContentOffset = {layout->contentSize.width * normalizedCenter.x,
+                                                 layout->contentSize.height * normalizedCenter.y};
+
+    TOCropPoint offset;
+    offset.x = floorf(translatedContentOffset.x - newMidPoint.x);
+    offset.y = floorf(translatedContentOffset.y - newMidPoint.y);
+
+    // Make sure it doesn't overshoot the top left corner of the crop box
+    offset.x = TOCropMax(-layout->contentInset.left, offset.x);
+    offset.y = TOCropMax(-layout->contentInset.top, offset.y);
+
+    // Nor undershoot the bottom right corner
+    const double maximumOffsetX = layout->contentSize.width - (layout->bounds.size.width - layout->contentInset.right);
+    const double maximumOffsetY = layout->contentSize.height - (layout->bounds.size.height - layout->contentInset.bottom);
+    offset.x = TOCropMin(offset.x, maximumOffsetX);
+    offset.y = TOCropMin(offset.y, maximumOffsetY);
+    return offset;
+}
+
+#pragma mark - Straightening -
+
+static const double kTOCropRadiansPerDegree = 3.14159265358979323846 / 180.0; // M_PI isn't part of standard C
+
+double TOCropGeometryClampStraighteningAngle(double angle) {
+    if (isnan(angle)) { return 0.0; }
+    const double clampedAngle = TOCropMax(-TOCropGeometryMaximumStraighteningAngle,
+                                          TOCropMin(angle, TOCropGeometryMaximumStraighteningAngle));
+    return round(clampedAngle / TOCropGeometryStraighteningAngleStep) * TOCropGeometryStraighteningAngleStep;
+}
+
+TOCropRect TOCropGeometryLargestStraightenedRect(TOCropSize imageSize, double angle) {
+    const double width = imageSize.width;
+    const double height = imageSize.height;
+    if (width <= 0.0 || height <= 0.0) {
+        return (TOCropRect){{0.0, 0.0}, {0.0, 0.0}};
+    }
+
+    const double radians = angle * kTOCropRadiansPerDegree;
+    const double sine = fabs(sin(radians));
+    const double cosine = fabs(cos(radians));
+    const double longSide = TOCropMax(width, height);
+    const double shortSide = TOCropMin(width, height);
+
+    TOCropSize size;
+    if (shortSide <= 2.0 * sine * cosine * longSide || fabs(sine - cosine) < 1e-10) {
+        // The rect is limited by the short side alone, so two of its corners touch the long sides
+        const double half = 0.5 * shortSide;
+        size = (width >= height) ? (TOCropSize){half / sine, half / cosine} : (TOCropSize){half / cosine, half / sine};
+    } else {
+        // Otherwise all four corners touch the image's sides
+        const double cosine2 = cosine * cosine - sine * sine;
+        size = (TOCropSize){(width * cosine - height * sine) / cosine2, (height * cosine - width * sine) / cosine2};
+    }
+
+    return (TOCropRect){{(width - size.width) * 0.5, (height - size.height) * 0.5}, size};
+}
+
+TOCropRect TOCropGeometryFitRectInStraightenedImage(TOCropSize imageSize, double angle, TOCropRect rect) {
+    if (imageSize.width <= 0.0 || imageSize.height <= 0.0 || rect.size.width <= 0.0 || rect.size.height <= 0.0) {
+        return rect;
+    }
+
+    // The image's own axes, as they point after straightening
+    const double radians = angle * kTOCropRadiansPerDegree;
+    const double cosine = cos(radians);
+    const double sine = sin(radians);
+
+    // How far the rect reaches from its center along each of the image's axes,
+    // and how far its center is from the image's
+    const double halfWidth = rect.size.width * 0.5;
+    const double halfHeight = rect.size.height * 0.5;
+    const double reachX = halfWidth * fabs(cosine) + halfHeight * fabs(sine);
+    const double reachY = halfWidth * fabs(sine) + halfHeight * fabs(cosine);
+    const double offsetX = TOCropRectMidX(rect) - imageSize.width * 0.5;
+    const double offsetY = TOCropRectMidY(rect) - imageSize.height * 0.5;
+    const double alongX = offsetX * cosine + offsetY * sine;
+    const double alongY = -offsetX * sine + offsetY * cosine;
+
+    const double limitX = imageSize.width * 0.5;
+    const double limitY = imageSize.height * 0.5;
+    if (fabs(alongX) + reachX <= limitX + 1e-9 && fabs(alongY) + reachY <= limitY + 1e-9) {
+        return rect;
+    }
+
+    // Shrink it to the largest size that fits when centered, and then slide it back inside
+    // along each axis. The two axes are at right angles, so each can be clamped on its own.
+    const double scale = TOCropMin(1.0, TOCropMin(limitX / reachX, limitY / reachY));
+    const double slackX = limitX - reachX * scale;
+    const double slackY = limitY - reachY * scale;
+    const double clampedX = TOCropMax(-slackX, TOCropMin(alongX, slackX));
+    const double clampedY = TOCropMax(-slackY, TOCropMin(alongY, slackY));
+
+    const TOCropPoint center = {imageSize.width * 0.5 + clampedX * cosine - clampedY * sine,
+                                imageSize.height * 0.5 + clampedX * sine + clampedY * cosine};
+    const TOCropSize size = {rect.size.width * scale, rect.size.height * scale};
+    return (TOCropRect){{center.x - size.width * 0.5, center.y - size.height * 0.5}, size};
+}
+
+#pragma mark - Perspective -
+
+// The z component of the cross product of the edges from `a` to `b`, and from `b` to `c`.
+// It's positive when the path turns clockwise on screen, since y points down.
+static inline double TOCropTurn(TOCropPoint a, TOCropPoint b, TOCropPoint c) {
+    return (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+}
+
+static inline double TOCropDistance(TOCropPoint a, TOCropPoint b) {
+    return hypot(b.x - a.x, b.y - a.y);
+}
+
+TOCropQuad TOCropGeometryQuadWithRect(TOCropRect rect) {
+    return (TOCropQuad){{TOCropRectMinX(rect), TOCropRectMinY(rect)}, {TOCropRectMaxX(rect), TOCropRectMinY(rect)},
+                        {TOCropRectMaxX(rect), TOCropRectMaxY(rect)}, {TOCropRectMinX(rect), TOCropRectMaxY(rect)}};
+}
+
+TOCropRect TOCropGeometryQuadBoundingRect(TOCropQuad quad) {
+    const double minX = TOCropMin(TOCropMin(quad.topLeft.x, quad.topRight.x), TOCropMin(quad.bottomRight.x, quad.bottomLeft.x));
+    const double maxX = TOCropMax(TOCropMax(quad.topLeft.x, quad.topRight.x), TOCropMax(quad.bottomRight.x, quad.bottomLeft.x));
+    const double minY = TOCropMin(TOCropMin(quad.topLeft.y, quad.topRight.y), TOCropMin(quad.bottomRight.y, quad.bottomLeft.y));
+    const double maxY = TOCropMax(TOCropMax(quad.topLeft.y, quad.topRight.y), TOCropMax(quad.bottomRight.y, quad.bottomLeft.y));
+    return (TOCropRect){{minX, minY}, {maxX - minX, maxY - minY}};
+}
+
+bool TOCropGeometryQuadIsConvex(TOCropQuad quad) {
+    return (TOCropTurn(quad.bottomLeft, quad.topLeft, quad.topRight) > 0.0 &&
+            TOCropTurn(quad.topLeft, quad.topRight, quad.bottomRight) > 0.0 &&
+            TOCropTurn(quad.topRight, quad.bottomRight, quad.bottomLeft) > 0.0 &&
+            TOCropTurn(quad.bottomRight, quad.bottomLeft, quad.topLeft) > 0.0);
+}
+
+TOCropEdge TOCropGeometryQuadCornerForPoint(TOCropQuad quad, TOCropPoint point, double radius) {
+    const TOCropEdge corners[] = {TOCropEdgeTopLeft, TOCropEdgeTopRight, TOCropEdgeBottomRight, TOCropEdgeBottomLeft};
+    const TOCropPoint points[] = {quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft};
+
+    TOCropEdge closestCorner = TOCropEdgeNone;
+    double closestDistance = radius;
+    for (int i = 0; i < 4; i++) {
+        const double distance = TOCropDistance(points[i], point);
+        if (distance <= closestDistance) {
+            closestCorner = corners[i];
+            closestDistance = distance;
+        }
+    }
+    return closestCorner;
+}
+
+TOCropQuad TOCropGeometryMoveQuadCorner(TOCropQuad quad, TOCropEdge corner, TOCropPoint point, TOCropRect bounds) {
+    const TOCropPoint clampedPoint = {TOCropMax(TOCropRectMinX(bounds), TOCropMin(point.x, TOCropRectMaxX(bounds))),
+                                      TOCropMax(TOCropRectMinY(bounds), TOCropMin(point.y, TOCropRectMaxY(bounds)))};
+
+    TOCropQuad movedQuad = quad;
+    switch (corner) {
+        case TOCropEdgeTopLeft: movedQuad.topLeft = clampedPoint; break;
+        case TOCropEdgeTopRight: movedQuad.topRight = clampedPoint; break;
+        case TOCropEdgeBottomRight: movedQuad.bottomRight = clampedPoint; break;
+        case TOCropEdgeBottomLeft: movedQuad.bottomLeft = clampedPoint; break;
+        default: return quad;
+    }
+
+    return TOCropGeometryQuadIsConvex(movedQuad) ? movedQuad : quad;
+}
+
+TOCropSize TOCropGeometryPerspectiveOutputSize(TOCropQuad quad) {
+    return (TOCropSize){TOCropMax(TOCropDistance(quad.topLeft, quad.topRight), TOCropDistance(quad.bottomLeft, quad.bottomRight)),
+                        TOCropMax(TOCropDistance(quad.topLeft, quad.bottomLeft), TOCropDistance(quad.topRight, quad.bottomRight))};
+}
+
+bool TOCropGeometryHomographyForQuad(TOCropQuad quad, TOCropSize outputSize, TOCropHomography *homography) {
+    if (!TOCropGeometryQuadIsConvex(quad) || outputSize.width <= 0.0 || outputSize.height <= 0.0) {
+        return false;
+    }
+
+    // First map the unit square onto the quad (Heckbert, "Fundamentals of Texture Mapping", 1989),
+    // where (u, v) lands at ((au + bv + c) / w, (du + ev + f) / w), with w = gu + hv + 1.
+    // When the quad is a parallelogram, g and h come out as 0 and the transform is affine.
+    const TOCropPoint p0 = quad.topLeft, p1 = quad.topRight, p2 = quad.bottomRight, p3 = quad.bottomLeft;
+    const double sumX = p0.x - p1.x + p2.x - p3.x;
+    const double sumY = p0.y - p1.y + p2.y - p3.y;
+    const double dx1 = p1.x - p2.x, dx2 = p3.x - p2.x;
+    const double dy1 = p1.y - p2.y, dy2 = p3.y - p2.y;
+    const double denominator = dx1 * dy2 - dx2 * dy1;
+    if (fabs(denominator) < DBL_EPSILON) {
+        return false;
+    }
+
+    const double g = (sumX * dy2 - dx2 * sumY) / denominator;
+    const double h = (dx1 * sumY - sumX * dy1) / denominator;
+    const double a = p1.x - p0.x + g * p1.x;
+    const double b = p3.x - p0.x + h * p3.x;
+    const double d = p1.y - p0.y + g * p1.y;
+    const double e = p3.y - p0.y + h * p3.y;
+
+    // Then scale the square up to the output size, by dividing the first two columns by it
+    const double scaleX = 1.0 / outputSize.width;
+    const double scaleY = 1.0 / outputSize.height;
+    *homography = (TOCropHomography){{a * scaleX, b * scaleY, p0.x,
+                                      d * scaleX, e * scaleY, p0.y,
+                                      g * scaleX, h * scaleY, 1.0}};
+    return true;
+}
+
+TOCropPoint TOCropGeometryApplyHomography(const TOCropHomography *homography, TOCropPoint point) {
+    const double *m = homography->m;
+    const double w = m[6] * point.x + m[7] * point.y + m[8];
+    return (TOCropPoint){(m[0] * point.x + m[1] * point.y + m[2]) / w, (m[3] * point.x + m[4] * point.y + m[5]) / w};
+}
@@ -0,0 +1,277 @@
+//
+//  TOCropGeometry.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TOCropGeometry_h
+#define TOCropGeometry_h
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The smallest width or height the crop box can be resized to, in points
+#define TOCropGeometryMinimumBoxSize 42.0
+
+#pragma mark - Value Types -
+
+// These mirror the Core Graphics types (and have the same layout as them on 64-bit
+// platforms), so that the geometry doesn't depend on any Apple frameworks
+
+typedef struct {
+    double x;
+    double y;
+} TOCropPoint;
+
+typedef struct {
+    double width;
+    double height;
+} TOCropSize;
+
+typedef struct {
+    TOCropPoint origin;
+    TOCropSize size;
+} TOCropRect;
+
+typedef struct {
+    double top;
+    double left;
+    double bottom;
+    double right;
+} TOCropInsets;
+
+/// Four corners that don't have to make a rectangle, such as the edges of a page photographed at an angle
+typedef struct {
+    TOCropPoint topLeft;
+    TOCropPoint topRight;
+    TOCropPoint bottomRight;
+    TOCropPoint bottomLeft;
+} TOCropQuad;
+
+/// A 3x3 projective transform, in row major order. A point (x, y) is mapped to
+/// ((m[0]x + m[1]y + m[2]) / w, (m[3]x + m[4]y + m[5]) / w), where w = m[6]x + m[7]y + m[8].
+typedef struct {
+    double m[9];
+} TOCropHomography;
+
+/// The edge or corner of the crop box that a touch is dragging
+typedef enum {
+    TOCropEdgeNone,
+    TOCropEdgeTopLeft,
+    TOCropEdgeTop,
+    TOCropEdgeTopRight,
+    TOCropEdgeRight,
+    TOCropEdgeBottomRight,
+    TOCropEdgeBottom,
+    TOCropEdgeBottomLeft,
+    TOCropEdgeLeft
+} TOCropEdge;
+
+/// A snapshot of everything the crop geometry is worked out from: the crop view,
+/// its crop box, and the scroll view that pans and zooms the image behind it.
+typedef struct {
+    TOCropRect bounds;          // The bounds of the crop view
+    TOCropRect contentBounds;   // The region of the crop view, inside its padding, that the crop box can occupy
+    TOCropSize imageSize;       // The size of the image in points, with its width and height swapped when rotated by 90° or 270°
+    TOCropRect cropBoxFrame;    // The crop box, in the crop view's coordinate space
+    TOCropPoint contentOffset;  // The content offset of the scroll view
+    TOCropSize contentSize;     // The content size of the scroll view (ie, the image at the current zoom scale)
+    TOCropInsets contentInset;  // The content insets of the scroll view, which line up with the crop box
+    double zoomScale;           // The zoom scale of the scroll view
+    double minimumZoomScale;    // The zoom scale at which the image only just fills the crop box
+    double maximumZoomScale;    // The zoom scale the user can't zoom in past
+} TOCropLayout;
+
+/// A new crop box and scroll view position, worked out by one of the functions below
+typedef struct {
+    TOCropRect cropBoxFrame;   // The new crop box, before it's clamped by `TOCropGeometryClampCropBox`
+    TOCropPoint contentOffset; // The new content offset of the scroll view
+    double zoomScale;          // The new zoom scale of the scroll view
+    double scale;              // How much the zoom scale was multiplied by (1 if it didn't change)
+} TOCropLayoutUpdate;
+
+/// The state of a crop box being resized by dragging one of its edges or corners
+typedef struct {
+    TOCropEdge edge;           // The edge or corner being dragged
+    TOCropRect originFrame;    // The crop box when the drag began
+    TOCropPoint originPoint;   // The touch point when the drag began
+    double padding;            // How far outside the content bounds the touch can go
+    bool aspectRatioLocked;    // Whether the crop box keeps the aspect ratio it had when the drag began
+    double minimumAspectRatio; // The smallest ratio of the shorter side to the longer side. 0 allows any.
+} TOCropResize;
+
+#pragma mark - Crop Box -
+
+/// The edge or corner of the crop box (if any) that a touch at a point would start dragging
+TOCropEdge TOCropGeometryEdgeForPoint(TOCropRect cropBoxFrame, TOCropPoint point);
+
+/// The crop box after dragging the edge or corner in `resize` to `point`
+TOCropRect TOCropGeometryResizeCropBox(const TOCropLayout *layout, const TOCropResize *resize, TOCropPoint point);
+
+/// Nudges a crop box that's being resized (as returned by `TOCropGeometryResizeCropBox`) to exactly
+/// `aspectRatio`, by changing the side being dragged. When dragging a corner, whichever side is too
+/// long is shortened instead. The sides that aren't being dragged stay where they are.
+/// @return The box at `aspectRatio`, or `frame` unchanged if the ratio is locked, or the snapped
+/// box would be too small, outside the content bounds, or narrower than the minimum aspect ratio
+TOCropRect TOCropGeometrySnapCropBoxToAspectRatio(const TOCropLayout *layout, const TOCropResize *resize,
+                                                  TOCropRect frame, double aspectRatio);
+
+/// Clamps a crop box to the content bounds, rounds it to whole points, and keeps it
+/// at the minimum size or larger.
+/// @return false (leaving `clampedFrame` untouched) if the frame is empty or NaN, and should be ignored
+bool TOCropGeometryClampCropBox(TOCropRect contentBounds, TOCropRect frame, TOCropRect *clampedFrame);
+
+/// The scroll view insets that let the image be scrolled to the edges of a crop box
+TOCropInsets TOCropGeometryContentInsetForCropBox(TOCropRect bounds, TOCropRect cropBoxFrame);
+
+/// The zoom scale at which the image only just fills a crop box
+double TOCropGeometryMinimumZoomScale(TOCropSize imageSize, TOCropSize cropBoxSize);
+
+#pragma mark - Image Crop Frame -
+
+/// The region of the image (in points) that's inside the crop box
+TOCropRect TOCropGeometryImageCropFrame(const TOCropLayout *layout);
+
+/// Zooms and scrolls so that a region of the image fills the content bounds.
+/// `layout` should be at its minimum zoom scale, since the region is converted from image points with it.
+TOCropLayoutUpdate TOCropGeometryLayoutForImageCropFrame(const TOCropLayout *layout, TOCropRect imageCropFrame);
+
+#pragma mark - Layout -
+
+/// The layout the crop view starts with, and returns to when reset
+typedef struct {
+    double minimumZoomScale;   // The starting zoom scale, where the image fills the crop box
+    double maximumZoomScale;   // The zoom scale the user can't zoom in past
+    TOCropRect cropBoxFrame;   // The crop box, centered in the content bounds
+    TOCropSize contentSize;    // The content size of the scroll view at the starting zoom scale
+    bool centersContent;       // Whether the image overflows the crop box, so `contentOffset` should be applied
+    TOCropPoint contentOffset; // The content offset that centers the image in the crop box
+    TOCropSize fittedSize;     // The image's size when it fits inside the content bounds, ignoring any aspect ratio
+} TOCropInitialLayout;
+
+/// Fits the image (or a crop box of a specific aspect ratio) inside the content bounds
+/// @param contentBounds The region of the crop view that the crop box can occupy
+/// @param imageSize The size of the image, after rotation
+/// @param aspectRatio The aspect ratio of the crop box, or a zero size to match the image
+/// @param maximumZoomMultiplier How far past the starting zoom scale the user can zoom in
+TOCropInitialLayout TOCropGeometryInitialLayout(TOCropRect contentBounds, TOCropSize imageSize,
+                                                TOCropSize aspectRatio, double maximumZoomMultiplier);
+
+/// Scales the crop box up to fill the content bounds, and works out where to scroll
+/// so the same part of the image stays in it. Before applying `contentOffset`, clamp it with
+/// `TOCropGeometryClampContentOffset` against the content size at the new zoom scale.
+/// @return false if there's no crop box yet
+bool TOCropGeometryCenterCropBox(const TOCropLayout *layout, TOCropLayoutUpdate *update);
+
+/// Stops a content offset from scrolling past the bottom right of the content
+TOCropPoint TOCropGeometryClampContentOffset(TOCropPoint contentOffset, TOCropRect cropBoxFrame, TOCropSize contentSize);
+
+/// Reshapes the crop box to an aspect ratio, keeping its center in the same place
+/// @param aspectRatio The new aspect ratio, or a zero size to match the image
+/// @param imageIsLandscape Whether the image is wider than it is tall, which decides how a square ratio is applied
+/// @param zoomOut Set to true if the image should be zoomed out as far as it can be afterwards
+TOCropLayoutUpdate TOCropGeometryLayoutForAspectRatio(const TOCropLayout *layout, TOCropSize aspectRatio,
+                                                      bool imageIsLandscape, bool *zoomOut);
+
+/// Scales the crop box to fill the content bounds after the crop view has changed size (eg, device rotation).
+/// `zoomScale` and `scale` hold the zoom to apply, but `contentOffset` is left as it was; use
+/// `TOCropGeometryContentOffsetKeepingCenter` once the new zoom scale has been applied.
+TOCropLayoutUpdate TOCropGeometryLayoutForResizedBounds(const TOCropLayout *layout);
+
+/// The content offset that puts the same part of the image in the middle of the content bounds
+/// as before the crop view changed size
+/// @param layout The layout after resizing and zooming
+/// @param previousContentBounds The content bounds before resizing
+/// @param previousContentOffset The content offset before resizing
+/// @param previousContentSize The content size before resizing
+TOCropPoint TOCropGeometryContentOffsetKeepingCenter(const TOCropLayout *layout, TOCropRect previousContentBounds,
+                                                     TOCropPoint previousContentOffset, TOCropSize previousContentSize);
+
+#pragma mark - Straightening -
+
+/// How far the image can be straightened either way, in degrees
+#define TOCropGeometryMaximumStraighteningAngle 45.0
+
+/// The finest step the straightening angle moves in, in degrees
+#define TOCropGeometryStraighteningAngleStep 0.1
+
+/// Clamps a straightening angle (in degrees) to the range allowed, rounded to the nearest step.
+/// NaN is treated as 0.
+double TOCropGeometryClampStraighteningAngle(double angle);
+
+/// The largest region with the most area, with sides parallel to the crop box, that's completely
+/// covered by the image once it's rotated about its center by a straightening angle.
+/// The straightened image is the same size as the image, and shares its center.
+/// @param imageSize The size of the image, after any rotation by 90° steps
+/// @param angle The straightening angle, in degrees
+TOCropRect TOCropGeometryLargestStraightenedRect(TOCropSize imageSize, double angle);
+
+/// Shrinks a region of the straightened image (keeping its aspect ratio) until it's no larger than
+/// the image can cover, and then moves it as little as possible so that it's completely covered.
+/// @param imageSize The size of the image, after any rotation by 90° steps
+/// @param angle The straightening angle, in degrees
+/// @param rect The region, in the straightened image's coordinate space
+/// @return The region that's covered, or `rect` exactly as it was if it already is
+TOCropRect TOCropGeometryFitRectInStraightenedImage(TOCropSize imageSize, double angle, TOCropRect rect);
+
+#pragma mark - Perspective -
+
+/// The quad with the corners of a rect
+TOCropQuad TOCropGeometryQuadWithRect(TOCropRect rect);
+
+/// The smallest rect that contains all four corners of a quad
+TOCropRect TOCropGeometryQuadBoundingRect(TOCropQuad quad);
+
+/// Whether a quad is convex, with its corners going clockwise on screen (as they are when it's a rect),
+/// and so can be flattened into a rect. Quads with three corners in a line aren't.
+bool TOCropGeometryQuadIsConvex(TOCropQuad quad);
+
+/// The corner of a quad (if any) that a touch at a point would start dragging. The closest corner
+/// within `radius` of the point wins, and every other edge is `TOCropEdgeNone`.
+TOCropEdge TOCropGeometryQuadCornerForPoint(TOCropQuad quad, TOCropPoint point, double radius);
+
+/// The quad after dragging one of its corners to a point, which is kept inside `bounds`.
+/// If the corner would make the quad concave, the quad is returned as it was.
+TOCropQuad TOCropGeometryMoveQuadCorner(TOCropQuad quad, TOCropEdge corner, TOCropPoint point, TOCropRect bounds);
+
+/// The size of the rect a quad is flattened into: the longer of each pair of opposite sides,
+/// so that no part of the quad is shrunk
+TOCropSize TOCropGeometryPerspectiveOutputSize(TOCropQuad quad);
+
+/// The transform that maps each point of a rect with its origin at zero (the flattened image) to where it
+/// lands in a quad (the part of the original image being flattened). This is the direction an image is
+/// warped in, since every output pixel is looked up in the original.
+/// @param quad The corners the rect's corners map to, in order
+/// @param outputSize The size of the flattened rect
+/// @param homography Set to the transform, if there is one
+/// @return false if the quad isn't convex, or the size is empty
+bool TOCropGeometryHomographyForQuad(TOCropQuad quad, TOCropSize outputSize, TOCropHomography *homography);
+
+/// Maps a point through a homography
+TOCropPoint TOCropGeometryApplyHomography(const TOCropHomography *homography, TOCropPoint point);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropGeometry_h */
@@ -0,0 +1,149 @@
+//
+//  TOCropOverlayGeometry.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropOverlayGeometry.h"
+
+#include <math.h>
+
+// The sizes of the overlay's lines, in points
+static const double TOCropOverlayBorderThickness = 1.0;
+static const double TOCropOverlayCornerThickness = 3.0;
+static const double TOCropOverlayCornerLength = 20.0;
+
+static inline TOCropOverlayLine TOCropOverlayLineMake(double x, double y, double width, double height, TOCropOverlayLineKind kind) {
+    return (TOCropOverlayLine){{{x, y}, {width, height}}, kind};
+}
+
+// How far across the box each grid line sits, as a fraction of the space between the lines
+static unsigned int TOCropOverlayGridFractions(const TOCropOverlayStyle *style, double fractions[TOCropOverlayMaximumGridDivisions]) {
+    switch (style->gridStyle) {
+        case TOCropOverlayGridGoldenRatio: {
+            const double goldenRatio = (1.0 + sqrt(5.0)) * 0.5;
+            fractions[0] = 1.0 - (1.0 / goldenRatio);
+            fractions[1] = 1.0 / goldenRatio;
+            return 2;
+        }
+        case TOCropOverlayGridUniform: {
+            unsigned int divisions = style->gridDivisions;
+            divisions = divisions < 1 ? 1 : (divisions > TOCropOverlayMaximumGridDivisions ? TOCropOverlayMaximumGridDivisions : divisions);
+            for (unsigned int i = 1; i < divisions; i++) {
+                fractions[i - 1] = (double)i / (double)divisions;
+            }
+            return divisions - 1;
+        }
+        case TOCropOverlayGridThirds:
+        default:
+            fractions[0] = 1.0 / 3.0;
+            fractions[1] = 2.0 / 3.0;
+            return 2;
+    }
+}
+
+size_t TOCropOverlayGenerateLines(TOCropSize size, const TOCropOverlayStyle *style,
+                                  TOCropOverlayLine lines[TOCropOverlayMaximumLineCount]) {
+    const double width = size.width, height = size.height;
+    const double border = TOCropOverlayBorderThickness;
+    const double corner = TOCropOverlayCornerThickness;
+    const double length = TOCropOverlayCornerLength;
+    size_t count = 0;
+
+    // The border sits just outside the box: top, right, bottom, left
+    lines[count++] = TOCropOverlayLineMake(-border, -border, width + (border * 2.0), border, TOCropOverlayLineBorder);
+    lines[count++] = TOCropOverlayLineMake(width, 0.0, border, height, TOCropOverlayLineBorder);
+    lines[count++] = TOCropOverlayLineMake(-border, height, width + (border * 2.0), border, TOCropOverlayLineBorder);
+    lines[count++] = TOCropOverlayLineMake(-border, 0.0, border, height + border, TOCropOverlayLineBorder);
+
+    // Each corner is a vertical and a horizontal line, clockwise from the top left
+    lines[count++] = TOCropOverlayLineMake(-corner, -corner, corner, length + corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(0.0, -corner, length, corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(width, -corner, corner, length + corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(width - length, -corner, length, corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(width, height - length, corner, length + corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(width - length, height, length, corner, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(-corner, height - length, corner, length, TOCropOverlayLineCorner);
+    lines[count++] = TOCropOverlayLineMake(-corner, height, length + corner, corner, TOCropOverlayLineCorner);
+
+    // The grid lines are spaced out across what's left once their own thickness is taken out,
+    // so with thirds, the three rows (and columns) come out exactly the same size
+    double fractions[TOCropOverlayMaximumGridDivisions];
+    const unsigned int lineCount = TOCropOverlayGridFractions(style, fractions);
+    const double thickness = style->gridLineThickness;
+
+    if (style->horizontalGridLines) {
+        const double space = height - (thickness * lineCount);
+        for (unsigned int i = 0; i < lineCount; i++) {
+            const double y = (space * fractions[i]) + (thickness * i);
+            lines[count++] = TOCropOverlayLineMake(0.0, y, width, thickness, TOCropOverlayLineGrid);
+        }
+    }
+
+    if (style->verticalGridLines) {
+        const double space = width - (thickness * lineCount);
+        for (unsigned int i = 0; i < lineCount; i++) {
+            const double x = (space * fractions[i]) + (thickness * i);
+            lines[count++] = TOCropOverlayLineMake(x, 0.0, thickness, height, TOCropOverlayLineGrid);
+        }
+    }
+
+    return count;
+}
+
+static inline bool TOCropOverlayRectIsEmpty(TOCropRect rect) {
+    return rect.size.width <= 0.0 || rect.size.height <= 0.0;
+}
+
+static TOCropRect TOCropOverlayRectUnion(TOCropRect a, TOCropRect b) {
+    if (TOCropOverlayRectIsEmpty(a)) { return b; }
+    if (TOCropOverlayRectIsEmpty(b)) { return a; }
+
+    const double minX = fmin(a.origin.x, b.origin.x);
+    const double minY = fmin(a.origin.y, b.origin.y);
+    const double maxX = fmax(a.origin.x + a.size.width, b.origin.x + b.size.width);
+    const double maxY = fmax(a.origin.y + a.size.height, b.origin.y + b.size.height);
+    return (TOCropRect){{minX, minY}, {maxX - minX, maxY - minY}};
+}
+
+static inline bool TOCropOverlayRectEqualToRect(TOCropRect a, TOCropRect b) {
+    return a.origin.x == b.origin.x && a.origin.y == b.origin.y &&
+           a.size.width == b.size.width && a.size.height == b.size.height;
+}
+
+TOCropRect TOCropOverlayDirtyRect(const TOCropOverlayLine *oldLines, size_t oldCount,
+                                  const TOCropOverlayLine *newLines, size_t newCount, unsigned int kinds) {
+    TOCropRect dirtyRect = {{0.0, 0.0}, {0.0, 0.0}};
+
+    // Lines are always generated in the same order, so the same line is at the same index
+    // in both lists, unless the grid was changed. Anything past the shorter list is new or gone.
+    const size_t count = oldCount > newCount ? oldCount : newCount;
+    for (size_t i = 0; i < count; i++) {
+        const TOCropOverlayLine *oldLine = (i < oldCount && (oldLines[i].kind & kinds)) ? &oldLines[i] : NULL;
+        const TOCropOverlayLine *newLine = (i < newCount && (newLines[i].kind & kinds)) ? &newLines[i] : NULL;
+        if (oldLine && newLine && oldLine->kind == newLine->kind && TOCropOverlayRectEqualToRect(oldLine->rect, newLine->rect)) {
+            continue;
+        }
+
+        if (oldLine) { dirtyRect = TOCropOverlayRectUnion(dirtyRect, oldLine->rect); }
+        if (newLine) { dirtyRect = TOCropOverlayRectUnion(dirtyRect, newLine->rect); }
+    }
+
+    return dirtyRect;
+}
@@ -0,0 +1,88 @@
+//
+//  TOCropOverlayGeometry.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropOverlayGeometry_h
+#define TOCropOverlayGeometry_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "TOCropGeometry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Works out every line of the crop box overlay (the border, the corner handles and the
+/// interior grid) as one packed list of rectangles, so the whole overlay can be drawn by
+/// a single path rather than a view per line.
+
+/// The most rows or columns a uniform grid can be divided into
+#define TOCropOverlayMaximumGridDivisions 12
+
+/// The most lines an overlay can be made of: 4 border lines, 8 corner lines and the grid
+#define TOCropOverlayMaximumLineCount (12 + (2 * (TOCropOverlayMaximumGridDivisions - 1)))
+
+/// How the interior grid divides up the crop box
+typedef enum {
+    TOCropOverlayGridThirds,      // Two lines each way, a third of the way in from each side
+    TOCropOverlayGridGoldenRatio, // Two lines each way, dividing each side by the golden ratio
+    TOCropOverlayGridUniform      // `gridDivisions` rows and columns of equal size
+} TOCropOverlayGridStyle;
+
+/// The parts of the overlay a line belongs to. These can be combined to pick out several at once.
+typedef enum {
+    TOCropOverlayLineBorder = 1 << 0, // The thin outline of the crop box
+    TOCropOverlayLineCorner = 1 << 1, // The thick corner handles
+    TOCropOverlayLineGrid = 1 << 2    // The interior grid, which fades in and out separately
+} TOCropOverlayLineKind;
+
+typedef struct {
+    TOCropRect rect;           // The line, relative to the top left of the crop box
+    TOCropOverlayLineKind kind;
+} TOCropOverlayLine;
+
+typedef struct {
+    TOCropOverlayGridStyle gridStyle;
+    unsigned int gridDivisions; // For uniform grids, the number of rows and columns (clamped to 1...`TOCropOverlayMaximumGridDivisions`)
+    bool horizontalGridLines;   // Whether the grid includes lines running across the box
+    bool verticalGridLines;     // Whether the grid includes lines running down the box
+    double gridLineThickness;   // The thickness of the grid lines, normally one pixel
+} TOCropOverlayStyle;
+
+/// Works out the overlay's lines for a crop box of `size`, in one pass: the border, then the
+/// corners, then the horizontal and vertical grid lines, from top to bottom and left to right
+/// @return The number of lines written to `lines`
+size_t TOCropOverlayGenerateLines(TOCropSize size, const TOCropOverlayStyle *style,
+                                  TOCropOverlayLine lines[TOCropOverlayMaximumLineCount]);
+
+/// The smallest rectangle covering every line of `kinds` that was added, removed or moved
+/// between two sets of lines, in both its old and new positions.
+/// @return A rectangle of zero size if none of those lines changed
+TOCropRect TOCropOverlayDirtyRect(const TOCropOverlayLine *oldLines, size_t oldCount,
+                                  const TOCropOverlayLine *newLines, size_t newCount, unsigned int kinds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropOverlayGeometry_h */
@@ -0,0 +1,553 @@
+//
+//  TOCropTrace.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropTrace.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// A trace starts with a magic number and format version, then the header as 64-bit floats (and
+// a byte of flags), then each event: a type byte, the time since the previous event in microseconds
+// as a variable-length integer, and the event's values as 32-bit floats. Everything is little-endian.
+
+static const uint8_t TOCropTraceMagic[4] = {'T', 'O', 'C', 'T'};
+static const uint8_t TOCropTraceVersion = 1;
+
+enum {
+    TOCropTraceHeaderValueCount = 26, // The layout and its base maximum zoom scale
+    TOCropTraceHeaderLength = 4 + 1 + ((TOCropTraceHeaderValueCount + 2) * 8) + 1
+};
+
+enum {
+    TOCropTraceFlagAspectRatioLocked = 1 << 0,
+    TOCropTraceFlagImageIsLandscape = 1 << 1
+};
+
+// How many 32-bit floats follow each type of event
+static size_t TOCropTraceEventValueCount(TOCropTraceEventType type) {
+    switch (type) {
+        case TOCropTraceEventPanBegan:
+        case TOCropTraceEventPanMoved:
+        case TOCropTraceEventPanEnded:
+        case TOCropTraceEventScroll:
+        case TOCropTraceEventAspectRatio:
+            return 2;
+        case TOCropTraceEventZoom:
+            return 3;
+        case TOCropTraceEventRotateClockwise:
+        case TOCropTraceEventRotateCounterclockwise:
+        case TOCropTraceEventRecenter:
+            return 0;
+    }
+    return SIZE_MAX;
+}
+
+#pragma mark - Encoding -
+
+static uint8_t *TOCropTraceWriteUInt64(uint8_t *bytes, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) { bytes[i] = (uint8_t)(value >> (i * 8)); }
+    return bytes + 8;
+}
+
+static uint64_t TOCropTraceReadUInt64(const uint8_t *bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++) { value |= (uint64_t)bytes[i] << (i * 8); }
+    return value;
+}
+
+static uint8_t *TOCropTraceWriteDouble(uint8_t *bytes, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return TOCropTraceWriteUInt64(bytes, bits);
+}
+
+static double TOCropTraceReadDouble(const uint8_t *bytes) {
+    const uint64_t bits = TOCropTraceReadUInt64(bytes);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint8_t *TOCropTraceWriteFloat(uint8_t *bytes, double value) {
+    const float single = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &single, sizeof(bits));
+    for (size_t i = 0; i < 4; i++) { bytes[i] = (uint8_t)(bits >> (i * 8)); }
+    return bytes + 4;
+}
+
+static double TOCropTraceReadFloat(const uint8_t *bytes) {
+    uint32_t bits = 0;
+    for (size_t i = 0; i < 4; i++) { bits |= (uint32_t)bytes[i] << (i * 8); }
+    float single;
+    memcpy(&single, &bits, sizeof(single));
+    return single;
+}
+
+// The header's values, in the order they're stored
+static void TOCropTraceHeaderValues(const TOCropTraceHeader *header, double values[TOCropTraceHeaderValueCount]) {
+    const TOCropLayout *layout = &header->layout;
+    const double layoutValues[] = {
+        layout->bounds.origin.x, layout->bounds.origin.y, layout->bounds.size.width, layout->bounds.size.height,
+        layout->contentBounds.origin.x, layout->contentBounds.origin.y, layout->contentBounds.size.width, layout->contentBounds.size.height,
+        layout->imageSize.width, layout->imageSize.height,
+        layout->cropBoxFrame.origin.x, layout->cropBoxFrame.origin.y, layout->cropBoxFrame.size.width, layout->cropBoxFrame.size.height,
+        layout->contentOffset.x, layout->contentOffset.y,
+        layout->contentSize.width, layout->contentSize.height,
+        layout->contentInset.top, layout->contentInset.left, layout->contentInset.bottom, layout->contentInset.right,
+        layout->zoomScale, layout->minimumZoomScale, layout->maximumZoomScale,
+        header->baseMaximumZoomScale
+    };
+    memcpy(values, layoutValues, sizeof(layoutValues));
+}
+
+#pragma mark - Writing -
+
+struct TOCropTraceWriter {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    double time; // The time of the last event, as it was stored
+};
+
+TOCropTraceWriter *TOCropTraceWriterCreate(const TOCropTraceHeader *header) {
+    TOCropTraceWriter *writer = calloc(1, sizeof(TOCropTraceWriter));
+    if (writer == NULL) { return NULL; }
+
+    writer->capacity = 1024;
+    writer->bytes = malloc(writer->capacity);
+    if (writer->bytes == NULL) {
+        free(writer);
+        return NULL;
+    }
+
+    uint8_t *bytes = writer->bytes;
+    memcpy(bytes, TOCropTraceMagic, sizeof(TOCropTraceMagic));
+    bytes += sizeof(TOCropTraceMagic);
+    *bytes++ = TOCropTraceVersion;
+
+    double values[TOCropTraceHeaderValueCount];
+    TOCropTraceHeaderValues(header, values);
+    for (size_t i = 0; i < TOCropTraceHeaderValueCount; i++) {
+        bytes = TOCropTraceWriteDouble(bytes, values[i]);
+    }
+    bytes = TOCropTraceWriteDouble(bytes, header->padding);
+    bytes = TOCropTraceWriteDouble(bytes, header->minimumAspectRatio);
+    *bytes++ = (uint8_t)((header->aspectRatioLocked ? TOCropTraceFlagAspectRatioLocked : 0) |
+                         (header->imageIsLandscape ? TOCropTraceFlagImageIsLandscape : 0));
+
+    writer->length = (size_t)(bytes - writer->bytes);
+    return writer;
+}
+
+void TOCropTraceWriterDestroy(TOCropTraceWriter *writer) {
+    if (writer == NULL) { return; }
+    free(writer->bytes);
+    free(writer);
+}
+
+bool TOCropTraceWriterAppend(TOCropTraceWriter *writer, const TOCropTraceEvent *event) {
+    const size_t valueCount = TOCropTraceEventValueCount(event->type);
+    if (valueCount == SIZE_MAX) { return false; }
+
+    // A type byte, up to 10 bytes of time, and the values
+    const size_t maximumLength = 1 + 10 + (valueCount * 4);
+    if (writer->length + maximumLength > writer->capacity) {
+        size_t capacity = writer->capacity * 2;
+        while (writer->length + maximumLength > capacity) { capacity *= 2; }
+        uint8_t *bytes = realloc(writer->bytes, capacity);
+        if (bytes == NULL) { return false; }
+        writer->bytes = bytes;
+        writer->capacity = capacity;
+    }
+
+    // Times are stored relative to the previous event, so they rarely need more than a couple of bytes.
+    // Rounding against the time that was stored stops the error adding up over a long trace.
+    double delta = round((event->time - writer->time) * 1000000.0);
+    if (!(delta > 0.0)) { delta = 0.0; }
+    uint64_t microseconds = (uint64_t)delta;
+    writer->time += (double)microseconds / 1000000.0;
+
+    uint8_t *bytes = writer->bytes + writer->length;
+    *bytes++ = (uint8_t)event->type;
+    do {
+        uint8_t byte = microseconds & 0x7F;
+        microseconds >>= 7;
+        *bytes++ = byte | (microseconds ? 0x80 : 0);
+    } while (microseconds);
+
+    if (valueCount >= 2) {
+        bytes = TOCropTraceWriteFloat(bytes, event->point.x);
+        bytes = TOCropTraceWriteFloat(bytes, event->point.y);
+    }
+    if (valueCount >= 3) {
+        bytes = TOCropTraceWriteFloat(bytes, event->value);
+    }
+
+    writer->length = (size_t)(bytes - writer->bytes);
+    return true;
+}
+
+const uint8_t *TOCropTraceWriterBytes(const TOCropTraceWriter *writer, size_t *length) {
+    *length = writer->length;
+    return writer->bytes;
+}
+
+#pragma mark - Reading -
+
+bool TOCropTraceReaderInit(TOCropTraceReader *reader, const uint8_t *bytes, size_t length, TOCropTraceHeader *header) {
+    if (bytes == NULL || length < TOCropTraceHeaderLength) { return false; }
+    if (memcmp(bytes, TOCropTraceMagic, sizeof(TOCropTraceMagic)) != 0) { return false; }
+    if (bytes[sizeof(TOCropTraceMagic)] != TOCropTraceVersion) { return false; }
+
+    const uint8_t *position = bytes + sizeof(TOCropTraceMagic) + 1;
+    double values[TOCropTraceHeaderValueCount];
+    for (size_t i = 0; i < TOCropTraceHeaderValueCount; i++, position += 8) {
+        values[i] = TOCropTraceReadDouble(position);
+    }
+
+    TOCropLayout *layout = &header->layout;
+    layout->bounds = (TOCropRect){{values[0], values[1]}, {values[2], values[3]}};
+    layout->contentBounds = (TOCropRect){{values[4], values[5]}, {values[6], values[7]}};
+    layout->imageSize = (TOCropSize){values[8], values[9]};
+    layout->cropBoxFrame = (TOCropRect){{values[10], values[11]}, {values[12], values[13]}};
+    layout->contentOffset = (TOCropPoint){values[14], values[15]};
+    layout->contentSize = (TOCropSize){values[16], values[17]};
+    layout->contentInset = (TOCropInsets){values[18], values[19], values[20], values[21]};
+    layout->zoomScale = values[22];
+    layout->minimumZoomScale = values[23];
+    layout->maximumZoomScale = values[24];
+    header->baseMaximumZoomScale = values[25];
+
+    header->padding = TOCropTraceReadDouble(position);
+    header->minimumAspectRatio = TOCropTraceReadDouble(position + 8);
+    const uint8_t flags = position[16];
+    header->aspectRatioLocked = (flags & TOCropTraceFlagAspectRatioLocked) != 0;
+    header->imageIsLandscape = (flags & TOCropTraceFlagImageIsLandscape) != 0;
+
+    reader->bytes = bytes;
+    reader->length = length;
+    reader->position = TOCropTraceHeaderLength;
+    reader->time = 0.0;
+    return true;
+}
+
+int TOCropTraceReaderNext(TOCropTraceReader *reader, TOCropTraceEvent *event) {
+    if (reader->position == reader->length) { return 0; }
+
+    const uint8_t *bytes = reader->bytes + reader->position;
+    const uint8_t *end = reader->bytes + reader->length;
+
+    const TOCropTraceEventType type = (TOCropTraceEventType)*bytes++;
+    const size_t valueCount = TOCropTraceEventValueCount(type);
+    if (valueCount == SIZE_MAX) { return -1; }
+
+    uint64_t microseconds = 0;
+    for (unsigned int shift = 0;; shift += 7) {
+        if (bytes == end || shift > 63) { return -1; }
+        const uint8_t byte = *bytes++;
+        microseconds |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) { break; }
+    }
+
+    if ((size_t)(end - bytes) < valueCount * 4) { return -1; }
+
+    memset(event, 0, sizeof(TOCropTraceEvent));
+    event->type = type;
+    reader->time += (double)microseconds / 1000000.0;
+    event->time = reader->time;
+    if (valueCount >= 2) {
+        event->point.x = TOCropTraceReadFloat(bytes);
+        event->point.y = TOCropTraceReadFloat(bytes + 4);
+    }
+    if (valueCount >= 3) {
+        event->value = TOCropTraceReadFloat(bytes + 8);
+    }
+
+    reader->position = (size_t)(bytes + (valueCount * 4) - reader->bytes);
+    return 1;
+}
+
+#pragma mark - Replaying -
+
+// These follow what `TOCropView` does when each of its layout properties
+// is set, and with the same rounding
+
+static inline double TOCropTraceClampZoomScale(const TOCropLayout *layout, double zoomScale) {
+    return fmax(layout->minimumZoomScale, fmin(layout->maximumZoomScale, zoomScale));
+}
+
+// Like UIScrollView, keep the zoom within its bounds and size the content to the zoomed image
+static void TOCropTraceSetZoomScale(TOCropLayout *layout, double zoomScale) {
+    layout->zoomScale = TOCropTraceClampZoomScale(layout, zoomScale);
+    layout->contentSize = (TOCropSize){layout->imageSize.width * layout->zoomScale,
+                                       layout->imageSize.height * layout->zoomScale};
+}
+
+// `setCropBoxFrame:`
+static void TOCropTraceSetCropBoxFrame(TOCropTraceReplayState *state, TOCropRect cropBoxFrame) {
+    TOCropLayout *layout = &state->layout;
+    if (memcmp(&cropBoxFrame, &layout->cropBoxFrame, sizeof(TOCropRect)) == 0) { return; }
+
+    TOCropRect clampedFrame;
+    if (!TOCropGeometryClampCropBox(layout->contentBounds, cropBoxFrame, &clampedFrame)) { return; }
+
+    layout->cropBoxFrame = clampedFrame;
+    layout->contentInset = TOCropGeometryContentInsetForCropBox(layout->bounds, clampedFrame);
+    layout->minimumZoomScale = TOCropGeometryMinimumZoomScale(layout->imageSize, clampedFrame.size);
+    layout->maximumZoomScale = fmax(layout->minimumZoomScale, state->baseMaximumZoomScale);
+    TOCropTraceSetZoomScale(layout, layout->zoomScale);
+}
+
+// `moveCroppedContentToCenterAnimated:`
+static void TOCropTraceRecenter(TOCropTraceReplayState *state) {
+    TOCropLayout *layout = &state->layout;
+    TOCropLayoutUpdate update;
+    if (!TOCropGeometryCenterCropBox(layout, &update)) { return; }
+
+    if (update.scale != 1.0) {
+        TOCropTraceSetZoomScale(layout, update.zoomScale);
+    }
+    if (layout->zoomScale < layout->maximumZoomScale - FLT_EPSILON) {
+        layout->contentOffset = TOCropGeometryClampContentOffset(update.contentOffset, update.cropBoxFrame, layout->contentSize);
+    }
+    TOCropTraceSetCropBoxFrame(state, update.cropBoxFrame);
+}
+
+// `setAspectRatio:animated:`
+static void TOCropTraceSetAspectRatio(TOCropTraceReplayState *state, TOCropSize aspectRatio) {
+    bool zoomOut = false;
+    const TOCropLayoutUpdate update = TOCropGeometryLayoutForAspectRatio(&state->layout, aspectRatio,
+                                                                         state->settings.imageIsLandscape, &zoomOut);
+    state->layout.contentOffset = update.contentOffset;
+    TOCropTraceSetCropBoxFrame(state, update.cropBoxFrame);
+    if (zoomOut) {
+        TOCropTraceSetZoomScale(&state->layout, state->layout.minimumZoomScale);
+    }
+    TOCropTraceRecenter(state);
+}
+
+// `rotateImageNinetyDegreesAnimated:clockwise:completion:`, scaling the crop box to
+// fit the content bounds rather than restoring a size it was previously edited at
+static void TOCropTraceRotate(TOCropTraceReplayState *state, bool clockwise) {
+    TOCropLayout *layout = &state->layout;
+    const TOCropRect contentBounds = layout->contentBounds;
+    const TOCropRect cropBoxFrame = layout->cropBoxFrame;
+    if (cropBoxFrame.size.width < FLT_EPSILON || cropBoxFrame.size.height < FLT_EPSILON) { return; }
+
+    const double scale = fmin(contentBounds.size.width / cropBoxFrame.size.height,
+                              contentBounds.size.height / cropBoxFrame.size.width);
+
+    // The part of the image in the middle of the crop box
+    TOCropPoint target = {cropBoxFrame.origin.x + cropBoxFrame.size.width * 0.5 + layout->contentOffset.x,
+                          cropBoxFrame.origin.y + cropBoxFrame.size.height * 0.5 + layout->contentOffset.y};
+
+    const double oldZoomScale = layout->zoomScale;
+    layout->minimumZoomScale *= scale;
+    state->baseMaximumZoomScale *= scale;
+    layout->maximumZoomScale = fmax(layout->minimumZoomScale, state->baseMaximumZoomScale);
+    layout->imageSize = (TOCropSize){layout->imageSize.height, layout->imageSize.width};
+    TOCropTraceSetZoomScale(layout, layout->zoomScale * scale);
+
+    TOCropRect newCropFrame;
+    newCropFrame.size = (TOCropSize){floorf(cropBoxFrame.size.height * scale), floorf(cropBoxFrame.size.width * scale)};
+    newCropFrame.origin.x = floorf(contentBounds.origin.x + contentBounds.size.width * 0.5 - newCropFrame.size.width * 0.5);
+    newCropFrame.origin.y = floorf(contentBounds.origin.y + contentBounds.size.height * 0.5 - newCropFrame.size.height * 0.5);
+
+    TOCropTraceSetCropBoxFrame(state, newCropFrame);
+    TOCropTraceRecenter(state);
+    newCropFrame = layout->cropBoxFrame;
+
+    const double appliedScale = (oldZoomScale > FLT_EPSILON) ? (layout->zoomScale / oldZoomScale) : scale;
+    target.x *= appliedScale;
+    target.y *= appliedScale;
+
+    const double swap = target.x;
+    if (clockwise) {
+        target.x = layout->contentSize.width - target.y;
+        target.y = swap;
+    } else {
+        target.x = target.y;
+        target.y = layout->contentSize.height - swap;
+    }
+
+    TOCropPoint offset;
+    offset.x = floorf(-(newCropFrame.origin.x + newCropFrame.size.width * 0.5) + target.x);
+    offset.y = floorf(-(newCropFrame.origin.y + newCropFrame.size.height * 0.5) + target.y);
+    offset.x = fmax(-layout->contentInset.left, offset.x);
+    offset.y = fmax(-layout->contentInset.top, offset.y);
+    offset.x = fmin(layout->contentSize.width - (newCropFrame.origin.x + newCropFrame.size.width), offset.x);
+    offset.y = fmin(layout->contentSize.height - (newCropFrame.origin.y + newCropFrame.size.height), offset.y);
+    layout->contentOffset = offset;
+}
+
+// `updateCropBoxFrameWithGesturePoint:`
+static void TOCropTraceResizeCropBox(TOCropTraceReplayState *state, TOCropPoint point) {
+    TOCropResize resize;
+    resize.edge = state->panEdge;
+    resize.originFrame = state->panOriginFrame;
+    resize.originPoint = state->panOriginPoint;
+    resize.padding = state->settings.padding;
+    resize.aspectRatioLocked = state->settings.aspectRatioLocked;
+    resize.minimumAspectRatio = state->settings.minimumAspectRatio;
+    TOCropTraceSetCropBoxFrame(state, TOCropGeometryResizeCropBox(&state->layout, &resize, point));
+}
+
+void TOCropTraceReplayStateInit(TOCropTraceReplayState *state, const TOCropTraceHeader *header) {
+    memset(state, 0, sizeof(TOCropTraceReplayState));
+    state->layout = header->layout;
+    state->baseMaximumZoomScale = header->baseMaximumZoomScale;
+    state->settings = *header;
+    state->panOriginFrame = header->layout.cropBoxFrame;
+}
+
+void TOCropTraceReplayEvent(TOCropTraceReplayState *state, const TOCropTraceEvent *event) {
+    switch (event->type) {
+        case TOCropTraceEventPanBegan:
+            state->panOriginPoint = event->point;
+            state->panOriginFrame = state->layout.cropBoxFrame;
+            state->panEdge = TOCropGeometryEdgeForPoint(state->layout.cropBoxFrame, event->point);
+            TOCropTraceResizeCropBox(state, event->point); // The crop view applies the first touch point too
+            break;
+        case TOCropTraceEventPanMoved:
+        case TOCropTraceEventPanEnded:
+            TOCropTraceResizeCropBox(state, event->point);
+            break;
+        case TOCropTraceEventScroll:
+            state->layout.contentOffset = event->point;
+            break;
+        case TOCropTraceEventZoom:
+            TOCropTraceSetZoomScale(&state->layout, event->value);
+            state->layout.contentOffset = event->point;
+            break;
+        case TOCropTraceEventRotateClockwise:
+        case TOCropTraceEventRotateCounterclockwise:
+            TOCropTraceRotate(state, event->type == TOCropTraceEventRotateClockwise);
+            break;
+        case TOCropTraceEventAspectRatio:
+            TOCropTraceSetAspectRatio(state, (TOCropSize){event->point.x, event->point.y});
+            break;
+        case TOCropTraceEventRecenter:
+            TOCropTraceRecenter(state);
+            break;
+    }
+}
+
+uint64_t TOCropTraceLayoutChecksum(const TOCropLayout *layout) {
+    const TOCropTraceHeader header = {*layout, 0.0, 0.0, 0.0, false, false};
+    double values[TOCropTraceHeaderValueCount];
+    TOCropTraceHeaderValues(&header, values);
+
+    // 64-bit FNV-1a over each value in thousandths of a point
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < TOCropTraceHeaderValueCount - 1; i++) {
+        const uint64_t value = (uint64_t)llround(values[i] * 1000.0);
+        for (size_t byte = 0; byte < 8; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xFF;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+static double TOCropTraceCurrentTime(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + ((double)time.tv_nsec / 1000000000.0);
+}
+
+static int TOCropTraceCompareTimes(const void *a, const void *b) {
+    const double first = *(const double *)a;
+    const double second = *(const double *)b;
+    return (first > second) - (first < second);
+}
+
+// The nearest-rank percentile of a sorted list
+static double TOCropTracePercentile(const double *sortedTimes, size_t count, double percentile) {
+    size_t rank = (size_t)ceil(percentile * (double)count);
+    rank = rank < 1 ? 1 : (rank > count ? count : rank);
+    return sortedTimes[rank - 1];
+}
+
+bool TOCropTraceReplay(const uint8_t *bytes, size_t length, unsigned int iterations, TOCropTraceReplayResult *result) {
+    TOCropTraceReader reader;
+    TOCropTraceHeader header;
+    if (!TOCropTraceReaderInit(&reader, bytes, length, &header)) { return false; }
+
+    // Decode the events up front, so only applying them is timed
+    size_t eventCount = 0, capacity = 256;
+    TOCropTraceEvent *events = malloc(capacity * sizeof(TOCropTraceEvent));
+    if (events == NULL) { return false; }
+
+    int status;
+    while ((status = TOCropTraceReaderNext(&reader, &events[eventCount])) == 1) {
+        if (++eventCount < capacity) { continue; }
+        capacity *= 2;
+        TOCropTraceEvent *grown = realloc(events, capacity * sizeof(TOCropTraceEvent));
+        if (grown == NULL) {
+            free(events);
+            return false;
+        }
+        events = grown;
+    }
+    if (status < 0) {
+        free(events);
+        return false;
+    }
+
+    iterations = iterations > 0 ? iterations : 1;
+    const size_t timeCount = eventCount * iterations;
+    double *times = malloc((timeCount > 0 ? timeCount : 1) * sizeof(double));
+    if (times == NULL) {
+        free(events);
+        return false;
+    }
+
+    TOCropTraceReplayState state;
+    for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+        TOCropTraceReplayStateInit(&state, &header);
+        double *iterationTimes = times + (iteration * eventCount);
+        for (size_t i = 0; i < eventCount; i++) {
+            const double start = TOCropTraceCurrentTime();
+            TOCropTraceReplayEvent(&state, &events[i]);
+            iterationTimes[i] = TOCropTraceCurrentTime() - start;
+        }
+    }
+
+    memset(result, 0, sizeof(TOCropTraceReplayResult));
+    result->eventCount = eventCount;
+    result->finalLayout = state.layout;
+    result->checksum = TOCropTraceLayoutChecksum(&state.layout);
+    if (timeCount > 0) {
+        qsort(times, timeCount, sizeof(double), TOCropTraceCompareTimes);
+        result->medianEventTime = TOCropTracePercentile(times, timeCount, 0.5);
+        result->p99EventTime = TOCropTracePercentile(times, timeCount, 0.99);
+        result->maximumEventTime = times[timeCount - 1];
+    }
+
+    free(times);
+    free(events);
+    return true;
+}
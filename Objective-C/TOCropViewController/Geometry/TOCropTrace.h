@@ -0,0 +1,149 @@
+//
+//  TOCropTrace.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropTrace_h
+#define TOCropTrace_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "TOCropGeometry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A recording of a user's session with the crop view: the layout it started from,
+/// followed by each interaction, in a compact binary form. Replaying a trace through
+/// the crop geometry reproduces the session without any views, so it can be timed
+/// (and its result compared) on any platform.
+
+#pragma mark - Events -
+
+/// The kinds of interaction a trace records
+typedef enum {
+    TOCropTraceEventPanBegan = 1,           // A drag on the crop box started at `point`
+    TOCropTraceEventPanMoved,               // The drag moved to `point`
+    TOCropTraceEventPanEnded,               // The drag finished at `point`
+    TOCropTraceEventScroll,                 // The user scrolled the image to the content offset `point`
+    TOCropTraceEventZoom,                   // The user zoomed the image to `value`, at the content offset `point`
+    TOCropTraceEventRotateClockwise,        // The image was rotated 90° clockwise
+    TOCropTraceEventRotateCounterclockwise, // The image was rotated 90° counterclockwise
+    TOCropTraceEventAspectRatio,            // The aspect ratio was changed to `point` (width, height), or zero to match the image
+    TOCropTraceEventRecenter                // The crop box settled, and was scaled back up to fill the crop view
+} TOCropTraceEventType;
+
+typedef struct {
+    TOCropTraceEventType type;
+    double time;       // Seconds since recording started (stored to the microsecond)
+    TOCropPoint point; // The touch point, content offset or aspect ratio, depending on the type (stored as floats)
+    double value;      // The zoom scale of a zoom event (stored as a float)
+} TOCropTraceEvent;
+
+/// The state of the crop view when recording started
+typedef struct {
+    TOCropLayout layout;          // The crop view's layout
+    double baseMaximumZoomScale;  // The zoom ceiling of the layout, before being raised to at least the minimum
+    double padding;               // The crop view's padding, which touches can stray past the content bounds by
+    double minimumAspectRatio;    // The crop box's minimum aspect ratio, or 0
+    bool aspectRatioLocked;       // Whether resizing the crop box keeps its aspect ratio
+    bool imageIsLandscape;        // Whether the unrotated image is wider than it is tall
+} TOCropTraceHeader;
+
+#pragma mark - Writing -
+
+/// Builds up a trace in memory as events are appended
+typedef struct TOCropTraceWriter TOCropTraceWriter;
+
+/// Creates a writer for a trace that starts from `header`
+/// @return NULL if there wasn't enough memory
+TOCropTraceWriter *TOCropTraceWriterCreate(const TOCropTraceHeader *header);
+void TOCropTraceWriterDestroy(TOCropTraceWriter *writer);
+
+/// Appends an event. Events should be appended in time order.
+/// @return false if there wasn't enough memory, in which case the trace is left as it was
+bool TOCropTraceWriterAppend(TOCropTraceWriter *writer, const TOCropTraceEvent *event);
+
+/// The trace so far. The bytes are owned by the writer, and only valid until the next append.
+const uint8_t *TOCropTraceWriterBytes(const TOCropTraceWriter *writer, size_t *length);
+
+#pragma mark - Reading -
+
+/// Reads events back out of a trace, one at a time
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t position;
+    double time;
+} TOCropTraceReader;
+
+/// Starts reading a trace, reading its header
+/// @return false if the bytes aren't a trace this version can read
+bool TOCropTraceReaderInit(TOCropTraceReader *reader, const uint8_t *bytes, size_t length, TOCropTraceHeader *header);
+
+/// Reads the next event
+/// @return 1 if an event was read, 0 at the end of the trace, or -1 if the trace is malformed
+int TOCropTraceReaderNext(TOCropTraceReader *reader, TOCropTraceEvent *event);
+
+#pragma mark - Replaying -
+
+/// The crop geometry's state partway through a replay
+typedef struct {
+    TOCropLayout layout;          // The layout, as the crop view would have it
+    double baseMaximumZoomScale;  // The zoom ceiling of the layout, before being raised to at least the minimum
+    TOCropTraceHeader settings;   // The settings the trace was recorded with
+    TOCropRect panOriginFrame;    // The crop box when the current drag began
+    TOCropPoint panOriginPoint;   // Where the current drag began
+    TOCropEdge panEdge;           // The edge of the crop box being dragged
+} TOCropTraceReplayState;
+
+/// Sets up a replay from the state the trace was recorded from
+void TOCropTraceReplayStateInit(TOCropTraceReplayState *state, const TOCropTraceHeader *header);
+
+/// Applies one event to the layout, the same way the crop view does
+void TOCropTraceReplayEvent(TOCropTraceReplayState *state, const TOCropTraceEvent *event);
+
+/// A checksum of a layout, with each value rounded to a thousandth of a point
+/// so it comes out the same across compilers and CPUs
+uint64_t TOCropTraceLayoutChecksum(const TOCropLayout *layout);
+
+/// The timings and outcome of replaying a trace
+typedef struct {
+    size_t eventCount;          // How many events each replay applied
+    double medianEventTime;     // The 50th percentile time to apply one event, in seconds
+    double p99EventTime;        // The 99th percentile time to apply one event, in seconds
+    double maximumEventTime;    // The slowest event, in seconds
+    TOCropLayout finalLayout;   // The layout once every event was applied
+    uint64_t checksum;          // `TOCropTraceLayoutChecksum` of the final layout
+} TOCropTraceReplayResult;
+
+/// Replays a whole trace, timing each event
+/// @param iterations How many times to replay the trace, with every event's time counted in the percentiles
+/// @return false if the trace is malformed, or there wasn't enough memory to hold the timings
+bool TOCropTraceReplay(const uint8_t *bytes, size_t length, unsigned int iterations, TOCropTraceReplayResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropTrace_h */
@@ -22,6 +22,12 @@
 
 #import <UIKit/UIKit.h>
 
+#if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropViewConstants.h"
+#else
+#import <TOCropViewController/TOCropViewConstants.h>
+#endif
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface TOActivityCroppedImageProvider : UIActivityItemProvider
@@ -31,6 +37,15 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) NSInteger angle;
 @property (nonatomic, readonly) BOOL circular;
 
+/// The angle the image is straightened by after `angle`, in degrees. Default is 0.
+@property (nonatomic, assign) CGFloat straighteningAngle;
+
+/// Whether `quadrilateral` is flattened into the image, rather than `cropFrame` cropped out of it. Default is NO.
+@property (nonatomic, assign) BOOL perspectiveCorrected;
+
+/// The corners of the region flattened when `perspectiveCorrected` is set.
+@property (nonatomic, assign) TOCropQuadrilateral quadrilateral;
+
 - (nonnull instancetype)initWithImage:(nonnull UIImage *)image cropFrame:(CGRect)cropFrame angle:(NSInteger)angle circular:(BOOL)circular;
 
 @end
@@ -22,6 +22,7 @@
 
 #import "TOActivityCroppedImageProvider.h"
 
+#import "TOCropRenderCache.h"
 #import "UIImage+CropRotate.h"
 
 @interface TOActivityCroppedImageProvider ()
@@ -60,12 +61,33 @@
 #pragma mark - Image Generation -
 - (id)item {
     // If the user didn't touch the image, just forward along the original
-    if (self.angle == 0 && CGRectEqualToRect(self.cropFrame, (CGRect){CGPointZero, self.image.size})) {
+    if (self.angle == 0 && self.straighteningAngle == 0.0f && !self.perspectiveCorrected && CGRectEqualToRect(self.cropFrame, (CGRect){CGPointZero, self.image.size})) {
         self.croppedImage = self.image;
         return self.croppedImage;
     }
 
-    UIImage *image = [self.image croppedImageWithFrame:self.cropFrame angle:self.angle circularClip:self.circular];
+    // The same crop is often rendered for the 'Done' callback too, so share it through the cache
+    if (self.perspectiveCorrected) {
+        self.croppedImage = [TOCropRenderCache.sharedCache croppedImageForImage:self.image
+                                                                  quadrilateral:self.quadrilateral
+                                                                          angle:self.angle
+                                                             straighteningAngle:self.straighteningAngle
+                                                                    renderBlock:^UIImage *{
+            return [self.image perspectiveCorrectedImageWithQuadrilateral:self.quadrilateral angle:self.angle
+                                                       straighteningAngle:self.straighteningAngle];
+        }];
+        return self.croppedImage;
+    }
+
+    UIImage *image = [TOCropRenderCache.sharedCache croppedImageForImage:self.image
+                                                                   frame:self.cropFrame
+                                                                   angle:self.angle
+                                                      straighteningAngle:self.straighteningAngle
+                                                                circular:self.circular
+                                                             renderBlock:^UIImage *{
+        return [self.image croppedImageWithFrame:self.cropFrame angle:self.angle
+                              straighteningAngle:self.straighteningAngle circularClip:self.circular];
+    }];
     self.croppedImage = image;
     return self.croppedImage;
 }
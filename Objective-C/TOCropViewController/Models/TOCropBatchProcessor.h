@@ -0,0 +1,89 @@
+//
+//  TOCropBatchProcessor.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<TOCropViewController/TOCroppedImageAttributes.h>)
+#import "TOCroppedImageAttributes.h"
+#else
+#import <TOCropViewController/TOCroppedImageAttributes.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Called once for each image in a batch, in the order the images were supplied.
+/// @param index The index of the image in the batch
+/// @param outputURL The file the cropped image was written to, or nil if it failed
+/// @param error Why the image couldn't be cropped. `NSUserCancelledError` if the batch was cancelled first.
+typedef void (^TOCropBatchItemCompletion)(NSUInteger index, NSURL *_Nullable outputURL, NSError *_Nullable error);
+
+/// Applies the same crop to a whole set of image files, such as a burst of photos, or every image a
+/// user selected at once. The crop's frame is scaled to each image in turn, so files of different
+/// resolutions are all cropped to the same region.
+///
+/// Each image is decoded, cropped and then encoded on its own queue, so while one image is being
+/// cropped, the next is already being decoded and the previous one is being written out. A batch
+/// takes about as long as its slowest stage, and only a few images are held in memory at a time.
+@interface TOCropBatchProcessor : NSObject
+
+/// The crop applied to every image. Its frame is relative to its `originalImageSize`.
+@property (nonatomic, readonly) TOCroppedImageAttributes *attributes;
+
+/// Whether the images are cropped to a circle (Default is NO)
+@property (nonatomic, assign) BOOL circular;
+
+/// The UTI of the image format to write, such as "public.jpeg". By default, each image is written in
+/// its original format, or as a PNG when `circular` is YES so the corners stay transparent.
+@property (nullable, nonatomic, copy) NSString *outputType;
+
+/// The quality used when writing lossy formats, between 0.0 and 1.0 (Default is 0.9)
+@property (nonatomic, assign) CGFloat compressionQuality;
+
+/// The most images that can wait between two stages of the batch at once. Lower values use less
+/// memory, and higher ones keep the stages busy when some images take much longer than others.
+/// Default is 2.
+@property (nonatomic, assign) NSUInteger maximumQueuedImages;
+
+/// Creates a new processor that crops images with the supplied attributes
+/// @param attributes The crop to apply, such as one captured from a `TOCropViewController`
+- (instancetype)initWithAttributes:(TOCroppedImageAttributes *)attributes NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Crops each image file to a new file. Both arrays must be the same length.
+/// @param sourceURLs The files of the images to crop
+/// @param destinationURLs The files each of the cropped images will be written to
+/// @param itemCompletion Called on the main queue as each image finishes
+/// @param completion Called on the main queue once every image has finished
+- (void)cropImagesAtURLs:(NSArray<NSURL *> *)sourceURLs
+                  toURLs:(NSArray<NSURL *> *)destinationURLs
+          itemCompletion:(nullable TOCropBatchItemCompletion)itemCompletion
+              completion:(nullable void (^)(void))completion;
+
+/// Stops every batch that is currently running. Images that haven't been written yet are
+/// reported to their item completion handler with an `NSUserCancelledError` error.
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,227 @@
+//
+//  TOCropBatchProcessor.m
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "TOCropBatchProcessor.h"
+#import "UIImage+CropRotate.h"
+
+#import <ImageIO/ImageIO.h>
+
+// Written when a circular crop doesn't specify a format, since it needs an alpha channel
+static NSString * const kTOCropBatchCircularOutputType = @"public.png";
+
+#pragma mark - Image I/O -
+
+static UIImageOrientation TOCropImageOrientationForEXIFOrientation(NSInteger orientation) {
+    switch (orientation) {
+        case 2: return UIImageOrientationUpMirrored;
+        case 3: return UIImageOrientationDown;
+        case 4: return UIImageOrientationDownMirrored;
+        case 5: return UIImageOrientationLeftMirrored;
+        case 6: return UIImageOrientationRight;
+        case 7: return UIImageOrientationRightMirrored;
+        case 8: return UIImageOrientationLeft;
+        default: return UIImageOrientationUp;
+    }
+}
+
+static NSError *TOCropBatchError(NSInteger code, NSURL *url) {
+    return [NSError errorWithDomain:NSCocoaErrorDomain code:code userInfo:@{NSURLErrorKey: url}];
+}
+
+// Fully decodes the first image in a file, so the crop stage doesn't end up decoding it lazily.
+static UIImage *TOCropBatchDecodeImage(NSURL *url, NSString **type) {
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)url, NULL);
+    if (source == NULL) { return nil; }
+
+    NSDictionary *options = @{(id)kCGImageSourceShouldCacheImmediately: @YES};
+    CGImageRef imageRef = CGImageSourceCreateImageAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    *type = [(__bridge NSString *)CGImageSourceGetType(source) copy];
+    CFRelease(source);
+    if (imageRef == NULL) { return nil; }
+
+    NSNumber *orientation = properties[(id)kCGImagePropertyOrientation];
+    UIImage *image = [UIImage imageWithCGImage:imageRef
+                                         scale:1.0f
+                                   orientation:TOCropImageOrientationForEXIFOrientation(orientation.integerValue)];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+static BOOL TOCropBatchEncodeImage(UIImage *image, NSURL *url, NSString *type, CGFloat compressionQuality) {
+    CGImageDestinationRef destination = CGImageDestinationCreateWithURL((__bridge CFURLRef)url,
+                                                                        (__bridge CFStringRef)type, 1, NULL);
+    if (destination == NULL) { return NO; }
+
+    NSDictionary *properties = @{(id)kCGImageDestinationLossyCompressionQuality: @(compressionQuality)};
+    CGImageDestinationAddImage(destination, image.CGImage, (__bridge CFDictionaryRef)properties);
+    const BOOL success = CGImageDestinationFinalize(destination);
+    CFRelease(destination);
+    return success;
+}
+
+#pragma mark - Batch Processor -
+
+@interface TOCropBatchProcessor () {
+    NSUInteger _generation; // Incremented on cancel, which invalidates every running batch
+}
+
+@property (nonatomic, strong, readwrite) TOCroppedImageAttributes *attributes;
+
+@end
+
+@implementation TOCropBatchProcessor
+
+- (instancetype)initWithAttributes:(TOCroppedImageAttributes *)attributes {
+    if (self = [super init]) {
+        _attributes = attributes;
+        _compressionQuality = 0.9f;
+        _maximumQueuedImages = 2;
+    }
+
+    return self;
+}
+
+- (CGRect)cropFrameForImageSize:(CGSize)imageSize {
+    // Scale the frame from the size the crop was made against to this image,
+    // so a crop made on a preview lands in the same place on the full resolution file.
+    CGRect frame = self.attributes.croppedFrame;
+    const CGSize originalSize = self.attributes.originalImageSize;
+    if (originalSize.width > 0.0f && originalSize.height > 0.0f) {
+        const CGFloat scaleX = imageSize.width / originalSize.width;
+        const CGFloat scaleY = imageSize.height / originalSize.height;
+        const CGFloat minX = round(CGRectGetMinX(frame) * scaleX);
+        const CGFloat minY = round(CGRectGetMinY(frame) * scaleY);
+        frame = (CGRect){minX, minY,
+                         round(CGRectGetMaxX(frame) * scaleX) - minX,
+                         round(CGRectGetMaxY(frame) * scaleY) - minY};
+    }
+
+    return CGRectIntersection(frame, (CGRect){CGPointZero, imageSize});
+}
+
+- (void)cropImagesAtURLs:(NSArray<NSURL *> *)sourceURLs
+                  toURLs:(NSArray<NSURL *> *)destinationURLs
+          itemCompletion:(TOCropBatchItemCompletion)itemCompletion
+              completion:(void (^)(void))completion {
+    NSParameterAssert(sourceURLs.count == destinationURLs.count);
+    const NSUInteger count = MIN(sourceURLs.count, destinationURLs.count);
+
+    // Capture the settings so changing them mid-batch doesn't affect images already underway
+    const NSUInteger generation = __atomic_load_n(&_generation, __ATOMIC_RELAXED);
+    const NSInteger angle = self.attributes.angle;
+    const BOOL circular = self.circular;
+    const CGFloat compressionQuality = self.compressionQuality;
+    NSString *outputType = self.outputType ?: (circular ? kTOCropBatchCircularOutputType : nil);
+
+    // Each stage is serial, so images stay in order, and stages overlap across consecutive images.
+    // A stage blocks once the queue ahead of it is full, which caps how many images are in memory.
+    dispatch_queue_t decodeQueue = dispatch_queue_create("dev.tim.TOCropBatchProcessor.decode", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t cropQueue = dispatch_queue_create("dev.tim.TOCropBatchProcessor.crop", DISPATCH_QUEUE_SERIAL);
+    dispatch_queue_t encodeQueue = dispatch_queue_create("dev.tim.TOCropBatchProcessor.encode", DISPATCH_QUEUE_SERIAL);
+    const long queueLimit = (long)MAX(self.maximumQueuedImages, 1);
+    dispatch_semaphore_t decodedSlots = dispatch_semaphore_create(queueLimit);
+    dispatch_semaphore_t croppedSlots = dispatch_semaphore_create(queueLimit);
+    dispatch_group_t group = dispatch_group_create();
+
+    // Every image passes through all three stages, even after it fails or is cancelled,
+    // so that each semaphore is signalled as many times as it is waited on.
+    dispatch_group_enter(group);
+    dispatch_async(decodeQueue, ^{
+        for (NSUInteger i = 0; i < count; i++) {
+            NSURL *sourceURL = sourceURLs[i];
+            NSURL *destinationURL = destinationURLs[i];
+            dispatch_group_enter(group);
+            dispatch_semaphore_wait(decodedSlots, DISPATCH_TIME_FOREVER);
+
+            __block UIImage *image = nil;
+            __block NSString *type = outputType;
+            __block NSError *error = nil;
+            @autoreleasepool {
+                if ([self isBatchCancelled:generation]) {
+                    error = TOCropBatchError(NSUserCancelledError, sourceURL);
+                }
+                else {
+                    NSString *sourceType = nil;
+                    image = TOCropBatchDecodeImage(sourceURL, &sourceType);
+                    type = type ?: sourceType;
+                    if (image == nil) { error = TOCropBatchError(NSFileReadCorruptFileError, sourceURL); }
+                }
+            }
+
+            dispatch_async(cropQueue, ^{
+                @autoreleasepool {
+                    if (error == nil && [self isBatchCancelled:generation]) {
+                        error = TOCropBatchError(NSUserCancelledError, sourceURL);
+                    }
+                    if (error == nil) {
+                        const CGRect frame = [self cropFrameForImageSize:image.size];
+                        if (CGRectIsEmpty(frame)) {
+                            error = TOCropBatchError(NSFileReadCorruptFileError, sourceURL);
+                        }
+                        else {
+                            image = [image croppedImageWithFrame:frame angle:angle circularClip:circular];
+                        }
+                    }
+                    if (error != nil) { image = nil; }
+                }
+                dispatch_semaphore_signal(decodedSlots);
+                dispatch_semaphore_wait(croppedSlots, DISPATCH_TIME_FOREVER);
+
+                dispatch_async(encodeQueue, ^{
+                    @autoreleasepool {
+                        if (error == nil && [self isBatchCancelled:generation]) {
+                            error = TOCropBatchError(NSUserCancelledError, sourceURL);
+                        }
+                        if (error == nil && !TOCropBatchEncodeImage(image, destinationURL, type, compressionQuality)) {
+                            error = TOCropBatchError(NSFileWriteUnknownError, destinationURL);
+                        }
+                        image = nil;
+                    }
+                    dispatch_semaphore_signal(croppedSlots);
+
+                    NSError *itemError = error;
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        if (itemCompletion) { itemCompletion(i, itemError ? nil : destinationURL, itemError); }
+                        dispatch_group_leave(group);
+                    });
+                });
+            });
+        }
+        dispatch_group_leave(group);
+    });
+
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        if (completion) { completion(); }
+    });
+}
+
+- (BOOL)isBatchCancelled:(NSUInteger)generation {
+    return __atomic_load_n(&_generation, __ATOMIC_RELAXED) != generation;
+}
+
+- (void)cancel {
+    __atomic_fetch_add(&_generation, 1, __ATOMIC_RELAXED);
+}
+
+@end
@@ -0,0 +1,112 @@
+//
+//  TOCropMemoryAccountant.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ How much a buffer is needed, which decides the order buffers are evicted in
+ when memory runs short
+ */
+typedef NS_ENUM(NSInteger, TOCropMemoryPriority) {
+    TOCropMemoryPriorityCache,    // Kept around in case it's used again (eg, rendered crops and tiles). Evicted first.
+    TOCropMemoryPriorityPreview,  // Makes the crop view faster or nicer to look at (eg, mipmaps and the blurred backdrop). Evicted next.
+    TOCropMemoryPriorityRequired  // Needed for the crop to carry on (eg, the image itself, or an animation's snapshot). Never evicted.
+};
+
+@class TOCropMemoryAccountant;
+
+/// One buffer being counted by a `TOCropMemoryAccountant`. The buffer stops being
+/// counted when `remove` is called, or when this object is deallocated.
+@interface TOCropMemoryAllocation : NSObject
+
+/// A description of the buffer, for debugging
+@property (nonatomic, readonly) NSString *name;
+
+/// How much the buffer is needed
+@property (nonatomic, readonly) TOCropMemoryPriority priority;
+
+/// The size of the buffer, in bytes. Set this whenever the buffer grows or shrinks.
+@property (nonatomic, assign) NSUInteger byteCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Stops counting the buffer. Its eviction handler won't be called after this.
+- (void)remove;
+
+@end
+
+/// Keeps count of the large buffers that are alive across the whole crop pipeline (the image,
+/// its mipmaps and backdrop, rendered tiles and crops, and animation snapshots), so their total
+/// can be seen and limited together.
+///
+/// When the total goes over `byteLimit`, or the system reports memory pressure, the buffers
+/// that can be rebuilt are evicted, caches first and then previews, oldest first, until the
+/// total fits again. Required buffers are never evicted.
+///
+/// This class is thread-safe. Eviction handlers are always called on the main queue.
+@interface TOCropMemoryAccountant : NSObject
+
+/// The accountant that every crop view, cache and transition in the app reports to
+@property (class, nonatomic, readonly) TOCropMemoryAccountant *sharedAccountant;
+
+/// The most bytes that the counted buffers may add up to. Going over evicts buffers until the total fits,
+/// and new caches and previews that wouldn't fit aren't allowed at all. 0 means there's no limit. Default is 0.
+/// App extensions, which are terminated at a much lower memory footprint than apps, should set this.
+@property (nonatomic, assign) NSUInteger byteLimit;
+
+/// The bytes of every buffer being counted right now
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+/// The highest `byteCount` has been since the accountant was created, or since `resetPeakByteCount`
+@property (nonatomic, readonly) NSUInteger peakByteCount;
+
+/// How many buffers have been evicted so far
+@property (nonatomic, readonly) NSUInteger evictionCount;
+
+/// Starts counting a buffer. If it would take the total over `byteLimit`, cheaper buffers are evicted to make
+/// room for it first.
+/// @param name A description of the buffer, for debugging
+/// @param byteCount The size of the buffer, in bytes
+/// @param priority How much the buffer is needed
+/// @param evictionHandler Called on the main queue when the buffer should be let go of. It should free the
+///        buffer, and then remove the allocation (or set its byte count to what's left). Required buffers don't need one.
+/// @return The allocation, which the owner of the buffer should hold on to for as long as the buffer is alive.
+///         Nil if the buffer is a cache or preview that wouldn't fit under `byteLimit`, in which case it shouldn't be kept.
+- (nullable TOCropMemoryAllocation *)addAllocationWithName:(NSString *)name
+                                                 byteCount:(NSUInteger)byteCount
+                                                  priority:(TOCropMemoryPriority)priority
+                                           evictionHandler:(nullable void (^)(void))evictionHandler;
+
+/// Evicts every cache and preview, as happens when the system reports memory pressure
+- (void)evictReclaimableAllocations;
+
+/// Sets `peakByteCount` back to the current `byteCount`
+- (void)resetPeakByteCount;
+
+/// The bytes taken up by the pixels of an image, once it's decoded
++ (NSUInteger)byteCountOfImage:(nullable UIImage *)image;
+
+@end
+
+NS_ASSUME_NONNULL_END
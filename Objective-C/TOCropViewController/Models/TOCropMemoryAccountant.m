@@ -0,0 +1,314 @@
+//
+//  TOCropMemoryAccountant.m
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "TOCropMemoryAccountant.h"
+
+// The accountant's record of one buffer. It's kept apart from `TOCropMemoryAllocation`,
+// so that the accountant doesn't retain the allocations its owners are holding on to.
+@interface TOCropMemoryEntry : NSObject
+@property (nonatomic, assign) TOCropMemoryPriority priority;
+@property (nonatomic, assign) NSUInteger byteCount;
+@property (nonatomic, copy) void (^evictionHandler)(void);
+@property (nonatomic, assign) BOOL evicting; /* Its eviction handler has been queued, so its bytes are already on their way out */
+@end
+
+@implementation TOCropMemoryEntry
+@end
+
+@interface TOCropMemoryAccountant () {
+    /* These, and the entries below, are only accessed while holding the lock on the accountant */
+    NSUInteger _byteLimit;
+    NSUInteger _byteCount;
+    NSUInteger _peakByteCount;
+    NSUInteger _evictionCount;
+}
+
+@property (nonatomic, strong) NSMutableArray<TOCropMemoryEntry *> *entries;  /* Every buffer being counted, from oldest to newest */
+@property (nonatomic, strong) dispatch_source_t memoryPressureSource;        /* Evicts everything it can when the system runs short of memory */
+
+- (void)setByteCount:(NSUInteger)byteCount forEntry:(TOCropMemoryEntry *)entry;
+- (void)removeEntry:(TOCropMemoryEntry *)entry;
+
+@end
+
+#pragma mark - Allocations -
+
+@interface TOCropMemoryAllocation ()
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, assign, readwrite) TOCropMemoryPriority priority;
+@property (nonatomic, weak) TOCropMemoryAccountant *accountant;
+@property (nonatomic, strong) TOCropMemoryEntry *entry;
+@end
+
+@implementation TOCropMemoryAllocation
+
+- (void)dealloc {
+    [_accountant removeEntry:_entry];
+}
+
+- (NSUInteger)byteCount {
+    TOCropMemoryAccountant *accountant = self.accountant;
+    if (accountant == nil) {
+        return 0;
+    }
+
+    @synchronized (accountant) {
+        return self.entry.byteCount;
+    }
+}
+
+- (void)setByteCount:(NSUInteger)byteCount {
+    [self.accountant setByteCount:byteCount forEntry:self.entry];
+}
+
+- (void)remove {
+    [self.accountant removeEntry:self.entry];
+}
+
+@end
+
+#pragma mark - Accountant -
+
+@implementation TOCropMemoryAccountant
+
++ (TOCropMemoryAccountant *)sharedAccountant {
+    static TOCropMemoryAccountant *sharedAccountant;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedAccountant = [[TOCropMemoryAccountant alloc] init];
+    });
+    return sharedAccountant;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _entries = [NSMutableArray array];
+
+        // A dispatch source rather than the app's memory warning notification, since it's delivered in app extensions too
+        _memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                       DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                       dispatch_get_main_queue());
+        __weak typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(_memoryPressureSource, ^{
+            [weakSelf evictReclaimableAllocations];
+        });
+        dispatch_resume(_memoryPressureSource);
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_memoryPressureSource);
+}
+
+#pragma mark - Counting -
+
+- (nullable TOCropMemoryAllocation *)addAllocationWithName:(NSString *)name
+                                                 byteCount:(NSUInteger)byteCount
+                                                  priority:(TOCropMemoryPriority)priority
+                                           evictionHandler:(nullable void (^)(void))evictionHandler {
+    TOCropMemoryEntry *entry = [[TOCropMemoryEntry alloc] init];
+    entry.priority = priority;
+    entry.byteCount = byteCount;
+    entry.evictionHandler = evictionHandler;
+
+    NSArray *evictionHandlers = nil;
+    @synchronized (self) {
+        // A cache or preview is only let in if evicting the buffers it outranks (or older ones like it) makes room
+        if (priority != TOCropMemoryPriorityRequired && _byteLimit > 0 &&
+            byteCount > _byteLimit - MIN(_byteLimit, [self remainingByteCountEvictingUpToPriority:priority])) {
+            return nil;
+        }
+
+        [self.entries addObject:entry];
+        _byteCount += byteCount;
+        _peakByteCount = MAX(_peakByteCount, _byteCount);
+        if (_byteLimit > 0) {
+            evictionHandlers = [self evictionHandlersToFitByteLimit:_byteLimit sparingEntry:entry];
+        }
+    }
+    [self performEvictionHandlers:evictionHandlers];
+
+    TOCropMemoryAllocation *allocation = [[TOCropMemoryAllocation alloc] init];
+    allocation.name = name;
+    allocation.priority = priority;
+    allocation.accountant = self;
+    allocation.entry = entry;
+    return allocation;
+}
+
+- (void)setByteCount:(NSUInteger)byteCount forEntry:(TOCropMemoryEntry *)entry {
+    NSArray *evictionHandlers = nil;
+    @synchronized (self) {
+        if (![self.entries containsObject:entry]) {
+            return;
+        }
+
+        _byteCount = _byteCount - entry.byteCount + byteCount;
+        _peakByteCount = MAX(_peakByteCount, _byteCount);
+        entry.byteCount = byteCount;
+
+        // Whatever is left after an eviction can be evicted again later
+        entry.evicting = NO;
+        if (_byteLimit > 0) {
+            evictionHandlers = [self evictionHandlersToFitByteLimit:_byteLimit sparingEntry:nil];
+        }
+    }
+    [self performEvictionHandlers:evictionHandlers];
+}
+
+- (void)removeEntry:(TOCropMemoryEntry *)entry {
+    if (entry == nil) {
+        return;
+    }
+
+    @synchronized (self) {
+        if (![self.entries containsObject:entry]) {
+            return;
+        }
+        _byteCount -= entry.byteCount;
+        [self.entries removeObject:entry];
+    }
+}
+
+#pragma mark - Eviction -
+
+- (void)evictReclaimableAllocations {
+    NSArray *evictionHandlers = nil;
+    @synchronized (self) {
+        // Nothing fits in a limit of 0, so this goes through every cache and preview
+        evictionHandlers = [self evictionHandlersToFitByteLimit:0 sparingEntry:nil];
+    }
+    [self performEvictionHandlers:evictionHandlers];
+}
+
+// These are only called while holding the lock on the accountant
+
+// The bytes that would be left if every buffer up to a priority was evicted
+- (NSUInteger)remainingByteCountEvictingUpToPriority:(TOCropMemoryPriority)priority {
+    NSUInteger byteCount = _byteCount;
+    for (TOCropMemoryEntry *entry in self.entries) {
+        if (entry.evicting || entry.priority <= priority) {
+            byteCount -= entry.byteCount;
+        }
+    }
+    return byteCount;
+}
+
+// Marks the cheapest buffers as evicting (caches before previews, and older before newer)
+// until the rest fit inside a limit, and returns their handlers
+- (NSArray<void (^)(void)> *)evictionHandlersToFitByteLimit:(NSUInteger)byteLimit sparingEntry:(nullable TOCropMemoryEntry *)sparedEntry {
+    NSUInteger byteCount = _byteCount;
+    for (TOCropMemoryEntry *entry in self.entries) {
+        if (entry.evicting) {
+            byteCount -= entry.byteCount;
+        }
+    }
+
+    NSMutableArray<void (^)(void)> *handlers = [NSMutableArray array];
+    for (TOCropMemoryPriority priority = TOCropMemoryPriorityCache; priority < TOCropMemoryPriorityRequired; priority++) {
+        for (TOCropMemoryEntry *entry in self.entries) {
+            if (byteCount <= byteLimit) {
+                return handlers;
+            }
+            if (entry.priority != priority || entry.evicting || entry == sparedEntry) {
+                continue;
+            }
+
+            entry.evicting = YES;
+            byteCount -= entry.byteCount;
+            _evictionCount++;
+            if (entry.evictionHandler) {
+                [handlers addObject:entry.evictionHandler];
+            }
+        }
+    }
+    return handlers;
+}
+
+- (void)performEvictionHandlers:(NSArray<void (^)(void)> *)handlers {
+    // Always deferred, so the owners never have a buffer pulled out from under them partway through a change
+    for (void (^handler)(void) in handlers) {
+        dispatch_async(dispatch_get_main_queue(), handler);
+    }
+}
+
+#pragma mark - Accessors -
+
+- (NSUInteger)byteLimit {
+    @synchronized (self) {
+        return _byteLimit;
+    }
+}
+
+- (void)setByteLimit:(NSUInteger)byteLimit {
+    NSArray *evictionHandlers = nil;
+    @synchronized (self) {
+        _byteLimit = byteLimit;
+        if (byteLimit > 0) {
+            evictionHandlers = [self evictionHandlersToFitByteLimit:byteLimit sparingEntry:nil];
+        }
+    }
+    [self performEvictionHandlers:evictionHandlers];
+}
+
+- (NSUInteger)byteCount {
+    @synchronized (self) {
+        return _byteCount;
+    }
+}
+
+- (NSUInteger)peakByteCount {
+    @synchronized (self) {
+        return _peakByteCount;
+    }
+}
+
+- (NSUInteger)evictionCount {
+    @synchronized (self) {
+        return _evictionCount;
+    }
+}
+
+- (void)resetPeakByteCount {
+    @synchronized (self) {
+        _peakByteCount = _byteCount;
+    }
+}
+
++ (NSUInteger)byteCountOfImage:(nullable UIImage *)image {
+    if (image == nil) {
+        return 0;
+    }
+
+    CGImageRef cgImage = image.CGImage;
+    if (cgImage) {
+        return CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage);
+    }
+
+    // Assume 4 bytes per pixel for images that aren't backed by a CGImage
+    const CGFloat scale = image.scale;
+    return (NSUInteger)(image.size.width * scale) * (NSUInteger)(image.size.height * scale) * 4;
+}
+
+@end
@@ -0,0 +1,128 @@
+//
+//  TOCropRenderCache.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropViewConstants.h"
+#else
+#import <TOCropViewController/TOCropViewConstants.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Holds on to recently rendered crops, so that cropping an image the same way again (such as
+/// for a preview, then the share sheet, then an upload) returns the image that was already
+/// rendered. Crops are looked up by the image they were cropped from, and everything that
+/// affects their pixels: the frame (or quadrilateral), angles, circular clip, and the size they were scaled to.
+///
+/// Once the crops add up to more than `byteBudget`, the least recently used ones are let go.
+/// If a crop is requested while it's already being rendered on another thread, the request
+/// waits for that render to finish, rather than rendering the same pixels twice.
+///
+/// Crops are keyed on the identity of the image object, not its pixels, so a crop is only
+/// found again when it's requested from the same `UIImage`. Once that image is deallocated,
+/// its crops can never be requested again, so they're let go as well.
+///
+/// This class is thread-safe.
+@interface TOCropRenderCache : NSObject
+
+/// The cache used by every crop view controller, render job, and activity item in the app
+@property (class, nonatomic, readonly) TOCropRenderCache *sharedCache;
+
+/// The most bytes of cropped images the cache holds at once. Lowering it lets go of the least
+/// recently used crops straight away. Default is 64MB.
+@property (nonatomic, assign) NSUInteger byteBudget;
+
+/// The bytes of cropped images currently in the cache
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+/// The number of cropped images currently in the cache
+@property (nonatomic, readonly) NSUInteger count;
+
+/// How many requests were answered with a crop that was cached, or was being rendered for another request
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+/// How many requests had to render their crop
+@property (nonatomic, readonly) NSUInteger missCount;
+
+/// Creates a new, empty cache
+/// @param byteBudget The most bytes of cropped images to hold at once
+- (instancetype)initWithByteBudget:(NSUInteger)byteBudget NS_DESIGNATED_INITIALIZER;
+
+/// Creates a new, empty cache, with the default budget
+- (instancetype)init;
+
+/// Returns the cached crop of an image if there is one. Otherwise, calls `renderBlock` on the
+/// current thread to render it, and caches the result. If the same crop is already being rendered,
+/// this blocks until that render finishes, so it shouldn't be called on the main thread.
+/// @param image The image being cropped
+/// @param frame The region of the image being cropped (in the image's point space, ie image.size)
+/// @param angle The angle the image is rotated at
+/// @param circular Whether the image is being cropped to a circle
+/// @param renderBlock Renders the crop. If it returns nil (eg, because it was cancelled), nothing is cached,
+///        and any requests waiting on it go on to render the crop themselves.
+/// @return The cropped image, or nil if `renderBlock` was called and returned nil
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                                  circular:(BOOL)circular
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock;
+
+/// The same as `croppedImageForImage:frame:angle:circular:renderBlock:`, for crops of an image
+/// that has been straightened by a fraction of a turn
+/// @param straighteningAngle The angle the image is straightened by after `angle`, in degrees
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                                  circular:(BOOL)circular
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock;
+
+/// The same as `croppedImageForImage:frame:angle:circular:renderBlock:`, for crops that
+/// are scaled to a final size as they're rendered
+/// @param pixelSize The size of the cropped image, in pixels, or CGSizeZero if it isn't scaled
+/// @param filter The filter used to scale the image (ignored when `pixelSize` is CGSizeZero)
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                                  circular:(BOOL)circular
+                                 pixelSize:(CGSize)pixelSize
+                                    filter:(TOCropViewResamplingFilter)filter
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock;
+
+/// The same as `croppedImageForImage:frame:angle:circular:renderBlock:`, for images flattened
+/// from a four-sided region (see `perspectiveCorrectedImageWithQuadrilateral:angle:straighteningAngle:`)
+/// @param quadrilateral The corners of the region being flattened (in the image's point space, ie image.size)
+/// @param straighteningAngle The angle the image is straightened by after `angle`, in degrees
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                             quadrilateral:(TOCropQuadrilateral)quadrilateral
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock;
+
+/// Lets go of every cached crop. Renders that are in progress are still shared with the requests waiting on them.
+- (void)removeAllImages;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,407 @@
+//
+//  TOCropRenderCache.m
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "TOCropRenderCache.h"
+#import "TOCropMemoryAccountant.h"
+
+static const NSUInteger kTOCropRenderCacheDefaultByteBudget = 64 * 1024 * 1024;
+
+#pragma mark - Keys -
+
+// Everything that decides the pixels of a crop. The image is only compared by its address, which is
+// safe because each entry also holds a weak reference to it, and is ignored once that's gone.
+@interface TOCropRenderCacheKey : NSObject <NSCopying>
+@property (nonatomic, assign) uintptr_t imageAddress;
+@property (nonatomic, assign) CGRect frame;
+@property (nonatomic, assign) NSInteger angle;
+@property (nonatomic, assign) CGFloat straighteningAngle;
+@property (nonatomic, assign) BOOL circular;
+@property (nonatomic, assign) BOOL perspectiveCorrected;
+@property (nonatomic, assign) TOCropQuadrilateral quadrilateral;
+@property (nonatomic, assign) CGSize pixelSize;
+@property (nonatomic, assign) TOCropViewResamplingFilter filter;
+@end
+
+@implementation TOCropRenderCacheKey
+
+- (id)copyWithZone:(NSZone *)zone {
+    // Keys are never changed once they're made
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) {
+        return YES;
+    }
+    if (![object isKindOfClass:[TOCropRenderCacheKey class]]) {
+        return NO;
+    }
+    TOCropRenderCacheKey *other = (TOCropRenderCacheKey *)object;
+    return self.imageAddress == other.imageAddress && CGRectEqualToRect(self.frame, other.frame) &&
+           self.angle == other.angle && self.straighteningAngle == other.straighteningAngle &&
+           self.circular == other.circular && self.perspectiveCorrected == other.perspectiveCorrected &&
+           TOCropQuadrilateralEqualToQuadrilateral(self.quadrilateral, other.quadrilateral) &&
+           CGSizeEqualToSize(self.pixelSize, other.pixelSize) && self.filter == other.filter;
+}
+
+- (NSUInteger)hash {
+    NSUInteger hash = 17;
+    hash = (hash * 31) + self.imageAddress;
+    hash = (hash * 31) + @(self.frame.origin.x).hash;
+    hash = (hash * 31) + @(self.frame.origin.y).hash;
+    hash = (hash * 31) + @(self.frame.size.width).hash;
+    hash = (hash * 31) + @(self.frame.size.height).hash;
+    hash = (hash * 31) + (NSUInteger)self.angle;
+    hash = (hash * 31) + @(self.straighteningAngle).hash;
+    hash = (hash * 31) + (NSUInteger)self.circular;
+    hash = (hash * 31) + (NSUInteger)self.perspectiveCorrected;
+    hash = (hash * 31) + @(self.quadrilateral.topLeft.x + self.quadrilateral.topRight.y).hash;
+    hash = (hash * 31) + @(self.quadrilateral.bottomRight.x + self.quadrilateral.bottomLeft.y).hash;
+    hash = (hash * 31) + @(self.pixelSize.width).hash;
+    hash = (hash * 31) + @(self.pixelSize.height).hash;
+    hash = (hash * 31) + (NSUInteger)self.filter;
+    return hash;
+}
+
+@end
+
+#pragma mark - Entries -
+
+@interface TOCropRenderCacheEntry : NSObject
+@property (nonatomic, weak) UIImage *sourceImage;     /* The image that was cropped. Once it's gone, the entry can't be requested again. */
+@property (nonatomic, strong) UIImage *croppedImage;  /* The rendered crop */
+@property (nonatomic, assign) NSUInteger byteCount;   /* The memory the crop's pixels take up */
+@end
+
+@implementation TOCropRenderCacheEntry
+@end
+
+// A render in progress, that any other requests for the same crop wait on
+@interface TOCropRenderCacheFlight : NSObject
+@property (nonatomic, strong) dispatch_group_t group;   /* Left once the render has finished */
+@property (nonatomic, strong) UIImage *croppedImage;    /* Set before the group is left. Nil if the render failed or was cancelled. */
+@end
+
+@implementation TOCropRenderCacheFlight
+@end
+
+#pragma mark - Cache -
+
+@interface TOCropRenderCache () {
+    /* These, and the collections below, are only accessed while holding the lock on the cache */
+    NSUInteger _byteCount;
+    NSUInteger _hitCount;
+    NSUInteger _missCount;
+}
+
+@property (nonatomic, strong) NSMutableDictionary<TOCropRenderCacheKey *, TOCropRenderCacheEntry *> *entries;  /* The cached crops */
+@property (nonatomic, strong) NSMutableOrderedSet<TOCropRenderCacheKey *> *recentKeys;                        /* The keys of the cached crops, from least to most recently used */
+@property (nonatomic, strong) NSMutableDictionary<TOCropRenderCacheKey *, TOCropRenderCacheFlight *> *flights; /* The renders in progress */
+@property (nonatomic, strong) TOCropMemoryAllocation *memoryAllocation;                                       /* The cached crops, as counted by the shared memory accountant */
+
+@end
+
+@implementation TOCropRenderCache
+
+@synthesize byteBudget = _byteBudget;
+
++ (TOCropRenderCache *)sharedCache {
+    static TOCropRenderCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[TOCropRenderCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (instancetype)initWithByteBudget:(NSUInteger)byteBudget {
+    if (self = [super init]) {
+        _byteBudget = byteBudget;
+        _entries = [NSMutableDictionary dictionary];
+        _recentKeys = [NSMutableOrderedSet orderedSet];
+        _flights = [NSMutableDictionary dictionary];
+
+        // Any crop can be rendered again, so they're the first thing let go of when memory runs short
+        __weak typeof(self) weakSelf = self;
+        _memoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Rendered crops"
+                                                                                  byteCount:0
+                                                                                   priority:TOCropMemoryPriorityCache
+                                                                            evictionHandler:^{
+            [weakSelf removeAllImages];
+        }];
+    }
+
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithByteBudget:kTOCropRenderCacheDefaultByteBudget];
+}
+
+#pragma mark - Requests -
+
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                                  circular:(BOOL)circular
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    return [self croppedImageForImage:image frame:frame angle:angle circular:circular
+                            pixelSize:CGSizeZero filter:TOCropViewResamplingFilterBox renderBlock:renderBlock];
+}
+
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                                  circular:(BOOL)circular
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    return [self croppedImageForImage:image frame:frame angle:angle straighteningAngle:straighteningAngle
+                             circular:circular pixelSize:CGSizeZero filter:TOCropViewResamplingFilterBox
+                          renderBlock:renderBlock];
+}
+
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                             quadrilateral:(TOCropQuadrilateral)quadrilateral
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    TOCropRenderCacheKey *key = [self keyForImage:image frame:CGRectZero angle:angle straighteningAngle:straighteningAngle
+                                         circular:NO pixelSize:CGSizeZero filter:TOCropViewResamplingFilterBox];
+    key.perspectiveCorrected = YES;
+    key.quadrilateral = quadrilateral;
+    return [self croppedImageForKey:key image:image renderBlock:renderBlock];
+}
+
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                                  circular:(BOOL)circular
+                                 pixelSize:(CGSize)pixelSize
+                                    filter:(TOCropViewResamplingFilter)filter
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    return [self croppedImageForImage:image frame:frame angle:angle straighteningAngle:0.0f
+                             circular:circular pixelSize:pixelSize filter:filter renderBlock:renderBlock];
+}
+
+- (nullable UIImage *)croppedImageForImage:(UIImage *)image
+                                     frame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                                  circular:(BOOL)circular
+                                 pixelSize:(CGSize)pixelSize
+                                    filter:(TOCropViewResamplingFilter)filter
+                               renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    TOCropRenderCacheKey *key = [self keyForImage:image frame:frame angle:angle straighteningAngle:straighteningAngle
+                                         circular:circular pixelSize:pixelSize filter:filter];
+    return [self croppedImageForKey:key image:image renderBlock:renderBlock];
+}
+
+- (TOCropRenderCacheKey *)keyForImage:(UIImage *)image
+                                frame:(CGRect)frame
+                                angle:(NSInteger)angle
+                   straighteningAngle:(CGFloat)straighteningAngle
+                             circular:(BOOL)circular
+                            pixelSize:(CGSize)pixelSize
+                               filter:(TOCropViewResamplingFilter)filter {
+    TOCropRenderCacheKey *key = [[TOCropRenderCacheKey alloc] init];
+    key.imageAddress = (uintptr_t)(__bridge void *)image;
+    key.frame = frame;
+    key.angle = angle;
+    key.straighteningAngle = straighteningAngle;
+    key.circular = circular;
+    key.pixelSize = pixelSize;
+    // The filter makes no difference to crops that aren't scaled
+    key.filter = CGSizeEqualToSize(pixelSize, CGSizeZero) ? TOCropViewResamplingFilterBox : filter;
+    return key;
+}
+
+- (nullable UIImage *)croppedImageForKey:(TOCropRenderCacheKey *)key
+                                   image:(UIImage *)image
+                             renderBlock:(UIImage *_Nullable (^)(void))renderBlock {
+    while (YES) {
+        TOCropRenderCacheFlight *flight = nil;
+        BOOL rendersCrop = NO;
+
+        @synchronized (self) {
+            UIImage *cachedImage = [self cachedImageForKey:key sourceImage:image];
+            if (cachedImage) {
+                _hitCount++;
+                return cachedImage;
+            }
+
+            flight = self.flights[key];
+            if (flight == nil) {
+                flight = [[TOCropRenderCacheFlight alloc] init];
+                flight.group = dispatch_group_create();
+                dispatch_group_enter(flight.group);
+                self.flights[key] = flight;
+                _missCount++;
+                rendersCrop = YES;
+            }
+        }
+
+        if (rendersCrop) {
+            UIImage *croppedImage = renderBlock();
+            @synchronized (self) {
+                [self.flights removeObjectForKey:key];
+                if (croppedImage) {
+                    [self storeCroppedImage:croppedImage forKey:key sourceImage:image];
+                }
+            }
+            flight.croppedImage = croppedImage;
+            dispatch_group_leave(flight.group);
+            return croppedImage;
+        }
+
+        dispatch_group_wait(flight.group, DISPATCH_TIME_FOREVER);
+        if (flight.croppedImage) {
+            @synchronized (self) {
+                _hitCount++;
+            }
+            return flight.croppedImage;
+        }
+
+        // The render that was waited on was cancelled, so go around again,
+        // and render the crop here unless another request already started to
+    }
+}
+
+- (void)removeAllImages {
+    @synchronized (self) {
+        [self.entries removeAllObjects];
+        [self.recentKeys removeAllObjects];
+        _byteCount = 0;
+        self.memoryAllocation.byteCount = 0;
+    }
+}
+
+#pragma mark - Storage -
+
+// These are only called while holding the lock on the cache
+
+- (nullable UIImage *)cachedImageForKey:(TOCropRenderCacheKey *)key sourceImage:(UIImage *)sourceImage {
+    TOCropRenderCacheEntry *entry = self.entries[key];
+    if (entry == nil) {
+        return nil;
+    }
+
+    // A different image may have since been allocated at the same address
+    if (entry.sourceImage != sourceImage) {
+        [self removeEntryForKey:key];
+        return nil;
+    }
+
+    // Move it to the most recently used end
+    [self.recentKeys removeObject:key];
+    [self.recentKeys addObject:key];
+    return entry.croppedImage;
+}
+
+- (void)storeCroppedImage:(UIImage *)croppedImage forKey:(TOCropRenderCacheKey *)key sourceImage:(UIImage *)sourceImage {
+    const NSUInteger byteCount = [TOCropMemoryAccountant byteCountOfImage:croppedImage];
+    [self removeEntryForKey:key];
+
+    // Crops of images that have since been deallocated can't be asked for again
+    [self removeEntriesOfDeallocatedImages];
+
+    if (byteCount > _byteBudget) {
+        return;
+    }
+
+    TOCropRenderCacheEntry *entry = [[TOCropRenderCacheEntry alloc] init];
+    entry.sourceImage = sourceImage;
+    entry.croppedImage = croppedImage;
+    entry.byteCount = byteCount;
+    self.entries[key] = entry;
+    [self.recentKeys addObject:key];
+    _byteCount += byteCount;
+
+    [self evictToByteBudget];
+    self.memoryAllocation.byteCount = _byteCount;
+}
+
+- (void)removeEntryForKey:(TOCropRenderCacheKey *)key {
+    TOCropRenderCacheEntry *entry = self.entries[key];
+    if (entry == nil) {
+        return;
+    }
+
+    _byteCount -= entry.byteCount;
+    [self.entries removeObjectForKey:key];
+    [self.recentKeys removeObject:key];
+    self.memoryAllocation.byteCount = _byteCount;
+}
+
+- (void)removeEntriesOfDeallocatedImages {
+    for (TOCropRenderCacheKey *key in self.recentKeys.array) {
+        if (self.entries[key].sourceImage == nil) {
+            [self removeEntryForKey:key];
+        }
+    }
+}
+
+- (void)evictToByteBudget {
+    while (_byteCount > _byteBudget && self.recentKeys.count > 0) {
+        [self removeEntryForKey:self.recentKeys.firstObject];
+    }
+}
+
+#pragma mark - Accessors -
+
+- (NSUInteger)byteBudget {
+    @synchronized (self) {
+        return _byteBudget;
+    }
+}
+
+- (void)setByteBudget:(NSUInteger)byteBudget {
+    @synchronized (self) {
+        _byteBudget = byteBudget;
+        [self evictToByteBudget];
+    }
+}
+
+- (NSUInteger)byteCount {
+    @synchronized (self) {
+        return _byteCount;
+    }
+}
+
+- (NSUInteger)hitCount {
+    @synchronized (self) {
+        return _hitCount;
+    }
+}
+
+- (NSUInteger)missCount {
+    @synchronized (self) {
+        return _missCount;
+    }
+}
+
+- (NSUInteger)count {
+    @synchronized (self) {
+        return self.entries.count;
+    }
+}
+
+@end
@@ -0,0 +1,109 @@
+//
+//  TOCropRenderJob.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+
+#if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropViewConstants.h"
+#else
+#import <TOCropViewController/TOCropViewConstants.h>
+#endif
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Renders a cropped copy of an image on a background queue, so the main thread is never
+/// blocked while the pixels are copied. A job can be cancelled at any point, in which case
+/// the render stops before its next block of rows and its completion receives no image.
+///
+/// Jobs run one at a time (each one spread across every core), and complete in the
+/// order they were started.
+@interface TOCropRenderJob : NSObject
+
+/// The image being cropped
+@property (nonatomic, readonly) UIImage *image;
+
+/// The region of the image being cropped (in the image's point space, ie image.size).
+/// When `perspectiveCorrected`, this is the rectangle around `quadrilateral`.
+@property (nonatomic, readonly) CGRect frame;
+
+/// Whether the image is being flattened from `quadrilateral`, rather than cropped to `frame`
+@property (nonatomic, readonly) BOOL perspectiveCorrected;
+
+/// When `perspectiveCorrected`, the corners of the region being flattened (in the image's point space)
+@property (nonatomic, readonly) TOCropQuadrilateral quadrilateral;
+
+/// The angle the image is rotated at
+@property (nonatomic, readonly) NSInteger angle;
+
+/// The angle the image is straightened by after `angle`, in degrees
+@property (nonatomic, readonly) CGFloat straighteningAngle;
+
+/// Whether the image is being cropped to a circle
+@property (nonatomic, readonly) BOOL circular;
+
+/// How much of the crop has been rendered, from 0.0 to 1.0. This can be read from any thread,
+/// such as from a display link driving a progress indicator.
+@property (nonatomic, readonly) double fractionCompleted;
+
+/// Whether `cancel` has been called
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/// Whether the job has called its completion handler
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+/// Once the job has finished, the cropped image it rendered (nil if it was cancelled)
+@property (nullable, nonatomic, readonly) UIImage *croppedImage;
+
+/// Creates a new job that, once started, crops the image to the supplied frame and angle
+- (instancetype)initWithImage:(UIImage *)image
+                        frame:(CGRect)frame
+                        angle:(NSInteger)angle
+                     circular:(BOOL)circular;
+
+/// Creates a new job that, once started, crops the image to the supplied frame and angle,
+/// after straightening it by a fraction of a turn
+- (instancetype)initWithImage:(UIImage *)image
+                        frame:(CGRect)frame
+                        angle:(NSInteger)angle
+           straighteningAngle:(CGFloat)straighteningAngle
+                     circular:(BOOL)circular NS_DESIGNATED_INITIALIZER;
+
+/// Creates a new job that, once started, flattens a four-sided region of the image into a
+/// rectangle (see `perspectiveCorrectedImageWithQuadrilateral:angle:straighteningAngle:`)
+- (instancetype)initWithImage:(UIImage *)image
+                quadrilateral:(TOCropQuadrilateral)quadrilateral
+                        angle:(NSInteger)angle
+           straighteningAngle:(CGFloat)straighteningAngle;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Queues the job to be rendered. A job can only be started once.
+/// @param completion Called on the main queue with the cropped image, or nil if the job was cancelled
+- (void)startWithCompletion:(void (^)(UIImage *_Nullable croppedImage))completion;
+
+/// Stops the job if it hasn't finished yet. Its completion handler is still called, with no image.
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,194 @@
+//
+//  TOCropRenderJob.m
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "TOCropRenderJob.h"
+#import "TOCropRenderCache.h"
+#import "UIImage+CropRotate.h"
+
+#import "TOCropGeometry.h"
+#import "TOCropTiledRenderer.h"
+
+// Implemented in UIImage+CropRotate.m, alongside the pixel paths it reports progress from
+@interface UIImage (TOCropRenderJob)
+- (nullable UIImage *)croppedImageWithFrame:(CGRect)frame
+                                     angle:(NSInteger)angle
+                        straighteningAngle:(CGFloat)straighteningAngle
+                              circularClip:(BOOL)circular
+                            renderProgress:(nullable TOCropRenderProgress *)progress;
+- (nullable UIImage *)perspectiveCorrectedImageWithQuadrilateral:(TOCropQuadrilateral)quadrilateral
+                                                           angle:(NSInteger)angle
+                                              straighteningAngle:(CGFloat)straighteningAngle
+                                                  renderProgress:(nullable TOCropRenderProgress *)progress;
+@end
+
+@interface TOCropRenderJob () {
+    TOCropRenderProgress _progress; // Shared with the threads rendering the crop, and only accessed atomically
+    size_t _totalRows;              // The number of rows in the cropped image
+    bool _finished;                 // Only accessed atomically
+    BOOL _started;                  // Only accessed on the main thread
+}
+
+@property (nonatomic, strong, readwrite) UIImage *image;
+@property (nonatomic, assign, readwrite) CGRect frame;
+@property (nonatomic, assign, readwrite) NSInteger angle;
+@property (nonatomic, assign, readwrite) CGFloat straighteningAngle;
+@property (nonatomic, assign, readwrite) BOOL circular;
+@property (nonatomic, assign, readwrite) BOOL perspectiveCorrected;
+@property (nonatomic, assign, readwrite) TOCropQuadrilateral quadrilateral;
+@property (nonatomic, strong, readwrite) UIImage *croppedImage;
+
+@end
+
+@implementation TOCropRenderJob
+
++ (dispatch_queue_t)renderQueue {
+    // Serial, so jobs complete in the order they were started. Each job already uses every core.
+    static dispatch_queue_t renderQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                                                   QOS_CLASS_USER_INITIATED, 0);
+        renderQueue = dispatch_queue_create("dev.tim.TOCropRenderJob", attributes);
+    });
+    return renderQueue;
+}
+
+- (instancetype)initWithImage:(UIImage *)image frame:(CGRect)frame angle:(NSInteger)angle circular:(BOOL)circular {
+    return [self initWithImage:image frame:frame angle:angle straighteningAngle:0.0f circular:circular];
+}
+
+- (instancetype)initWithImage:(UIImage *)image
+                        frame:(CGRect)frame
+                        angle:(NSInteger)angle
+           straighteningAngle:(CGFloat)straighteningAngle
+                     circular:(BOOL)circular {
+    if (self = [super init]) {
+        _image = image;
+        _frame = frame;
+        _angle = angle;
+        _straighteningAngle = straighteningAngle;
+        _circular = circular;
+        _totalRows = (size_t)MAX(round(CGRectGetHeight(frame) * image.scale), 1.0f);
+    }
+
+    return self;
+}
+
+- (instancetype)initWithImage:(UIImage *)image
+                quadrilateral:(TOCropQuadrilateral)quadrilateral
+                        angle:(NSInteger)angle
+           straighteningAngle:(CGFloat)straighteningAngle {
+    const TOCropQuad quad = {{quadrilateral.topLeft.x, quadrilateral.topLeft.y},
+                             {quadrilateral.topRight.x, quadrilateral.topRight.y},
+                             {quadrilateral.bottomRight.x, quadrilateral.bottomRight.y},
+                             {quadrilateral.bottomLeft.x, quadrilateral.bottomLeft.y}};
+    const TOCropRect boundingRect = TOCropGeometryQuadBoundingRect(quad);
+    const CGRect frame = (CGRect){{boundingRect.origin.x, boundingRect.origin.y},
+                                  {boundingRect.size.width, boundingRect.size.height}};
+    if (self = [self initWithImage:image frame:frame angle:angle straighteningAngle:straighteningAngle circular:NO]) {
+        _perspectiveCorrected = YES;
+        _quadrilateral = quadrilateral;
+
+        // The flattened image is as tall as the quad's longer side
+        _totalRows = (size_t)MAX(round(TOCropGeometryPerspectiveOutputSize(quad).height * image.scale), 1.0f);
+    }
+
+    return self;
+}
+
+#pragma mark - Rendering -
+
+- (void)startWithCompletion:(void (^)(UIImage *_Nullable))completion {
+    NSAssert(!_started, @"A TOCropRenderJob can only be started once");
+    if (_started) { return; }
+    _started = YES;
+
+    dispatch_async([TOCropRenderJob renderQueue], ^{
+        UIImage *croppedImage = nil;
+        if (!self.cancelled) {
+            @autoreleasepool {
+                croppedImage = [self render];
+            }
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // A cancel that arrives after the pixels are done still wins, so cancelling is always final
+            self.croppedImage = self.cancelled ? nil : croppedImage;
+            __atomic_store_n(&self->_finished, true, __ATOMIC_RELAXED);
+            completion(self.croppedImage);
+        });
+    });
+}
+
+- (nullable UIImage *)render {
+    // Cropping to the whole of an unrotated image leaves nothing to render
+    if (self.angle == 0 && self.straighteningAngle == 0.0f && !self.circular && !self.perspectiveCorrected &&
+        CGRectEqualToRect(self.frame, (CGRect){CGPointZero, self.image.size})) {
+        return self.image;
+    }
+
+    // If the same crop was rendered recently (or is being rendered right now), share it
+    TOCropRenderProgress *progress = &_progress;
+    if (self.perspectiveCorrected) {
+        return [TOCropRenderCache.sharedCache croppedImageForImage:self.image
+                                                     quadrilateral:self.quadrilateral
+                                                             angle:self.angle
+                                                straighteningAngle:self.straighteningAngle
+                                                       renderBlock:^UIImage *{
+            return [self.image perspectiveCorrectedImageWithQuadrilateral:self.quadrilateral angle:self.angle
+                                                       straighteningAngle:self.straighteningAngle renderProgress:progress];
+        }];
+    }
+
+    return [TOCropRenderCache.sharedCache croppedImageForImage:self.image
+                                                         frame:self.frame
+                                                         angle:self.angle
+                                            straighteningAngle:self.straighteningAngle
+                                                      circular:self.circular
+                                                   renderBlock:^UIImage *{
+        return [self.image croppedImageWithFrame:self.frame angle:self.angle straighteningAngle:self.straighteningAngle
+                                    circularClip:self.circular renderProgress:progress];
+    }];
+}
+
+- (void)cancel {
+    __atomic_store_n(&_progress.cancelled, true, __ATOMIC_RELAXED);
+}
+
+#pragma mark - Accessors -
+
+- (BOOL)isCancelled {
+    return __atomic_load_n(&_progress.cancelled, __ATOMIC_RELAXED);
+}
+
+- (BOOL)isFinished {
+    return __atomic_load_n(&_finished, __ATOMIC_RELAXED);
+}
+
+- (double)fractionCompleted {
+    if (self.finished) { return 1.0; }
+    const size_t completedRows = __atomic_load_n(&_progress.completedRows, __ATOMIC_RELAXED);
+    return MIN((double)completedRows / (double)_totalRows, 1.0);
+}
+
+@end
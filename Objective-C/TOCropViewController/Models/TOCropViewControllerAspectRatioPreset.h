@@ -54,9 +54,37 @@ NS_ASSUME_NONNULL_BEGIN
 /// A 16:9 aspect ratio
 @property (class, nonatomic, readonly) CGSize ratio16x9;
 
+/// The built-in presets for portrait crop boxes. These are only created once, so the same array is always returned.
 + (NSArray<TOCropViewControllerAspectRatioPreset *> *)portraitPresets;
+
+/// The built-in presets for landscape crop boxes. These are only created once, so the same array is always returned.
 + (NSArray<TOCropViewControllerAspectRatioPreset *> *)landscapePresets;
 
+/**
+ Every preset the crop box can snap to while it's being resized: the built-in portrait and landscape
+ presets, followed by any added with `registerPresets:`, in the order they were added.
+ */
+@property (class, nonatomic, readonly) NSArray<TOCropViewControllerAspectRatioPreset *> *registeredPresets;
+
+/**
+ Adds a catalog of presets (eg, print and social media sizes) to `registeredPresets`. Presets that are
+ equal to one already registered are skipped. The ratios are indexed once here, so that finding the
+ closest one stays quick, however many are registered.
+
+ @param presets The presets to add
+ */
++ (void)registerPresets:(NSArray<TOCropViewControllerAspectRatioPreset *> *)presets;
+
+/**
+ Finds the registered preset with the aspect ratio closest to `aspectRatio`.
+
+ @param aspectRatio A width divided by a height
+ @param tolerance How much bigger or smaller than `aspectRatio` (eg, 0.02 for 2%) the preset's ratio may be
+ @return The closest preset, or nil if none are within the tolerance. The original ratio preset is never returned.
+ */
++ (nullable TOCropViewControllerAspectRatioPreset *)registeredPresetNearestToAspectRatio:(CGFloat)aspectRatio
+                                                                               tolerance:(CGFloat)tolerance;
+
 - (nonnull instancetype)initWithSize:(CGSize)size title:(NSString *)title;
 
 @end
@@ -26,6 +26,16 @@
 #else
 #import <TOCropViewController/TOCropViewConstants.h>
 #endif
+#if !__has_include(<TOCropViewController/TOCropAspectRatioIndex.h>)
+#import "TOCropAspectRatioIndex.h"
+#else
+#import <TOCropViewController/TOCropAspectRatioIndex.h>
+#endif
+
+/* The presets that the crop box can snap to, shared by every crop view. These are guarded by a lock on the class. */
+static NSArray<TOCropViewControllerAspectRatioPreset *> *registeredPresets;        /* Every registered preset, in the order it was added */
+static NSMutableSet<TOCropViewControllerAspectRatioPreset *> *registeredPresetSet; /* The same presets, to quickly skip ones that are already registered */
+static TOCropAspectRatioIndex *registeredPresetIndex;                              /* The ratios of the presets, sorted, for finding the nearest */
 
 @interface TOCropViewControllerAspectRatioPreset ()
 
@@ -73,49 +83,146 @@
     return hash;
 }
 
++ (NSBundle *)resourceBundle {
+    static NSBundle *resourceBundle;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        TOCropViewControllerAspectRatioPreset *object = [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero title:@"Original"];
+        resourceBundle = TO_CROP_VIEW_RESOURCE_BUNDLE_FOR_OBJECT(object);
+    });
+    return resourceBundle;
+}
+
 + (NSArray<TOCropViewControllerAspectRatioPreset *> *)portraitPresets {
-    TOCropViewControllerAspectRatioPreset *object = [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero title:@"Original"];
-    NSBundle *resourceBundle = TO_CROP_VIEW_RESOURCE_BUNDLE_FOR_OBJECT(object);
-    return @[
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero
-                                                              title:NSLocalizedStringFromTableInBundle(@"Original", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(1.0f, 1.0f)
-                                                              title:NSLocalizedStringFromTableInBundle(@"Square", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(2.0f, 3.0f)
-                                                              title:@"2:3"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 5.0f)
-                                                              title:@"3:5"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 4.0f)
-                                                              title:@"3:4"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(4.0f, 5.0f)
-                                                              title:@"4:5"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 7.0f)
-                                                              title:@"5:7"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(9.0f, 16.0f)
-                                                              title:@"9:16"],
-    ];
+    static NSArray<TOCropViewControllerAspectRatioPreset *> *presets;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSBundle *resourceBundle = [TOCropViewControllerAspectRatioPreset resourceBundle];
+        presets = @[
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero
+                                                                  title:NSLocalizedStringFromTableInBundle(@"Original", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(1.0f, 1.0f)
+                                                                  title:NSLocalizedStringFromTableInBundle(@"Square", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(2.0f, 3.0f)
+                                                                  title:@"2:3"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 5.0f)
+                                                                  title:@"3:5"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 4.0f)
+                                                                  title:@"3:4"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(4.0f, 5.0f)
+                                                                  title:@"4:5"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 7.0f)
+                                                                  title:@"5:7"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(9.0f, 16.0f)
+                                                                  title:@"9:16"],
+        ];
+    });
+    return presets;
 }
 
 + (NSArray<TOCropViewControllerAspectRatioPreset *> *)landscapePresets {
-    TOCropViewControllerAspectRatioPreset *object = [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero title:@"Original"];
-    NSBundle *resourceBundle = TO_CROP_VIEW_RESOURCE_BUNDLE_FOR_OBJECT(object);
-    return @[
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero
-                                                              title:NSLocalizedStringFromTableInBundle(@"Original", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(1.0f, 1.0f)
-                                                              title:NSLocalizedStringFromTableInBundle(@"Square", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 2.0f)
-                                                              title:@"3:2"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 3.0f)
-                                                              title:@"5:3"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(4.0f, 3.0f)
-                                                              title:@"4:3"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 4.0f)
-                                                              title:@"5:4"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(7.0f, 5.0f)
-                                                              title:@"7:5"],
-        [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(16.0f, 9.0f)
-                                                              title:@"16:9"],
-    ];
+    static NSArray<TOCropViewControllerAspectRatioPreset *> *presets;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSBundle *resourceBundle = [TOCropViewControllerAspectRatioPreset resourceBundle];
+        presets = @[
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeZero
+                                                                  title:NSLocalizedStringFromTableInBundle(@"Original", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(1.0f, 1.0f)
+                                                                  title:NSLocalizedStringFromTableInBundle(@"Square", @"TOCropViewControllerLocalizable", resourceBundle, nil)],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(3.0f, 2.0f)
+                                                                  title:@"3:2"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 3.0f)
+                                                                  title:@"5:3"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(4.0f, 3.0f)
+                                                                  title:@"4:3"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(5.0f, 4.0f)
+                                                                  title:@"5:4"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(7.0f, 5.0f)
+                                                                  title:@"7:5"],
+            [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:CGSizeMake(16.0f, 9.0f)
+                                                                  title:@"16:9"],
+        ];
+    });
+    return presets;
+}
+
+#pragma mark - Registry -
+
++ (NSArray<TOCropViewControllerAspectRatioPreset *> *)registeredPresets {
+    @synchronized ([TOCropViewControllerAspectRatioPreset class]) {
+        [self loadRegistryIfNeeded];
+        return registeredPresets;
+    }
+}
+
++ (void)registerPresets:(NSArray<TOCropViewControllerAspectRatioPreset *> *)presets {
+    @synchronized ([TOCropViewControllerAspectRatioPreset class]) {
+        [self loadRegistryIfNeeded];
+        [self addPresetsToRegistry:presets];
+    }
+}
+
++ (nullable TOCropViewControllerAspectRatioPreset *)registeredPresetNearestToAspectRatio:(CGFloat)aspectRatio
+                                                                               tolerance:(CGFloat)tolerance {
+    @synchronized ([TOCropViewControllerAspectRatioPreset class]) {
+        [self loadRegistryIfNeeded];
+        if (registeredPresetIndex == NULL) {
+            return nil;
+        }
+
+        const size_t position = TOCropAspectRatioIndexNearest(registeredPresetIndex, aspectRatio, tolerance);
+        if (position == TOCropAspectRatioIndexNotFound) {
+            return nil;
+        }
+        return registeredPresets[position];
+    }
 }
+
+// These are only called while holding the lock on the class
+
++ (void)loadRegistryIfNeeded {
+    if (registeredPresets != nil) {
+        return;
+    }
+
+    registeredPresets = @[];
+    registeredPresetSet = [NSMutableSet set];
+    [self addPresetsToRegistry:[[TOCropViewControllerAspectRatioPreset portraitPresets]
+                                   arrayByAddingObjectsFromArray:[TOCropViewControllerAspectRatioPreset landscapePresets]]];
+}
+
++ (void)addPresetsToRegistry:(NSArray<TOCropViewControllerAspectRatioPreset *> *)presets {
+    NSMutableArray<TOCropViewControllerAspectRatioPreset *> *allPresets = [registeredPresets mutableCopy];
+    for (TOCropViewControllerAspectRatioPreset *preset in presets) {
+        if ([registeredPresetSet containsObject:preset]) {
+            continue;
+        }
+        [registeredPresetSet addObject:preset];
+        [allPresets addObject:preset];
+    }
+
+    if (allPresets.count == registeredPresets.count) {
+        return;
+    }
+
+    // Index every ratio again, so that lookups stay a single binary search.
+    // The original ratio has no size, so it's given a ratio of 0, which the index leaves out.
+    NSMutableData *ratios = [NSMutableData dataWithLength:allPresets.count * sizeof(double)];
+    double *ratioValues = ratios.mutableBytes;
+    for (NSUInteger i = 0; i < allPresets.count; i++) {
+        const CGSize size = allPresets[i].size;
+        ratioValues[i] = (size.width > 0.0f && size.height > 0.0f) ? (size.width / size.height) : 0.0;
+    }
+
+    TOCropAspectRatioIndex *index = TOCropAspectRatioIndexCreate(ratioValues, allPresets.count);
+    if (index == NULL) {
+        return;
+    }
+
+    TOCropAspectRatioIndexDestroy(registeredPresetIndex);
+    registeredPresetIndex = index;
+    registeredPresets = [allPresets copy];
+}
+
 @end
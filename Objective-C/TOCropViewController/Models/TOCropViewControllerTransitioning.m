@@ -21,6 +21,7 @@
 //  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "TOCropViewControllerTransitioning.h"
+#import "TOCropMemoryAccountant.h"
 
 #import <QuartzCore/QuartzCore.h>
 
@@ -82,6 +83,15 @@
         [containerView addSubview:imageView];
     }
 
+    // The image view draws its own copy of the image while it's animating
+    TOCropMemoryAllocation *imageViewMemoryAllocation = nil;
+    if (imageView) {
+        imageViewMemoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop transition image"
+                                                                                          byteCount:[TOCropMemoryAccountant byteCountOfImage:self.image]
+                                                                                           priority:TOCropMemoryPriorityRequired
+                                                                                    evictionHandler:nil];
+    }
+
     cropViewController.view.alpha = (self.isDismissing ? 1.0f : 0.0f);
     if (imageView) {
         [UIView animateWithDuration:[self transitionDuration:transitionContext]
@@ -99,6 +109,7 @@
                     }
                     completion:^(BOOL complete) {
                         [imageView removeFromSuperview];
+                        [imageViewMemoryAllocation remove];
                     }];
             }];
     }
@@ -0,0 +1,110 @@
+//
+//  TOCropBandRenderer.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropBandRenderer.h"
+
+#include "TOCropPixelView.h"
+
+// Mirrors the row padding `TOCropPixelBufferAllocate` applies
+static size_t TOCropBandAlignedRowBytes(size_t width) {
+    return ((width * TOCropPixelBufferBytesPerPixel) + 15) & ~(size_t)15;
+}
+
+// The bytes needed to hold a band of `rows` output rows, plus the source pixels it's made from
+static size_t TOCropBandBytesForRows(TOCropPixelRect rect, TOCropPixelOrientation orientation, size_t rows) {
+    const size_t outputBytes = TOCropBandAlignedRowBytes(rect.width) * rows;
+
+    // Turns that transpose the image read a strip of source columns instead of rows
+    const size_t sourceBytes = orientation.transpose ? TOCropBandAlignedRowBytes(rows) * rect.width
+                                                  : outputBytes;
+    return outputBytes + sourceBytes;
+}
+
+size_t TOCropBandRowsForMemoryBudget(TOCropPixelRect rect, TOCropPixelOrientation orientation, size_t memoryBudget) {
+    if (rect.width == 0 || rect.height == 0) {
+        return 0;
+    }
+
+    // Each output row costs roughly two rows of pixels: its own, and its source pixels
+    size_t rows = memoryBudget / (TOCropBandAlignedRowBytes(rect.width) * 2);
+    if (rows > rect.height) {
+        rows = rect.height;
+    }
+
+    // Row padding on transposed source strips can tip that estimate over by a few rows
+    while (rows > 1 && TOCropBandBytesForRows(rect, orientation, rows) > memoryBudget) {
+        rows--;
+    }
+    return rows > 0 ? rows : 1;
+}
+
+bool TOCropRenderBands(const TOCropBandSource *source,
+                       TOCropPixelRect rect,
+                       TOCropPixelOrientation orientation,
+                       size_t memoryBudget,
+                       const TOCropBandSink *sink) {
+    const bool transposed = orientation.transpose;
+    const size_t rotatedWidth = transposed ? source->height : source->width;
+    const size_t rotatedHeight = transposed ? source->width : source->height;
+    if (rect.width == 0 || rect.height == 0 ||
+        !TOCropPixelRectFitsInSize(rect, rotatedWidth, rotatedHeight)) {
+        return false;
+    }
+
+    const size_t bandRows = TOCropBandRowsForMemoryBudget(rect, orientation, memoryBudget);
+
+    // Both buffers are sized for a full band. The last band may be shorter, in which case
+    // they're just used with fewer rows (or columns) than they were allocated with.
+    TOCropPixelBuffer sourceBand, outputBand;
+    const size_t sourceWidth = transposed ? bandRows : rect.width;
+    const size_t sourceHeight = transposed ? rect.width : bandRows;
+    if (!TOCropPixelBufferAllocate(&sourceBand, sourceWidth, sourceHeight)) {
+        return false;
+    }
+    if (!TOCropPixelBufferAllocate(&outputBand, rect.width, bandRows)) {
+        TOCropPixelBufferFree(&sourceBand);
+        return false;
+    }
+
+    bool success = true;
+    for (size_t row = 0; row < rect.height && success; row += bandRows) {
+        const size_t rows = (rect.height - row < bandRows) ? rect.height - row : bandRows;
+
+        // Work out which part of the original image this band of output comes from
+        const TOCropPixelRect bandRect = {rect.x, rect.y + row, rect.width, rows};
+        const TOCropPixelRect region = TOCropPixelOrientationSourceRect(orientation, bandRect,
+                                                                        source->width, source->height);
+        sourceBand.width = region.width;
+        sourceBand.height = region.height;
+        outputBand.height = rows;
+
+        // Having been fetched on its own, the region is the whole of the oriented band
+        success = (source->read(source->context, region, &sourceBand) &&
+                   TOCropPixelViewCopyToBuffer(TOCropPixelViewApplyOrientation(TOCropPixelViewMake(&sourceBand), orientation),
+                                               &outputBand) &&
+                   sink->write(sink->context, row, &outputBand));
+    }
+
+    TOCropPixelBufferFree(&sourceBand);
+    TOCropPixelBufferFree(&outputBand);
+    return success;
+}
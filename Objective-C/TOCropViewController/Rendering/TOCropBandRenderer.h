@@ -0,0 +1,88 @@
+//
+//  TOCropBandRenderer.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropBandRenderer_h
+#define TOCropBandRenderer_h
+
+#include "TOCropPixelOrientation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The working memory a band render will stay within when no other budget is given
+#define TOCropBandRendererDefaultMemoryBudget ((size_t)16 * 1024 * 1024)
+
+/// Fills `buffer` with the pixels of the original source image inside `region`.
+/// The buffer's width and height already match the region. Return false to abort the render.
+typedef bool (*TOCropBandSourceReadFunction)(void *context, TOCropPixelRect region, TOCropPixelBuffer *buffer);
+
+/// Receives the next band of finished output rows, starting at row `firstRow` of the
+/// cropped image. The buffer is reused for the following band once this returns, so
+/// anything that needs to be kept must be copied out. Return false to abort the render.
+typedef bool (*TOCropBandSinkWriteFunction)(void *context, size_t firstRow, const TOCropPixelBuffer *rows);
+
+/// An image that is only read in pieces, as the render asks for them
+typedef struct {
+    size_t width;                      // The width of the original image, in pixels
+    size_t height;                     // The height of the original image, in pixels
+    TOCropBandSourceReadFunction read; // Called once for each band, with the region it needs
+    void *context;                     // Passed back to `read`
+} TOCropBandSource;
+
+/// Somewhere for output rows to go, such as an encoder or a larger buffer
+typedef struct {
+    TOCropBandSinkWriteFunction write; // Called once for each band, top band first
+    void *context;                     // Passed back to `write`
+} TOCropBandSink;
+
+/// The number of output rows each band will contain when rendering `rect` within
+/// `memoryBudget` bytes. This is never less than one row (so very small budgets will be
+/// exceeded by a single row's worth of pixels) and never more than the height of `rect`.
+size_t TOCropBandRowsForMemoryBudget(TOCropPixelRect rect, TOCropPixelOrientation orientation, size_t memoryBudget);
+
+/// Renders a region of an image with an orientation applied (such as its EXIF orientation
+/// combined with the user's rotation), one horizontal band of output rows at a time.
+///
+/// For each band, only the source pixels that land inside it are requested from `source`,
+/// and the finished rows are pushed straight to `sink`. The two band-sized buffers used
+/// for this are allocated once up front and reused, so the memory used stays the same no
+/// matter how large the source image or the crop is.
+///
+/// @param source The original image to read pixels from
+/// @param rect The region to render, in the coordinate space of the oriented image
+/// @param orientation The orientation applied to the image
+/// @param memoryBudget The maximum number of bytes of working memory to use
+/// @param sink Where to write the finished rows
+/// @return false if `rect` doesn't fit inside the oriented image, memory couldn't be
+///         allocated, or either callback aborted the render
+bool TOCropRenderBands(const TOCropBandSource *source,
+                       TOCropPixelRect rect,
+                       TOCropPixelOrientation orientation,
+                       size_t memoryBudget,
+                       const TOCropBandSink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropBandRenderer_h */
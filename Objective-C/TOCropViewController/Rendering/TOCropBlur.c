@@ -0,0 +1,285 @@
+//
+//  TOCropBlur.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropBlur.h"
+
+#include "TOCropParallel.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_BLUR_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_BLUR_SSE2 1
+#endif
+
+// The number of rows each thread takes at a time when blurring across rows
+static const size_t kTOCropBlurBlockRows = 32;
+
+// The number of columns each thread takes at a time when blurring down columns. Every column
+// in a strip shares the same cache line of each row, so it's only fetched from memory once.
+static const size_t kTOCropBlurStripColumns = 16;
+
+#pragma mark - Running Sums -
+
+// The running sum of each channel of a pixel, one channel per lane
+
+#if TOCROP_BLUR_NEON
+
+typedef uint32x4_t TOCropBlurSum;
+
+static inline TOCropBlurSum TOCropBlurSumZero(void) { return vdupq_n_u32(0); }
+
+static inline TOCropBlurSum TOCropBlurSumLoad(const uint8_t *pixel) {
+    uint32_t value;
+    memcpy(&value, pixel, sizeof(value));
+    return vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value)))));
+}
+
+static inline TOCropBlurSum TOCropBlurSumAdd(TOCropBlurSum a, TOCropBlurSum b) { return vaddq_u32(a, b); }
+static inline TOCropBlurSum TOCropBlurSumSubtract(TOCropBlurSum a, TOCropBlurSum b) { return vsubq_u32(a, b); }
+
+static inline void TOCropBlurSumStore(TOCropBlurSum sum, uint32_t multiplier, uint8_t *pixel) {
+    const uint32x4_t scaled = vshrq_n_u32(vaddq_u32(vmulq_n_u32(sum, multiplier), vdupq_n_u32(1 << 15)), 16);
+    const uint16x4_t narrow = vqmovn_u32(scaled);
+    const uint8x8_t bytes = vqmovn_u16(vcombine_u16(narrow, narrow));
+    const uint32_t value = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+    memcpy(pixel, &value, sizeof(value));
+}
+
+#elif TOCROP_BLUR_SSE2
+
+typedef __m128i TOCropBlurSum;
+
+static inline TOCropBlurSum TOCropBlurSumZero(void) { return _mm_setzero_si128(); }
+
+static inline TOCropBlurSum TOCropBlurSumLoad(const uint8_t *pixel) {
+    int value;
+    memcpy(&value, pixel, sizeof(value));
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+}
+
+static inline TOCropBlurSum TOCropBlurSumAdd(TOCropBlurSum a, TOCropBlurSum b) { return _mm_add_epi32(a, b); }
+static inline TOCropBlurSum TOCropBlurSumSubtract(TOCropBlurSum a, TOCropBlurSum b) { return _mm_sub_epi32(a, b); }
+
+static inline void TOCropBlurSumStore(TOCropBlurSum sum, uint32_t multiplier, uint8_t *pixel) {
+    // SSE2 can only multiply the even 32-bit lanes, so do the odd ones shifted down and interleave them back
+    const __m128i factor = _mm_set1_epi32((int)multiplier);
+    const __m128i even = _mm_mul_epu32(sum, factor);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(sum, 4), factor);
+    const __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                               _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    const __m128i scaled = _mm_srli_epi32(_mm_add_epi32(product, _mm_set1_epi32(1 << 15)), 16);
+    const __m128i narrow = _mm_packs_epi32(scaled, scaled);
+    const int value = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    memcpy(pixel, &value, sizeof(value));
+}
+
+#else
+
+typedef struct { uint32_t channels[4]; } TOCropBlurSum;
+
+static inline TOCropBlurSum TOCropBlurSumZero(void) { return (TOCropBlurSum){{0, 0, 0, 0}}; }
+
+static inline TOCropBlurSum TOCropBlurSumLoad(const uint8_t *pixel) {
+    return (TOCropBlurSum){{pixel[0], pixel[1], pixel[2], pixel[3]}};
+}
+
+static inline TOCropBlurSum TOCropBlurSumAdd(TOCropBlurSum a, TOCropBlurSum b) {
+    for (size_t c = 0; c < 4; c++) { a.channels[c] += b.channels[c]; }
+    return a;
+}
+
+static inline TOCropBlurSum TOCropBlurSumSubtract(TOCropBlurSum a, TOCropBlurSum b) {
+    for (size_t c = 0; c < 4; c++) { a.channels[c] -= b.channels[c]; }
+    return a;
+}
+
+static inline void TOCropBlurSumStore(TOCropBlurSum sum, uint32_t multiplier, uint8_t *pixel) {
+    for (size_t c = 0; c < 4; c++) {
+        const uint32_t value = (sum.channels[c] * multiplier + (1 << 15)) >> 16;
+        pixel[c] = (uint8_t)(value > 255 ? 255 : value);
+    }
+}
+
+#endif
+
+#pragma mark - Box Blurs -
+
+// Box blurs one line of pixels (either a row or a column), `stride` bytes apart.
+// Each output pixel is the sum of the 2 * radius + 1 pixels around it, times `multiplier` / 65536.
+static void TOCropBlurLine(const uint8_t *source, uint8_t *destination, size_t stride, size_t length,
+                           size_t radius, uint32_t multiplier) {
+    const size_t last = length - 1;
+
+    // Start with the window centred on the first pixel, which repeats it for everything off the edge
+    const TOCropBlurSum first = TOCropBlurSumLoad(source);
+    TOCropBlurSum sum = TOCropBlurSumZero();
+    for (size_t i = 0; i <= radius; i++) {
+        sum = TOCropBlurSumAdd(sum, first);
+    }
+    for (size_t i = 1; i <= radius; i++) {
+        sum = TOCropBlurSumAdd(sum, TOCropBlurSumLoad(source + (i < last ? i : last) * stride));
+    }
+
+    // Then slide it along, adding the pixel coming in and taking away the one going out
+    for (size_t i = 0; i < length; i++) {
+        TOCropBlurSumStore(sum, multiplier, destination + i * stride);
+
+        const size_t incoming = (i + radius + 1 < last) ? i + radius + 1 : last;
+        const size_t outgoing = (i > radius) ? i - radius : 0;
+        sum = TOCropBlurSumAdd(sum, TOCropBlurSumLoad(source + incoming * stride));
+        sum = TOCropBlurSumSubtract(sum, TOCropBlurSumLoad(source + outgoing * stride));
+    }
+}
+
+typedef struct {
+    const TOCropPixelBuffer *source;
+    TOCropPixelBuffer *destination;
+    size_t radius;
+    uint32_t multiplier;
+} TOCropBlurJob;
+
+static void TOCropBlurRowBlock(void *context, size_t block) {
+    const TOCropBlurJob *job = (const TOCropBlurJob *)context;
+    const TOCropPixelBuffer *source = job->source;
+    TOCropPixelBuffer *destination = job->destination;
+
+    const size_t firstRow = block * kTOCropBlurBlockRows;
+    const size_t lastRow = (firstRow + kTOCropBlurBlockRows < source->height) ? firstRow + kTOCropBlurBlockRows
+                                                                              : source->height;
+    for (size_t y = firstRow; y < lastRow; y++) {
+        TOCropBlurLine(source->data + y * source->bytesPerRow, destination->data + y * destination->bytesPerRow,
+                       TOCropPixelBufferBytesPerPixel, source->width, job->radius, job->multiplier);
+    }
+}
+
+static void TOCropBlurColumnStrip(void *context, size_t strip) {
+    const TOCropBlurJob *job = (const TOCropBlurJob *)context;
+    const TOCropPixelBuffer *source = job->source;
+    TOCropPixelBuffer *destination = job->destination;
+
+    const size_t firstColumn = strip * kTOCropBlurStripColumns;
+    const size_t lastColumn = (firstColumn + kTOCropBlurStripColumns < source->width)
+                                  ? firstColumn + kTOCropBlurStripColumns
+                                  : source->width;
+    for (size_t x = firstColumn; x < lastColumn; x++) {
+        const size_t offset = x * TOCropPixelBufferBytesPerPixel;
+        TOCropBlurLine(source->data + offset, destination->data + offset, source->bytesPerRow,
+                       source->height, job->radius, job->multiplier);
+    }
+}
+
+#pragma mark - Blurring -
+
+void TOCropBlurBoxRadiiForSigma(double sigma, size_t radii[TOCropBlurPassCount]) {
+    if (!(sigma > 0.0)) {
+        for (size_t i = 0; i < TOCropBlurPassCount; i++) { radii[i] = 0; }
+        return;
+    }
+
+    // Repeated box blurs tend towards a Gaussian. With boxes of two odd widths (the largest below
+    // the ideal width, and the next one up), pick how many of each give the closest variance.
+    const double passes = TOCropBlurPassCount;
+    const double variance = 12.0 * sigma * sigma;
+    long lowerWidth = (long)floor(sqrt(variance / passes + 1.0));
+    if (lowerWidth % 2 == 0) { lowerWidth--; }
+    const double lowerWidths = round((variance - passes * lowerWidth * lowerWidth - 4.0 * passes * lowerWidth - 3.0 * passes) /
+                                     (-4.0 * lowerWidth - 4.0));
+
+    for (size_t i = 0; i < TOCropBlurPassCount; i++) {
+        const long width = ((double)i < lowerWidths) ? lowerWidth : lowerWidth + 2;
+        const size_t radius = (size_t)((width - 1) / 2);
+        radii[i] = radius < TOCropBlurMaximumBoxRadius ? radius : TOCropBlurMaximumBoxRadius;
+    }
+}
+
+bool TOCropPixelBufferBlur(TOCropPixelBuffer *buffer, double sigma, double brightness, size_t maximumThreads) {
+    if (buffer->format != TOCropPixelFormatRGBA8) {
+        return false;
+    }
+    if (buffer->width == 0 || buffer->height == 0) {
+        return true;
+    }
+
+    // Every pass reads from one buffer and writes to the other, since each pixel's window overlaps pixels already written
+    TOCropPixelBuffer scratch;
+    if (!TOCropPixelBufferAllocate(&scratch, buffer->width, buffer->height)) {
+        return false;
+    }
+
+    // Passes with a radius of 0 would copy the pixels as they are, so they're skipped.
+    // If that leaves nothing to apply the brightness in, a single one is run anyway.
+    size_t radii[TOCropBlurPassCount];
+    TOCropBlurBoxRadiiForSigma(sigma, radii);
+    brightness = brightness < 0.0 ? 0.0 : (brightness > 1.0 ? 1.0 : brightness);
+    size_t passCount = 0;
+    for (size_t i = 0; i < TOCropBlurPassCount; i++) {
+        passCount += (radii[i] > 0) ? 2 : 0;
+    }
+    if (passCount == 0 && brightness < 1.0) {
+        radii[0] = 0;
+        passCount = 1;
+    }
+
+    TOCropPixelBuffer *source = buffer, *destination = &scratch;
+    size_t pass = 0;
+    for (size_t axis = 0; axis < 2; axis++) {
+        for (size_t i = 0; i < TOCropBlurPassCount && pass < passCount; i++) {
+            if (radii[i] == 0 && passCount > 1) {
+                continue;
+            }
+
+            // Only the very last pass darkens the pixels, so the rounding is only done once
+            pass++;
+            const double scale = ((pass == passCount) ? brightness : 1.0) / (double)(radii[i] * 2 + 1);
+            TOCropBlurJob job = {source, destination, radii[i], (uint32_t)round(scale * 65536.0)};
+            if (axis == 0) {
+                TOCropParallelFor((buffer->height + kTOCropBlurBlockRows - 1) / kTOCropBlurBlockRows,
+                                  maximumThreads, &job, TOCropBlurRowBlock);
+            } else {
+                TOCropParallelFor((buffer->width + kTOCropBlurStripColumns - 1) / kTOCropBlurStripColumns,
+                                  maximumThreads, &job, TOCropBlurColumnStrip);
+            }
+
+            TOCropPixelBuffer *swap = source;
+            source = destination;
+            destination = swap;
+        }
+    }
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if (source != buffer) {
+        const size_t rowLength = buffer->width * TOCropPixelBufferBytesPerPixel;
+        for (size_t y = 0; y < buffer->height; y++) {
+            memcpy(buffer->data + y * buffer->bytesPerRow, scratch.data + y * scratch.bytesPerRow, rowLength);
+        }
+    }
+
+    TOCropPixelBufferFree(&scratch);
+    return true;
+}
@@ -0,0 +1,64 @@
+//
+//  TOCropBlur.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TOCropBlur_h
+#define TOCropBlur_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of box blurs run along each axis to approximate a Gaussian blur
+#define TOCropBlurPassCount 3
+
+/// The widest radius of any one box blur, which keeps every running sum within 16 bits
+#define TOCropBlurMaximumBoxRadius 127
+
+/// Works out the radii of three successive box blurs that together come closest to a Gaussian
+/// blur with the given standard deviation. Each radius is capped at `TOCropBlurMaximumBoxRadius`.
+/// @param sigma The standard deviation of the Gaussian, in pixels
+/// @param radii Filled in with the radius of each pass, in pixels (0 means that pass does nothing)
+void TOCropBlurBoxRadiiForSigma(double sigma, size_t radii[TOCropBlurPassCount]);
+
+/// Blurs a buffer in place with an approximate Gaussian, and optionally darkens it in the same pass.
+///
+/// The blur is separable: three box blurs are run across every row, then three down every column.
+/// Each box blur keeps a running sum as it slides along, so the cost per pixel is the same whatever
+/// the radius. Pixels past the edges repeat the edge pixel, so the borders don't darken.
+///
+/// Every channel is filtered the same way, so pixels should have premultiplied alpha (or no alpha).
+/// Only 8-bit RGBA pixels are supported.
+/// @param buffer The pixels to blur
+/// @param sigma The standard deviation of the blur, in pixels
+/// @param brightness Every channel of the result is multiplied by this (0...1). 1 leaves the brightness as is.
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @return false if the buffer isn't 8-bit, or the working memory couldn't be allocated
+bool TOCropPixelBufferBlur(TOCropPixelBuffer *buffer, double sigma, double brightness, size_t maximumThreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropBlur_h */
@@ -0,0 +1,329 @@
+//
+//  TOCropCircularMask.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropCircularMask.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_CIRCULAR_MASK_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_CIRCULAR_MASK_SSE2 1
+#endif
+
+// Rows are masked in bands of this many, with each band's spans worked out up front. Views that
+// don't run left to right are read in square tiles of this size, to keep both sides of the copy in cache.
+#define kTOCropMaskBandRows 32
+
+// The shape being masked to: an ellipse centered in the buffer, touching every edge
+typedef struct {
+    float centerX;
+    float centerY;
+    float inverseRadiusX;        // 1 / rx
+    float inverseRadiusY;        // 1 / ry
+    float inverseRadiusXSquared; // 1 / rx^2
+    float inverseRadiusYSquared; // 1 / ry^2
+} TOCropEllipse;
+
+// Where each row of the mask changes from outside, to the edge, to inside, and back.
+// Pixels in [0, outerStart) and [outerEnd, width) are fully outside, and pixels in
+// [innerStart, innerEnd) are fully inside. Everything in between is on the edge.
+typedef struct {
+    size_t outerStart;
+    size_t innerStart;
+    size_t innerEnd;
+    size_t outerEnd;
+} TOCropMaskSpans;
+
+static size_t TOCropClampToWidth(double x, size_t width) {
+    if (x <= 0.0) { return 0; }
+    if (x >= (double)width) { return width; }
+    return (size_t)x;
+}
+
+// The half-width of an ellipse with the given radii at a vertical offset from its center,
+// or a negative value if that offset is outside of the ellipse entirely
+static double TOCropEllipseHalfWidth(double radiusX, double radiusY, double offsetY) {
+    if (radiusX <= 0.0 || radiusY <= 0.0 || fabs(offsetY) >= radiusY) {
+        return -1.0;
+    }
+    const double t = offsetY / radiusY;
+    return radiusX * sqrt(1.0 - (t * t));
+}
+
+// Works out the spans for one row. Pixel centers within ellipses a pixel larger and a
+// pixel smaller than the real one bound the edge ring, which is slightly generous, but
+// every pixel in the ring has its coverage calculated exactly, so that only costs time.
+static TOCropMaskSpans TOCropMaskSpansForRow(size_t y, size_t width, size_t height) {
+    const double radiusX = width * 0.5, radiusY = height * 0.5;
+    const double offsetY = (y + 0.5) - radiusY;
+
+    TOCropMaskSpans spans = {0, 0, 0, 0};
+    const double outerHalfWidth = TOCropEllipseHalfWidth(radiusX + 1.0, radiusY + 1.0, offsetY);
+    if (outerHalfWidth < 0.0) {
+        return spans;
+    }
+    spans.outerStart = TOCropClampToWidth(floor(radiusX - outerHalfWidth - 0.5), width);
+    spans.outerEnd = TOCropClampToWidth(ceil(radiusX + outerHalfWidth - 0.5) + 1.0, width);
+
+    const double innerHalfWidth = TOCropEllipseHalfWidth(radiusX - 1.0, radiusY - 1.0, offsetY);
+    if (innerHalfWidth < 0.0) {
+        // The whole row is edge
+        spans.innerStart = spans.innerEnd = spans.outerEnd;
+        return spans;
+    }
+    spans.innerStart = TOCropClampToWidth(ceil(radiusX - innerHalfWidth - 0.5), width);
+    spans.innerEnd = TOCropClampToWidth(floor(radiusX + innerHalfWidth - 0.5) + 1.0, width);
+    if (spans.innerStart < spans.outerStart) { spans.innerStart = spans.outerStart; }
+    if (spans.innerEnd > spans.outerEnd) { spans.innerEnd = spans.outerEnd; }
+    if (spans.innerEnd < spans.innerStart) { spans.innerEnd = spans.innerStart; }
+    return spans;
+}
+
+// Coverage of the pixel centered at an offset from the ellipse's center, from 0 to 1.
+// The distance to the edge is approximated as the implicit function over its gradient,
+// which is exact for circles and within a fraction of a pixel for any sane ellipse.
+static float TOCropEllipseCoverage(const TOCropEllipse *ellipse, float offsetX, float offsetY) {
+    const float u = offsetX * ellipse->inverseRadiusX, v = offsetY * ellipse->inverseRadiusY;
+    const float q = (u * u) + (v * v);
+    if (q < 0.25f) {
+        return 1.0f; // Nowhere near the edge, and where the gradient vanishes
+    }
+    const float f = sqrtf(q);
+    const float gx = offsetX * ellipse->inverseRadiusXSquared, gy = offsetY * ellipse->inverseRadiusYSquared;
+    const float distance = ((f - 1.0f) * f) / sqrtf((gx * gx) + (gy * gy));
+    const float coverage = 0.5f - distance;
+    return coverage < 0.0f ? 0.0f : (coverage > 1.0f ? 1.0f : coverage);
+}
+
+// x * coverage / 255, rounded, for 8-bit values
+static inline uint8_t TOCropScaleChannel(uint32_t value, uint32_t coverage) {
+    const uint32_t t = (value * coverage) + 128;
+    return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+static void TOCropApplyEdgeCoverage(const TOCropEllipse *ellipse, float offsetY,
+                                    const uint8_t *source, uint8_t *destination,
+                                    size_t start, size_t end, uint32_t alphaMask) {
+    size_t x = start;
+
+#if TOCROP_CIRCULAR_MASK_NEON
+    const float32x4_t lanes = {0.5f, 1.5f, 2.5f, 3.5f};
+    const float32x4_t v = vdupq_n_f32(offsetY * ellipse->inverseRadiusY);
+    const float32x4_t gy = vdupq_n_f32(offsetY * ellipse->inverseRadiusYSquared);
+    const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(alphaMask));
+    for (; x + 4 <= end; x += 4) {
+        const float32x4_t offsetX = vsubq_f32(vaddq_f32(vdupq_n_f32((float)x), lanes), vdupq_n_f32(ellipse->centerX));
+        const float32x4_t u = vmulq_f32(offsetX, vdupq_n_f32(ellipse->inverseRadiusX));
+        const float32x4_t q = vfmaq_f32(vmulq_f32(v, v), u, u);
+        const float32x4_t f = vsqrtq_f32(q);
+        const float32x4_t gx = vmulq_f32(offsetX, vdupq_n_f32(ellipse->inverseRadiusXSquared));
+        const float32x4_t gradient = vsqrtq_f32(vfmaq_f32(vmulq_f32(gy, gy), gx, gx));
+        const float32x4_t distance = vdivq_f32(vmulq_f32(vsubq_f32(f, vdupq_n_f32(1.0f)), f), gradient);
+        float32x4_t coverage = vsubq_f32(vdupq_n_f32(0.5f), distance);
+        coverage = vminq_f32(vmaxq_f32(coverage, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        coverage = vbslq_f32(vcltq_f32(q, vdupq_n_f32(0.25f)), vdupq_n_f32(1.0f), coverage);
+
+        // Spread each pixel's coverage across its four channels
+        const uint16x4_t coverage16 = vmovn_u32(vcvtnq_u32_f32(vmulq_f32(coverage, vdupq_n_f32(255.0f))));
+        const uint16x4x2_t pairs = vzip_u16(coverage16, coverage16);
+        const uint16x4x2_t low = vzip_u16(pairs.val[0], pairs.val[0]);
+        const uint16x4x2_t high = vzip_u16(pairs.val[1], pairs.val[1]);
+        const uint16x8_t coverageLow = vcombine_u16(low.val[0], low.val[1]);
+        const uint16x8_t coverageHigh = vcombine_u16(high.val[0], high.val[1]);
+
+        const uint8x16_t pixels = vorrq_u8(vld1q_u8(source + (x * TOCropPixelBufferBytesPerPixel)), mask);
+        uint16x8_t productLow = vmlaq_u16(vdupq_n_u16(128), vmovl_u8(vget_low_u8(pixels)), coverageLow);
+        uint16x8_t productHigh = vmlaq_u16(vdupq_n_u16(128), vmovl_u8(vget_high_u8(pixels)), coverageHigh);
+        productLow = vshrq_n_u16(vsraq_n_u16(productLow, productLow, 8), 8);
+        productHigh = vshrq_n_u16(vsraq_n_u16(productHigh, productHigh, 8), 8);
+        vst1q_u8(destination + (x * TOCropPixelBufferBytesPerPixel),
+                 vcombine_u8(vmovn_u16(productLow), vmovn_u16(productHigh)));
+    }
+#elif TOCROP_CIRCULAR_MASK_SSE2
+    const __m128 lanes = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 v = _mm_set1_ps(offsetY * ellipse->inverseRadiusY);
+    const __m128 gy = _mm_set1_ps(offsetY * ellipse->inverseRadiusYSquared);
+    const __m128i mask = _mm_set1_epi32((int)alphaMask);
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= end; x += 4) {
+        const __m128 offsetX = _mm_sub_ps(_mm_add_ps(_mm_set1_ps((float)x), lanes), _mm_set1_ps(ellipse->centerX));
+        const __m128 u = _mm_mul_ps(offsetX, _mm_set1_ps(ellipse->inverseRadiusX));
+        const __m128 q = _mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v));
+        const __m128 f = _mm_sqrt_ps(q);
+        const __m128 gx = _mm_mul_ps(offsetX, _mm_set1_ps(ellipse->inverseRadiusXSquared));
+        const __m128 gradient = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)));
+        const __m128 distance = _mm_div_ps(_mm_mul_ps(_mm_sub_ps(f, _mm_set1_ps(1.0f)), f), gradient);
+        __m128 coverage = _mm_sub_ps(_mm_set1_ps(0.5f), distance);
+        coverage = _mm_min_ps(_mm_max_ps(coverage, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const __m128 center = _mm_cmplt_ps(q, _mm_set1_ps(0.25f));
+        coverage = _mm_or_ps(_mm_and_ps(center, _mm_set1_ps(1.0f)), _mm_andnot_ps(center, coverage));
+
+        // Spread each pixel's coverage across its four channels
+        const __m128i coverage32 = _mm_cvtps_epi32(_mm_mul_ps(coverage, _mm_set1_ps(255.0f)));
+        const __m128i coverage16 = _mm_packs_epi32(coverage32, coverage32);
+        const __m128i pairs = _mm_unpacklo_epi16(coverage16, coverage16);
+        const __m128i coverageLow = _mm_unpacklo_epi32(pairs, pairs);
+        const __m128i coverageHigh = _mm_unpackhi_epi32(pairs, pairs);
+
+        const __m128i pixels = _mm_or_si128(_mm_loadu_si128((const __m128i *)(source + (x * TOCropPixelBufferBytesPerPixel))), mask);
+        const __m128i rounding = _mm_set1_epi16(128);
+        __m128i productLow = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), coverageLow), rounding);
+        __m128i productHigh = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), coverageHigh), rounding);
+        productLow = _mm_srli_epi16(_mm_add_epi16(productLow, _mm_srli_epi16(productLow, 8)), 8);
+        productHigh = _mm_srli_epi16(_mm_add_epi16(productHigh, _mm_srli_epi16(productHigh, 8)), 8);
+        _mm_storeu_si128((__m128i *)(destination + (x * TOCropPixelBufferBytesPerPixel)),
+                         _mm_packus_epi16(productLow, productHigh));
+    }
+#endif
+
+    for (; x < end; x++) {
+        const float coverage = TOCropEllipseCoverage(ellipse, (x + 0.5f) - ellipse->centerX, offsetY);
+        const uint32_t coverage255 = (uint32_t)((coverage * 255.0f) + 0.5f);
+        uint32_t packed;
+        memcpy(&packed, source + (x * TOCropPixelBufferBytesPerPixel), sizeof(packed));
+        packed |= alphaMask;
+        uint8_t pixel[TOCropPixelBufferBytesPerPixel];
+        memcpy(pixel, &packed, sizeof(packed));
+        for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+            destination[(x * TOCropPixelBufferBytesPerPixel) + c] = TOCropScaleChannel(pixel[c], coverage255);
+        }
+    }
+}
+
+// Masks one row into the destination. `source` is the row as it reads left to right, or NULL if
+// the part inside the outer edge has already been copied into `row`, to be masked in place.
+static void TOCropMaskRow(const TOCropEllipse *ellipse, TOCropMaskSpans spans, uint32_t alphaMask,
+                          const uint8_t *source, uint8_t *row, size_t width, float offsetY) {
+    const bool readsInPlace = (source != NULL);
+    if (!readsInPlace) {
+        source = row;
+    }
+
+    memset(row, 0, spans.outerStart * TOCropPixelBufferBytesPerPixel);
+    TOCropApplyEdgeCoverage(ellipse, offsetY, source, row, spans.outerStart, spans.innerStart, alphaMask);
+
+    // The inside of the circle is left exactly as it was
+    uint8_t *inside = row + (spans.innerStart * TOCropPixelBufferBytesPerPixel);
+    const size_t insideLength = spans.innerEnd - spans.innerStart;
+    if (readsInPlace) {
+        memcpy(inside, source + (spans.innerStart * TOCropPixelBufferBytesPerPixel),
+               insideLength * TOCropPixelBufferBytesPerPixel);
+    }
+    if (alphaMask != 0) {
+        for (size_t x = 0; x < insideLength; x++) {
+            uint32_t pixel;
+            memcpy(&pixel, inside + (x * TOCropPixelBufferBytesPerPixel), sizeof(pixel));
+            pixel |= alphaMask;
+            memcpy(inside + (x * TOCropPixelBufferBytesPerPixel), &pixel, sizeof(pixel));
+        }
+    }
+
+    TOCropApplyEdgeCoverage(ellipse, offsetY, source, row, spans.innerEnd, spans.outerEnd, alphaMask);
+    memset(row + (spans.outerEnd * TOCropPixelBufferBytesPerPixel), 0,
+           (width - spans.outerEnd) * TOCropPixelBufferBytesPerPixel);
+}
+
+// Copies [outerStart, outerEnd) of each row of a band out of a view that doesn't run left to right, and
+// nothing else, so no pixel that's about to be cleared is ever read. The band is walked in square tiles,
+// as in `TOCropPixelViewCopyToBuffer`, since stepping across one of these views jumps between rows in memory.
+static void TOCropCopyMaskSpans(TOCropPixelView view, const TOCropMaskSpans *spans, size_t firstRow,
+                                size_t rowCount, TOCropPixelBuffer *destination) {
+    size_t bandStart = view.width, bandEnd = 0;
+    for (size_t i = 0; i < rowCount; i++) {
+        if (spans[i].outerStart < spans[i].outerEnd) {
+            bandStart = spans[i].outerStart < bandStart ? spans[i].outerStart : bandStart;
+            bandEnd = spans[i].outerEnd > bandEnd ? spans[i].outerEnd : bandEnd;
+        }
+    }
+
+    for (size_t tileX = bandStart; tileX < bandEnd; tileX += kTOCropMaskBandRows) {
+        const size_t tileRight = (bandEnd - tileX < kTOCropMaskBandRows) ? bandEnd : tileX + kTOCropMaskBandRows;
+        for (size_t i = 0; i < rowCount; i++) {
+            const size_t start = spans[i].outerStart > tileX ? spans[i].outerStart : tileX;
+            const size_t end = spans[i].outerEnd < tileRight ? spans[i].outerEnd : tileRight;
+            if (start >= end) {
+                continue;
+            }
+            const uint8_t *source = TOCropPixelViewPixelAt(view, start, firstRow + i);
+            uint8_t *output = destination->data + ((firstRow + i) * destination->bytesPerRow) +
+                              (start * TOCropPixelBufferBytesPerPixel);
+            for (size_t x = start; x < end; x++, source += view.pixelStride, output += TOCropPixelBufferBytesPerPixel) {
+                memcpy(output, source, TOCropPixelBufferBytesPerPixel);
+            }
+        }
+    }
+}
+
+bool TOCropPixelViewCopyToBufferWithCircularMask(TOCropPixelView view,
+                                                 uint32_t alphaMask,
+                                                 TOCropPixelBuffer *destination) {
+    return TOCropPixelViewCopyRowsToBufferWithCircularMask(view, alphaMask, 0, view.height, destination);
+}
+
+bool TOCropPixelViewCopyRowsToBufferWithCircularMask(TOCropPixelView view,
+                                                     uint32_t alphaMask,
+                                                     size_t firstRow,
+                                                     size_t rowCount,
+                                                     TOCropPixelBuffer *destination) {
+    if (destination->width != view.width || destination->height != view.height ||
+        view.format != TOCropPixelFormatRGBA8 || destination->format != TOCropPixelFormatRGBA8 ||
+        firstRow > view.height || rowCount > view.height - firstRow) {
+        return false;
+    }
+    if (rowCount == 0) {
+        return true;
+    }
+
+    // Views that don't run left to right have the part of each row inside the outer edge copied
+    // across first, and are then masked in place
+    const bool readsInPlace = (view.pixelStride == TOCropPixelBufferBytesPerPixel);
+
+    const size_t width = view.width;
+    const size_t height = view.height;
+    const float radiusX = width * 0.5f, radiusY = height * 0.5f;
+    const TOCropEllipse ellipse = {radiusX, radiusY, 1.0f / radiusX, 1.0f / radiusY,
+                                   1.0f / (radiusX * radiusX), 1.0f / (radiusY * radiusY)};
+
+    TOCropMaskSpans bandSpans[kTOCropMaskBandRows];
+    for (size_t bandRow = firstRow; bandRow < firstRow + rowCount; bandRow += kTOCropMaskBandRows) {
+        const size_t bandEnd = firstRow + rowCount;
+        const size_t bandRowCount = (bandEnd - bandRow < kTOCropMaskBandRows) ? bandEnd - bandRow : kTOCropMaskBandRows;
+        for (size_t i = 0; i < bandRowCount; i++) {
+            bandSpans[i] = TOCropMaskSpansForRow(bandRow + i, width, height);
+        }
+        if (!readsInPlace) {
+            TOCropCopyMaskSpans(view, bandSpans, bandRow, bandRowCount, destination);
+        }
+
+        for (size_t i = 0; i < bandRowCount; i++) {
+            const size_t y = bandRow + i;
+            TOCropMaskRow(&ellipse, bandSpans[i], alphaMask,
+                          readsInPlace ? TOCropPixelViewPixelAt(view, 0, y) : NULL,
+                          destination->data + (y * destination->bytesPerRow), width, (y + 0.5f) - ellipse.centerY);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+//
+//  TOCropCircularMask.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropCircularMask_h
+#define TOCropCircularMask_h
+
+#include "TOCropPixelView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Copies a view into a buffer of the same size, clipped to the circle (or ellipse, for
+/// non-square views) inscribed inside it, with anti-aliased edges.
+///
+/// Each row is split into spans: pixels wholly inside the circle are copied straight
+/// across, pixels wholly outside are zero-filled without being read, and only the thin
+/// ring of pixels along the edge has its coverage worked out, which is then multiplied
+/// into every channel. This means the pixels must be premultiplied by their alpha, and
+/// (as only 8-bit channels are blended) in the `TOCropPixelFormatRGBA8` format.
+///
+/// @param view The pixels to copy
+/// @param alphaMask Bits to set in every copied pixel before its coverage is applied. Sources
+///                  without alpha that leave a byte of each pixel unused should pass a mask
+///                  filling that byte, so it becomes fully opaque. Otherwise pass 0.
+/// @param destination A buffer exactly the size of `view` to write the pixels into
+/// @return false if the buffer's dimensions don't match the view, or either isn't 8-bit
+bool TOCropPixelViewCopyToBufferWithCircularMask(TOCropPixelView view,
+                                                 uint32_t alphaMask,
+                                                 TOCropPixelBuffer *destination);
+
+/// Does the same as `TOCropPixelViewCopyToBufferWithCircularMask`, but only for a range of rows,
+/// so separate threads can each fill in their own part of the same destination buffer.
+/// The circle is still the one inscribed in the whole view.
+/// @return false if the buffer's dimensions don't match the view, either isn't 8-bit, or the
+///         rows run past the bottom of the view
+bool TOCropPixelViewCopyRowsToBufferWithCircularMask(TOCropPixelView view,
+                                                     uint32_t alphaMask,
+                                                     size_t firstRow,
+                                                     size_t rowCount,
+                                                     TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropCircularMask_h */
@@ -0,0 +1,994 @@
+//
+//  TOCropJPEGTransform.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropJPEGTransform.h"
+
+#include "TOCropPixelOrientation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The most components a frame can have, and metadata segments that will be carried across
+#define kTOCropJPEGMaxComponents 4
+#define kTOCropJPEGMaxSegments 32
+
+// The position in an 8x8 block of each coefficient, in the zig-zag order they're stored in
+static const uint8_t kTOCropJPEGNaturalOrder[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+// The example Huffman tables from Annex K of the JPEG spec. The output is encoded with
+// these rather than the source's own tables, since a rotated block produces different
+// run lengths, which an optimized source table may have no codes for.
+static const uint8_t kTOCropJPEGLuminanceDCBits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+static const uint8_t kTOCropJPEGChrominanceDCBits[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+static const uint8_t kTOCropJPEGDCValues[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+static const uint8_t kTOCropJPEGLuminanceACBits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+static const uint8_t kTOCropJPEGLuminanceACValues[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+static const uint8_t kTOCropJPEGChrominanceACBits[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+static const uint8_t kTOCropJPEGChrominanceACValues[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+// A Huffman table as needed for decoding, with a lookup for every code of 8 bits or fewer
+typedef struct {
+    bool defined;
+    uint8_t values[256];
+    int32_t minCode[17];
+    int32_t maxCode[18];
+    int32_t valueOffset[17];
+    uint8_t lookupLength[256]; // 0 when the code is longer than 8 bits
+    uint8_t lookupValue[256];
+} TOCropJPEGDecodeTable;
+
+// A Huffman table as needed for encoding, indexed by symbol
+typedef struct {
+    uint16_t codes[256];
+    uint8_t lengths[256];
+} TOCropJPEGEncodeTable;
+
+typedef struct {
+    uint8_t identifier;
+    int horizontalSampling;
+    int verticalSampling;
+    int quantTable;
+    int dcTable;
+    int acTable;
+
+    // The blocks of this component inside the crop region, and where they start in the image
+    size_t originBlockX;
+    size_t originBlockY;
+    size_t blocksWide;
+    size_t blocksHigh;
+    int16_t *coefficients;
+} TOCropJPEGComponent;
+
+// A byte range of the source file to be copied into the output as-is
+typedef struct {
+    size_t offset;
+    size_t length;
+} TOCropJPEGSegment;
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    size_t position;
+
+    uint16_t quantTables[4][64]; // In natural order
+    bool quantTableDefined[4];
+    TOCropJPEGDecodeTable dcTables[4];
+    TOCropJPEGDecodeTable acTables[4];
+
+    bool frameDefined;
+    bool extendedFrame;
+    size_t width;
+    size_t height;
+    int componentCount;
+    TOCropJPEGComponent components[kTOCropJPEGMaxComponents];
+    int maxHorizontalSampling;
+    int maxVerticalSampling;
+    unsigned int restartInterval;
+
+    TOCropJPEGSegment segments[kTOCropJPEGMaxSegments];
+    int segmentCount;
+    int exifOrientation;
+    size_t exifOrientationOffset; // Absolute offset of the orientation value, or 0 if none
+
+    // The crop, in the source image's own pixels, expanded to whole MCUs
+    TOCropPixelRect region;
+} TOCropJPEGDecoder;
+
+typedef struct {
+    uint32_t buffer;
+    int bitCount;
+    bool hitMarker;
+} TOCropJPEGBitReader;
+
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    uint32_t buffer;
+    int bitCount;
+} TOCropJPEGWriter;
+
+#pragma mark - Reading -
+
+static bool TOCropJPEGReadUInt16(TOCropJPEGDecoder *decoder, size_t *value) {
+    if (decoder->position + 2 > decoder->length) {
+        return false;
+    }
+    *value = ((size_t)decoder->data[decoder->position] << 8) | decoder->data[decoder->position + 1];
+    decoder->position += 2;
+    return true;
+}
+
+static bool TOCropJPEGBuildDecodeTable(TOCropJPEGDecodeTable *table, const uint8_t bits[16],
+                                       const uint8_t *values, size_t valueCount) {
+    memset(table, 0, sizeof(TOCropJPEGDecodeTable));
+    memcpy(table->values, values, valueCount);
+
+    // Canonical codes count upwards within each length, then double for the next length
+    int32_t code = 0;
+    int32_t index = 0;
+    for (int length = 1; length <= 16; length++) {
+        const int count = bits[length - 1];
+
+        // An over-subscribed table has more codes than fit in this length, which would run off
+        // the end of the lookup table below
+        if (code + count > (1 << length)) {
+            return false;
+        }
+        table->valueOffset[length] = index;
+        table->minCode[length] = code;
+        table->maxCode[length] = count ? code + count - 1 : -1;
+        for (int i = 0; i < count; i++, code++, index++) {
+            if (length <= 8) {
+                // Every 8-bit prefix starting with this code resolves straight to it
+                const int first = code << (8 - length), last = first + (1 << (8 - length));
+                for (int prefix = first; prefix < last; prefix++) {
+                    table->lookupLength[prefix] = (uint8_t)length;
+                    table->lookupValue[prefix] = values[index];
+                }
+            }
+        }
+        code <<= 1;
+    }
+    table->maxCode[17] = INT32_MAX;
+    table->defined = true;
+    return (size_t)index == valueCount;
+}
+
+static bool TOCropJPEGReadQuantTables(TOCropJPEGDecoder *decoder, size_t end) {
+    while (decoder->position < end) {
+        const uint8_t info = decoder->data[decoder->position++];
+        const int precision = info >> 4, identifier = info & 15;
+        const size_t size = precision ? 128 : 64;
+        if (identifier > 3 || precision > 1 || decoder->position + size > end) {
+            return false;
+        }
+        for (int k = 0; k < 64; k++) {
+            const uint8_t *value = decoder->data + decoder->position + (precision ? k * 2 : k);
+            decoder->quantTables[identifier][kTOCropJPEGNaturalOrder[k]] = precision ? (uint16_t)((value[0] << 8) | value[1]) : value[0];
+        }
+        decoder->quantTableDefined[identifier] = true;
+        decoder->position += size;
+    }
+    return true;
+}
+
+static bool TOCropJPEGReadHuffmanTables(TOCropJPEGDecoder *decoder, size_t end) {
+    while (decoder->position + 17 <= end) {
+        const uint8_t info = decoder->data[decoder->position];
+        const int tableClass = info >> 4, identifier = info & 15;
+        const uint8_t *bits = decoder->data + decoder->position + 1;
+        size_t valueCount = 0;
+        for (int i = 0; i < 16; i++) {
+            valueCount += bits[i];
+        }
+        decoder->position += 17;
+        if (tableClass > 1 || identifier > 3 || valueCount > 256 || decoder->position + valueCount > end) {
+            return false;
+        }
+        TOCropJPEGDecodeTable *table = tableClass ? &decoder->acTables[identifier] : &decoder->dcTables[identifier];
+        if (!TOCropJPEGBuildDecodeTable(table, bits, decoder->data + decoder->position, valueCount)) {
+            return false;
+        }
+        decoder->position += valueCount;
+    }
+    return decoder->position == end;
+}
+
+static bool TOCropJPEGReadFrame(TOCropJPEGDecoder *decoder, size_t end) {
+    if (decoder->frameDefined || decoder->position + 6 > end) {
+        return false;
+    }
+    const uint8_t *frame = decoder->data + decoder->position;
+    decoder->height = ((size_t)frame[1] << 8) | frame[2];
+    decoder->width = ((size_t)frame[3] << 8) | frame[4];
+    decoder->componentCount = frame[5];
+
+    // Only 8-bit samples, and an explicit height (rather than one given at the end by DNL)
+    if (frame[0] != 8 || decoder->width == 0 || decoder->height == 0 ||
+        decoder->componentCount < 1 || decoder->componentCount > kTOCropJPEGMaxComponents ||
+        decoder->position + 6 + (decoder->componentCount * 3) > end) {
+        return false;
+    }
+
+    for (int i = 0; i < decoder->componentCount; i++) {
+        const uint8_t *info = frame + 6 + (i * 3);
+        TOCropJPEGComponent *component = &decoder->components[i];
+        component->identifier = info[0];
+        component->horizontalSampling = info[1] >> 4;
+        component->verticalSampling = info[1] & 15;
+        component->quantTable = info[2];
+        if (component->horizontalSampling < 1 || component->horizontalSampling > 4 ||
+            component->verticalSampling < 1 || component->verticalSampling > 4 || component->quantTable > 3) {
+            return false;
+        }
+        if (component->horizontalSampling > decoder->maxHorizontalSampling) {
+            decoder->maxHorizontalSampling = component->horizontalSampling;
+        }
+        if (component->verticalSampling > decoder->maxVerticalSampling) {
+            decoder->maxVerticalSampling = component->verticalSampling;
+        }
+    }
+
+    // A lone component is coded one block at a time, whatever sampling it claims
+    if (decoder->componentCount == 1) {
+        decoder->components[0].horizontalSampling = decoder->components[0].verticalSampling = 1;
+        decoder->maxHorizontalSampling = decoder->maxVerticalSampling = 1;
+    }
+
+    decoder->frameDefined = true;
+    decoder->position = end;
+    return true;
+}
+
+// Finds the orientation tag in the first IFD of an EXIF segment, if there is one
+static void TOCropJPEGReadExifOrientation(TOCropJPEGDecoder *decoder, size_t start, size_t end) {
+    static const uint8_t header[6] = {'E', 'x', 'i', 'f', 0, 0};
+    if (end - start < 14 || memcmp(decoder->data + start, header, sizeof(header)) != 0) {
+        return;
+    }
+
+    const uint8_t *tiff = decoder->data + start + 6;
+    const size_t tiffLength = end - start - 6;
+    bool bigEndian;
+    if (tiff[0] == 'M' && tiff[1] == 'M') {
+        bigEndian = true;
+    } else if (tiff[0] == 'I' && tiff[1] == 'I') {
+        bigEndian = false;
+    } else {
+        return;
+    }
+
+#define TOCROP_EXIF_UINT16(p) (bigEndian ? (uint32_t)(((p)[0] << 8) | (p)[1]) : (uint32_t)(((p)[1] << 8) | (p)[0]))
+#define TOCROP_EXIF_UINT32(p) (bigEndian ? (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (p)[3]) \
+                                         : (((uint32_t)(p)[3] << 24) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[1] << 8) | (p)[0]))
+    const size_t ifdOffset = TOCROP_EXIF_UINT32(tiff + 4);
+    if (ifdOffset + 2 > tiffLength) {
+        return;
+    }
+    const size_t entryCount = TOCROP_EXIF_UINT16(tiff + ifdOffset);
+    for (size_t i = 0; i < entryCount; i++) {
+        const size_t entry = ifdOffset + 2 + (i * 12);
+        if (entry + 12 > tiffLength) {
+            return;
+        }
+        if (TOCROP_EXIF_UINT16(tiff + entry) == 0x0112 && TOCROP_EXIF_UINT16(tiff + entry + 2) == 3) {
+            const int orientation = (int)TOCROP_EXIF_UINT16(tiff + entry + 8);
+            if (orientation >= 1 && orientation <= 8) {
+                decoder->exifOrientation = orientation;
+                decoder->exifOrientationOffset = (size_t)((tiff + entry + 8) - decoder->data);
+            }
+            return;
+        }
+    }
+#undef TOCROP_EXIF_UINT16
+#undef TOCROP_EXIF_UINT32
+}
+
+// Reads every marker segment up to the start of the first scan
+static bool TOCropJPEGReadHeaders(TOCropJPEGDecoder *decoder) {
+    if (decoder->length < 4 || decoder->data[0] != 0xff || decoder->data[1] != 0xd8) {
+        return false;
+    }
+    decoder->position = 2;
+
+    while (decoder->position + 4 <= decoder->length) {
+        if (decoder->data[decoder->position] != 0xff) {
+            return false;
+        }
+        const uint8_t marker = decoder->data[decoder->position + 1];
+        if (marker == 0xff) { // Fill byte
+            decoder->position++;
+            continue;
+        }
+
+        const size_t segmentStart = decoder->position;
+        decoder->position += 2;
+        size_t segmentLength;
+        if (!TOCropJPEGReadUInt16(decoder, &segmentLength) || segmentLength < 2 ||
+            segmentStart + 2 + segmentLength > decoder->length) {
+            return false;
+        }
+        const size_t end = segmentStart + 2 + segmentLength;
+
+        switch (marker) {
+            case 0xc0: // Baseline
+            case 0xc1: // Extended sequential, Huffman coded
+                decoder->extendedFrame = (marker == 0xc1);
+                if (!TOCropJPEGReadFrame(decoder, end)) {
+                    return false;
+                }
+                break;
+            case 0xc4:
+                if (!TOCropJPEGReadHuffmanTables(decoder, end)) {
+                    return false;
+                }
+                break;
+            case 0xdb:
+                if (!TOCropJPEGReadQuantTables(decoder, end)) {
+                    return false;
+                }
+                break;
+            case 0xdd:
+                if (segmentLength != 4) {
+                    return false;
+                }
+                decoder->restartInterval = ((unsigned int)decoder->data[segmentStart + 4] << 8) | decoder->data[segmentStart + 5];
+                break;
+            case 0xda:
+                decoder->position = segmentStart;
+                return decoder->frameDefined;
+            default:
+                if ((marker >= 0xe0 && marker <= 0xef) || marker == 0xfe) {
+                    // Application data and comments are carried across to the output
+                    if (decoder->segmentCount == kTOCropJPEGMaxSegments) {
+                        return false;
+                    }
+                    decoder->segments[decoder->segmentCount++] = (TOCropJPEGSegment){segmentStart, end - segmentStart};
+                    if (marker == 0xe1 && decoder->exifOrientationOffset == 0) {
+                        TOCropJPEGReadExifOrientation(decoder, segmentStart + 4, end);
+                    }
+                } else if (marker >= 0xc0 && marker <= 0xcf) {
+                    return false; // Progressive, lossless, hierarchical or arithmetic coded
+                }
+                break;
+        }
+        decoder->position = end;
+    }
+    return false;
+}
+
+#pragma mark - Entropy Decoding -
+
+static void TOCropJPEGFillBits(TOCropJPEGDecoder *decoder, TOCropJPEGBitReader *reader) {
+    while (reader->bitCount <= 24) {
+        uint32_t byte = 0;
+        if (!reader->hitMarker && decoder->position < decoder->length) {
+            byte = decoder->data[decoder->position];
+            if (byte == 0xff) {
+                const uint8_t next = (decoder->position + 1 < decoder->length) ? decoder->data[decoder->position + 1] : 0;
+                if (next == 0x00) {
+                    decoder->position += 2; // A stuffed 0xff data byte
+                } else {
+                    reader->hitMarker = true; // Leave the marker to be read, and pad with zeros
+                    byte = 0;
+                }
+            } else {
+                decoder->position++;
+            }
+        }
+        reader->buffer = (reader->buffer << 8) | byte;
+        reader->bitCount += 8;
+    }
+}
+
+static inline uint32_t TOCropJPEGReadBits(TOCropJPEGDecoder *decoder, TOCropJPEGBitReader *reader, int count) {
+    if (count == 0) {
+        return 0;
+    }
+    TOCropJPEGFillBits(decoder, reader);
+    reader->bitCount -= count;
+    return (reader->buffer >> reader->bitCount) & ((1u << count) - 1);
+}
+
+static inline int TOCropJPEGDecodeSymbol(TOCropJPEGDecoder *decoder, TOCropJPEGBitReader *reader,
+                                         const TOCropJPEGDecodeTable *table) {
+    TOCropJPEGFillBits(decoder, reader);
+    const uint32_t peek = (reader->buffer >> (reader->bitCount - 8)) & 0xff;
+    if (table->lookupLength[peek]) {
+        reader->bitCount -= table->lookupLength[peek];
+        return table->lookupValue[peek];
+    }
+
+    // Longer codes are walked a bit at a time past the first 8
+    int32_t code = (int32_t)peek;
+    reader->bitCount -= 8;
+    for (int length = 9; length <= 16; length++) {
+        code = (code << 1) | (int32_t)TOCropJPEGReadBits(decoder, reader, 1);
+        if (code <= table->maxCode[length]) {
+            return table->values[table->valueOffset[length] + code - table->minCode[length]];
+        }
+    }
+    return -1;
+}
+
+// Turns `count` raw bits into the signed value they encode
+static inline int TOCropJPEGExtend(uint32_t bits, int count) {
+    return (count > 0 && bits < (1u << (count - 1))) ? (int)bits - (1 << count) + 1 : (int)bits;
+}
+
+static bool TOCropJPEGDecodeBlock(TOCropJPEGDecoder *decoder, TOCropJPEGBitReader *reader,
+                                  const TOCropJPEGComponent *component, int *dcPrediction, int16_t *block) {
+    memset(block, 0, sizeof(int16_t) * 64);
+
+    const int dcSize = TOCropJPEGDecodeSymbol(decoder, reader, &decoder->dcTables[component->dcTable]);
+    if (dcSize < 0 || dcSize > 11) {
+        return false;
+    }
+    *dcPrediction += TOCropJPEGExtend(TOCropJPEGReadBits(decoder, reader, dcSize), dcSize);
+    block[0] = (int16_t)*dcPrediction;
+
+    const TOCropJPEGDecodeTable *acTable = &decoder->acTables[component->acTable];
+    for (int k = 1; k < 64;) {
+        const int symbol = TOCropJPEGDecodeSymbol(decoder, reader, acTable);
+        if (symbol < 0) {
+            return false;
+        }
+        const int run = symbol >> 4, size = symbol & 15;
+        if (size == 0) {
+            if (run != 15) {
+                break; // End of block
+            }
+            k += 16;
+            continue;
+        }
+        k += run;
+        if (k > 63) {
+            return false;
+        }
+        block[kTOCropJPEGNaturalOrder[k++]] = (int16_t)TOCropJPEGExtend(TOCropJPEGReadBits(decoder, reader, size), size);
+    }
+    return true;
+}
+
+// Skips ahead to the restart marker expected at the end of a restart interval
+static bool TOCropJPEGReadRestartMarker(TOCropJPEGDecoder *decoder, TOCropJPEGBitReader *reader) {
+    reader->buffer = 0;
+    reader->bitCount = 0;
+    reader->hitMarker = false;
+    while (decoder->position + 1 < decoder->length) {
+        if (decoder->data[decoder->position] == 0xff) {
+            const uint8_t marker = decoder->data[decoder->position + 1];
+            if (marker >= 0xd0 && marker <= 0xd7) {
+                decoder->position += 2;
+                return true;
+            }
+            if (marker != 0x00 && marker != 0xff) {
+                return false;
+            }
+        }
+        decoder->position++;
+    }
+    return false;
+}
+
+// Decodes the scan, keeping only the blocks inside each component's crop region
+static bool TOCropJPEGReadScan(TOCropJPEGDecoder *decoder) {
+    size_t headerLength;
+    decoder->position += 2;
+    if (!TOCropJPEGReadUInt16(decoder, &headerLength) || decoder->position + headerLength - 2 > decoder->length) {
+        return false;
+    }
+    const uint8_t *header = decoder->data + decoder->position;
+    const int scanComponentCount = header[0];
+
+    // Everything needs to arrive in one interleaved scan, in frame order
+    if (scanComponentCount != decoder->componentCount || headerLength != 6 + (size_t)(2 * scanComponentCount)) {
+        return false;
+    }
+    for (int i = 0; i < scanComponentCount; i++) {
+        TOCropJPEGComponent *component = &decoder->components[i];
+        if (header[1 + (i * 2)] != component->identifier) {
+            return false;
+        }
+        component->dcTable = header[2 + (i * 2)] >> 4;
+        component->acTable = header[2 + (i * 2)] & 15;
+        if (component->dcTable > 3 || component->acTable > 3 ||
+            !decoder->dcTables[component->dcTable].defined || !decoder->acTables[component->acTable].defined ||
+            !decoder->quantTableDefined[component->quantTable]) {
+            return false;
+        }
+    }
+    const uint8_t *spectral = header + 1 + (scanComponentCount * 2);
+    if (spectral[0] != 0 || spectral[1] != 63 || spectral[2] != 0) {
+        return false;
+    }
+    decoder->position += headerLength - 2;
+
+    const size_t mcuWidth = 8 * (size_t)decoder->maxHorizontalSampling;
+    const size_t mcuHeight = 8 * (size_t)decoder->maxVerticalSampling;
+    const size_t mcusWide = (decoder->width + mcuWidth - 1) / mcuWidth;
+
+    // Nothing after the last MCU row of the crop is needed
+    const size_t lastMCURow = (decoder->region.y + decoder->region.height + mcuHeight - 1) / mcuHeight;
+
+    TOCropJPEGBitReader reader = {0, 0, false};
+    int dcPredictions[kTOCropJPEGMaxComponents] = {0};
+    int16_t scratch[64];
+    size_t mcuCount = 0;
+    for (size_t mcuY = 0; mcuY < lastMCURow; mcuY++) {
+        for (size_t mcuX = 0; mcuX < mcusWide; mcuX++) {
+            if (decoder->restartInterval && mcuCount > 0 && mcuCount % decoder->restartInterval == 0) {
+                if (!TOCropJPEGReadRestartMarker(decoder, &reader)) {
+                    return false;
+                }
+                memset(dcPredictions, 0, sizeof(dcPredictions));
+            }
+            mcuCount++;
+
+            for (int c = 0; c < decoder->componentCount; c++) {
+                const TOCropJPEGComponent *component = &decoder->components[c];
+                for (int v = 0; v < component->verticalSampling; v++) {
+                    for (int h = 0; h < component->horizontalSampling; h++) {
+                        const size_t blockX = (mcuX * component->horizontalSampling) + h;
+                        const size_t blockY = (mcuY * component->verticalSampling) + v;
+                        int16_t *block = scratch;
+                        if (blockX >= component->originBlockX && blockX - component->originBlockX < component->blocksWide &&
+                            blockY >= component->originBlockY && blockY - component->originBlockY < component->blocksHigh) {
+                            block = component->coefficients + ((((blockY - component->originBlockY) * component->blocksWide) +
+                                                                (blockX - component->originBlockX)) * 64);
+                        }
+                        if (!TOCropJPEGDecodeBlock(decoder, &reader, component, &dcPredictions[c], block)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+#pragma mark - Writing -
+
+static void TOCropJPEGWriteBytes(TOCropJPEGWriter *writer, const void *bytes, size_t length) {
+    if (writer->failed) {
+        return;
+    }
+    if (writer->length + length > writer->capacity) {
+        size_t capacity = writer->capacity ? writer->capacity : 4096;
+        while (capacity < writer->length + length) {
+            capacity *= 2;
+        }
+        uint8_t *data = realloc(writer->data, capacity);
+        if (data == NULL) {
+            writer->failed = true;
+            return;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    memcpy(writer->data + writer->length, bytes, length);
+    writer->length += length;
+}
+
+static void TOCropJPEGWriteByte(TOCropJPEGWriter *writer, uint8_t byte) {
+    TOCropJPEGWriteBytes(writer, &byte, 1);
+}
+
+static void TOCropJPEGWriteMarker(TOCropJPEGWriter *writer, uint8_t marker, size_t payloadLength) {
+    const uint8_t bytes[4] = {0xff, marker, (uint8_t)((payloadLength + 2) >> 8), (uint8_t)(payloadLength + 2)};
+    TOCropJPEGWriteBytes(writer, bytes, sizeof(bytes));
+}
+
+static void TOCropJPEGWriteBits(TOCropJPEGWriter *writer, uint32_t bits, int count) {
+    writer->buffer = (writer->buffer << count) | (bits & ((1u << count) - 1));
+    writer->bitCount += count;
+    while (writer->bitCount >= 8) {
+        const uint8_t byte = (uint8_t)(writer->buffer >> (writer->bitCount - 8));
+        TOCropJPEGWriteByte(writer, byte);
+        if (byte == 0xff) {
+            TOCropJPEGWriteByte(writer, 0x00);
+        }
+        writer->bitCount -= 8;
+    }
+}
+
+static void TOCropJPEGBuildEncodeTable(TOCropJPEGEncodeTable *table, const uint8_t bits[16], const uint8_t *values) {
+    memset(table, 0, sizeof(TOCropJPEGEncodeTable));
+    uint16_t code = 0;
+    int index = 0;
+    for (int length = 1; length <= 16; length++) {
+        for (int i = 0; i < bits[length - 1]; i++, code++, index++) {
+            table->codes[values[index]] = code;
+            table->lengths[values[index]] = (uint8_t)length;
+        }
+        code <<= 1;
+    }
+}
+
+static void TOCropJPEGWriteHuffmanTable(TOCropJPEGWriter *writer, int tableClass, int identifier,
+                                        const uint8_t bits[16], const uint8_t *values) {
+    size_t valueCount = 0;
+    for (int i = 0; i < 16; i++) {
+        valueCount += bits[i];
+    }
+    TOCropJPEGWriteMarker(writer, 0xc4, 17 + valueCount);
+    TOCropJPEGWriteByte(writer, (uint8_t)((tableClass << 4) | identifier));
+    TOCropJPEGWriteBytes(writer, bits, 16);
+    TOCropJPEGWriteBytes(writer, values, valueCount);
+}
+
+// The number of bits needed to hold the magnitude of a coefficient
+static inline int TOCropJPEGBitLength(int value) {
+    unsigned int magnitude = (unsigned int)(value < 0 ? -value : value);
+    int length = 0;
+    while (magnitude) {
+        length++;
+        magnitude >>= 1;
+    }
+    return length;
+}
+
+static void TOCropJPEGWriteBlock(TOCropJPEGWriter *writer, const int16_t *block, int *dcPrediction,
+                                 const TOCropJPEGEncodeTable *dcTable, const TOCropJPEGEncodeTable *acTable) {
+    const int difference = block[0] - *dcPrediction;
+    *dcPrediction = block[0];
+    int size = TOCropJPEGBitLength(difference);
+    TOCropJPEGWriteBits(writer, dcTable->codes[size], dcTable->lengths[size]);
+    TOCropJPEGWriteBits(writer, (uint32_t)(difference < 0 ? difference - 1 : difference), size);
+
+    int run = 0;
+    for (int k = 1; k < 64; k++) {
+        const int value = block[kTOCropJPEGNaturalOrder[k]];
+        if (value == 0) {
+            run++;
+            continue;
+        }
+        while (run > 15) {
+            TOCropJPEGWriteBits(writer, acTable->codes[0xf0], acTable->lengths[0xf0]);
+            run -= 16;
+        }
+        size = TOCropJPEGBitLength(value);
+        const int symbol = (run << 4) | size;
+        TOCropJPEGWriteBits(writer, acTable->codes[symbol], acTable->lengths[symbol]);
+        TOCropJPEGWriteBits(writer, (uint32_t)(value < 0 ? value - 1 : value), size);
+        run = 0;
+    }
+    if (run > 0) {
+        TOCropJPEGWriteBits(writer, acTable->codes[0x00], acTable->lengths[0x00]);
+    }
+}
+
+// Moves a block's coefficients to where they land after the orientation is applied.
+// Mirroring a block negates its odd frequencies along that axis, and transposing it
+// swaps its horizontal and vertical frequencies.
+static void TOCropJPEGOrientBlock(const int16_t *source, TOCropPixelOrientation orientation, int16_t *destination) {
+    for (int v = 0; v < 8; v++) {
+        for (int u = 0; u < 8; u++) {
+            int value = orientation.transpose ? source[(u * 8) + v] : source[(v * 8) + u];
+            if ((orientation.flipX && (u & 1)) != (orientation.flipY && (v & 1))) {
+                value = -value;
+            }
+            destination[(v * 8) + u] = (int16_t)value;
+        }
+    }
+}
+
+static bool TOCropJPEGWriteImage(const TOCropJPEGDecoder *decoder, TOCropPixelOrientation orientation,
+                                 uint8_t **outputData, size_t *outputLength) {
+    TOCropJPEGWriter writer = {0};
+    const uint8_t startOfImage[2] = {0xff, 0xd8};
+    TOCropJPEGWriteBytes(&writer, startOfImage, sizeof(startOfImage));
+
+    // Metadata, with the EXIF orientation reset now that it's been applied to the pixels
+    for (int i = 0; i < decoder->segmentCount; i++) {
+        const TOCropJPEGSegment segment = decoder->segments[i];
+        const size_t start = writer.length;
+        TOCropJPEGWriteBytes(&writer, decoder->data + segment.offset, segment.length);
+        const size_t orientationOffset = decoder->exifOrientationOffset;
+        if (!writer.failed && orientationOffset >= segment.offset && orientationOffset + 2 <= segment.offset + segment.length) {
+            uint8_t *value = writer.data + start + (orientationOffset - segment.offset);
+            const bool bigEndian = (value[0] == 0);
+            value[0] = bigEndian ? 0 : 1;
+            value[1] = bigEndian ? 1 : 0;
+        }
+    }
+
+    // Quantization tables, transposed along with the coefficients they apply to
+    bool needsExtendedFrame = decoder->extendedFrame;
+    for (int identifier = 0; identifier < 4; identifier++) {
+        if (!decoder->quantTableDefined[identifier]) {
+            continue;
+        }
+        uint16_t table[64];
+        bool wide = false;
+        for (int v = 0; v < 8; v++) {
+            for (int u = 0; u < 8; u++) {
+                table[(v * 8) + u] = decoder->quantTables[identifier][orientation.transpose ? (u * 8) + v : (v * 8) + u];
+                wide = wide || table[(v * 8) + u] > 255;
+            }
+        }
+        needsExtendedFrame = needsExtendedFrame || wide;
+        TOCropJPEGWriteMarker(&writer, 0xdb, 1 + (wide ? 128 : 64));
+        TOCropJPEGWriteByte(&writer, (uint8_t)(((wide ? 1 : 0) << 4) | identifier));
+        for (int k = 0; k < 64; k++) {
+            const uint16_t value = table[kTOCropJPEGNaturalOrder[k]];
+            if (wide) {
+                TOCropJPEGWriteByte(&writer, (uint8_t)(value >> 8));
+            }
+            TOCropJPEGWriteByte(&writer, (uint8_t)value);
+        }
+    }
+
+    // The frame, with its dimensions and sampling factors swapped if the image was transposed
+    const size_t outputWidth = orientation.transpose ? decoder->region.height : decoder->region.width;
+    const size_t outputHeight = orientation.transpose ? decoder->region.width : decoder->region.height;
+    TOCropJPEGWriteMarker(&writer, needsExtendedFrame ? 0xc1 : 0xc0, 6 + (3 * (size_t)decoder->componentCount));
+    const uint8_t frame[6] = {8, (uint8_t)(outputHeight >> 8), (uint8_t)outputHeight,
+                              (uint8_t)(outputWidth >> 8), (uint8_t)outputWidth, (uint8_t)decoder->componentCount};
+    TOCropJPEGWriteBytes(&writer, frame, sizeof(frame));
+    for (int c = 0; c < decoder->componentCount; c++) {
+        const TOCropJPEGComponent *component = &decoder->components[c];
+        const int h = orientation.transpose ? component->verticalSampling : component->horizontalSampling;
+        const int v = orientation.transpose ? component->horizontalSampling : component->verticalSampling;
+        const uint8_t info[3] = {component->identifier, (uint8_t)((h << 4) | v), (uint8_t)component->quantTable};
+        TOCropJPEGWriteBytes(&writer, info, sizeof(info));
+    }
+
+    // The first component is assumed to be luminance, and the rest chrominance
+    TOCropJPEGWriteHuffmanTable(&writer, 0, 0, kTOCropJPEGLuminanceDCBits, kTOCropJPEGDCValues);
+    TOCropJPEGWriteHuffmanTable(&writer, 1, 0, kTOCropJPEGLuminanceACBits, kTOCropJPEGLuminanceACValues);
+    if (decoder->componentCount > 1) {
+        TOCropJPEGWriteHuffmanTable(&writer, 0, 1, kTOCropJPEGChrominanceDCBits, kTOCropJPEGDCValues);
+        TOCropJPEGWriteHuffmanTable(&writer, 1, 1, kTOCropJPEGChrominanceACBits, kTOCropJPEGChrominanceACValues);
+    }
+    TOCropJPEGEncodeTable dcTables[2], acTables[2];
+    TOCropJPEGBuildEncodeTable(&dcTables[0], kTOCropJPEGLuminanceDCBits, kTOCropJPEGDCValues);
+    TOCropJPEGBuildEncodeTable(&acTables[0], kTOCropJPEGLuminanceACBits, kTOCropJPEGLuminanceACValues);
+    TOCropJPEGBuildEncodeTable(&dcTables[1], kTOCropJPEGChrominanceDCBits, kTOCropJPEGDCValues);
+    TOCropJPEGBuildEncodeTable(&acTables[1], kTOCropJPEGChrominanceACBits, kTOCropJPEGChrominanceACValues);
+
+    TOCropJPEGWriteMarker(&writer, 0xda, 4 + (2 * (size_t)decoder->componentCount));
+    TOCropJPEGWriteByte(&writer, (uint8_t)decoder->componentCount);
+    for (int c = 0; c < decoder->componentCount; c++) {
+        TOCropJPEGWriteByte(&writer, decoder->components[c].identifier);
+        TOCropJPEGWriteByte(&writer, c == 0 ? 0x00 : 0x11);
+    }
+    const uint8_t spectralSelection[3] = {0, 63, 0};
+    TOCropJPEGWriteBytes(&writer, spectralSelection, sizeof(spectralSelection));
+
+    // Walk the output's MCUs, pulling each block from wherever it sits in the source region
+    const int maxH = orientation.transpose ? decoder->maxVerticalSampling : decoder->maxHorizontalSampling;
+    const int maxV = orientation.transpose ? decoder->maxHorizontalSampling : decoder->maxVerticalSampling;
+    const size_t mcusWide = (outputWidth + (8 * maxH) - 1) / (8 * maxH);
+    const size_t mcusHigh = (outputHeight + (8 * maxV) - 1) / (8 * maxV);
+    int dcPredictions[kTOCropJPEGMaxComponents] = {0};
+    int16_t block[64];
+    for (size_t mcuY = 0; mcuY < mcusHigh; mcuY++) {
+        for (size_t mcuX = 0; mcuX < mcusWide; mcuX++) {
+            for (int c = 0; c < decoder->componentCount; c++) {
+                const TOCropJPEGComponent *component = &decoder->components[c];
+                const int h = orientation.transpose ? component->verticalSampling : component->horizontalSampling;
+                const int v = orientation.transpose ? component->horizontalSampling : component->verticalSampling;
+                const size_t blocksWide = orientation.transpose ? component->blocksHigh : component->blocksWide;
+                const size_t blocksHigh = orientation.transpose ? component->blocksWide : component->blocksHigh;
+                for (int y = 0; y < v; y++) {
+                    for (int x = 0; x < h; x++) {
+                        size_t blockX = (mcuX * h) + x, blockY = (mcuY * v) + y;
+                        if (orientation.flipX) {
+                            blockX = blocksWide - 1 - blockX;
+                        }
+                        if (orientation.flipY) {
+                            blockY = blocksHigh - 1 - blockY;
+                        }
+                        const size_t sourceX = orientation.transpose ? blockY : blockX;
+                        const size_t sourceY = orientation.transpose ? blockX : blockY;
+                        const int16_t *source = component->coefficients + (((sourceY * component->blocksWide) + sourceX) * 64);
+                        TOCropJPEGOrientBlock(source, orientation, block);
+                        TOCropJPEGWriteBlock(&writer, block, &dcPredictions[c], &dcTables[c ? 1 : 0], &acTables[c ? 1 : 0]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Pad out the last byte with ones, then close the file
+    TOCropJPEGWriteBits(&writer, 0x7f, 7);
+    const uint8_t endOfImage[2] = {0xff, 0xd9};
+    TOCropJPEGWriteBytes(&writer, endOfImage, sizeof(endOfImage));
+
+    if (writer.failed) {
+        free(writer.data);
+        return false;
+    }
+    *outputData = writer.data;
+    *outputLength = writer.length;
+    return true;
+}
+
+#pragma mark - Transforming -
+
+// Works out which part of the source the crop comes from, snapped outwards to whole MCUs.
+// MCUs that are only partially inside the image can only be kept if they stay along the
+// right or bottom edge of the output, so they're trimmed from any axis that gets reversed.
+static bool TOCropJPEGSetRegion(TOCropJPEGDecoder *decoder, TOCropPixelRect rect, TOCropPixelOrientation orientation) {
+    const size_t outputWidth = orientation.transpose ? decoder->height : decoder->width;
+    const size_t outputHeight = orientation.transpose ? decoder->width : decoder->height;
+    if (rect.width == 0 || rect.height == 0 || !TOCropPixelRectFitsInSize(rect, outputWidth, outputHeight)) {
+        return false;
+    }
+
+    const TOCropPixelRect region = TOCropPixelOrientationSourceRect(orientation, rect, decoder->width, decoder->height);
+    const bool reversedX = orientation.transpose ? orientation.flipY : orientation.flipX;
+    const bool reversedY = orientation.transpose ? orientation.flipX : orientation.flipY;
+
+    const size_t mcuWidth = 8 * (size_t)decoder->maxHorizontalSampling;
+    const size_t mcuHeight = 8 * (size_t)decoder->maxVerticalSampling;
+    const size_t spans[2][4] = {{region.x, region.width, mcuWidth, decoder->width},
+                                {region.y, region.height, mcuHeight, decoder->height}};
+    const bool reversed[2] = {reversedX, reversedY};
+    size_t snapped[2][2];
+    for (int axis = 0; axis < 2; axis++) {
+        const size_t unit = spans[axis][2], limit = spans[axis][3];
+        const size_t start = (spans[axis][0] / unit) * unit;
+        size_t end = ((spans[axis][0] + spans[axis][1] + unit - 1) / unit) * unit;
+        if (end > limit) {
+            end = reversed[axis] ? (limit / unit) * unit : limit;
+        }
+        if (end <= start) {
+            return false;
+        }
+        snapped[axis][0] = start;
+        snapped[axis][1] = end - start;
+    }
+    decoder->region = (TOCropPixelRect){snapped[0][0], snapped[1][0], snapped[0][1], snapped[1][1]};
+
+    // Each component keeps the blocks covering those MCUs
+    const size_t mcusWide = (decoder->region.width + mcuWidth - 1) / mcuWidth;
+    const size_t mcusHigh = (decoder->region.height + mcuHeight - 1) / mcuHeight;
+    for (int c = 0; c < decoder->componentCount; c++) {
+        TOCropJPEGComponent *component = &decoder->components[c];
+        component->originBlockX = (decoder->region.x / mcuWidth) * component->horizontalSampling;
+        component->originBlockY = (decoder->region.y / mcuHeight) * component->verticalSampling;
+        component->blocksWide = mcusWide * component->horizontalSampling;
+        component->blocksHigh = mcusHigh * component->verticalSampling;
+        if (component->blocksHigh > SIZE_MAX / 64 / sizeof(int16_t) / component->blocksWide) {
+            return false;
+        }
+        component->coefficients = calloc(component->blocksWide * component->blocksHigh * 64, sizeof(int16_t));
+        if (component->coefficients == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TOCropJPEGTransformData(const uint8_t *data,
+                             size_t length,
+                             TOCropPixelRect rect,
+                             int quarterTurns,
+                             uint8_t **outputData,
+                             size_t *outputLength,
+                             TOCropPixelRect *outputRect) {
+    TOCropJPEGDecoder *decoder = calloc(1, sizeof(TOCropJPEGDecoder));
+    if (decoder == NULL) {
+        return false;
+    }
+    decoder->data = data;
+    decoder->length = length;
+
+    // The crop is relative to the image after its EXIF orientation and then the user's
+    // rotation, so both are folded into the one reorientation of the blocks
+    bool success = TOCropJPEGReadHeaders(decoder);
+    TOCropPixelOrientation orientation = TOCropPixelOrientationIdentity();
+    if (success) {
+        orientation = TOCropPixelOrientationConcat(TOCropPixelOrientationForEXIFOrientation(decoder->exifOrientation),
+                                                   TOCropPixelOrientationForQuarterTurns(quarterTurns));
+        success = TOCropJPEGSetRegion(decoder, rect, orientation) &&
+                  TOCropJPEGReadScan(decoder) &&
+                  TOCropJPEGWriteImage(decoder, orientation, outputData, outputLength);
+    }
+
+    if (success && outputRect) {
+        // Report the region that was kept back in the same space as the requested one
+        *outputRect = TOCropPixelOrientationOrientedRect(orientation, decoder->region, decoder->width, decoder->height);
+    }
+
+    for (int c = 0; c < kTOCropJPEGMaxComponents; c++) {
+        free(decoder->components[c].coefficients);
+    }
+    free(decoder);
+    return success;
+}
+
+bool TOCropJPEGTransformFile(const char *inputPath,
+                             const char *outputPath,
+                             TOCropPixelRect rect,
+                             int quarterTurns,
+                             TOCropPixelRect *outputRect) {
+    FILE *input = fopen(inputPath, "rb");
+    if (input == NULL) {
+        return false;
+    }
+
+    uint8_t *data = NULL;
+    long length = -1;
+    if (fseek(input, 0, SEEK_END) == 0 && (length = ftell(input)) > 0 && fseek(input, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)length);
+    }
+    const bool didRead = (data != NULL && fread(data, 1, (size_t)length, input) == (size_t)length);
+    fclose(input);
+
+    uint8_t *outputData = NULL;
+    size_t outputLength = 0;
+    bool success = didRead && TOCropJPEGTransformData(data, (size_t)length, rect, quarterTurns,
+                                                      &outputData, &outputLength, outputRect);
+    free(data);
+    if (!success) {
+        return false;
+    }
+
+    FILE *output = fopen(outputPath, "wb");
+    success = (output != NULL && fwrite(outputData, 1, outputLength, output) == outputLength);
+    if (output != NULL && fclose(output) != 0) {
+        success = false;
+    }
+    if (!success) {
+        remove(outputPath);
+    }
+    free(outputData);
+    return success;
+}
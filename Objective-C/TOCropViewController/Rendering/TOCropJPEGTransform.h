@@ -0,0 +1,83 @@
+//
+//  TOCropJPEGTransform.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropJPEGTransform_h
+#define TOCropJPEGTransform_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Crops and rotates a JPEG without decoding its pixels, in the same manner as `jpegtran`.
+///
+/// Rather than decoding to pixels, cropping and then re-encoding, the quantized DCT
+/// coefficients are read out of the file and the 8x8 blocks are rearranged directly.
+/// Rotating a block is a matter of transposing its coefficients and flipping the sign of
+/// the odd frequencies, so the result is bit-for-bit the same image quality as the original,
+/// and no pixel buffers are ever allocated. Only the blocks inside the crop are kept in memory.
+///
+/// Any EXIF orientation in the file is folded into the same rotation, and then reset to
+/// upright in the output so that viewers don't apply it a second time. All other metadata
+/// segments are copied across untouched.
+///
+/// The crop can only start on the boundary of a whole minimum coded unit (8 or 16 pixels,
+/// depending on chroma subsampling), so `rect` is expanded outwards to the nearest ones.
+/// Partial units along the right and bottom edges of the image are trimmed off if the
+/// rotation would move them to the top or left of the output.
+///
+/// Baseline and extended sequential Huffman JPEGs with 8-bit samples are supported, which
+/// covers those written by cameras and `UIImageJPEGRepresentation`. Progressive and
+/// arithmetic coded files are rejected, and should be cropped through the regular path.
+///
+/// @param data The bytes of the JPEG file
+/// @param length The number of bytes in `data`
+/// @param rect The region to crop, in pixels, in the coordinate space of the image as displayed
+///             (ie, after its EXIF orientation) and then rotated
+/// @param quarterTurns The number of clockwise 90-degree turns to apply
+/// @param outputData On success, the new JPEG file, which must be released with `free()`
+/// @param outputLength On success, the number of bytes in `outputData`
+/// @param outputRect If not NULL, receives the region that was actually kept, after being
+///                   expanded to the nearest block boundaries
+/// @return false if the file is malformed or not supported, or memory couldn't be allocated
+bool TOCropJPEGTransformData(const uint8_t *data,
+                             size_t length,
+                             TOCropPixelRect rect,
+                             int quarterTurns,
+                             uint8_t **outputData,
+                             size_t *outputLength,
+                             TOCropPixelRect *outputRect);
+
+/// The same as `TOCropJPEGTransformData`, reading from and writing to files on disk.
+/// The output file is only created if the transform succeeded.
+bool TOCropJPEGTransformFile(const char *inputPath,
+                             const char *outputPath,
+                             TOCropPixelRect rect,
+                             int quarterTurns,
+                             TOCropPixelRect *outputRect);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropJPEGTransform_h */
@@ -0,0 +1,201 @@
+//
+//  TOCropMipmap.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropMipmap.h"
+
+#include "TOCropParallel.h"
+
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_MIPMAP_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_MIPMAP_SSE2 1
+#endif
+
+// The number of output rows each thread takes at a time
+static const size_t kTOCropMipmapBlockRows = 32;
+
+#pragma mark - Row Filtering -
+
+// Averages each 2x2 block of pixels spanning two rows, starting with output pixel `x`.
+// `x1Limit` is the last source column that can be read, so narrow images repeat their edge.
+static void TOCropDownsampleRowsScalar(const uint8_t *top, const uint8_t *bottom, uint8_t *output,
+                                       size_t x, size_t outputWidth, size_t x1Limit) {
+    for (; x < outputWidth; x++) {
+        const size_t x0 = x * 2;
+        const size_t x1 = (x0 + 1 <= x1Limit) ? x0 + 1 : x1Limit;
+        for (size_t c = 0; c < 4; c++) {
+            const unsigned sum = (unsigned)top[x0 * 4 + c] + top[x1 * 4 + c] +
+                                 bottom[x0 * 4 + c] + bottom[x1 * 4 + c];
+            output[x * 4 + c] = (uint8_t)((sum + 2) >> 2);
+        }
+    }
+}
+
+static void TOCropDownsampleRows(const uint8_t *top, const uint8_t *bottom, uint8_t *output,
+                                 size_t outputWidth, size_t sourceWidth) {
+    size_t x = 0;
+
+    // Four output pixels at a time, from eight pixels of each row. Only whole pairs are
+    // read here, so these never reach past the end of a row.
+    const size_t vectorWidth = (sourceWidth / 8 < outputWidth / 4) ? sourceWidth / 8 * 4 : outputWidth / 4 * 4;
+#if TOCROP_MIPMAP_NEON
+    for (; x < vectorWidth; x += 4) {
+        // De-interleave the even and odd pixels, so each pair to average lines up across two registers
+        const uint32x4x2_t t = vld2q_u32((const uint32_t *)(top + x * 8));
+        const uint32x4x2_t b = vld2q_u32((const uint32_t *)(bottom + x * 8));
+        const uint8x16_t t0 = vreinterpretq_u8_u32(t.val[0]), t1 = vreinterpretq_u8_u32(t.val[1]);
+        const uint8x16_t b0 = vreinterpretq_u8_u32(b.val[0]), b1 = vreinterpretq_u8_u32(b.val[1]);
+        const uint16x8_t low = vaddq_u16(vaddl_u8(vget_low_u8(t0), vget_low_u8(t1)),
+                                         vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+        const uint16x8_t high = vaddq_u16(vaddl_u8(vget_high_u8(t0), vget_high_u8(t1)),
+                                          vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+
+        // A rounding narrowing shift is (sum + 2) >> 2, the same as the scalar path
+        vst1q_u8(output + x * 4, vcombine_u8(vrshrn_n_u16(low, 2), vrshrn_n_u16(high, 2)));
+    }
+#elif TOCROP_MIPMAP_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    for (; x < vectorWidth; x += 4) {
+        const __m128i t0 = _mm_loadu_si128((const __m128i *)(top + x * 8));
+        const __m128i t1 = _mm_loadu_si128((const __m128i *)(top + x * 8 + 16));
+        const __m128i b0 = _mm_loadu_si128((const __m128i *)(bottom + x * 8));
+        const __m128i b1 = _mm_loadu_si128((const __m128i *)(bottom + x * 8 + 16));
+
+        // Sum the rows as 16-bit channels, two pixels to a register
+        const __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(t0, zero), _mm_unpacklo_epi8(b0, zero));
+        const __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(t0, zero), _mm_unpackhi_epi8(b0, zero));
+        const __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(t1, zero), _mm_unpacklo_epi8(b1, zero));
+        const __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(t1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Then add each pixel to its neighbour in the other half of the register
+        const __m128i h01 = _mm_unpacklo_epi64(_mm_add_epi16(s01, _mm_srli_si128(s01, 8)),
+                                               _mm_add_epi16(s23, _mm_srli_si128(s23, 8)));
+        const __m128i h23 = _mm_unpacklo_epi64(_mm_add_epi16(s45, _mm_srli_si128(s45, 8)),
+                                               _mm_add_epi16(s67, _mm_srli_si128(s67, 8)));
+        const __m128i out01 = _mm_srli_epi16(_mm_add_epi16(h01, two), 2);
+        const __m128i out23 = _mm_srli_epi16(_mm_add_epi16(h23, two), 2);
+        _mm_storeu_si128((__m128i *)(output + x * 4), _mm_packus_epi16(out01, out23));
+    }
+#else
+    (void)vectorWidth;
+#endif
+
+    TOCropDownsampleRowsScalar(top, bottom, output, x, outputWidth, sourceWidth - 1);
+}
+
+#pragma mark - Downsampling -
+
+typedef struct {
+    const TOCropPixelBuffer *source;
+    TOCropPixelBuffer *destination;
+} TOCropDownsampleJob;
+
+static void TOCropDownsampleBlock(void *context, size_t block) {
+    const TOCropDownsampleJob *job = (const TOCropDownsampleJob *)context;
+    const TOCropPixelBuffer *source = job->source;
+    TOCropPixelBuffer *destination = job->destination;
+
+    const size_t firstRow = block * kTOCropMipmapBlockRows;
+    const size_t lastRow = (firstRow + kTOCropMipmapBlockRows < destination->height) ? firstRow + kTOCropMipmapBlockRows
+                                                                                     : destination->height;
+    for (size_t y = firstRow; y < lastRow; y++) {
+        const size_t y0 = y * 2;
+        const size_t y1 = (y0 + 1 < source->height) ? y0 + 1 : source->height - 1;
+        TOCropDownsampleRows(source->data + y0 * source->bytesPerRow,
+                             source->data + y1 * source->bytesPerRow,
+                             destination->data + y * destination->bytesPerRow,
+                             destination->width, source->width);
+    }
+}
+
+bool TOCropPixelBufferDownsample(const TOCropPixelBuffer *source, size_t maximumThreads,
+                                 TOCropPixelBuffer *destination) {
+    const size_t width = (source->width > 1) ? source->width / 2 : 1;
+    const size_t height = (source->height > 1) ? source->height / 2 : 1;
+    if (source->format != TOCropPixelFormatRGBA8 || destination->format != TOCropPixelFormatRGBA8 ||
+        source->width == 0 || source->height == 0 || destination->width != width || destination->height != height) {
+        return false;
+    }
+
+    TOCropDownsampleJob job = {source, destination};
+    const size_t blockCount = (height + kTOCropMipmapBlockRows - 1) / kTOCropMipmapBlockRows;
+    TOCropParallelFor(blockCount, maximumThreads, &job, TOCropDownsampleBlock);
+    return true;
+}
+
+#pragma mark - Pyramids -
+
+bool TOCropMipmapPyramidBuild(const TOCropPixelBuffer *source, size_t minimumSize, size_t maximumThreads,
+                              TOCropMipmapPyramid *pyramid) {
+    memset(pyramid, 0, sizeof(TOCropMipmapPyramid));
+    if (source->format != TOCropPixelFormatRGBA8) {
+        return false;
+    }
+
+    pyramid->levels[0] = *source;
+    pyramid->count = 1;
+    while (pyramid->count < TOCropMipmapMaximumLevels) {
+        const TOCropPixelBuffer *previous = &pyramid->levels[pyramid->count - 1];
+        if ((previous->width <= minimumSize && previous->height <= minimumSize) ||
+            (previous->width == 1 && previous->height == 1)) {
+            break;
+        }
+
+        TOCropPixelBuffer *level = &pyramid->levels[pyramid->count];
+        const size_t width = (previous->width > 1) ? previous->width / 2 : 1;
+        const size_t height = (previous->height > 1) ? previous->height / 2 : 1;
+        if (!TOCropPixelBufferAllocate(level, width, height)) {
+            TOCropMipmapPyramidFree(pyramid);
+            return false;
+        }
+
+        // Each level is built from the one before it, which is already a quarter of the work
+        TOCropPixelBufferDownsample(previous, maximumThreads, level);
+        pyramid->count++;
+    }
+    return true;
+}
+
+void TOCropMipmapPyramidFree(TOCropMipmapPyramid *pyramid) {
+    for (size_t i = 1; i < pyramid->count; i++) {
+        TOCropPixelBufferFree(&pyramid->levels[i]);
+    }
+    memset(pyramid, 0, sizeof(TOCropMipmapPyramid));
+}
+
+size_t TOCropMipmapLevelForScale(double scale, size_t levelCount) {
+    // Each level has half the resolution of the one before, so step down
+    // for as long as the next one still covers the scale it's drawn at
+    size_t level = 0;
+    double levelScale = 0.5;
+    while (level + 1 < levelCount && scale > 0.0 && scale <= levelScale) {
+        level++;
+        levelScale *= 0.5;
+    }
+    return level;
+}
@@ -0,0 +1,78 @@
+//
+//  TOCropMipmap.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TOCropMipmap_h
+#define TOCropMipmap_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The most levels a pyramid can hold, which is enough to take a 32768 pixel image down to a single pixel
+#define TOCropMipmapMaximumLevels 16
+
+/// A chain of images, each half the width and height of the one before it, for displaying an image
+/// at a fraction of its size without filtering every one of its pixels each time it's drawn.
+typedef struct {
+    TOCropPixelBuffer levels[TOCropMipmapMaximumLevels]; // The first level is the source itself, which isn't owned
+    size_t count;                                        // The number of levels, including the source
+} TOCropMipmapPyramid;
+
+/// Halves the size of a buffer, setting each output pixel to the rounded average of a 2x2 block
+/// of source pixels (a box filter). When a side has an odd length, its last row or column is dropped.
+///
+/// Every channel is averaged the same way, so pixels should have premultiplied alpha (or no alpha).
+/// Only 8-bit RGBA pixels are supported.
+/// @param source The pixels to shrink
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @param destination A buffer half the size of `source` (rounded down, but at least 1 pixel)
+/// @return false if either buffer isn't 8-bit, or the destination is the wrong size
+bool TOCropPixelBufferDownsample(const TOCropPixelBuffer *source, size_t maximumThreads,
+                                 TOCropPixelBuffer *destination);
+
+/// Builds a pyramid by repeatedly halving a buffer, until neither side of the smallest level
+/// is larger than `minimumSize`. The source becomes the first level, and is only read.
+/// @param source The full size pixels, which must outlive the pyramid
+/// @param minimumSize The size, in pixels, at which to stop adding levels
+/// @param maximumThreads The most threads to spread each level over, or 0 for one per core
+/// @param pyramid The pyramid to fill in. Free it with `TOCropMipmapPyramidFree`.
+/// @return false if the source isn't 8-bit, or a level couldn't be allocated
+bool TOCropMipmapPyramidBuild(const TOCropPixelBuffer *source, size_t minimumSize, size_t maximumThreads,
+                              TOCropMipmapPyramid *pyramid);
+
+/// Releases every level of a pyramid apart from the source, and zeroes it
+void TOCropMipmapPyramidFree(TOCropMipmapPyramid *pyramid);
+
+/// Picks the smallest level that still has at least one pixel for every pixel it'll be drawn at.
+/// @param scale The size the full image is drawn at, relative to its size in pixels (eg, 0.1 for a tenth)
+/// @param levelCount The number of levels available
+/// @return The index of the level to draw
+size_t TOCropMipmapLevelForScale(double scale, size_t levelCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropMipmap_h */
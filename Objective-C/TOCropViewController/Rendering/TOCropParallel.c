@@ -0,0 +1,104 @@
+//
+//  TOCropParallel.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropParallel.h"
+
+#include <stdbool.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#else
+#include <pthread.h>
+#endif
+
+// Shared between every worker thread of one call to `TOCropParallelFor`
+typedef struct {
+    size_t count;
+    size_t nextIndex; // Only touched atomically
+    void *context;
+    TOCropParallelWorkFunction work;
+} TOCropParallelJob;
+
+size_t TOCropParallelDefaultThreadCount(void) {
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (size_t)cores : 1;
+}
+
+// Each worker keeps claiming the next unclaimed index until there are none left, so a
+// slow piece of work on one thread doesn't hold up the rest
+static void TOCropParallelWorker(void *context, size_t worker) {
+    (void)worker;
+    TOCropParallelJob *job = (TOCropParallelJob *)context;
+    for (;;) {
+        const size_t index = __atomic_fetch_add(&job->nextIndex, 1, __ATOMIC_RELAXED);
+        if (index >= job->count) {
+            return;
+        }
+        job->work(job->context, index);
+    }
+}
+
+#if !defined(__APPLE__)
+static void *TOCropParallelThreadMain(void *context) {
+    TOCropParallelWorker(context, 0);
+    return NULL;
+}
+#endif
+
+void TOCropParallelFor(size_t count, size_t maximumThreads, void *context, TOCropParallelWorkFunction work) {
+    size_t threads = maximumThreads > 0 ? maximumThreads : TOCropParallelDefaultThreadCount();
+    if (threads > count) {
+        threads = count;
+    }
+
+    // Not worth the hand-off
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            work(context, i);
+        }
+        return;
+    }
+
+    TOCropParallelJob job = {count, 0, context, work};
+
+#if defined(__APPLE__)
+    // GCD already keeps a pool of threads sized to the device, and runs one of the workers
+    // on the calling thread
+    dispatch_apply_f(threads, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), &job, TOCropParallelWorker);
+#else
+    pthread_t helpers[64];
+    if (threads > sizeof(helpers) / sizeof(helpers[0]) + 1) {
+        threads = sizeof(helpers) / sizeof(helpers[0]) + 1;
+    }
+    size_t started = 0;
+    for (; started < threads - 1; started++) {
+        if (pthread_create(&helpers[started], NULL, TOCropParallelThreadMain, &job) != 0) {
+            break; // Whatever couldn't be started is picked up by the threads that were
+        }
+    }
+    TOCropParallelWorker(&job, 0);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(helpers[i], NULL);
+    }
+#endif
+}
@@ -0,0 +1,54 @@
+//
+//  TOCropParallel.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropParallel_h
+#define TOCropParallel_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// One piece of a job split up by `TOCropParallelFor`
+typedef void (*TOCropParallelWorkFunction)(void *context, size_t index);
+
+/// The number of threads work is spread over when no limit is given: one for each active core
+size_t TOCropParallelDefaultThreadCount(void);
+
+/// Calls `work` once for every index from 0 to `count` - 1, spread over up to `maximumThreads`
+/// threads (the calling one included), and returns once every call has finished.
+///
+/// Indices are handed out to whichever thread is free next, so the order in which they run
+/// isn't fixed. Each call must only write to memory that no other index touches, which is
+/// what keeps the results identical to running them all on one thread.
+/// @param count The number of pieces of work
+/// @param maximumThreads The most threads to use at once, or 0 for one per core
+/// @param context Passed to every call of `work`
+/// @param work Called with each index
+void TOCropParallelFor(size_t count, size_t maximumThreads, void *context, TOCropParallelWorkFunction work);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropParallel_h */
@@ -0,0 +1,438 @@
+//
+//  TOCropPerspective.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropPerspective.h"
+
+#include "TOCropParallel.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_PERSPECTIVE_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_PERSPECTIVE_SSE2 1
+#endif
+
+// The width and height of each tile of output pixels. A tile's output and the source pixels
+// it reads (at most around twice as many, when the quad is shrunk) fit in the L2 cache together.
+static const size_t kTOCropPerspectiveTileSize = 64;
+
+#pragma mark - Pixel Vectors -
+
+// All four channels of one pixel, as floats, so each tap is a single vector multiply and add
+#if TOCROP_PERSPECTIVE_NEON
+typedef float32x4_t TOCropPerspectivePixel;
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelZero(void) { return vdupq_n_f32(0.0f); }
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelLoad(const uint8_t *pixel) {
+    uint32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const uint16x4_t wide = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed))));
+    return vcvtq_f32_u32(vmovl_u16(wide));
+}
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelMultiplyAdd(TOCropPerspectivePixel sum,
+                                                                      TOCropPerspectivePixel pixel, float weight) {
+    return vfmaq_n_f32(sum, pixel, weight);
+}
+
+static inline void TOCropPerspectivePixelStore(TOCropPerspectivePixel pixel, uint8_t *destination) {
+    const uint32x4_t rounded = vcvtnq_u32_f32(vmaxq_f32(pixel, vdupq_n_f32(0.0f)));
+    const uint16x4_t narrow = vqmovn_u32(rounded);
+    const uint8x8_t bytes = vqmovn_u16(vcombine_u16(narrow, narrow));
+    const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+    memcpy(destination, &packed, sizeof(packed));
+}
+#elif TOCROP_PERSPECTIVE_SSE2
+typedef __m128 TOCropPerspectivePixel;
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelZero(void) { return _mm_setzero_ps(); }
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelLoad(const uint8_t *pixel) {
+    int32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+    return _mm_cvtepi32_ps(wide);
+}
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelMultiplyAdd(TOCropPerspectivePixel sum,
+                                                                      TOCropPerspectivePixel pixel, float weight) {
+    return _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(weight)));
+}
+
+static inline void TOCropPerspectivePixelStore(TOCropPerspectivePixel pixel, uint8_t *destination) {
+    const __m128i rounded = _mm_cvtps_epi32(pixel);
+    const __m128i narrow = _mm_packs_epi32(rounded, rounded);
+    const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    memcpy(destination, &packed, sizeof(packed));
+}
+#else
+typedef struct { float channels[TOCropPixelBufferBytesPerPixel]; } TOCropPerspectivePixel;
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelZero(void) {
+    TOCropPerspectivePixel pixel = {{0.0f}};
+    return pixel;
+}
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelLoad(const uint8_t *bytes) {
+    TOCropPerspectivePixel pixel;
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        pixel.channels[c] = bytes[c];
+    }
+    return pixel;
+}
+
+static inline TOCropPerspectivePixel TOCropPerspectivePixelMultiplyAdd(TOCropPerspectivePixel sum,
+                                                                      TOCropPerspectivePixel pixel, float weight) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        sum.channels[c] += pixel.channels[c] * weight;
+    }
+    return sum;
+}
+
+static inline void TOCropPerspectivePixelStore(TOCropPerspectivePixel pixel, uint8_t *destination) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        const float value = pixel.channels[c];
+        destination[c] = value <= 0.0f ? 0 : (value >= 255.0f ? 255 : (uint8_t)(value + 0.5f));
+    }
+}
+#endif
+
+#pragma mark - Interpolation -
+
+// The number of source pixels along each axis that contribute to one output pixel
+static inline int TOCropPerspectiveTaps(TOCropInterpolation interpolation) {
+    return interpolation == TOCropInterpolationBicubic ? 4 : 2;
+}
+
+// The weights of each tap along one axis, for a sample `t` (0...1) of the way past the first
+// pixel at or before it. The bicubic spline is Catmull-Rom, the same as when straightening.
+static inline void TOCropPerspectiveWeights(TOCropInterpolation interpolation, float t, float *weights) {
+    if (interpolation == TOCropInterpolationBicubic) {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        weights[0] = -0.5f * t3 + t2 - 0.5f * t;
+        weights[1] = 1.5f * t3 - 2.5f * t2 + 1.0f;
+        weights[2] = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+        weights[3] = 0.5f * t3 - 0.5f * t2;
+    } else {
+        weights[0] = 1.0f - t;
+        weights[1] = t;
+    }
+}
+
+// Blends a square of `taps` x `taps` source pixels, the top left one of which is at (`x`, `y`).
+// When `checked`, pixels outside of the view count as transparent. Otherwise, they must all be inside it.
+static inline TOCropPerspectivePixel TOCropPerspectiveSample(TOCropPixelView view, ptrdiff_t x, ptrdiff_t y, int taps,
+                                                             const float *weightsX, const float *weightsY, bool checked) {
+    TOCropPerspectivePixel sum = TOCropPerspectivePixelZero();
+    if (!checked || (x >= 0 && y >= 0 && x + taps <= (ptrdiff_t)view.width && y + taps <= (ptrdiff_t)view.height)) {
+        const uint8_t *row = view.origin + x * view.pixelStride + y * view.rowStride;
+        for (int j = 0; j < taps; j++, row += view.rowStride) {
+            TOCropPerspectivePixel rowSum = TOCropPerspectivePixelZero();
+            const uint8_t *pixel = row;
+            for (int i = 0; i < taps; i++, pixel += view.pixelStride) {
+                rowSum = TOCropPerspectivePixelMultiplyAdd(rowSum, TOCropPerspectivePixelLoad(pixel), weightsX[i]);
+            }
+            sum = TOCropPerspectivePixelMultiplyAdd(sum, rowSum, weightsY[j]);
+        }
+        return sum;
+    }
+
+    for (int j = 0; j < taps; j++) {
+        const ptrdiff_t sourceY = y + j;
+        if (sourceY < 0 || sourceY >= (ptrdiff_t)view.height) {
+            continue;
+        }
+        TOCropPerspectivePixel rowSum = TOCropPerspectivePixelZero();
+        for (int i = 0; i < taps; i++) {
+            const ptrdiff_t sourceX = x + i;
+            if (sourceX < 0 || sourceX >= (ptrdiff_t)view.width) {
+                continue;
+            }
+            const uint8_t *pixel = TOCropPixelViewPixelAt(view, (size_t)sourceX, (size_t)sourceY);
+            rowSum = TOCropPerspectivePixelMultiplyAdd(rowSum, TOCropPerspectivePixelLoad(pixel), weightsX[i]);
+        }
+        sum = TOCropPerspectivePixelMultiplyAdd(sum, rowSum, weightsY[j]);
+    }
+    return sum;
+}
+
+#pragma mark - Warping -
+
+// Shared read-only between the threads warping each row of tiles
+typedef struct {
+    TOCropPixelView view;              // The oriented source, or the part of it that's in memory
+    ptrdiff_t viewX;                   // Where the top left pixel of `view` is in the whole oriented image
+    ptrdiff_t viewY;
+    TOCropInterpolation interpolation;
+    double homography[9];              // Maps output pixels to the whole oriented image, both measured from their top left corners
+    TOCropPixelBuffer *destination;
+    TOCropRenderProgress *progress;
+    bool failed;                       // Only touched atomically
+} TOCropPerspectiveJob;
+
+// How a tile's pixels are sampled, once the region of the source it reads is known
+typedef enum {
+    TOCropPerspectiveTileInside,  // Every tap lands inside the source, so none need checking
+    TOCropPerspectiveTileEdge,    // Some taps land outside the source, and are checked one by one
+    TOCropPerspectiveTileOutside  // Nothing lands inside the source, so the tile is cleared
+} TOCropPerspectiveTileCoverage;
+
+// Works out which part of the source a tile reads from, from where its corner pixels land.
+// Within a region where w stays positive, a homography maps straight lines to straight lines,
+// so a convex tile lands on the convex shape between its corners, and nothing lands outside
+// of the box around them.
+static TOCropPerspectiveTileCoverage TOCropPerspectiveCoverageForTile(const TOCropPerspectiveJob *job, size_t left, size_t top,
+                                                                      size_t right, size_t bottom) {
+    const double *m = job->homography;
+    const double xs[2] = {(double)left + 0.5, (double)right - 0.5};
+    const double ys[2] = {(double)top + 0.5, (double)bottom - 0.5};
+
+    double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            const double w = m[6] * xs[i] + m[7] * ys[j] + m[8];
+            if (!(w > 0.0)) {
+                // Part of the tile lands behind the source, so it has no bounded footprint at all
+                return TOCropPerspectiveTileEdge;
+            }
+            const double x = (m[0] * xs[i] + m[1] * ys[j] + m[2]) / w - 0.5;
+            const double y = (m[3] * xs[i] + m[4] * ys[j] + m[5]) / w - 0.5;
+            minX = fmin(minX, x);
+            maxX = fmax(maxX, x);
+            minY = fmin(minY, y);
+            maxY = fmax(maxY, y);
+        }
+    }
+
+    // The first and last pixels of the view any tap of the tile could read
+    const int taps = TOCropPerspectiveTaps(job->interpolation);
+    const double tapOffsetX = (double)(taps / 2 - 1 + job->viewX);
+    const double tapOffsetY = (double)(taps / 2 - 1 + job->viewY);
+    const double firstX = floor(minX) - tapOffsetX, lastX = floor(maxX) - tapOffsetX + (double)(taps - 1);
+    const double firstY = floor(minY) - tapOffsetY, lastY = floor(maxY) - tapOffsetY + (double)(taps - 1);
+    const double width = (double)job->view.width, height = (double)job->view.height;
+
+    if (lastX < 0.0 || lastY < 0.0 || firstX >= width || firstY >= height) {
+        return TOCropPerspectiveTileOutside;
+    }
+    if (firstX >= 0.0 && firstY >= 0.0 && lastX < width && lastY < height) {
+        return TOCropPerspectiveTileInside;
+    }
+    return TOCropPerspectiveTileEdge;
+}
+
+static void TOCropPerspectiveWarpTile(const TOCropPerspectiveJob *job, size_t left, size_t top, size_t right, size_t bottom) {
+    const TOCropPixelBuffer *destination = job->destination;
+    const TOCropPerspectiveTileCoverage coverage = TOCropPerspectiveCoverageForTile(job, left, top, right, bottom);
+    if (coverage == TOCropPerspectiveTileOutside) {
+        for (size_t row = top; row < bottom; row++) {
+            memset(destination->data + row * destination->bytesPerRow + left * TOCropPixelBufferBytesPerPixel, 0,
+                   (right - left) * TOCropPixelBufferBytesPerPixel);
+        }
+        return;
+    }
+
+    const double *m = job->homography;
+    const bool checked = (coverage != TOCropPerspectiveTileInside);
+    const int taps = TOCropPerspectiveTaps(job->interpolation);
+    const ptrdiff_t tapOffsetX = taps / 2 - 1 + job->viewX;
+    const ptrdiff_t tapOffsetY = taps / 2 - 1 + job->viewY;
+
+    for (size_t row = top; row < bottom; row++) {
+        // Every row of every tile starts from its own exact position, so no error builds up across the
+        // image, and each one comes out the same whichever thread it's on. Along the row, the three
+        // sums are each a constant step apart, so only the divide is left for each pixel.
+        const double outputX = (double)left + 0.5;
+        const double outputY = (double)row + 0.5;
+        double sumX = m[0] * outputX + m[1] * outputY + m[2];
+        double sumY = m[3] * outputX + m[4] * outputY + m[5];
+        double sumW = m[6] * outputX + m[7] * outputY + m[8];
+
+        uint8_t *output = destination->data + row * destination->bytesPerRow;
+        for (size_t column = left; column < right; column++, sumX += m[0], sumY += m[3], sumW += m[6]) {
+            uint8_t *pixel = output + column * TOCropPixelBufferBytesPerPixel;
+            if (checked && !(sumW > 0.0)) {
+                memset(pixel, 0, TOCropPixelBufferBytesPerPixel);
+                continue;
+            }
+
+            const double reciprocal = 1.0 / sumW;
+            const double x = sumX * reciprocal - 0.5;
+            const double y = sumY * reciprocal - 0.5;
+            const double floorX = floor(x);
+            const double floorY = floor(y);
+
+            // Anything too far off to be cast to an index is transparent anyway
+            if (checked && !(fabs(floorX) < 1e9 && fabs(floorY) < 1e9)) {
+                memset(pixel, 0, TOCropPixelBufferBytesPerPixel);
+                continue;
+            }
+
+            float weightsX[4], weightsY[4];
+            TOCropPerspectiveWeights(job->interpolation, (float)(x - floorX), weightsX);
+            TOCropPerspectiveWeights(job->interpolation, (float)(y - floorY), weightsY);
+            const TOCropPerspectivePixel sample = TOCropPerspectiveSample(job->view,
+                                                                          (ptrdiff_t)floorX - tapOffsetX,
+                                                                          (ptrdiff_t)floorY - tapOffsetY,
+                                                                          taps, weightsX, weightsY, checked);
+            TOCropPerspectivePixelStore(sample, pixel);
+        }
+    }
+}
+
+static void TOCropPerspectiveWarpTileRow(void *context, size_t tileRow) {
+    TOCropPerspectiveJob *job = (TOCropPerspectiveJob *)context;
+    TOCropRenderProgress *progress = job->progress;
+    if (progress && __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    const TOCropPixelBuffer *destination = job->destination;
+    const size_t top = tileRow * kTOCropPerspectiveTileSize;
+    const size_t bottom = (destination->height - top < kTOCropPerspectiveTileSize) ?
+                              destination->height : top + kTOCropPerspectiveTileSize;
+    for (size_t left = 0; left < destination->width; left += kTOCropPerspectiveTileSize) {
+        const size_t right = (destination->width - left < kTOCropPerspectiveTileSize) ?
+                                 destination->width : left + kTOCropPerspectiveTileSize;
+        TOCropPerspectiveWarpTile(job, left, top, right, bottom);
+    }
+
+    if (progress) {
+        __atomic_fetch_add(&progress->completedRows, bottom - top, __ATOMIC_RELAXED);
+    }
+}
+
+// The first and last source pixels along one axis read by samples landing between `minimum` and
+// `maximum`, clamped to the `length` pixels along that axis. A pixel either side is added for the
+// rounding error in stepping along each row.
+static void TOCropPerspectiveSpan(double minimum, double maximum, int taps, size_t length,
+                                  size_t *start, size_t *count) {
+    const double tapOffset = (double)(taps / 2 - 1);
+    double first = floor(minimum) - tapOffset - 1.0;
+    double last = floor(maximum) - tapOffset + (double)taps;
+    if (first < 0.0) { first = 0.0; }
+    if (last > (double)(length - 1)) { last = (double)(length - 1); }
+
+    // Samples entirely outside of the image read nothing, but the region still needs a pixel in it
+    if (first > last) {
+        first = last = (last < 0.0) ? 0.0 : (double)(length - 1);
+    }
+    *start = (size_t)first;
+    *count = (size_t)(last - first) + 1;
+}
+
+TOCropPixelRect TOCropPerspectiveSourceRect(const double homography[9],
+                                            size_t outputWidth,
+                                            size_t outputHeight,
+                                            TOCropPixelOrientation orientation,
+                                            TOCropInterpolation interpolation,
+                                            size_t width,
+                                            size_t height) {
+    const TOCropPixelRect wholeRect = {0, 0, width, height};
+    if (outputWidth == 0 || outputHeight == 0 || width == 0 || height == 0) {
+        return wholeRect;
+    }
+
+    // As with each tile, the whole output lands inside the box around its corners, as long as w stays positive
+    const double *m = homography;
+    const double xs[2] = {0.5, (double)outputWidth - 0.5};
+    const double ys[2] = {0.5, (double)outputHeight - 0.5};
+    double minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            const double w = m[6] * xs[i] + m[7] * ys[j] + m[8];
+            if (!(w > 0.0)) {
+                return wholeRect;
+            }
+            const double x = (m[0] * xs[i] + m[1] * ys[j] + m[2]) / w - 0.5;
+            const double y = (m[3] * xs[i] + m[4] * ys[j] + m[5]) / w - 0.5;
+            minX = fmin(minX, x);
+            maxX = fmax(maxX, x);
+            minY = fmin(minY, y);
+            maxY = fmax(maxY, y);
+        }
+    }
+    if (!(fabs(minX) < 1e9 && fabs(maxX) < 1e9 && fabs(minY) < 1e9 && fabs(maxY) < 1e9)) {
+        return wholeRect;
+    }
+
+    TOCropPixelRect orientedRect;
+    const int taps = TOCropPerspectiveTaps(interpolation);
+    TOCropPerspectiveSpan(minX, maxX, taps, orientation.transpose ? height : width, &orientedRect.x, &orientedRect.width);
+    TOCropPerspectiveSpan(minY, maxY, taps, orientation.transpose ? width : height, &orientedRect.y, &orientedRect.height);
+    return TOCropPixelOrientationSourceRect(orientation, orientedRect, width, height);
+}
+
+bool TOCropWarpPerspectiveInWindow(const TOCropPixelBuffer *window,
+                                   TOCropPixelRect windowRect,
+                                   size_t width,
+                                   size_t height,
+                                   TOCropPixelOrientation orientation,
+                                   const double homography[9],
+                                   TOCropInterpolation interpolation,
+                                   size_t maximumThreads,
+                                   TOCropRenderProgress *progress,
+                                   TOCropPixelBuffer *destination) {
+    if (window->format != TOCropPixelFormatRGBA8 || destination->format != TOCropPixelFormatRGBA8 ||
+        !TOCropPixelRectFitsInSize(windowRect, width, height) ||
+        window->width != windowRect.width || window->height != windowRect.height ||
+        destination->width == 0 || destination->height == 0) {
+        return false;
+    }
+
+    // The window is oriented on its own, and then offset to where it sits in the whole oriented image
+    const TOCropPixelRect orientedWindowRect = TOCropPixelOrientationOrientedRect(orientation, windowRect, width, height);
+
+    TOCropPerspectiveJob job;
+    job.view = TOCropPixelViewApplyOrientation(TOCropPixelViewMake(window), orientation);
+    job.viewX = (ptrdiff_t)orientedWindowRect.x;
+    job.viewY = (ptrdiff_t)orientedWindowRect.y;
+    job.interpolation = interpolation;
+    memcpy(job.homography, homography, sizeof(job.homography));
+    job.destination = destination;
+    job.progress = progress;
+    job.failed = false;
+
+    const size_t tileRowCount = (destination->height + kTOCropPerspectiveTileSize - 1) / kTOCropPerspectiveTileSize;
+    TOCropParallelFor(tileRowCount, maximumThreads, &job, TOCropPerspectiveWarpTileRow);
+    return !job.failed;
+}
+
+bool TOCropWarpPerspective(const TOCropPixelBuffer *source,
+                           TOCropPixelOrientation orientation,
+                           const double homography[9],
+                           TOCropInterpolation interpolation,
+                           size_t maximumThreads,
+                           TOCropRenderProgress *progress,
+                           TOCropPixelBuffer *destination) {
+    const TOCropPixelRect sourceRect = {0, 0, source->width, source->height};
+    return TOCropWarpPerspectiveInWindow(source, sourceRect, source->width, source->height, orientation,
+                                         homography, interpolation, maximumThreads, progress, destination);
+}
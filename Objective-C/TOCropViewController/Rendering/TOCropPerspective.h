@@ -0,0 +1,95 @@
+//
+//  TOCropPerspective.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropPerspective_h
+#define TOCropPerspective_h
+
+#include "TOCropStraighten.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Flattens a four-sided region of an image (such as a document photographed at an angle) into
+/// a rectangle, by looking up every output pixel in the source through a projective transform.
+///
+/// The output is worked through in 64x64 tiles, and each row of tiles goes to a separate thread.
+/// Before a tile is resampled, the region of the source it reads is worked out from its corners,
+/// so tiles that land completely inside the source skip every bounds check, and tiles that land
+/// completely outside it are cleared without reading anything. Anything outside of the source is
+/// left transparent, with its edges anti-aliased. The result is the same on any number of threads.
+///
+/// Every channel is interpolated the same way, so pixels should have premultiplied alpha (or no alpha).
+/// Only 8-bit RGBA pixels are supported.
+/// @param source The original pixels
+/// @param orientation The orientation applied to the source before it's warped (such as its EXIF orientation and the user's rotation)
+/// @param homography The 3x3 transform (in row major order) that maps a point in the output to where it
+///        lands in the oriented source, with both measured in pixels from their top left corners.
+///        See `TOCropGeometryHomographyForQuad`.
+/// @param interpolation How to blend the source pixels around each output pixel
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @param progress Optionally, where to report progress and check for cancellation
+/// @param destination The buffer to fill, which decides the size of the output
+/// @return false if either buffer isn't 8-bit, the destination is empty, or the render was cancelled
+bool TOCropWarpPerspective(const TOCropPixelBuffer *source,
+                           TOCropPixelOrientation orientation,
+                           const double homography[9],
+                           TOCropInterpolation interpolation,
+                           size_t maximumThreads,
+                           TOCropRenderProgress *progress,
+                           TOCropPixelBuffer *destination);
+
+/// The region of the original image, which is `width` x `height`, that `TOCropWarpPerspective` reads
+/// from to fill an output of `outputWidth` x `outputHeight`. Only this much of the image needs to be
+/// loaded for `TOCropWarpPerspectiveInWindow`.
+/// @return The whole image if part of the output doesn't land in front of the source
+TOCropPixelRect TOCropPerspectiveSourceRect(const double homography[9],
+                                            size_t outputWidth,
+                                            size_t outputHeight,
+                                            TOCropPixelOrientation orientation,
+                                            TOCropInterpolation interpolation,
+                                            size_t width,
+                                            size_t height);
+
+/// The same as `TOCropWarpPerspective`, but with only a window of the original image in memory.
+/// As long as the window covers `TOCropPerspectiveSourceRect`, the result is exactly the same.
+/// @param window The original pixels inside `windowRect`
+/// @param windowRect Where `window` is in the original image
+/// @param width The width of the whole original image
+/// @param height The height of the whole original image
+/// @return false if the window isn't the size of `windowRect`, or for any of the reasons `TOCropWarpPerspective` fails
+bool TOCropWarpPerspectiveInWindow(const TOCropPixelBuffer *window,
+                                   TOCropPixelRect windowRect,
+                                   size_t width,
+                                   size_t height,
+                                   TOCropPixelOrientation orientation,
+                                   const double homography[9],
+                                   TOCropInterpolation interpolation,
+                                   size_t maximumThreads,
+                                   TOCropRenderProgress *progress,
+                                   TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropPerspective_h */
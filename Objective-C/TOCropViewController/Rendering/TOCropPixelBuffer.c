@@ -0,0 +1,97 @@
+//
+//  TOCropPixelBuffer.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropPixelBuffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Row starts are kept on 16-byte boundaries, which is what Core Graphics prefers for
+// bitmaps it wraps, and what vector loads across a row want
+static const size_t kTOCropPixelBufferRowAlignment = 16;
+
+size_t TOCropPixelFormatBytesPerPixel(TOCropPixelFormat format) {
+    switch (format) {
+        case TOCropPixelFormatRGBA8: return 4;
+        case TOCropPixelFormatRGB10A2: return 4;
+        case TOCropPixelFormatRGBA16F: return 8;
+        case TOCropPixelFormatRGBA32F: return 16;
+    }
+    return TOCropPixelBufferBytesPerPixel;
+}
+
+bool TOCropPixelBufferAllocate(TOCropPixelBuffer *buffer, size_t width, size_t height) {
+    return TOCropPixelBufferAllocateWithFormat(buffer, width, height, TOCropPixelFormatRGBA8);
+}
+
+bool TOCropPixelBufferAllocateWithFormat(TOCropPixelBuffer *buffer, size_t width, size_t height,
+                                         TOCropPixelFormat format) {
+    memset(buffer, 0, sizeof(TOCropPixelBuffer));
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    // Guard against the row or total size overflowing on absurd dimensions
+    const size_t bytesPerPixel = TOCropPixelFormatBytesPerPixel(format);
+    if (width > (SIZE_MAX / bytesPerPixel) - kTOCropPixelBufferRowAlignment) {
+        return false;
+    }
+    size_t bytesPerRow = width * bytesPerPixel;
+    bytesPerRow = (bytesPerRow + (kTOCropPixelBufferRowAlignment - 1)) & ~(kTOCropPixelBufferRowAlignment - 1);
+    if (height > SIZE_MAX / bytesPerRow) {
+        return false;
+    }
+
+    uint8_t *data = malloc(bytesPerRow * height);
+    if (data == NULL) {
+        return false;
+    }
+
+    buffer->data = data;
+    buffer->width = width;
+    buffer->height = height;
+    buffer->bytesPerRow = bytesPerRow;
+    buffer->format = format;
+    return true;
+}
+
+void TOCropPixelBufferFree(TOCropPixelBuffer *buffer) {
+    free(buffer->data);
+    memset(buffer, 0, sizeof(TOCropPixelBuffer));
+}
+
+size_t TOCropPixelBufferByteCount(const TOCropPixelBuffer *buffer) {
+    if (buffer->height == 0) {
+        return 0;
+    }
+
+    // The last row doesn't need to include its trailing padding
+    return (buffer->bytesPerRow * (buffer->height - 1)) + (buffer->width * TOCropPixelFormatBytesPerPixel(buffer->format));
+}
+
+bool TOCropPixelRectFitsInSize(TOCropPixelRect rect, size_t width, size_t height) {
+    if (rect.width == 0 || rect.height == 0) {
+        return false;
+    }
+    return rect.x <= width && rect.width <= width - rect.x &&
+           rect.y <= height && rect.height <= height - rect.y;
+}
@@ -0,0 +1,90 @@
+//
+//  TOCropPixelBuffer.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropPixelBuffer_h
+#define TOCropPixelBuffer_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The size of a single pixel in the default format handled by the pixel kernels (8-bit RGBA,
+/// in whichever byte order the source image was stored in).
+#define TOCropPixelBufferBytesPerPixel 4
+
+/// How each pixel is laid out in memory. Copying and rotating only cares about the size of
+/// each pixel, so the values are moved exactly as they are, whatever they represent.
+typedef enum {
+    TOCropPixelFormatRGBA8,   // 8-bit channels, in the source's byte order. The default.
+    TOCropPixelFormatRGB10A2, // 10-bit color channels and a 2-bit alpha, packed into 32 bits with red in the lowest bits
+    TOCropPixelFormatRGBA16F, // Half-precision float channels, as used by extended range and HDR images
+    TOCropPixelFormatRGBA32F  // Single-precision float channels
+} TOCropPixelFormat;
+
+/// The number of bytes each pixel of a format takes up
+size_t TOCropPixelFormatBytesPerPixel(TOCropPixelFormat format);
+
+/// A block of pixels, stored top row first. This is deliberately free of any UIKit or
+/// Core Graphics types so the pixel kernels operating on it stay portable.
+typedef struct {
+    uint8_t *data;            // The first byte of the top row
+    size_t width;             // The width of the buffer, in pixels
+    size_t height;            // The height of the buffer, in pixels
+    size_t bytesPerRow;       // The distance between the start of each row, in bytes
+    TOCropPixelFormat format; // The layout of each pixel
+} TOCropPixelBuffer;
+
+/// An integral region of pixels
+typedef struct {
+    size_t x;
+    size_t y;
+    size_t width;
+    size_t height;
+} TOCropPixelRect;
+
+/// Allocates storage for an 8-bit RGBA buffer of the given size, with rows padded for alignment.
+/// Returns false (and leaves the buffer zeroed) if the allocation failed.
+bool TOCropPixelBufferAllocate(TOCropPixelBuffer *buffer, size_t width, size_t height);
+
+/// Allocates storage for a buffer of the given size and pixel format, with rows padded for alignment.
+/// Returns false (and leaves the buffer zeroed) if the allocation failed.
+bool TOCropPixelBufferAllocateWithFormat(TOCropPixelBuffer *buffer, size_t width, size_t height,
+                                         TOCropPixelFormat format);
+
+/// Releases storage created by `TOCropPixelBufferAllocate` and zeroes the buffer
+void TOCropPixelBufferFree(TOCropPixelBuffer *buffer);
+
+/// The total number of bytes spanned by the buffer's rows
+size_t TOCropPixelBufferByteCount(const TOCropPixelBuffer *buffer);
+
+/// Whether the region lies entirely within a space of the given dimensions
+bool TOCropPixelRectFitsInSize(TOCropPixelRect rect, size_t width, size_t height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropPixelBuffer_h */
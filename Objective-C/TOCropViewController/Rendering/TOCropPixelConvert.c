@@ -0,0 +1,191 @@
+//
+//  TOCropPixelConvert.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropPixelConvert.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma mark - Half Floats -
+
+float TOCropHalfToFloat(uint16_t value) {
+    const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1f;
+    const uint32_t mantissa = value & 0x3ff;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        // Zero and subnormals are a multiple of 2^-24, which a float holds exactly
+        const float magnitude = (float)mantissa * (1.0f / 16777216.0f);
+        return sign ? -magnitude : magnitude;
+    } else if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13); // Infinity, or NaN with its payload
+    } else {
+        bits = sign | ((exponent + (127 - 15)) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t TOCropFloatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude >= 0x7f800000) {
+        if (magnitude == 0x7f800000) {
+            return sign | 0x7c00;
+        }
+        // Keep as much of the NaN's payload as fits, making sure it doesn't collapse into infinity
+        const uint16_t payload = (uint16_t)((magnitude >> 13) & 0x3ff);
+        return sign | 0x7c00 | (payload != 0 ? payload : 0x200);
+    }
+
+    // 65520 is halfway between the largest half (65504) and the next power of two, so it
+    // and everything above it rounds up to infinity
+    if (magnitude >= 0x477ff000) {
+        return sign | 0x7c00;
+    }
+
+    // Below the smallest normal half, values are counted in steps of 2^-24. The scaled value
+    // is exact, and nearbyint rounds ties to even in the default rounding mode.
+    if (magnitude < 0x38800000) {
+        float absolute;
+        memcpy(&absolute, &magnitude, sizeof(absolute));
+        return sign | (uint16_t)nearbyintf(absolute * 16777216.0f);
+    }
+
+    // Drop 13 bits of mantissa, rounding ties to even. A carry out of the mantissa correctly
+    // bumps the exponent, and then the exponent is rebiased from 127 to 15.
+    const uint32_t rounded = magnitude + 0xfff + ((magnitude >> 13) & 1);
+    return sign | (uint16_t)((rounded >> 13) - ((127 - 15) << 10));
+}
+
+#pragma mark - Conversion -
+
+static inline float TOCropUnitFromInteger(uint32_t value, uint32_t maximum) {
+    return (float)value / (float)maximum;
+}
+
+static inline uint32_t TOCropIntegerFromUnit(float value, uint32_t maximum) {
+    if (!(value > 0.0f)) { return 0; } // Also catches NaN
+    if (value >= 1.0f) { return maximum; }
+    return (uint32_t)((value * (float)maximum) + 0.5f);
+}
+
+// Expands one row of pixels into four floats each
+static void TOCropDecodeRow(const uint8_t *row, TOCropPixelFormat format, size_t width, float *output) {
+    for (size_t x = 0; x < width; x++) {
+        float *channels = output + (x * 4);
+        switch (format) {
+            case TOCropPixelFormatRGBA8:
+                for (size_t c = 0; c < 4; c++) {
+                    channels[c] = TOCropUnitFromInteger(row[(x * 4) + c], 255);
+                }
+                break;
+            case TOCropPixelFormatRGB10A2: {
+                uint32_t packed;
+                memcpy(&packed, row + (x * 4), sizeof(packed));
+                channels[0] = TOCropUnitFromInteger(packed & 0x3ff, 1023);
+                channels[1] = TOCropUnitFromInteger((packed >> 10) & 0x3ff, 1023);
+                channels[2] = TOCropUnitFromInteger((packed >> 20) & 0x3ff, 1023);
+                channels[3] = TOCropUnitFromInteger(packed >> 30, 3);
+                break;
+            }
+            case TOCropPixelFormatRGBA16F: {
+                uint16_t halves[4];
+                memcpy(halves, row + (x * 8), sizeof(halves));
+                for (size_t c = 0; c < 4; c++) {
+                    channels[c] = TOCropHalfToFloat(halves[c]);
+                }
+                break;
+            }
+            case TOCropPixelFormatRGBA32F:
+                memcpy(channels, row + (x * 16), 4 * sizeof(float));
+                break;
+        }
+    }
+}
+
+// Packs one row of four floats per pixel into the destination format
+static void TOCropEncodeRow(const float *input, TOCropPixelFormat format, size_t width, uint8_t *row) {
+    for (size_t x = 0; x < width; x++) {
+        const float *channels = input + (x * 4);
+        switch (format) {
+            case TOCropPixelFormatRGBA8:
+                for (size_t c = 0; c < 4; c++) {
+                    row[(x * 4) + c] = (uint8_t)TOCropIntegerFromUnit(channels[c], 255);
+                }
+                break;
+            case TOCropPixelFormatRGB10A2: {
+                const uint32_t packed = (TOCropIntegerFromUnit(channels[0], 1023) |
+                                         (TOCropIntegerFromUnit(channels[1], 1023) << 10) |
+                                         (TOCropIntegerFromUnit(channels[2], 1023) << 20) |
+                                         (TOCropIntegerFromUnit(channels[3], 3) << 30));
+                memcpy(row + (x * 4), &packed, sizeof(packed));
+                break;
+            }
+            case TOCropPixelFormatRGBA16F: {
+                uint16_t halves[4];
+                for (size_t c = 0; c < 4; c++) {
+                    halves[c] = TOCropFloatToHalf(channels[c]);
+                }
+                memcpy(row + (x * 8), halves, sizeof(halves));
+                break;
+            }
+            case TOCropPixelFormatRGBA32F:
+                memcpy(row + (x * 16), channels, 4 * sizeof(float));
+                break;
+        }
+    }
+}
+
+bool TOCropPixelBufferConvert(const TOCropPixelBuffer *source, TOCropPixelBuffer *destination) {
+    if (source->width != destination->width || source->height != destination->height) {
+        return false;
+    }
+
+    const size_t width = source->width;
+    if (source->format == destination->format) {
+        const size_t rowLength = width * TOCropPixelFormatBytesPerPixel(source->format);
+        for (size_t y = 0; y < source->height; y++) {
+            memcpy(destination->data + (y * destination->bytesPerRow), source->data + (y * source->bytesPerRow), rowLength);
+        }
+        return true;
+    }
+
+    // Each row goes through floats, one row at a time
+    float *channels = malloc(width * 4 * sizeof(float));
+    if (channels == NULL) {
+        return false;
+    }
+    for (size_t y = 0; y < source->height; y++) {
+        TOCropDecodeRow(source->data + (y * source->bytesPerRow), source->format, width, channels);
+        TOCropEncodeRow(channels, destination->format, width, destination->data + (y * destination->bytesPerRow));
+    }
+    free(channels);
+    return true;
+}
@@ -0,0 +1,55 @@
+//
+//  TOCropPixelConvert.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropPixelConvert_h
+#define TOCropPixelConvert_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Expands a half-precision float to a float. Every half value (including subnormals,
+/// infinities and NaN payloads) has an exact float equivalent.
+float TOCropHalfToFloat(uint16_t value);
+
+/// Narrows a float to the nearest half-precision float, rounding ties to even. Values too large
+/// for a half become infinity, and NaNs stay NaNs. Halves survive a trip through a float and back
+/// bit for bit.
+uint16_t TOCropFloatToHalf(float value);
+
+/// Converts pixels from one format to another. The pixel kernels move values in their original
+/// format, so this is only needed at the edges of a pipeline, such as handing an HDR crop to
+/// something that expects 32-bit floats.
+///
+/// The 8-bit and 10-bit formats are treated as unsigned values normalized to 0...1, and float
+/// values outside that range are clamped when converting into them. Float formats keep whatever
+/// values they're given. Converting between identical formats copies the pixels unchanged.
+/// @return false if the buffers' dimensions don't match, or working memory couldn't be allocated
+bool TOCropPixelBufferConvert(const TOCropPixelBuffer *source, TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropPixelConvert_h */
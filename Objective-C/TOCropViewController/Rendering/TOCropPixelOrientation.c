@@ -0,0 +1,114 @@
+//
+//  TOCropPixelOrientation.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropPixelOrientation.h"
+
+TOCropPixelOrientation TOCropPixelOrientationIdentity(void) {
+    return (TOCropPixelOrientation){false, false, false};
+}
+
+bool TOCropPixelOrientationIsIdentity(TOCropPixelOrientation orientation) {
+    return !orientation.transpose && !orientation.flipX && !orientation.flipY;
+}
+
+TOCropPixelOrientation TOCropPixelOrientationForEXIFOrientation(int exifOrientation) {
+    switch (exifOrientation) {
+        case 2: return (TOCropPixelOrientation){false, true, false}; // Mirrored horizontally
+        case 3: return (TOCropPixelOrientation){false, true, true};  // Rotated 180
+        case 4: return (TOCropPixelOrientation){false, false, true}; // Mirrored vertically
+        case 5: return (TOCropPixelOrientation){true, false, false}; // Transposed
+        case 6: return (TOCropPixelOrientation){true, true, false};  // Rotated 90 clockwise
+        case 7: return (TOCropPixelOrientation){true, true, true};   // Transversed
+        case 8: return (TOCropPixelOrientation){true, false, true};  // Rotated 90 counter-clockwise
+        default: return TOCropPixelOrientationIdentity();
+    }
+}
+
+TOCropPixelOrientation TOCropPixelOrientationForQuarterTurns(int quarterTurns) {
+    switch (quarterTurns & 3) {
+        case 1: return TOCropPixelOrientationForEXIFOrientation(6);
+        case 2: return TOCropPixelOrientationForEXIFOrientation(3);
+        case 3: return TOCropPixelOrientationForEXIFOrientation(8);
+        default: return TOCropPixelOrientationIdentity();
+    }
+}
+
+TOCropPixelOrientation TOCropPixelOrientationConcat(TOCropPixelOrientation first, TOCropPixelOrientation second) {
+    // Each orientation is a signed permutation matrix taking oriented coordinates to original
+    // ones. Going from the final image back to the original passes through `second` and then
+    // `first`, so multiply them in that order and read the result back out.
+    int m[2][2][2];
+    const TOCropPixelOrientation orientations[2] = {first, second};
+    for (int i = 0; i < 2; i++) {
+        const int sx = orientations[i].flipX ? -1 : 1, sy = orientations[i].flipY ? -1 : 1;
+        m[i][0][0] = orientations[i].transpose ? 0 : sx;
+        m[i][0][1] = orientations[i].transpose ? sy : 0;
+        m[i][1][0] = orientations[i].transpose ? sx : 0;
+        m[i][1][1] = orientations[i].transpose ? 0 : sy;
+    }
+
+    int r[2][2];
+    for (int row = 0; row < 2; row++) {
+        for (int column = 0; column < 2; column++) {
+            r[row][column] = (m[0][row][0] * m[1][0][column]) + (m[0][row][1] * m[1][1][column]);
+        }
+    }
+
+    if (r[0][0] != 0) {
+        return (TOCropPixelOrientation){false, r[0][0] < 0, r[1][1] < 0};
+    }
+    return (TOCropPixelOrientation){true, r[1][0] < 0, r[0][1] < 0};
+}
+
+TOCropPixelRect TOCropPixelOrientationSourceRect(TOCropPixelOrientation orientation, TOCropPixelRect rect,
+                                                 size_t width, size_t height) {
+    const size_t orientedWidth = orientation.transpose ? height : width;
+    const size_t orientedHeight = orientation.transpose ? width : height;
+    if (orientation.flipX) {
+        rect.x = orientedWidth - rect.x - rect.width;
+    }
+    if (orientation.flipY) {
+        rect.y = orientedHeight - rect.y - rect.height;
+    }
+    if (orientation.transpose) {
+        return (TOCropPixelRect){rect.y, rect.x, rect.height, rect.width};
+    }
+    return rect;
+}
+
+TOCropPixelRect TOCropPixelOrientationOrientedRect(TOCropPixelOrientation orientation, TOCropPixelRect sourceRect,
+                                                   size_t width, size_t height) {
+    // The same steps as above, undone in reverse
+    TOCropPixelRect rect = sourceRect;
+    if (orientation.transpose) {
+        rect = (TOCropPixelRect){sourceRect.y, sourceRect.x, sourceRect.height, sourceRect.width};
+    }
+    const size_t orientedWidth = orientation.transpose ? height : width;
+    const size_t orientedHeight = orientation.transpose ? width : height;
+    if (orientation.flipX) {
+        rect.x = orientedWidth - rect.x - rect.width;
+    }
+    if (orientation.flipY) {
+        rect.y = orientedHeight - rect.y - rect.height;
+    }
+    return rect;
+}
@@ -0,0 +1,74 @@
+//
+//  TOCropPixelOrientation.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropPixelOrientation_h
+#define TOCropPixelOrientation_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// One of the eight ways an image can be rotated by quarter turns and mirrored, which covers
+/// every EXIF orientation as well as the rotations applied in the crop view.
+///
+/// It's expressed as where each pixel of the oriented image comes from in the original one:
+/// mirror the oriented image's axes where flagged, and then swap them if it's transposed.
+/// Any sequence of orientations reduces to exactly one of these, so however many are stacked
+/// up (eg, a camera's EXIF orientation and then the user's rotation), the pixels only ever
+/// need to be moved once.
+typedef struct {
+    bool transpose; // Whether the oriented image's rows come from the original's columns
+    bool flipX;     // Whether the oriented image's x axis runs backwards
+    bool flipY;     // Whether the oriented image's y axis runs backwards
+} TOCropPixelOrientation;
+
+/// The orientation that leaves the image as it is
+TOCropPixelOrientation TOCropPixelOrientationIdentity(void);
+
+/// Whether an orientation leaves the image as it is
+bool TOCropPixelOrientationIsIdentity(TOCropPixelOrientation orientation);
+
+/// The orientation needed to display an image with the given EXIF orientation tag (1 to 8).
+/// Invalid values are treated as 1, meaning the image is already upright.
+TOCropPixelOrientation TOCropPixelOrientationForEXIFOrientation(int exifOrientation);
+
+/// The orientation of an image rotated clockwise by a number of quarter turns
+TOCropPixelOrientation TOCropPixelOrientationForQuarterTurns(int quarterTurns);
+
+/// The single orientation equivalent to applying `first`, and then `second` to the result
+TOCropPixelOrientation TOCropPixelOrientationConcat(TOCropPixelOrientation first, TOCropPixelOrientation second);
+
+/// Maps a region of the oriented image back onto the original image, which is `width` x `height`
+TOCropPixelRect TOCropPixelOrientationSourceRect(TOCropPixelOrientation orientation, TOCropPixelRect rect,
+                                                 size_t width, size_t height);
+
+/// Maps a region of the original image, which is `width` x `height`, onto the oriented image
+TOCropPixelRect TOCropPixelOrientationOrientedRect(TOCropPixelOrientation orientation, TOCropPixelRect sourceRect,
+                                                   size_t width, size_t height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropPixelOrientation_h */
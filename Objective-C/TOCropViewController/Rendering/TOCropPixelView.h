@@ -0,0 +1,79 @@
+//
+//  TOCropPixelView.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropPixelView_h
+#define TOCropPixelView_h
+
+#include "TOCropPixelBuffer.h"
+#include "TOCropPixelOrientation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A read-only window onto pixels owned by something else (a pixel buffer, or the
+/// backing store of an image). Cropping or rotating a view only changes where it starts
+/// and which way it steps through memory, so no pixels are copied until the view is
+/// explicitly written out to a buffer.
+///
+/// Either stride may be negative, and they may be swapped (eg, stepping a whole row for
+/// each pixel across), which is how upside-down and quarter-turned views are expressed.
+typedef struct {
+    const uint8_t *origin;    // The first byte of the top left pixel of the view
+    size_t width;             // The width of the view, in pixels
+    size_t height;            // The height of the view, in pixels
+    ptrdiff_t pixelStride;    // The distance in bytes from one pixel to the next one across
+    ptrdiff_t rowStride;      // The distance in bytes from one pixel to the one beneath it
+    TOCropPixelFormat format; // The layout of each pixel, carried over from the buffer
+} TOCropPixelView;
+
+/// A view covering the whole of a buffer, as-is
+TOCropPixelView TOCropPixelViewMake(const TOCropPixelBuffer *buffer);
+
+/// Narrows a view to a region within it. Returns false if the region doesn't fit.
+bool TOCropPixelViewCrop(TOCropPixelView view, TOCropPixelRect rect, TOCropPixelView *croppedView);
+
+/// The same pixels, as they'd appear after rotating clockwise by a number of quarter turns
+TOCropPixelView TOCropPixelViewRotate(TOCropPixelView view, int quarterTurns);
+
+/// The same pixels, as they'd appear with an orientation applied (which may also mirror them)
+TOCropPixelView TOCropPixelViewApplyOrientation(TOCropPixelView view, TOCropPixelOrientation orientation);
+
+/// A pointer to the pixel at the given position in the view
+const uint8_t *TOCropPixelViewPixelAt(TOCropPixelView view, size_t x, size_t y);
+
+/// Whether each row of the view is laid out left to right in memory, top row first,
+/// so it can be handed to something expecting a conventional bitmap without copying
+bool TOCropPixelViewIsContiguous(TOCropPixelView view);
+
+/// Materializes the view into a buffer of exactly the same size, which is the only
+/// point at which its pixels are copied. Views that transpose the underlying pixels
+/// are copied in small tiles to keep both sides of the copy in cache.
+/// Pixels of every format are moved whole, so their values are copied bit for bit.
+/// Returns false if the buffer's dimensions or pixel format don't match the view.
+bool TOCropPixelViewCopyToBuffer(TOCropPixelView view, TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropPixelView_h */
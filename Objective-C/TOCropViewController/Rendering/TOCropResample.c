@@ -0,0 +1,464 @@
+//
+//  TOCropResample.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropResample.h"
+
+#include "TOCropParallel.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_RESAMPLE_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_RESAMPLE_SSE2 1
+#endif
+
+// The fewest output rows worth handing to a thread of their own
+static const size_t kTOCropResampleMinimumBlockRows = 16;
+
+// The number of source rows read at a time when they come from a band source
+static const size_t kTOCropResampleBandRows = 16;
+
+#pragma mark - Pixel Vectors -
+
+// All four channels of one pixel, as floats. Pixels are filtered a whole pixel at a time,
+// so every filter tap is a single vector multiply and add regardless of the byte order.
+#if TOCROP_RESAMPLE_NEON
+typedef float32x4_t TOCropPixelVector;
+
+static inline TOCropPixelVector TOCropPixelVectorZero(void) { return vdupq_n_f32(0.0f); }
+
+static inline TOCropPixelVector TOCropPixelVectorLoadBytes(const uint8_t *pixel) {
+    uint32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const uint16x4_t wide = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed))));
+    return vcvtq_f32_u32(vmovl_u16(wide));
+}
+
+static inline TOCropPixelVector TOCropPixelVectorMultiplyAdd(TOCropPixelVector sum, TOCropPixelVector pixel, float weight) {
+    return vfmaq_n_f32(sum, pixel, weight);
+}
+
+static inline void TOCropPixelVectorStoreBytes(TOCropPixelVector pixel, uint8_t *destination) {
+    const uint32x4_t rounded = vcvtnq_u32_f32(vmaxq_f32(pixel, vdupq_n_f32(0.0f)));
+    const uint16x4_t narrow = vqmovn_u32(rounded);
+    const uint8x8_t bytes = vqmovn_u16(vcombine_u16(narrow, narrow));
+    const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+    memcpy(destination, &packed, sizeof(packed));
+}
+#elif TOCROP_RESAMPLE_SSE2
+typedef __m128 TOCropPixelVector;
+
+static inline TOCropPixelVector TOCropPixelVectorZero(void) { return _mm_setzero_ps(); }
+
+static inline TOCropPixelVector TOCropPixelVectorLoadBytes(const uint8_t *pixel) {
+    int32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+    return _mm_cvtepi32_ps(wide);
+}
+
+static inline TOCropPixelVector TOCropPixelVectorMultiplyAdd(TOCropPixelVector sum, TOCropPixelVector pixel, float weight) {
+    return _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(weight)));
+}
+
+static inline void TOCropPixelVectorStoreBytes(TOCropPixelVector pixel, uint8_t *destination) {
+    const __m128i rounded = _mm_cvtps_epi32(pixel);
+    const __m128i narrow = _mm_packs_epi32(rounded, rounded);
+    const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    memcpy(destination, &packed, sizeof(packed));
+}
+#else
+typedef struct { float channels[TOCropPixelBufferBytesPerPixel]; } TOCropPixelVector;
+
+static inline TOCropPixelVector TOCropPixelVectorZero(void) {
+    TOCropPixelVector vector = {{0.0f}};
+    return vector;
+}
+
+static inline TOCropPixelVector TOCropPixelVectorLoadBytes(const uint8_t *pixel) {
+    TOCropPixelVector vector;
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        vector.channels[c] = pixel[c];
+    }
+    return vector;
+}
+
+static inline TOCropPixelVector TOCropPixelVectorMultiplyAdd(TOCropPixelVector sum, TOCropPixelVector pixel, float weight) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        sum.channels[c] += pixel.channels[c] * weight;
+    }
+    return sum;
+}
+
+static inline void TOCropPixelVectorStoreBytes(TOCropPixelVector pixel, uint8_t *destination) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        const float value = pixel.channels[c];
+        destination[c] = value <= 0.0f ? 0 : (value >= 255.0f ? 255 : (uint8_t)(value + 0.5f));
+    }
+}
+#endif
+
+#pragma mark - Filter Weights -
+
+// How far either side of its center each filter reaches, in source pixels when enlarging
+static double TOCropResampleFilterRadius(TOCropResampleFilter filter) {
+    switch (filter) {
+        case TOCropResampleFilterBox: return 0.5;
+        case TOCropResampleFilterBilinear: return 1.0;
+        case TOCropResampleFilterLanczos: return 3.0;
+    }
+    return 1.0;
+}
+
+static double TOCropSinc(double x) {
+    const double t = x * 3.14159265358979323846; // M_PI isn't part of standard C
+    return sin(t) / t;
+}
+
+// The weight of the source pixel whose center is `x` filter-widths away from the output pixel's
+static double TOCropResampleFilterWeight(TOCropResampleFilter filter, double x) {
+    switch (filter) {
+        case TOCropResampleFilterBox:
+            break; // Weighed by area instead
+        case TOCropResampleFilterBilinear:
+            x = fabs(x);
+            return x < 1.0 ? 1.0 - x : 0.0;
+        case TOCropResampleFilterLanczos:
+            if (x == 0.0) { return 1.0; }
+            return fabs(x) < 3.0 ? TOCropSinc(x) * TOCropSinc(x / 3.0) : 0.0;
+    }
+    return 0.0;
+}
+
+// For every output pixel along one axis, the run of source pixels that contribute to it,
+// and how much each one does. Every run is the same length (zero-weighted at the ends
+// where needed) so the inner loops never branch on it.
+typedef struct {
+    size_t taps;    // The number of source pixels in each run
+    size_t *starts; // The first source pixel of each output pixel's run
+    float *weights; // `taps` weights per output pixel, summing to 1
+} TOCropResampleAxis;
+
+static void TOCropResampleAxisFree(TOCropResampleAxis *axis) {
+    free(axis->starts);
+    free(axis->weights);
+    memset(axis, 0, sizeof(TOCropResampleAxis));
+}
+
+static bool TOCropResampleAxisMake(TOCropResampleAxis *axis, size_t sourceLength, size_t outputLength,
+                                   TOCropResampleFilter filter) {
+    memset(axis, 0, sizeof(TOCropResampleAxis));
+
+    // When shrinking, the filter is stretched to cover every source pixel between output pixels
+    const double scale = (double)sourceLength / (double)outputLength;
+    const double filterScale = scale > 1.0 ? scale : 1.0;
+    const double support = TOCropResampleFilterRadius(filter) * filterScale;
+    size_t taps = (size_t)ceil(support * 2.0) + 1;
+    if (taps > sourceLength) {
+        taps = sourceLength;
+    }
+
+    axis->taps = taps;
+    axis->starts = malloc(outputLength * sizeof(size_t));
+    axis->weights = malloc(outputLength * taps * sizeof(float));
+    if (axis->starts == NULL || axis->weights == NULL) {
+        TOCropResampleAxisFree(axis);
+        return false;
+    }
+
+    for (size_t i = 0; i < outputLength; i++) {
+        const double center = (i + 0.5) * scale;
+        double first = floor(center - support);
+        if (first > (double)(sourceLength - taps)) { first = (double)(sourceLength - taps); }
+        if (first < 0.0) { first = 0.0; }
+        const size_t start = (size_t)first;
+
+        // Edge pixels are renormalized over whatever part of the filter lands inside the image
+        float *weights = axis->weights + (i * taps);
+        double total = 0.0;
+        for (size_t t = 0; t < taps; t++) {
+            double weight;
+            if (filter == TOCropResampleFilterBox) {
+                // How much of the source pixel the output pixel's footprint covers, so partially
+                // covered pixels at either end count for exactly as much as they overlap
+                const double left = fmax((double)(start + t), center - (scale * 0.5));
+                const double right = fmin((double)(start + t + 1), center + (scale * 0.5));
+                weight = right > left ? right - left : 0.0;
+            } else {
+                weight = TOCropResampleFilterWeight(filter, ((start + t) + 0.5 - center) / filterScale);
+            }
+            weights[t] = (float)weight;
+            total += weight;
+        }
+        if (total == 0.0) {
+            // Can't happen with a sane filter, but fall back to the nearest pixel rather than black
+            memset(weights, 0, taps * sizeof(float));
+            size_t nearest = (size_t)center;
+            nearest = nearest < start ? start : (nearest >= start + taps ? start + taps - 1 : nearest);
+            weights[nearest - start] = 1.0f;
+            total = 1.0;
+        }
+        for (size_t t = 0; t < taps; t++) {
+            weights[t] = (float)(weights[t] / total);
+        }
+        axis->starts[i] = start;
+    }
+    return true;
+}
+
+#pragma mark - Resampling -
+
+static void TOCropResampleRowHorizontally(const uint8_t *row, ptrdiff_t pixelStride,
+                                          const TOCropResampleAxis *axis,
+                                          TOCropPixelVector *output, size_t outputWidth) {
+    const size_t taps = axis->taps;
+    for (size_t x = 0; x < outputWidth; x++) {
+        const uint8_t *pixel = row + ((ptrdiff_t)axis->starts[x] * pixelStride);
+        const float *weights = axis->weights + (x * taps);
+        TOCropPixelVector sum = TOCropPixelVectorZero();
+        for (size_t t = 0; t < taps; t++) {
+            sum = TOCropPixelVectorMultiplyAdd(sum, TOCropPixelVectorLoadBytes(pixel), weights[t]);
+            pixel += pixelStride;
+        }
+        output[x] = sum;
+    }
+}
+
+// Everything a block of output rows needs, shared read-only between the threads filling them in
+typedef struct {
+    TOCropPixelView view;              // The source, or just its size when it's read through `bands`
+    const TOCropBandSource *bands;     // If not NULL, where the rows of `bandRect` are read from
+    TOCropPixelRect bandRect;          // The part of the band source's image that `view` covers
+    TOCropResampleAxis horizontal;
+    TOCropResampleAxis vertical;
+    TOCropPixelBuffer *destination;
+    size_t blockRows;
+    bool failed; // Only touched atomically
+} TOCropResampleJob;
+
+// Fills in a run of output rows. Each run keeps its own ring, and refilters the few source rows
+// it shares with the run above, so every output row comes out the same whichever run it's in.
+static bool TOCropResampleRows(const TOCropResampleJob *job, size_t firstRow, size_t rowCount) {
+    const TOCropPixelView view = job->view;
+    const TOCropResampleAxis *vertical = &job->vertical;
+    TOCropPixelBuffer *destination = job->destination;
+    const size_t outputWidth = destination->width;
+
+    // A ring of horizontally filtered rows, one for every row a vertical run spans. Runs only
+    // ever move downwards, so each source row is filtered once, then dropped when no longer needed.
+    const size_t ringRows = vertical->taps;
+    TOCropPixelVector *ring = malloc((ringRows + 1) * outputWidth * sizeof(TOCropPixelVector));
+    if (ring == NULL) {
+        return false;
+    }
+    TOCropPixelVector *accumulator = ring + (ringRows * outputWidth);
+
+    // Source rows read through a band source land in a small buffer of this run's own first
+    TOCropPixelBuffer band = {NULL, 0, 0, 0, TOCropPixelFormatRGBA8};
+    size_t bandFirstRow = 0, bandRowCount = 0;
+    if (job->bands && !TOCropPixelBufferAllocate(&band, view.width, kTOCropResampleBandRows)) {
+        free(ring);
+        return false;
+    }
+
+    bool success = true;
+    size_t nextSourceRow = 0;
+    for (size_t y = firstRow; y < firstRow + rowCount; y++) {
+        const size_t start = vertical->starts[y];
+        const size_t end = start + ringRows;
+        if (nextSourceRow < start) {
+            nextSourceRow = start; // Rows no run covers are never read at all
+        }
+        for (; nextSourceRow < end && success; nextSourceRow++) {
+            const uint8_t *sourceRow;
+            if (job->bands) {
+                if (nextSourceRow >= bandFirstRow + bandRowCount) {
+                    bandFirstRow = nextSourceRow;
+                    bandRowCount = (view.height - bandFirstRow < kTOCropResampleBandRows) ?
+                                       view.height - bandFirstRow : kTOCropResampleBandRows;
+                    band.height = bandRowCount;
+                    const TOCropPixelRect region = {job->bandRect.x, job->bandRect.y + bandFirstRow,
+                                                    job->bandRect.width, bandRowCount};
+                    success = job->bands->read(job->bands->context, region, &band);
+                }
+                sourceRow = band.data + ((nextSourceRow - bandFirstRow) * band.bytesPerRow);
+            } else {
+                sourceRow = TOCropPixelViewPixelAt(view, 0, nextSourceRow);
+            }
+            if (success) {
+                TOCropResampleRowHorizontally(sourceRow, view.pixelStride, &job->horizontal,
+                                              ring + ((nextSourceRow % ringRows) * outputWidth), outputWidth);
+            }
+        }
+        if (!success) {
+            break;
+        }
+
+        const float *weights = vertical->weights + (y * ringRows);
+        for (size_t x = 0; x < outputWidth; x++) {
+            accumulator[x] = TOCropPixelVectorZero();
+        }
+        for (size_t t = 0; t < ringRows; t++) {
+            const float weight = weights[t];
+            if (weight == 0.0f) {
+                continue;
+            }
+            const TOCropPixelVector *row = ring + (((start + t) % ringRows) * outputWidth);
+            for (size_t x = 0; x < outputWidth; x++) {
+                accumulator[x] = TOCropPixelVectorMultiplyAdd(accumulator[x], row[x], weight);
+            }
+        }
+
+        uint8_t *outputRow = destination->data + (y * destination->bytesPerRow);
+        for (size_t x = 0; x < outputWidth; x++) {
+            TOCropPixelVectorStoreBytes(accumulator[x], outputRow + (x * TOCropPixelBufferBytesPerPixel));
+        }
+    }
+
+    TOCropPixelBufferFree(&band);
+    free(ring);
+    return success;
+}
+
+static void TOCropResampleBlock(void *context, size_t block) {
+    TOCropResampleJob *job = (TOCropResampleJob *)context;
+    const size_t firstRow = block * job->blockRows;
+    const size_t outputHeight = job->destination->height;
+    const size_t rowCount = (outputHeight - firstRow < job->blockRows) ? outputHeight - firstRow : job->blockRows;
+    if (!TOCropResampleRows(job, firstRow, rowCount)) {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+    }
+}
+
+static bool TOCropPixelViewResample(TOCropPixelView view, const TOCropBandSource *bands, TOCropPixelRect bandRect,
+                                    TOCropResampleFilter filter, size_t maximumThreads,
+                                    TOCropPixelBuffer *destination) {
+    const size_t outputWidth = destination->width;
+    const size_t outputHeight = destination->height;
+    if (view.width == 0 || view.height == 0 || outputWidth == 0 || outputHeight == 0 ||
+        view.format != TOCropPixelFormatRGBA8 || destination->format != TOCropPixelFormatRGBA8) {
+        return false;
+    }
+
+    TOCropResampleJob job = {view, bands, bandRect, {0, NULL, NULL}, {0, NULL, NULL}, destination, outputHeight, false};
+    if (!TOCropResampleAxisMake(&job.horizontal, view.width, outputWidth, filter)) {
+        return false;
+    }
+    if (!TOCropResampleAxisMake(&job.vertical, view.height, outputHeight, filter)) {
+        TOCropResampleAxisFree(&job.horizontal);
+        return false;
+    }
+
+    // A couple of blocks per thread evens out the load, while keeping blocks tall enough that
+    // refiltering the rows shared with their neighbours stays a small fraction of the work
+    const size_t threads = maximumThreads > 0 ? maximumThreads : TOCropParallelDefaultThreadCount();
+    if (threads > 1) {
+        const size_t blocks = threads * 2;
+        job.blockRows = (outputHeight + blocks - 1) / blocks;
+        if (job.blockRows < kTOCropResampleMinimumBlockRows) {
+            job.blockRows = kTOCropResampleMinimumBlockRows;
+        }
+    }
+    const size_t blockCount = (outputHeight + job.blockRows - 1) / job.blockRows;
+    TOCropParallelFor(blockCount, threads, &job, TOCropResampleBlock);
+
+    TOCropResampleAxisFree(&job.horizontal);
+    TOCropResampleAxisFree(&job.vertical);
+    return !job.failed;
+}
+
+bool TOCropPixelViewResampleToBuffer(TOCropPixelView view, TOCropResampleFilter filter,
+                                     TOCropPixelBuffer *destination) {
+    const TOCropPixelRect noBands = {0, 0, 0, 0};
+    return TOCropPixelViewResample(view, NULL, noBands, filter, 1, destination);
+}
+
+// Resizes the source (whether a view or band source) in its own orientation, where rows are read in
+// the order they sit in memory, and then applies the orientation to the much smaller result
+static bool TOCropResampleOriented(TOCropPixelView view, const TOCropBandSource *bands, TOCropPixelRect bandRect,
+                                   TOCropPixelOrientation orientation, TOCropResampleFilter filter,
+                                   size_t maximumThreads, TOCropPixelBuffer *destination) {
+    if (TOCropPixelOrientationIsIdentity(orientation)) {
+        return TOCropPixelViewResample(view, bands, bandRect, filter, maximumThreads, destination);
+    }
+
+    // The filters are symmetric, so resizing before or after mirroring gives the same result
+    TOCropPixelBuffer resized;
+    const size_t resizedWidth = orientation.transpose ? destination->height : destination->width;
+    const size_t resizedHeight = orientation.transpose ? destination->width : destination->height;
+    if (!TOCropPixelBufferAllocate(&resized, resizedWidth, resizedHeight)) {
+        return false;
+    }
+    const bool success = (TOCropPixelViewResample(view, bands, bandRect, filter, maximumThreads, &resized) &&
+                          TOCropPixelViewCopyToBuffer(TOCropPixelViewApplyOrientation(TOCropPixelViewMake(&resized),
+                                                                                      orientation),
+                                                      destination));
+    TOCropPixelBufferFree(&resized);
+    return success;
+}
+
+bool TOCropResampleRegion(const TOCropPixelBuffer *source,
+                          TOCropPixelRect rect,
+                          TOCropPixelOrientation orientation,
+                          TOCropResampleFilter filter,
+                          size_t maximumThreads,
+                          TOCropPixelBuffer *destination) {
+    const size_t orientedWidth = orientation.transpose ? source->height : source->width;
+    const size_t orientedHeight = orientation.transpose ? source->width : source->height;
+    if (!TOCropPixelRectFitsInSize(rect, orientedWidth, orientedHeight)) {
+        return false;
+    }
+
+    TOCropPixelView sourceView;
+    const TOCropPixelRect sourceRect = TOCropPixelOrientationSourceRect(orientation, rect, source->width, source->height);
+    if (!TOCropPixelViewCrop(TOCropPixelViewMake(source), sourceRect, &sourceView)) {
+        return false;
+    }
+
+    const TOCropPixelRect noBands = {0, 0, 0, 0};
+    return TOCropResampleOriented(sourceView, NULL, noBands, orientation, filter, maximumThreads, destination);
+}
+
+bool TOCropResampleBands(const TOCropBandSource *source,
+                         TOCropPixelRect rect,
+                         TOCropPixelOrientation orientation,
+                         TOCropResampleFilter filter,
+                         size_t maximumThreads,
+                         TOCropPixelBuffer *destination) {
+    const size_t orientedWidth = orientation.transpose ? source->height : source->width;
+    const size_t orientedHeight = orientation.transpose ? source->width : source->height;
+    if (!TOCropPixelRectFitsInSize(rect, orientedWidth, orientedHeight)) {
+        return false;
+    }
+
+    // Only the size of the view is used; every row comes from the band source
+    const TOCropPixelRect sourceRect = TOCropPixelOrientationSourceRect(orientation, rect, source->width, source->height);
+    const TOCropPixelView sourceView = {NULL, sourceRect.width, sourceRect.height,
+                                        TOCropPixelBufferBytesPerPixel, 0, TOCropPixelFormatRGBA8};
+    return TOCropResampleOriented(sourceView, source, sourceRect, orientation, filter, maximumThreads, destination);
+}
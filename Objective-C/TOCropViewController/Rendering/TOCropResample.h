@@ -0,0 +1,98 @@
+//
+//  TOCropResample.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropResample_h
+#define TOCropResample_h
+
+#include "TOCropBandRenderer.h"
+#include "TOCropPixelView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The filter used to weigh up source pixels when resizing
+typedef enum {
+    TOCropResampleFilterBox,      // An average of every source pixel covered. Fastest, but blocky when enlarging.
+    TOCropResampleFilterBilinear, // A tent filter. Smooth, and good enough for most downscaling.
+    TOCropResampleFilterLanczos   // A three-lobed windowed sinc. Sharpest, at around twice the cost of bilinear.
+} TOCropResampleFilter;
+
+/// Resizes a view to fill a buffer of a different size, in a single pass over the pixels.
+///
+/// The filter is separable: each source row is filtered horizontally down to the output
+/// width exactly once, and kept in a small ring of rows only until every output row that
+/// needs it has been filtered vertically. No source rows outside the view are read, and the
+/// working memory is proportional to the width of the output rather than the source.
+///
+/// Every channel is filtered the same way, so pixels should have premultiplied alpha (or no alpha).
+/// Only 8-bit RGBA pixels are supported.
+/// @return false if either size is zero, either isn't 8-bit, or the working memory couldn't be allocated
+bool TOCropPixelViewResampleToBuffer(TOCropPixelView view, TOCropResampleFilter filter,
+                                     TOCropPixelBuffer *destination);
+
+/// Crops a region out of a buffer with an orientation applied, and resizes it to fill
+/// `destination`, without ever materializing the crop at full size.
+///
+/// The region is resized in the buffer's own orientation, where rows are contiguous in memory,
+/// and the orientation is applied to the much smaller result afterwards. The output is split into
+/// blocks of rows that are filtered on separate threads, with exactly the same result as one thread.
+/// @param source The original pixels
+/// @param rect The region to crop, in the coordinate space of the oriented image
+/// @param orientation The orientation applied to the source (such as its EXIF orientation and the user's rotation)
+/// @param filter The resampling filter to use
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @param destination A buffer the size of the final image
+/// @return false if `rect` doesn't fit inside the oriented image, or memory couldn't be allocated
+bool TOCropResampleRegion(const TOCropPixelBuffer *source,
+                          TOCropPixelRect rect,
+                          TOCropPixelOrientation orientation,
+                          TOCropResampleFilter filter,
+                          size_t maximumThreads,
+                          TOCropPixelBuffer *destination);
+
+/// The same as `TOCropResampleRegion`, but reading the original image a few rows at a time
+/// through `source`, so neither the original nor the crop is ever held in memory at full size.
+///
+/// Each block of output rows reads just the source rows it needs, in small bands of its own,
+/// so `source` is called from several threads at once, and must be safe to call that way.
+/// The working memory is a few rows of the crop's width for each thread, plus the rows of the output.
+/// The result is exactly the same as `TOCropResampleRegion` with the whole image in memory.
+/// @param source The original image, which must be read as 8-bit pixels
+/// @param rect The region to crop, in the coordinate space of the oriented image
+/// @param orientation The orientation applied to the source (such as its EXIF orientation and the user's rotation)
+/// @param filter The resampling filter to use
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @param destination A buffer the size of the final image
+/// @return false if `rect` doesn't fit inside the oriented image, memory couldn't be allocated, or `source` failed
+bool TOCropResampleBands(const TOCropBandSource *source,
+                         TOCropPixelRect rect,
+                         TOCropPixelOrientation orientation,
+                         TOCropResampleFilter filter,
+                         size_t maximumThreads,
+                         TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropResample_h */
@@ -0,0 +1,49 @@
+//
+//  TOCropRotation.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropRotation.h"
+
+#include "TOCropPixelView.h"
+
+int TOCropQuarterTurnsForAngle(long angle) {
+    long turns = (angle / 90) % 4;
+    return (int)((turns + 4) % 4);
+}
+
+TOCropPixelRect TOCropUnrotatedRectForRotatedRect(TOCropPixelRect rect, int quarterTurns,
+                                                  size_t width, size_t height) {
+    return TOCropPixelOrientationSourceRect(TOCropPixelOrientationForQuarterTurns(quarterTurns), rect, width, height);
+}
+
+bool TOCropPixelBufferCopyRotatedRect(const TOCropPixelBuffer *source,
+                                      TOCropPixelRect rect,
+                                      int quarterTurns,
+                                      TOCropPixelBuffer *destination) {
+    // Turn the whole image first, so the region can be taken in the rotated space
+    TOCropPixelView rotatedView = TOCropPixelViewRotate(TOCropPixelViewMake(source), quarterTurns);
+
+    TOCropPixelView regionView;
+    if (!TOCropPixelViewCrop(rotatedView, rect, &regionView)) {
+        return false;
+    }
+    return TOCropPixelViewCopyToBuffer(regionView, destination);
+}
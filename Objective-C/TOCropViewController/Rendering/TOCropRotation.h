@@ -0,0 +1,69 @@
+//
+//  TOCropRotation.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropRotation_h
+#define TOCropRotation_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Converts a rotation angle in degrees (a multiple of 90, in either direction) to the
+/// equivalent number of clockwise quarter turns, from 0 to 3.
+int TOCropQuarterTurnsForAngle(long angle);
+
+/// Maps a region of an image rotated clockwise by a number of quarter turns back onto
+/// the region of the unrotated image holding the same pixels.
+///
+/// @param rect The region, in the coordinate space of the rotated image
+/// @param quarterTurns The number of clockwise 90-degree turns applied to the image
+/// @param width The width of the unrotated image
+/// @param height The height of the unrotated image
+TOCropPixelRect TOCropUnrotatedRectForRotatedRect(TOCropPixelRect rect, int quarterTurns,
+                                                  size_t width, size_t height);
+
+/// Copies a region out of an image rotated clockwise by a number of quarter turns,
+/// reading only the source pixels that land inside that region.
+///
+/// Rather than resampling, every output pixel is fetched straight from its source
+/// location. Turns that transpose the image are walked in small square tiles, so that
+/// the source rows being read down and the destination rows being written across both
+/// stay in cache.
+///
+/// @param source The unrotated image
+/// @param rect The region to copy, in the coordinate space of the rotated image (ie, the
+///             crop frames reported by `TOCropView`)
+/// @param quarterTurns The number of clockwise 90-degree turns applied to the image
+/// @param destination A buffer exactly the size of `rect` to write the pixels into
+/// @return false if `rect` extends outside of the rotated image, or doesn't match `destination`
+bool TOCropPixelBufferCopyRotatedRect(const TOCropPixelBuffer *source,
+                                      TOCropPixelRect rect,
+                                      int quarterTurns,
+                                      TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropRotation_h */
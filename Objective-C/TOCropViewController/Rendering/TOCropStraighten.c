@@ -0,0 +1,374 @@
+//
+//  TOCropStraighten.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropStraighten.h"
+
+#include "TOCropParallel.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define TOCROP_STRAIGHTEN_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOCROP_STRAIGHTEN_SSE2 1
+#endif
+
+// The number of output rows each thread takes at a time
+static const size_t kTOCropStraightenBlockRows = 32;
+
+#pragma mark - Pixel Vectors -
+
+// All four channels of one pixel, as floats, so each tap is a single vector multiply and add
+#if TOCROP_STRAIGHTEN_NEON
+typedef float32x4_t TOCropStraightenPixel;
+
+static inline TOCropStraightenPixel TOCropStraightenPixelZero(void) { return vdupq_n_f32(0.0f); }
+
+static inline TOCropStraightenPixel TOCropStraightenPixelLoad(const uint8_t *pixel) {
+    uint32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const uint16x4_t wide = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed))));
+    return vcvtq_f32_u32(vmovl_u16(wide));
+}
+
+static inline TOCropStraightenPixel TOCropStraightenPixelMultiplyAdd(TOCropStraightenPixel sum,
+                                                                    TOCropStraightenPixel pixel, float weight) {
+    return vfmaq_n_f32(sum, pixel, weight);
+}
+
+static inline void TOCropStraightenPixelStore(TOCropStraightenPixel pixel, uint8_t *destination) {
+    const uint32x4_t rounded = vcvtnq_u32_f32(vmaxq_f32(pixel, vdupq_n_f32(0.0f)));
+    const uint16x4_t narrow = vqmovn_u32(rounded);
+    const uint8x8_t bytes = vqmovn_u16(vcombine_u16(narrow, narrow));
+    const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+    memcpy(destination, &packed, sizeof(packed));
+}
+#elif TOCROP_STRAIGHTEN_SSE2
+typedef __m128 TOCropStraightenPixel;
+
+static inline TOCropStraightenPixel TOCropStraightenPixelZero(void) { return _mm_setzero_ps(); }
+
+static inline TOCropStraightenPixel TOCropStraightenPixelLoad(const uint8_t *pixel) {
+    int32_t packed;
+    memcpy(&packed, pixel, sizeof(packed));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+    return _mm_cvtepi32_ps(wide);
+}
+
+static inline TOCropStraightenPixel TOCropStraightenPixelMultiplyAdd(TOCropStraightenPixel sum,
+                                                                    TOCropStraightenPixel pixel, float weight) {
+    return _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(weight)));
+}
+
+static inline void TOCropStraightenPixelStore(TOCropStraightenPixel pixel, uint8_t *destination) {
+    const __m128i rounded = _mm_cvtps_epi32(pixel);
+    const __m128i narrow = _mm_packs_epi32(rounded, rounded);
+    const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    memcpy(destination, &packed, sizeof(packed));
+}
+#else
+typedef struct { float channels[TOCropPixelBufferBytesPerPixel]; } TOCropStraightenPixel;
+
+static inline TOCropStraightenPixel TOCropStraightenPixelZero(void) {
+    TOCropStraightenPixel pixel = {{0.0f}};
+    return pixel;
+}
+
+static inline TOCropStraightenPixel TOCropStraightenPixelLoad(const uint8_t *bytes) {
+    TOCropStraightenPixel pixel;
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        pixel.channels[c] = bytes[c];
+    }
+    return pixel;
+}
+
+static inline TOCropStraightenPixel TOCropStraightenPixelMultiplyAdd(TOCropStraightenPixel sum,
+                                                                    TOCropStraightenPixel pixel, float weight) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        sum.channels[c] += pixel.channels[c] * weight;
+    }
+    return sum;
+}
+
+static inline void TOCropStraightenPixelStore(TOCropStraightenPixel pixel, uint8_t *destination) {
+    for (size_t c = 0; c < TOCropPixelBufferBytesPerPixel; c++) {
+        const float value = pixel.channels[c];
+        destination[c] = value <= 0.0f ? 0 : (value >= 255.0f ? 255 : (uint8_t)(value + 0.5f));
+    }
+}
+#endif
+
+#pragma mark - Interpolation -
+
+// The number of source pixels along each axis that contribute to one output pixel
+static inline int TOCropInterpolationTaps(TOCropInterpolation interpolation) {
+    return interpolation == TOCropInterpolationBicubic ? 4 : 2;
+}
+
+// The weights of each tap along one axis, for a sample `t` (0...1) of the way past the first
+// pixel at or before it. The bicubic spline is Catmull-Rom, which passes through every pixel.
+static inline void TOCropInterpolationWeights(TOCropInterpolation interpolation, float t, float *weights) {
+    if (interpolation == TOCropInterpolationBicubic) {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        weights[0] = -0.5f * t3 + t2 - 0.5f * t;
+        weights[1] = 1.5f * t3 - 2.5f * t2 + 1.0f;
+        weights[2] = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+        weights[3] = 0.5f * t3 - 0.5f * t2;
+    } else {
+        weights[0] = 1.0f - t;
+        weights[1] = t;
+    }
+}
+
+// Blends a square of `taps` x `taps` source pixels, the top left one of which is at (`x`, `y`).
+// Pixels outside of the view count as transparent, which anti-aliases the straightened image's edges.
+static inline TOCropStraightenPixel TOCropStraightenSample(TOCropPixelView view, ptrdiff_t x, ptrdiff_t y, int taps,
+                                                           const float *weightsX, const float *weightsY) {
+    TOCropStraightenPixel sum = TOCropStraightenPixelZero();
+    const bool inside = (x >= 0 && y >= 0 && x + taps <= (ptrdiff_t)view.width && y + taps <= (ptrdiff_t)view.height);
+    if (inside) {
+        // Nearly every pixel lands well inside the source, so none of its taps need checking
+        const uint8_t *row = view.origin + x * view.pixelStride + y * view.rowStride;
+        for (int j = 0; j < taps; j++, row += view.rowStride) {
+            TOCropStraightenPixel rowSum = TOCropStraightenPixelZero();
+            const uint8_t *pixel = row;
+            for (int i = 0; i < taps; i++, pixel += view.pixelStride) {
+                rowSum = TOCropStraightenPixelMultiplyAdd(rowSum, TOCropStraightenPixelLoad(pixel), weightsX[i]);
+            }
+            sum = TOCropStraightenPixelMultiplyAdd(sum, rowSum, weightsY[j]);
+        }
+        return sum;
+    }
+
+    for (int j = 0; j < taps; j++) {
+        const ptrdiff_t sourceY = y + j;
+        if (sourceY < 0 || sourceY >= (ptrdiff_t)view.height) {
+            continue;
+        }
+        TOCropStraightenPixel rowSum = TOCropStraightenPixelZero();
+        for (int i = 0; i < taps; i++) {
+            const ptrdiff_t sourceX = x + i;
+            if (sourceX < 0 || sourceX >= (ptrdiff_t)view.width) {
+                continue;
+            }
+            const uint8_t *pixel = TOCropPixelViewPixelAt(view, (size_t)sourceX, (size_t)sourceY);
+            rowSum = TOCropStraightenPixelMultiplyAdd(rowSum, TOCropStraightenPixelLoad(pixel), weightsX[i]);
+        }
+        sum = TOCropStraightenPixelMultiplyAdd(sum, rowSum, weightsY[j]);
+    }
+    return sum;
+}
+
+#pragma mark - Straightening -
+
+// Shared read-only between the threads resampling each block
+typedef struct {
+    TOCropPixelView view;              // The oriented source, or the part of it that's in memory
+    ptrdiff_t viewX;                   // Where the top left pixel of `view` is in the whole oriented image
+    ptrdiff_t viewY;
+    TOCropInterpolation interpolation;
+    double originX;                    // Where the center of the first output pixel lands in the whole
+    double originY;                    // oriented image, measured from the center of its top left pixel
+    double acrossX;                    // How far through the view each step across an output row moves
+    double acrossY;
+    double downX;                      // How far through the view each step down to the next output row moves
+    double downY;
+    TOCropPixelBuffer *destination;
+    TOCropRenderProgress *progress;
+    bool failed;                       // Only touched atomically
+} TOCropStraightenJob;
+
+// Works out where each output pixel of `rect` lands in an oriented image that's `width` x `height`,
+// by rotating it back the other way about the center
+static void TOCropStraightenJobSetGeometry(TOCropStraightenJob *job, TOCropPixelRect rect, double angle,
+                                           size_t width, size_t height) {
+    const double radians = angle * (3.14159265358979323846 / 180.0); // M_PI isn't part of standard C
+    const double cosine = cos(radians);
+    const double sine = sin(radians);
+    const double centerX = (double)width * 0.5;
+    const double centerY = (double)height * 0.5;
+    const double offsetX = (double)rect.x + 0.5 - centerX;
+    const double offsetY = (double)rect.y + 0.5 - centerY;
+
+    job->originX = centerX + cosine * offsetX + sine * offsetY - 0.5;
+    job->originY = centerY - sine * offsetX + cosine * offsetY - 0.5;
+    job->acrossX = cosine;
+    job->acrossY = -sine;
+    job->downX = sine;
+    job->downY = cosine;
+}
+
+// The first and last source pixels along one axis read by samples landing between `minimum` and
+// `maximum`, clamped to the `length` pixels along that axis. A pixel either side is added for the
+// rounding error in stepping along each row.
+static void TOCropStraightenSpan(double minimum, double maximum, int taps, size_t length,
+                                 size_t *start, size_t *count) {
+    const double tapOffset = (double)(taps / 2 - 1);
+    double first = floor(minimum) - tapOffset - 1.0;
+    double last = floor(maximum) - tapOffset + (double)taps;
+    if (first < 0.0) { first = 0.0; }
+    if (last > (double)(length - 1)) { last = (double)(length - 1); }
+
+    // Samples entirely outside of the image read nothing, but the region still needs a pixel in it
+    if (first > last) {
+        first = last = (last < 0.0) ? 0.0 : (double)(length - 1);
+    }
+    *start = (size_t)first;
+    *count = (size_t)(last - first) + 1;
+}
+
+static void TOCropStraightenBlock(void *context, size_t block) {
+    TOCropStraightenJob *job = (TOCropStraightenJob *)context;
+    TOCropRenderProgress *progress = job->progress;
+    if (progress && __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    const TOCropPixelBuffer *destination = job->destination;
+    const size_t firstRow = block * kTOCropStraightenBlockRows;
+    const size_t rowCount = (destination->height - firstRow < kTOCropStraightenBlockRows) ?
+                                destination->height - firstRow : kTOCropStraightenBlockRows;
+    const int taps = TOCropInterpolationTaps(job->interpolation);
+    const ptrdiff_t tapOffsetX = taps / 2 - 1 + job->viewX;
+    const ptrdiff_t tapOffsetY = taps / 2 - 1 + job->viewY;
+
+    for (size_t row = firstRow; row < firstRow + rowCount; row++) {
+        // Every row starts from its own exact position, so no error builds up down the image,
+        // and each one comes out the same whichever thread it's on
+        double x = job->originX + job->downX * (double)row;
+        double y = job->originY + job->downY * (double)row;
+        uint8_t *output = destination->data + row * destination->bytesPerRow;
+        for (size_t column = 0; column < destination->width; column++) {
+            const double floorX = floor(x);
+            const double floorY = floor(y);
+            float weightsX[4], weightsY[4];
+            TOCropInterpolationWeights(job->interpolation, (float)(x - floorX), weightsX);
+            TOCropInterpolationWeights(job->interpolation, (float)(y - floorY), weightsY);
+            const TOCropStraightenPixel pixel = TOCropStraightenSample(job->view,
+                                                                       (ptrdiff_t)floorX - tapOffsetX,
+                                                                       (ptrdiff_t)floorY - tapOffsetY,
+                                                                       taps, weightsX, weightsY);
+            TOCropStraightenPixelStore(pixel, output + column * TOCropPixelBufferBytesPerPixel);
+            x += job->acrossX;
+            y += job->acrossY;
+        }
+    }
+
+    if (progress) {
+        __atomic_fetch_add(&progress->completedRows, rowCount, __ATOMIC_RELAXED);
+    }
+}
+
+TOCropPixelRect TOCropStraightenSourceRect(TOCropPixelRect rect,
+                                           TOCropPixelOrientation orientation,
+                                           double angle,
+                                           TOCropInterpolation interpolation,
+                                           size_t width,
+                                           size_t height) {
+    const size_t orientedWidth = orientation.transpose ? height : width;
+    const size_t orientedHeight = orientation.transpose ? width : height;
+    if (!TOCropPixelRectFitsInSize(rect, orientedWidth, orientedHeight) || rect.width == 0 || rect.height == 0) {
+        return (TOCropPixelRect){0, 0, width, height};
+    }
+
+    // Every row is a straight line through the source, so the samples all land inside the corners' bounds
+    TOCropStraightenJob job;
+    TOCropStraightenJobSetGeometry(&job, rect, angle, orientedWidth, orientedHeight);
+    const double lastColumn = (double)(rect.width - 1);
+    const double lastRow = (double)(rect.height - 1);
+    const double cornersX[4] = {job.originX, job.originX + job.acrossX * lastColumn,
+                                job.originX + job.downX * lastRow, job.originX + job.acrossX * lastColumn + job.downX * lastRow};
+    const double cornersY[4] = {job.originY, job.originY + job.acrossY * lastColumn,
+                                job.originY + job.downY * lastRow, job.originY + job.acrossY * lastColumn + job.downY * lastRow};
+    double minimumX = cornersX[0], maximumX = cornersX[0];
+    double minimumY = cornersY[0], maximumY = cornersY[0];
+    for (int i = 1; i < 4; i++) {
+        minimumX = fmin(minimumX, cornersX[i]);
+        maximumX = fmax(maximumX, cornersX[i]);
+        minimumY = fmin(minimumY, cornersY[i]);
+        maximumY = fmax(maximumY, cornersY[i]);
+    }
+
+    TOCropPixelRect orientedRect;
+    const int taps = TOCropInterpolationTaps(interpolation);
+    TOCropStraightenSpan(minimumX, maximumX, taps, orientedWidth, &orientedRect.x, &orientedRect.width);
+    TOCropStraightenSpan(minimumY, maximumY, taps, orientedHeight, &orientedRect.y, &orientedRect.height);
+    return TOCropPixelOrientationSourceRect(orientation, orientedRect, width, height);
+}
+
+bool TOCropStraightenRegionInWindow(const TOCropPixelBuffer *window,
+                                    TOCropPixelRect windowRect,
+                                    size_t width,
+                                    size_t height,
+                                    TOCropPixelRect rect,
+                                    TOCropPixelOrientation orientation,
+                                    double angle,
+                                    TOCropInterpolation interpolation,
+                                    size_t maximumThreads,
+                                    TOCropRenderProgress *progress,
+                                    TOCropPixelBuffer *destination) {
+    const size_t orientedWidth = orientation.transpose ? height : width;
+    const size_t orientedHeight = orientation.transpose ? width : height;
+    if (window->format != TOCropPixelFormatRGBA8 || destination->format != TOCropPixelFormatRGBA8 ||
+        !TOCropPixelRectFitsInSize(windowRect, width, height) ||
+        window->width != windowRect.width || window->height != windowRect.height ||
+        !TOCropPixelRectFitsInSize(rect, orientedWidth, orientedHeight) ||
+        destination->width != rect.width || destination->height != rect.height || rect.width == 0 || rect.height == 0) {
+        return false;
+    }
+
+    // The window is oriented on its own, and then offset to where it sits in the whole oriented image
+    const TOCropPixelRect orientedWindowRect = TOCropPixelOrientationOrientedRect(orientation, windowRect, width, height);
+
+    TOCropStraightenJob job;
+    job.view = TOCropPixelViewApplyOrientation(TOCropPixelViewMake(window), orientation);
+    job.viewX = (ptrdiff_t)orientedWindowRect.x;
+    job.viewY = (ptrdiff_t)orientedWindowRect.y;
+    job.interpolation = interpolation;
+    TOCropStraightenJobSetGeometry(&job, rect, angle, orientedWidth, orientedHeight);
+    job.destination = destination;
+    job.progress = progress;
+    job.failed = false;
+
+    const size_t blockCount = (rect.height + kTOCropStraightenBlockRows - 1) / kTOCropStraightenBlockRows;
+    TOCropParallelFor(blockCount, maximumThreads, &job, TOCropStraightenBlock);
+    return !job.failed;
+}
+
+bool TOCropStraightenRegion(const TOCropPixelBuffer *source,
+                            TOCropPixelRect rect,
+                            TOCropPixelOrientation orientation,
+                            double angle,
+                            TOCropInterpolation interpolation,
+                            size_t maximumThreads,
+                            TOCropRenderProgress *progress,
+                            TOCropPixelBuffer *destination) {
+    const TOCropPixelRect sourceRect = {0, 0, source->width, source->height};
+    return TOCropStraightenRegionInWindow(source, sourceRect, source->width, source->height, rect, orientation,
+                                          angle, interpolation, maximumThreads, progress, destination);
+}
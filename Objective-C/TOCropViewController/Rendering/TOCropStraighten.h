@@ -0,0 +1,103 @@
+//
+//  TOCropStraighten.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropStraighten_h
+#define TOCropStraighten_h
+
+#include "TOCropPixelView.h"
+#include "TOCropTiledRenderer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// How the colors between source pixels are worked out when the image is rotated by a fraction of a turn
+typedef enum {
+    TOCropInterpolationBilinear, // A blend of the 2x2 nearest pixels. Fast, but slightly softens the image.
+    TOCropInterpolationBicubic   // A Catmull-Rom spline through the 4x4 nearest pixels. Keeps edges sharp, at around three times the cost.
+} TOCropInterpolation;
+
+/// Copies a region out of an image that's been oriented, and then rotated about its center by a
+/// straightening angle, resampling every output pixel from wherever it lands in the source.
+///
+/// The straightened image is the same size as the oriented one, and shares its center, so crop
+/// frames carry over from one to the other unchanged. Anything outside of the rotated image is
+/// left transparent, with its edges anti-aliased.
+///
+/// Only the output pixels are visited: each output row steps along a straight line through the
+/// source, so nothing is allocated, and no source pixels away from the region are read. Blocks of
+/// rows are resampled on separate threads, with exactly the same result as one thread.
+///
+/// Every channel is interpolated the same way, so pixels should have premultiplied alpha (or no alpha).
+/// Only 8-bit RGBA pixels are supported.
+/// @param source The original pixels
+/// @param rect The region to copy, in the coordinate space of the straightened image
+/// @param orientation The orientation applied to the source before it's straightened (such as its EXIF orientation and the user's rotation)
+/// @param angle The straightening angle, in degrees. Positive angles rotate the image clockwise.
+/// @param interpolation How to blend the source pixels around each output pixel
+/// @param maximumThreads The most threads to spread the work over, or 0 for one per core
+/// @param progress Optionally, where to report progress and check for cancellation
+/// @param destination A buffer exactly the size of `rect`
+/// @return false if `rect` doesn't fit inside the straightened image, either buffer isn't 8-bit, or the render was cancelled
+bool TOCropStraightenRegion(const TOCropPixelBuffer *source,
+                            TOCropPixelRect rect,
+                            TOCropPixelOrientation orientation,
+                            double angle,
+                            TOCropInterpolation interpolation,
+                            size_t maximumThreads,
+                            TOCropRenderProgress *progress,
+                            TOCropPixelBuffer *destination);
+
+/// The region of the original image, which is `width` x `height`, that `TOCropStraightenRegion` reads
+/// from to fill `rect`. Only this much of the image needs to be loaded for `TOCropStraightenRegionInWindow`.
+/// @return The whole image if `rect` doesn't fit inside the straightened image
+TOCropPixelRect TOCropStraightenSourceRect(TOCropPixelRect rect,
+                                           TOCropPixelOrientation orientation,
+                                           double angle,
+                                           TOCropInterpolation interpolation,
+                                           size_t width,
+                                           size_t height);
+
+/// The same as `TOCropStraightenRegion`, but with only a window of the original image in memory.
+/// As long as the window covers `TOCropStraightenSourceRect`, the result is exactly the same.
+/// @param window The original pixels inside `windowRect`
+/// @param windowRect Where `window` is in the original image
+/// @param width The width of the whole original image
+/// @param height The height of the whole original image
+/// @return false if the window isn't the size of `windowRect`, or for any of the reasons `TOCropStraightenRegion` fails
+bool TOCropStraightenRegionInWindow(const TOCropPixelBuffer *window,
+                                    TOCropPixelRect windowRect,
+                                    size_t width,
+                                    size_t height,
+                                    TOCropPixelRect rect,
+                                    TOCropPixelOrientation orientation,
+                                    double angle,
+                                    TOCropInterpolation interpolation,
+                                    size_t maximumThreads,
+                                    TOCropRenderProgress *progress,
+                                    TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropStraighten_h */
@@ -0,0 +1,278 @@
+//
+//  TOCropTileCache.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropTileCache.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#pragma mark - Tile Grids -
+
+size_t TOCropTileGridColumns(TOCropTileGrid grid) {
+    if (grid.tileSize == 0) { return 0; }
+    return (grid.width + grid.tileSize - 1) / grid.tileSize;
+}
+
+size_t TOCropTileGridRows(TOCropTileGrid grid) {
+    if (grid.tileSize == 0) { return 0; }
+    return (grid.height + grid.tileSize - 1) / grid.tileSize;
+}
+
+TOCropPixelRect TOCropTileGridRectForTile(TOCropTileGrid grid, size_t x, size_t y) {
+    TOCropPixelRect rect = {0};
+    rect.x = x * grid.tileSize;
+    rect.y = y * grid.tileSize;
+    if (rect.x >= grid.width || rect.y >= grid.height) { return (TOCropPixelRect){0}; }
+
+    // The last row and column are cut short by the edges of the level
+    rect.width = (grid.width - rect.x < grid.tileSize) ? grid.width - rect.x : grid.tileSize;
+    rect.height = (grid.height - rect.y < grid.tileSize) ? grid.height - rect.y : grid.tileSize;
+    return rect;
+}
+
+// The tiles spanning [start, start + length) along one axis of `size` pixels,
+// as the range [*minimum, *maximum). Returns false if none do.
+static bool TOCropTileSpan(double start, double length, size_t size, size_t tileSize,
+                           size_t *minimum, size_t *maximum) {
+    double end = start + length;
+    if (!(length > 0.0) || end <= 0.0 || start >= (double)size) { return false; }
+    if (start < 0.0) { start = 0.0; }
+    if (end > (double)size) { end = (double)size; }
+
+    *minimum = (size_t)start / tileSize;
+    *maximum = ((size_t)ceil(end) + tileSize - 1) / tileSize;
+    return *maximum > *minimum;
+}
+
+TOCropTileRange TOCropTileRangeForRect(TOCropTileGrid grid, double x, double y, double width, double height) {
+    TOCropTileRange range = {0};
+    if (grid.tileSize == 0) { return range; }
+
+    size_t minX, maxX, minY, maxY;
+    if (!TOCropTileSpan(x, width, grid.width, grid.tileSize, &minX, &maxX) ||
+        !TOCropTileSpan(y, height, grid.height, grid.tileSize, &minY, &maxY)) {
+        return range;
+    }
+
+    range.minX = minX; range.maxX = maxX;
+    range.minY = minY; range.maxY = maxY;
+    return range;
+}
+
+TOCropTileRange TOCropTileRangeExtend(TOCropTileGrid grid, TOCropTileRange range, int directionX, int directionY) {
+    if (range.minX >= range.maxX || range.minY >= range.maxY) { return range; }
+
+    if (directionX < 0 && range.minX > 0) { range.minX--; }
+    if (directionX > 0 && range.maxX < TOCropTileGridColumns(grid)) { range.maxX++; }
+    if (directionY < 0 && range.minY > 0) { range.minY--; }
+    if (directionY > 0 && range.maxY < TOCropTileGridRows(grid)) { range.maxY++; }
+    return range;
+}
+
+bool TOCropTileRangeContainsTile(TOCropTileRange range, size_t x, size_t y) {
+    return x >= range.minX && x < range.maxX && y >= range.minY && y < range.maxY;
+}
+
+#pragma mark - Tile Cache -
+
+typedef struct TOCropTileEntry TOCropTileEntry;
+struct TOCropTileEntry {
+    TOCropTileKey key;
+    void *tile;
+    size_t byteCount;
+    TOCropTileEntry *nextInBucket;  // The next entry whose key hashes to the same bucket
+    TOCropTileEntry *newer;         // Towards the most recently used entry
+    TOCropTileEntry *older;         // Towards the least recently used entry
+};
+
+struct TOCropTileCache {
+    TOCropTileEntry **buckets;          // Entries chained by the hash of their key
+    size_t bucketCount;                 // Always a power of two
+    size_t count;                       // The number of entries
+    size_t byteCount;                   // The total byte count of every entry
+    size_t byteBudget;                  // The most bytes to hold before evicting
+    TOCropTileEntry *newest;            // The most recently used entry
+    TOCropTileEntry *oldest;            // The least recently used entry, and the next to be evicted
+    TOCropTileReleaseFunction release;  // Called with each tile as it leaves the cache
+};
+
+static const size_t kTOCropTileCacheInitialBuckets = 64;
+
+static inline bool TOCropTileKeyEqual(TOCropTileKey a, TOCropTileKey b) {
+    return a.level == b.level && a.x == b.x && a.y == b.y;
+}
+
+static inline size_t TOCropTileKeyHash(TOCropTileKey key) {
+    // Tiles that are neighbours on screen differ by one in x or y,
+    // so mix the bits well enough that they spread across the buckets
+    uint64_t hash = ((uint64_t)key.level << 48) ^ ((uint64_t)key.y << 24) ^ key.x;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+static TOCropTileEntry **TOCropTileCacheFindSlot(const TOCropTileCache *cache, TOCropTileKey key) {
+    TOCropTileEntry **slot = &cache->buckets[TOCropTileKeyHash(key) & (cache->bucketCount - 1)];
+    while (*slot && !TOCropTileKeyEqual((*slot)->key, key)) {
+        slot = &(*slot)->nextInBucket;
+    }
+    return slot;
+}
+
+static void TOCropTileCacheUnlink(TOCropTileCache *cache, TOCropTileEntry *entry) {
+    if (entry->newer) { entry->newer->older = entry->older; } else { cache->newest = entry->older; }
+    if (entry->older) { entry->older->newer = entry->newer; } else { cache->oldest = entry->newer; }
+    entry->newer = entry->older = NULL;
+}
+
+static void TOCropTileCacheLinkAsNewest(TOCropTileCache *cache, TOCropTileEntry *entry) {
+    entry->older = cache->newest;
+    entry->newer = NULL;
+    if (cache->newest) { cache->newest->newer = entry; }
+    cache->newest = entry;
+    if (cache->oldest == NULL) { cache->oldest = entry; }
+}
+
+// Takes an entry out of the cache entirely, and releases its tile
+static void TOCropTileCacheRemoveEntry(TOCropTileCache *cache, TOCropTileEntry *entry) {
+    TOCropTileEntry **slot = TOCropTileCacheFindSlot(cache, entry->key);
+    *slot = entry->nextInBucket;
+    TOCropTileCacheUnlink(cache, entry);
+
+    cache->count--;
+    cache->byteCount -= entry->byteCount;
+    if (cache->release) { cache->release(entry->tile); }
+    free(entry);
+}
+
+static void TOCropTileCacheEvictToFit(TOCropTileCache *cache, size_t byteBudget) {
+    while (cache->oldest && cache->byteCount > byteBudget) {
+        TOCropTileCacheRemoveEntry(cache, cache->oldest);
+    }
+}
+
+// Doubles the number of buckets once they're holding more than one entry each on average
+static void TOCropTileCacheGrowIfNeeded(TOCropTileCache *cache) {
+    if (cache->count < cache->bucketCount) { return; }
+
+    const size_t bucketCount = cache->bucketCount * 2;
+    TOCropTileEntry **buckets = calloc(bucketCount, sizeof(TOCropTileEntry *));
+    if (buckets == NULL) { return; } // Longer chains are slower, but still correct
+
+    for (size_t i = 0; i < cache->bucketCount; i++) {
+        TOCropTileEntry *entry = cache->buckets[i];
+        while (entry) {
+            TOCropTileEntry *next = entry->nextInBucket;
+            const size_t index = TOCropTileKeyHash(entry->key) & (bucketCount - 1);
+            entry->nextInBucket = buckets[index];
+            buckets[index] = entry;
+            entry = next;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucketCount = bucketCount;
+}
+
+TOCropTileCache *TOCropTileCacheCreate(size_t byteBudget, TOCropTileReleaseFunction release) {
+    TOCropTileCache *cache = calloc(1, sizeof(TOCropTileCache));
+    if (cache == NULL) { return NULL; }
+
+    cache->buckets = calloc(kTOCropTileCacheInitialBuckets, sizeof(TOCropTileEntry *));
+    if (cache->buckets == NULL) {
+        free(cache);
+        return NULL;
+    }
+
+    cache->bucketCount = kTOCropTileCacheInitialBuckets;
+    cache->byteBudget = byteBudget;
+    cache->release = release;
+    return cache;
+}
+
+void TOCropTileCacheDestroy(TOCropTileCache *cache) {
+    if (cache == NULL) { return; }
+    TOCropTileCacheRemoveAll(cache);
+    free(cache->buckets);
+    free(cache);
+}
+
+void *TOCropTileCacheGet(TOCropTileCache *cache, TOCropTileKey key) {
+    TOCropTileEntry *entry = *TOCropTileCacheFindSlot(cache, key);
+    if (entry == NULL) { return NULL; }
+
+    if (entry != cache->newest) {
+        TOCropTileCacheUnlink(cache, entry);
+        TOCropTileCacheLinkAsNewest(cache, entry);
+    }
+    return entry->tile;
+}
+
+bool TOCropTileCacheInsert(TOCropTileCache *cache, TOCropTileKey key, void *tile, size_t byteCount) {
+    TOCropTileEntry *existing = *TOCropTileCacheFindSlot(cache, key);
+    if (existing) { TOCropTileCacheRemoveEntry(cache, existing); }
+
+    // A tile that could never fit would only empty the cache on its way through
+    TOCropTileEntry *entry = (byteCount <= cache->byteBudget) ? calloc(1, sizeof(TOCropTileEntry)) : NULL;
+    if (entry == NULL) {
+        if (cache->release) { cache->release(tile); }
+        return false;
+    }
+
+    // Make room first, so the new tile is never the one evicted
+    TOCropTileCacheEvictToFit(cache, cache->byteBudget - byteCount);
+    TOCropTileCacheGrowIfNeeded(cache);
+
+    entry->key = key;
+    entry->tile = tile;
+    entry->byteCount = byteCount;
+
+    TOCropTileEntry **slot = TOCropTileCacheFindSlot(cache, key);
+    *slot = entry;
+    TOCropTileCacheLinkAsNewest(cache, entry);
+
+    cache->count++;
+    cache->byteCount += byteCount;
+    return true;
+}
+
+void TOCropTileCacheSetByteBudget(TOCropTileCache *cache, size_t byteBudget) {
+    cache->byteBudget = byteBudget;
+    TOCropTileCacheEvictToFit(cache, byteBudget);
+}
+
+void TOCropTileCacheRemoveAll(TOCropTileCache *cache) {
+    while (cache->oldest) {
+        TOCropTileCacheRemoveEntry(cache, cache->oldest);
+    }
+}
+
+size_t TOCropTileCacheCount(const TOCropTileCache *cache) {
+    return cache->count;
+}
+
+size_t TOCropTileCacheByteCount(const TOCropTileCache *cache) {
+    return cache->byteCount;
+}
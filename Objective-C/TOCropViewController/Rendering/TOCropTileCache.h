@@ -0,0 +1,128 @@
+//
+//  TOCropTileCache.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TOCropTileCache_h
+#define TOCropTileCache_h
+
+#include "TOCropPixelBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Tile Grids -
+
+/// How one level of an image is split into square tiles
+typedef struct {
+    size_t width;    // The width of the level, in pixels
+    size_t height;   // The height of the level, in pixels
+    size_t tileSize; // The width and height of each tile, in pixels. Tiles in the last row and column may be smaller.
+} TOCropTileGrid;
+
+/// A rectangle of tiles, from `minX`, `minY` up to (but not including) `maxX`, `maxY`
+typedef struct {
+    size_t minX;
+    size_t minY;
+    size_t maxX;
+    size_t maxY;
+} TOCropTileRange;
+
+/// The number of tiles across each row of a grid
+size_t TOCropTileGridColumns(TOCropTileGrid grid);
+
+/// The number of rows of tiles in a grid
+size_t TOCropTileGridRows(TOCropTileGrid grid);
+
+/// The region of the level covered by a tile
+TOCropPixelRect TOCropTileGridRectForTile(TOCropTileGrid grid, size_t x, size_t y);
+
+/// The tiles that any part of a rectangle overlaps, clamped to the grid.
+/// The range is empty (`minX == maxX`) when the rectangle is empty or entirely outside the grid.
+/// @param grid The grid of tiles
+/// @param x The left edge of the rectangle, in pixels of the level
+/// @param y The top edge of the rectangle, in pixels of the level
+/// @param width The width of the rectangle, in pixels
+/// @param height The height of the rectangle, in pixels
+TOCropTileRange TOCropTileRangeForRect(TOCropTileGrid grid, double x, double y, double width, double height);
+
+/// Grows a range by one tile on the sides it's moving towards, so the tiles about to
+/// come into view can be prepared ahead of time.
+/// @param directionX Negative when moving left, positive when moving right, or 0
+/// @param directionY Negative when moving up, positive when moving down, or 0
+TOCropTileRange TOCropTileRangeExtend(TOCropTileGrid grid, TOCropTileRange range, int directionX, int directionY);
+
+/// Whether a tile is inside a range
+bool TOCropTileRangeContainsTile(TOCropTileRange range, size_t x, size_t y);
+
+#pragma mark - Tile Cache -
+
+/// Identifies a tile by the level of the image it's from, and its column and row in that level
+typedef struct {
+    uint32_t level;
+    uint32_t x;
+    uint32_t y;
+} TOCropTileKey;
+
+/// Called with a tile once the cache no longer holds it
+typedef void (*TOCropTileReleaseFunction)(void *tile);
+
+/// A set of tiles that keeps the most recently used ones, up to a limit on their size in bytes.
+/// The cache doesn't know what a tile is: it holds an opaque pointer and a byte count for each.
+/// It isn't thread-safe, so it should only be used from one thread (such as the main thread).
+typedef struct TOCropTileCache TOCropTileCache;
+
+/// Creates an empty cache
+/// @param byteBudget The most bytes of tiles to hold at once
+/// @param release Called with each tile as it's evicted, replaced or removed
+/// @return The cache, or NULL if it couldn't be allocated
+TOCropTileCache *TOCropTileCacheCreate(size_t byteBudget, TOCropTileReleaseFunction release);
+
+/// Releases every tile, and the cache itself
+void TOCropTileCacheDestroy(TOCropTileCache *cache);
+
+/// Looks up a tile, and marks it as the most recently used one
+/// @return The tile, or NULL if it isn't in the cache
+void *TOCropTileCacheGet(TOCropTileCache *cache, TOCropTileKey key);
+
+/// Adds a tile, replacing any with the same key, then evicts the least recently used
+/// tiles until the cache fits inside its budget again. The cache takes ownership of the tile.
+/// @return false if the tile alone is larger than the budget (in which case it's released straight away)
+bool TOCropTileCacheInsert(TOCropTileCache *cache, TOCropTileKey key, void *tile, size_t byteCount);
+
+/// Changes the byte budget, evicting the least recently used tiles to fit
+void TOCropTileCacheSetByteBudget(TOCropTileCache *cache, size_t byteBudget);
+
+/// Releases every tile in the cache
+void TOCropTileCacheRemoveAll(TOCropTileCache *cache);
+
+/// The number of tiles in the cache
+size_t TOCropTileCacheCount(const TOCropTileCache *cache);
+
+/// The total byte count of every tile in the cache
+size_t TOCropTileCacheByteCount(const TOCropTileCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropTileCache_h */
@@ -0,0 +1,85 @@
+//
+//  TOCropTiledRenderer.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "TOCropTiledRenderer.h"
+
+#include "TOCropCircularMask.h"
+#include "TOCropParallel.h"
+
+// Shared read-only between the threads rendering each block
+typedef struct {
+    TOCropPixelView view;
+    TOCropTiledRenderOptions options;
+    TOCropPixelBuffer *destination;
+    bool failed; // Only touched atomically
+} TOCropTiledRenderJob;
+
+static void TOCropRenderBlock(void *context, size_t block) {
+    TOCropTiledRenderJob *job = (TOCropTiledRenderJob *)context;
+    TOCropRenderProgress *progress = job->options.progress;
+    if (progress && __atomic_load_n(&progress->cancelled, __ATOMIC_RELAXED)) {
+        // Blocks already underway finish, but the rest are skipped
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    const size_t height = job->view.height;
+    const size_t firstRow = block * TOCropTiledRendererBlockRows;
+    const size_t rowCount = (height - firstRow < TOCropTiledRendererBlockRows) ? height - firstRow
+                                                                                : TOCropTiledRendererBlockRows;
+    bool success;
+    if (job->options.circular) {
+        // The circle spans the whole output, so each block masks its rows against all of it
+        success = TOCropPixelViewCopyRowsToBufferWithCircularMask(job->view, job->options.alphaMask,
+                                                                  firstRow, rowCount, job->destination);
+    } else {
+        TOCropPixelView blockView;
+        TOCropPixelBuffer blockBuffer = *job->destination;
+        blockBuffer.data += firstRow * blockBuffer.bytesPerRow;
+        blockBuffer.height = rowCount;
+        success = (TOCropPixelViewCrop(job->view, (TOCropPixelRect){0, firstRow, job->view.width, rowCount}, &blockView) &&
+                   TOCropPixelViewCopyToBuffer(blockView, &blockBuffer));
+    }
+    if (!success) {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+    } else if (progress) {
+        __atomic_fetch_add(&progress->completedRows, rowCount, __ATOMIC_RELAXED);
+    }
+}
+
+bool TOCropRenderRegion(const TOCropPixelBuffer *source,
+                        TOCropPixelRect rect,
+                        TOCropPixelOrientation orientation,
+                        TOCropTiledRenderOptions options,
+                        TOCropPixelBuffer *destination) {
+    TOCropTiledRenderJob job = {{NULL, 0, 0, 0, 0, TOCropPixelFormatRGBA8}, options, destination, false};
+    const TOCropPixelView orientedView = TOCropPixelViewApplyOrientation(TOCropPixelViewMake(source), orientation);
+    if (!TOCropPixelViewCrop(orientedView, rect, &job.view) ||
+        destination->width != rect.width || destination->height != rect.height ||
+        destination->format != source->format) {
+        return false;
+    }
+
+    const size_t blockCount = (rect.height + TOCropTiledRendererBlockRows - 1) / TOCropTiledRendererBlockRows;
+    TOCropParallelFor(blockCount, options.maximumThreads, &job, TOCropRenderBlock);
+    return !job.failed;
+}
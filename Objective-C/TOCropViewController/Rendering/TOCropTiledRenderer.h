@@ -0,0 +1,74 @@
+//
+//  TOCropTiledRenderer.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TOCropTiledRenderer_h
+#define TOCropTiledRenderer_h
+
+#include "TOCropPixelView.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Shared with a render while it runs, so it can be watched and cancelled from another thread.
+/// Both fields are only ever read and written atomically.
+typedef struct {
+    bool cancelled;       // Set to stop the render before it starts any more blocks
+    size_t completedRows; // The number of output rows rendered so far
+} TOCropRenderProgress;
+
+/// How the output of a render is shaped and spread across threads
+typedef struct {
+    bool circular;                  // Whether to clip the output to the circle (or ellipse) inscribed in it
+    uint32_t alphaMask;             // For circular renders, bits to set in every pixel (see `TOCropPixelViewCopyToBufferWithCircularMask`)
+    size_t maximumThreads;          // The most threads to spread the work over, or 0 for one per core
+    TOCropRenderProgress *progress; // Optionally, where to report progress and check for cancellation
+} TOCropTiledRenderOptions;
+
+/// The number of output rows in each block of work. This is a multiple of the tile size used
+/// when transposing, so blocks never split a tile, and it keeps each block's output to a few
+/// hundred kilobytes on large images so there are plenty of blocks to share out.
+#define TOCropTiledRendererBlockRows 64
+
+/// Copies a region out of an image with an orientation applied, and optionally clips it to a circle,
+/// with the output split into blocks of rows that are rendered on separate threads at once.
+///
+/// Every block writes to its own rows of `destination`, and each output pixel is worked out
+/// exactly as it would be on a single thread, so the result is identical however many threads
+/// are used, and in whatever order the blocks finish.
+/// @param source The original pixels
+/// @param rect The region to copy, in the coordinate space of the oriented image
+/// @param orientation The orientation applied to the source (such as its EXIF orientation and the user's rotation)
+/// @param options Whether to clip to a circle, and how many threads to use
+/// @param destination A buffer exactly the size of `rect`, in the same format as `source`
+/// @return false if `rect` doesn't fit inside the oriented image, the buffers don't match, or the render was cancelled
+bool TOCropRenderRegion(const TOCropPixelBuffer *source,
+                        TOCropPixelRect rect,
+                        TOCropPixelOrientation orientation,
+                        TOCropTiledRenderOptions options,
+                        TOCropPixelBuffer *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropTiledRenderer_h */
@@ -0,0 +1,65 @@
+//
+//  TOCropToolbarIconAtlas.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropToolbarIconAtlas.h"
+
+#include <string.h>
+
+const TOCropToolbarIconAtlas *TOCropToolbarIconAtlasForScale(double scale) {
+    // Scaling an icon down looks better than scaling one up
+    for (size_t i = 0; i < TOCropToolbarIconAtlasScaleCount; i++) {
+        if (TOCropToolbarIconAtlases[i].scale >= scale) {
+            return &TOCropToolbarIconAtlases[i];
+        }
+    }
+    return &TOCropToolbarIconAtlases[TOCropToolbarIconAtlasScaleCount - 1];
+}
+
+bool TOCropToolbarIconAtlasUnpack(const TOCropToolbarIconAtlas *atlas, uint8_t *coverage) {
+    // Each run starts with a header byte. 0 to 127 means that many bytes plus one are copied as they
+    // are, and -1 to -127 means the next byte is repeated one more time than the header is negative.
+    const uint8_t *packed = atlas->packedCoverage;
+    const uint8_t *packedEnd = packed + atlas->packedLength;
+    const size_t length = (size_t)atlas->width * atlas->height;
+    size_t written = 0;
+    while (packed < packedEnd) {
+        const int8_t header = (int8_t)*packed++;
+        if (header >= 0) {
+            const size_t count = (size_t)header + 1;
+            if (count > (size_t)(packedEnd - packed) || count > length - written) {
+                return false;
+            }
+            memcpy(coverage + written, packed, count);
+            packed += count;
+            written += count;
+        } else if (header != -128) {
+            const size_t count = (size_t)(1 - header);
+            if (packed == packedEnd || count > length - written) {
+                return false;
+            }
+            memset(coverage + written, *packed++, count);
+            written += count;
+        }
+    }
+    return written == length;
+}
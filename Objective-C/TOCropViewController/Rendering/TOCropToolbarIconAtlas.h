@@ -0,0 +1,87 @@
+//
+//  TOCropToolbarIconAtlas.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TOCropToolbarIconAtlas_h
+#define TOCropToolbarIconAtlas_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The icons drawn in the toolbar, in the order they're packed into the atlas
+typedef enum {
+    TOCropToolbarIconDone,
+    TOCropToolbarIconCancel,
+    TOCropToolbarIconRotateCounterclockwise,
+    TOCropToolbarIconRotateClockwise,
+    TOCropToolbarIconReset,
+    TOCropToolbarIconClamp,
+    TOCropToolbarIconCount
+} TOCropToolbarIcon;
+
+/// The number of screen scales (1x, 2x and 3x) the icons are rasterized at
+#define TOCropToolbarIconAtlasScaleCount 3
+
+/// Where one icon sits in an atlas, in pixels from the top left
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+} TOCropToolbarIconSlice;
+
+/// Every toolbar icon, rasterized ahead of time at one screen scale and packed into a single image.
+/// The icons are white, so only how much of each pixel they cover is stored, compressed with PackBits.
+typedef struct {
+    unsigned int scale;                                    // The screen scale the icons were rasterized at
+    uint16_t width;                                        // The width of the atlas, in pixels
+    uint16_t height;                                       // The height of the atlas, in pixels
+    const uint8_t *packedCoverage;                         // One byte per pixel (255 being fully covered), top row first, compressed
+    size_t packedLength;                                   // The length of `packedCoverage`, in bytes
+    TOCropToolbarIconSlice slices[TOCropToolbarIconCount]; // Where each icon is
+    float pointWidths[TOCropToolbarIconCount];             // The size of each icon, in points
+    float pointHeights[TOCropToolbarIconCount];
+} TOCropToolbarIconAtlas;
+
+/// The atlases at 1x, 2x and 3x, generated from the icons' vector paths by
+/// `Tools/TOCropIconAtlasGenerator.c` (into TOCropToolbarIconAtlas.c)
+extern const TOCropToolbarIconAtlas TOCropToolbarIconAtlases[TOCropToolbarIconAtlasScaleCount];
+
+/// Picks the atlas rasterized closest to a screen scale, preferring the larger one when between two
+const TOCropToolbarIconAtlas *TOCropToolbarIconAtlasForScale(double scale);
+
+/// Decompresses an atlas's coverage.
+/// @param atlas The atlas to decompress
+/// @param coverage A buffer of `width` * `height` bytes, to be filled in a row at a time with no padding
+/// @return false if the packed data is malformed, or doesn't exactly fill the atlas
+bool TOCropToolbarIconAtlasUnpack(const TOCropToolbarIconAtlas *atlas, uint8_t *coverage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOCropToolbarIconAtlas_h */
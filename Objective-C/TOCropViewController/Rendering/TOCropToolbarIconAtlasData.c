@@ -0,0 +1,494 @@
+//
+//  TOCropToolbarIconAtlasData.c
+//
+//  Generated by Tools/TOCropIconAtlasGenerator.c from Tools/TOCropToolbarIconPaths.c.
+//  Don't edit this file by hand. Change the paths and run the generator again instead.
+//
+
+#include "TOCropToolbarIconAtlas.h"
+
+// 40x57 pixels, packed from 2280 bytes
+static const uint8_t kTOCropToolbarIconAtlas1x[] = {
+    0xf9, 0x00, 0x01, 0x24, 0xb7, 0xf0, 0x00, 0x01, 0xaf, 0x20, 0xf0, 0x00, 0x03, 0x08, 0x83, 0xf7,
+    0xff, 0xf0, 0x00, 0x03, 0xff, 0xf7, 0x7c, 0x08, 0xf3, 0x00, 0x01, 0x50, 0xdf, 0xfe, 0xff, 0x03,
+    0x80, 0x68, 0x38, 0x04, 0xf8, 0x00, 0x03, 0x04, 0x38, 0x68, 0x80, 0xfe, 0xff, 0x01, 0xdb, 0x48,
+    0xf4, 0x00, 0x01, 0x50, 0xdf, 0xfe, 0xff, 0x05, 0x80, 0x9b, 0xd3, 0xe7, 0x6c, 0x04, 0xfc, 0x00,
+    0x05, 0x04, 0x6c, 0xe7, 0xd3, 0x9b, 0x80, 0xfe, 0xff, 0x01, 0xdb, 0x48, 0xf3, 0x00, 0x03, 0x08,
+    0x83, 0xf7, 0xff, 0xfe, 0x00, 0x03, 0x30, 0xbf, 0xab, 0x04, 0xfe, 0x00, 0x03, 0x04, 0xab, 0xbf,
+    0x30, 0xfe, 0x00, 0x03, 0xff, 0xf7, 0x7c, 0x08, 0xf0, 0x00, 0x01, 0x24, 0xb7, 0xfd, 0x00, 0x02,
+    0x04, 0xaf, 0x93, 0xfe, 0x00, 0x02, 0x93, 0xaf, 0x04, 0xfd, 0x00, 0x01, 0xaf, 0x20, 0xe7, 0x00,
+    0x06, 0x10, 0xeb, 0x24, 0x00, 0x24, 0xeb, 0x10, 0xdf, 0x00, 0x04, 0x87, 0x83, 0x00, 0x83, 0x87,
+    0xde, 0x00, 0x04, 0x40, 0xc3, 0x00, 0xc3, 0x40, 0xee, 0x00, 0xf5, 0xff, 0xfd, 0x00, 0x04, 0x18,
+    0xeb, 0x00, 0xeb, 0x18, 0xfd, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xfc, 0x00, 0x02, 0xff,
+    0x00, 0xff, 0xfc, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00,
+    0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00,
+    0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00,
+    0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00,
+    0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00, 0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xfe, 0x00,
+    0xf5, 0xff, 0xf4, 0x00, 0xf5, 0xff, 0xcd, 0x00, 0x07, 0x4c, 0xa3, 0xdf, 0xff, 0xff, 0xdb, 0xa3,
+    0x4c, 0xfa, 0x00, 0x01, 0x78, 0x18, 0xf7, 0x00, 0x01, 0x18, 0x60, 0xf8, 0x00, 0x01, 0x2c, 0xc7,
+    0xf9, 0xff, 0x01, 0xc7, 0x2c, 0xfd, 0x00, 0x03, 0x78, 0xff, 0xd7, 0x18, 0xf9, 0x00, 0x03, 0x18,
+    0xd7, 0xff, 0x78, 0xfa, 0x00, 0x0d, 0x3c, 0xf3, 0xff, 0xe7, 0x74, 0x2c, 0x04, 0x04, 0x2c, 0x74,
+    0xe7, 0xff, 0xf3, 0x3c, 0xfe, 0x00, 0x04, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfb, 0x00, 0x04, 0x18,
+    0xd7, 0xff, 0xd7, 0x18, 0xfb, 0x00, 0x04, 0x2c, 0xf3, 0xff, 0xa3, 0x0c, 0xfb, 0x00, 0x04, 0x0c,
+    0xa3, 0xff, 0xf3, 0x2c, 0xfe, 0x00, 0x04, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfd, 0x00, 0x04, 0x18,
+    0xd7, 0xff, 0xd7, 0x18, 0xfa, 0x00, 0x02, 0xc7, 0xff, 0xa3, 0xf7, 0x00, 0x02, 0xa3, 0xff, 0xc7,
+    0xfd, 0x00, 0x0b, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0x00, 0x00, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfa,
+    0x00, 0x03, 0x4c, 0xff, 0xe7, 0x0c, 0xf7, 0x00, 0x03, 0x0c, 0xe7, 0xff, 0x4c, 0xfd, 0x00, 0x09,
+    0x18, 0xd7, 0xff, 0xd7, 0x18, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xf9, 0x00, 0x02, 0xa3, 0xff, 0x74,
+    0xf5, 0x00, 0x02, 0x74, 0xff, 0xa3, 0xfc, 0x00, 0x07, 0x18, 0xd7, 0xff, 0xdb, 0xdb, 0xff, 0xd7,
+    0x18, 0xf8, 0x00, 0x02, 0xdf, 0xff, 0x2c, 0xf5, 0x00, 0x02, 0x2c, 0xff, 0xdb, 0xfb, 0x00, 0x05,
+    0x18, 0xdb, 0xff, 0xff, 0xdb, 0x18, 0xf7, 0x00, 0x02, 0xff, 0xff, 0x04, 0xf5, 0x00, 0x02, 0x04,
+    0xff, 0xff, 0xfb, 0x00, 0x05, 0x18, 0xdb, 0xff, 0xff, 0xdb, 0x18, 0xfb, 0x00, 0x00, 0x97, 0xf9,
+    0xff, 0x00, 0x97, 0xf8, 0x00, 0x02, 0x04, 0xff, 0xff, 0xfc, 0x00, 0x07, 0x18, 0xd7, 0xff, 0xdb,
+    0xdb, 0xff, 0xd7, 0x18, 0xfc, 0x00, 0x01, 0x04, 0xbb, 0xfb, 0xff, 0x01, 0xbb, 0x04, 0xf8, 0x00,
+    0x02, 0x2c, 0xff, 0xdb, 0xfd, 0x00, 0x09, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0x18, 0xd7, 0xff, 0xd7,
+    0x18, 0xfc, 0x00, 0x01, 0x10, 0xd7, 0xfd, 0xff, 0x01, 0xd7, 0x10, 0xf7, 0x00, 0x02, 0x74, 0xff,
+    0xa3, 0xfe, 0x00, 0x0b, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0x00, 0x00, 0x18, 0xd7, 0xff, 0xd7, 0x18,
+    0xfc, 0x00, 0x05, 0x28, 0xef, 0xff, 0xff, 0xef, 0x28, 0xf7, 0x00, 0x0a, 0x0c, 0xe7, 0xff, 0x4c,
+    0x00, 0x00, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfd, 0x00, 0x04, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfc,
+    0x00, 0x03, 0x44, 0xfb, 0xfb, 0x44, 0xf6, 0x00, 0x09, 0xa3, 0xff, 0xc7, 0x00, 0x00, 0x18, 0xd7,
+    0xff, 0xd7, 0x18, 0xfb, 0x00, 0x04, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0xfc, 0x00, 0x01, 0x68, 0x68,
+    0xf7, 0x00, 0x0a, 0x0c, 0xa3, 0xff, 0xf3, 0x2c, 0x00, 0x00, 0x64, 0xff, 0xd7, 0x18, 0xf9, 0x00,
+    0x03, 0x18, 0xd7, 0xff, 0x60, 0xf3, 0x00, 0x06, 0x04, 0x2c, 0x74, 0xe7, 0xff, 0xf3, 0x3c, 0xfd,
+    0x00, 0x01, 0x78, 0x18, 0xf7, 0x00, 0x01, 0x18, 0x60, 0xf2, 0x00, 0xfd, 0xff, 0x01, 0xc7, 0x2c,
+    0xdf, 0x00, 0x03, 0xff, 0xdb, 0xa3, 0x4c, 0xc2, 0x00, 0xeb, 0x8d, 0xf2, 0x00, 0x02, 0x10, 0x60,
+    0x00, 0xeb, 0x8d, 0xf3, 0x00, 0x03, 0x0c, 0xc3, 0xff, 0x78, 0xee, 0x00, 0xfe, 0x8d, 0xf4, 0x00,
+    0x04, 0x04, 0xaf, 0xff, 0xe3, 0x18, 0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d,
+    0xf4, 0x00, 0x04, 0x9f, 0xff, 0xe7, 0x28, 0x00, 0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00,
+    0xfe, 0x8d, 0xf5, 0x00, 0x05, 0x8b, 0xff, 0xf3, 0x3c, 0x00, 0x00, 0xf4, 0xff, 0x00, 0x00, 0xfd,
+    0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xf6, 0x00, 0x03, 0x70, 0xff, 0xfb, 0x48, 0xfe, 0x00, 0xf4, 0xff,
+    0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0x03, 0x00, 0x00, 0x78, 0x18, 0xfb, 0x00, 0x03,
+    0x58, 0xff, 0xff, 0x58, 0xfd, 0x00, 0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d,
+    0x04, 0x00, 0x64, 0xff, 0xd7, 0x18, 0xfd, 0x00, 0x03, 0x48, 0xfb, 0xff, 0x70, 0xfc, 0x00, 0xf4,
+    0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0x0b, 0x00, 0x18, 0xd7, 0xff, 0xd7, 0x18,
+    0x00, 0x00, 0x3c, 0xf3, 0xff, 0x8b, 0xfb, 0x00, 0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00,
+    0xfe, 0x8d, 0x0a, 0x00, 0x00, 0x18, 0xd7, 0xff, 0xd7, 0x18, 0x28, 0xe7, 0xff, 0x9f, 0xfa, 0x00,
+    0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xfe, 0x00, 0x07, 0x18, 0xd7, 0xff,
+    0xd7, 0xe3, 0xff, 0xaf, 0x04, 0xfa, 0x00, 0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe,
+    0x8d, 0xfd, 0x00, 0x05, 0x18, 0xd7, 0xff, 0xff, 0xc3, 0x0c, 0xf9, 0x00, 0xf4, 0xff, 0x00, 0x00,
+    0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xfc, 0x00, 0x03, 0x18, 0xd7, 0xd7, 0x10, 0xf8, 0x00, 0xf4,
+    0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xfb, 0x00, 0x01, 0x18, 0x18, 0xf7, 0x00,
+    0xf4, 0xff, 0x00, 0x00, 0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xef, 0x00, 0xf4, 0xff, 0x00, 0x00,
+    0xfd, 0xc5, 0x00, 0x00, 0xfe, 0x8d, 0xef, 0x00,
+};
+
+// 79x112 pixels, packed from 8848 bytes
+static const uint8_t kTOCropToolbarIconAtlas2x[] = {
+    0xef, 0x00, 0x01, 0x24, 0xb7, 0xe0, 0x00, 0x01, 0xaf, 0x20, 0xd9, 0x00, 0x03, 0x08, 0x83, 0xf7,
+    0xff, 0xe0, 0x00, 0x03, 0xff, 0xf7, 0x7c, 0x08, 0xdc, 0x00, 0x01, 0x50, 0xdf, 0xfe, 0xff, 0xe0,
+    0x00, 0xfe, 0xff, 0x01, 0xdb, 0x48, 0xdf, 0x00, 0x01, 0x24, 0xb7, 0xfc, 0xff, 0xe0, 0x00, 0xfc,
+    0xff, 0x01, 0xaf, 0x20, 0xe3, 0x00, 0x02, 0x08, 0x83, 0xf7, 0xfb, 0xff, 0xe0, 0x00, 0xfb, 0xff,
+    0x02, 0xf7, 0x7c, 0x08, 0xe6, 0x00, 0x01, 0x50, 0xdf, 0xf8, 0xff, 0x05, 0xf7, 0xdf, 0xbb, 0x8f,
+    0x50, 0x0c, 0xee, 0x00, 0x05, 0x0c, 0x50, 0x8f, 0xbb, 0xdf, 0xf7, 0xf8, 0xff, 0x01, 0xdb, 0x48,
+    0xe7, 0x00, 0x01, 0x50, 0xdf, 0xf3, 0xff, 0x02, 0xf7, 0x9b, 0x2c, 0xf2, 0x00, 0x02, 0x2c, 0x9b,
+    0xf7, 0xf3, 0xff, 0x01, 0xdb, 0x48, 0xe6, 0x00, 0x02, 0x08, 0x83, 0xf7, 0xfb, 0xff, 0x0a, 0x00,
+    0x08, 0x24, 0x4c, 0x80, 0xc3, 0xff, 0xff, 0xfb, 0x93, 0x0c, 0xf6, 0x00, 0x0a, 0x0c, 0x93, 0xfb,
+    0xff, 0xff, 0xc3, 0x80, 0x4c, 0x24, 0x08, 0x00, 0xfb, 0xff, 0x02, 0xf7, 0x7c, 0x08, 0xe3, 0x00,
+    0x01, 0x24, 0xb7, 0xfc, 0xff, 0xfb, 0x00, 0x05, 0x20, 0x93, 0xfb, 0xff, 0xd3, 0x18, 0xf8, 0x00,
+    0x05, 0x18, 0xd3, 0xff, 0xfb, 0x93, 0x20, 0xfb, 0x00, 0xfc, 0xff, 0x01, 0xaf, 0x20, 0xdf, 0x00,
+    0x01, 0x50, 0xdf, 0xfe, 0xff, 0xf9, 0x00, 0x04, 0x30, 0xd7, 0xff, 0xd7, 0x18, 0xfa, 0x00, 0x04,
+    0x18, 0xd7, 0xff, 0xd7, 0x30, 0xf9, 0x00, 0xfe, 0xff, 0x01, 0xdb, 0x48, 0xdc, 0x00, 0x03, 0x08,
+    0x83, 0xf7, 0xff, 0xf8, 0x00, 0x04, 0x0c, 0xc3, 0xff, 0xcb, 0x04, 0xfc, 0x00, 0x04, 0x04, 0xcb,
+    0xff, 0xc3, 0x0c, 0xf8, 0x00, 0x03, 0xff, 0xf7, 0x7c, 0x08, 0xd9, 0x00, 0x01, 0x24, 0xb7, 0xf7,
+    0x00, 0x03, 0x14, 0xdf, 0xff, 0x7c, 0xfc, 0x00, 0x03, 0x7c, 0xff, 0xdf, 0x14, 0xf7, 0x00, 0x01,
+    0xaf, 0x20, 0xca, 0x00, 0x03, 0x44, 0xff, 0xf3, 0x18, 0xfe, 0x00, 0x03, 0x18, 0xf3, 0xff, 0x44,
+    0xbc, 0x00, 0x02, 0xaf, 0xff, 0x7c, 0xfe, 0x00, 0x02, 0x7c, 0xff, 0xaf, 0xbb, 0x00, 0x02, 0x40,
+    0xff, 0xe3, 0xfe, 0x00, 0x02, 0xe3, 0xff, 0x40, 0xba, 0x00, 0x06, 0xe3, 0xff, 0x2c, 0x00, 0x2c,
+    0xff, 0xe3, 0xb9, 0x00, 0x06, 0x9f, 0xff, 0x70, 0x00, 0x70, 0xff, 0x9f, 0xb9, 0x00, 0x06, 0x68,
+    0xff, 0x9f, 0x00, 0x9f, 0xff, 0x68, 0xda, 0x00, 0xe9, 0xff, 0xf8, 0x00, 0x06, 0x3c, 0xff, 0xc7,
+    0x00, 0xc7, 0xff, 0x3c, 0xf8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xf8, 0x00, 0x06, 0x20,
+    0xff, 0xdf, 0x00, 0xdf, 0xff, 0x20, 0xf8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xf8, 0x00,
+    0x06, 0x04, 0xff, 0xff, 0x00, 0xff, 0xff, 0x04, 0xf8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xf7, 0x00, 0x04, 0xff, 0xff, 0x00, 0xff, 0xff, 0xf7, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff,
+    0xe8, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xe8, 0x00, 0xe9, 0xff, 0x98, 0x00, 0x0b, 0x24,
+    0x70, 0xab, 0xd3, 0xef, 0xff, 0xff, 0xef, 0xd3, 0xab, 0x6c, 0x24, 0xf1, 0x00, 0x00, 0x30, 0xe9,
+    0x00, 0x00, 0x24, 0xeb, 0x00, 0x02, 0x04, 0x60, 0xcb, 0xf5, 0xff, 0x02, 0xc7, 0x5c, 0x04, 0xf5,
+    0x00, 0x02, 0x8f, 0xfb, 0x54, 0xeb, 0x00, 0x02, 0x54, 0xfb, 0x70, 0xed, 0x00, 0x01, 0x48, 0xdb,
+    0xf1, 0xff, 0x01, 0xdb, 0x48, 0xf7, 0x00, 0x04, 0x8f, 0xff, 0xff, 0xfb, 0x54, 0xed, 0x00, 0x04,
+    0x54, 0xfb, 0xff, 0xff, 0x8b, 0xf0, 0x00, 0x01, 0x0c, 0x9b, 0xed, 0xff, 0x01, 0x9b, 0x0c, 0xfa,
+    0x00, 0x01, 0x30, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xef, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff,
+    0x01, 0xfb, 0x30, 0xf2, 0x00, 0x01, 0x18, 0xcf, 0xfb, 0xff, 0x09, 0xbb, 0x74, 0x38, 0x18, 0x00,
+    0x00, 0x18, 0x38, 0x74, 0xbb, 0xfb, 0xff, 0x01, 0xcb, 0x18, 0xfa, 0x00, 0x01, 0x54, 0xfb, 0xfe,
+    0xff, 0x01, 0xfb, 0x54, 0xf1, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf2, 0x00,
+    0x01, 0x18, 0xd7, 0xfd, 0xff, 0x02, 0xfb, 0x9f, 0x24, 0xf7, 0x00, 0x02, 0x24, 0x9f, 0xfb, 0xfd,
+    0xff, 0x01, 0xd7, 0x18, 0xfa, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf3, 0x00,
+    0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf2, 0x00, 0x01, 0x0c, 0xcf, 0xfd, 0xff, 0x01,
+    0xd3, 0x30, 0xf3, 0x00, 0x01, 0x30, 0xd3, 0xfd, 0xff, 0x01, 0xcb, 0x0c, 0xfa, 0x00, 0x01, 0x54,
+    0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf5, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54,
+    0xf1, 0x00, 0x00, 0x9b, 0xfd, 0xff, 0x01, 0xb3, 0x0c, 0xf1, 0x00, 0x01, 0x0c, 0xaf, 0xfd, 0xff,
+    0x00, 0x9b, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf7, 0x00, 0x01, 0x54,
+    0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf1, 0x00, 0x00, 0x48, 0xfd, 0xff, 0x01, 0xb3, 0x04, 0xef,
+    0x00, 0x01, 0x04, 0xaf, 0xfd, 0xff, 0x00, 0x48, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01,
+    0xfb, 0x54, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf1, 0x00, 0x01, 0x04,
+    0xdb, 0xfe, 0xff, 0x01, 0xd3, 0x0c, 0xed, 0x00, 0x01, 0x0c, 0xd3, 0xfe, 0xff, 0x01, 0xdb, 0x04,
+    0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xfb, 0x00, 0x01, 0x54, 0xfb, 0xfe,
+    0xff, 0x01, 0xfb, 0x54, 0xf0, 0x00, 0x00, 0x60, 0xfe, 0xff, 0x01, 0xfb, 0x30, 0xeb, 0x00, 0x01,
+    0x30, 0xfb, 0xfe, 0xff, 0x00, 0x5c, 0xf8, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54,
+    0xfd, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xef, 0x00, 0x00, 0xcb, 0xfe, 0xff,
+    0x00, 0x9b, 0xe9, 0x00, 0x00, 0x9f, 0xfe, 0xff, 0x00, 0xc7, 0xf7, 0x00, 0x01, 0x54, 0xfb, 0xfe,
+    0xff, 0x05, 0xfb, 0x54, 0x00, 0x00, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xef, 0x00, 0x00,
+    0x24, 0xfd, 0xff, 0x00, 0x24, 0xe9, 0x00, 0x00, 0x24, 0xfd, 0xff, 0x00, 0x24, 0xf7, 0x00, 0x01,
+    0x54, 0xfb, 0xfe, 0xff, 0x03, 0xfb, 0x54, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xee, 0x00,
+    0x00, 0x70, 0xfe, 0xff, 0x00, 0xbb, 0xe7, 0x00, 0x00, 0xbb, 0xfe, 0xff, 0x00, 0x6c, 0xf6, 0x00,
+    0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfc, 0xfc, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xed, 0x00, 0x00,
+    0xab, 0xfe, 0xff, 0x00, 0x74, 0xe7, 0x00, 0x00, 0x74, 0xfe, 0xff, 0x00, 0xab, 0xf5, 0x00, 0x01,
+    0x54, 0xfb, 0xfb, 0xff, 0x01, 0xfb, 0x54, 0xec, 0x00, 0x00, 0xd3, 0xfe, 0xff, 0x00, 0x38, 0xe7,
+    0x00, 0x00, 0x38, 0xfe, 0xff, 0x00, 0xd3, 0xf4, 0x00, 0x01, 0x54, 0xfc, 0xfd, 0xff, 0x01, 0xfc,
+    0x54, 0xeb, 0x00, 0x00, 0xef, 0xfe, 0xff, 0x00, 0x14, 0xe7, 0x00, 0x00, 0x18, 0xfe, 0xff, 0x00,
+    0xef, 0xf4, 0x00, 0x01, 0x54, 0xfc, 0xfd, 0xff, 0x01, 0xfc, 0x54, 0xeb, 0x00, 0xfd, 0xff, 0xe5,
+    0x00, 0xfd, 0xff, 0xf5, 0x00, 0x01, 0x54, 0xfb, 0xfb, 0xff, 0x01, 0xfb, 0x54, 0xf4, 0x00, 0x00,
+    0x97, 0xef, 0xff, 0x00, 0x97, 0xed, 0x00, 0xfd, 0xff, 0xf6, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff,
+    0x01, 0xfc, 0xfc, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf5, 0x00, 0x01, 0x04, 0xbb, 0xf1, 0xff, 0x01,
+    0xbb, 0x04, 0xee, 0x00, 0x00, 0x18, 0xfe, 0xff, 0x00, 0xef, 0xf7, 0x00, 0x01, 0x54, 0xfb, 0xfe,
+    0xff, 0x03, 0xfb, 0x54, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf5, 0x00, 0x01, 0x10, 0xd7,
+    0xf3, 0xff, 0x01, 0xd7, 0x10, 0xed, 0x00, 0x00, 0x38, 0xfe, 0xff, 0x00, 0xd3, 0xf8, 0x00, 0x01,
+    0x54, 0xfb, 0xfe, 0xff, 0x05, 0xfb, 0x54, 0x00, 0x00, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54,
+    0xf5, 0x00, 0x01, 0x28, 0xef, 0xf5, 0xff, 0x01, 0xef, 0x28, 0xec, 0x00, 0x00, 0x74, 0xfe, 0xff,
+    0x00, 0xab, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xfd, 0x00, 0x01, 0x54,
+    0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf5, 0x00, 0x01, 0x44, 0xfb, 0xf7, 0xff, 0x01, 0xfb, 0x44,
+    0xeb, 0x00, 0x00, 0xbb, 0xfe, 0xff, 0x00, 0x6c, 0xfa, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01,
+    0xfb, 0x54, 0xfb, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf5, 0x00, 0x00, 0x68,
+    0xf7, 0xff, 0x00, 0x68, 0xeb, 0x00, 0x00, 0x24, 0xfd, 0xff, 0x00, 0x24, 0xfb, 0x00, 0x01, 0x54,
+    0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54,
+    0xf5, 0x00, 0x00, 0x97, 0xf9, 0xff, 0x00, 0x97, 0xea, 0x00, 0x00, 0x9f, 0xfe, 0xff, 0x00, 0xc7,
+    0xfb, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf7, 0x00, 0x01, 0x54, 0xfb, 0xfe,
+    0xff, 0x01, 0xfb, 0x54, 0xf6, 0x00, 0x01, 0x04, 0xbb, 0xfb, 0xff, 0x01, 0xbb, 0x04, 0xeb, 0x00,
+    0x01, 0x30, 0xfb, 0xfe, 0xff, 0x00, 0x5c, 0xfc, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb,
+    0x54, 0xf5, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf6, 0x00, 0x01, 0x10, 0xd7,
+    0xfd, 0xff, 0x01, 0xd7, 0x10, 0xeb, 0x00, 0x01, 0x0c, 0xd3, 0xfe, 0xff, 0x01, 0xdb, 0x04, 0xfd,
+    0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf3, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff,
+    0x01, 0xfb, 0x54, 0xf6, 0x00, 0x05, 0x28, 0xef, 0xff, 0xff, 0xef, 0x28, 0xeb, 0x00, 0x01, 0x04,
+    0xaf, 0xfd, 0xff, 0x00, 0x48, 0xfd, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf1,
+    0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf6, 0x00, 0x03, 0x44, 0xfb, 0xfb, 0x44,
+    0xeb, 0x00, 0x01, 0x0c, 0xaf, 0xfd, 0xff, 0x00, 0x9b, 0xfd, 0x00, 0x01, 0x24, 0xfb, 0xfe, 0xff,
+    0x01, 0xfb, 0x54, 0xef, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x24, 0xf6, 0x00, 0x01,
+    0x68, 0x68, 0xeb, 0x00, 0x01, 0x30, 0xd3, 0xfd, 0xff, 0x01, 0xcb, 0x0c, 0xfc, 0x00, 0x04, 0x7c,
+    0xff, 0xff, 0xfb, 0x54, 0xed, 0x00, 0x04, 0x54, 0xfb, 0xff, 0xff, 0x70, 0xdf, 0x00, 0x02, 0x24,
+    0x9f, 0xfb, 0xfd, 0xff, 0x01, 0xd7, 0x18, 0xfa, 0x00, 0x02, 0x8f, 0xfb, 0x54, 0xeb, 0x00, 0x02,
+    0x54, 0xfb, 0x70, 0xe2, 0x00, 0x03, 0x18, 0x38, 0x74, 0xbb, 0xfb, 0xff, 0x01, 0xcb, 0x18, 0xf8,
+    0x00, 0x00, 0x30, 0xe9, 0x00, 0x00, 0x24, 0xe2, 0x00, 0xf7, 0xff, 0x01, 0x9b, 0x0c, 0xbe, 0x00,
+    0xf9, 0xff, 0x01, 0xdb, 0x48, 0xbc, 0x00, 0xfb, 0xff, 0x02, 0xc7, 0x5c, 0x04, 0xbb, 0x00, 0x05,
+    0xff, 0xef, 0xd3, 0xab, 0x6c, 0x24, 0x83, 0x00, 0xd5, 0x8d, 0xe2, 0x00, 0x00, 0x20, 0xfe, 0x00,
+    0xd5, 0x8d, 0xe3, 0x00, 0x04, 0x44, 0xfb, 0x70, 0x00, 0x00, 0xd5, 0x8d, 0xe4, 0x00, 0x05, 0x38,
+    0xf3, 0xff, 0xff, 0x8f, 0x00, 0xd5, 0x8d, 0xe5, 0x00, 0x01, 0x28, 0xe7, 0xfd, 0xff, 0x00, 0x34,
+    0xdb, 0x00, 0xfb, 0x8d, 0xe6, 0x00, 0x01, 0x18, 0xdf, 0xfd, 0xff, 0x00, 0x70, 0xda, 0x00, 0xfb,
+    0x8d, 0xe7, 0x00, 0x01, 0x0c, 0xd7, 0xfd, 0xff, 0x02, 0x87, 0x00, 0x00, 0xe7, 0xff, 0x01, 0x00,
+    0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xe8, 0x00, 0x01, 0x0c, 0xc3, 0xfd, 0xff, 0x00,
+    0x9b, 0xfe, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xe9,
+    0x00, 0x01, 0x04, 0xab, 0xfd, 0xff, 0x01, 0xab, 0x04, 0xfe, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00,
+    0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xe9, 0x00, 0x00, 0x9b, 0xfd, 0xff, 0x01, 0xc3, 0x0c,
+    0xfd, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xea, 0x00,
+    0x00, 0x87, 0xfd, 0xff, 0x01, 0xd7, 0x0c, 0xfc, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5,
+    0x01, 0x00, 0x00, 0xfb, 0x8d, 0xeb, 0x00, 0x00, 0x70, 0xfd, 0xff, 0x01, 0xdf, 0x18, 0xfb, 0x00,
+    0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xec, 0x00, 0x00, 0x54,
+    0xfd, 0xff, 0x01, 0xe7, 0x28, 0xfa, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00,
+    0x00, 0xfb, 0x8d, 0xfd, 0x00, 0x00, 0x30, 0xf2, 0x00, 0x01, 0x44, 0xfb, 0xfe, 0xff, 0x01, 0xf3,
+    0x38, 0xf9, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xfe,
+    0x00, 0x02, 0x8f, 0xfb, 0x54, 0xf4, 0x00, 0x01, 0x38, 0xf3, 0xfe, 0xff, 0x01, 0xfb, 0x44, 0xf8,
+    0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0x06, 0x00, 0x00,
+    0x70, 0xff, 0xff, 0xfb, 0x54, 0xf6, 0x00, 0x01, 0x28, 0xe7, 0xfd, 0xff, 0x00, 0x54, 0xf7, 0x00,
+    0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0x02, 0x00, 0x24, 0xfb,
+    0xfe, 0xff, 0x01, 0xfb, 0x54, 0xf8, 0x00, 0x01, 0x18, 0xdf, 0xfd, 0xff, 0x00, 0x70, 0xf6, 0x00,
+    0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0x03, 0x00, 0x00, 0x54,
+    0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xfa, 0x00, 0x01, 0x0c, 0xd7, 0xfd, 0xff, 0x00, 0x87, 0xf5,
+    0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xfe, 0x00, 0x01,
+    0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xfc, 0x00, 0x01, 0x0c, 0xc3, 0xfd, 0xff, 0x00, 0x9b,
+    0xf4, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xfd, 0x00,
+    0x01, 0x54, 0xfb, 0xfe, 0xff, 0x01, 0xfb, 0x54, 0xfe, 0x00, 0x01, 0x04, 0xab, 0xfd, 0xff, 0x01,
+    0xab, 0x04, 0xf4, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d,
+    0xfc, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x04, 0xfb, 0x54, 0x00, 0x00, 0x9b, 0xfd, 0xff, 0x01,
+    0xc3, 0x0c, 0xf3, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d,
+    0xfb, 0x00, 0x01, 0x54, 0xfb, 0xfe, 0xff, 0x02, 0xfb, 0x54, 0x87, 0xfd, 0xff, 0x01, 0xd7, 0x0c,
+    0xf2, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xfa, 0x00,
+    0x01, 0x54, 0xfb, 0xfe, 0xff, 0x00, 0xfb, 0xfd, 0xff, 0x01, 0xdf, 0x18, 0xf1, 0x00, 0xe7, 0xff,
+    0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xf9, 0x00, 0x01, 0x54, 0xfb, 0xfb,
+    0xff, 0x01, 0xe7, 0x28, 0xf0, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00,
+    0xfb, 0x8d, 0xf8, 0x00, 0x01, 0x54, 0xfb, 0xfd, 0xff, 0x01, 0xf3, 0x38, 0xef, 0x00, 0xe7, 0xff,
+    0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xf7, 0x00, 0x05, 0x54, 0xfb, 0xff,
+    0xff, 0xfb, 0x44, 0xee, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb,
+    0x8d, 0xf6, 0x00, 0x03, 0x54, 0xfb, 0xff, 0x54, 0xed, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9,
+    0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xf5, 0x00, 0x01, 0x54, 0x70, 0xec, 0x00, 0xe7, 0xff, 0x01,
+    0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xde, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00,
+    0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb, 0x8d, 0xde, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5,
+    0x01, 0x00, 0x00, 0xfb, 0x8d, 0xde, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00,
+    0x00, 0xfb, 0x8d, 0xde, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x00, 0xf9, 0xc5, 0x01, 0x00, 0x00, 0xfb,
+    0x8d, 0xde, 0x00,
+};
+
+// 118x167 pixels, packed from 19706 bytes
+static const uint8_t kTOCropToolbarIconAtlas3x[] = {
+    0xe5, 0x00, 0x01, 0x20, 0xb7, 0xd0, 0x00, 0x01, 0xb3, 0x20, 0xc2, 0x00, 0x03, 0x08, 0x83, 0xf7,
+    0xff, 0xd0, 0x00, 0x03, 0xff, 0xf7, 0x80, 0x08, 0xc5, 0x00, 0x01, 0x50, 0xdb, 0xfe, 0xff, 0xd0,
+    0x00, 0xfe, 0xff, 0x01, 0xdb, 0x4c, 0xc8, 0x00, 0x01, 0x24, 0xb3, 0xfc, 0xff, 0xd0, 0x00, 0xfc,
+    0xff, 0x01, 0xb3, 0x20, 0xcc, 0x00, 0x02, 0x08, 0x80, 0xf7, 0xfb, 0xff, 0xd0, 0x00, 0xfb, 0xff,
+    0x02, 0xf7, 0x80, 0x08, 0xcf, 0x00, 0x01, 0x50, 0xdf, 0xf9, 0xff, 0xd0, 0x00, 0xf9, 0xff, 0x01,
+    0xdb, 0x4c, 0xd2, 0x00, 0x01, 0x24, 0xb7, 0xf7, 0xff, 0xd0, 0x00, 0xf7, 0xff, 0x01, 0xaf, 0x24,
+    0xd6, 0x00, 0x02, 0x08, 0x83, 0xf7, 0xf6, 0xff, 0x05, 0x80, 0x80, 0x64, 0x54, 0x38, 0x14, 0xdc,
+    0x00, 0x05, 0x14, 0x38, 0x54, 0x64, 0x80, 0x80, 0xf6, 0xff, 0x02, 0xf7, 0x7c, 0x08, 0xd9, 0x00,
+    0x01, 0x50, 0xdf, 0xee, 0xff, 0x03, 0xe3, 0xab, 0x68, 0x1c, 0xe4, 0x00, 0x03, 0x1c, 0x68, 0xab,
+    0xe3, 0xee, 0xff, 0x01, 0xdf, 0x48, 0xda, 0x00, 0x01, 0x50, 0xdb, 0xea, 0xff, 0x02, 0xbf, 0x54,
+    0x04, 0xea, 0x00, 0x02, 0x04, 0x54, 0xbf, 0xea, 0xff, 0x01, 0xdf, 0x48, 0xd9, 0x00, 0x02, 0x08,
+    0x83, 0xf7, 0xf6, 0xff, 0x05, 0x80, 0x80, 0x9f, 0xaf, 0xcf, 0xf7, 0xfb, 0xff, 0x01, 0xdb, 0x50,
+    0xec, 0x00, 0x01, 0x50, 0xdb, 0xfb, 0xff, 0x05, 0xf7, 0xcf, 0xaf, 0x9f, 0x80, 0x80, 0xf6, 0xff,
+    0x02, 0xf7, 0x7c, 0x08, 0xd6, 0x00, 0x01, 0x20, 0xb7, 0xf7, 0xff, 0xfb, 0x00, 0x03, 0x30, 0x6c,
+    0xbb, 0xfb, 0xfd, 0xff, 0x01, 0xb3, 0x18, 0xf0, 0x00, 0x01, 0x18, 0xb3, 0xfd, 0xff, 0x03, 0xfb,
+    0xbb, 0x6c, 0x30, 0xfb, 0x00, 0xf7, 0xff, 0x01, 0xaf, 0x24, 0xd2, 0x00, 0x01, 0x4c, 0xdf, 0xf9,
+    0xff, 0xf8, 0x00, 0x02, 0x18, 0x80, 0xef, 0xfe, 0xff, 0x01, 0xe7, 0x38, 0xf2, 0x00, 0x01, 0x38,
+    0xe7, 0xfe, 0xff, 0x02, 0xef, 0x80, 0x18, 0xf8, 0x00, 0xf9, 0xff, 0x01, 0xdb, 0x4c, 0xcf, 0x00,
+    0x02, 0x08, 0x80, 0xf7, 0xfb, 0xff, 0xf6, 0x00, 0x01, 0x10, 0x93, 0xfe, 0xff, 0x01, 0xf3, 0x3c,
+    0xf4, 0x00, 0x01, 0x3c, 0xf3, 0xfe, 0xff, 0x01, 0x93, 0x10, 0xf6, 0x00, 0xfb, 0xff, 0x02, 0xf7,
+    0x80, 0x08, 0xcc, 0x00, 0x01, 0x24, 0xb3, 0xfc, 0xff, 0xf4, 0x00, 0x05, 0x44, 0xeb, 0xff, 0xff,
+    0xf3, 0x3c, 0xf6, 0x00, 0x05, 0x3c, 0xf3, 0xff, 0xff, 0xeb, 0x44, 0xf4, 0x00, 0xfc, 0xff, 0x01,
+    0xb3, 0x20, 0xc8, 0x00, 0x01, 0x50, 0xdb, 0xfe, 0xff, 0xf3, 0x00, 0x05, 0x28, 0xe7, 0xff, 0xff,
+    0xe7, 0x18, 0xf8, 0x00, 0x05, 0x18, 0xe7, 0xff, 0xff, 0xe7, 0x28, 0xf3, 0x00, 0xfe, 0xff, 0x01,
+    0xdb, 0x4c, 0xc5, 0x00, 0x03, 0x08, 0x83, 0xf7, 0xff, 0xf2, 0x00, 0x04, 0x28, 0xe7, 0xff, 0xff,
+    0xbf, 0xf8, 0x00, 0x04, 0xbf, 0xff, 0xff, 0xe7, 0x28, 0xf2, 0x00, 0x03, 0xff, 0xf7, 0x80, 0x08,
+    0xc2, 0x00, 0x01, 0x20, 0xb7, 0xf1, 0x00, 0x04, 0x40, 0xfb, 0xff, 0xff, 0x5c, 0xfa, 0x00, 0x04,
+    0x5c, 0xff, 0xff, 0xfb, 0x40, 0xf1, 0x00, 0x01, 0xb3, 0x20, 0xad, 0x00, 0x04, 0x8b, 0xff, 0xff,
+    0xe7, 0x08, 0xfc, 0x00, 0x04, 0x08, 0xe7, 0xff, 0xff, 0x8b, 0x9a, 0x00, 0x04, 0x0c, 0xe7, 0xff,
+    0xff, 0x6c, 0xfc, 0x00, 0x04, 0x6c, 0xff, 0xff, 0xe7, 0x0c, 0x99, 0x00, 0x03, 0x70, 0xff, 0xff,
+    0xd7, 0xfc, 0x00, 0x03, 0xd7, 0xff, 0xff, 0x70, 0x98, 0x00, 0x04, 0x08, 0xef, 0xff, 0xff, 0x3c,
+    0xfe, 0x00, 0x04, 0x3c, 0xff, 0xff, 0xef, 0x08, 0x97, 0x00, 0x03, 0x9b, 0xff, 0xff, 0x8f, 0xfe,
+    0x00, 0x03, 0x8f, 0xff, 0xff, 0x9b, 0x96, 0x00, 0x03, 0x44, 0xff, 0xff, 0xd7, 0xfe, 0x00, 0x03,
+    0xd7, 0xff, 0xff, 0x44, 0x96, 0x00, 0x0a, 0x08, 0xf7, 0xff, 0xff, 0x18, 0x00, 0x18, 0xff, 0xff,
+    0xf7, 0x08, 0x95, 0x00, 0x08, 0xbf, 0xff, 0xff, 0x50, 0x00, 0x50, 0xff, 0xff, 0xbf, 0x94, 0x00,
+    0x08, 0x8b, 0xff, 0xff, 0x80, 0x00, 0x80, 0xff, 0xff, 0x8b, 0xc6, 0x00, 0xdd, 0xff, 0xf3, 0x00,
+    0x08, 0x64, 0xff, 0xff, 0xa3, 0x00, 0xa3, 0xff, 0xff, 0x64, 0xf3, 0x00, 0xdd, 0xff, 0xf8, 0x00,
+    0xdd, 0xff, 0xf3, 0x00, 0x08, 0x40, 0xff, 0xff, 0xbf, 0x00, 0xbf, 0xff, 0xff, 0x40, 0xf3, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xf3, 0x00, 0x08, 0x24, 0xff, 0xff, 0xdf, 0x00, 0xdf, 0xff,
+    0xff, 0x24, 0xf3, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xf3, 0x00, 0x08, 0x18, 0xff, 0xff,
+    0xe7, 0x00, 0xe7, 0xff, 0xff, 0x18, 0xf3, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xf2, 0x00,
+    0xfe, 0xff, 0x00, 0x00, 0xfe, 0xff, 0xf2, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xf2, 0x00,
+    0xfe, 0xff, 0x00, 0x00, 0xfe, 0xff, 0xf2, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00,
+    0xdd, 0xff, 0xf8, 0x00, 0xdd, 0xff, 0xdc, 0x00, 0xdd, 0xff, 0x81, 0x00, 0xe3, 0x00, 0x0e, 0x04,
+    0x38, 0x70, 0x9f, 0xc7, 0xdf, 0xfb, 0xff, 0xff, 0xf7, 0xdf, 0xc3, 0x9f, 0x70, 0x34, 0xe7, 0x00,
+    0x00, 0x04, 0xb8, 0x00, 0x03, 0x04, 0x48, 0xa3, 0xef, 0xf3, 0xff, 0x02, 0xeb, 0xa3, 0x44, 0xeb,
+    0x00, 0x02, 0x8f, 0xab, 0x04, 0xdf, 0x00, 0x02, 0x04, 0xab, 0x7c, 0xe0, 0x00, 0x02, 0x08, 0x70,
+    0xdf, 0xed, 0xff, 0x02, 0xdb, 0x70, 0x08, 0xef, 0x00, 0x04, 0x8f, 0xff, 0xff, 0xab, 0x04, 0xe1,
+    0x00, 0x04, 0x04, 0xab, 0xff, 0xff, 0x7c, 0xe2, 0x00, 0x01, 0x64, 0xe7, 0xe9, 0xff, 0x01, 0xe7,
+    0x60, 0xf1, 0x00, 0x00, 0x8f, 0xfd, 0xff, 0x01, 0xab, 0x04, 0xe3, 0x00, 0x01, 0x04, 0xab, 0xfd,
+    0xff, 0x00, 0x83, 0xe5, 0x00, 0x01, 0x28, 0xc7, 0xe5, 0xff, 0x01, 0xc3, 0x24, 0xf4, 0x00, 0x00,
+    0x8f, 0xfb, 0xff, 0x01, 0xab, 0x04, 0xe5, 0x00, 0x01, 0x04, 0xab, 0xfb, 0xff, 0x00, 0x83, 0xe7,
+    0x00, 0x01, 0x60, 0xf3, 0xe3, 0xff, 0x01, 0xf3, 0x60, 0xf6, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff,
+    0x01, 0xab, 0x04, 0xe7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xea, 0x00, 0x01,
+    0x04, 0x8f, 0xf7, 0xff, 0x0d, 0xf7, 0xbb, 0x7c, 0x4c, 0x28, 0x0c, 0x00, 0x00, 0x10, 0x28, 0x4c,
+    0x7c, 0xbb, 0xf7, 0xf7, 0xff, 0x01, 0x8b, 0x04, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xe9, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xea, 0x00, 0x01, 0x04,
+    0xab, 0xf8, 0xff, 0x02, 0xcb, 0x60, 0x0c, 0xf5, 0x00, 0x02, 0x0c, 0x60, 0xcb, 0xf8, 0xff, 0x01,
+    0xab, 0x04, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xeb, 0x00, 0x01, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xea, 0x00, 0x01, 0x04, 0xab, 0xf9, 0xff, 0x01, 0xcf, 0x40,
+    0xef, 0x00, 0x01, 0x40, 0xcb, 0xf9, 0xff, 0x01, 0xab, 0x04, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa,
+    0xff, 0x01, 0xab, 0x04, 0xed, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe9, 0x00,
+    0x00, 0x8f, 0xfa, 0xff, 0x02, 0xf3, 0x6c, 0x04, 0xed, 0x00, 0x02, 0x04, 0x6c, 0xf3, 0xfa, 0xff,
+    0x00, 0x8b, 0xf6, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00, 0x01, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe9, 0x00, 0x00, 0x60, 0xfa, 0xff, 0x01, 0xd7, 0x2c, 0xe9,
+    0x00, 0x01, 0x2c, 0xd7, 0xfa, 0xff, 0x00, 0x60, 0xf6, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xf1, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe9, 0x00, 0x01, 0x28,
+    0xf3, 0xfb, 0xff, 0x01, 0xc3, 0x10, 0xe7, 0x00, 0x01, 0x10, 0xc3, 0xfb, 0xff, 0x01, 0xf3, 0x24,
+    0xf6, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf3, 0x00, 0x01, 0x04, 0xab, 0xfa,
+    0xff, 0x01, 0xab, 0x04, 0xe8, 0x00, 0x00, 0xc7, 0xfb, 0xff, 0x01, 0xc3, 0x0c, 0xe5, 0x00, 0x01,
+    0x0c, 0xc3, 0xfb, 0xff, 0x00, 0xc3, 0xf5, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04,
+    0xf5, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe8, 0x00, 0x00, 0x64, 0xfb, 0xff,
+    0x01, 0xd7, 0x10, 0xe3, 0x00, 0x01, 0x10, 0xd7, 0xfb, 0xff, 0x00, 0x60, 0xf5, 0x00, 0x01, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04,
+    0xe8, 0x00, 0x01, 0x08, 0xe7, 0xfc, 0xff, 0x01, 0xf3, 0x2c, 0xe1, 0x00, 0x01, 0x2c, 0xf3, 0xfc,
+    0xff, 0x01, 0xe7, 0x08, 0xf5, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf9, 0x00,
+    0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe7, 0x00, 0x00, 0x70, 0xfb, 0xff, 0x00, 0x6c,
+    0xdf, 0x00, 0x00, 0x6c, 0xfb, 0xff, 0x00, 0x70, 0xf4, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xfb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe7, 0x00, 0x01, 0x04,
+    0xdf, 0xfc, 0xff, 0x01, 0xcf, 0x04, 0xdf, 0x00, 0x01, 0x04, 0xcb, 0xfc, 0xff, 0x00, 0xdb, 0xf3,
+    0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xfd, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff,
+    0x01, 0xab, 0x04, 0xe6, 0x00, 0x00, 0x48, 0xfb, 0xff, 0x00, 0x40, 0xdd, 0x00, 0x00, 0x40, 0xfb,
+    0xff, 0x00, 0x44, 0xf3, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x05, 0xab, 0x04, 0x00, 0x00, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe5, 0x00, 0x00, 0xa3, 0xfc, 0xff, 0x00, 0xcb, 0xdb, 0x00,
+    0x00, 0xcb, 0xfc, 0xff, 0x00, 0xa3, 0xf2, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x03, 0xab, 0x04,
+    0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe5, 0x00, 0x01, 0x04, 0xef, 0xfc, 0xff, 0x00, 0x60,
+    0xdb, 0x00, 0x00, 0x60, 0xfc, 0xff, 0x00, 0xeb, 0xf1, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xad, 0xad, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe4, 0x00, 0x00, 0x38, 0xfc, 0xff, 0x01, 0xf7, 0x0c,
+    0xdb, 0x00, 0x01, 0x0c, 0xf7, 0xfc, 0xff, 0x00, 0x34, 0xf1, 0x00, 0x01, 0x04, 0xab, 0xf3, 0xff,
+    0x01, 0xab, 0x04, 0xe3, 0x00, 0x00, 0x70, 0xfc, 0xff, 0x00, 0xbb, 0xd9, 0x00, 0x00, 0xbb, 0xfc,
+    0xff, 0x00, 0x70, 0xf0, 0x00, 0x01, 0x04, 0xab, 0xf5, 0xff, 0x01, 0xab, 0x04, 0xe2, 0x00, 0x00,
+    0x9f, 0xfc, 0xff, 0x00, 0x7c, 0xd9, 0x00, 0x00, 0x7c, 0xfc, 0xff, 0x00, 0x9f, 0xef, 0x00, 0x01,
+    0x04, 0xab, 0xf7, 0xff, 0x01, 0xab, 0x04, 0xe1, 0x00, 0x00, 0xc7, 0xfc, 0xff, 0x00, 0x4c, 0xd9,
+    0x00, 0x00, 0x4c, 0xfc, 0xff, 0x00, 0xc3, 0xee, 0x00, 0x01, 0x04, 0xad, 0xf9, 0xff, 0x01, 0xad,
+    0x04, 0xe0, 0x00, 0x00, 0xdf, 0xfc, 0xff, 0x00, 0x28, 0xd9, 0x00, 0x00, 0x28, 0xfc, 0xff, 0x00,
+    0xdf, 0xee, 0x00, 0x01, 0x04, 0xad, 0xf9, 0xff, 0x01, 0xad, 0x04, 0xe0, 0x00, 0x00, 0xfb, 0xfc,
+    0xff, 0x00, 0x0c, 0xd9, 0x00, 0x00, 0x10, 0xfc, 0xff, 0x00, 0xf7, 0xef, 0x00, 0x01, 0x04, 0xab,
+    0xf7, 0xff, 0x01, 0xab, 0x04, 0xe1, 0x00, 0xfb, 0xff, 0xd7, 0x00, 0xfb, 0xff, 0xf0, 0x00, 0x01,
+    0x04, 0xab, 0xf5, 0xff, 0x01, 0xab, 0x04, 0xee, 0x00, 0x00, 0x97, 0xe5, 0xff, 0x00, 0x97, 0xe3,
+    0x00, 0xfb, 0xff, 0xf1, 0x00, 0x01, 0x04, 0xab, 0xf3, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00, 0x01,
+    0x04, 0xbb, 0xe7, 0xff, 0x01, 0xbb, 0x04, 0xe4, 0x00, 0x00, 0x10, 0xfc, 0xff, 0x00, 0xf7, 0xf2,
+    0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xad, 0xad, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00,
+    0x01, 0x10, 0xd7, 0xe9, 0xff, 0x01, 0xd7, 0x10, 0xe3, 0x00, 0x00, 0x28, 0xfc, 0xff, 0x00, 0xdf,
+    0xf3, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x03, 0xab, 0x04, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab,
+    0x04, 0xef, 0x00, 0x01, 0x28, 0xef, 0xeb, 0xff, 0x01, 0xef, 0x28, 0xe2, 0x00, 0x00, 0x4c, 0xfc,
+    0xff, 0x00, 0xc3, 0xf4, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x05, 0xab, 0x04, 0x00, 0x00, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00, 0x01, 0x44, 0xfb, 0xed, 0xff, 0x01, 0xfb, 0x44,
+    0xe1, 0x00, 0x00, 0x7c, 0xfc, 0xff, 0x00, 0x9f, 0xf5, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xfd, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00, 0x00, 0x68,
+    0xed, 0xff, 0x00, 0x68, 0xe0, 0x00, 0x00, 0xbb, 0xfc, 0xff, 0x00, 0x70, 0xf6, 0x00, 0x01, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xfb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04,
+    0xef, 0x00, 0x00, 0x97, 0xef, 0xff, 0x00, 0x97, 0xe0, 0x00, 0x01, 0x0c, 0xf7, 0xfc, 0xff, 0x00,
+    0x34, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf9, 0x00, 0x01, 0x04, 0xab,
+    0xfa, 0xff, 0x01, 0xab, 0x04, 0xf0, 0x00, 0x01, 0x04, 0xbb, 0xf1, 0xff, 0x01, 0xbb, 0x04, 0xe0,
+    0x00, 0x00, 0x60, 0xfc, 0xff, 0x00, 0xeb, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab,
+    0x04, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf0, 0x00, 0x01, 0x10, 0xd7,
+    0xf3, 0xff, 0x01, 0xd7, 0x10, 0xdf, 0x00, 0x00, 0xcb, 0xfc, 0xff, 0x00, 0xa3, 0xf8, 0x00, 0x01,
+    0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf5, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab,
+    0x04, 0xf0, 0x00, 0x01, 0x28, 0xef, 0xf5, 0xff, 0x01, 0xef, 0x28, 0xdf, 0x00, 0x00, 0x40, 0xfb,
+    0xff, 0x00, 0x44, 0xf9, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf3, 0x00, 0x01,
+    0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf0, 0x00, 0x01, 0x44, 0xfb, 0xf7, 0xff, 0x01, 0xfb,
+    0x44, 0xdf, 0x00, 0x01, 0x04, 0xcb, 0xfc, 0xff, 0x00, 0xdb, 0xf9, 0x00, 0x01, 0x04, 0xab, 0xfa,
+    0xff, 0x01, 0xab, 0x04, 0xf1, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf0, 0x00,
+    0x00, 0x68, 0xf7, 0xff, 0x00, 0x68, 0xde, 0x00, 0x00, 0x6c, 0xfb, 0xff, 0x00, 0x70, 0xfa, 0x00,
+    0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xef, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xf0, 0x00, 0x00, 0x97, 0xf9, 0xff, 0x00, 0x97, 0xde, 0x00, 0x01, 0x2c, 0xf3, 0xfc,
+    0xff, 0x01, 0xe7, 0x08, 0xfb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xed, 0x00,
+    0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf1, 0x00, 0x01, 0x04, 0xbb, 0xfb, 0xff, 0x01,
+    0xbb, 0x04, 0xdf, 0x00, 0x01, 0x10, 0xd7, 0xfb, 0xff, 0x00, 0x60, 0xfb, 0x00, 0x01, 0x04, 0xab,
+    0xfa, 0xff, 0x01, 0xab, 0x04, 0xeb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf1,
+    0x00, 0x01, 0x10, 0xd7, 0xfd, 0xff, 0x01, 0xd7, 0x10, 0xdf, 0x00, 0x01, 0x0c, 0xc3, 0xfb, 0xff,
+    0x00, 0xc3, 0xfb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xe9, 0x00, 0x01, 0x04,
+    0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf1, 0x00, 0x05, 0x28, 0xef, 0xff, 0xff, 0xef, 0x28, 0xdf,
+    0x00, 0x01, 0x10, 0xc3, 0xfb, 0xff, 0x01, 0xf3, 0x24, 0xfb, 0x00, 0x00, 0xab, 0xfa, 0xff, 0x01,
+    0xab, 0x04, 0xe7, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x00, 0xab, 0xf0, 0x00, 0x03, 0x44, 0xfb,
+    0xfb, 0x44, 0xdf, 0x00, 0x01, 0x2c, 0xd7, 0xfa, 0xff, 0x00, 0x60, 0xfa, 0x00, 0x00, 0x7c, 0xfb,
+    0xff, 0x01, 0xab, 0x04, 0xe5, 0x00, 0x01, 0x04, 0xab, 0xfb, 0xff, 0x00, 0x70, 0xef, 0x00, 0x01,
+    0x68, 0x68, 0xe0, 0x00, 0x02, 0x04, 0x6c, 0xf3, 0xfa, 0xff, 0x00, 0x8b, 0xf8, 0x00, 0x00, 0x80,
+    0xfd, 0xff, 0x01, 0xab, 0x04, 0xe3, 0x00, 0x01, 0x04, 0xab, 0xfd, 0xff, 0x00, 0x70, 0xcc, 0x00,
+    0x01, 0x40, 0xcb, 0xf9, 0xff, 0x01, 0xab, 0x04, 0xf7, 0x00, 0x04, 0x83, 0xff, 0xff, 0xab, 0x04,
+    0xe1, 0x00, 0x04, 0x04, 0xab, 0xff, 0xff, 0x70, 0xce, 0x00, 0x02, 0x0c, 0x60, 0xcb, 0xf8, 0xff,
+    0x01, 0xab, 0x04, 0xf5, 0x00, 0x02, 0x8b, 0xab, 0x04, 0xdf, 0x00, 0x02, 0x04, 0xab, 0x70, 0xd2,
+    0x00, 0x05, 0x10, 0x28, 0x4c, 0x7c, 0xbb, 0xf7, 0xf7, 0xff, 0x01, 0x8b, 0x04, 0xf3, 0x00, 0x00,
+    0x04, 0xad, 0x00, 0xf2, 0xff, 0x01, 0xf3, 0x60, 0x9c, 0x00, 0xf3, 0xff, 0x01, 0xc3, 0x24, 0x9b,
+    0x00, 0xf5, 0xff, 0x01, 0xe7, 0x60, 0x99, 0x00, 0xf7, 0xff, 0x02, 0xdb, 0x70, 0x08, 0x98, 0x00,
+    0xfa, 0xff, 0x02, 0xeb, 0xa3, 0x44, 0x95, 0x00, 0x06, 0xff, 0xf7, 0xdf, 0xc3, 0x9f, 0x70, 0x34,
+    0x81, 0x00, 0xc3, 0x00, 0xbf, 0x8d, 0xcd, 0x00, 0xbf, 0x8d, 0xd4, 0x00, 0x02, 0x04, 0xa7, 0x5c,
+    0xfd, 0x00, 0xbf, 0x8d, 0xd4, 0x00, 0x03, 0x97, 0xff, 0xff, 0x70, 0xfe, 0x00, 0xbf, 0x8d, 0xd5,
+    0x00, 0x00, 0x83, 0xfd, 0xff, 0x02, 0x8f, 0x00, 0x00, 0xbf, 0x8d, 0xd6, 0x00, 0x00, 0x70, 0xfb,
+    0xff, 0x01, 0xa3, 0x04, 0xbf, 0x8d, 0xd7, 0x00, 0x01, 0x54, 0xfb, 0xfb, 0xff, 0x01, 0xc3, 0x08,
+    0xc8, 0x00, 0xf8, 0x8d, 0xd8, 0x00, 0x01, 0x40, 0xfb, 0xfb, 0xff, 0x01, 0xd3, 0x0c, 0xc7, 0x00,
+    0xf8, 0x8d, 0xd9, 0x00, 0x01, 0x34, 0xf3, 0xfb, 0xff, 0x01, 0xdb, 0x18, 0xc6, 0x00, 0xf8, 0x8d,
+    0xda, 0x00, 0x01, 0x28, 0xe7, 0xfb, 0xff, 0x01, 0xe7, 0x28, 0xfe, 0x00, 0xda, 0xff, 0xfe, 0x00,
+    0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xdb, 0x00, 0x01, 0x18, 0xdb, 0xfb, 0xff, 0x01, 0xf3, 0x34,
+    0xfd, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xdc, 0x00, 0x01, 0x0c,
+    0xd3, 0xfb, 0xff, 0x01, 0xfb, 0x40, 0xfc, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00,
+    0xf8, 0x8d, 0xdd, 0x00, 0x01, 0x08, 0xc3, 0xfb, 0xff, 0x01, 0xfb, 0x54, 0xfb, 0x00, 0xda, 0xff,
+    0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xde, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x00,
+    0x70, 0xfa, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xde, 0x00, 0x00,
+    0x97, 0xfa, 0xff, 0x00, 0x83, 0xf9, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8,
+    0x8d, 0xdf, 0x00, 0x00, 0x83, 0xfa, 0xff, 0x00, 0x97, 0xf8, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5,
+    0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xe0, 0x00, 0x00, 0x70, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf8, 0x00,
+    0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xe1, 0x00, 0x01, 0x54, 0xfb, 0xfb,
+    0xff, 0x01, 0xc3, 0x08, 0xf7, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d,
+    0xe2, 0x00, 0x01, 0x40, 0xfb, 0xfb, 0xff, 0x01, 0xd3, 0x0c, 0xf6, 0x00, 0xda, 0xff, 0xfe, 0x00,
+    0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xfb, 0x00, 0x00, 0x04, 0xea, 0x00, 0x01, 0x34, 0xf3, 0xfb,
+    0xff, 0x01, 0xdb, 0x18, 0xf5, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d,
+    0xfc, 0x00, 0x02, 0x8f, 0xab, 0x04, 0xec, 0x00, 0x01, 0x28, 0xe7, 0xfb, 0xff, 0x01, 0xe7, 0x28,
+    0xf4, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xfd, 0x00, 0x04, 0x87,
+    0xff, 0xff, 0xab, 0x04, 0xee, 0x00, 0x01, 0x18, 0xdb, 0xfb, 0xff, 0x01, 0xf3, 0x34, 0xf3, 0x00,
+    0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xfe, 0x00, 0x00, 0x7c, 0xfd, 0xff,
+    0x01, 0xab, 0x04, 0xf0, 0x00, 0x01, 0x0c, 0xd3, 0xfb, 0xff, 0x01, 0xfb, 0x40, 0xf2, 0x00, 0xda,
+    0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0x02, 0x00, 0x00, 0x78, 0xfb, 0xff, 0x01,
+    0xab, 0x04, 0xf2, 0x00, 0x01, 0x08, 0xc3, 0xfb, 0xff, 0x01, 0xfb, 0x54, 0xf1, 0x00, 0xda, 0xff,
+    0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0x02, 0x00, 0x00, 0xab, 0xfa, 0xff, 0x01, 0xab,
+    0x04, 0xf4, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x00, 0x70, 0xf0, 0x00, 0xda, 0xff, 0xfe, 0x00,
+    0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0x03, 0x00, 0x00, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04,
+    0xf5, 0x00, 0x00, 0x97, 0xfa, 0xff, 0x00, 0x83, 0xef, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5,
+    0xfe, 0x00, 0xf8, 0x8d, 0xfe, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf7, 0x00,
+    0x00, 0x83, 0xfa, 0xff, 0x00, 0x97, 0xee, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00,
+    0xf8, 0x8d, 0xfd, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xf9, 0x00, 0x00, 0x70,
+    0xfa, 0xff, 0x01, 0xab, 0x04, 0xee, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8,
+    0x8d, 0xfc, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xfb, 0x00, 0x01, 0x54, 0xfb,
+    0xfb, 0xff, 0x01, 0xc3, 0x08, 0xed, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8,
+    0x8d, 0xfb, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x01, 0xab, 0x04, 0xfd, 0x00, 0x01, 0x40, 0xfb,
+    0xfb, 0xff, 0x01, 0xd3, 0x0c, 0xec, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8,
+    0x8d, 0xfa, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x05, 0xab, 0x04, 0x00, 0x00, 0x34, 0xf3, 0xfb,
+    0xff, 0x01, 0xdb, 0x18, 0xeb, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d,
+    0xf9, 0x00, 0x01, 0x04, 0xab, 0xfa, 0xff, 0x03, 0xab, 0x04, 0x28, 0xe7, 0xfb, 0xff, 0x01, 0xe7,
+    0x28, 0xea, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf8, 0x00, 0x01,
+    0x04, 0xab, 0xfa, 0xff, 0x01, 0xaf, 0xdb, 0xfb, 0xff, 0x01, 0xf3, 0x34, 0xe9, 0x00, 0xda, 0xff,
+    0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf7, 0x00, 0x01, 0x04, 0xab, 0xf4, 0xff, 0x01,
+    0xfb, 0x40, 0xe8, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf6, 0x00,
+    0x01, 0x04, 0xab, 0xf6, 0xff, 0x01, 0xfb, 0x54, 0xe7, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5,
+    0xfe, 0x00, 0xf8, 0x8d, 0xf5, 0x00, 0x01, 0x04, 0xab, 0xf7, 0xff, 0x00, 0x70, 0xe6, 0x00, 0xda,
+    0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf4, 0x00, 0x01, 0x04, 0xab, 0xf9, 0xff,
+    0x00, 0x83, 0xe5, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf3, 0x00,
+    0x01, 0x04, 0xab, 0xfb, 0xff, 0x00, 0x97, 0xe4, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe,
+    0x00, 0xf8, 0x8d, 0xf2, 0x00, 0x01, 0x04, 0xab, 0xfd, 0xff, 0x01, 0xab, 0x04, 0xe4, 0x00, 0xda,
+    0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf1, 0x00, 0x05, 0x04, 0xab, 0xff, 0xff,
+    0xc3, 0x08, 0xe3, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xf0, 0x00,
+    0x03, 0x04, 0xab, 0xd3, 0x0c, 0xe2, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8,
+    0x8d, 0xef, 0x00, 0x01, 0x04, 0x14, 0xe1, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00,
+    0xf8, 0x8d, 0xcd, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xcd, 0x00,
+    0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xcd, 0x00, 0xda, 0xff, 0xfe, 0x00,
+    0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xcd, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00,
+    0xf8, 0x8d, 0xcd, 0x00, 0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xcd, 0x00,
+    0xda, 0xff, 0xfe, 0x00, 0xf5, 0xc5, 0xfe, 0x00, 0xf8, 0x8d, 0xcd, 0x00,
+};
+
+const TOCropToolbarIconAtlas TOCropToolbarIconAtlases[TOCropToolbarIconAtlasScaleCount] = {
+    {
+        1, 40, 57, kTOCropToolbarIconAtlas1x, 984,
+        {
+            {23, 41, 17, 14}, // Done
+            {23, 22, 16, 16}, // Cancel
+            {0, 0, 18, 21}, // Rotate Counterclockwise
+            {19, 0, 18, 21}, // Rotate Clockwise
+            {0, 22, 22, 18}, // Reset
+            {0, 41, 22, 16}, // Clamp
+        },
+        {17.0f, 16.0f, 18.0f, 18.0f, 22.0f, 22.0f},
+        {14.0f, 16.0f, 21.0f, 21.0f, 18.0f, 16.0f},
+    },
+    {
+        2, 79, 112, kTOCropToolbarIconAtlas2x, 2355,
+        {
+            {45, 80, 34, 28}, // Done
+            {45, 43, 32, 32}, // Cancel
+            {0, 0, 36, 42}, // Rotate Counterclockwise
+            {37, 0, 36, 42}, // Rotate Clockwise
+            {0, 43, 44, 36}, // Reset
+            {0, 80, 44, 32}, // Clamp
+        },
+        {17.0f, 16.0f, 18.0f, 18.0f, 22.0f, 22.0f},
+        {14.0f, 16.0f, 21.0f, 21.0f, 18.0f, 16.0f},
+    },
+    {
+        3, 118, 167, kTOCropToolbarIconAtlas3x, 3548,
+        {
+            {67, 119, 51, 42}, // Done
+            {67, 64, 48, 48}, // Cancel
+            {0, 0, 54, 63}, // Rotate Counterclockwise
+            {55, 0, 54, 63}, // Rotate Clockwise
+            {0, 64, 66, 54}, // Reset
+            {0, 119, 66, 48}, // Clamp
+        },
+        {17.0f, 16.0f, 18.0f, 18.0f, 22.0f, 22.0f},
+        {14.0f, 16.0f, 21.0f, 21.0f, 18.0f, 16.0f},
+    },
+};
@@ -23,11 +23,19 @@
 #import <UIKit/UIKit.h>
 
 #if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropBatchProcessor.h"
+#import "TOCropMemoryAccountant.h"
+#import "TOCropRenderCache.h"
+#import "TOCropRenderJob.h"
 #import "TOCropToolbar.h"
 #import "TOCropView.h"
 #import "TOCropViewConstants.h"
 #import "TOCropViewControllerAspectRatioPreset.h"
 #else
+#import <TOCropViewController/TOCropBatchProcessor.h>
+#import <TOCropViewController/TOCropMemoryAccountant.h>
+#import <TOCropViewController/TOCropRenderCache.h>
+#import <TOCropViewController/TOCropRenderJob.h>
 #import <TOCropViewController/TOCropToolbar.h>
 #import <TOCropViewController/TOCropView.h>
 #import <TOCropViewController/TOCropViewConstants.h>
@@ -141,6 +149,33 @@
  */
 @property (nonatomic, assign) NSInteger angle;
 
+/**
+ The angle the image is straightened by, after `angle`, in degrees (See `TOCropView.straighteningAngle`).
+ The cropped images passed to the delegate and blocks are straightened, but the angle passed
+ alongside them is only `angle`, so read this when cropping the image yourself.
+
+ This property can be set before the controller is presented to have
+ the image 'restored' to a previous cropping layout.
+ */
+@property (nonatomic, assign) CGFloat straighteningAngle;
+
+/**
+ Let the user drag the four corners of a quadrilateral over the image, and flatten the region inside
+ it into a rectangle when cropping, such as to scan a page photographed at an angle
+ (See `TOCropView.perspectiveCorrectionEnabled`). The rect passed alongside the cropped image is the
+ one around the quadrilateral. This has no effect in the circular cropping style. (Default is NO)
+ */
+@property (nonatomic, assign) BOOL perspectiveCorrectionEnabled;
+
+/**
+ In the coordinate space of the image, the corners of the region flattened while
+ `perspectiveCorrectionEnabled` is on (See `TOCropView.cropQuadrilateral`).
+
+ This property can be set before the controller is presented to have
+ the image 'restored' to a previous cropping layout.
+ */
+@property (nonatomic, assign) TOCropQuadrilateral cropQuadrilateral;
+
 /**
  The toolbar view managed by this view controller.
  */
@@ -361,6 +396,35 @@
  */
 @property (nullable, nonatomic, strong) void (^onDidCropToCircleImage)(UIImage *_Nonnull image, CGRect cropRect, NSInteger angle);
 
+/**
+ While the cropped image is being rendered in the background after the user taps 'Done',
+ the job rendering it. Use this to show the progress of large crops, or to cancel one.
+ It is cancelled automatically when the user cancels, or this view controller is deallocated.
+ */
+@property (nullable, nonatomic, strong, readonly) TOCropRenderJob *cropRenderJob;
+
+/**
+ When enabled, the cropped image starts rendering in the background as soon as the user stops
+ adjusting the crop, so it's usually ready by the time they tap 'Done'. Any new adjustment cancels it.
+ This only applies when a delegate method or block that receives the cropped image is set, and
+ holds a copy of the cropped image in memory while the user is idle.
+
+ Default is NO.
+ */
+@property (nonatomic, assign) BOOL speculativeRenderingEnabled;
+
+/**
+ While speculative rendering is enabled, the number of times 'Done' was tapped
+ and the same crop had already been rendered (or was being rendered) in the background
+ */
+@property (nonatomic, readonly) NSUInteger speculativeRenderHitCount;
+
+/**
+ While speculative rendering is enabled, the number of times 'Done' was tapped and the crop had to be
+ rendered from the start, because the crop hadn't settled yet, or had changed since it was rendered
+ */
+@property (nonatomic, readonly) NSUInteger speculativeRenderMissCount;
+
 ///------------------------------------------------
 /// @name Object Creation
 ///------------------------------------------------
@@ -67,6 +67,15 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
 /* Flag to perform initial setup on the first run */
 @property (nonatomic, assign) BOOL firstTime;
 
+/* The background render of the cropped image, while one is in progress, and who to pass the image to */
+@property (nonatomic, strong, readwrite) TOCropRenderJob *cropRenderJob;
+@property (nonatomic, copy) void (^cropRenderCompletion)(UIImage *image);
+
+/* A render of the crop started while the user is idle, in case they tap 'Done' next */
+@property (nonatomic, strong) TOCropRenderJob *speculativeRenderJob;
+@property (nonatomic, assign, readwrite) NSUInteger speculativeRenderHitCount;
+@property (nonatomic, assign, readwrite) NSUInteger speculativeRenderMissCount;
+
 @end
 
 @implementation TOCropViewController
@@ -109,6 +118,12 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     return [self initWithCroppingStyle:TOCropViewCroppingStyleDefault image:image];
 }
 
+- (void)dealloc {
+    // Nothing is left to receive the image, so stop rendering it
+    [_cropRenderJob cancel];
+    [_speculativeRenderJob cancel];
+}
+
 - (void)viewDidLoad {
     [super viewDidLoad];
 
@@ -648,6 +663,7 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
         self.aspectRatioLockEnabled = NO;
     }
 
+    [self cancelSpeculativeRender];
     [self.cropView resetLayoutToDefaultAnimated:animated];
 }
 
@@ -700,24 +716,29 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
 
 - (void)setAspectRatioPreset:(CGSize)aspectRatioPreset animated:(BOOL)animated {
     _aspectRatioPreset = aspectRatioPreset;
+    [self cancelSpeculativeRender];
     [self.cropView setAspectRatio:aspectRatioPreset animated:animated];
 }
 
 - (void)rotateCropViewClockwise {
     self.toolbar.disableRotationButtons = YES;
+    [self cancelSpeculativeRender];
     [self.cropView rotateImageNinetyDegreesAnimated:YES
                                           clockwise:YES
                                          completion:^(BOOL success) {
                                              self.toolbar.disableRotationButtons = NO;
+                                             [self startSpeculativeRender];
                                          }];
 }
 
 - (void)rotateCropViewCounterclockwise {
     self.toolbar.disableRotationButtons = YES;
+    [self cancelSpeculativeRender];
     [self.cropView rotateImageNinetyDegreesAnimated:YES
                                           clockwise:NO
                                          completion:^(BOOL success) {
                                              self.toolbar.disableRotationButtons = NO;
+                                             [self startSpeculativeRender];
                                          }];
 }
 
@@ -730,6 +751,14 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     self.toolbar.resetButtonEnabled = NO;
 }
 
+- (void)cropViewDidBeginEditing:(TOCropView *)cropView {
+    [self cancelSpeculativeRender];
+}
+
+- (void)cropViewDidEndEditing:(TOCropView *)cropView {
+    [self startSpeculativeRender];
+}
+
 #pragma mark - Presentation Handling -
 - (void)presentAnimatedFromParentViewController:(UIViewController *)viewController
                                        fromView:(UIView *)fromView
@@ -901,6 +930,9 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
 }
 
 - (void)dismissCropViewController {
+    [self.cropRenderJob cancel];
+    [self cancelSpeculativeRender];
+
     bool isDelegateOrCallbackHandled = NO;
 
     // Check if the delegate method was implemented and call if so
@@ -929,6 +961,13 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     CGRect cropFrame = self.cropView.imageCropFrame;
     NSInteger angle = self.cropView.angle;
 
+    // A flattened crop reports the rect around the quadrilateral it was flattened from
+    const BOOL perspectiveCorrected = [self rendersPerspectiveCorrectedImageWithCircularClip:
+                                                (self.croppingStyle == TOCropViewCroppingStyleCircular)];
+    if (perspectiveCorrected) {
+        cropFrame = TOCropQuadrilateralBoundingRect(self.cropView.cropQuadrilateral);
+    }
+
     if (self.onDidTapDone) {
         dispatch_async(dispatch_get_main_queue(), ^{
             self.onDidTapDone();
@@ -938,6 +977,9 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     // If desired, when the user taps done, show an activity sheet
     if (self.showActivitySheetOnDone) {
         TOActivityCroppedImageProvider *imageItem = [[TOActivityCroppedImageProvider alloc] initWithImage:self.image cropFrame:cropFrame angle:angle circular:(self.croppingStyle == TOCropViewCroppingStyleCircular)];
+        imageItem.straighteningAngle = self.cropView.straighteningAngle;
+        imageItem.perspectiveCorrected = perspectiveCorrected;
+        imageItem.quadrilateral = self.cropView.cropQuadrilateral;
         TOCroppedImageAttributes *attributes = [[TOCroppedImageAttributes alloc] initWithCroppedFrame:cropFrame angle:angle originalImageSize:self.image.size];
 
         NSMutableArray *activityItems = [@[imageItem, attributes] mutableCopy];
@@ -1011,47 +1053,33 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     BOOL isDidCropToImageCallbackAvailable = self.onDidCropToRect != nil;
 
     // If cropping circular and the circular generation delegate/block is implemented, call it
+    __weak typeof(self) weakSelf = self;
     if (self.croppingStyle == TOCropViewCroppingStyleCircular && (isCircularImageDelegateAvailable || isCircularImageCallbackAvailable)) {
-        UIImage *image = [self.image croppedImageWithFrame:cropFrame angle:angle circularClip:YES];
-
-        // Dispatch on the next run-loop so the animation isn't interuppted by the crop operation
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.03f * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        // Render in the background so the animation isn't interrupted by the crop operation
+        [self startCropRenderJobWithFrame:cropFrame angle:angle circular:YES completion:^(UIImage *image) {
             if (isCircularImageDelegateAvailable) {
-                [self.delegate cropViewController:self didCropToCircularImage:image withRect:cropFrame angle:angle];
+                [weakSelf.delegate cropViewController:weakSelf didCropToCircularImage:image withRect:cropFrame angle:angle];
             }
             if (isCircularImageCallbackAvailable) {
-                self.onDidCropToCircleImage(image, cropFrame, angle);
+                weakSelf.onDidCropToCircleImage(image, cropFrame, angle);
             }
-
-            // Let hosts that keep the controller on screen commit again
-            [self setDoneButtonsEnabled:YES];
-        });
+        }];
 
         isCallbackOrDelegateHandled = YES;
         willRestoreDoneButtonsAfterCallback = YES;
     }
     // If the delegate/block that requires the specific cropped image is provided, call it
     else if (isDidCropToImageDelegateAvailable || isDidCropToImageCallbackAvailable) {
-        UIImage *image = nil;
-        if (angle == 0 && CGRectEqualToRect(cropFrame, (CGRect){CGPointZero, self.image.size})) {
-            image = self.image;
-        } else {
-            image = [self.image croppedImageWithFrame:cropFrame angle:angle circularClip:NO];
-        }
-
-        // Dispatch on the next run-loop so the animation isn't interuppted by the crop operation
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.03f * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        // Render in the background so the animation isn't interrupted by the crop operation
+        [self startCropRenderJobWithFrame:cropFrame angle:angle circular:NO completion:^(UIImage *image) {
             if (isDidCropToImageDelegateAvailable) {
-                [self.delegate cropViewController:self didCropToImage:image withRect:cropFrame angle:angle];
+                [weakSelf.delegate cropViewController:weakSelf didCropToImage:image withRect:cropFrame angle:angle];
             }
 
             if (isDidCropToImageCallbackAvailable) {
-                self.onDidCropToRect(image, cropFrame, angle);
+                weakSelf.onDidCropToRect(image, cropFrame, angle);
             }
-
-            // Let hosts that keep the controller on screen commit again
-            [self setDoneButtonsEnabled:YES];
-        });
+        }];
 
         isCallbackOrDelegateHandled = YES;
         willRestoreDoneButtonsAfterCallback = YES;
@@ -1065,6 +1093,131 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     }
 }
 
+- (void)startCropRenderJobWithFrame:(CGRect)frame
+                              angle:(NSInteger)angle
+                           circular:(BOOL)circular
+                         completion:(void (^)(UIImage *image))completion {
+    [self.cropRenderJob cancel];
+    self.cropRenderCompletion = completion;
+
+    // If the same crop was already rendered while the user was idle, use that
+    const CGFloat straighteningAngle = self.cropView.straighteningAngle;
+    const BOOL perspectiveCorrected = [self rendersPerspectiveCorrectedImageWithCircularClip:circular];
+    TOCropRenderJob *speculativeJob = self.speculativeRenderJob;
+    self.speculativeRenderJob = nil;
+    if (self.speculativeRenderingEnabled) {
+        const BOOL isHit = (speculativeJob != nil && !speculativeJob.cancelled && speculativeJob.angle == angle &&
+                            speculativeJob.straighteningAngle == straighteningAngle &&
+                            speculativeJob.circular == circular && CGRectEqualToRect(speculativeJob.frame, frame) &&
+                            speculativeJob.perspectiveCorrected == perspectiveCorrected &&
+                            (!perspectiveCorrected ||
+                             TOCropQuadrilateralEqualToQuadrilateral(speculativeJob.quadrilateral, self.cropView.cropQuadrilateral)));
+        if (isHit) {
+            self.speculativeRenderHitCount++;
+            self.cropRenderJob = speculativeJob;
+            if (speculativeJob.finished) {
+                [self cropRenderJobDidFinish:speculativeJob];
+            }
+            return;
+        }
+        self.speculativeRenderMissCount++;
+    }
+    [speculativeJob cancel];
+
+    TOCropRenderJob *renderJob = [self renderJobWithFrame:frame angle:angle circular:circular];
+    self.cropRenderJob = renderJob;
+    [self startRenderJob:renderJob];
+}
+
+// Whether the crop is flattened out of the crop view's quadrilateral, rather than cut out of its crop frame
+- (BOOL)rendersPerspectiveCorrectedImageWithCircularClip:(BOOL)circular {
+    return self.cropView.perspectiveCorrectionEnabled && !circular;
+}
+
+- (TOCropRenderJob *)renderJobWithFrame:(CGRect)frame angle:(NSInteger)angle circular:(BOOL)circular {
+    if ([self rendersPerspectiveCorrectedImageWithCircularClip:circular]) {
+        return [[TOCropRenderJob alloc] initWithImage:self.image
+                                        quadrilateral:self.cropView.cropQuadrilateral
+                                                angle:angle
+                                   straighteningAngle:self.cropView.straighteningAngle];
+    }
+
+    return [[TOCropRenderJob alloc] initWithImage:self.image
+                                            frame:frame
+                                            angle:angle
+                               straighteningAngle:self.cropView.straighteningAngle
+                                         circular:circular];
+}
+
+- (void)startRenderJob:(TOCropRenderJob *)renderJob {
+    // The job doesn't retain the controller, so it can still be deallocated (cancelling the crop) mid-render
+    __weak typeof(self) weakSelf = self;
+    [renderJob startWithCompletion:^(UIImage *croppedImage) {
+        [weakSelf cropRenderJobDidFinish:renderJob];
+    }];
+}
+
+- (void)cropRenderJobDidFinish:(TOCropRenderJob *)renderJob {
+    // Speculative renders wait until 'Done' is tapped, and replaced renders have nothing to report
+    if (renderJob != self.cropRenderJob) {
+        return;
+    }
+
+    void (^completion)(UIImage *) = self.cropRenderCompletion;
+    self.cropRenderJob = nil;
+    self.cropRenderCompletion = nil;
+
+    // Only a cancelled job has nothing to report. As when the crop was rendered in place, the
+    // delegate and blocks are still called back if the render itself failed.
+    if (!renderJob.cancelled && completion) {
+        completion(renderJob.croppedImage);
+    }
+
+    // Let hosts that keep the controller on screen commit again
+    [self setDoneButtonsEnabled:YES];
+}
+
+#pragma mark - Speculative Rendering -
+
+// Whether tapping 'Done' would render an image to pass to the delegate or blocks, and if so, whether it's circular
+- (BOOL)willRenderCroppedImageWithCircularClip:(BOOL *)circular {
+    if (self.showActivitySheetOnDone) {
+        return NO;
+    }
+
+    // Mirrors the order the callbacks are checked in when 'Done' is tapped
+    if (self.croppingStyle == TOCropViewCroppingStyleCircular &&
+        ([self.delegate respondsToSelector:@selector(cropViewController:didCropToCircularImage:withRect:angle:)] ||
+         self.onDidCropToCircleImage != nil)) {
+        *circular = YES;
+        return YES;
+    }
+
+    *circular = NO;
+    return ([self.delegate respondsToSelector:@selector(cropViewController:didCropToImage:withRect:angle:)] ||
+            self.onDidCropToRect != nil);
+}
+
+- (void)startSpeculativeRender {
+    BOOL circular = NO;
+    if (!self.speculativeRenderingEnabled || self.cropRenderJob != nil ||
+        ![self willRenderCroppedImageWithCircularClip:&circular]) {
+        return;
+    }
+
+    [self.speculativeRenderJob cancel];
+    TOCropRenderJob *renderJob = [self renderJobWithFrame:self.cropView.imageCropFrame
+                                                    angle:self.cropView.angle
+                                                 circular:circular];
+    self.speculativeRenderJob = renderJob;
+    [self startRenderJob:renderJob];
+}
+
+- (void)cancelSpeculativeRender {
+    [self.speculativeRenderJob cancel];
+    self.speculativeRenderJob = nil;
+}
+
 - (void)setDoneButtonsEnabled:(BOOL)enabled {
     self.toolbar.doneTextButton.enabled = enabled;
     self.toolbar.doneIconButton.enabled = enabled;
@@ -1266,6 +1419,30 @@ static const CGFloat kTOCropViewControllerToolbarHeight = 44.0f;
     return self.cropView.angle;
 }
 
+- (void)setStraighteningAngle:(CGFloat)straighteningAngle {
+    self.cropView.straighteningAngle = straighteningAngle;
+}
+
+- (CGFloat)straighteningAngle {
+    return self.cropView.straighteningAngle;
+}
+
+- (void)setPerspectiveCorrectionEnabled:(BOOL)perspectiveCorrectionEnabled {
+    self.cropView.perspectiveCorrectionEnabled = perspectiveCorrectionEnabled;
+}
+
+- (BOOL)perspectiveCorrectionEnabled {
+    return self.cropView.perspectiveCorrectionEnabled;
+}
+
+- (void)setCropQuadrilateral:(TOCropQuadrilateral)cropQuadrilateral {
+    self.cropView.cropQuadrilateral = cropQuadrilateral;
+}
+
+- (TOCropQuadrilateral)cropQuadrilateral {
+    return self.cropView.cropQuadrilateral;
+}
+
 - (void)setImageCropFrame:(CGRect)imageCropFrame {
     self.cropView.imageCropFrame = imageCropFrame;
 }
@@ -22,6 +22,12 @@
 
 #import <UIKit/UIKit.h>
 
+#if !__has_include(<TOCropViewController/TOCropViewConstants.h>)
+#import "TOCropViewConstants.h"
+#else
+#import <TOCropViewController/TOCropViewConstants.h>
+#endif
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface TOCropOverlayView : UIView
@@ -35,6 +41,12 @@ NS_ASSUME_NONNULL_BEGIN
 /** Add/Remove the interior vertical grid lines. */
 @property (nonatomic, assign) BOOL displayVerticalGridLines;
 
+/** How the interior grid divides up the crop box. Default is `TOCropViewGridStyleThirds`. */
+@property (nonatomic, assign) TOCropViewGridStyle gridStyle;
+
+/** The number of rows and columns when `gridStyle` is `TOCropViewGridStyleUniform`, from 1 to 12. Default is 3. */
+@property (nonatomic, assign) NSUInteger gridDivisions;
+
 /** Shows and hides the interior grid lines with an optional crossfade animation. */
 - (void)setGridHidden:(BOOL)hidden animated:(BOOL)animated;
 
@@ -21,25 +21,23 @@
 //  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "TOCropOverlayView.h"
+#import "TOCropOverlayGeometry.h"
 
-static const CGFloat kTOCropOverLayerCornerWidth = 20.0f;
-
-@interface TOCropOverlayView ()
-
-@property (nonatomic, strong) NSArray *horizontalGridLines;
-@property (nonatomic, strong) NSArray *verticalGridLines;
-
-@property (nonatomic, strong) NSArray *outerLineViews;  // top, right, bottom, left
+@interface TOCropOverlayView () {
+    TOCropOverlayLine _lines[TOCropOverlayMaximumLineCount]; /* The lines currently drawn, to tell which have moved on the next layout */
+    size_t _lineCount;
+}
 
-@property (nonatomic, strong) NSArray *topLeftLineViews;  // vertical, horizontal
-@property (nonatomic, strong) NSArray *bottomLeftLineViews;
-@property (nonatomic, strong) NSArray *bottomRightLineViews;
-@property (nonatomic, strong) NSArray *topRightLineViews;
+@property (nonatomic, strong) CAShapeLayer *gridLayer; /* Draws the interior grid, which fades in and out separately to the outline */
 
 @end
 
 @implementation TOCropOverlayView
 
++ (Class)layerClass {
+    return [CAShapeLayer class];
+}
+
 - (instancetype)initWithFrame:(CGRect)frame {
     if (self = [super initWithFrame:frame]) {
         self.clipsToBounds = NO;
@@ -50,177 +48,148 @@ static const CGFloat kTOCropOverLayerCornerWidth = 20.0f;
 }
 
 - (void)setup {
-    UIView * (^newLineView)(void) = ^UIView *(void) {
-        return [self createNewLineView];
-    };
-
-    _outerLineViews = @[newLineView(), newLineView(), newLineView(), newLineView()];
-
-    _topLeftLineViews = @[newLineView(), newLineView()];
-    _bottomLeftLineViews = @[newLineView(), newLineView()];
-    _topRightLineViews = @[newLineView(), newLineView()];
-    _bottomRightLineViews = @[newLineView(), newLineView()];
-
-    self.displayHorizontalGridLines = YES;
-    self.displayVerticalGridLines = YES;
+    // The border and corners are drawn as one path by this view's own layer,
+    // and every grid line as one path by a single layer on top of it
+    CAShapeLayer *outlineLayer = (CAShapeLayer *)self.layer;
+    outlineLayer.fillColor = [UIColor whiteColor].CGColor;
+
+    _gridLayer = [CAShapeLayer layer];
+    _gridLayer.fillColor = [UIColor whiteColor].CGColor;
+    [outlineLayer addSublayer:_gridLayer];
+
+    _gridStyle = TOCropViewGridStyleThirds;
+    _gridDivisions = 3;
+    _displayHorizontalGridLines = YES;
+    _displayVerticalGridLines = YES;
+    [self layoutLines];
 }
 
 - (void)setFrame:(CGRect)frame {
     [super setFrame:frame];
-    if (_outerLineViews) {
+    if (_gridLayer) {
         [self layoutLines];
     }
 }
 
 - (void)didMoveToSuperview {
     [super didMoveToSuperview];
-    if (_outerLineViews) {
+    if (_gridLayer) {
         [self layoutLines];
     }
 }
 
-- (void)layoutLines {
-    CGSize boundsSize = self.bounds.size;
-
-    // border lines
-    for (NSInteger i = 0; i < 4; i++) {
-        UIView *lineView = self.outerLineViews[i];
-
-        CGRect frame = CGRectZero;
-        switch (i) {
-        case 0:
-            frame = (CGRect){-1.0f, -1.0f, boundsSize.width + 2.0f, 1.0f};
-            break;  // top
-        case 1:
-            frame = (CGRect){boundsSize.width, 0.0f, 1.0f, boundsSize.height};
-            break;  // right
-        case 2:
-            frame = (CGRect){-1.0f, boundsSize.height, boundsSize.width + 2.0f, 1.0f};
-            break;  // bottom
-        case 3:
-            frame = (CGRect){-1.0f, 0, 1.0f, boundsSize.height + 1.0f};
-            break;  // left
-        }
-
-        lineView.frame = frame;
-    }
-
-    // corner liness
-    NSArray *cornerLines = @[self.topLeftLineViews, self.topRightLineViews, self.bottomRightLineViews, self.bottomLeftLineViews];
-    for (NSInteger i = 0; i < 4; i++) {
-        NSArray *cornerLine = cornerLines[i];
-
-        CGRect verticalFrame = CGRectZero, horizontalFrame = CGRectZero;
-        switch (i) {
-        case 0:  // top left
-            verticalFrame = (CGRect){-3.0f, -3.0f, 3.0f, kTOCropOverLayerCornerWidth + 3.0f};
-            horizontalFrame = (CGRect){0, -3.0f, kTOCropOverLayerCornerWidth, 3.0f};
-            break;
-        case 1:  // top right
-            verticalFrame = (CGRect){boundsSize.width, -3.0f, 3.0f, kTOCropOverLayerCornerWidth + 3.0f};
-            horizontalFrame = (CGRect){boundsSize.width - kTOCropOverLayerCornerWidth, -3.0f, kTOCropOverLayerCornerWidth, 3.0f};
-            break;
-        case 2:  // bottom right
-            verticalFrame = (CGRect){boundsSize.width, boundsSize.height - kTOCropOverLayerCornerWidth, 3.0f, kTOCropOverLayerCornerWidth + 3.0f};
-            horizontalFrame = (CGRect){boundsSize.width - kTOCropOverLayerCornerWidth, boundsSize.height, kTOCropOverLayerCornerWidth, 3.0f};
-            break;
-        case 3:  // bottom left
-            verticalFrame = (CGRect){-3.0f, boundsSize.height - kTOCropOverLayerCornerWidth, 3.0f, kTOCropOverLayerCornerWidth};
-            horizontalFrame = (CGRect){-3.0f, boundsSize.height, kTOCropOverLayerCornerWidth + 3.0f, 3.0f};
-            break;
-        }
+- (void)traitCollectionDidChange:(UITraitCollection *)previousTraitCollection {
+    [super traitCollectionDidChange:previousTraitCollection];
 
-        [cornerLine[0] setFrame:verticalFrame];
-        [cornerLine[1] setFrame:horizontalFrame];
+    // The grid lines are a pixel thick, so they change with the display scale
+    if (self.traitCollection.displayScale != previousTraitCollection.displayScale) {
+        [self layoutLines];
     }
+}
 
-    // grid lines - horizontal
+- (void)layoutLines {
     // (displayScale can be 0 before the view joins a window)
-    CGFloat thickness = 1.0f / MAX(1.0f, self.traitCollection.displayScale);
-    NSInteger numberOfLines = self.horizontalGridLines.count;
-    CGFloat padding = (CGRectGetHeight(self.bounds) - (thickness * numberOfLines)) / (numberOfLines + 1);
-    for (NSInteger i = 0; i < numberOfLines; i++) {
-        UIView *lineView = self.horizontalGridLines[i];
-        CGRect frame = CGRectZero;
-        frame.size.height = thickness;
-        frame.size.width = CGRectGetWidth(self.bounds);
-        frame.origin.y = (padding * (i + 1)) + (thickness * i);
-        lineView.frame = frame;
+    const CGFloat scale = MAX(1.0f, self.traitCollection.displayScale);
+    self.gridLayer.contentsScale = scale;
+
+    TOCropOverlayStyle style;
+    style.gridStyle = (TOCropOverlayGridStyle)self.gridStyle;
+    style.gridDivisions = (unsigned int)MIN(self.gridDivisions, (NSUInteger)TOCropOverlayMaximumGridDivisions);
+    style.horizontalGridLines = self.displayHorizontalGridLines;
+    style.verticalGridLines = self.displayVerticalGridLines;
+    style.gridLineThickness = 1.0f / scale;
+
+    const CGSize boundsSize = self.bounds.size;
+    TOCropOverlayLine lines[TOCropOverlayMaximumLineCount];
+    const size_t lineCount = TOCropOverlayGenerateLines((TOCropSize){boundsSize.width, boundsSize.height}, &style, lines);
+
+    // Only rebuild the paths for the parts of the overlay that actually moved. Moving the
+    // crop box without resizing it (such as while it's being re-centered) leaves them all alone.
+    const unsigned int outlineKinds = TOCropOverlayLineBorder | TOCropOverlayLineCorner;
+    const TOCropRect outlineDirtyRect = TOCropOverlayDirtyRect(_lines, _lineCount, lines, lineCount, outlineKinds);
+    const TOCropRect gridDirtyRect = TOCropOverlayDirtyRect(_lines, _lineCount, lines, lineCount, TOCropOverlayLineGrid);
+
+    memcpy(_lines, lines, sizeof(TOCropOverlayLine) * lineCount);
+    _lineCount = lineCount;
+
+    if (outlineDirtyRect.size.width > 0.0 && outlineDirtyRect.size.height > 0.0) {
+        [self updatePathOfLayer:(CAShapeLayer *)self.layer withLinesOfKinds:outlineKinds];
     }
-
-    // grid lines - vertical
-    numberOfLines = self.verticalGridLines.count;
-    padding = (CGRectGetWidth(self.bounds) - (thickness * numberOfLines)) / (numberOfLines + 1);
-    for (NSInteger i = 0; i < numberOfLines; i++) {
-        UIView *lineView = self.verticalGridLines[i];
-        CGRect frame = CGRectZero;
-        frame.size.width = thickness;
-        frame.size.height = CGRectGetHeight(self.bounds);
-        frame.origin.x = (padding * (i + 1)) + (thickness * i);
-        lineView.frame = frame;
+    if (gridDirtyRect.size.width > 0.0 && gridDirtyRect.size.height > 0.0) {
+        [self updatePathOfLayer:self.gridLayer withLinesOfKinds:TOCropOverlayLineGrid];
     }
 }
 
-- (void)setGridHidden:(BOOL)hidden animated:(BOOL)animated {
-    _gridHidden = hidden;
-
-    if (animated == NO) {
-        for (UIView *lineView in self.horizontalGridLines) {
-            lineView.alpha = hidden ? 0.0f : 1.0f;
+- (void)updatePathOfLayer:(CAShapeLayer *)layer withLinesOfKinds:(unsigned int)kinds {
+    CGMutablePathRef path = CGPathCreateMutable();
+    for (size_t i = 0; i < _lineCount; i++) {
+        if (_lines[i].kind & kinds) {
+            const TOCropRect rect = _lines[i].rect;
+            CGPathAddRect(path, NULL, (CGRect){{rect.origin.x, rect.origin.y}, {rect.size.width, rect.size.height}});
         }
+    }
 
-        for (UIView *lineView in self.verticalGridLines) {
-            lineView.alpha = hidden ? 0.0f : 1.0f;
+    // When the view is resized inside an animation block, its lines need to be animated along with it.
+    // Paths aren't animated by UIView, so copy the timing of the animation it added for the new size.
+    CABasicAnimation *pathAnimation = nil;
+    if ([UIView inheritedAnimationDuration] > 0.0) {
+        CAAnimation *sizeAnimation = [self.layer animationForKey:@"bounds.size"] ?: [self.layer animationForKey:@"bounds"];
+        if ([sizeAnimation isKindOfClass:[CABasicAnimation class]]) {
+            pathAnimation = [sizeAnimation copy];
+        } else {
+            pathAnimation = [CABasicAnimation animation];
+            pathAnimation.duration = [UIView inheritedAnimationDuration];
+            pathAnimation.timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];
         }
+    }
 
-        return;
+    if (pathAnimation && layer.path) {
+        CAShapeLayer *presentationLayer = layer.presentationLayer;
+        pathAnimation.keyPath = @"path";
+        pathAnimation.additive = NO;
+        pathAnimation.fromValue = (__bridge id)(presentationLayer.path ?: layer.path);
+        pathAnimation.toValue = (__bridge id)path;
+        [layer addAnimation:pathAnimation forKey:@"path"];
     }
 
-    [UIView animateWithDuration:hidden ? 0.35f : 0.2f
-                     animations:^{
-                         for (UIView *lineView in self.horizontalGridLines)
-                             lineView.alpha = hidden ? 0.0f : 1.0f;
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    layer.path = path;
+    [CATransaction commit];
 
-                         for (UIView *lineView in self.verticalGridLines)
-                             lineView.alpha = hidden ? 0.0f : 1.0f;
-                     }];
+    CGPathRelease(path);
+}
+
+- (void)setGridHidden:(BOOL)hidden animated:(BOOL)animated {
+    _gridHidden = hidden;
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:!animated];
+    [CATransaction setAnimationDuration:hidden ? 0.35f : 0.2f];
+    [CATransaction setAnimationTimingFunction:[CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut]];
+    self.gridLayer.opacity = hidden ? 0.0f : 1.0f;
+    [CATransaction commit];
 }
 
 #pragma mark - Property methods
 
 - (void)setDisplayHorizontalGridLines:(BOOL)displayHorizontalGridLines {
     _displayHorizontalGridLines = displayHorizontalGridLines;
-
-    [self.horizontalGridLines enumerateObjectsUsingBlock:^(UIView *__nonnull lineView, NSUInteger idx, BOOL *__nonnull stop) {
-        [lineView removeFromSuperview];
-    }];
-
-    if (_displayHorizontalGridLines) {
-        self.horizontalGridLines = @[[self createNewLineView], [self createNewLineView]];
-    } else {
-        self.horizontalGridLines = @[];
-    }
-
-    // Re-apply the current visibility to the rebuilt lines and lay them out
-    [self setGridHidden:_gridHidden animated:NO];
     [self layoutLines];
 }
 
 - (void)setDisplayVerticalGridLines:(BOOL)displayVerticalGridLines {
     _displayVerticalGridLines = displayVerticalGridLines;
+    [self layoutLines];
+}
 
-    [self.verticalGridLines enumerateObjectsUsingBlock:^(UIView *__nonnull lineView, NSUInteger idx, BOOL *__nonnull stop) {
-        [lineView removeFromSuperview];
-    }];
-
-    if (_displayVerticalGridLines) {
-        self.verticalGridLines = @[[self createNewLineView], [self createNewLineView]];
-    } else {
-        self.verticalGridLines = @[];
-    }
+- (void)setGridStyle:(TOCropViewGridStyle)gridStyle {
+    _gridStyle = gridStyle;
+    [self layoutLines];
+}
 
-    // Re-apply the current visibility to the rebuilt lines and lay them out
-    [self setGridHidden:_gridHidden animated:NO];
+- (void)setGridDivisions:(NSUInteger)gridDivisions {
+    _gridDivisions = MAX(1, MIN(gridDivisions, (NSUInteger)TOCropOverlayMaximumGridDivisions));
     [self layoutLines];
 }
 
@@ -228,13 +197,4 @@ static const CGFloat kTOCropOverLayerCornerWidth = 20.0f;
     [self setGridHidden:gridHidden animated:NO];
 }
 
-#pragma mark - Private methods
-
-- (nonnull UIView *)createNewLineView {
-    UIView *newLine = [[UIView alloc] initWithFrame:CGRectZero];
-    newLine.backgroundColor = [UIColor whiteColor];
-    [self addSubview:newLine];
-    return newLine;
-}
-
 @end
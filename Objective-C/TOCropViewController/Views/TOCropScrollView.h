@@ -34,6 +34,27 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nullable, nonatomic, copy) void (^touchesCancelled)(void);
 @property (nullable, nonatomic, copy) void (^touchesEnded)(void);
 
+/**
+ While a layout transaction is open, changes to the content inset, size and offset, and to the
+ zoom scale and its bounds, are held back rather than applied. Reading those properties returns the
+ pending values, so layout code can carry on as normal. When the outermost transaction commits,
+ each property that ended up changed is written to the scroll view exactly once.
+
+ Setting the zoom scale inside a transaction also resizes the pending content size and moves the
+ pending content offset, zooming around the middle of the visible area and keeping the offset inside
+ the content, the same way UIScrollView does when the zoom scale is set outside of one.
+
+ Transactions can be nested; only the outermost commit applies anything.
+ */
+- (void)beginLayoutTransaction;
+- (void)commitLayoutTransaction;
+
+/** Whether a layout transaction is currently open */
+@property (nonatomic, readonly) BOOL layoutTransactionOpen;
+
+/** The number of properties that the most recent commit actually wrote to the scroll view */
+@property (nonatomic, readonly) NSUInteger committedPropertyWriteCount;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -22,8 +22,219 @@
 
 #import "TOCropScrollView.h"
 
+// The layout properties that a transaction holds back, along with
+// which of them were assigned while it was open
+typedef struct {
+    UIEdgeInsets contentInset;
+    CGSize contentSize;
+    CGPoint contentOffset;
+    CGFloat zoomScale;
+    CGFloat minimumZoomScale;
+    CGFloat maximumZoomScale;
+    BOOL contentInsetChanged;
+    BOOL contentSizeChanged;
+    BOOL contentOffsetChanged;
+    BOOL zoomScaleChanged;
+    BOOL zoomBoundsChanged;
+} TOCropScrollViewLayout;
+
+@interface TOCropScrollView ()
+
+@property (nonatomic, assign) NSInteger layoutTransactionDepth;         /* How many transactions are open. Writes are applied when the last one commits */
+@property (nonatomic, assign) TOCropScrollViewLayout pendingLayout;      /* The values to be applied when the transaction commits */
+@property (nonatomic, assign, readwrite) NSUInteger committedPropertyWriteCount;
+
+@end
+
 @implementation TOCropScrollView
 
+#pragma mark - Layout Transactions -
+
+- (void)beginLayoutTransaction {
+    if (self.layoutTransactionDepth++ > 0) {
+        return;
+    }
+
+    TOCropScrollViewLayout layout = {0};
+    layout.contentInset = super.contentInset;
+    layout.contentSize = super.contentSize;
+    layout.contentOffset = super.contentOffset;
+    layout.zoomScale = super.zoomScale;
+    layout.minimumZoomScale = super.minimumZoomScale;
+    layout.maximumZoomScale = super.maximumZoomScale;
+    self.pendingLayout = layout;
+}
+
+- (void)commitLayoutTransaction {
+    NSAssert(self.layoutTransactionDepth > 0, @"A layout transaction was committed without being started");
+    if (--self.layoutTransactionDepth > 0) {
+        return;
+    }
+
+    const TOCropScrollViewLayout layout = self.pendingLayout;
+    NSUInteger writeCount = 0;
+
+    // The zoom bounds go first so the zoom scale isn't clamped against stale values.
+    // Setting the zoom scale then resizes the content, and moves the offset, for us,
+    // so those are only written if they still differ afterwards.
+    if (layout.zoomBoundsChanged) {
+        if (super.minimumZoomScale != layout.minimumZoomScale) {
+            super.minimumZoomScale = layout.minimumZoomScale;
+            writeCount++;
+        }
+        if (super.maximumZoomScale != layout.maximumZoomScale) {
+            super.maximumZoomScale = layout.maximumZoomScale;
+            writeCount++;
+        }
+    }
+
+    // Re-applying an unchanged zoom scale is still needed after its bounds change,
+    // as it's what makes the scroll view update its content to match
+    if (layout.zoomScaleChanged && (super.zoomScale != layout.zoomScale || layout.zoomBoundsChanged)) {
+        super.zoomScale = layout.zoomScale;
+        writeCount++;
+    }
+
+    if (layout.contentSizeChanged && !CGSizeEqualToSize(super.contentSize, layout.contentSize)) {
+        super.contentSize = layout.contentSize;
+        writeCount++;
+    }
+
+    if (layout.contentInsetChanged && !UIEdgeInsetsEqualToEdgeInsets(super.contentInset, layout.contentInset)) {
+        super.contentInset = layout.contentInset;
+        writeCount++;
+    }
+
+    if (layout.contentOffsetChanged && !CGPointEqualToPoint(super.contentOffset, layout.contentOffset)) {
+        super.contentOffset = layout.contentOffset;
+        writeCount++;
+    }
+
+    self.committedPropertyWriteCount = writeCount;
+}
+
+- (BOOL)layoutTransactionOpen {
+    return self.layoutTransactionDepth > 0;
+}
+
+#pragma mark - Layout Properties -
+
+- (void)setContentInset:(UIEdgeInsets)contentInset {
+    if (!self.layoutTransactionOpen) {
+        super.contentInset = contentInset;
+        return;
+    }
+    _pendingLayout.contentInset = contentInset;
+    _pendingLayout.contentInsetChanged = YES;
+}
+
+- (UIEdgeInsets)contentInset {
+    return self.layoutTransactionOpen ? _pendingLayout.contentInset : super.contentInset;
+}
+
+- (void)setContentSize:(CGSize)contentSize {
+    if (!self.layoutTransactionOpen) {
+        super.contentSize = contentSize;
+        return;
+    }
+    _pendingLayout.contentSize = contentSize;
+    _pendingLayout.contentSizeChanged = YES;
+}
+
+- (CGSize)contentSize {
+    return self.layoutTransactionOpen ? _pendingLayout.contentSize : super.contentSize;
+}
+
+- (void)setContentOffset:(CGPoint)contentOffset {
+    if (!self.layoutTransactionOpen) {
+        super.contentOffset = contentOffset;
+        return;
+    }
+    _pendingLayout.contentOffset = contentOffset;
+    _pendingLayout.contentOffsetChanged = YES;
+}
+
+- (CGPoint)contentOffset {
+    return self.layoutTransactionOpen ? _pendingLayout.contentOffset : super.contentOffset;
+}
+
+- (void)setMinimumZoomScale:(CGFloat)minimumZoomScale {
+    if (!self.layoutTransactionOpen) {
+        super.minimumZoomScale = minimumZoomScale;
+        return;
+    }
+    _pendingLayout.minimumZoomScale = minimumZoomScale;
+    _pendingLayout.zoomBoundsChanged = YES;
+}
+
+- (CGFloat)minimumZoomScale {
+    return self.layoutTransactionOpen ? _pendingLayout.minimumZoomScale : super.minimumZoomScale;
+}
+
+- (void)setMaximumZoomScale:(CGFloat)maximumZoomScale {
+    if (!self.layoutTransactionOpen) {
+        super.maximumZoomScale = maximumZoomScale;
+        return;
+    }
+    _pendingLayout.maximumZoomScale = maximumZoomScale;
+    _pendingLayout.zoomBoundsChanged = YES;
+}
+
+- (CGFloat)maximumZoomScale {
+    return self.layoutTransactionOpen ? _pendingLayout.maximumZoomScale : super.maximumZoomScale;
+}
+
+- (void)setZoomScale:(CGFloat)zoomScale {
+    if (!self.layoutTransactionOpen) {
+        super.zoomScale = zoomScale;
+        return;
+    }
+
+    // Like UIScrollView, keep the zoom within its bounds, and size the content to the zoomed view
+    zoomScale = MAX(_pendingLayout.minimumZoomScale, MIN(_pendingLayout.maximumZoomScale, zoomScale));
+    const CGFloat previousZoomScale = _pendingLayout.zoomScale;
+    _pendingLayout.zoomScale = zoomScale;
+    _pendingLayout.zoomScaleChanged = YES;
+
+    UIView *zoomingView = nil;
+    if ([self.delegate respondsToSelector:@selector(viewForZoomingInScrollView:)]) {
+        zoomingView = [self.delegate viewForZoomingInScrollView:self];
+    }
+    if (zoomingView == nil) {
+        return;
+    }
+
+    const CGSize size = zoomingView.bounds.size;
+    _pendingLayout.contentSize = (CGSize){size.width * zoomScale, size.height * zoomScale};
+    _pendingLayout.contentSizeChanged = YES;
+
+    // UIScrollView also moves the offset, zooming around the middle of the visible area and
+    // then keeping it inside the new content. Do the same, so the offset read back before the
+    // commit is the one the scroll view will actually end up with.
+    const CGSize boundsSize = self.bounds.size;
+    const UIEdgeInsets inset = _pendingLayout.contentInset;
+    const CGSize contentSize = _pendingLayout.contentSize;
+    const CGFloat scale = (previousZoomScale > 0.0f) ? zoomScale / previousZoomScale : 1.0f;
+
+    CGPoint offset = _pendingLayout.contentOffset;
+    offset.x = ((offset.x + boundsSize.width * 0.5f) * scale) - boundsSize.width * 0.5f;
+    offset.y = ((offset.y + boundsSize.height * 0.5f) * scale) - boundsSize.height * 0.5f;
+
+    const CGFloat maximumX = MAX(-inset.left, contentSize.width + inset.right - boundsSize.width);
+    const CGFloat maximumY = MAX(-inset.top, contentSize.height + inset.bottom - boundsSize.height);
+    offset.x = MAX(-inset.left, MIN(maximumX, offset.x));
+    offset.y = MAX(-inset.top, MIN(maximumY, offset.y));
+
+    _pendingLayout.contentOffset = offset;
+    _pendingLayout.contentOffsetChanged = YES;
+}
+
+- (CGFloat)zoomScale {
+    return self.layoutTransactionOpen ? _pendingLayout.zoomScale : super.zoomScale;
+}
+
+#pragma mark - Touch Events -
+
 - (void)touchesBegan:(NSSet *)touches withEvent:(UIEvent *)event {
     if (self.touchesBegan)
         self.touchesBegan();
@@ -0,0 +1,72 @@
+//
+//  TOCropTiledImageView.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ Draws only the visible part of a very large image, as a grid of tiles that are rendered
+ in the background as they come into view, and kept in a size-limited cache while they're
+ nearby. Placed over an image view showing a smaller copy of the same image, this lets the
+ user zoom all the way into the full resolution without it ever being uploaded in one piece.
+ */
+@interface TOCropTiledImageView : UIView
+
+/// Each level of the image, from the full resolution downwards. Every level is the same size in points.
+@property (nonatomic, copy, readonly) NSArray<UIImage *> *images;
+
+/// The width and height of each tile, in pixels of the level it's from. Default is 256.
+@property (nonatomic, assign) NSUInteger tileSize;
+
+/// The most bytes of rendered tiles to keep. Default is 32MB.
+@property (nonatomic, assign) NSUInteger tileCacheByteBudget;
+
+/// The number of rendered tiles currently being kept
+@property (nonatomic, readonly) NSUInteger cachedTileCount;
+
+/// The number of tiles currently being shown
+@property (nonatomic, readonly) NSUInteger visibleTileCount;
+
+- (instancetype)initWithImages:(NSArray<UIImage *> *)images NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithFrame:(CGRect)frame NS_UNAVAILABLE;
+- (nullable instancetype)initWithCoder:(NSCoder *)coder NS_UNAVAILABLE;
+
+/**
+ Shows the tiles of one level that cover a region of the view, and renders any that are missing.
+ Tiles just past the side the region is moving towards are rendered ahead of time as well.
+
+ @param visibleRect The region of the view that's on screen, in its own coordinate space
+ @param level The level of `images` to show
+ */
+- (void)updateTilesForVisibleRect:(CGRect)visibleRect level:(NSUInteger)level;
+
+/// Stops showing any tiles (but keeps them cached for when they're next visible)
+- (void)hideTiles;
+
+/// Empties the tile cache
+- (void)removeAllCachedTiles;
+
+@end
+
+NS_ASSUME_NONNULL_END
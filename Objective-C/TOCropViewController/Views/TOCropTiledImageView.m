@@ -0,0 +1,411 @@
+//
+//  TOCropTiledImageView.m
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "TOCropTiledImageView.h"
+
+#import "TOCropMemoryAccountant.h"
+#import "TOCropPixelOrientation.h"
+#import "TOCropTileCache.h"
+
+static const NSUInteger kTOCropTiledImageViewTileSize = 256;
+static const NSUInteger kTOCropTiledImageViewByteBudget = 32 * 1024 * 1024;
+
+// Tiles are stored in Foundation collections by their key packed into a single number
+static inline NSNumber *TOCropTileKeyValue(TOCropTileKey key) {
+    return @(((uint64_t)key.level << 48) | ((uint64_t)key.y << 24) | (uint64_t)key.x);
+}
+
+static inline TOCropTileKey TOCropTileKeyFromValue(NSNumber *value) {
+    const uint64_t packed = value.unsignedLongLongValue;
+    return (TOCropTileKey){(uint32_t)(packed >> 48), (uint32_t)(packed & 0xFFFFFF), (uint32_t)((packed >> 24) & 0xFFFFFF)};
+}
+
+static void TOCropTiledImageViewReleaseTile(void *tile) {
+    CGImageRelease((CGImageRef)tile);
+}
+
+// The EXIF orientation tag matching each UIImage orientation
+static int TOCropTiledImageViewEXIFOrientation(UIImageOrientation orientation) {
+    switch (orientation) {
+        case UIImageOrientationUpMirrored:    return 2;
+        case UIImageOrientationDown:          return 3;
+        case UIImageOrientationDownMirrored:  return 4;
+        case UIImageOrientationLeftMirrored:  return 5;
+        case UIImageOrientationRight:         return 6;
+        case UIImageOrientationRightMirrored: return 7;
+        case UIImageOrientationLeft:          return 8;
+        default:                              return 1;
+    }
+}
+
+// Draws one region of an image (in pixels, after its orientation is applied) into a new image
+static CGImageRef TOCropTiledImageViewCreateTile(UIImage *image, TOCropPixelRect rect) {
+    CGImageRef imageRef = image.CGImage;
+    const CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(imageRef);
+
+    // Cut the tile's region out of the stored image first, so only those pixels are drawn (and
+    // copied out of the image's backing data), rather than the whole image clipped to the tile.
+    UIImage *region = image;
+    if (imageRef) {
+        const TOCropPixelOrientation orientation = TOCropPixelOrientationForEXIFOrientation(TOCropTiledImageViewEXIFOrientation(image.imageOrientation));
+        const TOCropPixelRect sourceRect = TOCropPixelOrientationSourceRect(orientation, rect,
+                                                                            CGImageGetWidth(imageRef),
+                                                                            CGImageGetHeight(imageRef));
+        CGImageRef regionRef = CGImageCreateWithImageInRect(imageRef, (CGRect){{sourceRect.x, sourceRect.y},
+                                                                              {sourceRect.width, sourceRect.height}});
+        if (regionRef) {
+            region = [UIImage imageWithCGImage:regionRef scale:1.0f orientation:image.imageOrientation];
+            CGImageRelease(regionRef);
+        }
+    }
+
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = (alphaInfo == kCGImageAlphaNone || alphaInfo == kCGImageAlphaNoneSkipFirst ||
+                     alphaInfo == kCGImageAlphaNoneSkipLast);
+
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){rect.width, rect.height}
+                                                                               format:format];
+    UIImage *tile = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
+        if (region != image) {
+            [region drawInRect:(CGRect){CGPointZero, {rect.width, rect.height}}];
+            return;
+        }
+
+        // Without a bitmap to cut the region from, draw the whole image, offset so the tile's region lands inside it
+        const CGSize pixelSize = (CGSize){image.size.width * image.scale, image.size.height * image.scale};
+        [image drawInRect:(CGRect){{-(CGFloat)rect.x, -(CGFloat)rect.y}, pixelSize}];
+    }];
+    return CGImageRetain(tile.CGImage);
+}
+
+@interface TOCropTiledImageView ()
+
+@property (nonatomic, copy, readwrite) NSArray<UIImage *> *images;
+
+@property (nonatomic, assign) TOCropTileCache *tileCache;                            /* Rendered tiles, as retained CGImages */
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, CALayer *> *tileLayers; /* The layers of every tile being shown */
+@property (nonatomic, strong) NSMutableSet<NSNumber *> *pendingTiles;                  /* Tiles waiting to be rendered. Locked, since the render queue reads it. */
+@property (nonatomic, strong) dispatch_queue_t renderQueue;                            /* Renders one tile at a time, in the order they were requested */
+@property (nonatomic, strong) TOCropMemoryAllocation *memoryAllocation;                /* The cached tiles, as counted by the shared memory accountant */
+
+@property (nonatomic, assign) BOOL tilesVisible;
+@property (nonatomic, assign) NSUInteger visibleLevel;
+@property (nonatomic, assign) TOCropTileRange visibleRange;
+@property (nonatomic, assign) CGRect visiblePixelRect; /* The last visible region, in pixels of `visibleLevel` */
+
+@end
+
+@implementation TOCropTiledImageView
+
+- (instancetype)initWithImages:(NSArray<UIImage *> *)images {
+    if (self = [super initWithFrame:CGRectZero]) {
+        _images = [images copy];
+        _tileSize = kTOCropTiledImageViewTileSize;
+        _tileCacheByteBudget = kTOCropTiledImageViewByteBudget;
+        _tileCache = TOCropTileCacheCreate(_tileCacheByteBudget, TOCropTiledImageViewReleaseTile);
+        _tileLayers = [NSMutableDictionary dictionary];
+        _pendingTiles = [NSMutableSet set];
+        _renderQueue = dispatch_queue_create("dev.tim.TOCropTiledImageView",
+                                             dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+        self.userInteractionEnabled = NO;
+
+        // The tiles can always be rendered again, so they're the first thing let go of when memory runs short
+        __weak typeof(self) weakSelf = self;
+        _memoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop view tiles"
+                                                                                  byteCount:0
+                                                                                   priority:TOCropMemoryPriorityCache
+                                                                            evictionHandler:^{
+            [weakSelf removeAllCachedTiles];
+        }];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    TOCropTileCacheDestroy(_tileCache);
+}
+
+#pragma mark - Tiles -
+
+- (TOCropTileGrid)tileGridForLevel:(NSUInteger)level {
+    UIImage *image = self.images[level];
+    TOCropTileGrid grid;
+    grid.width = (size_t)round(image.size.width * image.scale);
+    grid.height = (size_t)round(image.size.height * image.scale);
+    grid.tileSize = self.tileSize;
+    return grid;
+}
+
+- (void)updateTilesForVisibleRect:(CGRect)visibleRect level:(NSUInteger)level {
+    const CGRect bounds = self.bounds;
+    if (level >= self.images.count || self.tileCache == NULL ||
+        CGRectGetWidth(bounds) < FLT_EPSILON || CGRectGetHeight(bounds) < FLT_EPSILON) {
+        [self hideTiles];
+        return;
+    }
+
+    // Convert the region from points in this view, to pixels of the level
+    const TOCropTileGrid grid = [self tileGridForLevel:level];
+    const CGFloat scaleX = grid.width / CGRectGetWidth(bounds);
+    const CGFloat scaleY = grid.height / CGRectGetHeight(bounds);
+    const CGRect pixelRect = (CGRect){
+        (CGRectGetMinX(visibleRect) - CGRectGetMinX(bounds)) * scaleX,
+        (CGRectGetMinY(visibleRect) - CGRectGetMinY(bounds)) * scaleY,
+        CGRectGetWidth(visibleRect) * scaleX,
+        CGRectGetHeight(visibleRect) * scaleY
+    };
+    const TOCropTileRange range = TOCropTileRangeForRect(grid, pixelRect.origin.x, pixelRect.origin.y,
+                                                         pixelRect.size.width, pixelRect.size.height);
+
+    // Compare with the last region to see which way the user is panning
+    int directionX = 0, directionY = 0;
+    if (self.tilesVisible && level == self.visibleLevel) {
+        const CGFloat deltaX = CGRectGetMidX(pixelRect) - CGRectGetMidX(self.visiblePixelRect);
+        const CGFloat deltaY = CGRectGetMidY(pixelRect) - CGRectGetMidY(self.visiblePixelRect);
+        directionX = (deltaX > 0.5f) - (deltaX < -0.5f);
+        directionY = (deltaY > 0.5f) - (deltaY < -0.5f);
+    }
+    const TOCropTileRange prefetchRange = TOCropTileRangeExtend(grid, range, directionX, directionY);
+
+    self.tilesVisible = YES;
+    self.visibleLevel = level;
+    self.visibleRange = range;
+    self.visiblePixelRect = pixelRect;
+
+    // Forget about any tiles that went out of range before they were rendered
+    @synchronized (self.pendingTiles) {
+        for (NSNumber *value in self.pendingTiles.allObjects) {
+            const TOCropTileKey key = TOCropTileKeyFromValue(value);
+            if (key.level != level || !TOCropTileRangeContainsTile(prefetchRange, key.x, key.y)) {
+                [self.pendingTiles removeObject:value];
+            }
+        }
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+
+    // Remove the tiles that are no longer visible
+    for (NSNumber *value in self.tileLayers.allKeys) {
+        const TOCropTileKey key = TOCropTileKeyFromValue(value);
+        if (key.level != level || !TOCropTileRangeContainsTile(range, key.x, key.y)) {
+            [self.tileLayers[value] removeFromSuperlayer];
+            [self.tileLayers removeObjectForKey:value];
+        }
+    }
+
+    // Show every visible tile that's been rendered, and queue up the ones that haven't
+    for (size_t y = range.minY; y < range.maxY; y++) {
+        for (size_t x = range.minX; x < range.maxX; x++) {
+            const TOCropTileKey key = (TOCropTileKey){(uint32_t)level, (uint32_t)x, (uint32_t)y};
+            CGImageRef tile = TOCropTileCacheGet(self.tileCache, key);
+            if (tile) {
+                [self showTile:tile forKey:key];
+            } else {
+                [self renderTileForKey:key grid:grid];
+            }
+        }
+    }
+
+    [self layoutTileLayers];
+    [CATransaction commit];
+
+    // Then the ones just past the edge the user is heading towards
+    for (size_t y = prefetchRange.minY; y < prefetchRange.maxY; y++) {
+        for (size_t x = prefetchRange.minX; x < prefetchRange.maxX; x++) {
+            if (TOCropTileRangeContainsTile(range, x, y)) { continue; }
+            const TOCropTileKey key = (TOCropTileKey){(uint32_t)level, (uint32_t)x, (uint32_t)y};
+            if (TOCropTileCacheGet(self.tileCache, key) == NULL) {
+                [self renderTileForKey:key grid:grid];
+            }
+        }
+    }
+}
+
+- (void)showTile:(CGImageRef)tile forKey:(TOCropTileKey)key {
+    NSNumber *value = TOCropTileKeyValue(key);
+    CALayer *layer = self.tileLayers[value];
+    if (layer == nil) {
+        layer = [CALayer layer];
+        self.tileLayers[value] = layer;
+        [self.layer addSublayer:layer];
+    }
+    layer.contents = (__bridge id)tile;
+}
+
+- (void)renderTileForKey:(TOCropTileKey)key grid:(TOCropTileGrid)grid {
+    NSNumber *value = TOCropTileKeyValue(key);
+    NSMutableSet<NSNumber *> *pendingTiles = self.pendingTiles;
+    @synchronized (pendingTiles) {
+        if ([pendingTiles containsObject:value]) {
+            return;
+        }
+        [pendingTiles addObject:value];
+    }
+
+    UIImage *image = self.images[key.level];
+    const TOCropPixelRect rect = TOCropTileGridRectForTile(grid, key.x, key.y);
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(self.renderQueue, ^{
+        // Skip tiles that were scrolled past while they waited their turn
+        @synchronized (pendingTiles) {
+            if (![pendingTiles containsObject:value]) {
+                return;
+            }
+        }
+
+        CGImageRef tile = TOCropTiledImageViewCreateTile(image, rect);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didRenderTile:tile forKey:key];
+            CGImageRelease(tile);
+        });
+    });
+}
+
+- (void)didRenderTile:(nullable CGImageRef)tile forKey:(TOCropTileKey)key {
+    NSNumber *value = TOCropTileKeyValue(key);
+    @synchronized (self.pendingTiles) {
+        if (![self.pendingTiles containsObject:value]) {
+            return;
+        }
+        [self.pendingTiles removeObject:value];
+    }
+
+    if (tile == NULL || self.tileCache == NULL) {
+        return;
+    }
+
+    const size_t byteCount = CGImageGetBytesPerRow(tile) * CGImageGetHeight(tile);
+    TOCropTileCacheInsert(self.tileCache, key, (void *)CGImageRetain(tile), byteCount);
+    [self updateMemoryAllocation];
+
+    if (!self.tilesVisible || key.level != self.visibleLevel ||
+        !TOCropTileRangeContainsTile(self.visibleRange, key.x, key.y)) {
+        return;
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [self showTile:tile forKey:key];
+    [self layoutTileLayers];
+    [CATransaction commit];
+}
+
+- (void)hideTiles {
+    if (!self.tilesVisible && self.tileLayers.count == 0) {
+        return;
+    }
+
+    @synchronized (self.pendingTiles) {
+        [self.pendingTiles removeAllObjects];
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (CALayer *layer in self.tileLayers.allValues) {
+        [layer removeFromSuperlayer];
+    }
+    [CATransaction commit];
+
+    [self.tileLayers removeAllObjects];
+    self.tilesVisible = NO;
+}
+
+- (void)removeAllCachedTiles {
+    if (self.tileCache == NULL) {
+        return;
+    }
+    TOCropTileCacheRemoveAll(self.tileCache);
+    [self updateMemoryAllocation];
+}
+
+- (void)updateMemoryAllocation {
+    self.memoryAllocation.byteCount = TOCropTileCacheByteCount(self.tileCache);
+}
+
+#pragma mark - Layout -
+
+- (void)layoutSubviews {
+    [super layoutSubviews];
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [self layoutTileLayers];
+    [CATransaction commit];
+}
+
+- (void)layoutTileLayers {
+    if (self.tileLayers.count == 0) {
+        return;
+    }
+
+    // Every level covers the whole view, so tiles are placed by their fraction of the level
+    const CGRect bounds = self.bounds;
+    const TOCropTileGrid grid = [self tileGridForLevel:self.visibleLevel];
+    const CGFloat scaleX = CGRectGetWidth(bounds) / grid.width;
+    const CGFloat scaleY = CGRectGetHeight(bounds) / grid.height;
+    [self.tileLayers enumerateKeysAndObjectsUsingBlock:^(NSNumber *value, CALayer *layer, BOOL *stop) {
+        const TOCropTileKey key = TOCropTileKeyFromValue(value);
+        const TOCropPixelRect rect = TOCropTileGridRectForTile(grid, key.x, key.y);
+        layer.frame = (CGRect){
+            CGRectGetMinX(bounds) + rect.x * scaleX,
+            CGRectGetMinY(bounds) + rect.y * scaleY,
+            rect.width * scaleX,
+            rect.height * scaleY
+        };
+    }];
+}
+
+#pragma mark - Accessors -
+
+- (void)setTileSize:(NSUInteger)tileSize {
+    tileSize = MAX(tileSize, 16);
+    if (tileSize == _tileSize) {
+        return;
+    }
+
+    // Every tile is cut along a different grid now
+    _tileSize = tileSize;
+    [self hideTiles];
+    [self removeAllCachedTiles];
+}
+
+- (void)setTileCacheByteBudget:(NSUInteger)tileCacheByteBudget {
+    _tileCacheByteBudget = tileCacheByteBudget;
+    if (self.tileCache) {
+        TOCropTileCacheSetByteBudget(self.tileCache, tileCacheByteBudget);
+        [self updateMemoryAllocation];
+    }
+}
+
+- (NSUInteger)cachedTileCount {
+    return self.tileCache ? TOCropTileCacheCount(self.tileCache) : 0;
+}
+
+- (NSUInteger)visibleTileCount {
+    return self.tileLayers.count;
+}
+
+@end
@@ -21,6 +21,7 @@
 //  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "TOCropToolbar.h"
+#import "TOCropToolbarIconAtlas.h"
 
 #define TOCROPTOOLBAR_DEBUG_SHOWING_BUTTONS_CONTAINER_RECT 0  // convenience debug toggle
 
@@ -555,24 +556,66 @@
 }
 
 #pragma mark - Image Generation -
+
+/* On iOS 12, which has no SF Symbols, the icons are sliced out of an atlas that was rasterized
+ from their paths ahead of time (see Tools/TOCropIconAtlasGenerator.c), so nothing is drawn at launch. */
++ (NSArray<UIImage *> *)iconAtlasImages {
+    static NSArray<UIImage *> *images;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        const TOCropToolbarIconAtlas *atlas = TOCropToolbarIconAtlasForScale(UIScreen.mainScreen.scale);
+        const size_t pixelCount = (size_t)atlas->width * atlas->height;
+        NSMutableData *coverage = [NSMutableData dataWithLength:pixelCount];
+        if (!TOCropToolbarIconAtlasUnpack(atlas, coverage.mutableBytes)) {
+            images = @[];
+            return;
+        }
+
+        // The icons are white, so as premultiplied gray and alpha, both channels are the coverage
+        NSMutableData *pixels = [NSMutableData dataWithLength:pixelCount * 2];
+        const uint8_t *coverageBytes = coverage.bytes;
+        uint8_t *pixelBytes = pixels.mutableBytes;
+        for (size_t i = 0; i < pixelCount; i++) {
+            pixelBytes[i * 2] = coverageBytes[i];
+            pixelBytes[i * 2 + 1] = coverageBytes[i];
+        }
+
+        CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)pixels);
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+        CGImageRef atlasImage = CGImageCreate(atlas->width, atlas->height, 8, 16, (size_t)atlas->width * 2, colorSpace,
+                                              (CGBitmapInfo)kCGImageAlphaPremultipliedLast, provider, NULL, false,
+                                              kCGRenderingIntentDefault);
+        CGColorSpaceRelease(colorSpace);
+        CGDataProviderRelease(provider);
+
+        NSMutableArray<UIImage *> *slicedImages = [NSMutableArray arrayWithCapacity:TOCropToolbarIconCount];
+        for (NSInteger i = 0; i < TOCropToolbarIconCount && atlasImage != NULL; i++) {
+            const TOCropToolbarIconSlice slice = atlas->slices[i];
+            CGImageRef iconImage = CGImageCreateWithImageInRect(atlasImage, (CGRect){slice.x, slice.y, slice.width, slice.height});
+            if (iconImage == NULL) {
+                break;
+            }
+            [slicedImages addObject:[UIImage imageWithCGImage:iconImage scale:atlas->scale orientation:UIImageOrientationUp]];
+            CGImageRelease(iconImage);
+        }
+        CGImageRelease(atlasImage);
+        images = (slicedImages.count == TOCropToolbarIconCount) ? [slicedImages copy] : @[];
+    });
+    return images;
+}
+
++ (UIImage *)iconImage:(TOCropToolbarIcon)icon {
+    NSArray<UIImage *> *images = [self iconAtlasImages];
+    return ((NSUInteger)icon < images.count) ? images[icon] : [UIImage new];
+}
+
 + (UIImage *)doneImage {
     if (@available(iOS 13.0, *)) {
         return [UIImage systemImageNamed:@"checkmark"
                        withConfiguration:[UIImageSymbolConfiguration configurationWithWeight:UIImageSymbolWeightSemibold]];
     }
 
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){17, 14}];
-    UIImage *doneImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        UIBezierPath *rectanglePath = UIBezierPath.bezierPath;
-        [rectanglePath moveToPoint:CGPointMake(1, 7)];
-        [rectanglePath addLineToPoint:CGPointMake(6, 12)];
-        [rectanglePath addLineToPoint:CGPointMake(16, 1)];
-        [UIColor.whiteColor setStroke];
-        rectanglePath.lineWidth = 2;
-        [rectanglePath stroke];
-    }];
-
-    return doneImage;
+    return [self iconImage:TOCropToolbarIconDone];
 }
 
 + (UIImage *)cancelImage {
@@ -581,24 +624,7 @@
                        withConfiguration:[UIImageSymbolConfiguration configurationWithWeight:UIImageSymbolWeightSemibold]];
     }
 
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){16, 16}];
-    UIImage *cancelImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        UIBezierPath *bezierPath = UIBezierPath.bezierPath;
-        [bezierPath moveToPoint:CGPointMake(15, 15)];
-        [bezierPath addLineToPoint:CGPointMake(1, 1)];
-        [UIColor.whiteColor setStroke];
-        bezierPath.lineWidth = 2;
-        [bezierPath stroke];
-
-        UIBezierPath *bezier2Path = UIBezierPath.bezierPath;
-        [bezier2Path moveToPoint:CGPointMake(1, 15)];
-        [bezier2Path addLineToPoint:CGPointMake(15, 1)];
-        [UIColor.whiteColor setStroke];
-        bezier2Path.lineWidth = 2;
-        [bezier2Path stroke];
-    }];
-
-    return cancelImage;
+    return [self iconImage:TOCropToolbarIconCancel];
 }
 
 + (UIImage *)rotateCCWImage {
@@ -608,30 +634,7 @@
             imageWithBaselineOffsetFromBottom:4];
     }
 
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){18, 21}];
-    UIImage *rotateImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        UIBezierPath *rectangle2Path = [UIBezierPath bezierPathWithRect:CGRectMake(0, 9, 12, 12)];
-        [UIColor.whiteColor setFill];
-        [rectangle2Path fill];
-
-        UIBezierPath *rectangle3Path = UIBezierPath.bezierPath;
-        [rectangle3Path moveToPoint:CGPointMake(5, 3)];
-        [rectangle3Path addLineToPoint:CGPointMake(10, 6)];
-        [rectangle3Path addLineToPoint:CGPointMake(10, 0)];
-        [rectangle3Path addLineToPoint:CGPointMake(5, 3)];
-        [rectangle3Path closePath];
-        [UIColor.whiteColor setFill];
-        [rectangle3Path fill];
-
-        UIBezierPath *bezierPath = UIBezierPath.bezierPath;
-        [bezierPath moveToPoint:CGPointMake(10, 3)];
-        [bezierPath addCurveToPoint:CGPointMake(17.5, 11) controlPoint1:CGPointMake(15, 3) controlPoint2:CGPointMake(17.5, 5.91)];
-        [UIColor.whiteColor setStroke];
-        bezierPath.lineWidth = 1;
-        [bezierPath stroke];
-    }];
-
-    return rotateImage;
+    return [self iconImage:TOCropToolbarIconRotateCounterclockwise];
 }
 
 + (UIImage *)rotateCWImage {
@@ -641,16 +644,7 @@
             imageWithBaselineOffsetFromBottom:4];
     }
 
-    UIImage *rotateCCWImage = [self.class rotateCCWImage];
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:rotateCCWImage.size];
-    UIImage *rotateCWImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        CGContextRef context = rendererContext.CGContext;
-        CGContextTranslateCTM(context, rotateCCWImage.size.width, rotateCCWImage.size.height);
-        CGContextRotateCTM(context, M_PI);
-        CGContextDrawImage(context, CGRectMake(0, 0, rotateCCWImage.size.width, rotateCCWImage.size.height), rotateCCWImage.CGImage);
-    }];
-
-    return rotateCWImage;
+    return [self iconImage:TOCropToolbarIconRotateClockwise];
 }
 
 + (UIImage *)resetImage {
@@ -658,39 +652,9 @@
         return [[UIImage systemImageNamed:@"arrow.counterclockwise"
                         withConfiguration:[UIImageSymbolConfiguration configurationWithWeight:UIImageSymbolWeightSemibold]]
             imageWithBaselineOffsetFromBottom:0];
-        ;
     }
 
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){22, 18}];
-    UIImage *resetImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        UIBezierPath *bezier2Path = UIBezierPath.bezierPath;
-        [bezier2Path moveToPoint:CGPointMake(22, 9)];
-        [bezier2Path addCurveToPoint:CGPointMake(13, 18) controlPoint1:CGPointMake(22, 13.97) controlPoint2:CGPointMake(17.97, 18)];
-        [bezier2Path addCurveToPoint:CGPointMake(13, 16) controlPoint1:CGPointMake(13, 17.35) controlPoint2:CGPointMake(13, 16.68)];
-        [bezier2Path addCurveToPoint:CGPointMake(20, 9) controlPoint1:CGPointMake(16.87, 16) controlPoint2:CGPointMake(20, 12.87)];
-        [bezier2Path addCurveToPoint:CGPointMake(13, 2) controlPoint1:CGPointMake(20, 5.13) controlPoint2:CGPointMake(16.87, 2)];
-        [bezier2Path addCurveToPoint:CGPointMake(6.55, 6.27) controlPoint1:CGPointMake(10.1, 2) controlPoint2:CGPointMake(7.62, 3.76)];
-        [bezier2Path addCurveToPoint:CGPointMake(6, 9) controlPoint1:CGPointMake(6.2, 7.11) controlPoint2:CGPointMake(6, 8.03)];
-        [bezier2Path addLineToPoint:CGPointMake(4, 9)];
-        [bezier2Path addCurveToPoint:CGPointMake(4.65, 5.63) controlPoint1:CGPointMake(4, 7.81) controlPoint2:CGPointMake(4.23, 6.67)];
-        [bezier2Path addCurveToPoint:CGPointMake(7.65, 1.76) controlPoint1:CGPointMake(5.28, 4.08) controlPoint2:CGPointMake(6.32, 2.74)];
-        [bezier2Path addCurveToPoint:CGPointMake(13, 0) controlPoint1:CGPointMake(9.15, 0.65) controlPoint2:CGPointMake(11, 0)];
-        [bezier2Path addCurveToPoint:CGPointMake(22, 9) controlPoint1:CGPointMake(17.97, 0) controlPoint2:CGPointMake(22, 4.03)];
-        [bezier2Path closePath];
-        [UIColor.whiteColor setFill];
-        [bezier2Path fill];
-
-        UIBezierPath *polygonPath = UIBezierPath.bezierPath;
-        [polygonPath moveToPoint:CGPointMake(5, 15)];
-        [polygonPath addLineToPoint:CGPointMake(10, 9)];
-        [polygonPath addLineToPoint:CGPointMake(0, 9)];
-        [polygonPath addLineToPoint:CGPointMake(5, 15)];
-        [polygonPath closePath];
-        [UIColor.whiteColor setFill];
-        [polygonPath fill];
-    }];
-
-    return resetImage;
+    return [self iconImage:TOCropToolbarIconReset];
 }
 
 + (UIImage *)clampImage {
@@ -700,37 +664,7 @@
             imageWithBaselineOffsetFromBottom:0];
     }
 
-    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){22, 16}];
-    UIImage *clampImage = [renderer imageWithActions:^(UIGraphicsImageRendererContext *rendererContext) {
-        //// Color Declarations
-        UIColor *outerBox = [UIColor colorWithRed:1 green:1 blue:1 alpha:0.553];
-        UIColor *innerBox = [UIColor colorWithRed:1 green:1 blue:1 alpha:0.773];
-
-        //// Rectangle Drawing
-        UIBezierPath *rectanglePath = [UIBezierPath bezierPathWithRect:CGRectMake(0, 3, 13, 13)];
-        [UIColor.whiteColor setFill];
-        [rectanglePath fill];
-
-        //// Outer
-        {
-            //// Top Drawing
-            UIBezierPath *topPath = [UIBezierPath bezierPathWithRect:CGRectMake(0, 0, 22, 2)];
-            [outerBox setFill];
-            [topPath fill];
-
-            //// Side Drawing
-            UIBezierPath *sidePath = [UIBezierPath bezierPathWithRect:CGRectMake(19, 2, 3, 14)];
-            [outerBox setFill];
-            [sidePath fill];
-        }
-
-        //// Rectangle 2 Drawing
-        UIBezierPath *rectangle2Path = [UIBezierPath bezierPathWithRect:CGRectMake(14, 3, 4, 13)];
-        [innerBox setFill];
-        [rectangle2Path fill];
-    }];
-
-    return clampImage;
+    return [self iconImage:TOCropToolbarIconClamp];
 }
 
 #pragma mark - Accessors -
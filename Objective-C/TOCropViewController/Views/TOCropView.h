@@ -46,6 +46,15 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)cropViewDidBecomeResettable:(nonnull TOCropView *)cropView;
 - (void)cropViewDidBecomeNonResettable:(nonnull TOCropView *)cropView;
 
+@optional
+
+/// Called as the user starts adjusting the crop (eg, dragging, zooming, or resizing the crop box)
+- (void)cropViewDidBeginEditing:(nonnull TOCropView *)cropView;
+
+/// Called once the user has stopped adjusting the crop for `cropAdjustingDelay`, and the crop box
+/// has been laid out in its final position. The crop frame won't change again until the next edit.
+- (void)cropViewDidEndEditing:(nonnull TOCropView *)cropView;
+
 @end
 
 @interface TOCropView : UIView
@@ -155,6 +164,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) NSInteger angle;
 
+/**
+ The angle the image is straightened by after `angle`, in degrees, such as to level a tilted horizon.
+ Clockwise rotations are positive. Values are clamped to ±45 degrees, and rounded to the nearest 0.1 of one.
+
+ The image turns about its center without changing its size, so `imageCropFrame` is in the same
+ coordinate space at every angle. As the angle changes, the crop is shrunk (keeping its aspect ratio)
+ and moved until it's completely covered by the image, and it grows back to the crop from before
+ straightening began as the angle returns to 0. The crop is pulled back inside the image whenever
+ the user scrolls, zooms or resizes it past the image's edges. Default is 0.
+ */
+@property (nonatomic, assign) CGFloat straighteningAngle;
+
+/**
+ Show the four corners of `cropQuadrilateral` over the image, so the user can drag each of them
+ onto the corners of a page, whiteboard or sign photographed at an angle, and have it flattened
+ into a rectangle when the image is cropped. This has no effect in the circular cropping style.
+ (Default is NO)
+ */
+@property (nonatomic, assign) BOOL perspectiveCorrectionEnabled;
+
+/**
+ In the same coordinate space as `imageCropFrame`, the four corners of the region to flatten while
+ `perspectiveCorrectionEnabled` is on. The corners are kept inside the image, and changes that would
+ make the shape concave are ignored. Resetting the crop view moves them back to the corners of the
+ crop. Default to the corners of `imageCropFrame` when perspective correction is turned on.
+ */
+@property (nonatomic, assign) TOCropQuadrilateral cropQuadrilateral;
+
 /**
  Hide all of the crop elements for transition animations
  */
@@ -186,6 +223,20 @@ The minimum croping aspect ratio. If set, user is prevented from setting croppin
 */
 @property (nonatomic, assign) CGFloat minimumAspectRatio;
 
+/**
+ While the user resizes the crop box, snap it to the closest of
+ `TOCropViewControllerAspectRatioPreset.registeredPresets` whenever its shape comes within
+ `aspectRatioSnappingTolerance` of one. This has no effect while the aspect ratio is locked.
+ (Default is NO)
+ */
+@property (nonatomic, assign) BOOL aspectRatioSnappingEnabled;
+
+/**
+ How far the crop box's aspect ratio can be from a preset's (as a fraction of it) for the crop box
+ to snap to it. Default to 0.02 (2%)
+ */
+@property (nonatomic, assign) CGFloat aspectRatioSnappingTolerance;
+
 /**
  The maximum scale that user can apply to image by pinching to zoom. Small values
  are only recomended with aspectRatioLockEnabled set to true. Default to 15.0
@@ -205,6 +256,14 @@ The minimum croping aspect ratio. If set, user is prevented from setting croppin
  */
 @property (nonatomic, assign) BOOL translucencyAlwaysHidden;
 
+/**
+ Replaces the live blur over the parts of the image outside the crop box with a blurred,
+ darkened copy of the image that is computed once, in the background, when the crop view is
+ set up. It looks much the same, but nothing is re-blurred as the image is scrolled and zoomed,
+ which saves a lot of GPU time on older devices. (Default is NO)
+ */
+@property (nonatomic, assign) BOOL precomputedTranslucencyEnabled;
+
 ///*
 // if YES it will always show grid
 // if NO it will never show grid
@@ -306,6 +365,21 @@ The minimum croping aspect ratio. If set, user is prevented from setting croppin
  */
 - (void)moveCroppedContentToCenterAnimated:(BOOL)animated;
 
+/**
+ Starts recording the user's interactions with the crop view (resizing the crop box, scrolling,
+ zooming, rotating and changing the aspect ratio) into a compact binary trace. Any recording
+ already in progress is discarded.
+ */
+- (void)startRecordingInteractionTrace;
+
+/**
+ Stops recording interactions. The trace can be replayed through the crop geometry, without
+ any views, by `Benchmarks/TOCropTraceBenchmark.c` to time the layout against a real session.
+
+ @return The trace recorded since `startRecordingInteractionTrace`, or nil if nothing was being recorded
+ */
+- (nullable NSData *)stopRecordingInteractionTrace;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -24,27 +24,42 @@
 
 #import "TOCropOverlayView.h"
 #import "TOCropScrollView.h"
+#import "TOCropGeometry.h"
+#import "TOCropMemoryAccountant.h"
+#import "TOCropTiledImageView.h"
+#import "TOCropTrace.h"
+#import "TOCropViewControllerAspectRatioPreset.h"
+#import "UIImage+CropRotate.h"
+
+#import "TOCropMipmap.h"
 
 #define TOCROPVIEW_BACKGROUND_COLOR [UIColor colorWithWhite:0.12f alpha:1.0f]
 
 static const CGFloat kTOCropViewPadding = 14.0f;
 static const NSTimeInterval kTOCropTimerDuration = 0.8f;
-static const CGFloat kTOCropViewMinimumBoxSize = 42.0f;
 static const CGFloat kTOMaximumZoomScale = 15.0f;
-
-/* When the user taps down to resize the box, this state is used
- to determine where they tapped and how to manipulate the box */
-typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
-    TOCropViewOverlayEdgeNone,
-    TOCropViewOverlayEdgeTopLeft,
-    TOCropViewOverlayEdgeTop,
-    TOCropViewOverlayEdgeTopRight,
-    TOCropViewOverlayEdgeRight,
-    TOCropViewOverlayEdgeBottomRight,
-    TOCropViewOverlayEdgeBottom,
-    TOCropViewOverlayEdgeBottomLeft,
-    TOCropViewOverlayEdgeLeft
-};
+static const CGFloat kTOAspectRatioSnappingTolerance = 0.02f;
+static const NSUInteger kTOCropMipmapMinimumPixelSize = 256;
+static const NSUInteger kTOCropBackdropMaximumPixelSize = 512;
+static const CGFloat kTOCropBackdropBlurRadius = 12.0f; // In screen points, when zoomed all the way out
+static const CGFloat kTOCropBackdropBrightness = 0.55f;
+static const CGFloat kTOCropQuadrilateralCornerRadius = 30.0f; // How close a touch has to be to a corner to drag it
+static const CGFloat kTOCropQuadrilateralHandleRadius = 8.0f;
+
+// The geometry is worked out in plain C types, which match Core Graphics' on 64-bit platforms
+static inline TOCropPoint TOCropPointFromCGPoint(CGPoint point) { return (TOCropPoint){point.x, point.y}; }
+static inline TOCropSize TOCropSizeFromCGSize(CGSize size) { return (TOCropSize){size.width, size.height}; }
+static inline TOCropRect TOCropRectFromCGRect(CGRect rect) { return (TOCropRect){TOCropPointFromCGPoint(rect.origin), TOCropSizeFromCGSize(rect.size)}; }
+static inline CGPoint CGPointFromTOCropPoint(TOCropPoint point) { return (CGPoint){point.x, point.y}; }
+static inline CGRect CGRectFromTOCropRect(TOCropRect rect) { return (CGRect){{rect.origin.x, rect.origin.y}, {rect.size.width, rect.size.height}}; }
+static inline TOCropQuad TOCropQuadFromQuadrilateral(TOCropQuadrilateral q) {
+    return (TOCropQuad){TOCropPointFromCGPoint(q.topLeft), TOCropPointFromCGPoint(q.topRight),
+                        TOCropPointFromCGPoint(q.bottomRight), TOCropPointFromCGPoint(q.bottomLeft)};
+}
+static inline TOCropQuadrilateral TOCropQuadrilateralFromQuad(TOCropQuad q) {
+    return (TOCropQuadrilateral){CGPointFromTOCropPoint(q.topLeft), CGPointFromTOCropPoint(q.topRight),
+                                 CGPointFromTOCropPoint(q.bottomRight), CGPointFromTOCropPoint(q.bottomLeft)};
+}
 
 @interface TOCropView () <UIScrollViewDelegate, UIGestureRecognizerDelegate>
 
@@ -55,11 +70,14 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 @property (nonatomic, strong) UIImageView *backgroundImageView; /* The main image view, placed within the scroll view */
 @property (nonatomic, strong) UIView *backgroundContainerView;  /* A view which contains the background image view, to separate its transforms from the scroll view. */
 @property (nonatomic, strong, readwrite) UIView *foregroundContainerView;
+@property (nonatomic, strong) UIView *foregroundStraighteningView;           /* A view which contains the foreground image view, and turns it about its center when straightening */
 @property (nonatomic, strong) UIImageView *foregroundImageView;              /* A copy of the background image view, placed over the dimming views */
 @property (nonatomic, strong) TOCropScrollView *scrollView;                  /* The scroll view in charge of panning/zooming the image. */
 @property (nonatomic, strong) UIView *overlayView;                           /* A semi-transparent grey view, overlaid on top of the background image */
 @property (nonatomic, strong) UIView *translucencyView;                      /* A blur view that is made visible when the user isn't interacting with the crop view */
 @property (nonatomic, strong) id translucencyEffect;                         /* The dark blur visual effect applied to the visual effect view. */
+@property (nonatomic, strong) UIImageView *backdropImageView;                /* A pre-blurred copy of the image, shown over the background image in place of the live blur */
+@property (nonatomic, assign) BOOL translucencyVisible;                      /* Whether the translucency is currently shown, so the backdrop can start out matching it */
 @property (nonatomic, strong, readwrite) TOCropOverlayView *gridOverlayView; /* A grid view overlaid on top of the foreground image view's container. */
 
 /* Gesture Recognizers */
@@ -67,13 +85,22 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 
 /* Crop box handling */
 @property (nonatomic, assign) BOOL applyInitialCroppedImageFrame; /* No by default, when setting initialCroppedImageFrame this will be set to YES, and set back to NO after first application - so it's only done once */
-@property (nonatomic, assign) TOCropViewOverlayEdge tappedEdge;   /* The edge region that the user tapped on, to resize the cropping region */
+@property (nonatomic, assign) TOCropEdge tappedEdge;             /* The edge region that the user tapped on, to resize the cropping region */
 @property (nonatomic, assign) CGRect cropOriginFrame;             /* When resizing, this is the original frame of the crop box. */
 @property (nonatomic, assign) CGPoint panOriginPoint;             /* The initial touch point of the pan gesture recognizer */
 @property (nonatomic, assign, readwrite) CGRect cropBoxFrame;     /* The frame, in relation to to this view where the grid, and crop container view are aligned */
 @property (nonatomic, strong) NSTimer *resetTimer;                /* The timer used to reset the view after the user stops interacting with it */
 @property (nonatomic, assign) BOOL editing;                       /* Used to denote the active state of the user manipulating the content */
-@property (nonatomic, assign) BOOL disableForgroundMatching;      /* At times during animation, disable matching the forground image view to the background */
+
+/* Layout transactions */
+@property (nonatomic, assign) NSInteger layoutTransactionDepth;   /* While above zero, layout changes are collected, and applied once when the last transaction commits */
+@property (nonatomic, assign) BOOL cropBoxViewsNeedLayout;        /* The crop box changed during the transaction, so its views need to be moved */
+@property (nonatomic, assign) BOOL foregroundNeedsMatching;       /* Something asked for the foreground to be matched during the transaction */
+@property (nonatomic, assign) NSUInteger layoutCommitWriteCount;  /* How many scroll view and view frame properties the last commit wrote */
+
+/* Interaction trace recording */
+@property (nonatomic, assign) TOCropTraceWriter *traceWriter;  /* While recording, the trace that each interaction is appended to */
+@property (nonatomic, assign) CFTimeInterval traceStartTime;   /* When recording started, so each interaction can be timed from it */
 
 /* Pre-screen-rotation state information */
 @property (nonatomic, assign) CGPoint rotationContentOffset;
@@ -84,6 +111,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 @property (nonatomic, readonly) CGRect contentBounds; /* Give the current screen real-estate, the frame that the scroll view is allowed to use */
 @property (nonatomic, readonly) CGSize imageSize;     /* Given the current rotation of the image, the size of the image */
 @property (nonatomic, readonly) BOOL hasAspectRatio;  /* True if an aspect ratio was explicitly applied to this crop view */
+@property (nonatomic, readonly) TOCropLayout geometryLayout; /* A snapshot of the current layout, for the crop geometry functions to work from */
 
 /* 90-degree rotation state data */
 @property (nonatomic, assign) CGSize cropBoxLastEditedSize;          /* When performing 90-degree rotations, remember what our last manual size was to use that as a base */
@@ -102,8 +130,30 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 /* If restoring to a previous crop setting, these properties hang onto the
  values until the view is configured for the first time. */
 @property (nonatomic, assign) NSInteger restoreAngle;
+
+/* Straightening */
+@property (nonatomic, assign) CGRect straighteningSourceImageCropFrame; /* The crop the user chose before straightening, which each angle is fitted from */
+@property (nonatomic, assign) CGRect straighteningFittedImageCropFrame; /* The crop last fitted to the straightened image, to tell when the user has changed it since */
 @property (nonatomic, assign) CGRect restoreImageCropFrame;
 
+/* Perspective Correction */
+@property (nonatomic, strong) UIView *quadrilateralView;                  /* A view over the image which draws the outline and corners of the crop quadrilateral */
+@property (nonatomic, strong) CAShapeLayer *quadrilateralLayer;           /* The shape layer inside it, which the outline is drawn with */
+@property (nonatomic, assign) TOCropEdge tappedQuadrilateralCorner;       /* The corner of the quadrilateral that the user is dragging, if any */
+@property (nonatomic, assign) CGPoint quadrilateralCornerOriginPoint;     /* When dragging, where that corner was in the image when the drag began */
+@property (nonatomic, assign) TOCropQuadrilateral restoreCropQuadrilateral;
+@property (nonatomic, assign) BOOL applyInitialCropQuadrilateral;         /* A quadrilateral was set before the initial layout, so it's applied once the image is laid out */
+
+/* For very large images, smaller copies to display while zoomed out, and the one currently displayed */
+@property (nonatomic, copy) NSArray<UIImage *> *mipmapImages;
+@property (nonatomic, assign) NSUInteger mipmapLevel;
+@property (nonatomic, strong) TOCropTiledImageView *tiledImageView; /* Draws the full resolution tiles inside the crop box once zoomed in far enough to need them */
+
+/* The memory of the image and its copies, as counted by the shared memory accountant */
+@property (nonatomic, strong) TOCropMemoryAllocation *imageMemoryAllocation;    /* The decoded pixels of the image itself */
+@property (nonatomic, strong) TOCropMemoryAllocation *mipmapMemoryAllocation;   /* The smaller copies of the image, which can be let go of */
+@property (nonatomic, strong) TOCropMemoryAllocation *backdropMemoryAllocation; /* The blurred backdrop, which can be let go of in favour of the live blur */
+
 /* Set to YES once `performInitialLayout` is called. This lets pending properties get queued until the view
  has been properly set up in its parent. */
 @property (nonatomic, assign) BOOL initialSetupPerformed;
@@ -120,6 +170,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     if (self = [super init]) {
         _image = image;
         _croppingStyle = style;
+        _imageMemoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop view image"
+                                                                                      byteCount:[TOCropMemoryAccountant byteCountOfImage:image]
+                                                                                       priority:TOCropMemoryPriorityRequired
+                                                                                evictionHandler:nil];
         [self setup];
     }
 
@@ -145,6 +199,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.cropAdjustingDelay = kTOCropTimerDuration;
     self.cropViewPadding = kTOCropViewPadding;
     self.maximumZoomScale = kTOMaximumZoomScale;
+    self.aspectRatioSnappingTolerance = kTOAspectRatioSnappingTolerance;
 
     // Scroll View properties
     self.scrollView = [[TOCropScrollView alloc] initWithFrame:self.bounds];
@@ -186,6 +241,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.translucencyView.userInteractionEnabled = NO;
     self.translucencyView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
     [self addSubview:self.translucencyView];
+    self.translucencyVisible = YES;
 
     // The forground container that holds the foreground image view
     self.foregroundContainerView = [[UIView alloc] initWithFrame:(CGRect){0, 0, 200, 200}];
@@ -193,9 +249,13 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.foregroundContainerView.userInteractionEnabled = NO;
     [self addSubview:self.foregroundContainerView];
 
+    self.foregroundStraighteningView = [[UIView alloc] initWithFrame:self.foregroundContainerView.bounds];
+    self.foregroundStraighteningView.userInteractionEnabled = NO;
+    [self.foregroundContainerView addSubview:self.foregroundStraighteningView];
+
     self.foregroundImageView = [[UIImageView alloc] initWithImage:self.image];
     self.foregroundImageView.layer.minificationFilter = kCAFilterTrilinear;
-    [self.foregroundContainerView addSubview:self.foregroundImageView];
+    [self.foregroundStraighteningView addSubview:self.foregroundImageView];
 
     // Disable colour inversion for the image views
     self.foregroundImageView.accessibilityIgnoresInvertColors = YES;
@@ -212,6 +272,19 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.gridOverlayView.gridHidden = YES;
     [self addSubview:self.gridOverlayView];
 
+    // The outline of the region that's flattened when perspective correction is on
+    self.quadrilateralView = [[UIView alloc] initWithFrame:self.bounds];
+    self.quadrilateralView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    self.quadrilateralView.userInteractionEnabled = NO;
+    self.quadrilateralView.hidden = YES;
+    [self addSubview:self.quadrilateralView];
+
+    self.quadrilateralLayer = [CAShapeLayer layer];
+    self.quadrilateralLayer.fillColor = nil;
+    self.quadrilateralLayer.strokeColor = [UIColor whiteColor].CGColor;
+    self.quadrilateralLayer.lineWidth = 2.0f;
+    [self.quadrilateralView.layer addSublayer:self.quadrilateralLayer];
+
     // The pan controller to recognize gestures meant to resize the grid view
     self.gridPanGestureRecognizer = [[UIPanGestureRecognizer alloc] initWithTarget:self action:@selector(gridPanGestureRecognized:)];
     self.gridPanGestureRecognizer.delegate = self;
@@ -221,6 +294,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 
 - (void)dealloc {
     [_resetTimer invalidate];
+    TOCropTraceWriterDestroy(_traceWriter);
 }
 
 #pragma mark - View Layout -
@@ -236,6 +310,12 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     // Perform the initial layout of the image
     [self layoutInitialImage];
 
+    // Start building smaller copies of very large images in the background
+    [self prepareMipmapImages];
+
+    // And the blurred backdrop, if it's replacing the live blur
+    [self prepareBackdropImage];
+
     // -- State Restoration --
 
     // If the angle value was previously set before this point, apply it now
@@ -251,6 +331,20 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         self.restoreImageCropFrame = CGRectZero;
     }
 
+    // And straighten the image if that was set too, keeping the crop inside it
+    if (self.straighteningAngle != 0.0f) {
+        [self applyStraighteningTransform];
+        [self updateImageCropFrameForStraighteningAngle];
+    }
+
+    // Then place the perspective quadrilateral, starting from the crop if none was set
+    const BOOL restoresCropQuadrilateral = self.applyInitialCropQuadrilateral;
+    self.applyInitialCropQuadrilateral = NO;
+    if (!restoresCropQuadrilateral || ![self applyCropQuadrilateral:self.restoreCropQuadrilateral]) {
+        [self resetCropQuadrilateral];
+    }
+    [self updateQuadrilateralView];
+
     // Save the current layout state for later
     [self captureStateForImageRotation];
 
@@ -258,61 +352,157 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     [self checkForCanReset];
 }
 
-- (void)layoutInitialImage {
-    CGSize imageSize = self.imageSize;
-    // A zero-sized image would produce NaN geometry below, which crashes CALayer
-    if (imageSize.width < FLT_EPSILON || imageSize.height < FLT_EPSILON) {
+#pragma mark - Mipmaps -
+
+// The number of display pixels each of the image's pixels covers at a zoom scale
+- (CGFloat)displayPixelScaleForZoomScale:(CGFloat)zoomScale {
+    // (displayScale can be 0 before the view joins a window)
+    return zoomScale * MAX(1.0f, self.traitCollection.displayScale) / self.image.scale;
+}
+
+- (void)prepareMipmapImages {
+    // Only worth building when the image is shown at under half its resolution when zoomed out
+    if ([self displayPixelScaleForZoomScale:self.scrollView.minimumZoomScale] > 0.5f) {
         return;
     }
-    self.scrollView.contentSize = imageSize;
 
-    CGRect bounds = self.contentBounds;
-    CGSize boundsSize = bounds.size;
+    // Showing a smaller copy while zoomed out means the full image is only uploaded
+    // and filtered once the user zooms in far enough to see its detail
+    UIImage *image = self.image;
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSArray<UIImage *> *mipmapImages = [image mipmapImagesWithMinimumPixelSize:kTOCropMipmapMinimumPixelSize];
+        if (mipmapImages.count < 2) {
+            return;
+        }
 
-    // work out the minimum scale of the object
-    CGFloat scale = 0.0f;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf applyMipmapImages:mipmapImages];
+        });
+    });
+}
 
-    // Work out the size of the image to fit into the content bounds
-    scale = MIN(CGRectGetWidth(bounds) / imageSize.width, CGRectGetHeight(bounds) / imageSize.height);
-    CGSize scaledImageSize = (CGSize){floorf(imageSize.width * scale), floorf(imageSize.height * scale)};
+- (void)applyMipmapImages:(NSArray<UIImage *> *)mipmapImages {
+    // Every level after the first is an extra copy. If the copies won't fit in the memory limit, go without.
+    NSUInteger byteCount = 0;
+    for (NSUInteger i = 1; i < mipmapImages.count; i++) {
+        byteCount += [TOCropMemoryAccountant byteCountOfImage:mipmapImages[i]];
+    }
+
+    __weak typeof(self) weakSelf = self;
+    self.mipmapMemoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop view mipmaps"
+                                                                                       byteCount:byteCount
+                                                                                        priority:TOCropMemoryPriorityPreview
+                                                                                 evictionHandler:^{
+        [weakSelf removeMipmapImages];
+    }];
+    if (self.mipmapMemoryAllocation == nil) {
+        return;
+    }
 
-    // If an aspect ratio was pre-applied to the crop view, use that to work out the minimum scale the image needs to be to fit
-    CGSize cropBoxSize = CGSizeZero;
-    if (self.hasAspectRatio) {
-        CGFloat ratioScale = (self.aspectRatio.width / self.aspectRatio.height);  // Work out the size of the width in relation to height
-        CGSize fullSizeRatio = (CGSize){boundsSize.height * ratioScale, boundsSize.height};
-        CGFloat fitScale = MIN(boundsSize.width / fullSizeRatio.width, boundsSize.height / fullSizeRatio.height);
-        cropBoxSize = (CGSize){fullSizeRatio.width * fitScale, fullSizeRatio.height * fitScale};
+    self.mipmapImages = mipmapImages;
+}
 
-        scale = MAX(cropBoxSize.width / imageSize.width, cropBoxSize.height / imageSize.height);
+- (void)removeMipmapImages {
+    [self.mipmapMemoryAllocation remove];
+    self.mipmapMemoryAllocation = nil;
+    if (self.mipmapImages == nil) {
+        return;
     }
 
-    // Whether aspect ratio, or original, the final image size we'll base the rest of the calculations off
-    CGSize scaledSize = (CGSize){floorf(imageSize.width * scale), floorf(imageSize.height * scale)};
+    // Go back to showing the image itself, as if it had never needed any copies
+    self.mipmapImages = nil;
+    self.mipmapLevel = 0;
+    self.backgroundImageView.image = self.image;
+    self.foregroundImageView.image = self.image;
+}
+
+- (void)setMipmapImages:(NSArray<UIImage *> *)mipmapImages {
+    _mipmapImages = [mipmapImages copy];
+
+    [self.tiledImageView removeFromSuperview];
+    self.tiledImageView = nil;
+    if (_mipmapImages.count < 2) {
+        return;
+    }
+
+    // The tiles are only drawn in the foreground, since anything outside the crop box is dimmed
+    self.tiledImageView = [[TOCropTiledImageView alloc] initWithImages:_mipmapImages];
+    self.tiledImageView.frame = self.foregroundImageView.bounds;
+    [self.foregroundImageView addSubview:self.tiledImageView];
+
+    [self updateMipmapLevel];
+}
+
+- (void)updateMipmapLevel {
+    if (self.mipmapImages == nil) {
+        return;
+    }
+
+    const CGFloat scale = [self displayPixelScaleForZoomScale:self.scrollView.zoomScale];
+    self.mipmapLevel = TOCropMipmapLevelForScale(scale, self.mipmapImages.count);
+
+    // The image views never show the full resolution level. Once the user zooms in far enough
+    // to need it, only the tiles of it that are inside the crop box are drawn over the next level down.
+    // (Every level is the same size in points, so the image views' frames stay as they are.)
+    UIImage *image = self.mipmapImages[MAX(self.mipmapLevel, 1)];
+    if (self.backgroundImageView.image != image) {
+        self.backgroundImageView.image = image;
+        self.foregroundImageView.image = image;
+    }
+
+    [self updateVisibleTiles];
+}
+
+- (void)updateVisibleTiles {
+    if (self.tiledImageView == nil) {
+        return;
+    }
+
+    if (self.mipmapLevel > 0) {
+        [self.tiledImageView hideTiles];
+        return;
+    }
+
+    // Converting through the views accounts for the image's rotation as well as the zoom
+    self.tiledImageView.frame = self.foregroundImageView.bounds;
+    const CGRect visibleRect = [self.foregroundContainerView convertRect:self.foregroundContainerView.bounds
+                                                                  toView:self.tiledImageView];
+    [self.tiledImageView updateTilesForVisibleRect:visibleRect level:self.mipmapLevel];
+}
+
+- (void)layoutInitialImage {
+    CGSize imageSize = self.imageSize;
+    // A zero-sized image would produce NaN geometry below, which crashes CALayer
+    if (imageSize.width < FLT_EPSILON || imageSize.height < FLT_EPSILON) {
+        return;
+    }
+
+    [self beginLayoutTransaction];
+    self.scrollView.contentSize = imageSize;
+
+    // Fit the image, or a crop box of the pre-applied aspect ratio, into the content bounds
+    const TOCropInitialLayout layout = TOCropGeometryInitialLayout(TOCropRectFromCGRect(self.contentBounds),
+                                                                   TOCropSizeFromCGSize(imageSize),
+                                                                   TOCropSizeFromCGSize(self.aspectRatio),
+                                                                   self.maximumZoomScale);
 
     // Configure the scroll view
-    self.scrollView.minimumZoomScale = scale;
-    self.baseMaximumZoomScale = scale * self.maximumZoomScale;
+    self.scrollView.minimumZoomScale = layout.minimumZoomScale;
+    self.baseMaximumZoomScale = layout.maximumZoomScale;
     [self updateScrollViewMaximumZoomScale];
 
     // Set the crop box to the size we calculated and align in the middle of the screen
-    CGRect frame = CGRectZero;
-    frame.size = self.hasAspectRatio ? cropBoxSize : scaledSize;
-    frame.origin.x = floorf(bounds.origin.x + floorf((CGRectGetWidth(bounds) - frame.size.width) * 0.5f));
-    frame.origin.y = floorf(bounds.origin.y + floorf((CGRectGetHeight(bounds) - frame.size.height) * 0.5f));
-    self.cropBoxFrame = frame;
+    self.cropBoxFrame = CGRectFromTOCropRect(layout.cropBoxFrame);
 
     // set the fully zoomed out state initially
     self.scrollView.zoomScale = self.scrollView.minimumZoomScale;
-    self.scrollView.contentSize = scaledSize;
+    self.scrollView.contentSize = (CGSize){layout.contentSize.width, layout.contentSize.height};
 
     // If we ended up with a smaller crop box than the content, line up the content so its center
     // is in the center of the cropbox
-    if (frame.size.width < scaledSize.width - FLT_EPSILON || frame.size.height < scaledSize.height - FLT_EPSILON) {
-        CGPoint offset = CGPointZero;
-        offset.x = -floorf(CGRectGetMidX(bounds) - (scaledSize.width * 0.5f));
-        offset.y = -floorf(CGRectGetMidY(bounds) - (scaledSize.height * 0.5f));
-        self.scrollView.contentOffset = offset;
+    if (layout.centersContent) {
+        self.scrollView.contentOffset = CGPointFromTOCropPoint(layout.contentOffset);
     }
 
     // save the current state for use with 90-degree rotations
@@ -320,11 +510,12 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     [self captureStateForImageRotation];
 
     // save the size for checking if we're in a resettable state
-    self.originalCropBoxSize = self.resetAspectRatioEnabled ? scaledImageSize : self.cropBoxFrame.size;
+    self.originalCropBoxSize = self.resetAspectRatioEnabled ? (CGSize){layout.fittedSize.width, layout.fittedSize.height} : self.cropBoxFrame.size;
     self.originalContentOffset = self.scrollView.contentOffset;
 
     [self checkForCanReset];
     [self matchForegroundToBackground];
+    [self commitLayoutTransaction];
 }
 
 - (void)prepareforRotation {
@@ -334,341 +525,77 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 }
 
 - (void)performRelayoutForRotation {
-    CGRect cropFrame = self.cropBoxFrame;
-    CGRect contentFrame = self.contentBounds;
-
-    CGFloat scale = MIN(contentFrame.size.width / cropFrame.size.width, contentFrame.size.height / cropFrame.size.height);
-    self.scrollView.minimumZoomScale *= scale;
-    self.baseMaximumZoomScale *= scale;
+    // Scale the crop box up to fill the new content bounds, and zoom in by the same amount
+    [self beginLayoutTransaction];
+    TOCropLayout layout = self.geometryLayout;
+    const TOCropLayoutUpdate update = TOCropGeometryLayoutForResizedBounds(&layout);
+    self.scrollView.minimumZoomScale *= update.scale;
+    self.baseMaximumZoomScale *= update.scale;
     [self updateScrollViewMaximumZoomScale];
-    self.scrollView.zoomScale *= scale;
-
-    // Work out the centered, upscaled version of the crop rectangle
-    cropFrame.size.width = floorf(cropFrame.size.width * scale);
-    cropFrame.size.height = floorf(cropFrame.size.height * scale);
-    cropFrame.origin.x = floorf(contentFrame.origin.x + ((contentFrame.size.width - cropFrame.size.width) * 0.5f));
-    cropFrame.origin.y = floorf(contentFrame.origin.y + ((contentFrame.size.height - cropFrame.size.height) * 0.5f));
-    self.cropBoxFrame = cropFrame;
+    self.scrollView.zoomScale *= update.scale;
+    self.cropBoxFrame = CGRectFromTOCropRect(update.cropBoxFrame);
 
     [self captureStateForImageRotation];
 
-    // Work out the center point of the content before we rotated
-    CGPoint oldMidPoint = (CGPoint){CGRectGetMidX(self.rotationBoundFrame), CGRectGetMidY(self.rotationBoundFrame)};
-    CGPoint contentCenter = (CGPoint){self.rotationContentOffset.x + oldMidPoint.x, self.rotationContentOffset.y + oldMidPoint.y};
-
-    // Normalize it to a percentage we can apply to different sizes
-    CGPoint normalizedCenter = CGPointZero;
-    normalizedCenter.x = contentCenter.x / self.rotationContentSize.width;
-    normalizedCenter.y = contentCenter.y / self.rotationContentSize.height;
-
-    // Work out the new content offset by applying the normalized values to the new layout
-    CGPoint newMidPoint = (CGPoint){CGRectGetMidX(self.contentBounds), CGRectGetMidY(self.contentBounds)};
-
-    CGPoint translatedContentOffset = CGPointZero;
-    translatedContentOffset.x = self.scrollView.contentSize.width * normalizedCenter.x;
-    translatedContentOffset.y = self.scrollView.contentSize.height * normalizedCenter.y;
-
-    CGPoint offset = CGPointZero;
-    offset.x = floorf(translatedContentOffset.x - newMidPoint.x);
-    offset.y = floorf(translatedContentOffset.y - newMidPoint.y);
-
-    // Make sure it doesn't overshoot the top left corner of the crop box
-    offset.x = MAX(-self.scrollView.contentInset.left, offset.x);
-    offset.y = MAX(-self.scrollView.contentInset.top, offset.y);
-
-    // Nor undershoot the bottom right corner
-    CGPoint maximumOffset = CGPointZero;
-    maximumOffset.x = self.scrollView.contentSize.width - (self.bounds.size.width - self.scrollView.contentInset.right);
-    maximumOffset.y = self.scrollView.contentSize.height - (self.bounds.size.height - self.scrollView.contentInset.bottom);
-    offset.x = MIN(offset.x, maximumOffset.x);
-    offset.y = MIN(offset.y, maximumOffset.y);
-    self.scrollView.contentOffset = offset;
+    // Keep the same part of the image in the middle of the crop box as before the rotation
+    layout = self.geometryLayout;
+    const TOCropPoint offset = TOCropGeometryContentOffsetKeepingCenter(&layout,
+                                                                        TOCropRectFromCGRect(self.rotationBoundFrame),
+                                                                        TOCropPointFromCGPoint(self.rotationContentOffset),
+                                                                        TOCropSizeFromCGSize(self.rotationContentSize));
+    self.scrollView.contentOffset = CGPointFromTOCropPoint(offset);
 
     // Line up the background instance of the image
     [self matchForegroundToBackground];
+    [self commitLayoutTransaction];
 }
 
 - (void)matchForegroundToBackground {
-    if (self.disableForgroundMatching)
+    // Every scroll view change would otherwise ask for this, so a transaction only does it once, as it commits
+    if (self.layoutTransactionDepth > 0) {
+        self.foregroundNeedsMatching = YES;
         return;
-
-    // We can't simply match the frames since if the images are rotated, the frame property becomes unusable
-    self.foregroundImageView.frame = [self.backgroundContainerView.superview
-        convertRect:self.backgroundContainerView.frame
-             toView:self.foregroundContainerView];
-}
-
-- (void)updateCropBoxFrameWithGesturePoint:(CGPoint)point {
-    CGRect frame = self.cropBoxFrame;
-    CGRect originFrame = self.cropOriginFrame;
-    CGRect contentFrame = self.contentBounds;
-
-    point.x = MAX(contentFrame.origin.x - self.cropViewPadding, point.x);
-    point.y = MAX(contentFrame.origin.y - self.cropViewPadding, point.y);
-
-    // The delta between where we first tapped, and where our finger is now
-    CGFloat xDelta = ceilf(point.x - self.panOriginPoint.x);
-    CGFloat yDelta = ceilf(point.y - self.panOriginPoint.y);
-
-    // Current aspect ratio of the crop box in case we need to clamp it
-    CGFloat aspectRatio = (originFrame.size.width / originFrame.size.height);
-
-    // Note whether we're being aspect transformed horizontally or vertically
-    BOOL aspectHorizontal = NO, aspectVertical = NO;
-
-    // Depending on which corner we drag from, set the appropriate min flag to
-    // ensure we can properly clamp the XY value of the box if it overruns the minimum size
-    //(Otherwise the image itself will slide with the drag gesture)
-    BOOL clampMinFromTop = NO, clampMinFromLeft = NO;
-
-    switch (self.tappedEdge) {
-    case TOCropViewOverlayEdgeLeft:
-        if (self.aspectRatioLockEnabled) {
-            aspectHorizontal = YES;
-            xDelta = MAX(xDelta, 0);
-            CGPoint scaleOrigin = (CGPoint){CGRectGetMaxX(originFrame), CGRectGetMidY(originFrame)};
-            frame.size.height = frame.size.width / aspectRatio;
-            frame.origin.y = scaleOrigin.y - (frame.size.height * 0.5f);
-        }
-        CGFloat newWidth = originFrame.size.width - xDelta;
-        CGFloat newHeight = originFrame.size.height;
-        if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-            frame.origin.x = originFrame.origin.x + xDelta;
-            frame.size.width = originFrame.size.width - xDelta;
-        }
-
-        clampMinFromLeft = YES;
-
-        break;
-    case TOCropViewOverlayEdgeRight:
-        if (self.aspectRatioLockEnabled) {
-            aspectHorizontal = YES;
-            CGPoint scaleOrigin = (CGPoint){CGRectGetMinX(originFrame), CGRectGetMidY(originFrame)};
-            frame.size.height = frame.size.width / aspectRatio;
-            frame.origin.y = scaleOrigin.y - (frame.size.height * 0.5f);
-            frame.size.width = originFrame.size.width + xDelta;
-            frame.size.width = MIN(frame.size.width, contentFrame.size.height * aspectRatio);
-        } else {
-            CGFloat newWidth = originFrame.size.width + xDelta;
-            CGFloat newHeight = originFrame.size.height;
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.size.width = originFrame.size.width + xDelta;
-            }
-        }
-
-        break;
-    case TOCropViewOverlayEdgeBottom:
-        if (self.aspectRatioLockEnabled) {
-            aspectVertical = YES;
-            CGPoint scaleOrigin = (CGPoint){CGRectGetMidX(originFrame), CGRectGetMinY(originFrame)};
-            frame.size.width = frame.size.height * aspectRatio;
-            frame.origin.x = scaleOrigin.x - (frame.size.width * 0.5f);
-            frame.size.height = originFrame.size.height + yDelta;
-            frame.size.height = MIN(frame.size.height, contentFrame.size.width / aspectRatio);
-        } else {
-            CGFloat newWidth = originFrame.size.width;
-            CGFloat newHeight = originFrame.size.height + yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.size.height = originFrame.size.height + yDelta;
-            }
-        }
-        break;
-    case TOCropViewOverlayEdgeTop:
-        if (self.aspectRatioLockEnabled) {
-            aspectVertical = YES;
-            yDelta = MAX(0, yDelta);
-            CGPoint scaleOrigin = (CGPoint){CGRectGetMidX(originFrame), CGRectGetMaxY(originFrame)};
-            frame.size.width = frame.size.height * aspectRatio;
-            frame.origin.x = scaleOrigin.x - (frame.size.width * 0.5f);
-            frame.origin.y = originFrame.origin.y + yDelta;
-            frame.size.height = originFrame.size.height - yDelta;
-        } else {
-            CGFloat newWidth = originFrame.size.width;
-            CGFloat newHeight = originFrame.size.height - yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.origin.y = originFrame.origin.y + yDelta;
-                frame.size.height = originFrame.size.height - yDelta;
-            }
-        }
-
-        clampMinFromTop = YES;
-
-        break;
-    case TOCropViewOverlayEdgeTopLeft:
-        if (self.aspectRatioLockEnabled) {
-            xDelta = MAX(xDelta, 0);
-            yDelta = MAX(yDelta, 0);
-
-            CGPoint distance;
-            distance.x = 1.0f - (xDelta / CGRectGetWidth(originFrame));
-            distance.y = 1.0f - (yDelta / CGRectGetHeight(originFrame));
-
-            CGFloat scale = (distance.x + distance.y) * 0.5f;
-
-            frame.size.width = ceilf(CGRectGetWidth(originFrame) * scale);
-            frame.size.height = ceilf(CGRectGetHeight(originFrame) * scale);
-            frame.origin.x = originFrame.origin.x + (CGRectGetWidth(originFrame) - frame.size.width);
-            frame.origin.y = originFrame.origin.y + (CGRectGetHeight(originFrame) - frame.size.height);
-
-            aspectVertical = YES;
-            aspectHorizontal = YES;
-        } else {
-            CGFloat newWidth = originFrame.size.width - xDelta;
-            CGFloat newHeight = originFrame.size.height - yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.origin.x = originFrame.origin.x + xDelta;
-                frame.size.width = originFrame.size.width - xDelta;
-                frame.origin.y = originFrame.origin.y + yDelta;
-                frame.size.height = originFrame.size.height - yDelta;
-            }
-        }
-
-        clampMinFromTop = YES;
-        clampMinFromLeft = YES;
-
-        break;
-    case TOCropViewOverlayEdgeTopRight:
-        if (self.aspectRatioLockEnabled) {
-            xDelta = MIN(xDelta, 0);
-            yDelta = MAX(yDelta, 0);
-
-            CGPoint distance;
-            distance.x = 1.0f - ((-xDelta) / CGRectGetWidth(originFrame));
-            distance.y = 1.0f - ((yDelta) / CGRectGetHeight(originFrame));
-
-            CGFloat scale = (distance.x + distance.y) * 0.5f;
-
-            frame.size.width = ceilf(CGRectGetWidth(originFrame) * scale);
-            frame.size.height = ceilf(CGRectGetHeight(originFrame) * scale);
-            frame.origin.y = originFrame.origin.y + (CGRectGetHeight(originFrame) - frame.size.height);
-
-            aspectVertical = YES;
-            aspectHorizontal = YES;
-        } else {
-            CGFloat newWidth = originFrame.size.width + xDelta;
-            CGFloat newHeight = originFrame.size.height - yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.size.width = originFrame.size.width + xDelta;
-                frame.origin.y = originFrame.origin.y + yDelta;
-                frame.size.height = originFrame.size.height - yDelta;
-            }
-        }
-
-        clampMinFromTop = YES;
-
-        break;
-    case TOCropViewOverlayEdgeBottomLeft:
-        if (self.aspectRatioLockEnabled) {
-            CGPoint distance;
-            distance.x = 1.0f - (xDelta / CGRectGetWidth(originFrame));
-            distance.y = 1.0f - (-yDelta / CGRectGetHeight(originFrame));
-
-            CGFloat scale = (distance.x + distance.y) * 0.5f;
-
-            frame.size.width = ceilf(CGRectGetWidth(originFrame) * scale);
-            frame.size.height = ceilf(CGRectGetHeight(originFrame) * scale);
-            frame.origin.x = CGRectGetMaxX(originFrame) - frame.size.width;
-
-            aspectVertical = YES;
-            aspectHorizontal = YES;
-        } else {
-            CGFloat newWidth = originFrame.size.width - xDelta;
-            CGFloat newHeight = originFrame.size.height + yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.size.height = originFrame.size.height + yDelta;
-                frame.origin.x = originFrame.origin.x + xDelta;
-                frame.size.width = originFrame.size.width - xDelta;
-            }
-        }
-
-        clampMinFromLeft = YES;
-
-        break;
-    case TOCropViewOverlayEdgeBottomRight:
-        if (self.aspectRatioLockEnabled) {
-            CGPoint distance;
-            distance.x = 1.0f - ((-1 * xDelta) / CGRectGetWidth(originFrame));
-            distance.y = 1.0f - ((-1 * yDelta) / CGRectGetHeight(originFrame));
-
-            CGFloat scale = (distance.x + distance.y) * 0.5f;
-
-            frame.size.width = ceilf(CGRectGetWidth(originFrame) * scale);
-            frame.size.height = ceilf(CGRectGetHeight(originFrame) * scale);
-
-            aspectVertical = YES;
-            aspectHorizontal = YES;
-        } else {
-            CGFloat newWidth = originFrame.size.width + xDelta;
-            CGFloat newHeight = originFrame.size.height + yDelta;
-
-            if (MIN(newHeight, newWidth) / MAX(newHeight, newWidth) >= (double)_minimumAspectRatio) {
-                frame.size.height = originFrame.size.height + yDelta;
-                frame.size.width = originFrame.size.width + xDelta;
-            }
-        }
-        break;
-    case TOCropViewOverlayEdgeNone:
-        break;
     }
 
-    // The absolute max/min size the box may be in the bounds of the crop view
-    CGSize minSize = (CGSize){kTOCropViewMinimumBoxSize, kTOCropViewMinimumBoxSize};
-    CGSize maxSize = (CGSize){CGRectGetWidth(contentFrame), CGRectGetHeight(contentFrame)};
+    // We can't simply match the frames since if the images are rotated, the frame property becomes unusable.
+    // The straightening view is only ever turned, so it's placed by its bounds and center instead.
+    const CGRect imageFrame = [self.backgroundContainerView.superview convertRect:self.backgroundContainerView.frame
+                                                                           toView:self.foregroundContainerView];
+    self.foregroundStraighteningView.bounds = (CGRect){CGPointZero, imageFrame.size};
+    self.foregroundStraighteningView.center = (CGPoint){CGRectGetMidX(imageFrame), CGRectGetMidY(imageFrame)};
+    self.foregroundImageView.frame = self.foregroundStraighteningView.bounds;
 
-    // clamp the box to ensure it doesn't go beyond the bounds we've set
-    if (self.aspectRatioLockEnabled && aspectHorizontal) {
-        maxSize.height = contentFrame.size.width / aspectRatio;
-        minSize.width = kTOCropViewMinimumBoxSize * aspectRatio;
-    }
-
-    if (self.aspectRatioLockEnabled && aspectVertical) {
-        maxSize.width = contentFrame.size.height * aspectRatio;
-        minSize.height = kTOCropViewMinimumBoxSize / aspectRatio;
-    }
-
-    // Clamp the width if it goes over
-    if (clampMinFromLeft) {
-        CGFloat maxWidth = CGRectGetMaxX(self.cropOriginFrame) - contentFrame.origin.x;
-        frame.size.width = MIN(frame.size.width, maxWidth);
-    }
-
-    if (clampMinFromTop) {
-        CGFloat maxHeight = CGRectGetMaxY(self.cropOriginFrame) - contentFrame.origin.y;
-        frame.size.height = MIN(frame.size.height, maxHeight);
-    }
+    // Follow the crop box with the full resolution tiles, if they're being shown
+    [self updateVisibleTiles];
 
-    // Clamp the minimum size
-    frame.size.width = MAX(frame.size.width, minSize.width);
-    frame.size.height = MAX(frame.size.height, minSize.height);
-
-    // Clamp the maximum size
-    frame.size.width = MIN(frame.size.width, maxSize.width);
-    frame.size.height = MIN(frame.size.height, maxSize.height);
-
-    // Clamp the X position of the box to the interior of the cropping bounds
-    frame.origin.x = MAX(frame.origin.x, CGRectGetMinX(contentFrame));
-    frame.origin.x = MIN(frame.origin.x, CGRectGetMaxX(contentFrame) - minSize.width);
-
-    // Clamp the Y postion of the box to the interior of the cropping bounds
-    frame.origin.y = MAX(frame.origin.y, CGRectGetMinY(contentFrame));
-    frame.origin.y = MIN(frame.origin.y, CGRectGetMaxY(contentFrame) - minSize.height);
-
-    // Once the box is completely shrunk, clamp its ability to move
-    if (clampMinFromLeft && frame.size.width <= minSize.width + FLT_EPSILON) {
-        frame.origin.x = CGRectGetMaxX(originFrame) - minSize.width;
-    }
+    // And keep the quadrilateral over the same part of the image
+    [self updateQuadrilateralView];
+}
 
-    // Once the box is completely shrunk, clamp its ability to move
-    if (clampMinFromTop && frame.size.height <= minSize.height + FLT_EPSILON) {
-        frame.origin.y = CGRectGetMaxY(originFrame) - minSize.height;
+- (void)updateCropBoxFrameWithGesturePoint:(CGPoint)point {
+    TOCropResize resize;
+    resize.edge = self.tappedEdge;
+    resize.originFrame = TOCropRectFromCGRect(self.cropOriginFrame);
+    resize.originPoint = TOCropPointFromCGPoint(self.panOriginPoint);
+    resize.padding = self.cropViewPadding;
+    resize.aspectRatioLocked = self.aspectRatioLockEnabled;
+    resize.minimumAspectRatio = self.minimumAspectRatio;
+
+    const TOCropLayout layout = self.geometryLayout;
+    TOCropRect frame = TOCropGeometryResizeCropBox(&layout, &resize, TOCropPointFromCGPoint(point));
+
+    // If the box has come close to the shape of a preset, pull it the rest of the way.
+    // Finding the closest preset is a binary search, so this stays cheap however many are registered.
+    if (self.aspectRatioSnappingEnabled && !resize.aspectRatioLocked) {
+        TOCropViewControllerAspectRatioPreset *preset =
+            [TOCropViewControllerAspectRatioPreset registeredPresetNearestToAspectRatio:frame.size.width / frame.size.height
+                                                                             tolerance:self.aspectRatioSnappingTolerance];
+        if (preset) {
+            frame = TOCropGeometrySnapCropBoxToAspectRatio(&layout, &resize, frame, preset.size.width / preset.size.height);
+        }
     }
 
-    self.cropBoxFrame = frame;
+    self.cropBoxFrame = CGRectFromTOCropRect(frame);
 
     [self checkForCanReset];
 }
@@ -681,9 +608,11 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         _aspectRatio = CGSizeZero;
     }
 
-    if (animated == NO || self.angle != 0) {
+    if (animated == NO || self.angle != 0 || self.straighteningAngle != 0.0f) {
         // Reset all of the rotation transforms
         _angle = 0;
+        _straighteningAngle = 0.0f;
+        [self applyStraighteningTransform];
 
         // Set the scroll to 1.0f to reset the transform scale
         self.scrollView.zoomScale = 1.0f;
@@ -702,6 +631,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 
         // Reset the layout
         [self layoutInitialImage];
+        [self resetCropQuadrilateral];
 
         // Enable / Disable the reset button
         [self checkForCanReset];
@@ -727,6 +657,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
             options:UIViewAnimationOptionBeginFromCurrentState
             animations:^{
                 [self layoutInitialImage];
+                [self resetCropQuadrilateral];
             }
             completion:^(BOOL complete) {
                 [self setSimpleRenderMode:NO animated:YES];
@@ -735,42 +666,150 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 }
 
 - (void)toggleTranslucencyViewVisible:(BOOL)visible {
+    self.translucencyVisible = visible;
+
+    // The backdrop is a plain image, so fading it is all it takes
+    if (self.backdropImageView) {
+        self.backdropImageView.alpha = visible ? 1.0f : 0.0f;
+        return;
+    }
+
     [(UIVisualEffectView *)self.translucencyView setEffect:visible ? self.translucencyEffect : nil];
 }
 
 - (void)updateToImageCropFrame:(CGRect)imageCropframe {
-    // Convert the image crop frame's size from image space to the screen space
-    CGFloat minimumSize = self.scrollView.minimumZoomScale;
-    CGPoint scaledOffset = (CGPoint){imageCropframe.origin.x * minimumSize, imageCropframe.origin.y * minimumSize};
-    CGSize scaledCropSize = (CGSize){imageCropframe.size.width * minimumSize, imageCropframe.size.height * minimumSize};
-
-    // Work out the scale necessary to upscale the crop size to fit the content bounds of the crop bound
-    CGRect bounds = self.contentBounds;
-    CGFloat scale = MIN(bounds.size.width / scaledCropSize.width, bounds.size.height / scaledCropSize.height);
+    const TOCropLayout layout = self.geometryLayout;
+    const TOCropLayoutUpdate update = TOCropGeometryLayoutForImageCropFrame(&layout, TOCropRectFromCGRect(imageCropframe));
+    [self beginLayoutTransaction];
 
     // Zoom into the scroll view to the appropriate size, transiently raising the
     // ceiling if the restored crop requires more zoom than is normally allowed
     // (the next layout-driven update re-derives the ceiling from the base value)
-    self.scrollView.maximumZoomScale = MAX(self.scrollView.maximumZoomScale, self.scrollView.minimumZoomScale * scale);
-    self.scrollView.zoomScale = self.scrollView.minimumZoomScale * scale;
+    self.scrollView.maximumZoomScale = MAX(self.scrollView.maximumZoomScale, update.zoomScale);
+    self.scrollView.zoomScale = update.zoomScale;
 
     CGSize contentSize = self.scrollView.contentSize;
     self.scrollView.contentSize = CGSizeMake(floorf(contentSize.width), floorf(contentSize.height));
 
-    // Work out the size and offset of the upscaled crop box
-    CGRect frame = CGRectZero;
-    frame.size = (CGSize){floorf(scaledCropSize.width * scale), floorf(scaledCropSize.height * scale)};
+    // set the crop box, and scroll the region to the top left of it
+    self.cropBoxFrame = CGRectFromTOCropRect(update.cropBoxFrame);
+    self.scrollView.contentOffset = CGPointFromTOCropPoint(update.contentOffset);
+    [self commitLayoutTransaction];
+}
+
+#pragma mark - Backdrop -
+
+- (void)prepareBackdropImage {
+    if (!self.precomputedTranslucencyEnabled || self.backdropImageView) {
+        return;
+    }
+
+    // The blur is baked into the image at the size it appears when zoomed all the way out.
+    // Until it's ready, the live blur stays in place.
+    const CGFloat blurRadius = kTOCropBackdropBlurRadius / MAX(self.scrollView.minimumZoomScale, FLT_EPSILON);
+    UIImage *image = self.image;
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        UIImage *backdropImage = [image backdropImageWithMaximumPixelSize:kTOCropBackdropMaximumPixelSize
+                                                               blurRadius:blurRadius
+                                                               brightness:kTOCropBackdropBrightness];
+        if (backdropImage == nil) {
+            return;
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (weakSelf.precomputedTranslucencyEnabled) {
+                [weakSelf applyBackdropImage:backdropImage];
+            }
+        });
+    });
+}
 
-    // set the crop box
-    CGRect cropBoxFrame = CGRectZero;
-    cropBoxFrame.size = frame.size;
-    cropBoxFrame.origin.x = floorf(CGRectGetMidX(bounds) - (frame.size.width * 0.5f));
-    cropBoxFrame.origin.y = floorf(CGRectGetMidY(bounds) - (frame.size.height * 0.5f));
-    self.cropBoxFrame = cropBoxFrame;
+- (void)applyBackdropImage:(UIImage *)backdropImage {
+    // If it won't fit in the memory limit, the live blur stays in place
+    __weak typeof(self) weakSelf = self;
+    self.backdropMemoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop view backdrop"
+                                                                                         byteCount:[TOCropMemoryAccountant byteCountOfImage:backdropImage]
+                                                                                          priority:TOCropMemoryPriorityPreview
+                                                                                   evictionHandler:^{
+        [weakSelf setBackdropImage:nil];
+    }];
+    if (self.backdropMemoryAllocation == nil) {
+        return;
+    }
+
+    [self setBackdropImage:backdropImage];
+}
+
+- (void)setBackdropImage:(nullable UIImage *)backdropImage {
+    if (backdropImage == nil) {
+        [self.backdropMemoryAllocation remove];
+        self.backdropMemoryAllocation = nil;
+        if (self.backdropImageView == nil) {
+            return;
+        }
 
-    frame.origin.x = ceilf((scaledOffset.x * scale) - self.scrollView.contentInset.left);
-    frame.origin.y = ceilf((scaledOffset.y * scale) - self.scrollView.contentInset.top);
-    self.scrollView.contentOffset = frame.origin;
+        [self.backdropImageView removeFromSuperview];
+        self.backdropImageView = nil;
+        [self toggleTranslucencyViewVisible:self.translucencyVisible];
+        return;
+    }
+
+    // Placed inside the background image view, it follows every zoom, scroll and rotation of the
+    // image for free, and the live blur effect can be removed entirely
+    if (self.backdropImageView == nil) {
+        self.backdropImageView = [[UIImageView alloc] initWithFrame:self.backgroundImageView.bounds];
+        self.backdropImageView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        self.backdropImageView.accessibilityIgnoresInvertColors = YES;
+        [self.backgroundImageView addSubview:self.backdropImageView];
+    }
+    self.backdropImageView.image = backdropImage;
+    self.backdropImageView.hidden = self.translucencyAlwaysHidden;
+    [(UIVisualEffectView *)self.translucencyView setEffect:nil];
+    [self toggleTranslucencyViewVisible:self.translucencyVisible];
+}
+
+#pragma mark - Layout Transactions -
+
+/* Changing the crop box touches most of the scroll view's properties, and each of those
+ re-lays out the scroll view and calls back into the delegate. Since a single change in the
+ crop view often sets the crop box several times over, those changes are collected into a
+ transaction instead, and the final state is applied once when the outermost one commits. */
+- (void)beginLayoutTransaction {
+    if (self.layoutTransactionDepth++ > 0) {
+        return;
+    }
+
+    [self.scrollView beginLayoutTransaction];
+}
+
+- (void)commitLayoutTransaction {
+    NSAssert(self.layoutTransactionDepth > 0, @"A layout transaction was committed without being started");
+    if (self.layoutTransactionDepth > 1) {
+        self.layoutTransactionDepth--;
+        return;
+    }
+
+    // The scroll view's delegate callbacks fire as it applies its changes, but
+    // are still inside the transaction here, so they won't match the foreground yet
+    [self.scrollView commitLayoutTransaction];
+    NSUInteger writeCount = self.scrollView.committedPropertyWriteCount;
+
+    if (self.cropBoxViewsNeedLayout) {
+        [self layoutCropBoxViews];
+        self.cropBoxViewsNeedLayout = NO;
+        writeCount++;
+    }
+
+    self.layoutTransactionDepth = 0;
+
+    if (self.foregroundNeedsMatching) {
+        self.foregroundNeedsMatching = NO;
+        [self matchForegroundToBackground];
+        writeCount++;
+    }
+
+    self.layoutCommitWriteCount = writeCount;
 }
 
 #pragma mark - Gesture Recognizer -
@@ -781,13 +820,23 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         [self startEditing];
         self.panOriginPoint = point;
         self.cropOriginFrame = self.cropBoxFrame;
-        self.tappedEdge = [self cropEdgeForPoint:self.panOriginPoint];
+        self.tappedEdge = TOCropGeometryEdgeForPoint(TOCropRectFromCGRect(self.cropBoxFrame), TOCropPointFromCGPoint(self.panOriginPoint));
+        self.tappedQuadrilateralCorner = [self quadrilateralCornerForPoint:point];
+        self.quadrilateralCornerOriginPoint = [self cropQuadrilateralPointForCorner:self.tappedQuadrilateralCorner];
+        [self recordTraceEvent:TOCropTraceEventPanBegan point:point value:0.0f];
+    } else if (recognizer.state == UIGestureRecognizerStateEnded ||
+               recognizer.state == UIGestureRecognizerStateCancelled ||
+               recognizer.state == UIGestureRecognizerStateFailed) {
+        [self startResetTimer];
+        [self recordTraceEvent:TOCropTraceEventPanEnded point:point value:0.0f];
+    } else {
+        [self recordTraceEvent:TOCropTraceEventPanMoved point:point value:0.0f];
     }
 
-    if (recognizer.state == UIGestureRecognizerStateEnded ||
-        recognizer.state == UIGestureRecognizerStateCancelled ||
-        recognizer.state == UIGestureRecognizerStateFailed) {
-        [self startResetTimer];
+    // Dragging a corner of the quadrilateral leaves the crop box where it is
+    if (self.tappedQuadrilateralCorner != TOCropEdgeNone) {
+        [self moveCropQuadrilateralCornerWithGesturePoint:point];
+        return;
     }
 
     [self updateCropBoxFrameWithGesturePoint:point];
@@ -807,6 +856,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 
     CGPoint tapPoint = [gestureRecognizer locationInView:self];
 
+    // The quadrilateral's corners can be dragged wherever they are over the image
+    if ([self quadrilateralCornerForPoint:tapPoint] != TOCropEdgeNone)
+        return YES;
+
     CGRect frame = self.gridOverlayView.frame;
     CGRect innerFrame = CGRectInset(frame, 22.0f, 22.0f);
     CGRect outerFrame = CGRectInset(frame, -22.0f, -22.0f);
@@ -858,6 +911,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     [self setEditing:NO resetCropBox:YES animated:YES];
     [self.resetTimer invalidate];
     self.resetTimer = nil;
+
+    if ([self.delegate respondsToSelector:@selector(cropViewDidEndEditing:)]) {
+        [self.delegate cropViewDidEndEditing:self];
+    }
 }
 
 - (void)cancelResetTimer {
@@ -865,60 +922,17 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.resetTimer = nil;
 }
 
-- (TOCropViewOverlayEdge)cropEdgeForPoint:(CGPoint)point {
-    CGRect frame = self.cropBoxFrame;
-
-    // account for padding around the box
-    frame = CGRectInset(frame, -32.0f, -32.0f);
-
-    // Make sure the corners take priority
-    CGRect topLeftRect = (CGRect){frame.origin, {64, 64}};
-    if (CGRectContainsPoint(topLeftRect, point))
-        return TOCropViewOverlayEdgeTopLeft;
-
-    CGRect topRightRect = topLeftRect;
-    topRightRect.origin.x = CGRectGetMaxX(frame) - 64.0f;
-    if (CGRectContainsPoint(topRightRect, point))
-        return TOCropViewOverlayEdgeTopRight;
-
-    CGRect bottomLeftRect = topLeftRect;
-    bottomLeftRect.origin.y = CGRectGetMaxY(frame) - 64.0f;
-    if (CGRectContainsPoint(bottomLeftRect, point))
-        return TOCropViewOverlayEdgeBottomLeft;
-
-    CGRect bottomRightRect = topRightRect;
-    bottomRightRect.origin.y = bottomLeftRect.origin.y;
-    if (CGRectContainsPoint(bottomRightRect, point))
-        return TOCropViewOverlayEdgeBottomRight;
-
-    // Check for edges
-    CGRect topRect = (CGRect){frame.origin, {CGRectGetWidth(frame), 64.0f}};
-    if (CGRectContainsPoint(topRect, point))
-        return TOCropViewOverlayEdgeTop;
-
-    CGRect bottomRect = topRect;
-    bottomRect.origin.y = CGRectGetMaxY(frame) - 64.0f;
-    if (CGRectContainsPoint(bottomRect, point))
-        return TOCropViewOverlayEdgeBottom;
-
-    CGRect leftRect = (CGRect){frame.origin, {64.0f, CGRectGetHeight(frame)}};
-    if (CGRectContainsPoint(leftRect, point))
-        return TOCropViewOverlayEdgeLeft;
-
-    CGRect rightRect = leftRect;
-    rightRect.origin.x = CGRectGetMaxX(frame) - 64.0f;
-    if (CGRectContainsPoint(rightRect, point))
-        return TOCropViewOverlayEdgeRight;
-
-    return TOCropViewOverlayEdgeNone;
-}
-
 #pragma mark - Scroll View Delegate -
 
 - (UIView *)viewForZoomingInScrollView:(UIScrollView *)scrollView {
     return self.backgroundContainerView;
 }
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView {
+    // Only the user's own scrolling is recorded, since the rest is replayed from what caused it
+    if ((scrollView.isDragging || scrollView.isDecelerating) && !scrollView.isZooming) {
+        [self recordTraceEvent:TOCropTraceEventScroll point:scrollView.contentOffset value:0.0f];
+    }
+
     [self matchForegroundToBackground];
 }
 
@@ -949,7 +963,12 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         self.cropBoxLastEditedMaxZoomScale = self.baseMaximumZoomScale;
     }
 
+    if (scrollView.isZooming || scrollView.isZoomBouncing) {
+        [self recordTraceEvent:TOCropTraceEventZoom point:scrollView.contentOffset value:scrollView.zoomScale];
+    }
+
     [self matchForegroundToBackground];
+    [self updateMipmapLevel];
 }
 
 - (void)scrollViewDidEndDragging:(UIScrollView *)scrollView willDecelerate:(BOOL)decelerate {
@@ -969,61 +988,25 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         return;
     }
 
-    // Upon init, sometimes the box size is still 0 (or NaN), which can result in CALayer issues
-    CGSize frameSize = cropBoxFrame.size;
-    if (frameSize.width < FLT_EPSILON || frameSize.height < FLT_EPSILON) {
-        return;
-    }
-    if (isnan(frameSize.width) || isnan(frameSize.height)) {
+    // clamp the cropping region to the inset boundaries of the screen
+    TOCropRect clampedFrame;
+    if (!TOCropGeometryClampCropBox(TOCropRectFromCGRect(self.contentBounds), TOCropRectFromCGRect(cropBoxFrame), &clampedFrame)) {
         return;
     }
 
-    // clamp the cropping region to the inset boundaries of the screen
-    CGRect contentFrame = self.contentBounds;
-    CGFloat xOrigin = ceilf(contentFrame.origin.x);
-    CGFloat xDelta = cropBoxFrame.origin.x - xOrigin;
-    cropBoxFrame.origin.x = floorf(MAX(cropBoxFrame.origin.x, xOrigin));
-    if (xDelta < -FLT_EPSILON)  // If we clamp the x value, ensure we compensate for the subsequent delta generated in the width (Or else, the box will keep growing)
-        cropBoxFrame.size.width += xDelta;
-
-    CGFloat yOrigin = ceilf(contentFrame.origin.y);
-    CGFloat yDelta = cropBoxFrame.origin.y - yOrigin;
-    cropBoxFrame.origin.y = floorf(MAX(cropBoxFrame.origin.y, yOrigin));
-    if (yDelta < -FLT_EPSILON)
-        cropBoxFrame.size.height += yDelta;
-
-    // given the clamped X/Y values, make sure we can't extend the crop box beyond the edge of the screen in the current state
-    CGFloat maxWidth = (contentFrame.size.width + contentFrame.origin.x) - cropBoxFrame.origin.x;
-    cropBoxFrame.size.width = floorf(MIN(cropBoxFrame.size.width, maxWidth));
-
-    CGFloat maxHeight = (contentFrame.size.height + contentFrame.origin.y) - cropBoxFrame.origin.y;
-    cropBoxFrame.size.height = floorf(MIN(cropBoxFrame.size.height, maxHeight));
+    _cropBoxFrame = CGRectFromTOCropRect(clampedFrame);
 
-    // Make sure we can't make the crop box too small
-    cropBoxFrame.size.width = MAX(cropBoxFrame.size.width, kTOCropViewMinimumBoxSize);
-    cropBoxFrame.size.height = MAX(cropBoxFrame.size.height, kTOCropViewMinimumBoxSize);
-
-    _cropBoxFrame = cropBoxFrame;
-
-    self.foregroundContainerView.frame = _cropBoxFrame;  // set the clipping view to match the new rect
-    self.gridOverlayView.frame = _cropBoxFrame;          // set the new overlay view to match the same region
-
-    // If the mask layer is present, adjust its transform to fit the new container view size
-    if (self.croppingStyle == TOCropViewCroppingStyleCircular) {
-        CGFloat halfWidth = self.foregroundContainerView.frame.size.width * 0.5f;
-        self.foregroundContainerView.layer.cornerRadius = halfWidth;
-    }
+    // The crop box can be set several times over in one layout pass, so only move its views once it's settled
+    [self beginLayoutTransaction];
+    self.cropBoxViewsNeedLayout = YES;
 
     // reset the scroll view insets to match the region of the new crop rect
-    self.scrollView.contentInset = (UIEdgeInsets){CGRectGetMinY(_cropBoxFrame),
-                                                  CGRectGetMinX(_cropBoxFrame),
-                                                  CGRectGetMaxY(self.bounds) - CGRectGetMaxY(_cropBoxFrame),
-                                                  CGRectGetMaxX(self.bounds) - CGRectGetMaxX(_cropBoxFrame)};
+    const TOCropInsets insets = TOCropGeometryContentInsetForCropBox(TOCropRectFromCGRect(self.bounds), clampedFrame);
+    self.scrollView.contentInset = (UIEdgeInsets){insets.top, insets.left, insets.bottom, insets.right};
 
     // if necessary, work out the new minimum size of the scroll view so it fills the crop box
-    CGSize imageSize = self.backgroundContainerView.bounds.size;
-    CGFloat scale = MAX(cropBoxFrame.size.height / imageSize.height, cropBoxFrame.size.width / imageSize.width);
-    self.scrollView.minimumZoomScale = scale;
+    const CGSize imageSize = self.backgroundContainerView.bounds.size;
+    self.scrollView.minimumZoomScale = TOCropGeometryMinimumZoomScale(TOCropSizeFromCGSize(imageSize), clampedFrame.size);
     [self updateScrollViewMaximumZoomScale];
 
     // make sure content isn't smaller than the crop box
@@ -1036,6 +1019,17 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.scrollView.zoomScale = self.scrollView.zoomScale;
 
     [self matchForegroundToBackground];  // re-align the background content to match
+    [self commitLayoutTransaction];
+}
+
+- (void)layoutCropBoxViews {
+    self.foregroundContainerView.frame = _cropBoxFrame;  // set the clipping view to match the new rect
+    self.gridOverlayView.frame = _cropBoxFrame;          // set the new overlay view to match the same region
+
+    // If the mask layer is present, adjust its transform to fit the new container view size
+    if (self.croppingStyle == TOCropViewCroppingStyleCircular) {
+        self.foregroundContainerView.layer.cornerRadius = _cropBoxFrame.size.width * 0.5f;
+    }
 }
 
 - (void)setEditing:(BOOL)editing {
@@ -1052,36 +1046,8 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 }
 
 - (CGRect)imageCropFrame {
-    CGSize imageSize = self.imageSize;
-    CGSize contentSize = self.scrollView.contentSize;
-    CGRect cropBoxFrame = self.cropBoxFrame;
-    CGPoint contentOffset = self.scrollView.contentOffset;
-    UIEdgeInsets edgeInsets = self.scrollView.contentInset;
-    CGFloat scale = MIN(imageSize.width / contentSize.width, imageSize.height / contentSize.height);
-
-    CGRect frame = CGRectZero;
-
-    // Calculate the normalized origin, clamped inside the image so the size
-    // subtraction below can never go negative (eg, during rubber-band overscroll)
-    frame.origin.x = floorf((floorf(contentOffset.x) + edgeInsets.left) * (imageSize.width / contentSize.width));
-    frame.origin.x = MAX(0, MIN(frame.origin.x, imageSize.width));
-
-    frame.origin.y = floorf((floorf(contentOffset.y) + edgeInsets.top) * (imageSize.height / contentSize.height));
-    frame.origin.y = MAX(0, MIN(frame.origin.y, imageSize.height));
-
-    // Calculate the normalized width, clamped so the rect never extends past the image
-    frame.size.width = ceilf(cropBoxFrame.size.width * scale);
-    frame.size.width = MIN(imageSize.width - frame.origin.x, frame.size.width);
-
-    // Calculate normalized height
-    if (floor(cropBoxFrame.size.width) == floor(cropBoxFrame.size.height)) {
-        frame.size.height = frame.size.width;
-    } else {
-        frame.size.height = ceilf(cropBoxFrame.size.height * scale);
-    }
-    frame.size.height = MIN(imageSize.height - frame.origin.y, frame.size.height);
-
-    return frame;
+    const TOCropLayout layout = self.geometryLayout;
+    return CGRectFromTOCropRect(TOCropGeometryImageCropFrame(&layout));
 }
 
 - (void)setImageCropFrame:(CGRect)imageCropFrame {
@@ -1109,6 +1075,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         self.backgroundImageView.alpha = alpha;
         self.foregroundContainerView.alpha = alpha;
         self.gridOverlayView.alpha = alpha;
+        self.quadrilateralView.alpha = alpha;
 
         [self toggleTranslucencyViewVisible:!hidden];
 
@@ -1122,6 +1089,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
                      animations:^{
                          [self toggleTranslucencyViewVisible:!hidden];
                          self.gridOverlayView.alpha = alpha;
+                         self.quadrilateralView.alpha = alpha;
                      }];
 }
 
@@ -1161,6 +1129,20 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     }
     _translucencyAlwaysHidden = translucencyAlwaysHidden;
     self.translucencyView.hidden = _translucencyAlwaysHidden;
+    self.backdropImageView.hidden = _translucencyAlwaysHidden;
+}
+
+- (void)setPrecomputedTranslucencyEnabled:(BOOL)precomputedTranslucencyEnabled {
+    if (_precomputedTranslucencyEnabled == precomputedTranslucencyEnabled) {
+        return;
+    }
+    _precomputedTranslucencyEnabled = precomputedTranslucencyEnabled;
+
+    if (!_precomputedTranslucencyEnabled) {
+        [self setBackdropImage:nil];
+    } else if (self.initialSetupPerformed) {
+        [self prepareBackdropImage];
+    }
 }
 
 - (void)setGridOverlayHidden:(BOOL)gridOverlayHidden {
@@ -1243,6 +1225,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 - (void)startEditing {
     [self cancelResetTimer];
     [self setEditing:YES resetCropBox:NO animated:YES];
+
+    if ([self.delegate respondsToSelector:@selector(cropViewDidBeginEditing:)]) {
+        [self.delegate cropViewDidBeginEditing:self];
+    }
 }
 
 - (void)setEditing:(BOOL)editing resetCropBox:(BOOL)resetCropbox animated:(BOOL)animated {
@@ -1259,7 +1245,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     [self.gridOverlayView setGridHidden:hidden animated:animated];
 
     if (resetCropbox) {
-        [self moveCroppedContentToCenterAnimated:animated];
+        [self recordTraceEvent:TOCropTraceEventRecenter point:CGPointZero value:0.0f];
+        if (![self moveCroppedContentInsideStraightenedImageAnimated:animated]) {
+            [self moveCroppedContentToCenterAnimated:animated];
+        }
         [self captureStateForImageRotation];
         self.cropBoxLastEditedAngle = self.angle;
     }
@@ -1289,74 +1278,46 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     if (self.internalLayoutDisabled)
         return;
 
-    CGRect contentRect = self.contentBounds;
-    CGRect cropFrame = self.cropBoxFrame;
-
-    // Ensure we only proceed after the crop frame has been setup for the first time
-    if (cropFrame.size.width < FLT_EPSILON || cropFrame.size.height < FLT_EPSILON) {
+    // Work out how much to scale up the crop box to fit full screen, and where to
+    // scroll to re-center the point it's focusing on. (Nothing to do until the
+    // crop frame has been setup for the first time.)
+    const TOCropLayout layout = self.geometryLayout;
+    TOCropLayoutUpdate update;
+    if (!TOCropGeometryCenterCropBox(&layout, &update)) {
         return;
     }
 
-    // The scale we need to scale up the crop box to fit full screen
-    CGFloat scale = MIN(CGRectGetWidth(contentRect) / CGRectGetWidth(cropFrame), CGRectGetHeight(contentRect) / CGRectGetHeight(cropFrame));
-
-    CGPoint focusPoint = (CGPoint){CGRectGetMidX(cropFrame), CGRectGetMidY(cropFrame)};
-    CGPoint midPoint = (CGPoint){CGRectGetMidX(contentRect), CGRectGetMidY(contentRect)};
-
-    cropFrame.size.width = ceilf(cropFrame.size.width * scale);
-    cropFrame.size.height = ceilf(cropFrame.size.height * scale);
-    cropFrame.origin.x = contentRect.origin.x + ceilf((contentRect.size.width - cropFrame.size.width) * 0.5f);
-    cropFrame.origin.y = contentRect.origin.y + ceilf((contentRect.size.height - cropFrame.size.height) * 0.5f);
-
-    // Work out the point on the scroll content that the focusPoint is aiming at
-    CGPoint contentTargetPoint = CGPointZero;
-    contentTargetPoint.x = ((focusPoint.x + self.scrollView.contentOffset.x) * scale);
-    contentTargetPoint.y = ((focusPoint.y + self.scrollView.contentOffset.y) * scale);
-
-    // Work out where the crop box is focusing, so we can re-align to center that point
-    __block CGPoint offset = CGPointZero;
-    offset.x = -midPoint.x + contentTargetPoint.x;
-    offset.y = -midPoint.y + contentTargetPoint.y;
-
-    // clamp the content so it doesn't create any seams around the grid
-    offset.x = MAX(-cropFrame.origin.x, offset.x);
-    offset.y = MAX(-cropFrame.origin.y, offset.y);
-
     __weak typeof(self) weakSelf = self;
     void (^translateBlock)(void) = ^{
         typeof(self) strongSelf = weakSelf;
 
-        // Setting these scroll view properties will trigger
+        // Setting these scroll view properties would trigger
         // the foreground matching method via their delegates,
         // multiple times inside the same animation block, resulting
         // in glitchy animations.
         //
-        // Disable matching for now, and explicitly update at the end.
-        strongSelf.disableForgroundMatching = YES;
+        // Collect them into one transaction, which matches once at the end.
+        [strongSelf beginLayoutTransaction];
         {
             // Slight hack. This method needs to be called during `[UIViewController viewDidLayoutSubviews]`
             // in order for the crop view to resize itself during iPad split screen events.
-            // On the first run, even though scale is exactly 1.0f, performing this multiplication introduces
-            // a floating point noise that zooms the image in by about 5 pixels. This fixes that issue.
-            if (scale < 1.0f - FLT_EPSILON || scale > 1.0f + FLT_EPSILON) {
-                strongSelf.scrollView.zoomScale *= scale;
-                strongSelf.scrollView.zoomScale = MIN(strongSelf.scrollView.maximumZoomScale, strongSelf.scrollView.zoomScale);
+            // (The geometry leaves the scale at exactly 1 in that case, so the zoom isn't disturbed.)
+            if (update.scale != 1.0) {
+                strongSelf.scrollView.zoomScale = update.zoomScale;
             }
 
             // If it turns out the zoom operation would have exceeded the minizum zoom scale, don't apply
             // the content offset
             if (strongSelf.scrollView.zoomScale < strongSelf.scrollView.maximumZoomScale - FLT_EPSILON) {
-                offset.x = MIN(-CGRectGetMaxX(cropFrame) + strongSelf.scrollView.contentSize.width, offset.x);
-                offset.y = MIN(-CGRectGetMaxY(cropFrame) + strongSelf.scrollView.contentSize.height, offset.y);
-                strongSelf.scrollView.contentOffset = offset;
+                const TOCropPoint offset = TOCropGeometryClampContentOffset(update.contentOffset, update.cropBoxFrame,
+                                                                            TOCropSizeFromCGSize(strongSelf.scrollView.contentSize));
+                strongSelf.scrollView.contentOffset = CGPointFromTOCropPoint(offset);
             }
 
-            strongSelf.cropBoxFrame = cropFrame;
+            strongSelf.cropBoxFrame = CGRectFromTOCropRect(update.cropBoxFrame);
         }
-        strongSelf.disableForgroundMatching = NO;
-
-        // Explicitly update the matching at the end of the calculations
         [strongSelf matchForegroundToBackground];
+        [strongSelf commitLayoutTransaction];
     };
 
     if (!animated) {
@@ -1409,86 +1370,22 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         return;
     }
 
-    BOOL zoomOut = NO;
+    [self recordTraceEvent:TOCropTraceEventAspectRatio point:(CGPoint){aspectRatio.width, aspectRatio.height} value:0.0f];
 
-    // Passing in an empty size (or one with a zero component) will revert back to the image aspect ratio
-    if (aspectRatio.width < FLT_EPSILON || aspectRatio.height < FLT_EPSILON) {
-        aspectRatio = (CGSize){self.imageSize.width, self.imageSize.height};
-        zoomOut = YES;  // Prevent from steadily zooming in when cycling between alternate aspectRatios and original
-    }
-
-    CGRect boundsFrame = self.contentBounds;
-    CGRect cropBoxFrame = self.cropBoxFrame;
-    CGPoint offset = self.scrollView.contentOffset;
-
-    BOOL cropBoxIsPortrait = NO;
-    if ((NSInteger)aspectRatio.width == 1 && (NSInteger)aspectRatio.height == 1)
-        cropBoxIsPortrait = self.image.size.width > self.image.size.height;
-    else
-        cropBoxIsPortrait = aspectRatio.width < aspectRatio.height;
-
-    if (cropBoxIsPortrait) {
-        CGFloat newWidth = floorf(cropBoxFrame.size.height * (aspectRatio.width / aspectRatio.height));
-        CGFloat delta = cropBoxFrame.size.width - newWidth;
-        cropBoxFrame.size.width = newWidth;
-        offset.x += (delta * 0.5f);
-
-        if (delta < FLT_EPSILON) {
-            cropBoxFrame.origin.x = self.contentBounds.origin.x;  // set to 0 to avoid accidental clamping by the crop frame sanitizer
-        }
-
-        // If the aspect ratio causes the new width to extend
-        // beyond the content width, we'll need to zoom the image out
-        CGFloat boundsWidth = CGRectGetWidth(boundsFrame);
-        if (newWidth > boundsWidth) {
-            CGFloat scale = boundsWidth / newWidth;
-
-            // Scale the new height
-            CGFloat newHeight = cropBoxFrame.size.height * scale;
-            delta = cropBoxFrame.size.height - newHeight;
-            cropBoxFrame.size.height = newHeight;
-
-            // Offset the Y position so it stays in the middle
-            offset.y += (delta * 0.5f);
-
-            // Clamp the width to the bounds width
-            cropBoxFrame.size.width = boundsWidth;
-            zoomOut = YES;
-        }
-    } else {
-        CGFloat newHeight = floorf(cropBoxFrame.size.width * (aspectRatio.height / aspectRatio.width));
-        CGFloat delta = cropBoxFrame.size.height - newHeight;
-        cropBoxFrame.size.height = newHeight;
-        offset.y += (delta * 0.5f);
-
-        if (delta < FLT_EPSILON) {
-            cropBoxFrame.origin.y = self.contentBounds.origin.y;
-        }
-
-        // If the aspect ratio causes the new height to extend
-        // beyond the content width, we'll need to zoom the image out
-        CGFloat boundsHeight = CGRectGetHeight(boundsFrame);
-        if (newHeight > boundsHeight) {
-            CGFloat scale = boundsHeight / newHeight;
-
-            // Scale the new width
-            CGFloat newWidth = cropBoxFrame.size.width * scale;
-            delta = cropBoxFrame.size.width - newWidth;
-            cropBoxFrame.size.width = newWidth;
-
-            // Offset the Y position so it stays in the middle
-            offset.x += (delta * 0.5f);
-
-            // Clamp the width to the bounds height
-            cropBoxFrame.size.height = boundsHeight;
-            zoomOut = YES;
-        }
-    }
+    // Reshape the crop box, keeping it centered over the same part of the image
+    const TOCropLayout layout = self.geometryLayout;
+    bool zoomOut = false;
+    const TOCropLayoutUpdate update = TOCropGeometryLayoutForAspectRatio(&layout, TOCropSizeFromCGSize(aspectRatio),
+                                                                         self.image.size.width > self.image.size.height,
+                                                                         &zoomOut);
+    const CGRect cropBoxFrame = CGRectFromTOCropRect(update.cropBoxFrame);
+    const CGPoint offset = CGPointFromTOCropPoint(update.contentOffset);
 
     self.cropBoxLastEditedSize = cropBoxFrame.size;
     self.cropBoxLastEditedAngle = self.angle;
 
     void (^translateBlock)(void) = ^{
+        [self beginLayoutTransaction];
         self.scrollView.contentOffset = offset;
         self.cropBoxFrame = cropBoxFrame;
 
@@ -1497,6 +1394,8 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         }
 
         [self moveCroppedContentToCenterAnimated:NO];
+        [self commitLayoutTransaction];
+
         [self checkForCanReset];
     };
 
@@ -1538,6 +1437,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         [self captureStateForImageRotation];
     }
 
+    [self recordTraceEvent:(clockwise ? TOCropTraceEventRotateClockwise : TOCropTraceEventRotateCounterclockwise)
+                     point:CGPointZero
+                     value:0.0f];
+
     // Work out the new angle, and wrap around once we exceed 360s
     NSInteger newAngle = self.angle;
     newAngle = clockwise ? newAngle + 90 : newAngle - 90;
@@ -1545,6 +1448,11 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
         newAngle = 0;
     }
 
+    // Turn the quadrilateral along with the image, so it stays over the same part of it
+    if (self.perspectiveCorrectionEnabled) {
+        _cropQuadrilateral = [self cropQuadrilateral:_cropQuadrilateral rotatedClockwise:clockwise];
+    }
+
     _angle = newAngle;
 
     // Convert the new angle to radians
@@ -1585,6 +1493,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     CGPoint cropTargetPoint = (CGPoint){cropMidPoint.x + self.scrollView.contentOffset.x, cropMidPoint.y + self.scrollView.contentOffset.y};
 
     // Work out the dimensions of the crop box when rotated
+    [self beginLayoutTransaction];
     const CGFloat oldZoomScale = self.scrollView.zoomScale;
     CGRect newCropFrame = CGRectZero;
     if (labs(self.angle) == labs(self.cropBoxLastEditedAngle) || (labs(self.angle) * -1) == ((labs(self.cropBoxLastEditedAngle) - 180) % 360)) {
@@ -1610,9 +1519,19 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
 
     // If we're animated, generate a snapshot view that we'll animate in place of the real view
     UIView *snapshotView = nil;
+    TOCropMemoryAllocation *snapshotMemoryAllocation = nil;
     if (animated) {
         snapshotView = [self.foregroundContainerView snapshotViewAfterScreenUpdates:NO];
         self.rotateAnimationInProgress = YES;
+
+        // The snapshot is rendered at the screen's scale, with 4 bytes per pixel
+        const CGFloat screenScale = MAX(1.0f, self.traitCollection.displayScale);
+        const CGSize snapshotSize = snapshotView.bounds.size;
+        const NSUInteger snapshotByteCount = (NSUInteger)(snapshotSize.width * screenScale) * (NSUInteger)(snapshotSize.height * screenScale) * 4;
+        snapshotMemoryAllocation = [TOCropMemoryAccountant.sharedAccountant addAllocationWithName:@"Crop view rotation snapshot"
+                                                                                        byteCount:snapshotByteCount
+                                                                                         priority:TOCropMemoryPriorityRequired
+                                                                                  evictionHandler:nil];
     }
 
     // Rotate the background image view, inside its container view
@@ -1627,8 +1546,11 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.foregroundContainerView.transform = CGAffineTransformIdentity;
     self.foregroundImageView.transform = rotation;
 
-    // Flip the content size of the scroll view to match the rotated bounds
-    self.scrollView.contentSize = self.backgroundContainerView.frame.size;
+    // Flip the content size of the scroll view to match the rotated bounds. The container's frame
+    // still reflects the zoom scale from before the transaction, so scale its bounds by the new one
+    const CGSize rotatedSize = self.backgroundContainerView.bounds.size;
+    const CGFloat zoomScale = self.scrollView.zoomScale;
+    self.scrollView.contentSize = (CGSize){rotatedSize.width * zoomScale, rotatedSize.height * zoomScale};
 
     // assign the new crop box frame and re-adjust the content to fill it
     self.cropBoxFrame = newCropFrame;
@@ -1663,12 +1585,10 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     offset.x = MIN(self.scrollView.contentSize.width - CGRectGetMaxX(newCropFrame), offset.x);
     offset.y = MIN(self.scrollView.contentSize.height - CGRectGetMaxY(newCropFrame), offset.y);
 
-    // if the scroll view's new scale is 1 and the new offset is equal to the old, will not trigger the delegate 'scrollViewDidScroll:'
-    // so we should call the method manually to update the foregroundImageView's frame
-    if (offset.x == self.scrollView.contentOffset.x && offset.y == self.scrollView.contentOffset.y && fabs(appliedScale - 1.0) < FLT_EPSILON) {
-        [self matchForegroundToBackground];
-    }
+    // Matched explicitly, since an unchanged offset and scale won't trigger `scrollViewDidScroll:`
     self.scrollView.contentOffset = offset;
+    [self matchForegroundToBackground];
+    [self commitLayoutTransaction];
 
     // If we're animated, play an animation of the snapshot view rotating,
     // then fade it out over the live content
@@ -1711,6 +1631,7 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
                     completion:^(BOOL complete) {
                         self.rotateAnimationInProgress = NO;
                         [snapshotView removeFromSuperview];
+                        [snapshotMemoryAllocation remove];
 
                         // If the aspect ratio lock is not enabled, allow a swap
                         // If the aspect ratio lock is on, allow a aspect ratio swap
@@ -1739,6 +1660,309 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     }
 }
 
+#pragma mark - Perspective Correction -
+
+- (void)setPerspectiveCorrectionEnabled:(BOOL)perspectiveCorrectionEnabled {
+    // Circular crops are always cut out of the crop box
+    const BOOL enabled = perspectiveCorrectionEnabled && self.croppingStyle != TOCropViewCroppingStyleCircular;
+    if (enabled == _perspectiveCorrectionEnabled) {
+        return;
+    }
+
+    _perspectiveCorrectionEnabled = enabled;
+
+    // Before the initial layout, the quadrilateral is placed as part of it
+    if (!self.initialSetupPerformed) {
+        return;
+    }
+
+    // Start out flattening exactly what's already being cropped
+    [self resetCropQuadrilateral];
+    [self updateQuadrilateralView];
+    [self checkForCanReset];
+}
+
+- (TOCropQuadrilateral)cropQuadrilateral {
+    if (self.applyInitialCropQuadrilateral) {
+        return self.restoreCropQuadrilateral;
+    }
+    return _cropQuadrilateral;
+}
+
+- (void)setCropQuadrilateral:(TOCropQuadrilateral)cropQuadrilateral {
+    if (!self.initialSetupPerformed) {
+        self.restoreCropQuadrilateral = cropQuadrilateral;
+        self.applyInitialCropQuadrilateral = YES;
+        return;
+    }
+
+    if (![self applyCropQuadrilateral:cropQuadrilateral]) {
+        return;
+    }
+
+    [self updateQuadrilateralView];
+    [self checkForCanReset];
+}
+
+// Keeps the corners inside the image, and turns away shapes that couldn't be flattened
+- (BOOL)applyCropQuadrilateral:(TOCropQuadrilateral)cropQuadrilateral {
+    const CGSize imageSize = self.imageSize;
+    CGPoint corners[4] = {cropQuadrilateral.topLeft, cropQuadrilateral.topRight,
+                          cropQuadrilateral.bottomRight, cropQuadrilateral.bottomLeft};
+    for (NSInteger i = 0; i < 4; i++) {
+        corners[i].x = MIN(MAX(corners[i].x, 0.0f), imageSize.width);
+        corners[i].y = MIN(MAX(corners[i].y, 0.0f), imageSize.height);
+    }
+
+    const TOCropQuadrilateral clampedQuadrilateral = (TOCropQuadrilateral){corners[0], corners[1], corners[2], corners[3]};
+    if (!TOCropGeometryQuadIsConvex(TOCropQuadFromQuadrilateral(clampedQuadrilateral))) {
+        return NO;
+    }
+
+    _cropQuadrilateral = clampedQuadrilateral;
+    return YES;
+}
+
+// Puts the corners back on the corners of the crop
+- (void)resetCropQuadrilateral {
+    if (!self.perspectiveCorrectionEnabled) {
+        return;
+    }
+
+    _cropQuadrilateral = TOCropQuadrilateralMakeWithRect(self.imageCropFrame);
+    [self updateQuadrilateralView];
+}
+
+- (BOOL)cropQuadrilateralHasBeenMoved {
+    const TOCropQuadrilateral cropFrameQuadrilateral = TOCropQuadrilateralMakeWithRect(self.imageCropFrame);
+    const CGPoint corners[] = {_cropQuadrilateral.topLeft, _cropQuadrilateral.topRight,
+                               _cropQuadrilateral.bottomRight, _cropQuadrilateral.bottomLeft};
+    const CGPoint cropFrameCorners[] = {cropFrameQuadrilateral.topLeft, cropFrameQuadrilateral.topRight,
+                                        cropFrameQuadrilateral.bottomRight, cropFrameQuadrilateral.bottomLeft};
+    for (NSInteger i = 0; i < 4; i++) {
+        if (fabs(corners[i].x - cropFrameCorners[i].x) > 1.0f || fabs(corners[i].y - cropFrameCorners[i].y) > 1.0f) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (CGPoint)cropQuadrilateralPointForCorner:(TOCropEdge)corner {
+    switch (corner) {
+    case TOCropEdgeTopLeft:
+        return _cropQuadrilateral.topLeft;
+    case TOCropEdgeTopRight:
+        return _cropQuadrilateral.topRight;
+    case TOCropEdgeBottomRight:
+        return _cropQuadrilateral.bottomRight;
+    case TOCropEdgeBottomLeft:
+        return _cropQuadrilateral.bottomLeft;
+    default:
+        return CGPointZero;
+    }
+}
+
+// The quadrilateral's corners are in the image's coordinate space, which the scroll view's content is a scaled copy of
+- (CGPoint)viewPointForImagePoint:(CGPoint)point {
+    const CGSize imageSize = self.imageSize;
+    const CGSize contentSize = self.scrollView.contentSize;
+    const CGPoint contentPoint = (CGPoint){point.x * (contentSize.width / imageSize.width),
+                                           point.y * (contentSize.height / imageSize.height)};
+    return [self.scrollView convertPoint:contentPoint toView:self];
+}
+
+- (CGPoint)imagePointForViewPoint:(CGPoint)point {
+    const CGSize imageSize = self.imageSize;
+    const CGSize contentSize = self.scrollView.contentSize;
+    const CGPoint contentPoint = [self convertPoint:point toView:self.scrollView];
+    return (CGPoint){contentPoint.x * (imageSize.width / contentSize.width),
+                     contentPoint.y * (imageSize.height / contentSize.height)};
+}
+
+- (TOCropEdge)quadrilateralCornerForPoint:(CGPoint)point {
+    if (!self.perspectiveCorrectionEnabled || self.scrollView.contentSize.width < FLT_EPSILON) {
+        return TOCropEdgeNone;
+    }
+
+    const TOCropQuadrilateral viewQuadrilateral = (TOCropQuadrilateral){
+        [self viewPointForImagePoint:_cropQuadrilateral.topLeft], [self viewPointForImagePoint:_cropQuadrilateral.topRight],
+        [self viewPointForImagePoint:_cropQuadrilateral.bottomRight], [self viewPointForImagePoint:_cropQuadrilateral.bottomLeft]};
+    return TOCropGeometryQuadCornerForPoint(TOCropQuadFromQuadrilateral(viewQuadrilateral), TOCropPointFromCGPoint(point),
+                                            kTOCropQuadrilateralCornerRadius);
+}
+
+- (void)moveCropQuadrilateralCornerWithGesturePoint:(CGPoint)point {
+    // Move the corner as far through the image as the touch has moved, so it doesn't jump to be under the finger
+    const CGPoint imagePoint = [self imagePointForViewPoint:point];
+    const CGPoint imageOriginPoint = [self imagePointForViewPoint:self.panOriginPoint];
+    const CGPoint cornerPoint = (CGPoint){self.quadrilateralCornerOriginPoint.x + (imagePoint.x - imageOriginPoint.x),
+                                          self.quadrilateralCornerOriginPoint.y + (imagePoint.y - imageOriginPoint.y)};
+
+    const TOCropRect imageBounds = (TOCropRect){{0.0f, 0.0f}, TOCropSizeFromCGSize(self.imageSize)};
+    const TOCropQuad quad = TOCropGeometryMoveQuadCorner(TOCropQuadFromQuadrilateral(_cropQuadrilateral), self.tappedQuadrilateralCorner,
+                                                         TOCropPointFromCGPoint(cornerPoint), imageBounds);
+    _cropQuadrilateral = TOCropQuadrilateralFromQuad(quad);
+
+    [self updateQuadrilateralView];
+    [self checkForCanReset];
+}
+
+// The quadrilateral over the image once it has been turned another 90 degrees
+- (TOCropQuadrilateral)cropQuadrilateral:(TOCropQuadrilateral)quadrilateral rotatedClockwise:(BOOL)clockwise {
+    const CGSize imageSize = self.imageSize;
+    const CGPoint topLeft = quadrilateral.topLeft, topRight = quadrilateral.topRight;
+    const CGPoint bottomRight = quadrilateral.bottomRight, bottomLeft = quadrilateral.bottomLeft;
+
+    // Each point (x, y) lands on (height - y, x), and each corner takes the place of the one after it
+    if (clockwise) {
+        return (TOCropQuadrilateral){{imageSize.height - bottomLeft.y, bottomLeft.x}, {imageSize.height - topLeft.y, topLeft.x},
+                                     {imageSize.height - topRight.y, topRight.x}, {imageSize.height - bottomRight.y, bottomRight.x}};
+    }
+
+    // Each point (x, y) lands on (y, width - x), and each corner takes the place of the one before it
+    return (TOCropQuadrilateral){{topRight.y, imageSize.width - topRight.x}, {bottomRight.y, imageSize.width - bottomRight.x},
+                                 {bottomLeft.y, imageSize.width - bottomLeft.x}, {topLeft.y, imageSize.width - topLeft.x}};
+}
+
+- (void)updateQuadrilateralView {
+    self.quadrilateralView.hidden = !self.perspectiveCorrectionEnabled;
+    if (!self.perspectiveCorrectionEnabled || self.scrollView.contentSize.width < FLT_EPSILON) {
+        return;
+    }
+
+    const CGPoint corners[] = {[self viewPointForImagePoint:_cropQuadrilateral.topLeft],
+                               [self viewPointForImagePoint:_cropQuadrilateral.topRight],
+                               [self viewPointForImagePoint:_cropQuadrilateral.bottomRight],
+                               [self viewPointForImagePoint:_cropQuadrilateral.bottomLeft]};
+
+    UIBezierPath *path = [UIBezierPath bezierPath];
+    [path moveToPoint:corners[0]];
+    for (NSInteger i = 1; i < 4; i++) {
+        [path addLineToPoint:corners[i]];
+    }
+    [path closePath];
+
+    // With a handle on each corner to show it can be dragged
+    for (NSInteger i = 0; i < 4; i++) {
+        [path appendPath:[UIBezierPath bezierPathWithArcCenter:corners[i] radius:kTOCropQuadrilateralHandleRadius
+                                                    startAngle:0.0f endAngle:(M_PI * 2.0f) clockwise:YES]];
+    }
+
+    // The outline follows every scroll and zoom, so it mustn't trail behind them by animating
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.quadrilateralLayer.path = path.CGPath;
+    [CATransaction commit];
+}
+
+#pragma mark - Straightening -
+
+- (void)setStraighteningAngle:(CGFloat)straighteningAngle {
+    const CGFloat angle = TOCropGeometryClampStraighteningAngle(straighteningAngle);
+    if (angle == _straighteningAngle) {
+        return;
+    }
+    _straighteningAngle = angle;
+
+    // The initial layout would not have been performed yet, so it'll be applied once it has
+    if (!self.initialSetupPerformed) {
+        return;
+    }
+
+    // Only the views' transforms and the scroll view change, so this is cheap enough
+    // to call on every frame while the user drags a slider
+    [self applyStraighteningTransform];
+    [self updateImageCropFrameForStraighteningAngle];
+    [self checkForCanReset];
+}
+
+- (void)applyStraighteningTransform {
+    // The image views are turned about their centers, inside views that are laid out as if they weren't,
+    // so the scroll view and crop box carry on working in the straightened image's coordinate space.
+    // The background container's own transform belongs to the scroll view's zooming.
+    const CGAffineTransform rotation = CGAffineTransformMakeRotation(self.straighteningAngle * (M_PI / 180.0f));
+    self.backgroundContainerView.layer.sublayerTransform = CATransform3DMakeAffineTransform(rotation);
+    self.foregroundStraighteningView.transform = rotation;
+}
+
+// The crop frame moved as little as possible to be covered by the straightened image. It's kept
+// a point inside the image's edges, since the crop frame is rounded out to whole points.
+- (CGRect)imageCropFrameFittingStraightenedImage:(CGRect)imageCropFrame {
+    const CGSize imageSize = self.imageSize;
+    const TOCropSize insetImageSize = {imageSize.width - 2.0f, imageSize.height - 2.0f};
+    const CGRect insetFrame = CGRectOffset(imageCropFrame, -1.0f, -1.0f);
+    const TOCropRect fittedFrame = TOCropGeometryFitRectInStraightenedImage(insetImageSize, self.straighteningAngle,
+                                                                            TOCropRectFromCGRect(insetFrame));
+    return CGRectOffset(CGRectFromTOCropRect(fittedFrame), 1.0f, 1.0f);
+}
+
+- (void)updateImageCropFrameForStraighteningAngle {
+    // Straightening one way and then back should give back the crop from before, so every angle is fitted
+    // from the last crop the user chose themselves, rather than from the one fitted to the previous angle
+    const CGRect imageCropFrame = self.imageCropFrame;
+    if (CGRectIsEmpty(self.straighteningFittedImageCropFrame) ||
+        !CGRectEqualToRect(CGRectIntegral(imageCropFrame), CGRectIntegral(self.straighteningFittedImageCropFrame))) {
+        self.straighteningSourceImageCropFrame = imageCropFrame;
+    }
+
+    // When the whole image is being cropped with no particular shape, keep as much of it as possible.
+    // Otherwise, keep the shape of the crop.
+    const CGRect sourceFrame = self.straighteningSourceImageCropFrame;
+    const CGSize imageSize = self.imageSize;
+    const BOOL cropsWholeImage = (CGRectGetWidth(sourceFrame) >= imageSize.width - 1.0f &&
+                                  CGRectGetHeight(sourceFrame) >= imageSize.height - 1.0f);
+    CGRect fittedFrame = sourceFrame;
+    if (self.straighteningAngle != 0.0f && cropsWholeImage && !self.aspectRatioLockEnabled && !self.hasAspectRatio) {
+        const TOCropSize insetImageSize = {imageSize.width - 2.0f, imageSize.height - 2.0f};
+        const TOCropRect largestFrame = TOCropGeometryLargestStraightenedRect(insetImageSize, self.straighteningAngle);
+        fittedFrame = CGRectOffset(CGRectFromTOCropRect(largestFrame), 1.0f, 1.0f);
+    } else if (self.straighteningAngle != 0.0f) {
+        fittedFrame = [self imageCropFrameFittingStraightenedImage:sourceFrame];
+    }
+
+    if (!CGRectEqualToRect(CGRectIntegral(fittedFrame), CGRectIntegral(imageCropFrame))) {
+        [self updateToImageCropFrame:fittedFrame];
+    }
+    self.straighteningFittedImageCropFrame = self.imageCropFrame;
+}
+
+// Once the user stops adjusting a straightened image, pulls the crop back inside the image if it was
+// scrolled, zoomed or resized past its edges. Returns NO if it was already inside.
+- (BOOL)moveCroppedContentInsideStraightenedImageAnimated:(BOOL)animated {
+    if (self.straighteningAngle == 0.0f || self.internalLayoutDisabled) {
+        return NO;
+    }
+
+    const CGRect imageCropFrame = self.imageCropFrame;
+    const CGRect fittedFrame = [self imageCropFrameFittingStraightenedImage:imageCropFrame];
+    if (CGRectEqualToRect(fittedFrame, imageCropFrame)) {
+        return NO;
+    }
+
+    // This is the user's own crop now, so straightening further starts from it
+    __weak typeof(self) weakSelf = self;
+    void (^fitBlock)(void) = ^{
+        typeof(self) strongSelf = weakSelf;
+        [strongSelf updateToImageCropFrame:fittedFrame];
+        strongSelf.straighteningSourceImageCropFrame = fittedFrame;
+        strongSelf.straighteningFittedImageCropFrame = strongSelf.imageCropFrame;
+    };
+
+    if (!animated) {
+        fitBlock();
+        return YES;
+    }
+
+    [UIView animateWithDuration:0.5f
+                          delay:0.0f
+         usingSpringWithDamping:1.0f
+          initialSpringVelocity:1.0f
+                        options:UIViewAnimationOptionBeginFromCurrentState
+                     animations:fitBlock
+                     completion:nil];
+    return YES;
+}
+
 - (void)captureStateForImageRotation {
     self.cropBoxLastEditedSize = self.cropBoxFrame.size;
     self.cropBoxLastEditedZoomScale = self.scrollView.zoomScale;
@@ -1752,11 +1976,55 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     self.scrollView.maximumZoomScale = MAX(self.scrollView.minimumZoomScale, self.baseMaximumZoomScale);
 }
 
+#pragma mark - Interaction Traces -
+
+- (void)startRecordingInteractionTrace {
+    // Record the layout as it is now, so the trace can be replayed from it
+    TOCropTraceHeader header;
+    header.layout = self.geometryLayout;
+    header.baseMaximumZoomScale = self.baseMaximumZoomScale;
+    header.padding = self.cropViewPadding;
+    header.minimumAspectRatio = self.minimumAspectRatio;
+    header.aspectRatioLocked = self.aspectRatioLockEnabled;
+    header.imageIsLandscape = self.image.size.width > self.image.size.height;
+
+    TOCropTraceWriterDestroy(self.traceWriter);
+    self.traceWriter = TOCropTraceWriterCreate(&header);
+    self.traceStartTime = CACurrentMediaTime();
+}
+
+- (NSData *)stopRecordingInteractionTrace {
+    if (self.traceWriter == NULL) {
+        return nil;
+    }
+
+    size_t length = 0;
+    const uint8_t *bytes = TOCropTraceWriterBytes(self.traceWriter, &length);
+    NSData *trace = [NSData dataWithBytes:bytes length:length];
+
+    TOCropTraceWriterDestroy(self.traceWriter);
+    self.traceWriter = NULL;
+    return trace;
+}
+
+- (void)recordTraceEvent:(TOCropTraceEventType)type point:(CGPoint)point value:(CGFloat)value {
+    if (self.traceWriter == NULL) {
+        return;
+    }
+
+    TOCropTraceEvent event;
+    event.type = type;
+    event.time = CACurrentMediaTime() - self.traceStartTime;
+    event.point = TOCropPointFromCGPoint(point);
+    event.value = value;
+    TOCropTraceWriterAppend(self.traceWriter, &event);
+}
+
 #pragma mark - Resettable State -
 - (void)checkForCanReset {
     BOOL canReset = NO;
 
-    if (self.angle != 0) {  // Image has been rotated
+    if (self.angle != 0 || self.straighteningAngle != 0.0f) {  // Image has been rotated
         canReset = YES;
     } else if (self.scrollView.zoomScale > self.scrollView.minimumZoomScale + FLT_EPSILON) {  // image has been zoomed in
         canReset = YES;
@@ -1766,12 +2034,32 @@ typedef NS_ENUM(NSInteger, TOCropViewOverlayEdge) {
     } else if ((NSInteger)floorf(self.scrollView.contentOffset.x) != (NSInteger)floorf(self.originalContentOffset.x) ||
                (NSInteger)floorf(self.scrollView.contentOffset.y) != (NSInteger)floorf(self.originalContentOffset.y)) {
         canReset = YES;
+    } else if (self.perspectiveCorrectionEnabled && [self cropQuadrilateralHasBeenMoved]) {  // A corner has been dragged
+        canReset = YES;
     }
 
     self.canBeReset = canReset;
 }
 
 #pragma mark - Convienience Methods -
+- (TOCropLayout)geometryLayout {
+    TOCropLayout layout;
+    layout.bounds = TOCropRectFromCGRect(self.bounds);
+    layout.contentBounds = TOCropRectFromCGRect(self.contentBounds);
+    layout.imageSize = TOCropSizeFromCGSize(self.imageSize);
+    layout.cropBoxFrame = TOCropRectFromCGRect(self.cropBoxFrame);
+    layout.contentOffset = TOCropPointFromCGPoint(self.scrollView.contentOffset);
+    layout.contentSize = TOCropSizeFromCGSize(self.scrollView.contentSize);
+
+    const UIEdgeInsets insets = self.scrollView.contentInset;
+    layout.contentInset = (TOCropInsets){insets.top, insets.left, insets.bottom, insets.right};
+
+    layout.zoomScale = self.scrollView.zoomScale;
+    layout.minimumZoomScale = self.scrollView.minimumZoomScale;
+    layout.maximumZoomScale = self.scrollView.maximumZoomScale;
+    return layout;
+}
+
 - (CGRect)contentBounds {
     CGRect contentRect = CGRectZero;
     contentRect.origin.x = self.cropViewPadding + self.cropRegionInsets.left;
@@ -0,0 +1 @@
+../Geometry/TOCropAspectRatioIndex.h
\ No newline at end of file
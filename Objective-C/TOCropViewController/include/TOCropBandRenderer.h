@@ -0,0 +1 @@
+../Rendering/TOCropBandRenderer.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Models/TOCropBatchProcessor.h
\ No newline at end of file
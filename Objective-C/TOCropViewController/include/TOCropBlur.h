@@ -0,0 +1 @@
+../Rendering/TOCropBlur.h
\ No newline at end of file
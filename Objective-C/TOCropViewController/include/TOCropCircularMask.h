@@ -0,0 +1 @@
+../Rendering/TOCropCircularMask.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Geometry/TOCropGeometry.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropJPEGTransform.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Models/TOCropMemoryAccountant.h
\ No newline at end of file
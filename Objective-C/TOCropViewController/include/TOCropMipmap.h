@@ -0,0 +1 @@
+../Rendering/TOCropMipmap.h
\ No newline at end of file
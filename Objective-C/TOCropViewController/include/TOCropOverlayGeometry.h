@@ -0,0 +1 @@
+../Geometry/TOCropOverlayGeometry.h
\ No newline at end of file
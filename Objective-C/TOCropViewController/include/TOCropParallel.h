@@ -0,0 +1 @@
+../Rendering/TOCropParallel.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropPerspective.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropPixelBuffer.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropPixelConvert.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropPixelOrientation.h
\ No newline at end of file
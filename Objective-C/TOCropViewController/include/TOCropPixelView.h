@@ -0,0 +1 @@
+../Rendering/TOCropPixelView.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Models/TOCropRenderCache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Models/TOCropRenderJob.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropResample.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropRotation.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropStraighten.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropTileCache.h
\ No newline at end of file
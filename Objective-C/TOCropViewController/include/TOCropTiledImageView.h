@@ -0,0 +1 @@
+../Views/TOCropTiledImageView.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Rendering/TOCropTiledRenderer.h
\ No newline at end of file
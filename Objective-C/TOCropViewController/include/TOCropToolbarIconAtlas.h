@@ -0,0 +1 @@
+../Rendering/TOCropToolbarIconAtlas.h
\ No newline at end of file
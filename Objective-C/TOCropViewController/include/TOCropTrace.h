@@ -0,0 +1 @@
+../Geometry/TOCropTrace.h
\ No newline at end of file
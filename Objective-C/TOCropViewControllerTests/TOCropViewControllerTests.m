@@ -10,7 +10,32 @@
 #import <UIKit/UIKit.h>
 #import <XCTest/XCTest.h>
 
+#import "TOCropAspectRatioIndex.h"
+#import "TOCropBandRenderer.h"
+#import "TOCropBatchProcessor.h"
+#import "TOCropBlur.h"
+#import "TOCropCircularMask.h"
+#import "TOCropGeometry.h"
+#import "TOCropJPEGTransform.h"
+#import "TOCropMemoryAccountant.h"
+#import "TOCropMipmap.h"
+#import "TOCropOverlayGeometry.h"
+#import "TOCropPixelConvert.h"
+#import "TOCropParallel.h"
+#import "TOCropPerspective.h"
+#import "TOCropPixelOrientation.h"
+#import "TOCropPixelView.h"
+#import "TOCropRenderCache.h"
+#import "TOCropRenderJob.h"
+#import "TOCropResample.h"
+#import "TOCropRotation.h"
 #import "TOCropScrollView.h"
+#import "TOCropStraighten.h"
+#import "TOCropTileCache.h"
+#import "TOCropTiledImageView.h"
+#import "TOCropTiledRenderer.h"
+#import "TOCropToolbarIconAtlas.h"
+#import "TOCropTrace.h"
 #import "TOCropViewController.h"
 #import "UIImage+CropRotate.h"
 
@@ -21,6 +46,11 @@
 @property (nonatomic, assign) BOOL rotateAnimationInProgress;
 @property (nonatomic, strong, readonly) TOCropScrollView *scrollView;
 @property (nonatomic, strong, readonly) NSTimer *resetTimer;
+@property (nonatomic, assign, readonly) NSUInteger layoutCommitWriteCount;
+@end
+
+@interface TOCropToolbar (UnitTests)
++ (UIImage *)iconImage:(TOCropToolbarIcon)icon;
 @end
 
 // UIScrollView won't report itself as dragging without a real touch sequence, so
@@ -43,6 +73,17 @@ static void TOCropRunWhileScrollViewIsDragging(void (^block)(void)) {
     method_exchangeImplementations(real, stub);
 }
 
+// Zooms a scroll view onto a single view of a fixed size
+@interface TOCropTestZoomingDelegate : NSObject <UIScrollViewDelegate>
+@property (nonatomic, strong) UIView *zoomingView;
+@end
+
+@implementation TOCropTestZoomingDelegate
+- (UIView *)viewForZoomingInScrollView:(UIScrollView *)scrollView {
+    return self.zoomingView;
+}
+@end
+
 @interface TOCropViewControllerTests : XCTestCase
 
 @end
@@ -59,6 +100,18 @@ static void TOCropRunWhileScrollViewIsDragging(void (^block)(void)) {
     }];
 }
 
+- (UIColor *)averageColorOfImage:(UIImage *)image {
+    // Let Core Graphics average the image down into a single pixel
+    uint8_t pixel[4] = {0};
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixel, 1, 1, 8, 4, colorSpace, kCGImageAlphaPremultipliedLast);
+    CGContextSetInterpolationQuality(context, kCGInterpolationMedium);
+    CGContextDrawImage(context, (CGRect){0, 0, 1, 1}, image.CGImage);
+    CGContextRelease(context);
+    CGColorSpaceRelease(colorSpace);
+    return [UIColor colorWithRed:pixel[0] / 255.0f green:pixel[1] / 255.0f blue:pixel[2] / 255.0f alpha:pixel[3] / 255.0f];
+}
+
 - (TOCropView *)cropViewWithImageSize:(CGSize)imageSize {
     TOCropView *cropView = [[TOCropView alloc] initWithImage:[self testImageWithSize:imageSize]];
     cropView.frame = (CGRect){0, 0, 320, 480};
@@ -66,6 +119,147 @@ static void TOCropRunWhileScrollViewIsDragging(void (^block)(void)) {
     return cropView;
 }
 
+// Fills a buffer so that every pixel holds its own index in reading order
+static void TOCropFillPixelBufferWithIndices(TOCropPixelBuffer *buffer) {
+    for (size_t y = 0; y < buffer->height; y++) {
+        uint32_t *row = (uint32_t *)(buffer->data + (y * buffer->bytesPerRow));
+        for (size_t x = 0; x < buffer->width; x++) {
+            row[x] = (uint32_t)((y * buffer->width) + x);
+        }
+    }
+}
+
+static uint32_t TOCropPixelAt(const TOCropPixelBuffer *buffer, size_t x, size_t y) {
+    return ((const uint32_t *)(buffer->data + (y * buffer->bytesPerRow)))[x];
+}
+
+// A synthetic band source where each pixel holds its own index in the full image
+static bool TOCropReadIndexRegion(void *context, TOCropPixelRect region, TOCropPixelBuffer *buffer) {
+    const size_t imageWidth = *(const size_t *)context;
+    for (size_t y = 0; y < region.height; y++) {
+        uint32_t *row = (uint32_t *)(buffer->data + (y * buffer->bytesPerRow));
+        for (size_t x = 0; x < region.width; x++) {
+            row[x] = (uint32_t)(((region.y + y) * imageWidth) + region.x + x);
+        }
+    }
+    return true;
+}
+
+// Collects every band into a single buffer, counting the bands along the way
+typedef struct {
+    TOCropPixelBuffer *output;
+    size_t bandCount;
+} TOCropBandCollector;
+
+static bool TOCropCollectBand(void *context, size_t firstRow, const TOCropPixelBuffer *rows) {
+    TOCropBandCollector *collector = context;
+    for (size_t y = 0; y < rows->height; y++) {
+        memcpy(collector->output->data + ((firstRow + y) * collector->output->bytesPerRow),
+               rows->data + (y * rows->bytesPerRow), rows->width * TOCropPixelBufferBytesPerPixel);
+    }
+    collector->bandCount++;
+    return true;
+}
+
+// A 40x24 baseline JPEG with 4:2:0 chroma and an EXIF orientation of 6 (turned clockwise to
+// display), written by hand so its bytes never change. Every 8x8 block is a flat level with
+// a couple of low frequencies on top, so any rotated block would show up with flipped signs.
+static const uint8_t kTOCropGoldenJPEG[] = {
+    0xff, 0xd8, 0xff, 0xe1, 0x00, 0x22, 0x45, 0x78, 0x69, 0x66, 0x00, 0x00, 0x49, 0x49, 0x2a, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x12, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x06, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0xff, 0xc0, 0x00, 0x11, 0x08,
+    0x00, 0x18, 0x00, 0x28, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00, 0xff, 0xc4,
+    0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff,
+    0xc4, 0x00, 0x16, 0x10, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x00,
+    0x03, 0x00, 0x00, 0x3f, 0x00, 0xe5, 0xe9, 0x12, 0x52, 0x35, 0x29, 0x12, 0x52, 0x2a, 0x91, 0x19,
+    0x74, 0x89, 0x29, 0x1a, 0x94, 0x89, 0x29, 0x16, 0x80, 0xcb, 0xa4, 0x49, 0x48, 0xd4, 0xa4, 0x49,
+    0x48, 0xb4, 0x04, 0x94, 0x89, 0x29, 0x1a, 0x94, 0x89, 0x29, 0x19, 0x65, 0xa3, 0x2e, 0x91, 0x25,
+    0x23, 0x52, 0x91, 0x25, 0x22, 0xd0, 0x19, 0x74, 0x89, 0x29, 0x1a, 0x94, 0x89, 0x29, 0x16, 0x80,
+    0xff, 0xd9
+};
+
+// The golden JPEG above cropped to (8, 8, 24, 16) and turned by a further 90°, which with its
+// EXIF orientation is a half turn. Checked coefficient by coefficient against the source.
+static const uint8_t kTOCropGoldenJPEGCroppedAt90Degrees[] = {
+    0xff, 0xd8, 0xff, 0xe1, 0x00, 0x22, 0x45, 0x78, 0x69, 0x66, 0x00, 0x00, 0x49, 0x49, 0x2a, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x12, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0xff, 0xc0, 0x00, 0x11, 0x08,
+    0x00, 0x10, 0x00, 0x20, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00, 0xff, 0xc4,
+    0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff,
+    0xc4, 0x00, 0xb5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04,
+    0x00, 0x00, 0x01, 0x7d, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06,
+    0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1,
+    0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a,
+    0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45,
+    0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65,
+    0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85,
+    0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3,
+    0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+    0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8,
+    0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4,
+    0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xc4, 0x00, 0x1f, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04,
+    0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x11, 0x00, 0x02, 0x01, 0x02,
+    0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03,
+    0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81,
+    0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1,
+    0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54,
+    0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74,
+    0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92,
+    0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9,
+    0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4, 0xe5,
+    0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xda,
+    0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0x8d, 0x4d, 0x46, 0xa6,
+    0xb2, 0xd4, 0xd4, 0x6a, 0x68, 0x32, 0x35, 0x14, 0xd4, 0x6a, 0x6b, 0x2d, 0x4d, 0x46, 0xa6, 0xb9,
+    0x40, 0xff, 0xd9
+};
+
+// Swaps the first Huffman table in a JPEG for a DC table with the given code counts, holding
+// `valueCount` values (which may be fewer than the counts add up to)
+static NSData *TOCropJPEGWithDCTable(NSData *jpeg, const uint8_t bits[16], size_t valueCount) {
+    const uint8_t *bytes = jpeg.bytes;
+    size_t offset = 2;
+    while (offset + 4 <= jpeg.length && bytes[offset + 1] != 0xc4) {
+        offset += 2 + (((size_t)bytes[offset + 2] << 8) | bytes[offset + 3]);
+    }
+    const size_t segmentEnd = offset + 2 + (((size_t)bytes[offset + 2] << 8) | bytes[offset + 3]);
+
+    NSMutableData *data = [NSMutableData dataWithBytes:bytes length:offset];
+    const size_t length = 2 + 1 + 16 + valueCount;
+    const uint8_t header[] = {0xff, 0xc4, (uint8_t)(length >> 8), (uint8_t)length, 0x00};
+    [data appendBytes:header length:sizeof(header)];
+    [data appendBytes:bits length:16];
+    for (size_t i = 0; i < valueCount; i++) {
+        const uint8_t value = (uint8_t)(i % 12);
+        [data appendBytes:&value length:1];
+    }
+    [data appendBytes:bytes + segmentEnd length:jpeg.length - segmentEnd];
+    return data;
+}
+
+static BOOL TOCropJPEGTransformSucceeds(NSData *jpeg) {
+    uint8_t *output = NULL;
+    size_t outputLength = 0;
+    if (!TOCropJPEGTransformData(jpeg.bytes, jpeg.length, (TOCropPixelRect){8, 8, 24, 16}, 1, &output, &outputLength, NULL)) {
+        return NO;
+    }
+    free(output);
+    return YES;
+}
+
 #pragma mark - Tests -
 
 - (void)testGridOverlayHiddenSetter {
@@ -214,6 +408,71 @@ static void TOCropRunWhileScrollViewIsDragging(void (^block)(void)) {
     XCTAssertEqual(presets.count, 1u);
 }
 
+- (void)testRegisteredPresetsSnapTheCropBoxToTheNearestRatio {
+    // The built-in presets are only created once
+    XCTAssertTrue([TOCropViewControllerAspectRatioPreset portraitPresets] == [TOCropViewControllerAspectRatioPreset portraitPresets]);
+    XCTAssertTrue([TOCropViewControllerAspectRatioPreset landscapePresets] == [TOCropViewControllerAspectRatioPreset landscapePresets]);
+
+    // Registering the same preset twice only adds it once
+    TOCropViewControllerAspectRatioPreset *link = [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:(CGSize){191, 100} title:@"Link"];
+    [TOCropViewControllerAspectRatioPreset registerPresets:@[link]];
+    const NSUInteger count = TOCropViewControllerAspectRatioPreset.registeredPresets.count;
+    [TOCropViewControllerAspectRatioPreset registerPresets:@[link, [[TOCropViewControllerAspectRatioPreset alloc] initWithSize:(CGSize){191, 100} title:@"Link"]]];
+    XCTAssertEqual(TOCropViewControllerAspectRatioPreset.registeredPresets.count, count);
+
+    XCTAssertEqualObjects([TOCropViewControllerAspectRatioPreset registeredPresetNearestToAspectRatio:1.9f tolerance:0.02f], link);
+    XCTAssertEqualObjects([TOCropViewControllerAspectRatioPreset registeredPresetNearestToAspectRatio:0.99f tolerance:0.02f].title, @"Square");
+    XCTAssertEqualObjects([TOCropViewControllerAspectRatioPreset registeredPresetNearestToAspectRatio:0.57f tolerance:0.02f].title, @"9:16");
+    XCTAssertNil([TOCropViewControllerAspectRatioPreset registeredPresetNearestToAspectRatio:1.1f tolerance:0.02f]);
+
+    // The nearest ratio in a large catalog matches a linear search
+    const size_t ratioCount = 500;
+    double ratios[ratioCount];
+    for (size_t i = 0; i < ratioCount; i++) {
+        ratios[i] = (1.0 + (i % 37)) / (1.0 + (i % 23));
+    }
+    TOCropAspectRatioIndex *index = TOCropAspectRatioIndexCreate(ratios, ratioCount);
+    for (double ratio = 0.05; ratio < 20.0; ratio *= 1.013) {
+        double closestDistance = INFINITY;
+        for (size_t i = 0; i < ratioCount; i++) {
+            closestDistance = MIN(closestDistance, fabs(log(ratios[i] / ratio)));
+        }
+        const size_t position = TOCropAspectRatioIndexNearest(index, ratio, 0.05);
+        if (closestDistance > log1p(0.05)) {
+            XCTAssertEqual(position, TOCropAspectRatioIndexNotFound);
+        } else {
+            XCTAssertEqualWithAccuracy(fabs(log(ratios[position] / ratio)), closestDistance, 1e-12);
+        }
+    }
+    TOCropAspectRatioIndexDestroy(index);
+
+    // Dragging the right edge changes the width, and keeps the left edge where it is
+    TOCropLayout layout = {0};
+    layout.contentBounds = (TOCropRect){{10, 10}, {300, 500}};
+    TOCropResize resize = {0};
+    resize.edge = TOCropEdgeRight;
+    TOCropRect frame = TOCropGeometrySnapCropBoxToAspectRatio(&layout, &resize, (TOCropRect){{20, 20}, {101, 100}}, 1.0);
+    XCTAssertEqual(frame.origin.x, 20.0);
+    XCTAssertEqual(frame.size.width, 100.0);
+    XCTAssertEqual(frame.size.height, 100.0);
+
+    // Dragging a corner shortens whichever side is too long, and keeps the opposite corner where it is
+    resize.edge = TOCropEdgeTopLeft;
+    frame = TOCropGeometrySnapCropBoxToAspectRatio(&layout, &resize, (TOCropRect){{20, 20}, {100, 140}}, 0.75);
+    XCTAssertEqual(frame.origin.x, 20.0);
+    XCTAssertEqualWithAccuracy(frame.size.height, 100.0 / 0.75, 1e-9);
+    XCTAssertEqualWithAccuracy(frame.origin.y + frame.size.height, 160.0, 1e-9);
+
+    // A box that would be pushed out of the content bounds is left alone, as is a locked one
+    resize.edge = TOCropEdgeBottom;
+    frame = TOCropGeometrySnapCropBoxToAspectRatio(&layout, &resize, (TOCropRect){{20, 400}, {300, 100}}, 1.0);
+    XCTAssertEqual(frame.size.height, 100.0);
+    resize.edge = TOCropEdgeRight;
+    resize.aspectRatioLocked = true;
+    frame = TOCropGeometrySnapCropBoxToAspectRatio(&layout, &resize, (TOCropRect){{20, 20}, {101, 100}}, 1.0);
+    XCTAssertEqual(frame.size.width, 101.0);
+}
+
 - (void)testViewControllerInstance {
     TOCropViewController *controller = [[TOCropViewController alloc] initWithImage:[self testImageWithSize:(CGSize){10, 10}]];
     UIView *view = controller.view;
@@ -309,4 +568,1632 @@ static void TOCropRunWhileScrollViewIsDragging(void (^block)(void)) {
     XCTAssertFalse(CGRectIsEmpty(toolbar.doneButtonFrame));
 }
 
+#pragma mark - Pixel Kernels -
+
+- (void)testQuarterTurnCopiesMatchRotatedImage {
+    // 0 1 2
+    // 3 4 5
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 3, 2));
+    TOCropFillPixelBufferWithIndices(&source);
+
+    const uint32_t expected[4][6] = {
+        {0, 1, 2, 3, 4, 5},  // As-is
+        {3, 0, 4, 1, 5, 2},  // Clockwise: the left column becomes the top row
+        {5, 4, 3, 2, 1, 0},  // Upside down
+        {2, 5, 1, 4, 0, 3},  // Counterclockwise: the right column becomes the top row
+    };
+
+    for (NSInteger angle = -270; angle <= 270; angle += 90) {
+        const int turns = TOCropQuarterTurnsForAngle(angle);
+        const size_t width = (turns % 2) ? 2 : 3;
+        const size_t height = (turns % 2) ? 3 : 2;
+
+        TOCropPixelBuffer destination;
+        XCTAssertTrue(TOCropPixelBufferAllocate(&destination, width, height));
+        XCTAssertTrue(TOCropPixelBufferCopyRotatedRect(&source, (TOCropPixelRect){0, 0, width, height}, turns, &destination));
+        for (size_t i = 0; i < 6; i++) {
+            XCTAssertEqual(TOCropPixelAt(&destination, i % width, i / width), expected[turns][i], @"angle %ld", (long)angle);
+        }
+        TOCropPixelBufferFree(&destination);
+    }
+
+    // A sub-region is expressed in the rotated space, and overruns are rejected
+    TOCropPixelBuffer region;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&region, 1, 2));
+    XCTAssertTrue(TOCropPixelBufferCopyRotatedRect(&source, (TOCropPixelRect){1, 1, 1, 2}, 1, &region));
+    XCTAssertEqual(TOCropPixelAt(&region, 0, 0), 1u);
+    XCTAssertEqual(TOCropPixelAt(&region, 0, 1), 2u);
+    XCTAssertFalse(TOCropPixelBufferCopyRotatedRect(&source, (TOCropPixelRect){2, 1, 1, 2}, 1, &region));
+
+    TOCropPixelBufferFree(&region);
+    TOCropPixelBufferFree(&source);
+}
+
+- (void)testPixelCroppedImageMatchesRenderedOrientation {
+    // Left half red, right half blue
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = YES;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){40, 20} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor redColor] setFill];
+            [context fillRect:(CGRect){0, 0, 20, 20}];
+            [[UIColor blueColor] setFill];
+            [context fillRect:(CGRect){20, 0, 20, 20}];
+        }];
+
+    // Turned clockwise, the red half ends up on top
+    UIImage *rotated = [image croppedImageWithFrame:(CGRect){0, 0, 20, 40} angle:90 circularClip:NO];
+    XCTAssertEqual(CGImageGetWidth(rotated.CGImage), 20u);
+    XCTAssertEqual(CGImageGetHeight(rotated.CGImage), 40u);
+
+    UIImage *top = [rotated croppedImageWithFrame:(CGRect){0, 0, 20, 20} angle:0 circularClip:NO];
+    UIImage *bottom = [rotated croppedImageWithFrame:(CGRect){0, 20, 20, 20} angle:0 circularClip:NO];
+    CGFloat red = 0.0f, blue = 0.0f;
+    [[self averageColorOfImage:top] getRed:&red green:NULL blue:&blue alpha:NULL];
+    XCTAssertGreaterThan(red, blue);
+    [[self averageColorOfImage:bottom] getRed:&red green:NULL blue:&blue alpha:NULL];
+    XCTAssertGreaterThan(blue, red);
+}
+
+- (void)testPixelViewsCropAndRotateWithoutCopying {
+    // 0 1 2
+    // 3 4 5
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 3, 2));
+    TOCropFillPixelBufferWithIndices(&source);
+
+    // Cropping only moves the origin, and stays contiguous
+    TOCropPixelView view = TOCropPixelViewMake(&source);
+    TOCropPixelView cropped;
+    XCTAssertTrue(TOCropPixelViewCrop(view, (TOCropPixelRect){1, 0, 2, 2}, &cropped));
+    XCTAssertTrue(cropped.origin == source.data + TOCropPixelBufferBytesPerPixel);
+    XCTAssertTrue(TOCropPixelViewIsContiguous(cropped));
+    XCTAssertFalse(TOCropPixelViewCrop(view, (TOCropPixelRect){2, 0, 2, 2}, &cropped));
+
+    // Upside down is expressed with negative strides, starting from the last pixel
+    TOCropPixelView flipped = TOCropPixelViewRotate(view, 2);
+    XCTAssertEqual(*(const uint32_t *)TOCropPixelViewPixelAt(flipped, 0, 0), 5u);
+    XCTAssertEqual(*(const uint32_t *)TOCropPixelViewPixelAt(flipped, 2, 1), 0u);
+    XCTAssertFalse(TOCropPixelViewIsContiguous(flipped));
+
+    // A quarter turn swaps the dimensions, and only copies once materialized
+    TOCropPixelView turned = TOCropPixelViewRotate(view, 1);
+    XCTAssertEqual(turned.width, 2u);
+    XCTAssertEqual(turned.height, 3u);
+    TOCropPixelBuffer copy;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&copy, 2, 3));
+    XCTAssertTrue(TOCropPixelViewCopyToBuffer(turned, &copy));
+    XCTAssertEqual(TOCropPixelAt(&copy, 0, 0), 3u);
+    XCTAssertEqual(TOCropPixelAt(&copy, 1, 2), 2u);
+
+    // Four turns land back where they started
+    TOCropPixelView fullTurn = TOCropPixelViewRotate(TOCropPixelViewRotate(turned, 1), 2);
+    XCTAssertTrue(fullTurn.origin == view.origin);
+    XCTAssertEqual(fullTurn.pixelStride, view.pixelStride);
+    XCTAssertEqual(fullTurn.rowStride, view.rowStride);
+
+    TOCropPixelBufferFree(&copy);
+    TOCropPixelBufferFree(&source);
+}
+
+- (void)testBandRendererMatchesSinglePassCopy {
+    size_t imageWidth = 97;
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, imageWidth, 61));
+    TOCropFillPixelBufferWithIndices(&source);
+
+    const TOCropBandSource bandSource = {source.width, source.height, TOCropReadIndexRegion, &imageWidth};
+    for (int quarterTurns = 0; quarterTurns < 4; quarterTurns++) {
+        const TOCropPixelRect rect = {5, 3, 50, 40};
+        TOCropPixelBuffer expected, output;
+        XCTAssertTrue(TOCropPixelBufferAllocate(&expected, rect.width, rect.height));
+        XCTAssertTrue(TOCropPixelBufferAllocate(&output, rect.width, rect.height));
+        XCTAssertTrue(TOCropPixelBufferCopyRotatedRect(&source, rect, quarterTurns, &expected));
+
+        // A budget of a few kilobytes forces the crop to be split over many bands
+        const size_t memoryBudget = 4096;
+        const TOCropPixelOrientation orientation = TOCropPixelOrientationForQuarterTurns(quarterTurns);
+        const size_t bandRows = TOCropBandRowsForMemoryBudget(rect, orientation, memoryBudget);
+        XCTAssertGreaterThan(bandRows, 0u);
+        XCTAssertLessThan(bandRows, rect.height);
+
+        TOCropBandCollector collector = {&output, 0};
+        const TOCropBandSink sink = {TOCropCollectBand, &collector};
+        XCTAssertTrue(TOCropRenderBands(&bandSource, rect, orientation, memoryBudget, &sink));
+        XCTAssertEqual(collector.bandCount, (rect.height + bandRows - 1) / bandRows);
+
+        for (size_t y = 0; y < rect.height; y++) {
+            XCTAssertEqual(memcmp(expected.data + (y * expected.bytesPerRow), output.data + (y * output.bytesPerRow),
+                                  rect.width * TOCropPixelBufferBytesPerPixel), 0);
+        }
+
+        TOCropPixelBufferFree(&expected);
+        TOCropPixelBufferFree(&output);
+    }
+
+    // Regions outside of the rotated image are rejected before anything is read
+    TOCropBandCollector collector = {NULL, 0};
+    const TOCropBandSink sink = {TOCropCollectBand, &collector};
+    XCTAssertFalse(TOCropRenderBands(&bandSource, (TOCropPixelRect){0, 0, 61, 97},
+                                     TOCropPixelOrientationIdentity(), 4096, &sink));
+    XCTAssertEqual(collector.bandCount, 0u);
+
+    TOCropPixelBufferFree(&source);
+}
+
+- (void)testEnumeratingCroppedRowsStaysWithinMemoryBudget {
+    UIImage *image = [self testImageWithSize:(CGSize){300, 200}];
+    const NSUInteger memoryBudget = 16 * 1024;
+    const NSInteger scale = (NSInteger)image.scale;
+
+    __block NSInteger totalRows = 0;
+    __block NSInteger largestBand = 0;
+    BOOL success = [image enumerateCroppedRowsWithFrame:(CGRect){10, 20, 100, 150}
+                                                  angle:-90
+                                           memoryBudget:memoryBudget
+                                             usingBlock:^BOOL(const uint8_t *bytes, size_t bytesPerRow,
+                                                              NSInteger firstRow, NSInteger rowCount) {
+        XCTAssertEqual(firstRow, totalRows);
+        XCTAssertGreaterThanOrEqual((NSInteger)bytesPerRow, 100 * scale * 4);
+        totalRows += rowCount;
+        largestBand = MAX(largestBand, rowCount);
+        return YES;
+    }];
+    XCTAssertTrue(success);
+    XCTAssertEqual(totalRows, 150 * scale);
+    XCTAssertLessThanOrEqual(largestBand * (100 * scale) * 4 * 2, (NSInteger)memoryBudget);
+
+    // Stopping early is reported back
+    success = [image enumerateCroppedRowsWithFrame:(CGRect){0, 0, 100, 100}
+                                             angle:0
+                                      memoryBudget:memoryBudget
+                                        usingBlock:^BOOL(const uint8_t *bytes, size_t bytesPerRow,
+                                                         NSInteger firstRow, NSInteger rowCount) {
+        return NO;
+    }];
+    XCTAssertFalse(success);
+}
+
+- (void)testCircularMaskCopiesInsideAndClearsOutside {
+    TOCropPixelBuffer source, destination;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 64, 64));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&destination, 64, 64));
+    memset(source.data, 0xff, TOCropPixelBufferByteCount(&source));
+
+    XCTAssertTrue(TOCropPixelViewCopyToBufferWithCircularMask(TOCropPixelViewMake(&source), 0, &destination));
+
+    // Corners are cleared, the middle is untouched, and the edge is partially covered
+    XCTAssertEqual(TOCropPixelAt(&destination, 0, 0), 0u);
+    XCTAssertEqual(TOCropPixelAt(&destination, 63, 63), 0u);
+    XCTAssertEqual(TOCropPixelAt(&destination, 32, 32), 0xffffffffu);
+    const uint8_t edge = destination.data[(32 * destination.bytesPerRow) + 0];
+    XCTAssertGreaterThan(edge, 0);
+    XCTAssertLessThan(edge, 0xff);
+
+    // Every channel of a pixel is scaled by the same coverage
+    for (size_t x = 0; x < destination.width; x++) {
+        const uint8_t *pixel = destination.data + (10 * destination.bytesPerRow) + (x * TOCropPixelBufferBytesPerPixel);
+        XCTAssertTrue(pixel[0] == pixel[1] && pixel[1] == pixel[2] && pixel[2] == pixel[3]);
+    }
+
+    // Unused alpha bytes are treated as opaque
+    memset(source.data, 0, TOCropPixelBufferByteCount(&source));
+    XCTAssertTrue(TOCropPixelViewCopyToBufferWithCircularMask(TOCropPixelViewMake(&source), 0xffu, &destination));
+    XCTAssertEqual(destination.data[(32 * destination.bytesPerRow) + (32 * TOCropPixelBufferBytesPerPixel)], 0xff);
+    XCTAssertEqual(TOCropPixelAt(&destination, 0, 0), 0u);
+
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&destination);
+}
+
+- (void)testCircularCropOfOpaqueImageHasTransparentCorners {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = YES;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){80, 60} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor redColor] setFill];
+            [context fillRect:(CGRect){0, 0, 80, 60}];
+        }];
+
+    UIImage *circle = [image croppedImageWithFrame:(CGRect){0, 0, 40, 40} angle:90 circularClip:YES];
+    XCTAssertNotEqual(CGImageGetAlphaInfo(circle.CGImage), kCGImageAlphaNoneSkipLast);
+    XCTAssertNotEqual(CGImageGetAlphaInfo(circle.CGImage), kCGImageAlphaNoneSkipFirst);
+
+    CGFloat alpha = 1.0f;
+    UIImage *corner = [circle croppedImageWithFrame:(CGRect){0, 0, 4, 4} angle:0 circularClip:NO];
+    [[self averageColorOfImage:corner] getRed:NULL green:NULL blue:NULL alpha:&alpha];
+    XCTAssertLessThan(alpha, 0.1f);
+
+    CGFloat red = 0.0f;
+    UIImage *middle = [circle croppedImageWithFrame:(CGRect){16, 16, 8, 8} angle:0 circularClip:NO];
+    [[self averageColorOfImage:middle] getRed:&red green:NULL blue:NULL alpha:&alpha];
+    XCTAssertGreaterThan(red, 0.9f);
+    XCTAssertGreaterThan(alpha, 0.9f);
+}
+
+- (void)testLosslessJPEGCropRotatesBlocks {
+    // Left half red, right half blue, with block-aligned halves
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = YES;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){64, 48} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor redColor] setFill];
+            [context fillRect:(CGRect){0, 0, 32, 48}];
+            [[UIColor blueColor] setFill];
+            [context fillRect:(CGRect){32, 0, 32, 48}];
+        }];
+
+    NSURL *directoryURL = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+    NSURL *sourceURL = [directoryURL URLByAppendingPathComponent:@"TOCropLosslessSource.jpg"];
+    NSURL *destinationURL = [directoryURL URLByAppendingPathComponent:@"TOCropLosslessOutput.jpg"];
+    XCTAssertTrue([UIImageJPEGRepresentation(image, 0.9f) writeToURL:sourceURL atomically:YES]);
+
+    // Turned clockwise, the image is 48x64 with the red half on top. Crop a little of each.
+    CGRect croppedFrame = [UIImage writeLosslessJPEGCropFromURL:sourceURL
+                                                          toURL:destinationURL
+                                                          frame:(CGRect){0, 16, 48, 32}
+                                                          angle:90];
+    XCTAssertFalse(CGRectIsNull(croppedFrame));
+    XCTAssertTrue(CGRectContainsRect(croppedFrame, (CGRect){0, 16, 48, 32}));
+
+    UIImage *croppedImage = [UIImage imageWithContentsOfFile:destinationURL.path];
+    XCTAssertEqual(croppedImage.size.width, CGRectGetWidth(croppedFrame));
+    XCTAssertEqual(croppedImage.size.height, CGRectGetHeight(croppedFrame));
+
+    const CGFloat halfHeight = (32.0f - CGRectGetMinY(croppedFrame));
+    UIImage *top = [croppedImage croppedImageWithFrame:(CGRect){0, 0, 48, halfHeight} angle:0 circularClip:NO];
+    UIImage *bottom = [croppedImage croppedImageWithFrame:(CGRect){0, halfHeight, 48, halfHeight} angle:0 circularClip:NO];
+    CGFloat red = 0.0f, blue = 0.0f;
+    [[self averageColorOfImage:top] getRed:&red green:NULL blue:&blue alpha:NULL];
+    XCTAssertGreaterThan(red, blue);
+    [[self averageColorOfImage:bottom] getRed:&red green:NULL blue:&blue alpha:NULL];
+    XCTAssertGreaterThan(blue, red);
+
+    // Files that aren't JPEGs are rejected without writing anything
+    NSURL *pngURL = [directoryURL URLByAppendingPathComponent:@"TOCropLosslessSource.png"];
+    XCTAssertTrue([UIImagePNGRepresentation(image) writeToURL:pngURL atomically:YES]);
+    [[NSFileManager defaultManager] removeItemAtURL:destinationURL error:nil];
+    XCTAssertTrue(CGRectIsNull([UIImage writeLosslessJPEGCropFromURL:pngURL toURL:destinationURL
+                                                               frame:(CGRect){0, 0, 16, 16} angle:0]));
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:destinationURL.path]);
+
+    [[NSFileManager defaultManager] removeItemAtURL:sourceURL error:nil];
+    [[NSFileManager defaultManager] removeItemAtURL:pngURL error:nil];
+}
+
+- (void)testLosslessJPEGCropMatchesGoldenFile {
+    NSURL *directoryURL = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+    NSURL *sourceURL = [directoryURL URLByAppendingPathComponent:@"TOCropGoldenSource.jpg"];
+    NSURL *destinationURL = [directoryURL URLByAppendingPathComponent:@"TOCropGoldenOutput.jpg"];
+    XCTAssertTrue([[NSData dataWithBytes:kTOCropGoldenJPEG length:sizeof(kTOCropGoldenJPEG)] writeToURL:sourceURL atomically:YES]);
+
+    // Displayed and turned, the image is 40x24, with its partial blocks moved to the top left,
+    // so the crop expands out to the whole blocks after them
+    CGRect croppedFrame = [UIImage writeLosslessJPEGCropFromURL:sourceURL
+                                                          toURL:destinationURL
+                                                          frame:(CGRect){8, 8, 24, 16}
+                                                          angle:90];
+    XCTAssertTrue(CGRectEqualToRect(croppedFrame, (CGRect){8, 8, 32, 16}));
+
+    NSData *expected = [NSData dataWithBytes:kTOCropGoldenJPEGCroppedAt90Degrees length:sizeof(kTOCropGoldenJPEGCroppedAt90Degrees)];
+    XCTAssertEqualObjects([NSData dataWithContentsOfURL:destinationURL], expected);
+
+    // The orientation has been applied to the blocks, so the output displays as stored
+    UIImage *croppedImage = [UIImage imageWithContentsOfFile:destinationURL.path];
+    XCTAssertEqual(croppedImage.imageOrientation, UIImageOrientationUp);
+    XCTAssertEqual(croppedImage.size.width, 32.0f);
+    XCTAssertEqual(croppedImage.size.height, 16.0f);
+
+    [[NSFileManager defaultManager] removeItemAtURL:sourceURL error:nil];
+    [[NSFileManager defaultManager] removeItemAtURL:destinationURL error:nil];
+}
+
+- (void)testLosslessJPEGCropRejectsMalformedHuffmanTables {
+    NSData *jpeg = [NSData dataWithBytes:kTOCropGoldenJPEG length:sizeof(kTOCropGoldenJPEG)];
+    XCTAssertTrue(TOCropJPEGTransformSucceeds(jpeg));
+
+    // The standard luminance DC table, in place of the file's own, still decodes
+    const uint8_t standardBits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+    XCTAssertTrue(TOCropJPEGTransformSucceeds(TOCropJPEGWithDCTable(jpeg, standardBits, 12)));
+
+    // More codes of one length than there are bit patterns for them
+    const uint8_t oneBitCodes[16] = {200};
+    XCTAssertFalse(TOCropJPEGTransformSucceeds(TOCropJPEGWithDCTable(jpeg, oneBitCodes, 200)));
+    const uint8_t twoBitCodes[16] = {0, 5};
+    XCTAssertFalse(TOCropJPEGTransformSucceeds(TOCropJPEGWithDCTable(jpeg, twoBitCodes, 5)));
+    const uint8_t overfullBits[16] = {0, 4, 0, 0, 0, 0, 0, 0, 1}; // Every 2-bit pattern is taken, leaving none to extend
+    XCTAssertFalse(TOCropJPEGTransformSucceeds(TOCropJPEGWithDCTable(jpeg, overfullBits, 5)));
+
+    // Fewer values than the counts add up to, so the table runs into the next segment
+    XCTAssertFalse(TOCropJPEGTransformSucceeds(TOCropJPEGWithDCTable(jpeg, standardBits, 6)));
+
+    // Cut off anywhere before the compressed data starts, the file is rejected. (Once into the
+    // compressed data, the missing bits are read as zeros, the same as libjpeg.)
+    const uint8_t *bytes = jpeg.bytes;
+    size_t scanStart = 2;
+    while (bytes[scanStart + 1] != 0xda) {
+        scanStart += 2 + (((size_t)bytes[scanStart + 2] << 8) | bytes[scanStart + 3]);
+    }
+    scanStart += 2 + (((size_t)bytes[scanStart + 2] << 8) | bytes[scanStart + 3]);
+    for (size_t length = 0; length < scanStart; length++) {
+        XCTAssertFalse(TOCropJPEGTransformSucceeds([jpeg subdataWithRange:NSMakeRange(0, length)]), @"%zu bytes", length);
+    }
+}
+
+- (void)testBatchProcessorScalesCropToEachImage {
+    // The same picture at two sizes, left half red and right half blue
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = YES;
+    NSURL *directoryURL = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+    NSMutableArray<NSURL *> *sourceURLs = [NSMutableArray array];
+    NSMutableArray<NSURL *> *destinationURLs = [NSMutableArray array];
+    for (NSInteger i = 0; i < 3; i++) {
+        const CGSize size = (CGSize){80 * (i + 1), 40 * (i + 1)};
+        UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:size format:format]
+            imageWithActions:^(UIGraphicsImageRendererContext *context) {
+                [[UIColor redColor] setFill];
+                [context fillRect:(CGRect){0, 0, size.width / 2, size.height}];
+                [[UIColor blueColor] setFill];
+                [context fillRect:(CGRect){size.width / 2, 0, size.width / 2, size.height}];
+            }];
+        NSString *name = [NSString stringWithFormat:@"TOCropBatch%ld", (long)i];
+        [sourceURLs addObject:[directoryURL URLByAppendingPathComponent:[name stringByAppendingString:@".jpg"]]];
+        [destinationURLs addObject:[directoryURL URLByAppendingPathComponent:[name stringByAppendingString:@"-cropped.jpg"]]];
+        XCTAssertTrue([UIImageJPEGRepresentation(image, 0.9f) writeToURL:sourceURLs.lastObject atomically:YES]);
+    }
+
+    // One file that doesn't exist, which shouldn't hold up the others
+    [sourceURLs insertObject:[directoryURL URLByAppendingPathComponent:@"TOCropBatchMissing.jpg"] atIndex:1];
+    [destinationURLs insertObject:[directoryURL URLByAppendingPathComponent:@"TOCropBatchMissing-cropped.jpg"] atIndex:1];
+
+    // The blue half of the smallest image, at a single slot between each stage
+    TOCroppedImageAttributes *attributes = [[TOCroppedImageAttributes alloc] initWithCroppedFrame:(CGRect){40, 0, 40, 40}
+                                                                                            angle:0
+                                                                                originalImageSize:(CGSize){80, 40}];
+    TOCropBatchProcessor *processor = [[TOCropBatchProcessor alloc] initWithAttributes:attributes];
+    processor.maximumQueuedImages = 1;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Batch finished"];
+    NSMutableArray<NSNumber *> *completedIndices = [NSMutableArray array];
+    NSMutableArray *errors = [NSMutableArray array];
+    [processor cropImagesAtURLs:sourceURLs toURLs:destinationURLs itemCompletion:^(NSUInteger index, NSURL *outputURL, NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertTrue((outputURL == nil) != (error == nil));
+        [completedIndices addObject:@(index)];
+        [errors addObject:error ?: [NSNull null]];
+    } completion:^{
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqualObjects(completedIndices, (@[@0, @1, @2, @3]));
+    XCTAssertTrue([errors[1] isKindOfClass:[NSError class]]);
+    for (NSInteger i = 0; i < 4; i++) {
+        if (i == 1) { continue; }
+        XCTAssertEqualObjects(errors[i], [NSNull null]);
+
+        // Each crop is a square of the blue half, at that image's own resolution
+        const CGFloat scale = (i == 0) ? 1.0f : i; // The sources are 80, 160 and 240 wide
+        UIImage *croppedImage = [UIImage imageWithContentsOfFile:destinationURLs[i].path];
+        XCTAssertEqual(croppedImage.size.width, 40.0f * scale);
+        XCTAssertEqual(croppedImage.size.height, 40.0f * scale);
+        CGFloat red = 0.0f, blue = 0.0f;
+        [[self averageColorOfImage:croppedImage] getRed:&red green:NULL blue:&blue alpha:NULL];
+        XCTAssertGreaterThan(blue, 0.8f);
+        XCTAssertLessThan(red, 0.2f);
+    }
+
+    for (NSURL *url in [sourceURLs arrayByAddingObjectsFromArray:destinationURLs]) {
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    }
+}
+
+- (void)testOrientationsComposeIntoOnePixelPass {
+    // Rotating clockwise then mirroring is the same as the EXIF 'transverse' orientation
+    TOCropPixelOrientation combined = TOCropPixelOrientationConcat(TOCropPixelOrientationForQuarterTurns(1),
+                                                                   TOCropPixelOrientationForEXIFOrientation(2));
+    TOCropPixelOrientation transverse = TOCropPixelOrientationForEXIFOrientation(7);
+    XCTAssertEqual(combined.transpose, transverse.transpose);
+    XCTAssertEqual(combined.flipX, transverse.flipX);
+    XCTAssertEqual(combined.flipY, transverse.flipY);
+
+    // Four quarter turns cancel out entirely
+    TOCropPixelOrientation fullTurn = TOCropPixelOrientationIdentity();
+    for (NSInteger i = 0; i < 4; i++) {
+        fullTurn = TOCropPixelOrientationConcat(fullTurn, TOCropPixelOrientationForQuarterTurns(1));
+    }
+    XCTAssertTrue(TOCropPixelOrientationIsIdentity(fullTurn));
+
+    // Red, green, blue and white quadrants
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    format.opaque = YES;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){40, 20} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            NSArray<UIColor *> *colors = @[UIColor.redColor, UIColor.greenColor, UIColor.blueColor, UIColor.whiteColor];
+            for (NSInteger i = 0; i < 4; i++) {
+                [colors[i] setFill];
+                [context fillRect:(CGRect){(i % 2) * 20, (i / 2) * 10, 20, 10}];
+            }
+        }];
+
+    // Every orientation, cropped with a rotation, lands the same way UIKit would draw it
+    for (NSInteger imageOrientation = UIImageOrientationUp; imageOrientation <= UIImageOrientationRightMirrored; imageOrientation++) {
+        UIImage *orientedImage = [UIImage imageWithCGImage:image.CGImage scale:1.0f orientation:imageOrientation];
+        UIImage *drawnImage = [[[UIGraphicsImageRenderer alloc] initWithSize:orientedImage.size format:format]
+            imageWithActions:^(UIGraphicsImageRendererContext *context) {
+                [orientedImage drawAtPoint:CGPointZero];
+            }];
+
+        const CGRect frame = (CGRect){CGPointZero, (CGSize){orientedImage.size.height, orientedImage.size.width}};
+        UIImage *pixelCropped = [orientedImage croppedImageWithFrame:frame angle:90 circularClip:NO];
+        UIImage *drawnCropped = [drawnImage croppedImageWithFrame:frame angle:90 circularClip:NO];
+        XCTAssertTrue(CGSizeEqualToSize(pixelCropped.size, drawnCropped.size));
+
+        const CGRect corner = (CGRect){0, 0, 4, 4};
+        UIColor *pixelColor = [self averageColorOfImage:[pixelCropped croppedImageWithFrame:corner angle:0 circularClip:NO]];
+        UIColor *drawnColor = [self averageColorOfImage:[drawnCropped croppedImageWithFrame:corner angle:0 circularClip:NO]];
+        CGFloat pixelRGB[3], drawnRGB[3];
+        [pixelColor getRed:&pixelRGB[0] green:&pixelRGB[1] blue:&pixelRGB[2] alpha:NULL];
+        [drawnColor getRed:&drawnRGB[0] green:&drawnRGB[1] blue:&drawnRGB[2] alpha:NULL];
+        for (NSInteger i = 0; i < 3; i++) {
+            XCTAssertEqualWithAccuracy(pixelRGB[i], drawnRGB[i], 0.05f, @"Orientation %ld", (long)imageOrientation);
+        }
+    }
+}
+
+- (void)testResamplingAveragesPixelsAndKeepsFlatColors {
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 64, 48));
+    for (size_t y = 0; y < source.height; y++) {
+        for (size_t x = 0; x < source.width; x++) {
+            uint8_t *pixel = source.data + (y * source.bytesPerRow) + (x * TOCropPixelBufferBytesPerPixel);
+            pixel[0] = (uint8_t)(x * 4);
+            pixel[1] = (uint8_t)(y * 5);
+            pixel[2] = 90;
+            pixel[3] = 255;
+        }
+    }
+
+    // Halving with a box filter averages each 2x2 block exactly
+    TOCropPixelBuffer half;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&half, 32, 24));
+    XCTAssertTrue(TOCropPixelViewResampleToBuffer(TOCropPixelViewMake(&source), TOCropResampleFilterBox, &half));
+    for (size_t y = 0; y < half.height; y++) {
+        for (size_t x = 0; x < half.width; x++) {
+            const uint8_t *pixel = half.data + (y * half.bytesPerRow) + (x * TOCropPixelBufferBytesPerPixel);
+            XCTAssertEqual(pixel[0], (x * 8) + 2);
+            XCTAssertEqualWithAccuracy(pixel[1], (y * 10) + 2.5, 0.5);
+        }
+    }
+    TOCropPixelBufferFree(&half);
+
+    // Every filter leaves a flat channel untouched at any size, including past the edges
+    for (TOCropResampleFilter filter = TOCropResampleFilterBox; filter <= TOCropResampleFilterLanczos; filter++) {
+        TOCropPixelBuffer resized;
+        XCTAssertTrue(TOCropPixelBufferAllocate(&resized, 17, 71));
+        XCTAssertTrue(TOCropResampleRegion(&source, (TOCropPixelRect){5, 3, 40, 50},
+                                           TOCropPixelOrientationForQuarterTurns(1), filter, 0, &resized));
+        for (size_t y = 0; y < resized.height; y++) {
+            for (size_t x = 0; x < resized.width; x++) {
+                const uint8_t *pixel = resized.data + (y * resized.bytesPerRow) + (x * TOCropPixelBufferBytesPerPixel);
+                XCTAssertEqual(pixel[2], 90);
+                XCTAssertEqual(pixel[3], 255);
+            }
+        }
+        TOCropPixelBufferFree(&resized);
+    }
+
+    // Regions outside the oriented image are rejected
+    TOCropPixelBuffer small;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&small, 8, 8));
+    XCTAssertFalse(TOCropResampleRegion(&source, (TOCropPixelRect){0, 0, 64, 48},
+                                        TOCropPixelOrientationForQuarterTurns(1), TOCropResampleFilterBox, 0, &small));
+    TOCropPixelBufferFree(&small);
+    TOCropPixelBufferFree(&source);
+}
+
+- (void)testCroppingToPixelSizeMatchesCroppingThenScaling {
+    // Red, green, blue and white quadrants
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 2.0f;
+    format.opaque = YES;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){200, 100} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            NSArray<UIColor *> *colors = @[UIColor.redColor, UIColor.greenColor, UIColor.blueColor, UIColor.whiteColor];
+            for (NSInteger i = 0; i < 4; i++) {
+                [colors[i] setFill];
+                [context fillRect:(CGRect){(i % 2) * 100, (i / 2) * 50, 100, 50}];
+            }
+        }];
+
+    // In the space of the image once it's turned, which is 100x200
+    const CGRect frame = (CGRect){10, 20, 80, 160};
+    for (TOCropViewResamplingFilter filter = TOCropViewResamplingFilterBox; filter <= TOCropViewResamplingFilterLanczos; filter++) {
+        UIImage *scaled = [image croppedImageWithFrame:frame angle:90 circularClip:NO
+                                     scaledToPixelSize:(CGSize){40, 80} filter:filter];
+        XCTAssertEqual(scaled.scale, 1.0f);
+        XCTAssertTrue(CGSizeEqualToSize(scaled.size, ((CGSize){40, 80})));
+
+        // After a clockwise turn, the blue quadrant is in the top left and red in the top right
+        CGFloat red, green, blue;
+        [[self averageColorOfImage:[scaled croppedImageWithFrame:(CGRect){2, 2, 12, 30} angle:0 circularClip:NO]]
+            getRed:&red green:&green blue:&blue alpha:NULL];
+        XCTAssertGreaterThan(blue, 0.9f);
+        XCTAssertLessThan(red + green, 0.1f);
+        [[self averageColorOfImage:[scaled croppedImageWithFrame:(CGRect){26, 2, 12, 30} angle:0 circularClip:NO]]
+            getRed:&red green:&green blue:&blue alpha:NULL];
+        XCTAssertGreaterThan(red, 0.9f);
+        XCTAssertLessThan(green + blue, 0.1f);
+    }
+
+    // Circular crops come out transparent in the corners at the final size
+    UIImage *avatar = [image croppedImageWithFrame:(CGRect){50, 0, 100, 100} angle:0 circularClip:YES
+                                 scaledToPixelSize:(CGSize){32, 32} filter:TOCropViewResamplingFilterBilinear];
+    XCTAssertTrue(CGSizeEqualToSize(avatar.size, ((CGSize){32, 32})));
+    CGFloat alpha;
+    [[self averageColorOfImage:[avatar croppedImageWithFrame:(CGRect){0, 0, 2, 2} angle:0 circularClip:NO]]
+        getRed:NULL green:NULL blue:NULL alpha:&alpha];
+    XCTAssertLessThan(alpha, 0.1f);
+}
+
+- (void)testHalfFloatAndTenBitPixelsRoundTripBitExactly {
+    // Every possible half survives a trip through a float and back
+    for (uint32_t half = 0; half <= 0xffff; half++) {
+        const float value = TOCropHalfToFloat((uint16_t)half);
+        if (isnan(value)) {
+            XCTAssertTrue(isnan(TOCropHalfToFloat(TOCropFloatToHalf(value))));
+            continue;
+        }
+        XCTAssertEqual(TOCropFloatToHalf(value), half);
+    }
+    XCTAssertEqual(TOCropFloatToHalf(65520.0f), 0x7c00); // Rounds up to infinity
+    XCTAssertEqual(TOCropFloatToHalf(1.0f + (1.0f / 2048.0f)), 0x3c00); // A tie, which rounds to even
+
+    // Four quarter turns of every format give back the original bits
+    const TOCropPixelFormat formats[] = {TOCropPixelFormatRGBA8, TOCropPixelFormatRGB10A2,
+                                         TOCropPixelFormatRGBA16F, TOCropPixelFormatRGBA32F};
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        TOCropPixelBuffer original;
+        XCTAssertTrue(TOCropPixelBufferAllocateWithFormat(&original, 45, 37, formats[f]));
+        for (size_t i = 0; i < original.bytesPerRow * original.height; i++) {
+            original.data[i] = (uint8_t)((i * 131) ^ (i >> 7));
+        }
+
+        TOCropPixelBuffer current = original;
+        for (NSInteger turn = 0; turn < 4; turn++) {
+            TOCropPixelBuffer rotated;
+            TOCropPixelView view = TOCropPixelViewRotate(TOCropPixelViewMake(&current), 1);
+            XCTAssertTrue(TOCropPixelBufferAllocateWithFormat(&rotated, view.width, view.height, formats[f]));
+            XCTAssertTrue(TOCropPixelViewCopyToBuffer(view, &rotated));
+            if (current.data != original.data) {
+                TOCropPixelBufferFree(&current);
+            }
+            current = rotated;
+        }
+        const size_t rowLength = original.width * TOCropPixelFormatBytesPerPixel(formats[f]);
+        for (size_t y = 0; y < original.height; y++) {
+            XCTAssertEqual(memcmp(original.data + (y * original.bytesPerRow),
+                                  current.data + (y * current.bytesPerRow), rowLength), 0);
+        }
+        TOCropPixelBufferFree(&current);
+        TOCropPixelBufferFree(&original);
+    }
+
+    // Every 10-bit value survives conversion to floats and back
+    TOCropPixelBuffer packed, floats, unpacked;
+    XCTAssertTrue(TOCropPixelBufferAllocateWithFormat(&packed, 1024, 1, TOCropPixelFormatRGB10A2));
+    XCTAssertTrue(TOCropPixelBufferAllocateWithFormat(&floats, 1024, 1, TOCropPixelFormatRGBA32F));
+    XCTAssertTrue(TOCropPixelBufferAllocateWithFormat(&unpacked, 1024, 1, TOCropPixelFormatRGB10A2));
+    for (uint32_t x = 0; x < 1024; x++) {
+        const uint32_t pixel = x | ((1023 - x) << 10) | (((x * 7) & 1023) << 20) | ((x & 3) << 30);
+        memcpy(packed.data + (x * 4), &pixel, sizeof(pixel));
+    }
+    XCTAssertTrue(TOCropPixelBufferConvert(&packed, &floats));
+    XCTAssertTrue(TOCropPixelBufferConvert(&floats, &unpacked));
+    XCTAssertEqual(memcmp(packed.data, unpacked.data, 1024 * 4), 0);
+
+    // Formats can't be mixed in a copy
+    XCTAssertFalse(TOCropPixelViewCopyToBuffer(TOCropPixelViewMake(&packed), &floats));
+    TOCropPixelBufferFree(&packed);
+    TOCropPixelBufferFree(&floats);
+    TOCropPixelBufferFree(&unpacked);
+}
+
+- (void)testHalfFloatImagesCropWithoutChangingFormat {
+    // An extended range image, with values beyond SDR white that an 8-bit crop would clip
+    const size_t width = 48, height = 32;
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceExtendedLinearSRGB);
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 16, 0, colorSpace,
+                                                 kCGImageAlphaPremultipliedLast | kCGBitmapFloatComponents |
+                                                 kCGBitmapByteOrder16Little);
+    CGColorSpaceRelease(colorSpace);
+    XCTAssertTrue(context != NULL);
+    uint16_t *pixels = CGBitmapContextGetData(context);
+    const size_t halvesPerRow = CGBitmapContextGetBytesPerRow(context) / sizeof(uint16_t);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint16_t *pixel = pixels + (y * halvesPerRow) + (x * 4);
+            pixel[0] = TOCropFloatToHalf(4.0f * x / width);
+            pixel[1] = TOCropFloatToHalf(2.0f * y / height);
+            pixel[2] = TOCropFloatToHalf(0.5f);
+            pixel[3] = TOCropFloatToHalf(1.0f);
+        }
+    }
+    CGImageRef imageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:1.0f orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    // Rotated clockwise, the crop's top left pixel is the original's bottom left one
+    UIImage *cropped = [image croppedImageWithFrame:(CGRect){0, 0, height, width} angle:90 circularClip:NO];
+    CGImageRef croppedRef = cropped.CGImage;
+    XCTAssertEqual(CGImageGetBitsPerComponent(croppedRef), 16);
+    XCTAssertEqual(CGImageGetBitsPerPixel(croppedRef), 64);
+    XCTAssertTrue((CGImageGetBitmapInfo(croppedRef) & kCGBitmapFloatComponents) != 0);
+
+    CFDataRef croppedData = CGDataProviderCopyData(CGImageGetDataProvider(croppedRef));
+    const uint16_t *croppedPixels = (const uint16_t *)CFDataGetBytePtr(croppedData);
+    const size_t croppedHalvesPerRow = CGImageGetBytesPerRow(croppedRef) / sizeof(uint16_t);
+    for (size_t y = 0; y < width; y++) {
+        for (size_t x = 0; x < height; x++) {
+            const uint16_t *pixel = croppedPixels + (y * croppedHalvesPerRow) + (x * 4);
+            XCTAssertEqual(pixel[0], TOCropFloatToHalf(4.0f * y / width));
+            XCTAssertEqual(pixel[1], TOCropFloatToHalf(2.0f * (height - 1 - x) / height));
+        }
+    }
+    CFRelease(croppedData);
+}
+
+- (void)testTiledRenderingIsIdenticalOnAnyNumberOfThreads {
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 517, 389));
+    for (size_t i = 0; i < source.bytesPerRow * source.height; i++) {
+        source.data[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    const size_t maximumThreads = MAX(TOCropParallelDefaultThreadCount(), 4);
+    for (int exifOrientation = 1; exifOrientation <= 8; exifOrientation++) {
+        const TOCropPixelOrientation orientation = TOCropPixelOrientationForEXIFOrientation(exifOrientation);
+        const size_t width = orientation.transpose ? source.height : source.width;
+        const size_t height = orientation.transpose ? source.width : source.height;
+        const TOCropPixelRect rect = {7, 11, width - 20, height - 15};
+
+        for (NSInteger circular = 0; circular < 2; circular++) {
+            TOCropPixelBuffer singleThreaded, multiThreaded;
+            XCTAssertTrue(TOCropPixelBufferAllocate(&singleThreaded, rect.width, rect.height));
+            XCTAssertTrue(TOCropPixelBufferAllocate(&multiThreaded, rect.width, rect.height));
+            XCTAssertTrue(TOCropRenderRegion(&source, rect, orientation,
+                                             (TOCropTiledRenderOptions){circular, 0, 1, NULL}, &singleThreaded));
+            for (size_t threads = 2; threads <= maximumThreads; threads++) {
+                memset(multiThreaded.data, 0, multiThreaded.bytesPerRow * multiThreaded.height);
+                XCTAssertTrue(TOCropRenderRegion(&source, rect, orientation,
+                                                 (TOCropTiledRenderOptions){circular, 0, threads, NULL}, &multiThreaded));
+                XCTAssertEqual(memcmp(singleThreaded.data, multiThreaded.data,
+                                      singleThreaded.bytesPerRow * singleThreaded.height), 0);
+            }
+            TOCropPixelBufferFree(&singleThreaded);
+            TOCropPixelBufferFree(&multiThreaded);
+        }
+    }
+
+    // Scaling refilters the rows each block shares with the one above, which must come out the same
+    for (TOCropResampleFilter filter = TOCropResampleFilterBox; filter <= TOCropResampleFilterLanczos; filter++) {
+        TOCropPixelBuffer singleThreaded, multiThreaded;
+        XCTAssertTrue(TOCropPixelBufferAllocate(&singleThreaded, 131, 97));
+        XCTAssertTrue(TOCropPixelBufferAllocate(&multiThreaded, 131, 97));
+        XCTAssertTrue(TOCropPixelViewResampleToBuffer(TOCropPixelViewMake(&source), filter, &singleThreaded));
+        for (size_t threads = 2; threads <= maximumThreads; threads++) {
+            XCTAssertTrue(TOCropResampleRegion(&source, (TOCropPixelRect){0, 0, 517, 389},
+                                               TOCropPixelOrientationIdentity(), filter, threads, &multiThreaded));
+            XCTAssertEqual(memcmp(singleThreaded.data, multiThreaded.data,
+                                  singleThreaded.bytesPerRow * singleThreaded.height), 0);
+        }
+        TOCropPixelBufferFree(&singleThreaded);
+        TOCropPixelBufferFree(&multiThreaded);
+    }
+    TOCropPixelBufferFree(&source);
+}
+
+- (void)testCancelledRenderStopsBeforeItsNextBlock {
+    TOCropPixelBuffer source, destination;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 300, 500));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&destination, 500, 300));
+    memset(source.data, 0x7f, source.bytesPerRow * source.height);
+    const TOCropPixelRect rect = {0, 0, 500, 300};
+    const TOCropPixelOrientation orientation = TOCropPixelOrientationForQuarterTurns(1);
+
+    // Every row is counted as it's rendered
+    TOCropRenderProgress progress = {false, 0};
+    XCTAssertTrue(TOCropRenderRegion(&source, rect, orientation, (TOCropTiledRenderOptions){false, 0, 0, &progress}, &destination));
+    XCTAssertEqual(progress.completedRows, 300u);
+
+    // Once cancelled, no more blocks are started, and the render reports it failed
+    TOCropRenderProgress cancelledProgress = {true, 0};
+    XCTAssertFalse(TOCropRenderRegion(&source, rect, orientation, (TOCropTiledRenderOptions){false, 0, 0, &cancelledProgress}, &destination));
+    XCTAssertEqual(cancelledProgress.completedRows, 0u);
+
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&destination);
+}
+
+- (void)testRenderJobsCompleteInOrderAndCanBeCancelled {
+    UIImage *image = [self testImageWithSize:(CGSize){400, 300}];
+    const CGRect frame = (CGRect){10, 20, 200, 150};
+    TOCropRenderJob *firstJob = [[TOCropRenderJob alloc] initWithImage:image frame:frame angle:90 circular:NO];
+    TOCropRenderJob *cancelledJob = [[TOCropRenderJob alloc] initWithImage:image frame:frame angle:0 circular:YES];
+    TOCropRenderJob *lastJob = [[TOCropRenderJob alloc] initWithImage:image frame:frame angle:0 circular:YES];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Jobs finished"];
+    expectation.expectedFulfillmentCount = 3;
+    NSMutableArray *results = [NSMutableArray array];
+    for (TOCropRenderJob *job in @[firstJob, cancelledJob, lastJob]) {
+        [job startWithCompletion:^(UIImage *croppedImage) {
+            XCTAssertTrue([NSThread isMainThread]);
+            XCTAssertTrue(job.finished);
+            [results addObject:croppedImage ?: [NSNull null]];
+            [expectation fulfill];
+        }];
+    }
+    [cancelledJob cancel];
+    XCTAssertTrue(cancelledJob.cancelled);
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    // Each finished job matches cropping on the calling thread
+    XCTAssertEqual(results.count, 3u);
+    XCTAssertEqualObjects(results[1], [NSNull null]);
+    UIImage *expectedFirst = [image croppedImageWithFrame:frame angle:90 circularClip:NO];
+    UIImage *expectedLast = [image croppedImageWithFrame:frame angle:0 circularClip:YES];
+    XCTAssertTrue(CGSizeEqualToSize([results[0] size], expectedFirst.size));
+    XCTAssertTrue(CGSizeEqualToSize([results[2] size], expectedLast.size));
+    XCTAssertEqual(firstJob.fractionCompleted, 1.0);
+    XCTAssertEqual(lastJob.fractionCompleted, 1.0);
+}
+
+- (void)testRenderCacheSharesOneRenderAndKeepsTheMostRecentlyUsedCrops {
+    UIImage *image = [self testImageWithSize:(CGSize){40, 20}];
+    UIImage *croppedImage = [self testImageWithSize:(CGSize){10, 10}];
+    const NSUInteger byteCount = CGImageGetBytesPerRow(croppedImage.CGImage) * CGImageGetHeight(croppedImage.CGImage);
+
+    // Room for two crops, but not three
+    TOCropRenderCache *cache = [[TOCropRenderCache alloc] initWithByteBudget:byteCount * 2 + 1];
+    __block NSInteger renderCount = 0;
+    UIImage *_Nullable (^render)(void) = ^UIImage *{
+        @synchronized (self) {
+            renderCount++;
+        }
+        [NSThread sleepForTimeInterval:0.05];
+        return [self testImageWithSize:(CGSize){10, 10}];
+    };
+
+    // Requests for the same crop on many threads at once wait on a single render
+    NSMutableArray<UIImage *> *results = [NSMutableArray array];
+    dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        UIImage *result = [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:0 circular:NO renderBlock:render];
+        @synchronized (results) {
+            [results addObject:result];
+        }
+    });
+    XCTAssertEqual(renderCount, 1);
+    XCTAssertEqual(results.count, 8u);
+    for (UIImage *result in results) {
+        XCTAssertTrue(result == results.firstObject);
+    }
+    XCTAssertEqual(cache.missCount, 1u);
+    XCTAssertEqual(cache.hitCount, 7u);
+    XCTAssertEqual(cache.byteCount, byteCount);
+
+    // The angle, circular clip and scaled size are all part of the key
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:90 circular:NO renderBlock:render];
+    XCTAssertEqual(renderCount, 2);
+    XCTAssertEqual(cache.count, 2u);
+
+    // Using the first crop again makes the 90° one the least recently used, so it's the one evicted
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:0 circular:NO renderBlock:render];
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:0 circular:YES renderBlock:render];
+    XCTAssertEqual(renderCount, 3);
+    XCTAssertEqual(cache.count, 2u);
+    XCTAssertLessThanOrEqual(cache.byteCount, cache.byteBudget);
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:0 circular:NO renderBlock:render];
+    XCTAssertEqual(renderCount, 3);
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:90 circular:NO renderBlock:render];
+    XCTAssertEqual(renderCount, 4);
+
+    // Scaled crops are kept apart from the full size one
+    [cache croppedImageForImage:image frame:(CGRect){0, 0, 10, 10} angle:90 circular:NO
+                      pixelSize:(CGSize){5, 5} filter:TOCropViewResamplingFilterBilinear renderBlock:render];
+    XCTAssertEqual(renderCount, 5);
+
+    // A render that returns nothing (eg, because it was cancelled) isn't cached
+    UIImage *cancelled = [cache croppedImageForImage:image frame:(CGRect){1, 1, 10, 10} angle:0 circular:NO renderBlock:^UIImage *{
+        return nil;
+    }];
+    XCTAssertNil(cancelled);
+    XCTAssertEqual(cache.count, 2u);
+
+    // Lowering the budget lets go of crops straight away
+    cache.byteBudget = 0;
+    XCTAssertEqual(cache.count, 0u);
+    XCTAssertEqual(cache.byteCount, 0u);
+}
+
+- (void)testMemoryAccountantEvictsCachesThenPreviewsToStayUnderItsLimit {
+    TOCropMemoryAccountant *accountant = [[TOCropMemoryAccountant alloc] init];
+    TOCropMemoryAllocation *image = [accountant addAllocationWithName:@"Image" byteCount:100
+                                                             priority:TOCropMemoryPriorityRequired evictionHandler:nil];
+
+    __block TOCropMemoryAllocation *cache = nil;
+    XCTestExpectation *cacheEvicted = [self expectationWithDescription:@"Cache evicted"];
+    cache = [accountant addAllocationWithName:@"Cache" byteCount:50 priority:TOCropMemoryPriorityCache evictionHandler:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [cache remove];
+        cache = nil;
+        [cacheEvicted fulfill];
+    }];
+
+    __block TOCropMemoryAllocation *preview = nil;
+    XCTestExpectation *previewEvicted = [self expectationWithDescription:@"Preview evicted"];
+    preview = [accountant addAllocationWithName:@"Preview" byteCount:30 priority:TOCropMemoryPriorityPreview evictionHandler:^{
+        [preview remove];
+        preview = nil;
+        [previewEvicted fulfill];
+    }];
+    XCTAssertEqual(accountant.byteCount, 180u);
+    XCTAssertEqual(accountant.peakByteCount, 180u);
+
+    // Going over the limit evicts the cache first, which is enough on its own
+    accountant.byteLimit = 150;
+    [self waitForExpectations:@[cacheEvicted] timeout:1.0];
+    XCTAssertEqual(accountant.byteCount, 130u);
+    XCTAssertEqual(accountant.evictionCount, 1u);
+
+    // A new cache can't evict the preview or the image to make room, so it isn't let in
+    XCTAssertNil([accountant addAllocationWithName:@"Cache" byteCount:40 priority:TOCropMemoryPriorityCache evictionHandler:nil]);
+    XCTAssertEqual(accountant.byteCount, 130u);
+
+    // But a new preview can take the place of the older one
+    XCTestExpectation *newPreviewEvicted = [self expectationWithDescription:@"New preview evicted"];
+    __block TOCropMemoryAllocation *newPreview = nil;
+    newPreview = [accountant addAllocationWithName:@"Preview" byteCount:40 priority:TOCropMemoryPriorityPreview evictionHandler:^{
+        [newPreview remove];
+        newPreview = nil;
+        [newPreviewEvicted fulfill];
+    }];
+    XCTAssertNotNil(newPreview);
+    [self waitForExpectations:@[previewEvicted] timeout:1.0];
+    XCTAssertEqual(accountant.byteCount, 140u);
+
+    // Memory pressure evicts everything that isn't required
+    [accountant evictReclaimableAllocations];
+    [self waitForExpectations:@[newPreviewEvicted] timeout:1.0];
+    XCTAssertEqual(accountant.byteCount, 100u);
+    XCTAssertEqual(accountant.peakByteCount, 180u);
+    [accountant resetPeakByteCount];
+    XCTAssertEqual(accountant.peakByteCount, 100u);
+
+    // Allocations stop being counted when they're deallocated
+    @autoreleasepool {
+        TOCropMemoryAllocation *snapshot = [accountant addAllocationWithName:@"Snapshot" byteCount:500
+                                                                    priority:TOCropMemoryPriorityRequired evictionHandler:nil];
+        XCTAssertEqual(snapshot.byteCount, 500u);
+        XCTAssertEqual(accountant.byteCount, 600u);
+    }
+    XCTAssertEqual(accountant.byteCount, 100u);
+    [image remove];
+    XCTAssertEqual(accountant.byteCount, 0u);
+}
+
+- (void)testCommittingCropRendersImageInTheBackground {
+    TOCropViewController *controller = [[TOCropViewController alloc] initWithImage:[self testImageWithSize:(CGSize){40, 20}]];
+    controller.view.frame = (CGRect){0, 0, 320, 480};
+    [controller.view layoutIfNeeded];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Cropped image delivered"];
+    __block UIImage *croppedImage = nil;
+    controller.onDidCropToRect = ^(UIImage *image, CGRect cropRect, NSInteger angle) {
+        croppedImage = image;
+        [expectation fulfill];
+    };
+
+    // The image arrives in a later run loop pass, from the job the controller exposes
+    [controller commitCurrentCrop];
+    XCTAssertNil(croppedImage);
+    XCTAssertNotNil(controller.cropRenderJob);
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    XCTAssertNotNil(croppedImage);
+    XCTAssertNil(controller.cropRenderJob);
+}
+
+- (void)testSpeculativeRenderIsUsedOnlyWhenTheCropHasSettled {
+    TOCropViewController *controller = [[TOCropViewController alloc] initWithImage:[self testImageWithSize:(CGSize){40, 20}]];
+    controller.speculativeRenderingEnabled = YES;
+    controller.view.frame = (CGRect){0, 0, 320, 480};
+    [controller.view layoutIfNeeded];
+    id<TOCropViewDelegate> cropViewDelegate = (id<TOCropViewDelegate>)controller;
+
+    __block XCTestExpectation *expectation = nil;
+    controller.onDidCropToRect = ^(UIImage *image, CGRect cropRect, NSInteger angle) {
+        [expectation fulfill];
+    };
+    void (^commitAndWait)(void) = ^{
+        expectation = [self expectationWithDescription:@"Cropped image delivered"];
+        [controller commitCurrentCrop];
+        [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    };
+
+    // Once the crop settles, tapping 'Done' picks up the render already underway
+    [cropViewDelegate cropViewDidEndEditing:controller.cropView];
+    commitAndWait();
+    XCTAssertEqual(controller.speculativeRenderHitCount, 1u);
+    XCTAssertEqual(controller.speculativeRenderMissCount, 0u);
+
+    // Each render is only used once
+    commitAndWait();
+    XCTAssertEqual(controller.speculativeRenderMissCount, 1u);
+
+    // And a new edit throws away the render from before it
+    [cropViewDelegate cropViewDidEndEditing:controller.cropView];
+    [cropViewDelegate cropViewDidBeginEditing:controller.cropView];
+    commitAndWait();
+    XCTAssertEqual(controller.speculativeRenderHitCount, 1u);
+    XCTAssertEqual(controller.speculativeRenderMissCount, 2u);
+}
+
+- (void)testMipmapLevelsAverageEachBlockOfPixels {
+    // Odd sizes, so the vector loops hand their last few pixels over to the scalar path
+    for (size_t width = 1; width < 40; width += 3) {
+        TOCropPixelBuffer source, destination;
+        XCTAssertTrue(TOCropPixelBufferAllocate(&source, width, 7));
+        for (size_t i = 0; i < source.bytesPerRow * source.height; i++) {
+            source.data[i] = (uint8_t)((i * 37) ^ (i >> 3));
+        }
+        const size_t outputWidth = MAX(width / 2, 1);
+        XCTAssertTrue(TOCropPixelBufferAllocate(&destination, outputWidth, 3));
+        XCTAssertTrue(TOCropPixelBufferDownsample(&source, 0, &destination));
+
+        for (size_t y = 0; y < 3; y++) {
+            for (size_t x = 0; x < outputWidth; x++) {
+                const size_t x0 = x * 2, x1 = MIN(x0 + 1, width - 1);
+                const uint8_t *top = source.data + (y * 2) * source.bytesPerRow;
+                const uint8_t *bottom = top + source.bytesPerRow;
+                for (size_t c = 0; c < 4; c++) {
+                    const unsigned sum = top[x0 * 4 + c] + top[x1 * 4 + c] + bottom[x0 * 4 + c] + bottom[x1 * 4 + c];
+                    XCTAssertEqual(destination.data[y * destination.bytesPerRow + x * 4 + c], (uint8_t)((sum + 2) / 4));
+                }
+            }
+        }
+        TOCropPixelBufferFree(&source);
+        TOCropPixelBufferFree(&destination);
+    }
+
+    // Levels halve down to the minimum size, and are picked by how much they're scaled down
+    TOCropPixelBuffer source;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 1000, 600));
+    TOCropMipmapPyramid pyramid;
+    XCTAssertTrue(TOCropMipmapPyramidBuild(&source, 100, 0, &pyramid));
+    XCTAssertEqual(pyramid.count, 5u);
+    XCTAssertEqual(pyramid.levels[4].width, 62u);
+    XCTAssertEqual(pyramid.levels[4].height, 37u);
+    XCTAssertEqual(TOCropMipmapLevelForScale(1.0, pyramid.count), 0u);
+    XCTAssertEqual(TOCropMipmapLevelForScale(0.6, pyramid.count), 0u);
+    XCTAssertEqual(TOCropMipmapLevelForScale(0.5, pyramid.count), 1u);
+    XCTAssertEqual(TOCropMipmapLevelForScale(0.2, pyramid.count), 2u);
+    XCTAssertEqual(TOCropMipmapLevelForScale(0.001, pyramid.count), 4u);
+    TOCropMipmapPyramidFree(&pyramid);
+    TOCropPixelBufferFree(&source);
+
+    // As images, every level is drawn at the same size in points
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 2.0f;
+    format.preferredRange = UIGraphicsImageRendererFormatRangeStandard;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){300, 200} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor redColor] setFill];
+            [context fillRect:(CGRect){0, 0, 300, 200}];
+        }];
+    NSArray<UIImage *> *levels = [image mipmapImagesWithMinimumPixelSize:64];
+    XCTAssertGreaterThan(levels.count, 2u);
+    XCTAssertEqual(levels.firstObject, image);
+    for (UIImage *level in levels) {
+        XCTAssertEqualWithAccuracy(level.size.width, image.size.width, image.size.width * 0.05f);
+        XCTAssertEqualWithAccuracy(level.size.height, image.size.height, image.size.height * 0.05f);
+    }
+}
+
+- (void)testBackdropBlurKeepsFlatColorsAndSpreadsPointsEvenly {
+    // Three boxes of widths 19, 19 and 21 have close to the variance of a Gaussian with a sigma of 10
+    size_t radii[TOCropBlurPassCount];
+    TOCropBlurBoxRadiiForSigma(10.0, radii);
+    XCTAssertEqual(radii[0], 9u);
+    XCTAssertEqual(radii[1], 9u);
+    XCTAssertEqual(radii[2], 10u);
+
+    // Edges repeat, so a flat color stays exactly as it is, apart from being darkened
+    TOCropPixelBuffer flat;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&flat, 37, 23));
+    memset(flat.data, 200, flat.bytesPerRow * flat.height);
+    XCTAssertTrue(TOCropPixelBufferBlur(&flat, 6.0, 0.5, 0));
+    for (size_t y = 0; y < flat.height; y++) {
+        for (size_t i = 0; i < flat.width * 4; i++) {
+            XCTAssertEqual(flat.data[y * flat.bytesPerRow + i], 100);
+        }
+    }
+    TOCropPixelBufferFree(&flat);
+
+    // A single point spreads out the same way in every direction, whatever the number of threads
+    TOCropPixelBuffer points[2];
+    for (size_t i = 0; i < 2; i++) {
+        XCTAssertTrue(TOCropPixelBufferAllocate(&points[i], 41, 41));
+        memset(points[i].data, 0, points[i].bytesPerRow * points[i].height);
+        memset(points[i].data + 20 * points[i].bytesPerRow + 20 * 4, 255, 4);
+        XCTAssertTrue(TOCropPixelBufferBlur(&points[i], 2.0, 1.0, i == 0 ? 1 : 4));
+    }
+    const uint8_t *row = points[0].data + 20 * points[0].bytesPerRow;
+    XCTAssertLessThan(row[20 * 4], 255);
+    for (size_t k = 1; k < 8; k++) {
+        XCTAssertEqual(row[(20 - k) * 4], row[(20 + k) * 4]);
+        XCTAssertEqual(points[0].data[(20 - k) * points[0].bytesPerRow + 20 * 4], points[0].data[(20 + k) * points[0].bytesPerRow + 20 * 4]);
+        XCTAssertLessThanOrEqual(row[(20 + k) * 4], row[(20 + k - 1) * 4]);
+    }
+    for (size_t y = 0; y < 41; y++) {
+        XCTAssertEqual(memcmp(points[0].data + y * points[0].bytesPerRow, points[1].data + y * points[1].bytesPerRow, 41 * 4), 0);
+    }
+    TOCropPixelBufferFree(&points[0]);
+    TOCropPixelBufferFree(&points[1]);
+
+    // The backdrop is small in pixels, but drawn at the same size in points as the image
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 2.0f;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){300, 200} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor whiteColor] setFill];
+            [context fillRect:(CGRect){0, 0, 300, 200}];
+        }];
+    UIImage *backdropImage = [image backdropImageWithMaximumPixelSize:64 blurRadius:10.0f brightness:0.5f];
+    XCTAssertNotNil(backdropImage);
+    XCTAssertEqual(CGImageGetWidth(backdropImage.CGImage), 64u);
+    XCTAssertEqual(CGImageGetHeight(backdropImage.CGImage), 43u);
+    XCTAssertEqualWithAccuracy(backdropImage.size.width, 300.0f, 0.01f);
+    XCTAssertEqualWithAccuracy(backdropImage.size.height, 200.0f, 2.0f);
+}
+
+- (void)testTileCacheKeepsTheMostRecentlyUsedVisibleTiles {
+    // A 1000x600 level splits into 4x3 tiles, with the last row and column cut short
+    const TOCropTileGrid grid = {1000, 600, 256};
+    XCTAssertEqual(TOCropTileGridColumns(grid), 4u);
+    XCTAssertEqual(TOCropTileGridRows(grid), 3u);
+    const TOCropPixelRect corner = TOCropTileGridRectForTile(grid, 3, 2);
+    XCTAssertEqual(corner.x, 768u);
+    XCTAssertEqual(corner.width, 232u);
+    XCTAssertEqual(corner.height, 88u);
+
+    TOCropTileRange range = TOCropTileRangeForRect(grid, 300, 10, 300, 246);
+    XCTAssertEqual(range.minX, 1u);
+    XCTAssertEqual(range.maxX, 3u);
+    XCTAssertEqual(range.minY, 0u);
+    XCTAssertEqual(range.maxY, 1u);
+    range = TOCropTileRangeForRect(grid, 900, 500, 500, 500);
+    XCTAssertEqual(range.minX, 3u);
+    XCTAssertEqual(range.maxY, 3u);
+    range = TOCropTileRangeForRect(grid, -50, -50, 10, 10);
+    XCTAssertEqual(range.minX, range.maxX);
+
+    // Prefetching grows the range towards the pan, but never past the edge of the grid
+    range = TOCropTileRangeForRect(grid, 300, 10, 300, 246);
+    TOCropTileRange prefetch = TOCropTileRangeExtend(grid, range, 1, -1);
+    XCTAssertEqual(prefetch.maxX, 4u);
+    XCTAssertEqual(prefetch.minY, 0u);
+    XCTAssertEqual(prefetch.minX, 1u);
+    prefetch = TOCropTileRangeExtend(grid, range, -1, 1);
+    XCTAssertEqual(prefetch.minX, 0u);
+    XCTAssertEqual(prefetch.maxY, 2u);
+
+    // With room for three tiles, adding a fourth evicts whichever was used longest ago
+    TOCropTileCache *cache = TOCropTileCacheCreate(300, NULL);
+    for (uint32_t x = 0; x < 3; x++) {
+        XCTAssertTrue(TOCropTileCacheInsert(cache, (TOCropTileKey){0, x, 0}, (void *)(uintptr_t)(x + 1), 100));
+    }
+    XCTAssertEqual(TOCropTileCacheGet(cache, (TOCropTileKey){0, 0, 0}), (void *)1);
+    XCTAssertTrue(TOCropTileCacheInsert(cache, (TOCropTileKey){0, 3, 0}, (void *)4, 100));
+    XCTAssertEqual(TOCropTileCacheGet(cache, (TOCropTileKey){0, 1, 0}), NULL);
+    XCTAssertEqual(TOCropTileCacheGet(cache, (TOCropTileKey){0, 0, 0}), (void *)1);
+    XCTAssertEqual(TOCropTileCacheByteCount(cache), 300u);
+
+    // A tile bigger than the whole budget is turned away rather than emptying the cache
+    XCTAssertFalse(TOCropTileCacheInsert(cache, (TOCropTileKey){1, 0, 0}, (void *)5, 400));
+    XCTAssertEqual(TOCropTileCacheCount(cache), 3u);
+    TOCropTileCacheSetByteBudget(cache, 100);
+    XCTAssertEqual(TOCropTileCacheCount(cache), 1u);
+    XCTAssertEqual(TOCropTileCacheGet(cache, (TOCropTileKey){0, 0, 0}), (void *)1);
+    TOCropTileCacheDestroy(cache);
+
+    // The view only renders and shows the tiles covering the visible region
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat new];
+    format.scale = 1.0f;
+    UIImage *image = [[[UIGraphicsImageRenderer alloc] initWithSize:(CGSize){600, 400} format:format]
+        imageWithActions:^(UIGraphicsImageRendererContext *context) {
+            [[UIColor blueColor] setFill];
+            [context fillRect:(CGRect){0, 0, 600, 400}];
+        }];
+    TOCropTiledImageView *tiledImageView = [[TOCropTiledImageView alloc] initWithImages:@[image]];
+    tiledImageView.frame = (CGRect){0, 0, 300, 200};
+    [tiledImageView updateTilesForVisibleRect:(CGRect){0, 0, 150, 100} level:0];
+
+    NSPredicate *rendered = [NSPredicate predicateWithFormat:@"visibleTileCount == 2"];
+    [self waitForExpectations:@[[[XCTNSPredicateExpectation alloc] initWithPredicate:rendered object:tiledImageView]]
+                      timeout:10.0];
+    XCTAssertEqual(tiledImageView.cachedTileCount, 2u);
+    NSMutableSet<NSValue *> *tileFrames = [NSMutableSet set];
+    for (CALayer *layer in tiledImageView.layer.sublayers) {
+        [tileFrames addObject:[NSValue valueWithCGRect:layer.frame]];
+    }
+    XCTAssertTrue([tileFrames containsObject:[NSValue valueWithCGRect:(CGRect){0, 0, 128, 128}]]);
+    XCTAssertTrue([tileFrames containsObject:[NSValue valueWithCGRect:(CGRect){128, 0, 128, 128}]]);
+
+    [tiledImageView hideTiles];
+    XCTAssertEqual(tiledImageView.visibleTileCount, 0u);
+    XCTAssertEqual(tiledImageView.cachedTileCount, 2u);
+}
+
+- (void)testCropGeometryIsWorkedOutWithoutTheCropView {
+    // A 4000x3000 photo fitted into a portrait phone's content bounds
+    const TOCropRect contentBounds = {{14, 14}, {347, 639}};
+    const TOCropSize imageSize = {4000, 3000};
+    const TOCropInitialLayout initial = TOCropGeometryInitialLayout(contentBounds, imageSize, (TOCropSize){0, 0}, 15);
+    XCTAssertEqualWithAccuracy(initial.minimumZoomScale, 0.08675, 0.00001);
+    XCTAssertEqualWithAccuracy(initial.maximumZoomScale, 0.08675 * 15, 0.0001);
+    XCTAssertFalse(initial.centersContent);
+    XCTAssertEqual(initial.cropBoxFrame.origin.y, 203);
+    XCTAssertEqual(initial.cropBoxFrame.size.width, 347);
+    XCTAssertEqual(initial.cropBoxFrame.size.height, 260);
+
+    // A square crop box is narrower than the image, so the image is centered behind it
+    const TOCropInitialLayout square = TOCropGeometryInitialLayout(contentBounds, imageSize, (TOCropSize){1, 1}, 15);
+    XCTAssertTrue(square.centersContent);
+    XCTAssertEqual(square.cropBoxFrame.size.width, square.cropBoxFrame.size.height);
+    XCTAssertEqual(square.contentOffset.x, 44);
+
+    TOCropLayout layout = {0};
+    layout.bounds = (TOCropRect){{0, 0}, {375, 667}};
+    layout.contentBounds = contentBounds;
+    layout.imageSize = imageSize;
+    layout.cropBoxFrame = initial.cropBoxFrame;
+    layout.contentSize = initial.contentSize;
+    layout.zoomScale = layout.minimumZoomScale = initial.minimumZoomScale;
+    layout.maximumZoomScale = initial.maximumZoomScale;
+    layout.contentInset = TOCropGeometryContentInsetForCropBox(layout.bounds, layout.cropBoxFrame);
+    layout.contentOffset = (TOCropPoint){-layout.contentInset.left, -layout.contentInset.top};
+    XCTAssertEqual(layout.contentInset.top, 203);
+    XCTAssertEqual(layout.contentInset.bottom, 204);
+
+    // Zoomed all the way out, the crop box covers the whole image
+    const TOCropRect imageCropFrame = TOCropGeometryImageCropFrame(&layout);
+    XCTAssertEqual(imageCropFrame.origin.x, 0);
+    XCTAssertEqual(imageCropFrame.size.width, 4000);
+
+    // Touches near the crop box pick the edge or corner under them
+    XCTAssertEqual(TOCropGeometryEdgeForPoint(layout.cropBoxFrame, (TOCropPoint){14, 268}), TOCropEdgeLeft);
+    XCTAssertEqual(TOCropGeometryEdgeForPoint(layout.cropBoxFrame, (TOCropPoint){361, 400}), TOCropEdgeRight);
+    XCTAssertEqual(TOCropGeometryEdgeForPoint(layout.cropBoxFrame, (TOCropPoint){200, 333}), TOCropEdgeNone);
+
+    // Dragging the top left corner moves it by whole points, down to the minimum size
+    TOCropResize resize = {TOCropEdgeTopLeft, layout.cropBoxFrame, {14, 268}, 14, false, 0};
+    TOCropRect frame = TOCropGeometryResizeCropBox(&layout, &resize, (TOCropPoint){64.3, 318});
+    XCTAssertEqual(frame.origin.x, 65);
+    XCTAssertEqual(frame.origin.y, 253);
+    XCTAssertEqual(frame.size.width, 296);
+    XCTAssertEqual(frame.size.height, 210);
+    frame = TOCropGeometryResizeCropBox(&layout, &resize, (TOCropPoint){400, 600});
+    XCTAssertEqual(frame.size.width, TOCropGeometryMinimumBoxSize);
+    XCTAssertEqual(frame.size.height, TOCropGeometryMinimumBoxSize);
+    XCTAssertEqual(frame.origin.x + frame.size.width, 361); // Pinned to the opposite edge
+
+    // With the aspect ratio locked, both sides shrink together
+    resize.aspectRatioLocked = true;
+    frame = TOCropGeometryResizeCropBox(&layout, &resize, (TOCropPoint){64, 268});
+    XCTAssertEqualWithAccuracy(frame.size.width / frame.size.height, 347.0 / 260.0, 0.01);
+
+    // Crop boxes are clamped inside the content bounds, and empty ones are ignored
+    TOCropRect clamped;
+    XCTAssertTrue(TOCropGeometryClampCropBox(contentBounds, (TOCropRect){{0, 20.5}, {500, 100.7}}, &clamped));
+    XCTAssertEqual(clamped.origin.x, 14);
+    XCTAssertEqual(clamped.origin.y, 20);
+    XCTAssertEqual(clamped.size.width, 347);
+    XCTAssertEqual(clamped.size.height, 100);
+    XCTAssertFalse(TOCropGeometryClampCropBox(contentBounds, (TOCropRect){{0, 0}, {0, 10}}, &clamped));
+
+    // Restoring a region zooms in until it fills the content bounds
+    TOCropLayoutUpdate update = TOCropGeometryLayoutForImageCropFrame(&layout, (TOCropRect){{1000, 1000}, {1000, 1000}});
+    XCTAssertEqualWithAccuracy(update.zoomScale, 0.347, 0.0001);
+    XCTAssertEqual(update.cropBoxFrame.size.width, 347);
+    XCTAssertEqual(update.contentOffset.x, 333);
+
+    // A square aspect ratio narrows the box around its center, and re-centering scales it back up
+    bool zoomOut = true;
+    update = TOCropGeometryLayoutForAspectRatio(&layout, (TOCropSize){1, 1}, true, &zoomOut);
+    XCTAssertFalse(zoomOut);
+    XCTAssertEqual(update.cropBoxFrame.size.width, 260);
+    XCTAssertEqual(update.contentOffset.x, layout.contentOffset.x + 43.5);
+
+    TOCropLayout squared = layout;
+    squared.cropBoxFrame = update.cropBoxFrame;
+    XCTAssertTrue(TOCropGeometryCenterCropBox(&squared, &update));
+    XCTAssertEqual(update.cropBoxFrame.size.width, 347);
+    XCTAssertEqualWithAccuracy(update.zoomScale, layout.zoomScale * update.scale, 0.000001);
+
+    // A crop box that already fills the content bounds leaves the zoom exactly as it was
+    XCTAssertTrue(TOCropGeometryCenterCropBox(&layout, &update));
+    XCTAssertEqual(update.scale, 1.0);
+    XCTAssertEqual(update.zoomScale, layout.zoomScale);
+}
+
+- (void)testCropGeometryResizePerTouchSample {
+    TOCropLayout layout = {0};
+    layout.bounds = (TOCropRect){{0, 0}, {375, 667}};
+    layout.contentBounds = (TOCropRect){{14, 14}, {347, 639}};
+    layout.cropBoxFrame = (TOCropRect){{14, 203}, {347, 260}};
+    const TOCropResize resize = {TOCropEdgeTopLeft, layout.cropBoxFrame, {14, 203}, 14, false, 0};
+
+    // A thousand drags of a hundred touch samples each
+    [self measureBlock:^{
+        double total = 0;
+        for (NSInteger i = 0; i < 100000; i++) {
+            const TOCropPoint point = {14 + (i % 200), 203 + (i % 300)};
+            total += TOCropGeometryResizeCropBox(&layout, &resize, point).size.width;
+        }
+        XCTAssertGreaterThan(total, 0);
+    }];
+}
+
+- (void)testLayoutTransactionWritesEachPropertyOnce {
+    // Changing the aspect ratio sets the crop box twice, zooms and scrolls twice over, but
+    // commits as one: at most each scroll view property, the crop box views and the foreground
+    TOCropView *cropView = [self cropViewWithImageSize:(CGSize){400, 300}];
+    [cropView setAspectRatio:(CGSize){1.0f, 1.0f} animated:NO];
+    XCTAssertFalse(cropView.scrollView.layoutTransactionOpen);
+    XCTAssertGreaterThan(cropView.scrollView.committedPropertyWriteCount, 0u);
+    XCTAssertLessThanOrEqual(cropView.scrollView.committedPropertyWriteCount, 6u);
+    XCTAssertLessThanOrEqual(cropView.layoutCommitWriteCount, 8u);
+    XCTAssertEqualWithAccuracy(cropView.cropBoxFrame.size.width, cropView.cropBoxFrame.size.height, 1.0);
+
+    // Inside a transaction, reads return the pending values, and only the outermost commit applies them
+    TOCropScrollView *scrollView = [[TOCropScrollView alloc] initWithFrame:(CGRect){0, 0, 100, 100}];
+    scrollView.contentSize = (CGSize){400, 400};
+    [scrollView beginLayoutTransaction];
+    scrollView.contentOffset = (CGPoint){10, 0};
+    scrollView.contentOffset = (CGPoint){20, 30};
+    scrollView.contentSize = (CGSize){400, 400};
+    XCTAssertEqual(scrollView.contentOffset.y, 30.0);
+
+    [scrollView beginLayoutTransaction];
+    [scrollView commitLayoutTransaction];
+    XCTAssertTrue(scrollView.layoutTransactionOpen);
+
+    [scrollView commitLayoutTransaction];
+    XCTAssertFalse(scrollView.layoutTransactionOpen);
+    XCTAssertEqual(scrollView.contentOffset.x, 20.0);
+    XCTAssertEqual(scrollView.contentOffset.y, 30.0);
+    XCTAssertEqual(scrollView.committedPropertyWriteCount, 1u, @"the unchanged content size shouldn't be written");
+}
+
+- (void)testLayoutTransactionZoomMovesContentOffset {
+    TOCropTestZoomingDelegate *delegate = [TOCropTestZoomingDelegate new];
+    delegate.zoomingView = [[UIView alloc] initWithFrame:(CGRect){0, 0, 400, 400}];
+
+    TOCropScrollView *scrollView = [[TOCropScrollView alloc] initWithFrame:(CGRect){0, 0, 100, 100}];
+    scrollView.contentInsetAdjustmentBehavior = UIScrollViewContentInsetAdjustmentNever;
+    scrollView.delegate = delegate;
+    [scrollView addSubview:delegate.zoomingView];
+    scrollView.contentSize = (CGSize){400, 400};
+    scrollView.contentInset = (UIEdgeInsets){10, 20, 10, 20};
+    scrollView.minimumZoomScale = 0.1f;
+    scrollView.maximumZoomScale = 1.0f;
+    scrollView.contentOffset = (CGPoint){300, 300};
+
+    // Zooming out until the content is smaller than the scroll view has to pull the offset back
+    // inside it, and that has to be visible before the commit, not only after it
+    [scrollView beginLayoutTransaction];
+    scrollView.zoomScale = 0.1f;
+    XCTAssertEqualWithAccuracy(scrollView.contentSize.width, 40.0, 0.001);
+    XCTAssertEqualWithAccuracy(scrollView.contentOffset.x, -20.0, 0.001);
+    XCTAssertEqualWithAccuracy(scrollView.contentOffset.y, -10.0, 0.001);
+    const CGPoint pendingOffset = scrollView.contentOffset;
+    [scrollView commitLayoutTransaction];
+
+    XCTAssertEqualWithAccuracy(scrollView.contentOffset.x, pendingOffset.x, 0.001);
+    XCTAssertEqualWithAccuracy(scrollView.contentOffset.y, pendingOffset.y, 0.001);
+}
+
+- (void)testRecordedTraceReplaysToTheSameCrop {
+    TOCropView *cropView = [self cropViewWithImageSize:(CGSize){400, 300}];
+    XCTAssertNil([cropView stopRecordingInteractionTrace]);
+
+    [cropView startRecordingInteractionTrace];
+    [cropView setAspectRatio:(CGSize){16.0f, 9.0f} animated:NO];
+    [cropView rotateImageNinetyDegreesAnimated:NO clockwise:YES completion:nil];
+    NSData *trace = [cropView stopRecordingInteractionTrace];
+    XCTAssertNotNil(trace);
+
+    // Replaying through the geometry alone should land on the same crop box as the view did
+    TOCropTraceReplayResult result;
+    XCTAssertTrue(TOCropTraceReplay(trace.bytes, trace.length, 10, &result));
+    XCTAssertEqual(result.eventCount, 2u);
+    XCTAssertEqualWithAccuracy(result.finalLayout.cropBoxFrame.origin.x, CGRectGetMinX(cropView.cropBoxFrame), 1.0);
+    XCTAssertEqualWithAccuracy(result.finalLayout.cropBoxFrame.origin.y, CGRectGetMinY(cropView.cropBoxFrame), 1.0);
+    XCTAssertEqualWithAccuracy(result.finalLayout.cropBoxFrame.size.width, CGRectGetWidth(cropView.cropBoxFrame), 1.0);
+    XCTAssertEqualWithAccuracy(result.finalLayout.cropBoxFrame.size.height, CGRectGetHeight(cropView.cropBoxFrame), 1.0);
+    XCTAssertLessThanOrEqual(result.medianEventTime, result.p99EventTime);
+
+    // The same trace always checksums the same, and a truncated one is rejected
+    TOCropTraceReplayResult again;
+    XCTAssertTrue(TOCropTraceReplay(trace.bytes, trace.length, 1, &again));
+    XCTAssertEqual(result.checksum, again.checksum);
+    XCTAssertFalse(TOCropTraceReplay(trace.bytes, trace.length - 1, 1, &again));
+}
+
+- (void)testOverlayLinesAreGeneratedWithoutAnyViews {
+    // Thirds leave three equal rows and columns once the pixel-thick lines are taken out
+    TOCropOverlayStyle style = {TOCropOverlayGridThirds, 3, true, true, 0.5};
+    TOCropOverlayLine lines[TOCropOverlayMaximumLineCount];
+    const size_t count = TOCropOverlayGenerateLines((TOCropSize){300, 200}, &style, lines);
+    XCTAssertEqual(count, 16u);
+    XCTAssertEqual(lines[0].kind, TOCropOverlayLineBorder);
+    XCTAssertEqual(lines[4].kind, TOCropOverlayLineCorner);
+    XCTAssertEqual(lines[12].kind, TOCropOverlayLineGrid);
+    XCTAssertEqualWithAccuracy(lines[12].rect.origin.y, 66.3333, 0.001);
+    XCTAssertEqualWithAccuracy(lines[13].rect.origin.y, 133.1667, 0.001);
+    XCTAssertEqualWithAccuracy(lines[15].rect.origin.x, 199.8333, 0.001);
+
+    // Other densities only change the grid
+    TOCropOverlayLine uniformLines[TOCropOverlayMaximumLineCount];
+    style.gridStyle = TOCropOverlayGridUniform;
+    style.gridDivisions = 5;
+    XCTAssertEqual(TOCropOverlayGenerateLines((TOCropSize){300, 200}, &style, uniformLines), 20u);
+    XCTAssertEqualWithAccuracy(uniformLines[12].rect.origin.y, 39.6, 0.001);
+    TOCropRect dirtyRect = TOCropOverlayDirtyRect(lines, count, uniformLines, 20, TOCropOverlayLineBorder | TOCropOverlayLineCorner);
+    XCTAssertEqual(dirtyRect.size.width, 0.0);
+    dirtyRect = TOCropOverlayDirtyRect(lines, count, uniformLines, 20, TOCropOverlayLineGrid);
+    XCTAssertEqualWithAccuracy(dirtyRect.size.width, 300.0, 0.001);
+
+    // Narrowing the box leaves the left border alone, but moves the right side
+    TOCropOverlayLine narrowLines[TOCropOverlayMaximumLineCount];
+    style.gridStyle = TOCropOverlayGridThirds;
+    TOCropOverlayGenerateLines((TOCropSize){250, 200}, &style, narrowLines);
+    dirtyRect = TOCropOverlayDirtyRect(lines, count, narrowLines, count, TOCropOverlayLineCorner);
+    XCTAssertEqual(dirtyRect.origin.x, 230.0);
+    XCTAssertEqual(dirtyRect.size.width, 73.0);
+
+    // The overlay view draws all of it without a single subview
+    TOCropOverlayView *overlayView = [[TOCropOverlayView alloc] initWithFrame:(CGRect){0, 0, 300, 200}];
+    overlayView.gridStyle = TOCropViewGridStyleGoldenRatio;
+    XCTAssertEqual(overlayView.subviews.count, 0u);
+    XCTAssertTrue([overlayView.layer isKindOfClass:[CAShapeLayer class]]);
+    const CGRect outline = CGPathGetBoundingBox(((CAShapeLayer *)overlayView.layer).path);
+    XCTAssertTrue(CGRectEqualToRect(outline, (CGRect){-3, -3, 306, 206}));
+}
+
+- (void)testToolbarIconsAreSlicedFromPrerasterizedAtlases {
+    for (size_t a = 0; a < TOCropToolbarIconAtlasScaleCount; a++) {
+        const TOCropToolbarIconAtlas *atlas = &TOCropToolbarIconAtlases[a];
+        XCTAssertEqual(TOCropToolbarIconAtlasForScale(atlas->scale), atlas);
+        NSMutableData *coverage = [NSMutableData dataWithLength:(size_t)atlas->width * atlas->height];
+        XCTAssertTrue(TOCropToolbarIconAtlasUnpack(atlas, coverage.mutableBytes));
+        const uint8_t *pixels = coverage.bytes;
+
+        // Every icon fits in the atlas at its size in points, without overlapping any other
+        for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+            const TOCropToolbarIconSlice slice = atlas->slices[i];
+            XCTAssertEqual(slice.width, atlas->pointWidths[i] * atlas->scale);
+            XCTAssertEqual(slice.height, atlas->pointHeights[i] * atlas->scale);
+            XCTAssertLessThanOrEqual(slice.x + slice.width, atlas->width);
+            XCTAssertLessThanOrEqual(slice.y + slice.height, atlas->height);
+            for (size_t j = 0; j < i; j++) {
+                const TOCropToolbarIconSlice other = atlas->slices[j];
+                XCTAssertFalse(CGRectIntersectsRect((CGRect){slice.x, slice.y, slice.width, slice.height},
+                                                    (CGRect){other.x, other.y, other.width, other.height}));
+            }
+        }
+
+        // The clamp icon's three boxes are drawn at their own opacities
+        const TOCropToolbarIconSlice clamp = atlas->slices[TOCropToolbarIconClamp];
+        const size_t scale = atlas->scale;
+        XCTAssertEqual(pixels[(clamp.y + 9 * scale) * atlas->width + clamp.x + 6 * scale], 255);
+        XCTAssertEqual(pixels[(clamp.y + 1 * scale) * atlas->width + clamp.x + 5 * scale], 141);
+        XCTAssertEqual(pixels[(clamp.y + 9 * scale) * atlas->width + clamp.x + 15 * scale], 197);
+
+        // And rotating clockwise is a mirror image of rotating counterclockwise
+        const TOCropToolbarIconSlice left = atlas->slices[TOCropToolbarIconRotateCounterclockwise];
+        const TOCropToolbarIconSlice right = atlas->slices[TOCropToolbarIconRotateClockwise];
+        for (size_t y = 0; y < left.height; y++) {
+            for (size_t x = 0; x < left.width; x++) {
+                XCTAssertEqualWithAccuracy(pixels[(left.y + y) * atlas->width + left.x + x],
+                                           pixels[(right.y + y) * atlas->width + right.x + right.width - 1 - x], 8);
+            }
+        }
+    }
+
+    // A truncated atlas is rejected rather than read past its end
+    TOCropToolbarIconAtlas truncatedAtlas = TOCropToolbarIconAtlases[0];
+    truncatedAtlas.packedLength -= 1;
+    NSMutableData *coverage = [NSMutableData dataWithLength:(size_t)truncatedAtlas.width * truncatedAtlas.height];
+    XCTAssertFalse(TOCropToolbarIconAtlasUnpack(&truncatedAtlas, coverage.mutableBytes));
+
+    UIImage *resetImage = [TOCropToolbar iconImage:TOCropToolbarIconReset];
+    XCTAssertTrue(CGSizeEqualToSize(resetImage.size, (CGSize){22, 18}));
+    XCTAssertEqual(resetImage.scale, TOCropToolbarIconAtlasForScale(UIScreen.mainScreen.scale)->scale);
+}
+
+- (void)testStraighteningFitsTheCropInsideTheTurnedImage {
+    // Straightening by no angle at all is an exact copy, and any angle comes out the same on any number of threads
+    TOCropPixelBuffer source, singleThreaded, multiThreaded;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 64, 48));
+    TOCropFillPixelBufferWithIndices(&source);
+    const TOCropPixelRect rect = {8, 4, 40, 30};
+    XCTAssertTrue(TOCropPixelBufferAllocate(&singleThreaded, rect.width, rect.height));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&multiThreaded, rect.width, rect.height));
+    for (TOCropInterpolation interpolation = TOCropInterpolationBilinear; interpolation <= TOCropInterpolationBicubic; interpolation++) {
+        XCTAssertTrue(TOCropStraightenRegion(&source, rect, TOCropPixelOrientationIdentity(), 0.0, interpolation, 1, NULL, &singleThreaded));
+        for (size_t y = 0; y < rect.height; y++) {
+            XCTAssertEqual(memcmp(singleThreaded.data + y * singleThreaded.bytesPerRow,
+                                  source.data + (rect.y + y) * source.bytesPerRow + rect.x * 4, rect.width * 4), 0);
+        }
+
+        XCTAssertTrue(TOCropStraightenRegion(&source, rect, TOCropPixelOrientationIdentity(), 7.3, interpolation, 1, NULL, &singleThreaded));
+        XCTAssertTrue(TOCropStraightenRegion(&source, rect, TOCropPixelOrientationIdentity(), 7.3, interpolation, 4, NULL, &multiThreaded));
+        XCTAssertEqual(memcmp(singleThreaded.data, multiThreaded.data, singleThreaded.bytesPerRow * singleThreaded.height), 0);
+    }
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&singleThreaded);
+    TOCropPixelBufferFree(&multiThreaded);
+
+    // Angles are clamped, and rounded to a tenth of a degree
+    XCTAssertEqualWithAccuracy(TOCropGeometryClampStraighteningAngle(12.345), 12.3, 0.0001);
+    XCTAssertEqual(TOCropGeometryClampStraighteningAngle(-90.0), -45.0);
+    XCTAssertEqual(TOCropGeometryClampStraighteningAngle(NAN), 0.0);
+
+    // The largest crop, and any crop fitted into the image, has all four corners inside the turned image
+    const TOCropSize imageSize = {400, 300};
+    for (double angle = -45.0; angle <= 45.0; angle += 2.5) {
+        const double radians = angle * (M_PI / 180.0);
+        const TOCropRect frames[] = {
+            TOCropGeometryLargestStraightenedRect(imageSize, angle),
+            TOCropGeometryFitRectInStraightenedImage(imageSize, angle, (TOCropRect){{0, 0}, imageSize}),
+            TOCropGeometryFitRectInStraightenedImage(imageSize, angle, (TOCropRect){{250, 10}, {140, 80}}),
+        };
+        for (size_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+            for (NSInteger corner = 0; corner < 4; corner++) {
+                const double x = frames[i].origin.x + ((corner & 1) ? frames[i].size.width : 0.0) - 200.0;
+                const double y = frames[i].origin.y + ((corner & 2) ? frames[i].size.height : 0.0) - 150.0;
+                XCTAssertLessThanOrEqual(fabs(x * cos(radians) + y * sin(radians)), 200.0 + 0.001);
+                XCTAssertLessThanOrEqual(fabs(-x * sin(radians) + y * cos(radians)), 150.0 + 0.001);
+            }
+        }
+    }
+
+    // The crop view shrinks the crop as the image turns, and gives back the original one when it's turned back
+    TOCropView *cropView = [self cropViewWithImageSize:(CGSize){400, 300}];
+    const CGRect originalFrame = cropView.imageCropFrame;
+    cropView.straighteningAngle = 10.04;
+    XCTAssertEqualWithAccuracy(cropView.straighteningAngle, 10.0, 0.0001);
+    XCTAssertTrue(cropView.canBeReset);
+    XCTAssertLessThan(CGRectGetWidth(cropView.imageCropFrame), CGRectGetWidth(originalFrame));
+    XCTAssertLessThan(CGRectGetHeight(cropView.imageCropFrame), CGRectGetHeight(originalFrame));
+    cropView.straighteningAngle = -20.0;
+    cropView.straighteningAngle = 0.0;
+    XCTAssertEqualWithAccuracy(CGRectGetWidth(cropView.imageCropFrame), CGRectGetWidth(originalFrame), 1.0);
+    XCTAssertEqualWithAccuracy(CGRectGetHeight(cropView.imageCropFrame), CGRectGetHeight(originalFrame), 1.0);
+
+    // And the cropped image is straightened too, at the same size as the crop
+    UIImage *image = [self testImageWithSize:(CGSize){400, 300}];
+    UIImage *straightenedImage = [image croppedImageWithFrame:(CGRect){100, 100, 120, 80} angle:0
+                                           straighteningAngle:5.0 circularClip:NO];
+    XCTAssertTrue(CGSizeEqualToSize(straightenedImage.size, (CGSize){120, 80}));
+}
+
+- (void)testPerspectiveCorrectionFlattensTheQuadrilateral {
+    // The flattened rect's corners land on the quad's corners, and its sides are the longer of each pair
+    const TOCropQuad quad = {{10, 20}, {300, 5}, {280, 250}, {30, 200}};
+    XCTAssertTrue(TOCropGeometryQuadIsConvex(quad));
+    const TOCropSize outputSize = TOCropGeometryPerspectiveOutputSize(quad);
+    XCTAssertEqualWithAccuracy(outputSize.width, hypot(290.0, 15.0), 0.001);
+    XCTAssertEqualWithAccuracy(outputSize.height, hypot(20.0, 245.0), 0.001);
+
+    TOCropHomography homography;
+    XCTAssertTrue(TOCropGeometryHomographyForQuad(quad, outputSize, &homography));
+    const TOCropPoint flattenedCorners[] = {{0, 0}, {outputSize.width, 0}, {outputSize.width, outputSize.height}, {0, outputSize.height}};
+    const TOCropPoint quadCorners[] = {quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft};
+    for (size_t i = 0; i < 4; i++) {
+        const TOCropPoint point = TOCropGeometryApplyHomography(&homography, flattenedCorners[i]);
+        XCTAssertEqualWithAccuracy(point.x, quadCorners[i].x, 0.001);
+        XCTAssertEqualWithAccuracy(point.y, quadCorners[i].y, 0.001);
+    }
+
+    // A corner dragged out of bounds stops at the edge, and one dragged across the quad doesn't move
+    const TOCropRect bounds = {{0, 0}, {320, 260}};
+    const TOCropQuad clampedQuad = TOCropGeometryMoveQuadCorner(quad, TOCropEdgeTopRight, (TOCropPoint){400, -50}, bounds);
+    XCTAssertEqual(clampedQuad.topRight.x, 320.0);
+    XCTAssertEqual(clampedQuad.topRight.y, 0.0);
+    const TOCropQuad crossedQuad = TOCropGeometryMoveQuadCorner(quad, TOCropEdgeTopLeft, (TOCropPoint){290, 240}, bounds);
+    XCTAssertEqual(crossedQuad.topLeft.x, quad.topLeft.x);
+    XCTAssertEqual(crossedQuad.topLeft.y, quad.topLeft.y);
+
+    // Flattening the whole image is an exact copy, and any quad comes out the same on any number of threads
+    TOCropPixelBuffer source, singleThreaded, multiThreaded;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 150, 130));
+    TOCropFillPixelBufferWithIndices(&source);
+    XCTAssertTrue(TOCropPixelBufferAllocate(&singleThreaded, 150, 130));
+    XCTAssertTrue(TOCropGeometryHomographyForQuad(TOCropGeometryQuadWithRect((TOCropRect){{0, 0}, {150, 130}}),
+                                                  (TOCropSize){150, 130}, &homography));
+    XCTAssertTrue(TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, TOCropInterpolationBicubic,
+                                        1, NULL, &singleThreaded));
+    XCTAssertEqual(memcmp(singleThreaded.data, source.data, source.bytesPerRow * source.height), 0);
+    TOCropPixelBufferFree(&singleThreaded);
+
+    const TOCropQuad skewedQuad = {{-10, 5}, {140, 12}, {120, 125}, {8, 100}};
+    const TOCropSize skewedSize = TOCropGeometryPerspectiveOutputSize(skewedQuad);
+    const size_t width = (size_t)round(skewedSize.width), height = (size_t)round(skewedSize.height);
+    XCTAssertTrue(TOCropGeometryHomographyForQuad(skewedQuad, (TOCropSize){width, height}, &homography));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&singleThreaded, width, height));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&multiThreaded, width, height));
+    for (TOCropInterpolation interpolation = TOCropInterpolationBilinear; interpolation <= TOCropInterpolationBicubic; interpolation++) {
+        XCTAssertTrue(TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, interpolation, 1, NULL, &singleThreaded));
+        XCTAssertTrue(TOCropWarpPerspective(&source, TOCropPixelOrientationIdentity(), homography.m, interpolation, 4, NULL, &multiThreaded));
+        XCTAssertEqual(memcmp(singleThreaded.data, multiThreaded.data, singleThreaded.bytesPerRow * singleThreaded.height), 0);
+    }
+
+    // The part of the quad hanging off the image's left edge is transparent
+    XCTAssertEqual(TOCropPixelAt(&singleThreaded, 0, 0), 0u);
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&singleThreaded);
+    TOCropPixelBufferFree(&multiThreaded);
+
+    // The crop view starts the quadrilateral on the crop, ignores concave ones, and puts it back when reset
+    TOCropView *cropView = [self cropViewWithImageSize:(CGSize){400, 300}];
+    cropView.perspectiveCorrectionEnabled = YES;
+    XCTAssertTrue(TOCropQuadrilateralEqualToQuadrilateral(cropView.cropQuadrilateral,
+                                                          TOCropQuadrilateralMakeWithRect(cropView.imageCropFrame)));
+    XCTAssertFalse(cropView.canBeReset);
+    TOCropQuadrilateral quadrilateral = cropView.cropQuadrilateral;
+    quadrilateral.topLeft = (CGPoint){40, 30};
+    cropView.cropQuadrilateral = quadrilateral;
+    XCTAssertTrue(CGPointEqualToPoint(cropView.cropQuadrilateral.topLeft, (CGPoint){40, 30}));
+    XCTAssertTrue(cropView.canBeReset);
+    quadrilateral.topLeft = (CGPoint){390, 290};
+    cropView.cropQuadrilateral = quadrilateral;
+    XCTAssertTrue(CGPointEqualToPoint(cropView.cropQuadrilateral.topLeft, (CGPoint){40, 30}));
+    [cropView resetLayoutToDefaultAnimated:NO];
+    XCTAssertFalse(cropView.canBeReset);
+
+    // And the flattened image is as large as the region's longer sides
+    UIImage *image = [self testImageWithSize:(CGSize){400, 300}];
+    UIImage *flattenedImage = [image perspectiveCorrectedImageWithQuadrilateral:TOCropQuadrilateralMakeWithRect((CGRect){100, 100, 120, 80})
+                                                                          angle:0
+                                                             straighteningAngle:0.0f];
+    XCTAssertTrue(CGSizeEqualToSize(flattenedImage.size, (CGSize){120, 80}));
+}
+
+- (void)testTiledRenderingPerformance {
+    // A 12MP photo turned a quarter turn, spread over one thread per core
+    TOCropPixelBuffer source;
+    __block TOCropPixelBuffer destination;
+    XCTAssertTrue(TOCropPixelBufferAllocate(&source, 4032, 3024));
+    XCTAssertTrue(TOCropPixelBufferAllocate(&destination, 3024, 4032));
+    memset(source.data, 0x7f, source.bytesPerRow * source.height);
+
+    const TOCropPixelRect rect = {0, 0, 3024, 4032};
+    const TOCropPixelOrientation orientation = TOCropPixelOrientationForQuarterTurns(1);
+    [self measureBlock:^{
+        XCTAssertTrue(TOCropRenderRegion(&source, rect, orientation,
+                                         (TOCropTiledRenderOptions){false, 0, 0, NULL}, &destination));
+    }];
+
+    TOCropPixelBufferFree(&source);
+    TOCropPixelBufferFree(&destination);
+}
+
 @end
@@ -27,6 +27,8 @@
 // name is unambiguous. The shared headers themselves keep quoted imports, with the
 // module verifier's quoted-include diagnostic disabled on the framework targets.
 #if __has_include(<CropViewController/TOCropViewController.h>)
+#import <CropViewController/TOCropBatchProcessor.h>
+#import <CropViewController/TOCropRenderJob.h>
 #import <CropViewController/TOCropToolbar.h>
 #import <CropViewController/TOCropView.h>
 #import <CropViewController/TOCropViewConstants.h>
@@ -34,6 +36,8 @@
 #import <CropViewController/TOCropViewControllerAspectRatioPreset.h>
 #import <CropViewController/UIImage+CropRotate.h>
 #else
+#import "TOCropBatchProcessor.h"
+#import "TOCropRenderJob.h"
 #import "TOCropToolbar.h"
 #import "TOCropView.h"
 #import "TOCropViewConstants.h"
@@ -39,6 +39,41 @@ public typealias CropViewControllerToolbarPosition = TOCropViewControllerToolbar
  */
 public typealias CropViewCroppingStyle = TOCropViewCroppingStyle
 
+/**
+ The filter used when scaling a cropped image to a new size (ie box, bilinear or Lanczos)
+ */
+public typealias CropViewResamplingFilter = TOCropViewResamplingFilter
+
+/**
+ How the grid overlaid on the crop box divides it up (ie thirds, the golden ratio, or a number of equal rows and columns)
+ */
+public typealias CropViewGridStyle = TOCropViewGridStyle
+
+/**
+ Applies one crop to a whole batch of image files, decoding, cropping and encoding them in overlapping stages
+ */
+public typealias CropBatchProcessor = TOCropBatchProcessor
+
+/**
+ Holds on to recently rendered crops, so the same crop of the same image is only rendered once (ie for a preview, then the share sheet)
+ */
+public typealias CropRenderCache = TOCropRenderCache
+
+/**
+ Counts the large buffers alive across the crop pipeline, and evicts caches and previews when they go over a limit or memory runs short
+ */
+public typealias CropMemoryAccountant = TOCropMemoryAccountant
+
+/**
+ How much a buffer counted by the memory accountant is needed (ie a cache, a preview, or required)
+ */
+public typealias CropMemoryPriority = TOCropMemoryPriority
+
+/**
+ The four corners of a region of an image to flatten into a rectangle (ie a page photographed at an angle)
+ */
+public typealias CropQuadrilateral = TOCropQuadrilateral
+
 // ------------------------------------------------
 /// @name Delegate
 // ------------------------------------------------
@@ -169,6 +204,33 @@ open class CropViewController: UIViewController, TOCropViewControllerDelegate {
         get { return toCropViewController.angle }
     }
     
+    /**
+     The angle the image is straightened by after `angle`, in degrees, such as to level a tilted horizon.
+     Clockwise is positive. Clamped to ±45 degrees, in steps of 0.1.
+     */
+    public var straighteningAngle: CGFloat {
+        set { toCropViewController.straighteningAngle = newValue }
+        get { return toCropViewController.straighteningAngle }
+    }
+    
+    /**
+     Let the user drag the four corners of `cropQuadrilateral` over the image, and flatten the region
+     inside it into a rectangle when cropping. Has no effect in the circular cropping style. (Default is false)
+     */
+    public var perspectiveCorrectionEnabled: Bool {
+        set { toCropViewController.perspectiveCorrectionEnabled = newValue }
+        get { return toCropViewController.perspectiveCorrectionEnabled }
+    }
+    
+    /**
+     In the coordinate space of the image, the corners of the region flattened while
+     `perspectiveCorrectionEnabled` is on.
+     */
+    public var cropQuadrilateral: CropQuadrilateral {
+        set { toCropViewController.cropQuadrilateral = newValue }
+        get { return toCropViewController.cropQuadrilateral }
+    }
+    
     /**
      The cropping style of this particular crop view controller
      */
@@ -0,0 +1,546 @@
+//
+//  TOCropIconAtlasGenerator.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Rasterizes the toolbar's icons (`TOCropToolbarIconPaths.c`) at 1x, 2x and 3x, packs each
+// scale into one atlas, and writes them out as C source to be compiled into the library. The
+// toolbar then only has to slice the icons out at launch, rather than drawing their paths.
+// It only uses the C standard library, so it builds and runs anywhere, including on Linux:
+//
+//   cc -O2 -std=gnu99 -I Objective-C/TOCropViewController/Rendering -o crop-icon-atlas-generator
+//      Tools/TOCropIconAtlasGenerator.c Tools/TOCropToolbarIconPaths.c -lm
+//
+//   ./crop-icon-atlas-generator > Objective-C/TOCropViewController/Rendering/TOCropToolbarIconAtlasData.c
+//
+// Run it again after changing any of the paths, and commit the regenerated file with them.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TOCropToolbarIconAtlas.h"
+#include "TOCropToolbarIconPaths.h"
+
+// The sub-pixel samples taken along each side of a pixel, to work out how much of it is covered
+#define kTOCropIconSamplesPerSide 8
+
+// The straight lines each curve is split into
+#define kTOCropIconCurveSegments 32
+
+// Strokes with sharper corners than this are beveled rather than mitered (the Core Graphics default)
+#define kTOCropIconMiterLimit 10.0
+
+// Empty pixels left between icons in the atlas
+#define kTOCropIconAtlasPadding 1
+
+#define kTOCropIconMaximumPoints 1024
+#define kTOCropIconMaximumContours 16
+#define kTOCropIconMaximumPolygons 512
+
+#pragma mark - Paths -
+
+typedef struct {
+    double x;
+    double y;
+} TOCropIconPoint;
+
+typedef struct {
+    size_t start;  // The index of the first point in the path's points
+    size_t count;
+    int closed;
+} TOCropIconContour;
+
+typedef struct {
+    TOCropIconPoint points[kTOCropIconMaximumPoints];
+    size_t pointCount;
+    TOCropIconContour contours[kTOCropIconMaximumContours];
+    size_t contourCount;
+} TOCropIconPath;
+
+// A set of closed polygons. A point is covered when its winding number around any one of the
+// groups of polygons (filled paths are a single group, strokes are a group per segment and join)
+// isn't zero, which unions each piece of a stroke instead of letting overlaps cancel out.
+typedef struct {
+    TOCropIconPoint points[kTOCropIconMaximumPoints * 4];
+    size_t pointCount;
+    size_t starts[kTOCropIconMaximumPolygons];  // Where each polygon's points start
+    size_t counts[kTOCropIconMaximumPolygons];
+    size_t groups[kTOCropIconMaximumPolygons];  // Which group each polygon belongs to
+    size_t polygonCount;
+    size_t groupCount;
+} TOCropIconShape;
+
+static void TOCropIconFail(const char *message) {
+    fprintf(stderr, "crop-icon-atlas-generator: %s\n", message);
+    exit(1);
+}
+
+static void TOCropIconPathAddPoint(TOCropIconPath *path, TOCropIconPoint point) {
+    if (path->pointCount == kTOCropIconMaximumPoints || path->contourCount == 0) {
+        TOCropIconFail("a path has too many points, or doesn't start with a move");
+    }
+    path->points[path->pointCount++] = point;
+    path->contours[path->contourCount - 1].count++;
+}
+
+static void TOCropIconPathMoveTo(TOCropIconPath *path, TOCropIconPoint point) {
+    if (path->contourCount == kTOCropIconMaximumContours) {
+        TOCropIconFail("a path has too many contours");
+    }
+    path->contours[path->contourCount++] = (TOCropIconContour){path->pointCount, 0, 0};
+    TOCropIconPathAddPoint(path, point);
+}
+
+static void TOCropIconShapeBeginPolygon(TOCropIconShape *shape, size_t group) {
+    if (shape->polygonCount == kTOCropIconMaximumPolygons) {
+        TOCropIconFail("a shape has too many polygons");
+    }
+    shape->starts[shape->polygonCount] = shape->pointCount;
+    shape->counts[shape->polygonCount] = 0;
+    shape->groups[shape->polygonCount] = group;
+    shape->polygonCount++;
+    if (group + 1 > shape->groupCount) {
+        shape->groupCount = group + 1;
+    }
+}
+
+static void TOCropIconShapeAddPoint(TOCropIconShape *shape, TOCropIconPoint point) {
+    if (shape->pointCount == kTOCropIconMaximumPoints * 4) {
+        TOCropIconFail("a shape has too many points");
+    }
+    shape->points[shape->pointCount++] = point;
+    shape->counts[shape->polygonCount - 1]++;
+}
+
+// Every contour of a filled path is wound together, so holes work the way they do in Core Graphics
+static void TOCropIconShapeFill(TOCropIconShape *shape, const TOCropIconPath *path) {
+    for (size_t c = 0; c < path->contourCount; c++) {
+        TOCropIconShapeBeginPolygon(shape, 0);
+        for (size_t i = 0; i < path->contours[c].count; i++) {
+            TOCropIconShapeAddPoint(shape, path->points[path->contours[c].start + i]);
+        }
+    }
+}
+
+static TOCropIconPoint TOCropIconOffset(TOCropIconPoint point, TOCropIconPoint normal, double distance) {
+    return (TOCropIconPoint){point.x + normal.x * distance, point.y + normal.y * distance};
+}
+
+static void TOCropIconShapeStroke(TOCropIconShape *shape, const TOCropIconPath *path, double lineWidth) {
+    const double halfWidth = lineWidth * 0.5;
+    for (size_t c = 0; c < path->contourCount; c++) {
+        const TOCropIconContour *contour = &path->contours[c];
+        const TOCropIconPoint *points = path->points + contour->start;
+
+        // Drop repeated points, which have no direction to stroke along
+        TOCropIconPoint line[kTOCropIconMaximumPoints];
+        size_t count = 0;
+        for (size_t i = 0; i < contour->count; i++) {
+            if (count == 0 || points[i].x != line[count - 1].x || points[i].y != line[count - 1].y) {
+                line[count++] = points[i];
+            }
+        }
+        if (contour->closed && count > 1 && line[0].x == line[count - 1].x && line[0].y == line[count - 1].y) {
+            count--;
+        }
+        if (count < 2) {
+            continue;
+        }
+
+        // Each segment is a rectangle, with its ends cut off square at the points (butt caps)
+        const size_t segmentCount = contour->closed ? count : count - 1;
+        TOCropIconPoint normals[kTOCropIconMaximumPoints];
+        for (size_t i = 0; i < segmentCount; i++) {
+            const TOCropIconPoint a = line[i], b = line[(i + 1) % count];
+            const double length = hypot(b.x - a.x, b.y - a.y);
+            normals[i] = (TOCropIconPoint){-(b.y - a.y) / length, (b.x - a.x) / length};
+
+            TOCropIconShapeBeginPolygon(shape, shape->groupCount);
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(a, normals[i], halfWidth));
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(b, normals[i], halfWidth));
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(b, normals[i], -halfWidth));
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(a, normals[i], -halfWidth));
+        }
+
+        // Then the gap on the outside of each corner is filled in with a miter, or a bevel if it's too sharp
+        const size_t firstJoin = contour->closed ? 0 : 1;
+        for (size_t j = firstJoin; j < count && (contour->closed || j < count - 1); j++) {
+            const TOCropIconPoint n1 = normals[(j + segmentCount - 1) % segmentCount];
+            const TOCropIconPoint n2 = normals[j % segmentCount];
+            const double turn = n1.x * n2.y - n1.y * n2.x;
+            if (fabs(turn) < 1e-9) {
+                continue;
+            }
+
+            const double side = (turn > 0.0) ? -1.0 : 1.0;
+            const TOCropIconPoint point = line[j];
+            TOCropIconShapeBeginPolygon(shape, shape->groupCount);
+            TOCropIconShapeAddPoint(shape, point);
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(point, n1, side * halfWidth));
+
+            TOCropIconPoint bisector = {n1.x + n2.x, n1.y + n2.y};
+            const double bisectorLength = hypot(bisector.x, bisector.y);
+            if (bisectorLength > 1e-9) {
+                bisector.x /= bisectorLength;
+                bisector.y /= bisectorLength;
+                const double cosine = bisector.x * n1.x + bisector.y * n1.y;
+                if (cosine > 1.0 / kTOCropIconMiterLimit) {
+                    TOCropIconShapeAddPoint(shape, TOCropIconOffset(point, bisector, side * halfWidth / cosine));
+                }
+            }
+
+            TOCropIconShapeAddPoint(shape, TOCropIconOffset(point, n2, side * halfWidth));
+        }
+    }
+}
+
+#pragma mark - Rasterizing -
+
+static int TOCropIconWindingNumber(const TOCropIconPoint *points, size_t count, TOCropIconPoint point) {
+    int winding = 0;
+    for (size_t i = 0; i < count; i++) {
+        const TOCropIconPoint a = points[i], b = points[(i + 1) % count];
+        const double side = (b.x - a.x) * (point.y - a.y) - (point.x - a.x) * (b.y - a.y);
+        if (a.y <= point.y) {
+            if (b.y > point.y && side > 0.0) { winding++; }
+        } else if (b.y <= point.y && side < 0.0) {
+            winding--;
+        }
+    }
+    return winding;
+}
+
+static int TOCropIconShapeContainsPoint(const TOCropIconShape *shape, TOCropIconPoint point) {
+    for (size_t group = 0; group < shape->groupCount; group++) {
+        int winding = 0;
+        for (size_t p = 0; p < shape->polygonCount; p++) {
+            if (shape->groups[p] == group) {
+                winding += TOCropIconWindingNumber(shape->points + shape->starts[p], shape->counts[p], point);
+            }
+        }
+        if (winding != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Composites a shape over an icon's coverage, the same as drawing it in white with `alpha`
+static void TOCropIconDrawShape(const TOCropIconShape *shape, double alpha, unsigned int scale,
+                                double *coverage, size_t width, size_t height) {
+    if (shape->pointCount == 0) {
+        return;
+    }
+
+    // Pixels outside the shape's bounds aren't touched at all
+    double minX = shape->points[0].x, minY = shape->points[0].y, maxX = minX, maxY = minY;
+    for (size_t i = 1; i < shape->pointCount; i++) {
+        minX = fmin(minX, shape->points[i].x);
+        minY = fmin(minY, shape->points[i].y);
+        maxX = fmax(maxX, shape->points[i].x);
+        maxY = fmax(maxY, shape->points[i].y);
+    }
+    const size_t firstX = (size_t)fmax(floor(minX * scale), 0.0), lastX = (size_t)fmin(ceil(maxX * scale), width);
+    const size_t firstY = (size_t)fmax(floor(minY * scale), 0.0), lastY = (size_t)fmin(ceil(maxY * scale), height);
+
+    const int samples = kTOCropIconSamplesPerSide;
+    for (size_t y = firstY; y < lastY; y++) {
+        for (size_t x = firstX; x < lastX; x++) {
+            int covered = 0;
+            for (int sy = 0; sy < samples; sy++) {
+                for (int sx = 0; sx < samples; sx++) {
+                    const TOCropIconPoint point = {((double)x + (sx + 0.5) / samples) / scale,
+                                                   ((double)y + (sy + 0.5) / samples) / scale};
+                    covered += TOCropIconShapeContainsPoint(shape, point);
+                }
+            }
+
+            const double source = alpha * covered / (samples * samples);
+            coverage[y * width + x] = source + coverage[y * width + x] * (1.0 - source);
+        }
+    }
+}
+
+static void TOCropIconRasterize(const TOCropIconPathIcon *icon, unsigned int scale, double *coverage,
+                                size_t width, size_t height) {
+    static TOCropIconPath path;
+    static TOCropIconShape shape;
+    memset(&path, 0, sizeof(path));
+
+    for (size_t i = 0; i < icon->commandCount; i++) {
+        const TOCropIconPathCommand *command = &icon->commands[i];
+        const float *v = command->values;
+        const double mirror = icon->mirrored ? -1.0 : 1.0;
+        const double offset = icon->mirrored ? icon->width : 0.0;
+        #define TOCROP_ICON_POINT(x, y) ((TOCropIconPoint){offset + mirror * (x), (y)})
+
+        switch (command->type) {
+            case TOCropIconPathMove:
+                TOCropIconPathMoveTo(&path, TOCROP_ICON_POINT(v[0], v[1]));
+                break;
+            case TOCropIconPathLine:
+                TOCropIconPathAddPoint(&path, TOCROP_ICON_POINT(v[0], v[1]));
+                break;
+            case TOCropIconPathCurve: {
+                if (path.pointCount == 0) {
+                    TOCropIconFail("a curve doesn't start with a move");
+                }
+                const TOCropIconPoint p0 = path.points[path.pointCount - 1];
+                const TOCropIconPoint p1 = TOCROP_ICON_POINT(v[0], v[1]);
+                const TOCropIconPoint p2 = TOCROP_ICON_POINT(v[2], v[3]);
+                const TOCropIconPoint p3 = TOCROP_ICON_POINT(v[4], v[5]);
+                for (int s = 1; s <= kTOCropIconCurveSegments; s++) {
+                    const double t = (double)s / kTOCropIconCurveSegments, u = 1.0 - t;
+                    const double a = u * u * u, b = 3.0 * u * u * t, c = 3.0 * u * t * t, d = t * t * t;
+                    TOCropIconPathAddPoint(&path, (TOCropIconPoint){a * p0.x + b * p1.x + c * p2.x + d * p3.x,
+                                                                    a * p0.y + b * p1.y + c * p2.y + d * p3.y});
+                }
+                break;
+            }
+            case TOCropIconPathRect:
+                TOCropIconPathMoveTo(&path, TOCROP_ICON_POINT(v[0], v[1]));
+                TOCropIconPathAddPoint(&path, TOCROP_ICON_POINT(v[0] + v[2], v[1]));
+                TOCropIconPathAddPoint(&path, TOCROP_ICON_POINT(v[0] + v[2], v[1] + v[3]));
+                TOCropIconPathAddPoint(&path, TOCROP_ICON_POINT(v[0], v[1] + v[3]));
+                path.contours[path.contourCount - 1].closed = 1;
+                break;
+            case TOCropIconPathClose:
+                if (path.contourCount > 0) {
+                    path.contours[path.contourCount - 1].closed = 1;
+                }
+                break;
+            case TOCropIconPathFill:
+            case TOCropIconPathStroke:
+                memset(&shape, 0, sizeof(shape));
+                if (command->type == TOCropIconPathFill) {
+                    TOCropIconShapeFill(&shape, &path);
+                } else {
+                    TOCropIconShapeStroke(&shape, &path, v[0]);
+                }
+                TOCropIconDrawShape(&shape, command->type == TOCropIconPathFill ? v[0] : v[1], scale,
+                                    coverage, width, height);
+                memset(&path, 0, sizeof(path));
+                break;
+        }
+        #undef TOCROP_ICON_POINT
+    }
+}
+
+#pragma mark - Packing -
+
+typedef struct {
+    unsigned int scale;
+    size_t width;
+    size_t height;
+    uint8_t *coverage;
+    TOCropToolbarIconSlice slices[TOCropToolbarIconCount];
+} TOCropIconAtlas;
+
+// Lays the icons out in rows (tallest first), and returns the height needed for the given width
+static size_t TOCropIconAtlasPack(const size_t *order, const size_t *widths, const size_t *heights, size_t width,
+                                  TOCropToolbarIconSlice *slices) {
+    size_t x = 0, y = 0, rowHeight = 0;
+    for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+        const size_t icon = order[i];
+        if (x > 0 && x + widths[icon] > width) {
+            y += rowHeight + kTOCropIconAtlasPadding;
+            x = 0;
+            rowHeight = 0;
+        }
+        slices[icon] = (TOCropToolbarIconSlice){(uint16_t)x, (uint16_t)y, (uint16_t)widths[icon], (uint16_t)heights[icon]};
+        x += widths[icon] + kTOCropIconAtlasPadding;
+        rowHeight = (heights[icon] > rowHeight) ? heights[icon] : rowHeight;
+    }
+    return y + rowHeight;
+}
+
+static void TOCropIconAtlasBuild(unsigned int scale, TOCropIconAtlas *atlas) {
+    size_t widths[TOCropToolbarIconCount], heights[TOCropToolbarIconCount], order[TOCropToolbarIconCount];
+    size_t widest = 0, totalWidth = 0;
+    for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+        widths[i] = (size_t)ceil(TOCropToolbarIconPaths[i].width * scale);
+        heights[i] = (size_t)ceil(TOCropToolbarIconPaths[i].height * scale);
+        widest = (widths[i] > widest) ? widths[i] : widest;
+        totalWidth += widths[i] + kTOCropIconAtlasPadding;
+        order[i] = i;
+    }
+
+    // Tallest first, so each row wastes as little height as possible
+    for (size_t i = 1; i < TOCropToolbarIconCount; i++) {
+        for (size_t j = i; j > 0 && heights[order[j]] > heights[order[j - 1]]; j--) {
+            const size_t swap = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = swap;
+        }
+    }
+
+    // Then try every width the atlas could be, and keep the one with the smallest area
+    size_t bestArea = (size_t)-1;
+    for (size_t width = widest; width <= totalWidth; width++) {
+        TOCropToolbarIconSlice slices[TOCropToolbarIconCount];
+        const size_t height = TOCropIconAtlasPack(order, widths, heights, width, slices);
+        size_t usedWidth = 0;
+        for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+            const size_t right = slices[i].x + slices[i].width;
+            usedWidth = (right > usedWidth) ? right : usedWidth;
+        }
+        if (usedWidth * height < bestArea) {
+            bestArea = usedWidth * height;
+            atlas->width = usedWidth;
+            atlas->height = height;
+            memcpy(atlas->slices, slices, sizeof(slices));
+        }
+    }
+
+    atlas->scale = scale;
+    atlas->coverage = calloc(atlas->width * atlas->height, 1);
+    if (atlas->coverage == NULL) {
+        TOCropIconFail("couldn't allocate an atlas");
+    }
+
+    for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+        const TOCropToolbarIconSlice slice = atlas->slices[i];
+        double *coverage = calloc((size_t)slice.width * slice.height, sizeof(double));
+        if (coverage == NULL) {
+            TOCropIconFail("couldn't allocate an icon");
+        }
+        TOCropIconRasterize(&TOCropToolbarIconPaths[i], scale, coverage, slice.width, slice.height);
+
+        for (size_t y = 0; y < slice.height; y++) {
+            for (size_t x = 0; x < slice.width; x++) {
+                const double value = round(coverage[y * slice.width + x] * 255.0);
+                atlas->coverage[(slice.y + y) * atlas->width + slice.x + x] = (uint8_t)(value > 255.0 ? 255.0 : value);
+            }
+        }
+        free(coverage);
+    }
+}
+
+#pragma mark - Output -
+
+// Compresses bytes with PackBits, the run-length encoding `TOCropToolbarIconAtlasUnpack` reads.
+// Returns the packed length. `packed` needs room for at least length + length / 128 + 1 bytes.
+static size_t TOCropIconPackBits(const uint8_t *bytes, size_t length, uint8_t *packed) {
+    size_t written = 0, i = 0;
+    while (i < length) {
+        // Runs of three or more of the same byte are stored as a count and the byte
+        size_t run = 1;
+        while (i + run < length && run < 128 && bytes[i + run] == bytes[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            packed[written++] = (uint8_t)(int8_t)(1 - (int)run);
+            packed[written++] = bytes[i];
+            i += run;
+            continue;
+        }
+
+        // Anything else is copied as it is, up to the start of the next run
+        size_t literal = 0;
+        while (i + literal < length && literal < 128 &&
+               !(i + literal + 2 < length && bytes[i + literal] == bytes[i + literal + 1] &&
+                 bytes[i + literal] == bytes[i + literal + 2])) {
+            literal++;
+        }
+        packed[written++] = (uint8_t)(literal - 1);
+        memcpy(packed + written, bytes + i, literal);
+        written += literal;
+        i += literal;
+    }
+    return written;
+}
+
+static void TOCropIconAtlasWrite(FILE *file, const TOCropIconAtlas *atlases) {
+    fprintf(file,
+            "//\n"
+            "//  TOCropToolbarIconAtlasData.c\n"
+            "//\n"
+            "//  Generated by Tools/TOCropIconAtlasGenerator.c from Tools/TOCropToolbarIconPaths.c.\n"
+            "//  Don't edit this file by hand. Change the paths and run the generator again instead.\n"
+            "//\n\n"
+            "#include \"TOCropToolbarIconAtlas.h\"\n");
+
+    size_t packedLengths[TOCropToolbarIconAtlasScaleCount];
+    for (size_t a = 0; a < TOCropToolbarIconAtlasScaleCount; a++) {
+        const TOCropIconAtlas *atlas = &atlases[a];
+        const size_t length = atlas->width * atlas->height;
+        uint8_t *packed = malloc(length + length / 128 + 1);
+        if (packed == NULL) {
+            TOCropIconFail("couldn't allocate the packed atlas");
+        }
+        packedLengths[a] = TOCropIconPackBits(atlas->coverage, length, packed);
+
+        fprintf(file, "\n// %zux%zu pixels, packed from %zu bytes\nstatic const uint8_t kTOCropToolbarIconAtlas%ux[] = {",
+                atlas->width, atlas->height, length, atlas->scale);
+        for (size_t i = 0; i < packedLengths[a]; i++) {
+            fprintf(file, "%s0x%02x,", (i % 16 == 0) ? "\n    " : " ", packed[i]);
+        }
+        fprintf(file, "\n};\n");
+        free(packed);
+    }
+
+    fprintf(file, "\nconst TOCropToolbarIconAtlas TOCropToolbarIconAtlases[TOCropToolbarIconAtlasScaleCount] = {\n");
+    for (size_t a = 0; a < TOCropToolbarIconAtlasScaleCount; a++) {
+        const TOCropIconAtlas *atlas = &atlases[a];
+        fprintf(file, "    {\n        %u, %zu, %zu, kTOCropToolbarIconAtlas%ux, %zu,\n        {\n",
+                atlas->scale, atlas->width, atlas->height, atlas->scale, packedLengths[a]);
+        for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+            const TOCropToolbarIconSlice slice = atlas->slices[i];
+            fprintf(file, "            {%u, %u, %u, %u}, // %s\n", slice.x, slice.y, slice.width, slice.height,
+                    TOCropToolbarIconPaths[i].name);
+        }
+        fprintf(file, "        },\n        {");
+        for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+            fprintf(file, "%s%.1ff", i > 0 ? ", " : "", TOCropToolbarIconPaths[i].width);
+        }
+        fprintf(file, "},\n        {");
+        for (size_t i = 0; i < TOCropToolbarIconCount; i++) {
+            fprintf(file, "%s%.1ff", i > 0 ? ", " : "", TOCropToolbarIconPaths[i].height);
+        }
+        fprintf(file, "},\n    },\n");
+    }
+    fprintf(file, "};\n");
+}
+
+int main(int argc, char *argv[]) {
+    (void)argv;
+    if (argc > 1) {
+        fprintf(stderr, "usage: %s > TOCropToolbarIconAtlasData.c\n", argv[0]);
+        return 2;
+    }
+    if (TOCropToolbarIconPathCount != TOCropToolbarIconCount) {
+        TOCropIconFail("the paths don't match the icons listed in TOCropToolbarIconAtlas.h");
+    }
+
+    TOCropIconAtlas atlases[TOCropToolbarIconAtlasScaleCount];
+    for (unsigned int a = 0; a < TOCropToolbarIconAtlasScaleCount; a++) {
+        TOCropIconAtlasBuild(a + 1, &atlases[a]);
+    }
+
+    TOCropIconAtlasWrite(stdout, atlases);
+
+    for (size_t a = 0; a < TOCropToolbarIconAtlasScaleCount; a++) {
+        free(atlases[a].coverage);
+    }
+    return 0;
+}
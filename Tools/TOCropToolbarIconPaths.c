@@ -0,0 +1,115 @@
+//
+//  TOCropToolbarIconPaths.c
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TOCropToolbarIconPaths.h"
+
+#define TOCROP_COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+static const TOCropIconPathCommand kTOCropDoneIcon[] = {
+    {TOCropIconPathMove, {1, 7}},
+    {TOCropIconPathLine, {6, 12}},
+    {TOCropIconPathLine, {16, 1}},
+    {TOCropIconPathStroke, {2, 1}},
+};
+
+static const TOCropIconPathCommand kTOCropCancelIcon[] = {
+    {TOCropIconPathMove, {15, 15}},
+    {TOCropIconPathLine, {1, 1}},
+    {TOCropIconPathStroke, {2, 1}},
+
+    {TOCropIconPathMove, {1, 15}},
+    {TOCropIconPathLine, {15, 1}},
+    {TOCropIconPathStroke, {2, 1}},
+};
+
+static const TOCropIconPathCommand kTOCropRotateIcon[] = {
+    // The square being rotated
+    {TOCropIconPathRect, {0, 9, 12, 12}},
+    {TOCropIconPathFill, {1}},
+
+    // The arrow head
+    {TOCropIconPathMove, {5, 3}},
+    {TOCropIconPathLine, {10, 6}},
+    {TOCropIconPathLine, {10, 0}},
+    {TOCropIconPathLine, {5, 3}},
+    {TOCropIconPathClose, {0}},
+    {TOCropIconPathFill, {1}},
+
+    // The arrow's arc
+    {TOCropIconPathMove, {10, 3}},
+    {TOCropIconPathCurve, {15, 3, 17.5f, 5.91f, 17.5f, 11}},
+    {TOCropIconPathStroke, {1, 1}},
+};
+
+static const TOCropIconPathCommand kTOCropResetIcon[] = {
+    // The arc
+    {TOCropIconPathMove, {22, 9}},
+    {TOCropIconPathCurve, {22, 13.97f, 17.97f, 18, 13, 18}},
+    {TOCropIconPathCurve, {13, 17.35f, 13, 16.68f, 13, 16}},
+    {TOCropIconPathCurve, {16.87f, 16, 20, 12.87f, 20, 9}},
+    {TOCropIconPathCurve, {20, 5.13f, 16.87f, 2, 13, 2}},
+    {TOCropIconPathCurve, {10.1f, 2, 7.62f, 3.76f, 6.55f, 6.27f}},
+    {TOCropIconPathCurve, {6.2f, 7.11f, 6, 8.03f, 6, 9}},
+    {TOCropIconPathLine, {4, 9}},
+    {TOCropIconPathCurve, {4, 7.81f, 4.23f, 6.67f, 4.65f, 5.63f}},
+    {TOCropIconPathCurve, {5.28f, 4.08f, 6.32f, 2.74f, 7.65f, 1.76f}},
+    {TOCropIconPathCurve, {9.15f, 0.65f, 11, 0, 13, 0}},
+    {TOCropIconPathCurve, {17.97f, 0, 22, 4.03f, 22, 9}},
+    {TOCropIconPathClose, {0}},
+    {TOCropIconPathFill, {1}},
+
+    // The arrow head
+    {TOCropIconPathMove, {5, 15}},
+    {TOCropIconPathLine, {10, 9}},
+    {TOCropIconPathLine, {0, 9}},
+    {TOCropIconPathLine, {5, 15}},
+    {TOCropIconPathClose, {0}},
+    {TOCropIconPathFill, {1}},
+};
+
+static const TOCropIconPathCommand kTOCropClampIcon[] = {
+    // The crop box
+    {TOCropIconPathRect, {0, 3, 13, 13}},
+    {TOCropIconPathFill, {1}},
+
+    // The outer box, along the top and side
+    {TOCropIconPathRect, {0, 0, 22, 2}},
+    {TOCropIconPathFill, {0.553f}},
+    {TOCropIconPathRect, {19, 2, 3, 14}},
+    {TOCropIconPathFill, {0.553f}},
+
+    // The inner box, beside the crop box
+    {TOCropIconPathRect, {14, 3, 4, 13}},
+    {TOCropIconPathFill, {0.773f}},
+};
+
+const TOCropIconPathIcon TOCropToolbarIconPaths[] = {
+    {"Done", 17, 14, false, kTOCropDoneIcon, TOCROP_COUNT(kTOCropDoneIcon)},
+    {"Cancel", 16, 16, false, kTOCropCancelIcon, TOCROP_COUNT(kTOCropCancelIcon)},
+    {"Rotate Counterclockwise", 18, 21, false, kTOCropRotateIcon, TOCROP_COUNT(kTOCropRotateIcon)},
+    {"Rotate Clockwise", 18, 21, true, kTOCropRotateIcon, TOCROP_COUNT(kTOCropRotateIcon)},
+    {"Reset", 22, 18, false, kTOCropResetIcon, TOCROP_COUNT(kTOCropResetIcon)},
+    {"Clamp", 22, 16, false, kTOCropClampIcon, TOCROP_COUNT(kTOCropClampIcon)},
+};
+
+const size_t TOCropToolbarIconPathCount = TOCROP_COUNT(TOCropToolbarIconPaths);
@@ -0,0 +1,64 @@
+//
+//  TOCropToolbarIconPaths.h
+//
+//  Copyright 2026 Timothy Oliver. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+//  IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// The toolbar's icons, as vector paths. These are only read by `TOCropIconAtlasGenerator.c`,
+// which rasterizes them ahead of time into the atlases compiled into the library.
+
+#ifndef TOCropToolbarIconPaths_h
+#define TOCropToolbarIconPaths_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/// One step of drawing an icon. Points are in the icon's own coordinate space, in points,
+/// with the origin at the top left (the same as UIKit).
+typedef enum {
+    TOCropIconPathMove,   // Starts a new contour at (x, y)
+    TOCropIconPathLine,   // A straight line to (x, y)
+    TOCropIconPathCurve,  // A cubic curve to (x, y), through control points (x1, y1) and (x2, y2)
+    TOCropIconPathRect,   // A closed rectangle contour at (x, y), of size (width, height)
+    TOCropIconPathClose,  // Joins the current contour back to its start
+    TOCropIconPathFill,   // Fills the path so far with the non-zero rule at an alpha, then starts a new path
+    TOCropIconPathStroke  // Strokes the path so far with butt caps and mitered joins, then starts a new path
+} TOCropIconPathCommandType;
+
+typedef struct {
+    TOCropIconPathCommandType type;
+    float values[6]; // Move, Line: x, y. Curve: x1, y1, x2, y2, x, y. Rect: x, y, width, height.
+                     // Fill: alpha. Stroke: line width, alpha.
+} TOCropIconPathCommand;
+
+typedef struct {
+    const char *name;                      // A name for the icon, only used in the generated code's comments
+    float width;                           // The size of the icon, in points
+    float height;
+    bool mirrored;                         // Drawn flipped horizontally, for icons that are mirror images of another
+    const TOCropIconPathCommand *commands; // The steps to draw the icon
+    size_t commandCount;
+} TOCropIconPathIcon;
+
+/// Every toolbar icon, in the order of `TOCropToolbarIcon`
+extern const TOCropIconPathIcon TOCropToolbarIconPaths[];
+extern const size_t TOCropToolbarIconPathCount;
+
+#endif /* TOCropToolbarIconPaths_h */